@@ -145,7 +145,7 @@ export INCLUDE          :=  $(foreach dir,$(INCLUDES),-iquote $(CURDIR)/$(dir))
  
 export LIBPATHS         :=  $(foreach dir,$(LIBDIRS),-L$(dir)/lib)
 
-.PHONY: $(BUILD) clean
+.PHONY: $(BUILD) clean multiboot
  
 #---------------------------------------------------------------------------------
 all:
@@ -158,10 +158,19 @@ $(BUILD):
 	@$(PYTHON) -B $(LIBBUTANOABS)/tools/butano_assets_tool.py --audio="$(AUDIO)" --graphics="$(GRAPHICS)" --build=$(BUILD)
 	@$(MAKE) --no-print-directory -C $(BUILD) -f $(CURDIR)/Makefile
 
+#---------------------------------------------------------------------------------------------------------------------
+# Builds a multiboot image linked in EWRAM and a LZ77 compressed version of it which decompresses itself on boot:
+#---------------------------------------------------------------------------------------------------------------------
+multiboot:
+	@[ -d $(BUILD) ] || mkdir -p $(BUILD)
+	@$(EXTTOOL)
+	@$(PYTHON) -B $(LIBBUTANOABS)/tools/butano_assets_tool.py --audio="$(AUDIO)" --graphics="$(GRAPHICS)" --build=$(BUILD)
+	@$(MAKE) --no-print-directory -C $(BUILD) -f $(CURDIR)/Makefile $(OUTPUT)_mb_lz.gba
+
 #---------------------------------------------------------------------------------------------------------------------
 clean:
 	@echo clean ...
-	@rm -fr $(BUILD) $(TARGET).elf $(TARGET).gba $(USERBUILD)
+	@rm -fr $(BUILD) $(TARGET).elf $(TARGET).gba $(TARGET)_mb.elf $(TARGET)_mb.gba $(TARGET)_mb_lz.gba $(USERBUILD)
 
 #---------------------------------------------------------------------------------------------------------------------
 else
@@ -177,6 +186,17 @@ $(OUTPUT).gba       :   $(OUTPUT).elf
 
 $(OUTPUT).elf       :	$(OFILES)
 
+$(OUTPUT)_mb.gba    :   $(OUTPUT)_mb.elf
+	$(SILENTCMD)$(OBJCOPY) -O binary $< $@
+	@echo Fixing $(notdir $@) ...
+	$(SILENTCMD)gbafix -t"$(ROMTITLE)" -c"$(ROMCODE)" $@
+
+$(OUTPUT)_mb.elf    :	$(OFILES)
+
+$(OUTPUT)_mb_lz.gba :   $(OUTPUT)_mb.gba
+	@echo Compressing $(notdir $<) ...
+	$(SILENTCMD)$(PYTHON) -B $(LIBBUTANOABS)/tools/butano_multiboot_tool.py --input="$<" --output="$@"
+
 $(OFILES_SOURCES)   :   $(HFILES)
 
 #---------------------------------------------------------------------------------------------------------------------
@@ -5,7 +5,7 @@
 #include <tonc_memdef.h>
 #include <tonc_memmap.h>
 
-#include "bn_deque.h"
+#include "bn_spsc_ring.h"
 #include "bn_config_link.h"
 
 static_assert(BN_CFG_LINK_BAUD_RATE == BN_LINK_BAUD_RATE_9600_BPS ||
@@ -19,10 +19,13 @@ static_assert(bn::power_of_two(BN_CFG_LINK_MAX_MESSAGES));
 
 static_assert(BN_CFG_LINK_MAX_MISSING_MESSAGES >= 0);
 
+static_assert(BN_CFG_LINK_MAX_PACKET_SIZE > 0 && BN_CFG_LINK_MAX_PACKET_SIZE + 3 <= BN_CFG_LINK_MAX_MESSAGES);
+
 
 #define LINK_MAX_PLAYERS 4
 #define LINK_DISCONNECTED 0xFFFF
 #define LINK_NO_DATA 0x0
+#define LINK_PACKET_START 0xFFFE
 
 #define LINK_DEFAULT_TIMEOUT (BN_CFG_LINK_MAX_MISSING_MESSAGES + 1)
 #define LINK_DEFAULT_REMOTE_TIMEOUT LINK_DEFAULT_TIMEOUT
@@ -61,6 +64,11 @@ static_assert(BN_CFG_LINK_MAX_MISSING_MESSAGES >= 0);
 //       linkConnection->send(...);
 //       linkConnection->linkState
 
+// Message queues are single producer single consumer rings shared by the interrupt handlers
+// and the main thread, so they can be accessed without blocking the connection.
+// When a queue is full, new messages are discarded.
+// Incoming queues are cleared by the main thread when the interrupt handlers request it.
+
 // `data` restrictions:
 // 0xFFFF and 0x0 are reserved values, so don't use them
 // (they mean 'disconnected' and 'no data' respectively)
@@ -68,14 +76,23 @@ static_assert(BN_CFG_LINK_MAX_MISSING_MESSAGES >= 0);
 void LINK_ISR_VBLANK();
 void LINK_ISR_TIMER();
 void LINK_ISR_SERIAL();
-u16 LINK_QUEUE_POP(bn::ideque<u16>& q);
-void LINK_QUEUE_CLEAR(bn::ideque<u16>& q);
+
+using LinkQueue = bn::spsc_ring<u16, LINK_DEFAULT_BUFFER_SIZE>;
+
+u16 LINK_QUEUE_POP(LinkQueue& q);
+void LINK_QUEUE_CLEAR(LinkQueue& q);
 
 struct LinkState {
-    bn::deque<u16, LINK_DEFAULT_BUFFER_SIZE> _incomingMessages[LINK_MAX_PLAYERS];
-    bn::deque<u16, LINK_DEFAULT_BUFFER_SIZE> _outgoingMessages;
+    LinkQueue _incomingMessages[LINK_MAX_PLAYERS];
+    LinkQueue _outgoingMessages;
+    volatile bool _incomingClearRequests[LINK_MAX_PLAYERS];
     int _timeouts[LINK_MAX_PLAYERS];
     u32 _IRQTimeout;
+    u32 _sentWords = 0;
+    u32 _receivedWords = 0;
+    u32 _droppedSentWords = 0;
+    u32 _droppedReceivedWords = 0;
+    u32 _resets = 0;
     u8 playerCount;
     u8 currentPlayerId;
     bool _IRQFlag;
@@ -92,7 +109,14 @@ struct LinkState {
     }
     
     u16 readMessage(u8 playerId) {
-        return LINK_QUEUE_POP(_incomingMessages[playerId]);
+        LinkQueue& incomingMessages = _incomingMessages[playerId];
+
+        if (_incomingClearRequests[playerId]) {
+            _incomingClearRequests[playerId] = false;
+            LINK_QUEUE_CLEAR(incomingMessages);
+        }
+
+        return LINK_QUEUE_POP(incomingMessages);
     }
 };
 
@@ -131,7 +155,20 @@ public:
         if (data == LINK_DISCONNECTED || data == LINK_NO_DATA)
             return;
         
-        push(linkState._outgoingMessages, data);
+        if (!linkState._outgoingMessages.push(data))
+            linkState._droppedSentWords++;
+    }
+
+    bool send(const u16* data, int count) {
+        LinkQueue& outgoingMessages = linkState._outgoingMessages;
+
+        if (outgoingMessages.available() < count) {
+            linkState._droppedSentWords += count;
+            return false;
+        }
+
+        outgoingMessages.push(bn::span<const u16>(data, count));
+        return true;
     }
     
     void _onVBlank() {
@@ -149,6 +186,7 @@ public:
             return;
         
         if (didTimeout()) {
+            linkState._resets++;
             reset();
             return;
         }
@@ -172,14 +210,18 @@ public:
             u16 data = REG_SIOMULTI[i];
             
             if (data != LINK_DISCONNECTED) {
-                if (data != LINK_NO_DATA && i != linkState.currentPlayerId)
-                    push(linkState._incomingMessages[i], data);
+                if (data != LINK_NO_DATA && i != linkState.currentPlayerId) {
+                    if (linkState._incomingMessages[i].push(data))
+                        linkState._receivedWords++;
+                    else
+                        linkState._droppedReceivedWords++;
+                }
                 newPlayerCount++;
                 linkState._timeouts[i] = 0;
             }
             else if (linkState._timeouts[i] > LINK_REMOTE_TIMEOUT_OFFLINE) {
                 if (linkState._timeouts[i] >= LINK_DEFAULT_REMOTE_TIMEOUT) {
-                    LINK_QUEUE_CLEAR(linkState._incomingMessages[i]);
+                    linkState._incomingClearRequests[i] = true;
                     linkState._timeouts[i] = LINK_REMOTE_TIMEOUT_OFFLINE;
                 }
                 else {
@@ -213,6 +255,9 @@ private:
     
     void transfer(u16 data) {
         REG_SIOMLT_SEND = data;
+
+        if (data != LINK_NO_DATA)
+            linkState._sentWords++;
         
         if (isMaster()) {
             setBitHigh(LINK_BIT_START);
@@ -221,6 +266,7 @@ private:
     
     bool resetIfNeeded() {
         if (!isReady() || hasError()) {
+            linkState._resets++;
             reset();
             return true;
         }
@@ -238,7 +284,7 @@ private:
         linkState.playerCount = 0;
         linkState.currentPlayerId = 0;
         for (u32 i = 0; i < LINK_MAX_PLAYERS; i++) {
-            LINK_QUEUE_CLEAR(linkState._incomingMessages[i]);
+            linkState._incomingClearRequests[i] = true;
             linkState._timeouts[i] = LINK_REMOTE_TIMEOUT_OFFLINE;
         }
         LINK_QUEUE_CLEAR(linkState._outgoingMessages);
@@ -272,13 +318,6 @@ private:
         REG_TM[LINK_DEFAULT_SEND_TIMER_ID].cnt = TM_ENABLE | TM_IRQ | LINK_BASE_FREQUENCY;
     }
     
-    void push(bn::ideque<u16>& q, u16 value) {
-        if (q.full())
-            q.pop_front();
-        
-        q.push_back(value);
-    }
-    
     bool isBitHigh(unsigned bit) { return (REG_SIOCNT >> bit) & 1; }
     void setBitHigh(unsigned bit) { LINK_SET_HIGH(REG_SIOCNT, bit); }
     void setBitLow(unsigned bit) { LINK_SET_LOW(REG_SIOCNT, bit); }
@@ -298,16 +337,16 @@ inline void LINK_ISR_SERIAL() {
     linkConnection->_onSerial();
 }
 
-inline u16 LINK_QUEUE_POP(bn::ideque<u16>& q) {
-    if (q.empty())
+inline u16 LINK_QUEUE_POP(LinkQueue& q) {
+    u16 value;
+
+    if (!q.pop(value))
         return LINK_NO_DATA;
-    
-    u16 value = q.front();
-    q.pop_front();
+
     return value;
 }
 
-inline void LINK_QUEUE_CLEAR(bn::ideque<u16>& q) {
+inline void LINK_QUEUE_CLEAR(LinkQueue& q) {
     q.clear();
 }
 
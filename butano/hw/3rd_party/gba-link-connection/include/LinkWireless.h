@@ -0,0 +1,749 @@
+#ifndef LINK_WIRELESS_H
+#define LINK_WIRELESS_H
+
+#include "LinkConnection.h"
+
+static_assert(BN_CFG_LINK_WIRELESS_GAME_ID >= 0 && BN_CFG_LINK_WIRELESS_GAME_ID <= 0xFFFF);
+
+
+#define LINK_WIRELESS_MAX_PLAYERS 5
+#define LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH 20
+#define LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH 4
+#define LINK_WIRELESS_MAX_COMMAND_LENGTH (LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH + 2)
+#define LINK_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH 30
+#define LINK_WIRELESS_MAX_RELAYED_MESSAGES 32
+#define LINK_WIRELESS_BROADCAST_LENGTH 6
+#define LINK_WIRELESS_BROADCAST_RESPONSE_LENGTH (1 + LINK_WIRELESS_BROADCAST_LENGTH)
+#define LINK_WIRELESS_LOGIN_STEPS 9
+#define LINK_WIRELESS_COMMAND_HEADER 0x9966
+#define LINK_WIRELESS_RESPONSE_ACK 0x80
+#define LINK_WIRELESS_DATA_REQUEST 0x80000000
+#define LINK_WIRELESS_SETUP_MAGIC 0x003C0420
+#define LINK_WIRELESS_SETUP_MAX_PLAYERS_BIT 16
+#define LINK_WIRELESS_STILL_CONNECTING 0x01000000
+#define LINK_WIRELESS_CMD_TIMEOUT_LINES 10
+#define LINK_WIRELESS_PING_LINES 2
+#define LINK_WIRELESS_START_RETRY_FRAMES 30
+#define LINK_WIRELESS_SEARCH_FRAMES 60
+#define LINK_WIRELESS_SEARCH_JITTER_MASK 63
+#define LINK_WIRELESS_SEARCH_POLL_FRAMES 10
+#define LINK_WIRELESS_CONNECT_FRAMES 60
+#define LINK_WIRELESS_DEFAULT_TIMEOUT 30
+#define LINK_WIRELESS_CONTROL_ID 7
+
+#define LINK_WIRELESS_BITS_PLAYER_ID 16
+#define LINK_WIRELESS_BIT_VALID 19
+#define LINK_WIRELESS_BITS_CLIENT_BYTES 8
+#define LINK_WIRELESS_CLIENT_BYTES_LENGTH 5
+
+#define LINK_WIRELESS_BIT_CLOCK 0
+#define LINK_WIRELESS_BIT_SI 2
+#define LINK_WIRELESS_BIT_SO 3
+#define LINK_WIRELESS_BIT_START 7
+#define LINK_WIRELESS_BIT_LENGTH 12
+#define LINK_WIRELESS_BIT_IRQ 14
+#define LINK_WIRELESS_BIT_SD_DATA 1
+#define LINK_WIRELESS_BIT_SD_DIRECTION 5
+
+#define LINK_WIRELESS_COMMAND_HELLO 0x10
+#define LINK_WIRELESS_COMMAND_BROADCAST 0x16
+#define LINK_WIRELESS_COMMAND_SETUP 0x17
+#define LINK_WIRELESS_COMMAND_START_HOST 0x19
+#define LINK_WIRELESS_COMMAND_ACCEPT_CONNECTIONS 0x1A
+#define LINK_WIRELESS_COMMAND_BROADCAST_READ_START 0x1C
+#define LINK_WIRELESS_COMMAND_BROADCAST_READ_POLL 0x1D
+#define LINK_WIRELESS_COMMAND_BROADCAST_READ_END 0x1E
+#define LINK_WIRELESS_COMMAND_CONNECT 0x1F
+#define LINK_WIRELESS_COMMAND_IS_FINISHED_CONNECT 0x20
+#define LINK_WIRELESS_COMMAND_FINISH_CONNECTION 0x21
+#define LINK_WIRELESS_COMMAND_SEND_DATA 0x24
+#define LINK_WIRELESS_COMMAND_RECEIVE_DATA 0x26
+#define LINK_WIRELESS_COMMAND_BYE 0x3D
+
+// A Wireless Adapter connection with the same LinkState interface as LinkConnection.
+
+// Usage:
+// - Same as LinkConnection: _onVBlank must be called once per frame,
+//   and _onTimer and _onSerial must be called by the timer and serial interrupt service routines.
+
+// Session:
+// - When activated, the adapter searches for a host with the same game ID for about one second.
+//   If one is found, it joins its room as a client. Otherwise, it becomes the host.
+// - The host is always player 0. Clients are players 1 to LINK_MAX_PLAYERS - 1.
+// - Session management commands are sent by _onVBlank and they block it for a few scanlines.
+
+// Data exchanges:
+// - Once connected, each timer interrupt starts an exchange if the previous one has finished.
+// - An exchange sends all pending messages in one multi-word frame (up to 20 words for the host
+//   and up to 4 words for clients) and receives the frames of the other players.
+// - Exchanges are driven by the serial interrupt, so nothing waits for a whole exchange.
+// - Clients only talk to the host, so the host relays the messages of each client to the other ones.
+
+// Frame words:
+// - Bits 0-15: message (0x0 means 'no data').
+// - Bits 16-18: player ID of the sender (LINK_WIRELESS_CONTROL_ID means 'player count').
+// - Bit 19: always high.
+
+class LinkWireless {
+public:
+    LinkState linkState;
+
+    void init() {
+        stop();
+    }
+
+    bool isActive() {
+        return isEnabled;
+    }
+
+    void activate() {
+        isEnabled = true;
+        reset();
+        stateFrames = LINK_WIRELESS_START_RETRY_FRAMES - 1;
+    }
+
+    void deactivate() {
+        if (isEnabled && sessionState != SessionState::NEEDS_RESET) {
+            stopExchanges();
+            sendCommand(LINK_WIRELESS_COMMAND_BYE);
+        }
+
+        isEnabled = false;
+        resetState();
+        stop();
+    }
+
+    void send(u16 data) {
+        if (data == LINK_DISCONNECTED || data == LINK_NO_DATA)
+            return;
+
+        if (!linkState._outgoingMessages.push(data))
+            linkState._droppedSentWords++;
+    }
+
+    bool send(const u16* data, int count) {
+        LinkQueue& outgoingMessages = linkState._outgoingMessages;
+
+        if (outgoingMessages.available() < count) {
+            linkState._droppedSentWords += count;
+            return false;
+        }
+
+        outgoingMessages.push(bn::span<const u16>(data, count));
+        return true;
+    }
+
+    void _onVBlank() {
+        if (!isEnabled)
+            return;
+
+        stateFrames++;
+
+        switch (sessionState) {
+            case SessionState::NEEDS_RESET:
+                if (stateFrames >= LINK_WIRELESS_START_RETRY_FRAMES && !start())
+                    reset();
+                break;
+
+            case SessionState::SEARCHING:
+                search();
+                break;
+
+            case SessionState::CONNECTING:
+                connect();
+                break;
+
+            default:
+                if (linkState._IRQTimeout++ >= LINK_WIRELESS_DEFAULT_TIMEOUT) {
+                    linkState._resets++;
+                    reset();
+                }
+                break;
+        }
+    }
+
+    void _onTimer() {
+        if (!isEnabled || asyncCommand.busy)
+            return;
+
+        if (sessionState == SessionState::SERVING || sessionState == SessionState::CONNECTED)
+            startDataExchange();
+    }
+
+    void _onSerial() {
+        if (!isEnabled || !asyncCommand.busy)
+            return;
+
+        u32 response = REG_SIODATA32;
+
+        if (!acknowledge()) {
+            failAsyncCommand();
+            return;
+        }
+
+        switch (asyncCommand.step) {
+            case AsyncStep::SENDING:
+                if (response != LINK_WIRELESS_DATA_REQUEST) {
+                    failAsyncCommand();
+                    return;
+                }
+
+                asyncCommand.wordIndex++;
+
+                if (asyncCommand.wordIndex < asyncCommand.wordsCount) {
+                    transferAsync(asyncCommand.words[asyncCommand.wordIndex]);
+                } else {
+                    asyncCommand.step = AsyncStep::RESPONSE_HEADER;
+                    transferAsync(LINK_WIRELESS_DATA_REQUEST);
+                }
+                break;
+
+            case AsyncStep::RESPONSE_HEADER:
+                if (!isResponseHeader(response, asyncCommand.type)) {
+                    failAsyncCommand();
+                    return;
+                }
+
+                asyncCommand.responsesCount = 0;
+                asyncCommand.expectedResponsesCount = (response >> 8) & 0xFF;
+
+                if (asyncCommand.expectedResponsesCount > LINK_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH) {
+                    failAsyncCommand();
+                } else if (asyncCommand.expectedResponsesCount == 0) {
+                    completeAsyncCommand();
+                } else {
+                    asyncCommand.step = AsyncStep::RESPONSES;
+                    transferAsync(LINK_WIRELESS_DATA_REQUEST);
+                }
+                break;
+
+            default:
+                asyncCommand.responses[asyncCommand.responsesCount++] = response;
+
+                if (asyncCommand.responsesCount == asyncCommand.expectedResponsesCount)
+                    completeAsyncCommand();
+                else
+                    transferAsync(LINK_WIRELESS_DATA_REQUEST);
+                break;
+        }
+    }
+
+private:
+    using RelayQueue = bn::spsc_ring<u32, LINK_WIRELESS_MAX_RELAYED_MESSAGES>;
+
+    enum class SessionState : u8 {
+        NEEDS_RESET,
+        SEARCHING,
+        CONNECTING,
+        SERVING,
+        CONNECTED
+    };
+
+    enum class AsyncStep : u8 {
+        SENDING,
+        RESPONSE_HEADER,
+        RESPONSES
+    };
+
+    struct AsyncCommand {
+        u32 words[LINK_WIRELESS_MAX_COMMAND_LENGTH];
+        u32 responses[LINK_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH];
+        u32 wordsCount = 0;
+        u32 wordIndex = 0;
+        u32 responsesCount = 0;
+        u32 expectedResponsesCount = 0;
+        u8 type = 0;
+        AsyncStep step = AsyncStep::SENDING;
+        volatile bool busy = false;
+    };
+
+    AsyncCommand asyncCommand;
+    RelayQueue relayedMessages;
+    u32 responses[LINK_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH];
+    u32 responsesCount = 0;
+    u32 stateFrames = 0;
+    u32 searchFrames = 0;
+    volatile SessionState sessionState = SessionState::NEEDS_RESET;
+    bool isEnabled = false;
+
+    void reset() {
+        stopExchanges();
+        resetState();
+        stop();
+        startTimer();
+    }
+
+    void resetState() {
+        sessionState = SessionState::NEEDS_RESET;
+        stateFrames = 0;
+        linkState.playerCount = 0;
+        linkState.currentPlayerId = 0;
+        for (u32 i = 0; i < LINK_MAX_PLAYERS; i++) {
+            linkState._incomingClearRequests[i] = true;
+            linkState._timeouts[i] = LINK_REMOTE_TIMEOUT_OFFLINE;
+        }
+        LINK_QUEUE_CLEAR(linkState._outgoingMessages);
+        relayedMessages.clear();
+        linkState._IRQFlag = false;
+        linkState._IRQTimeout = 0;
+    }
+
+    void stop() {
+        stopTimer();
+
+        LINK_SET_LOW(REG_RCNT, LINK_BIT_GENERAL_PURPOSE_LOW);
+        LINK_SET_HIGH(REG_RCNT, LINK_BIT_GENERAL_PURPOSE_HIGH);
+    }
+
+    bool start() {
+        pingAdapter();
+
+        REG_RCNT = 0;
+        REG_SIOCNT = baseControl();
+
+        if (!login() || !sendCommand(LINK_WIRELESS_COMMAND_HELLO))
+            return false;
+
+        u32 setup = LINK_WIRELESS_SETUP_MAGIC |
+                ((LINK_WIRELESS_MAX_PLAYERS - LINK_MAX_PLAYERS) << LINK_WIRELESS_SETUP_MAX_PLAYERS_BIT);
+
+        if (!sendCommand(LINK_WIRELESS_COMMAND_SETUP, &setup, 1) ||
+                !sendCommand(LINK_WIRELESS_COMMAND_BROADCAST_READ_START))
+            return false;
+
+        // Random search time, so two GBAs activated at the same time don't become hosts at the same time:
+        sessionState = SessionState::SEARCHING;
+        stateFrames = 0;
+        searchFrames = LINK_WIRELESS_SEARCH_FRAMES + (REG_TM2D & LINK_WIRELESS_SEARCH_JITTER_MASK);
+        return true;
+    }
+
+    void search() {
+        if (stateFrames % LINK_WIRELESS_SEARCH_POLL_FRAMES == 0) {
+            if (!sendCommand(LINK_WIRELESS_COMMAND_BROADCAST_READ_POLL)) {
+                reset();
+                return;
+            }
+
+            for (u32 i = 0; i + LINK_WIRELESS_BROADCAST_RESPONSE_LENGTH <= responsesCount;
+                    i += LINK_WIRELESS_BROADCAST_RESPONSE_LENGTH) {
+                if ((responses[i + 1] & 0xFFFF) == BN_CFG_LINK_WIRELESS_GAME_ID) {
+                    u32 serverId = responses[i] & 0xFFFF;
+
+                    if (!sendCommand(LINK_WIRELESS_COMMAND_BROADCAST_READ_END) ||
+                            !sendCommand(LINK_WIRELESS_COMMAND_CONNECT, &serverId, 1)) {
+                        reset();
+                        return;
+                    }
+
+                    sessionState = SessionState::CONNECTING;
+                    stateFrames = 0;
+                    return;
+                }
+            }
+        }
+
+        if (stateFrames >= searchFrames)
+            serve();
+    }
+
+    void serve() {
+        u32 broadcast[LINK_WIRELESS_BROADCAST_LENGTH] = { BN_CFG_LINK_WIRELESS_GAME_ID };
+
+        if (!sendCommand(LINK_WIRELESS_COMMAND_BROADCAST_READ_END) ||
+                !sendCommand(LINK_WIRELESS_COMMAND_BROADCAST, broadcast, LINK_WIRELESS_BROADCAST_LENGTH) ||
+                !sendCommand(LINK_WIRELESS_COMMAND_START_HOST)) {
+            reset();
+            return;
+        }
+
+        linkState.playerCount = 1;
+        linkState.currentPlayerId = 0;
+        linkState._IRQTimeout = 0;
+        sessionState = SessionState::SERVING;
+    }
+
+    void connect() {
+        if (!sendCommand(LINK_WIRELESS_COMMAND_IS_FINISHED_CONNECT) || responsesCount == 0) {
+            reset();
+            return;
+        }
+
+        u32 connection = responses[0];
+
+        if (connection == LINK_WIRELESS_STILL_CONNECTING) {
+            if (stateFrames >= LINK_WIRELESS_CONNECT_FRAMES)
+                reset();
+            return;
+        }
+
+        u32 playerId = 1 + ((connection >> 16) & 0xFF);
+
+        if (playerId >= LINK_MAX_PLAYERS || !sendCommand(LINK_WIRELESS_COMMAND_FINISH_CONNECTION) ||
+                responsesCount == 0 || (responses[0] & 0xFFFF) != (connection & 0xFFFF)) {
+            reset();
+            return;
+        }
+
+        linkState.playerCount = playerId + 1;
+        linkState.currentPlayerId = playerId;
+        linkState._IRQTimeout = 0;
+        sessionState = SessionState::CONNECTED;
+    }
+
+    void startDataExchange() {
+        u32* data = asyncCommand.words + 2;
+        u32 dataCount = 0;
+        u16 message;
+
+        if (sessionState == SessionState::SERVING) {
+            data[dataCount++] = buildWord(LINK_WIRELESS_CONTROL_ID, linkState.playerCount);
+
+            while (dataCount < LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH && relayedMessages.pop(data[dataCount]))
+                dataCount++;
+
+            while (dataCount < LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH &&
+                    linkState._outgoingMessages.pop(message)) {
+                data[dataCount++] = buildWord(0, message);
+                linkState._sentWords++;
+            }
+
+            asyncCommand.words[1] = dataCount * 4;
+        } else {
+            u32 playerId = linkState.currentPlayerId;
+
+            while (dataCount < LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH && linkState._outgoingMessages.pop(message)) {
+                data[dataCount++] = buildWord(playerId, message);
+                linkState._sentWords++;
+            }
+
+            // Clients always send something, so the host knows they are still alive:
+            if (dataCount == 0)
+                data[dataCount++] = buildWord(playerId, LINK_NO_DATA);
+
+            asyncCommand.words[1] = (dataCount * 4) <<
+                    (LINK_WIRELESS_BITS_CLIENT_BYTES + (playerId - 1) * LINK_WIRELESS_CLIENT_BYTES_LENGTH);
+        }
+
+        startAsyncCommand(LINK_WIRELESS_COMMAND_SEND_DATA, 1 + dataCount);
+    }
+
+    void receiveData() {
+        const u32* receivedResponses = asyncCommand.responses;
+        u32 receivedCount = asyncCommand.responsesCount;
+
+        // The host only needs the adapter to answer to know that the session is still alive:
+        if (sessionState == SessionState::SERVING) {
+            linkState._IRQFlag = true;
+            linkState._IRQTimeout = 0;
+        }
+
+        if (receivedCount == 0)
+            return;
+
+        u32 header = receivedResponses[0];
+        u32 index = 1;
+
+        if (sessionState == SessionState::SERVING) {
+            for (u32 playerId = 1; playerId < LINK_MAX_PLAYERS; playerId++) {
+                u32 shift = LINK_WIRELESS_BITS_CLIENT_BYTES + (playerId - 1) * LINK_WIRELESS_CLIENT_BYTES_LENGTH;
+                u32 bytes = (header >> shift) & ((1 << LINK_WIRELESS_CLIENT_BYTES_LENGTH) - 1);
+
+                for (u32 end = index + (bytes + 3) / 4; index < end && index < receivedCount; index++) {
+                    u32 word = receivedResponses[index];
+
+                    if (isValidWord(word) && wordPlayerId(word) == playerId) {
+                        u16 message = word & 0xFFFF;
+                        linkState._timeouts[playerId] = 0;
+
+                        if (message != LINK_NO_DATA) {
+                            if (linkState._incomingMessages[playerId].push(message))
+                                linkState._receivedWords++;
+                            else
+                                linkState._droppedReceivedWords++;
+
+                            relayedMessages.push(word);
+                        }
+                    }
+                }
+            }
+        } else {
+            u32 bytes = header & 0x7F;
+
+            for (u32 end = index + (bytes + 3) / 4; index < end && index < receivedCount; index++) {
+                u32 word = receivedResponses[index];
+
+                if (isValidWord(word)) {
+                    u32 playerId = wordPlayerId(word);
+                    u16 message = word & 0xFFFF;
+
+                    if (playerId == LINK_WIRELESS_CONTROL_ID) {
+                        if (message > linkState.currentPlayerId && message <= LINK_MAX_PLAYERS)
+                            linkState.playerCount = message;
+                    } else if (playerId < LINK_MAX_PLAYERS && playerId != linkState.currentPlayerId &&
+                            message != LINK_NO_DATA) {
+                        if (linkState._incomingMessages[playerId].push(message))
+                            linkState._receivedWords++;
+                        else
+                            linkState._droppedReceivedWords++;
+                    }
+                }
+            }
+
+            if (bytes) {
+                linkState._IRQFlag = true;
+                linkState._IRQTimeout = 0;
+            }
+        }
+    }
+
+    void acceptConnections() {
+        u32 newPlayerCount = 1;
+        u32 connectedPlayers = 1;
+
+        for (u32 i = 0; i < asyncCommand.responsesCount; i++) {
+            u32 playerId = 1 + ((asyncCommand.responses[i] >> 16) & 0xFF);
+
+            if (playerId < LINK_MAX_PLAYERS) {
+                connectedPlayers |= 1 << playerId;
+
+                if (playerId >= newPlayerCount)
+                    newPlayerCount = playerId + 1;
+            }
+        }
+
+        for (u32 playerId = 1; playerId < LINK_MAX_PLAYERS; playerId++) {
+            if (!(connectedPlayers & (1 << playerId)))
+                linkState._incomingClearRequests[playerId] = true;
+        }
+
+        linkState.playerCount = newPlayerCount;
+    }
+
+    void startAsyncCommand(u8 type, u32 paramsCount) {
+        asyncCommand.words[0] = buildCommandHeader(type, paramsCount);
+        asyncCommand.wordsCount = 1 + paramsCount;
+        asyncCommand.wordIndex = 0;
+        asyncCommand.type = type;
+        asyncCommand.step = AsyncStep::SENDING;
+        asyncCommand.busy = true;
+        transferAsync(asyncCommand.words[0]);
+    }
+
+    void completeAsyncCommand() {
+        switch (asyncCommand.type) {
+            case LINK_WIRELESS_COMMAND_SEND_DATA:
+                startAsyncCommand(LINK_WIRELESS_COMMAND_RECEIVE_DATA, 0);
+                break;
+
+            case LINK_WIRELESS_COMMAND_RECEIVE_DATA:
+                receiveData();
+
+                if (sessionState == SessionState::SERVING)
+                    startAsyncCommand(LINK_WIRELESS_COMMAND_ACCEPT_CONNECTIONS, 0);
+                else
+                    asyncCommand.busy = false;
+                break;
+
+            default:
+                acceptConnections();
+                asyncCommand.busy = false;
+                break;
+        }
+    }
+
+    void failAsyncCommand() {
+        REG_SIOCNT = baseControl();
+        asyncCommand.busy = false;
+    }
+
+    void stopExchanges() {
+        sessionState = SessionState::NEEDS_RESET;
+        failAsyncCommand();
+    }
+
+    void transferAsync(u32 data) {
+        if (!waitSI(false)) {
+            failAsyncCommand();
+            return;
+        }
+
+        REG_SIODATA32 = data;
+        REG_SIOCNT = baseControl() | (1 << LINK_WIRELESS_BIT_IRQ);
+        setBitHigh(LINK_WIRELESS_BIT_START);
+    }
+
+    bool sendCommand(u8 type, const u32* params = nullptr, u32 paramsCount = 0) {
+        u32 response;
+        responsesCount = 0;
+
+        if (!transfer(buildCommandHeader(type, paramsCount), response) || response != LINK_WIRELESS_DATA_REQUEST)
+            return false;
+
+        for (u32 i = 0; i < paramsCount; i++) {
+            if (!transfer(params[i], response) || response != LINK_WIRELESS_DATA_REQUEST)
+                return false;
+        }
+
+        if (!transfer(LINK_WIRELESS_DATA_REQUEST, response) || !isResponseHeader(response, type))
+            return false;
+
+        u32 count = (response >> 8) & 0xFF;
+
+        if (count > LINK_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH)
+            return false;
+
+        for (u32 i = 0; i < count; i++) {
+            if (!transfer(LINK_WIRELESS_DATA_REQUEST, responses[i]))
+                return false;
+        }
+
+        responsesCount = count;
+        return true;
+    }
+
+    bool login() {
+        static constexpr u16 loginParts[LINK_WIRELESS_LOGIN_STEPS] = {
+            0x494E, 0x494E, 0x544E, 0x544E, 0x4E45, 0x4E45, 0x4F44, 0x4F44, 0x8001
+        };
+
+        u16 previousGBAData = 0xFFFF;
+        u16 previousAdapterData = 0xFFFF;
+
+        // The adapter echoes the previous GBA data with the bitwise NOT of the previous adapter data:
+        for (u32 i = 0; i < LINK_WIRELESS_LOGIN_STEPS; i++) {
+            u16 data = loginParts[i];
+            u16 expectedResponse = i ? loginParts[i - 1] : 0;
+            u32 response;
+
+            if (!transfer((u32(u16(~previousAdapterData)) << 16) | data, response, false))
+                return false;
+
+            if ((response >> 16) != expectedResponse || u16(response) != u16(~previousGBAData))
+                return false;
+
+            previousGBAData = data;
+            previousAdapterData = expectedResponse;
+        }
+
+        return true;
+    }
+
+    void pingAdapter() {
+        REG_RCNT = (1 << LINK_BIT_GENERAL_PURPOSE_HIGH) | (1 << LINK_WIRELESS_BIT_SD_DIRECTION) |
+                (1 << LINK_WIRELESS_BIT_SD_DATA);
+        waitLines(LINK_WIRELESS_PING_LINES);
+        REG_RCNT = (1 << LINK_BIT_GENERAL_PURPOSE_HIGH) | (1 << LINK_WIRELESS_BIT_SD_DIRECTION);
+        waitLines(LINK_WIRELESS_PING_LINES);
+    }
+
+    bool transfer(u32 data, u32& response, bool ack = true) {
+        if (!waitSI(false))
+            return false;
+
+        REG_SIODATA32 = data;
+        REG_SIOCNT = baseControl();
+        setBitHigh(LINK_WIRELESS_BIT_START);
+
+        u32 lines = 0;
+        u32 vCount = REG_VCOUNT;
+
+        while (isBitHigh(LINK_WIRELESS_BIT_START)) {
+            if (timeout(lines, vCount))
+                return false;
+        }
+
+        response = REG_SIODATA32;
+        return !ack || acknowledge();
+    }
+
+    bool acknowledge() {
+        setBitLow(LINK_WIRELESS_BIT_SO);
+
+        if (!waitSI(true))
+            return false;
+
+        setBitHigh(LINK_WIRELESS_BIT_SO);
+
+        if (!waitSI(false))
+            return false;
+
+        setBitLow(LINK_WIRELESS_BIT_SO);
+        return true;
+    }
+
+    bool waitSI(bool high) {
+        u32 lines = 0;
+        u32 vCount = REG_VCOUNT;
+
+        while (isBitHigh(LINK_WIRELESS_BIT_SI) != high) {
+            if (timeout(lines, vCount))
+                return false;
+        }
+
+        return true;
+    }
+
+    void waitLines(u32 count) {
+        u32 lines = 0;
+        u32 vCount = REG_VCOUNT;
+
+        while (lines < count) {
+            if (REG_VCOUNT != vCount) {
+                vCount = REG_VCOUNT;
+                lines++;
+            }
+        }
+    }
+
+    bool timeout(u32& lines, u32& vCount) {
+        if (REG_VCOUNT != vCount) {
+            vCount = REG_VCOUNT;
+            lines++;
+        }
+
+        return lines > LINK_WIRELESS_CMD_TIMEOUT_LINES;
+    }
+
+    void stopTimer() {
+        REG_TM[LINK_DEFAULT_SEND_TIMER_ID].cnt = REG_TM[LINK_DEFAULT_SEND_TIMER_ID].cnt & (~TM_ENABLE);
+    }
+
+    void startTimer() {
+        REG_TM[LINK_DEFAULT_SEND_TIMER_ID].start = -LINK_DEFAULT_INTERVAL;
+        REG_TM[LINK_DEFAULT_SEND_TIMER_ID].cnt = TM_ENABLE | TM_IRQ | LINK_BASE_FREQUENCY;
+    }
+
+    static u32 baseControl() {
+        return (1 << LINK_WIRELESS_BIT_LENGTH) | (1 << LINK_WIRELESS_BIT_CLOCK);
+    }
+
+    static u32 buildCommandHeader(u8 type, u32 paramsCount) {
+        return (LINK_WIRELESS_COMMAND_HEADER << 16) | (paramsCount << 8) | type;
+    }
+
+    static bool isResponseHeader(u32 response, u8 type) {
+        return (response >> 16) == LINK_WIRELESS_COMMAND_HEADER &&
+                (response & 0xFF) == u32(type + LINK_WIRELESS_RESPONSE_ACK);
+    }
+
+    static u32 buildWord(u32 playerId, u16 message) {
+        return (1 << LINK_WIRELESS_BIT_VALID) | (playerId << LINK_WIRELESS_BITS_PLAYER_ID) | message;
+    }
+
+    static bool isValidWord(u32 word) {
+        return (word >> LINK_WIRELESS_BIT_VALID) == 1;
+    }
+
+    static u32 wordPlayerId(u32 word) {
+        return (word >> LINK_WIRELESS_BITS_PLAYER_ID) & 0b111;
+    }
+
+    bool isBitHigh(unsigned bit) { return (REG_SIOCNT >> bit) & 1; }
+    void setBitHigh(unsigned bit) { LINK_SET_HIGH(REG_SIOCNT, bit); }
+    void setBitLow(unsigned bit) { LINK_SET_LOW(REG_SIOCNT, bit); }
+};
+
+extern LinkWireless* linkWireless;
+
+#endif  // LINK_WIRELESS_H
@@ -71,6 +71,18 @@ namespace bn::hw::audio
 
     void stop_all_sounds();
 
+    [[nodiscard]] bool pop_music_event(uint8_t& event);
+
+    [[nodiscard]] int mixing_rate();
+
+    [[nodiscard]] int max_music_channels();
+
+    [[nodiscard]] int max_sound_channels();
+
+    void reconfigure(int mixing_rate, int max_music_channels, int max_sound_channels);
+
+    [[nodiscard]] int mixer_ticks();
+
     [[nodiscard]] bool update_on_vblank();
 
     void set_update_on_vblank(bool update_on_vblank);
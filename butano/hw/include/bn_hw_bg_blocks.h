@@ -67,12 +67,48 @@ namespace bn::hw::bg_blocks
             hw::decompress::rl_vram(source_ptr, destination_ptr);
             break;
 
+        case compression_type::LZ4:
+            hw::decompress::lz4(source_ptr, destination_ptr);
+            break;
+
+        case compression_type::HUFFMAN:
+            hw::decompress::huffman(source_ptr, destination_ptr);
+            break;
+
+        case compression_type::LZ77_HUFFMAN:
+            hw::decompress::lz77_huffman_vram(source_ptr, destination_ptr);
+            break;
+
         default:
             BN_ERROR("Unknown compression type: ", int(compression));
             break;
         }
     }
 
+    inline void decompress_big_map_chunk(const uint8_t* source_ptr, uint16_t* destination_ptr)
+    {
+        // The compression type is stored in the high nibble of the first byte of GBA BIOS compressed data:
+        switch(*source_ptr >> 4)
+        {
+
+        case 1:
+            hw::decompress::lz77_wram(source_ptr, destination_ptr);
+            break;
+
+        case 3:
+            hw::decompress::rl_wram(source_ptr, destination_ptr);
+            break;
+
+        case 4:
+            hw::decompress::lz4(source_ptr, destination_ptr);
+            break;
+
+        default:
+            BN_ERROR("Unknown big map chunk compression type: ", *source_ptr >> 4);
+            break;
+        }
+    }
+
     [[nodiscard]] inline uint16_t regular_map_cells_offset(unsigned tiles_offset, unsigned palette_offset)
     {
         return uint16_t((palette_offset << 12) + tiles_offset);
@@ -106,6 +142,42 @@ namespace bn::hw::bg_blocks
             _commit_offset_half_words(source_data_ptr, unsigned(half_words), offset, destination_vram_ptr);
         }
     }
+
+    BN_CODE_IWRAM void _copy_regular_map_cells_backward(
+            const uint16_t* source_ptr, int count, uint16_t offset, uint16_t* destination_ptr);
+
+    BN_CODE_IWRAM void _copy_affine_map_cells(
+            const uint8_t* source_ptr, int count, uint8_t offset, uint8_t* destination_ptr);
+
+    inline void copy_regular_map_cells(const uint16_t* source_ptr, int count, uint16_t offset,
+                                       uint16_t* destination_ptr)
+    {
+        // Backward copies are only required when the destination overlaps the end of the source:
+        if(destination_ptr > source_ptr && destination_ptr < source_ptr + count)
+        {
+            _copy_regular_map_cells_backward(source_ptr, count, offset, destination_ptr);
+        }
+        else if(offset)
+        {
+            commit_offset(source_ptr, count, offset, destination_ptr);
+        }
+        else
+        {
+            hw::memory::copy_half_words(source_ptr, count, destination_ptr);
+        }
+    }
+
+    inline void copy_affine_map_cells(const uint8_t* source_ptr, int count, uint8_t offset, uint8_t* destination_ptr)
+    {
+        if(offset || (destination_ptr > source_ptr && destination_ptr < source_ptr + count))
+        {
+            _copy_affine_map_cells(source_ptr, count, offset, destination_ptr);
+        }
+        else
+        {
+            hw::memory::copy_bytes(source_ptr, count, destination_ptr);
+        }
+    }
 }
 
 #endif
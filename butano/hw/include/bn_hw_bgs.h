@@ -187,31 +187,6 @@ namespace bn::hw::bgs
         set_mosaic_enabled(mosaic_enabled, bg.cnt);
     }
 
-    inline void commit(const handle* bgs_ptr)
-    {
-        const handle& bg0 = bgs_ptr[0];
-        REG_BG0CNT = bg0.cnt;
-        REG_BG0HOFS = bg0.hofs;
-        REG_BG0VOFS = bg0.vofs;
-
-        const handle& bg1 = bgs_ptr[1];
-        REG_BG1CNT = bg1.cnt;
-        REG_BG1HOFS = bg1.hofs;
-        REG_BG1VOFS = bg1.vofs;
-
-        const handle& bg2 = bgs_ptr[2];
-        REG_BG2CNT = bg2.cnt;
-        REG_BG2HOFS = bg2.hofs;
-        REG_BG2VOFS = bg2.vofs;
-        REG_BG_AFFINE[2] = bg2.affine;
-
-        const handle& bg3 = bgs_ptr[3];
-        REG_BG3CNT = bg3.cnt;
-        REG_BG3HOFS = bg3.hofs;
-        REG_BG3VOFS = bg3.vofs;
-        REG_BG_AFFINE[3] = bg3.affine;
-    }
-
     inline void stop()
     {
         REG_BG_AFFINE[2] = handle().affine;
@@ -236,6 +211,17 @@ namespace bn::hw::bgs
     {
         return reinterpret_cast<uint16_t*>(REG_BASE + 0x0008 + (0x0002 * id));
     }
+
+    template<typename Type>
+    inline void commit_register(Type value, Type* register_ptr)
+    {
+        *reinterpret_cast<volatile Type*>(register_ptr) = value;
+    }
+
+    inline void commit_affine_mat(const affine_attributes& affine, int id)
+    {
+        REG_BG_AFFINE[id] = affine;
+    }
 }
 
 #endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_BITMAP_BG_H
+#define BN_HW_BITMAP_BG_H
+
+#include "bn_hw_tonc.h"
+
+namespace bn::hw::bitmap_bg
+{
+    [[nodiscard]] constexpr int mode()
+    {
+        return 4;
+    }
+
+    [[nodiscard]] constexpr int bg()
+    {
+        return 2;
+    }
+
+    [[nodiscard]] constexpr int width()
+    {
+        return 240;
+    }
+
+    [[nodiscard]] constexpr int height()
+    {
+        return 160;
+    }
+
+    [[nodiscard]] constexpr int pitch()
+    {
+        return width() / 2;
+    }
+
+    [[nodiscard]] constexpr int reserved_sprite_tiles_count()
+    {
+        return 512;
+    }
+
+    [[nodiscard]] constexpr unsigned page_flag(int page)
+    {
+        return page ? DCNT_PAGE : 0;
+    }
+
+    [[nodiscard]] inline uint16_t* page(int page)
+    {
+        return reinterpret_cast<uint16_t*>(MEM_VRAM + (page * VRAM_PAGE_SIZE));
+    }
+
+    BN_CODE_IWRAM void fill_rect(int x, int y, int width, int height, int color_index, uint16_t* page_ptr);
+
+    BN_CODE_IWRAM void copy_rect(const uint8_t* source_ptr, int source_pitch, int x, int y, int width, int height,
+                                 uint16_t* page_ptr);
+
+    BN_CODE_IWRAM void copy_masked_rect(const uint8_t* source_ptr, int source_pitch, int x, int y, int width,
+                                        int height, uint16_t* page_ptr);
+
+    BN_CODE_IWRAM void copy_page_rect(const uint16_t* source_page_ptr, int x, int y, int width, int height,
+                                      uint16_t* destination_page_ptr);
+
+    BN_CODE_IWRAM void draw_line(int x0, int y0, int x1, int y1, int color_index, uint16_t* page_ptr);
+}
+
+#endif
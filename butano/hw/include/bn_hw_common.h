@@ -16,6 +16,20 @@
  */
 #define BN_CODE_IWRAM __attribute__((section(".iwram"), target("arm")))
 
+/**
+ * @brief Store ARM code in the given IWRAM overlay (from 0 to 9).
+ *
+ * It must be loaded with bn::iwram_overlay::load before being called.
+ */
+#define BN_CODE_IWRAM_OVERLAY(id) __attribute__((section(".iwram" #id), target("arm"), noinline))
+
+/**
+ * @brief Store data in the given IWRAM overlay (from 0 to 9).
+ *
+ * It must be loaded with bn::iwram_overlay::load before being accessed.
+ */
+#define BN_DATA_IWRAM_OVERLAY(id) __attribute__((section(".iwram" #id)))
+
 /**
  * @brief Store Thumb code in EWRAM.
  */
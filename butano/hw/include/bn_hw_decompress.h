@@ -6,7 +6,7 @@
 #ifndef BN_HW_DECOMPRESS_H
 #define BN_HW_DECOMPRESS_H
 
-#include "bn_common.h"
+#include "bn_hw_tonc.h"
 #include "../3rd_party/cult-of-gba-bios/include/cult-of-gba-bios.h"
 
 namespace bn::hw::decompress
@@ -30,6 +30,18 @@ namespace bn::hw::decompress
     {
         swi_RLUnCompReadNormalWrite16bit(src, dst);
     }
+
+    BN_CODE_IWRAM void lz4(const void* src, void* dst);
+
+    inline void huffman(const void* src, void* dst)
+    {
+        // GBA BIOS Huffman decompression writes 32bit units, so it supports both WRAM and VRAM:
+        HuffUnComp(src, dst);
+    }
+
+    void lz77_huffman_wram(const void* src, void* dst);
+
+    void lz77_huffman_vram(const void* src, void* dst);
 }
 
 #endif
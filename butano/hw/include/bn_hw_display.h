@@ -8,6 +8,8 @@
 
 #include "bn_point.h"
 #include "bn_hw_bgs.h"
+#include "bn_hw_bitmap_bg.h"
+#include "bn_config_sprites.h"
 
 #define REG_DISPCNT_U16     *(u16*)(REG_BASE+0x0000)
 #define REG_DISPCNT_U16_2   *(u16*)(REG_BASE+0x0002)
@@ -31,6 +33,13 @@ namespace bn::hw::display
         return 4;
     }
 
+    [[nodiscard]] inline int current_line()
+    {
+        BN_BARRIER;
+
+        return REG_VCOUNT;
+    }
+
     [[nodiscard]] constexpr int inside_windows_count()
     {
         return 3;
@@ -46,6 +55,10 @@ namespace bn::hw::display
     {
         unsigned dispcnt = unsigned(mode) | DCNT_OBJ | DCNT_OBJ_1D;
 
+        #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+            dispcnt |= DCNT_OAM_HBL;
+        #endif
+
         for(int index = 0; index < bgs::count(); ++index)
         {
             if(enabled_bgs[index])
@@ -65,6 +78,14 @@ namespace bn::hw::display
         display_cnt = uint16_t(dispcnt);
     }
 
+    inline void set_bitmap_display(int page, const bool* enabled_inside_windows, uint16_t& display_cnt)
+    {
+        bool enabled_bgs[bgs::count()] = {};
+        enabled_bgs[bitmap_bg::bg()] = true;
+        set_display(bitmap_bg::mode(), enabled_bgs, enabled_inside_windows, display_cnt);
+        display_cnt |= uint16_t(bitmap_bg::page_flag(page));
+    }
+
     inline void commit_display(uint16_t display_cnt)
     {
         REG_DISPCNT_U16 = display_cnt;
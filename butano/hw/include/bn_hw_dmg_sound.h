@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_DMG_SOUND_H
+#define BN_HW_DMG_SOUND_H
+
+#include "bn_hw_tonc.h"
+
+namespace bn::hw::dmg_sound
+{
+    namespace
+    {
+        constexpr uint16_t wave_bank_1 = 1 << 6;
+        constexpr uint16_t wave_enable = 1 << 7;
+    }
+
+    inline void enable(int volume)
+    {
+        // Maxmod can overwrite these registers when it is reconfigured, so they are committed again and again:
+        REG_SNDDMGCNT = uint16_t(SDMG_LSQR1 | SDMG_LSQR2 | SDMG_LWAVE | SDMG_LNOISE |
+                                 SDMG_RSQR1 | SDMG_RSQR2 | SDMG_RWAVE | SDMG_RNOISE | (volume << 4) | volume);
+        REG_SNDDSCNT = uint16_t((REG_SNDDSCNT & ~0x3) | SDS_DMG100);
+        REG_SNDSTAT = SSTAT_ENABLE;
+    }
+
+    inline void play_square_1(int sweep, int control, int frequency)
+    {
+        REG_SND1SWEEP = uint16_t(sweep);
+        REG_SND1CNT = uint16_t(control);
+        REG_SND1FREQ = uint16_t(frequency);
+    }
+
+    inline void play_square_2(int control, int frequency)
+    {
+        REG_SND2CNT = uint16_t(control);
+        REG_SND2FREQ = uint16_t(frequency);
+    }
+
+    inline void set_wave_pattern(const uint8_t* wave_pattern)
+    {
+        // Wave RAM writes go to the bank which is not being played:
+        REG_SND3SEL = wave_bank_1;
+
+        for(int index = 0; index < 16; index += 4)
+        {
+            (REG_WAVE_RAM)[index / 4] = unsigned(wave_pattern[index]) | (unsigned(wave_pattern[index + 1]) << 8) |
+                    (unsigned(wave_pattern[index + 2]) << 16) | (unsigned(wave_pattern[index + 3]) << 24);
+        }
+
+        REG_SND3SEL = wave_enable;
+    }
+
+    inline void play_wave(int control, int frequency)
+    {
+        REG_SND3SEL = wave_enable;
+        REG_SND3CNT = uint16_t(control);
+        REG_SND3FREQ = uint16_t(frequency);
+    }
+
+    inline void play_noise(int control, int frequency)
+    {
+        REG_SND4CNT = uint16_t(control);
+        REG_SND4FREQ = uint16_t(frequency);
+    }
+
+    inline void stop_square_1()
+    {
+        play_square_1(0, 0, SFREQ_RESET);
+    }
+
+    inline void stop_square_2()
+    {
+        play_square_2(0, SFREQ_RESET);
+    }
+
+    inline void stop_wave()
+    {
+        REG_SND3SEL = 0;
+    }
+
+    inline void stop_noise()
+    {
+        play_noise(0, SFREQ_RESET);
+    }
+}
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_EEPROM_H
+#define BN_HW_EEPROM_H
+
+#include "bn_hw_eeprom_constants.h"
+
+namespace bn::hw::eeprom
+{
+    void read_block(int block, uint8_t* destination);
+
+    [[nodiscard]] bool write_block(int block, const uint8_t* source);
+}
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_EEPROM_CONSTANTS_H
+#define BN_HW_EEPROM_CONSTANTS_H
+
+#include "bn_config_eeprom.h"
+
+namespace bn::hw::eeprom
+{
+    [[nodiscard]] constexpr int size()
+    {
+        return BN_CFG_EEPROM_SIZE;
+    }
+
+    [[nodiscard]] constexpr int block_size()
+    {
+        return 8;
+    }
+}
+
+#endif
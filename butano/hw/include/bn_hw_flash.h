@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_FLASH_H
+#define BN_HW_FLASH_H
+
+#include "bn_hw_flash_constants.h"
+
+namespace bn::hw::flash
+{
+    void read(void* destination, int size, int offset);
+
+    void start_erase_sector(int sector);
+
+    [[nodiscard]] bool erase_sector_done(int sector);
+
+    [[nodiscard]] bool erase_sector(int sector);
+
+    [[nodiscard]] bool write(const uint8_t* source, int size, int offset);
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_FLASH_CONSTANTS_H
+#define BN_HW_FLASH_CONSTANTS_H
+
+#include "bn_config_flash.h"
+
+namespace bn::hw::flash
+{
+    [[nodiscard]] constexpr int size()
+    {
+        return BN_CFG_FLASH_SIZE;
+    }
+
+    [[nodiscard]] constexpr int sector_size()
+    {
+        return 4 * 1024;
+    }
+
+    [[nodiscard]] constexpr int sectors_count()
+    {
+        return size() / sector_size();
+    }
+}
+
+#endif
@@ -16,11 +16,18 @@ namespace bn::hw::hdma
     return 3;
 }
 
+[[nodiscard]] constexpr int medium_priority_channel()
+{
+    return 2;
+}
+
 [[nodiscard]] constexpr int high_priority_channel()
 {
     return 0;
 }
 
+// DMA channel 1 is reserved for audio, and DMA channel 2 is reserved for PCM streams if they are enabled.
+
 inline void start(int channel, const uint16_t* source_ptr, int half_words, uint16_t* destination_ptr)
 {
     DMA_TRANSFER(destination_ptr, source_ptr, half_words, channel, DMA_HDMA);
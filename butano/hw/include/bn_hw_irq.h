@@ -57,6 +57,27 @@ namespace bn::hw::irq
     {
         irq_disable(eIrqIndex(irq_id));
     }
+
+    [[nodiscard]] inline unsigned enable_nested(unsigned irqs_mask)
+    {
+        // The IRQ dispatcher clears IME and the current IRQ in IE before calling an ISR,
+        // so only the given IRQs (if they are enabled) can interrupt it:
+        unsigned ie = REG_IE;
+        REG_IE = ie & irqs_mask;
+        REG_IME = 1;
+        return ie;
+    }
+
+    inline void disable_nested(unsigned ie)
+    {
+        REG_IME = 0;
+        REG_IE = ie;
+    }
+
+    [[nodiscard]] constexpr unsigned mask(id irq_id)
+    {
+        return 1U << unsigned(irq_id);
+    }
 }
 
 #endif
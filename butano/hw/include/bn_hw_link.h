@@ -7,18 +7,41 @@
 #define BN_HW_LINK_H
 
 #include "bn_hw_irq.h"
+#include "bn_config_link.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wvolatile"
 #pragma GCC diagnostic ignored "-Wpedantic"
 
-#include "../3rd_party/gba-link-connection/include/LinkConnection.h"
+#if BN_CFG_LINK_TRANSPORT == BN_LINK_TRANSPORT_WIRELESS
+    #include "../3rd_party/gba-link-connection/include/LinkWireless.h"
+#else
+    #include "../3rd_party/gba-link-connection/include/LinkConnection.h"
+#endif
 
 #pragma GCC diagnostic pop
 
+static_assert(BN_CFG_LINK_TRANSPORT == BN_LINK_TRANSPORT_CABLE ||
+              BN_CFG_LINK_TRANSPORT == BN_LINK_TRANSPORT_WIRELESS);
+
 namespace bn::hw::link
 {
-    using connection = LinkConnection;
+    #if BN_CFG_LINK_TRANSPORT == BN_LINK_TRANSPORT_WIRELESS
+        using connection = LinkWireless;
+
+        [[nodiscard]] inline connection*& _connection()
+        {
+            return linkWireless;
+        }
+    #else
+        using connection = LinkConnection;
+
+        [[nodiscard]] inline connection*& _connection()
+        {
+            return linkConnection;
+        }
+    #endif
+
     using state = LinkState;
 
     void _serial_intr();
@@ -29,38 +52,33 @@ namespace bn::hw::link
     {
         irq::enable(irq::id::SERIAL);
         irq::enable(irq::id::TIMER1);
-        linkConnection->activate();
+        _connection()->activate();
     }
 
     inline void disable()
     {
-        linkConnection->deactivate();
+        _connection()->deactivate();
         irq::disable(irq::id::TIMER1);
         irq::disable(irq::id::SERIAL);
     }
 
     inline void init(connection& connection_ref)
     {
-        linkConnection = &connection_ref;
+        _connection() = &connection_ref;
         connection_ref.init();
         irq::replace_or_push_back_disabled(irq::id::SERIAL, _serial_intr);
         irq::replace_or_push_back_disabled(irq::id::TIMER1, _timer_intr);
-        linkConnection->deactivate();
+        connection_ref.deactivate();
     }
 
-    inline void block()
+    [[nodiscard]] inline state& connection_state()
     {
-        linkConnection->block();
-    }
-
-    inline void unblock()
-    {
-        linkConnection->unblock();
+        return _connection()->linkState;
     }
 
     inline state* current_state()
     {
-        state& link_state = linkConnection->linkState;
+        state& link_state = _connection()->linkState;
 
         if(! link_state.isConnected())
         {
@@ -72,12 +90,22 @@ namespace bn::hw::link
 
     inline void send(int data_to_send)
     {
-        linkConnection->send(u16(data_to_send));
+        _connection()->send(u16(data_to_send));
+    }
+
+    [[nodiscard]] inline bool send(const uint16_t* data_to_send, int count)
+    {
+        return _connection()->send(data_to_send, count);
+    }
+
+    [[nodiscard]] constexpr int packet_start()
+    {
+        return LINK_PACKET_START;
     }
 
     inline void commit()
     {
-        linkConnection->_onVBlank();
+        _connection()->_onVBlank();
     }
 }
 
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_LINK_MULTIBOOT_H
+#define BN_HW_LINK_MULTIBOOT_H
+
+#include "bn_link_multiboot_result.h"
+
+namespace bn::hw::link_multiboot
+{
+    [[nodiscard]] link_multiboot_result send(const uint8_t* image, int size, int timeout_frames);
+}
+
+#endif
@@ -24,16 +24,36 @@ namespace bn::hw::memory
         return int(ptr) >= MEM_PAL && int(ptr) < MEM_ROM;
     }
 
+    [[nodiscard]] inline bool in_rom(const void* ptr)
+    {
+        return int(ptr) >= MEM_ROM;
+    }
+
     [[nodiscard]] int used_stack_iwram(int current_stack_address);
 
+    [[nodiscard]] int max_used_stack_iwram(int current_stack_address);
+
     [[nodiscard]] int used_static_iwram();
 
+    [[nodiscard]] int used_overlays_iwram();
+
+    [[nodiscard]] int unused_iwram(int current_stack_address);
+
     [[nodiscard]] int used_static_ewram();
 
     [[nodiscard]] char* ewram_heap_start();
 
     [[nodiscard]] char* ewram_heap_end();
 
+    [[nodiscard]] constexpr int iwram_overlays_count()
+    {
+        return 10;
+    }
+
+    [[nodiscard]] int iwram_overlay_size(int id);
+
+    void load_iwram_overlay(int id);
+
     inline void copy_bytes(const void* source, int bytes, void* destination)
     {
         tonccpy(destination, source, unsigned(bytes));
@@ -38,6 +38,15 @@ namespace bn::hw::palettes
         }
     }
 
+    BN_CODE_IWRAM void _lut_effect(const color* source_colors_ptr, const uint8_t* lut, int count,
+                                   color* destination_colors_ptr);
+
+    BN_CODE_IWRAM void _brightness(const color* source_colors_ptr, int value, int count,
+                                   color* destination_colors_ptr);
+
+    BN_CODE_IWRAM void _aligned_brightness(const color* source_colors_ptr, int value, int count,
+                                           color* destination_colors_ptr);
+
     void brightness(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr);
 
     void contrast(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr);
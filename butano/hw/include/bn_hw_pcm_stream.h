@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_PCM_STREAM_H
+#define BN_HW_PCM_STREAM_H
+
+#include "bn_assert.h"
+#include "bn_hw_tonc.h"
+#include "bn_audio_mixing_rate.h"
+
+namespace bn::hw::pcm_stream
+{
+    [[nodiscard]] constexpr int dma_channel()
+    {
+        return 2;
+    }
+
+    [[nodiscard]] constexpr int samples_per_frame(int mixing_rate)
+    {
+        // Maxmod timer 0 overflows this number of times per frame, so samples are synced with the display:
+        switch(mixing_rate)
+        {
+
+        case BN_AUDIO_MIXING_RATE_8_KHZ:
+            return 136;
+
+        case BN_AUDIO_MIXING_RATE_10_KHZ:
+            return 176;
+
+        case BN_AUDIO_MIXING_RATE_13_KHZ:
+            return 224;
+
+        case BN_AUDIO_MIXING_RATE_16_KHZ:
+            return 264;
+
+        case BN_AUDIO_MIXING_RATE_18_KHZ:
+            return 304;
+
+        case BN_AUDIO_MIXING_RATE_21_KHZ:
+            return 352;
+
+        case BN_AUDIO_MIXING_RATE_27_KHZ:
+            return 448;
+
+        case BN_AUDIO_MIXING_RATE_31_KHZ:
+            return 528;
+
+        default:
+            BN_ERROR("Invalid mixing rate: ", mixing_rate);
+        }
+    }
+
+    inline void start(const int8_t* buffer)
+    {
+        constexpr uint16_t direct_sound_b_mask = SDS_B100 | SDS_BR | SDS_BL | SDS_BTMR1;
+
+        REG_DMA[dma_channel()].cnt = 0;
+        REG_SNDDSCNT = (REG_SNDDSCNT & ~direct_sound_b_mask) | SDS_B100 | SDS_BR | SDS_BL | SDS_BTMR0 | SDS_BRESET;
+        REG_DMA[dma_channel()].src = buffer;
+        REG_DMA[dma_channel()].dst = const_cast<uint32_t*>(&REG_FIFO_B);
+        REG_DMA[dma_channel()].cnt = DMA_DST_FIXED | DMA_REPEAT | DMA_32 | DMA_AT_FIFO | DMA_ENABLE;
+    }
+
+    inline void restart(const int8_t* buffer)
+    {
+        REG_DMA[dma_channel()].cnt = 0;
+        REG_DMA[dma_channel()].src = buffer;
+        REG_DMA[dma_channel()].cnt = DMA_DST_FIXED | DMA_REPEAT | DMA_32 | DMA_AT_FIFO | DMA_ENABLE;
+    }
+
+    inline void stop()
+    {
+        REG_DMA[dma_channel()].cnt = 0;
+        REG_SNDDSCNT &= ~(SDS_BR | SDS_BL);
+    }
+}
+
+#endif
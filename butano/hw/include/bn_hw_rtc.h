@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_RTC_H
+#define BN_HW_RTC_H
+
+#include "bn_common.h"
+
+namespace bn::hw::rtc
+{
+    [[nodiscard]] constexpr int time_bytes()
+    {
+        return 7;
+    }
+
+    [[nodiscard]] bool init();
+
+    void start_time_read();
+
+    [[nodiscard]] int read_byte();
+
+    void stop();
+}
+
+#endif
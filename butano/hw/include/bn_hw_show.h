@@ -9,7 +9,7 @@
 #include "bn_config_assert.h"
 #include "bn_config_profiler.h"
 
-#if BN_CFG_ASSERT_ENABLED
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED
     #include "bn_string_fwd.h"
 
     namespace bn
@@ -20,7 +20,7 @@
 
 namespace bn::hw::show
 {
-    #if BN_CFG_ASSERT_ENABLED
+    #if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED
         void error(const string_view& condition, const string_view& file_name, const string_view& function, int line,
                    const string_view& message);
     #endif
@@ -40,6 +40,37 @@ namespace bn::hw::sprite_tiles
         return tile_vram(index);
     }
 
+    inline void decompress(const tile* source_tiles_ptr, compression_type compression, tile* destination_tiles_ptr)
+    {
+        switch(compression)
+        {
+
+        case compression_type::LZ77:
+            hw::decompress::lz77_wram(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        case compression_type::RUN_LENGTH:
+            hw::decompress::rl_wram(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        case compression_type::LZ4:
+            hw::decompress::lz4(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        case compression_type::HUFFMAN:
+            hw::decompress::huffman(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        case compression_type::LZ77_HUFFMAN:
+            hw::decompress::lz77_huffman_wram(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        default:
+            BN_ERROR("Invalid compression type: ", int(compression));
+            break;
+        }
+    }
+
     inline void commit(const tile* source_tiles_ptr, compression_type compression, int index, int count)
     {
         tile* destination_tiles_ptr = tile_vram(index);
@@ -59,12 +90,41 @@ namespace bn::hw::sprite_tiles
             hw::decompress::rl_vram(source_tiles_ptr, destination_tiles_ptr);
             break;
 
+        case compression_type::LZ4:
+            hw::decompress::lz4(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        case compression_type::HUFFMAN:
+            hw::decompress::huffman(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
+        case compression_type::LZ77_HUFFMAN:
+            hw::decompress::lz77_huffman_vram(source_tiles_ptr, destination_tiles_ptr);
+            break;
+
         default:
             BN_ERROR("Unknown compression type: ", int(compression));
             break;
         }
     }
 
+    inline int commit_delta(const uint32_t* delta_ptr, tile* destination_tiles_ptr)
+    {
+        auto destination_words_ptr = reinterpret_cast<uint32_t*>(destination_tiles_ptr);
+        int bytes = 0;
+
+        // Each run of changed words starts with its offset in the high half word and its size in the low half word:
+        while(uint32_t run = *delta_ptr)
+        {
+            int words = int(run & 0xFFFF);
+            hw::memory::copy_words(delta_ptr + 1, words, destination_words_ptr + (run >> 16));
+            delta_ptr += words + 1;
+            bytes += words * 4;
+        }
+
+        return bytes;
+    }
+
     void plot_tiles(int width, const tile* source_tiles_ptr, int source_height, int source_y, int destination_y,
                     tile* destination_tiles_ptr);
 
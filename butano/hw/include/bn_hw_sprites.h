@@ -178,6 +178,11 @@ namespace bn::hw::sprites
         BN_BFN_SET(sprite.attr1, int(shape_size.size()), ATTR1_SIZE);
     }
 
+    [[nodiscard]] inline int tiles_id(const handle_type& sprite)
+    {
+        return BN_BFN_GET(sprite.attr2, ATTR2_ID);
+    }
+
     inline void set_tiles(int tiles_id, handle_type& sprite)
     {
         BN_BFN_SET(sprite.attr2, tiles_id, ATTR2_ID);
@@ -320,6 +325,12 @@ namespace bn::hw::sprites
         hw::memory::copy_words((&sprites_ref) + offset, count * int(sizeof(handle_type) / 4), vram() + offset);
     }
 
+    inline void dma_commit(const handle_type& sprites_ref, int offset, int count)
+    {
+        // The low priority HDMA channel can be overwritten, since it is restarted by the HDMA commit after this one:
+        DMA_TRANSFER(vram() + offset, (&sprites_ref) + offset, count * int(sizeof(handle_type) / 4), 3, DMA_CPY32);
+    }
+
     [[nodiscard]] inline uint16_t* first_attributes_register(int id)
     {
         handle_type& handle = vram()[id];
@@ -14,6 +14,11 @@ namespace bn::hw::sram
 
     void _copy(const uint8_t* source, int size, uint8_t* destination);
 
+    [[nodiscard]] inline volatile uint8_t* data()
+    {
+        return reinterpret_cast<volatile uint8_t*>(MEM_SRAM);
+    }
+
     inline void write(const void* source, int size, int offset)
     {
         auto source_ptr = reinterpret_cast<const uint8_t*>(source);
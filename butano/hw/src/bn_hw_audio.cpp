@@ -6,9 +6,11 @@
 #include "../include/bn_hw_audio.h"
 
 #include "maxmod.h"
+#include "bn_spsc_ring.h"
 #include "bn_forward_list.h"
 #include "bn_config_audio.h"
 #include "../include/bn_hw_irq.h"
+#include "../include/bn_hw_timer.h"
 
 extern const uint8_t _bn_audio_soundbank_bin[];
 
@@ -19,6 +21,14 @@ namespace
 {
     static_assert(BN_CFG_AUDIO_MAX_MUSIC_CHANNELS > 0, "Invalid max music channels");
     static_assert(BN_CFG_AUDIO_MAX_SOUND_CHANNELS > 0, "Invalid max sound channels");
+    static_assert(BN_CFG_AUDIO_MAX_MIXING_RATE >= BN_CFG_AUDIO_MIXING_RATE, "Invalid max mixing rate");
+    static_assert(power_of_two(BN_CFG_AUDIO_MAX_MUSIC_EVENTS), "Invalid max music events");
+    static_assert(BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES >= 0 && BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES < 65536,
+                  "Invalid sound collapse frames");
+
+    constexpr int default_sound_speed = 1024;
+    constexpr int default_sound_volume = 255;
+    constexpr int default_sound_panning = 128;
 
 
     class sound_type
@@ -27,6 +37,11 @@ namespace
     public:
         mm_sfxhand handle;
         int16_t priority;
+        uint16_t id;
+        uint16_t speed;
+        uint16_t frame;
+        uint8_t volume;
+        uint8_t panning;
     };
 
 
@@ -35,8 +50,14 @@ namespace
 
     public:
         forward_list<sound_type, BN_CFG_AUDIO_MAX_SOUND_CHANNELS> sounds_queue;
+        spsc_ring<uint8_t, BN_CFG_AUDIO_MAX_MUSIC_EVENTS> music_events;
         func_type hp_vblank_function = nullptr;
         func_type lp_vblank_function = nullptr;
+        int mixing_rate = BN_CFG_AUDIO_MIXING_RATE;
+        int max_music_channels = BN_CFG_AUDIO_MAX_MUSIC_CHANNELS;
+        int max_sound_channels = BN_CFG_AUDIO_MAX_SOUND_CHANNELS;
+        int mixer_ticks = 0;
+        uint16_t frame = 0;
         uint16_t stat_value = 0;
         uint16_t direct_sound_control_value = 0;
         bool update_on_vblank = false;
@@ -46,9 +67,9 @@ namespace
     BN_DATA_EWRAM static_data data;
 
 
-    constexpr int _mix_length()
+    constexpr int _mix_length(int mixing_rate)
     {
-        switch(BN_CFG_AUDIO_MIXING_RATE)
+        switch(mixing_rate)
         {
 
         case BN_AUDIO_MIXING_RATE_8_KHZ:
@@ -76,28 +97,40 @@ namespace
             return MM_MIXLEN_31KHZ;
 
         default:
-            BN_ERROR("Invalid maxing rate: ", BN_CFG_AUDIO_MIXING_RATE);
+            BN_ERROR("Invalid mixing rate: ", mixing_rate);
         }
     }
 
     constexpr int _max_channels = BN_CFG_AUDIO_MAX_MUSIC_CHANNELS + BN_CFG_AUDIO_MAX_SOUND_CHANNELS;
 
+    constexpr int _max_mix_length = _mix_length(BN_CFG_AUDIO_MAX_MIXING_RATE);
+
     alignas(int) BN_DATA_EWRAM uint8_t maxmod_engine_buffer[
-            _max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH) + _mix_length()];
+            _max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH)];
 
-    alignas(int) uint8_t maxmod_mixing_buffer[_mix_length()];
+    #if BN_CFG_AUDIO_MIXING_BUFFER_IWRAM
+        alignas(int) uint8_t maxmod_mixing_buffer[_max_mix_length];
+    #else
+        alignas(int) BN_DATA_EWRAM uint8_t maxmod_mixing_buffer[_max_mix_length];
+    #endif
+
+    #if BN_CFG_AUDIO_WAVE_BUFFER_IWRAM
+        alignas(int) uint8_t maxmod_wave_buffer[_max_mix_length];
+    #else
+        alignas(int) BN_DATA_EWRAM uint8_t maxmod_wave_buffer[_max_mix_length];
+    #endif
 
 
     void _check_sounds_queue()
     {
-        if(data.sounds_queue.full())
+        if(int(data.sounds_queue.size()) >= data.max_sound_channels)
         {
             mmEffectRelease(data.sounds_queue.front().handle);
             data.sounds_queue.pop_front();
         }
     }
 
-    void _add_sound_to_queue(int priority, mm_sfxhand handle)
+    void _add_sound_to_queue(const sound_type& new_sound)
     {
         auto before_it = data.sounds_queue.before_begin();
         auto it = data.sounds_queue.begin();
@@ -107,7 +140,7 @@ namespace
         {
             sound_type& sound = *it;
 
-            if(sound.priority <= priority)
+            if(sound.priority <= new_sound.priority)
             {
                 before_it = it;
                 ++it;
@@ -118,15 +151,71 @@ namespace
             }
         }
 
-        data.sounds_queue.insert_after(before_it, sound_type{ handle, int16_t(priority) });
+        data.sounds_queue.insert_after(before_it, new_sound);
+    }
+
+    void _add_sound_to_queue(int priority, int id, int volume, int speed, int panning, mm_sfxhand handle)
+    {
+        _add_sound_to_queue(sound_type{ handle, int16_t(priority), uint16_t(id), uint16_t(speed), data.frame,
+                                        uint8_t(volume), uint8_t(panning) });
+    }
+
+    [[nodiscard]] bool _collapse_sound(int priority, int id, int volume, int speed, int panning)
+    {
+        if(! BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES)
+        {
+            return false;
+        }
+
+        auto before_it = data.sounds_queue.before_begin();
+        auto it = data.sounds_queue.begin();
+        auto end = data.sounds_queue.end();
+
+        while(it != end)
+        {
+            sound_type& sound = *it;
+
+            if(sound.id == id && sound.speed == speed && sound.panning == panning &&
+                    uint16_t(data.frame - sound.frame) <= BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES &&
+                    mmEffectActive(sound.handle))
+            {
+                // The new instance is mostly masked by the active one, so only half of its volume is added:
+                sound_type collapsed_sound = sound;
+                collapsed_sound.priority = int16_t(max(int(sound.priority), priority));
+                collapsed_sound.volume = uint8_t(min(sound.volume + (volume / 2), default_sound_volume));
+                mmEffectVolume(collapsed_sound.handle, mm_word(collapsed_sound.volume));
+
+                data.sounds_queue.erase_after(before_it);
+                _add_sound_to_queue(collapsed_sound);
+                return true;
+            }
+
+            before_it = it;
+            ++it;
+        }
+
+        return false;
     }
 
     void _commit()
     {
+        unsigned mixer_start_ticks = timer::ticks();
         mmFrame();
+        data.mixer_ticks = int(timer::ticks() - mixer_start_ticks);
         data.lp_vblank_function();
     }
 
+    mm_word _event_handler(mm_word message, mm_word parameter)
+    {
+        // mmFrame can be called from the V-Blank handler, so events are queued in a lock-free ring:
+        if(message == MMCB_SONGMESSAGE)
+        {
+            data.music_events.push(uint8_t(parameter));
+        }
+
+        return 0;
+    }
+
     void _vblank_handler()
     {
         data.hp_vblank_function();
@@ -136,6 +225,29 @@ namespace
             _commit();
         }
     }
+
+    void _init_maxmod()
+    {
+        // Channels are packed at the beginning of the engine buffer, so fewer channels leave unused space at the end:
+        int channels = data.max_music_channels + data.max_sound_channels;
+        uint8_t* active_channels = maxmod_engine_buffer + (channels * MM_SIZEOF_MODCH);
+        uint8_t* mixing_channels = active_channels + (channels * MM_SIZEOF_ACTCH);
+
+        mm_gba_system maxmod_info;
+        maxmod_info.mixing_mode = mm_mixmode(data.mixing_rate);
+        maxmod_info.mod_channel_count = mm_word(channels);
+        maxmod_info.mix_channel_count = mm_word(channels);
+        maxmod_info.module_channels = mm_addr(maxmod_engine_buffer);
+        maxmod_info.active_channels = mm_addr(active_channels);
+        maxmod_info.mixing_channels = mm_addr(mixing_channels);
+        maxmod_info.mixing_memory = mm_addr(maxmod_mixing_buffer);
+        maxmod_info.wave_memory = mm_addr(maxmod_wave_buffer);
+        maxmod_info.soundbank = mm_addr(_bn_audio_soundbank_bin);
+        mmInit(&maxmod_info);
+
+        mmSetVBlankHandler(reinterpret_cast<void*>(_vblank_handler));
+        mmSetEventHandler(_event_handler);
+    }
 }
 
 void init(func_type hp_vblank_function, func_type lp_vblank_function)
@@ -144,22 +256,7 @@ void init(func_type hp_vblank_function, func_type lp_vblank_function)
     data.lp_vblank_function = lp_vblank_function;
 
     irq::replace_or_push_back_enabled(irq::id::VBLANK, mmVBlank);
-
-    mm_gba_system maxmod_info;
-    maxmod_info.mixing_mode = mm_mixmode(BN_CFG_AUDIO_MIXING_RATE);
-    maxmod_info.mod_channel_count = _max_channels;
-    maxmod_info.mix_channel_count = _max_channels;
-    maxmod_info.module_channels = mm_addr(maxmod_engine_buffer);
-    maxmod_info.active_channels = mm_addr(maxmod_engine_buffer + (_max_channels * MM_SIZEOF_MODCH));
-    maxmod_info.mixing_channels = mm_addr(maxmod_engine_buffer +
-            (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH)));
-    maxmod_info.mixing_memory = mm_addr(maxmod_mixing_buffer);
-    maxmod_info.wave_memory = mm_addr(maxmod_engine_buffer +
-            (_max_channels * (MM_SIZEOF_MODCH + MM_SIZEOF_ACTCH + MM_SIZEOF_MIXCH)));
-    maxmod_info.soundbank = mm_addr(_bn_audio_soundbank_bin);
-    mmInit(&maxmod_info);
-
-    mmSetVBlankHandler(reinterpret_cast<void*>(_vblank_handler));
+    _init_maxmod();
 }
 
 void enable()
@@ -180,12 +277,23 @@ void disable()
 
 void play_sound(int priority, int id)
 {
+    if(_collapse_sound(priority, id, default_sound_volume, default_sound_speed, default_sound_panning))
+    {
+        return;
+    }
+
     _check_sounds_queue();
-    _add_sound_to_queue(priority, mmEffect(mm_word(id)));
+    _add_sound_to_queue(priority, id, default_sound_volume, default_sound_speed, default_sound_panning,
+                        mmEffect(mm_word(id)));
 }
 
 void play_sound(int priority, int id, int volume, int speed, int panning)
 {
+    if(_collapse_sound(priority, id, volume, speed, panning))
+    {
+        return;
+    }
+
     mm_sound_effect sound_effect;
     sound_effect.id = mm_word(id);
     sound_effect.rate = mm_hword(speed);
@@ -193,7 +301,7 @@ void play_sound(int priority, int id, int volume, int speed, int panning)
     sound_effect.volume = mm_byte(volume);
     sound_effect.panning = mm_byte(panning);
     _check_sounds_queue();
-    _add_sound_to_queue(priority, mmEffectEx(&sound_effect));
+    _add_sound_to_queue(priority, id, volume, speed, panning, mmEffectEx(&sound_effect));
 }
 
 void stop_all_sounds()
@@ -202,6 +310,47 @@ void stop_all_sounds()
     data.sounds_queue.clear();
 }
 
+bool pop_music_event(uint8_t& event)
+{
+    return data.music_events.pop(event);
+}
+
+int mixing_rate()
+{
+    return data.mixing_rate;
+}
+
+int max_music_channels()
+{
+    return data.max_music_channels;
+}
+
+int max_sound_channels()
+{
+    return data.max_sound_channels;
+}
+
+void reconfigure(int mixing_rate, int max_music_channels, int max_sound_channels)
+{
+    mmStop();
+    stop_all_sounds();
+
+    data.mixing_rate = mixing_rate;
+    data.max_music_channels = max_music_channels;
+    data.max_sound_channels = max_sound_channels;
+
+    // Interrupts are disabled to avoid running the V-Blank mixer with a partially initialized state:
+    uint16_t ime = REG_IME;
+    REG_IME = 0;
+    _init_maxmod();
+    REG_IME = ime;
+}
+
+int mixer_ticks()
+{
+    return data.mixer_ticks;
+}
+
 bool update_on_vblank()
 {
     return data.update_on_vblank;
@@ -223,6 +372,7 @@ void update()
     auto it = data.sounds_queue.begin();
     auto end = data.sounds_queue.end();
     data.delay_commit = ! data.update_on_vblank;
+    ++data.frame;
 
     while(it != end)
     {
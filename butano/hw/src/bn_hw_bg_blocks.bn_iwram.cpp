@@ -27,4 +27,31 @@ void _commit_offset_words(const unsigned* source_data_ptr, unsigned words, unsig
     }
 }
 
+void _copy_regular_map_cells_backward(const uint16_t* source_ptr, int count, uint16_t offset,
+                                      uint16_t* destination_ptr)
+{
+    for(int index = count - 1; index >= 0; --index)
+    {
+        destination_ptr[index] = source_ptr[index] + offset;
+    }
+}
+
+void _copy_affine_map_cells(const uint8_t* source_ptr, int count, uint8_t offset, uint8_t* destination_ptr)
+{
+    if(destination_ptr > source_ptr && destination_ptr < source_ptr + count)
+    {
+        for(int index = count - 1; index >= 0; --index)
+        {
+            destination_ptr[index] = uint8_t(source_ptr[index] + offset);
+        }
+    }
+    else
+    {
+        for(int index = 0; index < count; ++index)
+        {
+            destination_ptr[index] = uint8_t(source_ptr[index] + offset);
+        }
+    }
+}
+
 }
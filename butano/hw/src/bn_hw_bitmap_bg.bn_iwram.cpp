@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_bitmap_bg.h"
+
+namespace bn::hw::bitmap_bg
+{
+
+namespace
+{
+    // VRAM doesn't allow 8 bit writes, so pixels are written inside their half words:
+    [[gnu::always_inline]] inline void _set_pixel(int x, unsigned color_index, uint16_t* row_ptr)
+    {
+        uint16_t& pixels = row_ptr[x >> 1];
+
+        if(x & 1)
+        {
+            pixels = uint16_t((pixels & 0x00FF) | (color_index << 8));
+        }
+        else
+        {
+            pixels = uint16_t((pixels & 0xFF00) | color_index);
+        }
+    }
+}
+
+void fill_rect(int x, int y, int width, int height, int color_index, uint16_t* page_ptr)
+{
+    auto color = unsigned(color_index) & 0xFF;
+    auto pixels = uint16_t(color | (color << 8));
+    int first_x = x;
+    int last_x = x + width;
+    uint16_t* row_ptr = page_ptr + (y * pitch());
+
+    for(int row = 0; row < height; ++row)
+    {
+        int row_first_x = first_x;
+        int row_last_x = last_x;
+
+        if(row_first_x & 1)
+        {
+            _set_pixel(row_first_x, color, row_ptr);
+            ++row_first_x;
+        }
+
+        if(row_last_x & 1)
+        {
+            --row_last_x;
+            _set_pixel(row_last_x, color, row_ptr);
+        }
+
+        for(int index = row_first_x >> 1, limit = row_last_x >> 1; index < limit; ++index)
+        {
+            row_ptr[index] = pixels;
+        }
+
+        row_ptr += pitch();
+    }
+}
+
+void copy_rect(const uint8_t* source_ptr, int source_pitch, int x, int y, int width, int height,
+               uint16_t* page_ptr)
+{
+    uint16_t* row_ptr = page_ptr + (y * pitch());
+
+    for(int row = 0; row < height; ++row)
+    {
+        int destination_x = x;
+        int index = 0;
+
+        if(destination_x & 1)
+        {
+            _set_pixel(destination_x, source_ptr[0], row_ptr);
+            ++destination_x;
+            ++index;
+        }
+
+        for(; index + 1 < width; index += 2)
+        {
+            row_ptr[destination_x >> 1] = uint16_t(source_ptr[index] | (source_ptr[index + 1] << 8));
+            destination_x += 2;
+        }
+
+        if(index < width)
+        {
+            _set_pixel(destination_x, source_ptr[index], row_ptr);
+        }
+
+        source_ptr += source_pitch;
+        row_ptr += pitch();
+    }
+}
+
+void copy_masked_rect(const uint8_t* source_ptr, int source_pitch, int x, int y, int width, int height,
+                      uint16_t* page_ptr)
+{
+    uint16_t* row_ptr = page_ptr + (y * pitch());
+
+    for(int row = 0; row < height; ++row)
+    {
+        for(int index = 0; index < width; ++index)
+        {
+            // Color index 0 is transparent:
+            if(unsigned color_index = source_ptr[index])
+            {
+                _set_pixel(x + index, color_index, row_ptr);
+            }
+        }
+
+        source_ptr += source_pitch;
+        row_ptr += pitch();
+    }
+}
+
+void copy_page_rect(const uint16_t* source_page_ptr, int x, int y, int width, int height,
+                    uint16_t* destination_page_ptr)
+{
+    int first_index = x >> 1;
+    int last_index = (x + width + 1) >> 1;
+    int offset = y * pitch();
+    const uint16_t* source_row_ptr = source_page_ptr + offset;
+    uint16_t* destination_row_ptr = destination_page_ptr + offset;
+
+    for(int row = 0; row < height; ++row)
+    {
+        for(int index = first_index; index < last_index; ++index)
+        {
+            destination_row_ptr[index] = source_row_ptr[index];
+        }
+
+        source_row_ptr += pitch();
+        destination_row_ptr += pitch();
+    }
+}
+
+void draw_line(int x0, int y0, int x1, int y1, int color_index, uint16_t* page_ptr)
+{
+    auto color = unsigned(color_index) & 0xFF;
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+    int step_x = x0 < x1 ? 1 : -1;
+    int step_y = y0 < y1 ? 1 : -1;
+    int error = dx + dy;
+
+    while(true)
+    {
+        _set_pixel(x0, color, page_ptr + (y0 * pitch()));
+
+        if(x0 == x1 && y0 == y1)
+        {
+            break;
+        }
+
+        int error2 = error * 2;
+
+        if(error2 >= dy)
+        {
+            error += dy;
+            x0 += step_x;
+        }
+
+        if(error2 <= dx)
+        {
+            error += dx;
+            y0 += step_y;
+        }
+    }
+}
+
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_decompress.h"
+
+namespace bn::hw::decompress
+{
+
+namespace
+{
+    class lz4_writer
+    {
+
+    public:
+        explicit lz4_writer(void* destination) :
+            _words(static_cast<unsigned*>(destination)),
+            _bytes(static_cast<const uint8_t*>(destination))
+        {
+        }
+
+        [[nodiscard]] int size() const
+        {
+            return _size;
+        }
+
+        void write_byte(unsigned byte)
+        {
+            _pending |= byte << ((_size & 3) * 8);
+            ++_size;
+
+            if(! (_size & 3))
+            {
+                _words[(_size >> 2) - 1] = _pending;
+                _pending = 0;
+            }
+        }
+
+        void write_word(unsigned word)
+        {
+            _words[_size >> 2] = word;
+            _size += 4;
+        }
+
+        [[nodiscard]] bool aligned() const
+        {
+            return ! (_size & 3);
+        }
+
+        [[nodiscard]] unsigned read_byte(int distance) const
+        {
+            int position = _size - distance;
+
+            if(position >= (_size & ~3))
+            {
+                return (_pending >> ((position & 3) * 8)) & 0xFF;
+            }
+
+            return _bytes[position];
+        }
+
+        [[nodiscard]] unsigned read_word(int distance) const
+        {
+            return _words[(_size - distance) >> 2];
+        }
+
+        void flush()
+        {
+            // Half word writes, since byte writes are not supported in VRAM (odd sizes are supported in WRAM only):
+            if(int pending_bytes = _size & 3)
+            {
+                auto half_words = reinterpret_cast<uint16_t*>(_words + (_size >> 2));
+
+                if(pending_bytes >= 2)
+                {
+                    half_words[0] = uint16_t(_pending);
+                }
+
+                if(pending_bytes & 1)
+                {
+                    auto bytes = reinterpret_cast<uint8_t*>(half_words);
+                    bytes[pending_bytes - 1] = uint8_t(_pending >> ((pending_bytes - 1) * 8));
+                }
+            }
+        }
+
+    private:
+        unsigned* _words;
+        const uint8_t* _bytes;
+        unsigned _pending = 0;
+        int _size = 0;
+    };
+
+    [[nodiscard]] int _read_length(int length, const uint8_t*& source)
+    {
+        if(length == 15)
+        {
+            unsigned extra_length;
+
+            do
+            {
+                extra_length = *source;
+                ++source;
+                length += int(extra_length);
+            }
+            while(extra_length == 255);
+        }
+
+        return length;
+    }
+}
+
+void lz4(const void* src, void* dst)
+{
+    // Header compatible with GBA BIOS compressed data (type 4 in the high nibble of the first byte),
+    // followed by LZ4 block sequences:
+    auto source = static_cast<const uint8_t*>(src);
+    int decompressed_size = int(source[1] | (source[2] << 8) | (source[3] << 16));
+    source += 4;
+
+    lz4_writer writer(dst);
+
+    while(writer.size() < decompressed_size)
+    {
+        unsigned token = *source;
+        ++source;
+
+        int literals = _read_length(int(token >> 4), source);
+
+        while(literals && ! writer.aligned())
+        {
+            writer.write_byte(*source);
+            ++source;
+            --literals;
+        }
+
+        while(literals >= 4)
+        {
+            writer.write_word(unsigned(source[0]) | (unsigned(source[1]) << 8) | (unsigned(source[2]) << 16) |
+                              (unsigned(source[3]) << 24));
+            source += 4;
+            literals -= 4;
+        }
+
+        while(literals)
+        {
+            writer.write_byte(*source);
+            ++source;
+            --literals;
+        }
+
+        if(writer.size() >= decompressed_size)
+        {
+            break;
+        }
+
+        int distance = int(source[0] | (source[1] << 8));
+        source += 2;
+
+        int length = _read_length(int(token & 15), source) + 4;
+
+        if(distance % 4 == 0)
+        {
+            while(length && ! writer.aligned())
+            {
+                writer.write_byte(writer.read_byte(distance));
+                --length;
+            }
+
+            while(length >= 4)
+            {
+                writer.write_word(writer.read_word(distance));
+                length -= 4;
+            }
+        }
+
+        while(length)
+        {
+            writer.write_byte(writer.read_byte(distance));
+            --length;
+        }
+    }
+
+    writer.flush();
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_decompress.h"
+
+#include "bn_assert.h"
+#include "bn_memory.h"
+
+namespace bn::hw::decompress
+{
+
+namespace
+{
+    [[nodiscard]] void* _huffman_to_staging(const void* src)
+    {
+        // LZ77 data is Huffman compressed, so it is decompressed first to an EWRAM staging buffer:
+        auto source = static_cast<const uint8_t*>(src);
+        int staging_bytes = int(source[1] | (source[2] << 8) | (source[3] << 16));
+        void* staging_ptr = bn::memory::ewram_alloc((staging_bytes + 3) & ~3);
+        BN_ASSERT(staging_ptr, "LZ77 staging buffer allocation failed: ", staging_bytes);
+
+        huffman(src, staging_ptr);
+        return staging_ptr;
+    }
+}
+
+void lz77_huffman_wram(const void* src, void* dst)
+{
+    void* staging_ptr = _huffman_to_staging(src);
+    lz77_wram(staging_ptr, dst);
+    bn::memory::ewram_free(staging_ptr);
+}
+
+void lz77_huffman_vram(const void* src, void* dst)
+{
+    void* staging_ptr = _huffman_to_staging(src);
+    lz77_vram(staging_ptr, dst);
+    bn::memory::ewram_free(staging_ptr);
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_eeprom.h"
+
+#include "../include/bn_hw_tonc.h"
+
+// http://problemkaputt.de/gbatek.htm#gbacartbackupeeprom
+
+namespace bn::hw::eeprom
+{
+
+static_assert(BN_CFG_EEPROM_SIZE == 0 || BN_CFG_EEPROM_SIZE == 512 || BN_CFG_EEPROM_SIZE == 8 * 1024);
+
+namespace
+{
+    #if BN_CFG_EEPROM_SIZE
+        alignas(int) __attribute__((used)) const char save_type[] = "EEPROM_V124";
+    #endif
+
+    constexpr int address_bits = size() > 512 ? 14 : 6;
+
+    // Approximate number of status reads before giving up (writing a block takes less than 10ms):
+    constexpr int max_write_status_reads = 1 << 16;
+
+    [[nodiscard]] volatile uint16_t* _memory()
+    {
+        return reinterpret_cast<volatile uint16_t*>(0x0DFFFF00);
+    }
+
+    // EEPROM must be accessed with DMA3 and 8 wait states, without interrupts:
+    class access_lock
+    {
+
+    public:
+        access_lock() :
+            _ime(REG_IME),
+            _waitcnt(REG_WAITCNT)
+        {
+            REG_IME = 0;
+            REG_WAITCNT = uint16_t((_waitcnt & ~(WS_ROM2_N8 | WS_ROM2_S1)) | WS_ROM2_N8);
+        }
+
+        ~access_lock()
+        {
+            REG_WAITCNT = _waitcnt;
+            REG_IME = _ime;
+        }
+
+    private:
+        uint16_t _ime;
+        uint16_t _waitcnt;
+    };
+
+    void _transfer(const volatile void* source, volatile void* destination, int halfwords)
+    {
+        REG_DMA3SAD = uint32_t(source);
+        REG_DMA3DAD = uint32_t(destination);
+        REG_DMA3CNT = DMA_CPY16 | uint32_t(halfwords);
+
+        while(REG_DMA3CNT & DMA_ENABLE)
+        {
+        }
+    }
+
+    [[nodiscard]] int _write_header(int block, int request, uint16_t* bits)
+    {
+        int bits_count = 0;
+        bits[bits_count++] = 1;
+        bits[bits_count++] = uint16_t(request);
+
+        for(int bit = address_bits - 1; bit >= 0; --bit)
+        {
+            bits[bits_count++] = uint16_t((block >> bit) & 1);
+        }
+
+        return bits_count;
+    }
+}
+
+void read_block(int block, uint8_t* destination)
+{
+    uint16_t bits[68];
+    int bits_count = _write_header(block, 1, bits);
+    bits[bits_count++] = 0;
+
+    {
+        access_lock lock;
+        _transfer(bits, _memory(), bits_count);
+        _transfer(_memory(), bits, 68);
+    }
+
+    // The first 4 received bits must be ignored:
+    const uint16_t* data_bits = bits + 4;
+
+    for(int byte_index = 0; byte_index < block_size(); ++byte_index)
+    {
+        unsigned value = 0;
+
+        for(int bit = 0; bit < 8; ++bit)
+        {
+            value = (value << 1) | (*data_bits & 1);
+            ++data_bits;
+        }
+
+        destination[byte_index] = uint8_t(value);
+    }
+}
+
+bool write_block(int block, const uint8_t* source)
+{
+    uint16_t bits[2 + address_bits + 64 + 1];
+    int bits_count = _write_header(block, 0, bits);
+
+    for(int byte_index = 0; byte_index < block_size(); ++byte_index)
+    {
+        unsigned value = source[byte_index];
+
+        for(int bit = 7; bit >= 0; --bit)
+        {
+            bits[bits_count++] = uint16_t((value >> bit) & 1);
+        }
+    }
+
+    bits[bits_count++] = 0;
+
+    access_lock lock;
+    _transfer(bits, _memory(), bits_count);
+
+    for(int index = 0; index < max_write_status_reads; ++index)
+    {
+        if(*_memory() & 1)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
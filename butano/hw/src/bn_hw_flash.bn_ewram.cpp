@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_flash.h"
+
+#include "bn_algorithm.h"
+#include "bn_config_eeprom.h"
+#include "../include/bn_hw_tonc.h"
+
+// Flash access code is executed from EWRAM, since reading flash status while running code from ROM
+// doesn't work on some carts:
+// http://problemkaputt.de/gbatek.htm#gbacartbackupflashrom
+
+namespace bn::hw::flash
+{
+
+static_assert(BN_CFG_FLASH_SIZE == 0 || BN_CFG_FLASH_SIZE == 64 * 1024 || BN_CFG_FLASH_SIZE == 128 * 1024);
+static_assert(BN_CFG_FLASH_SIZE == 0 || BN_CFG_EEPROM_SIZE == 0, "Flash and EEPROM can't be enabled at once");
+
+namespace
+{
+    #if BN_CFG_FLASH_SIZE == 128 * 1024
+        alignas(int) __attribute__((used)) const char save_type[] = "FLASH1M_V103";
+    #elif BN_CFG_FLASH_SIZE == 64 * 1024
+        alignas(int) __attribute__((used)) const char save_type[] = "FLASH512_V131";
+    #endif
+
+    constexpr int bank_size = 64 * 1024;
+
+    // Approximate number of status reads before giving up (erasing a sector takes less than 25ms):
+    constexpr int max_erase_status_reads = 1 << 20;
+    constexpr int max_write_status_reads = 1 << 12;
+
+    [[nodiscard]] volatile uint8_t* _memory(int offset)
+    {
+        return reinterpret_cast<volatile uint8_t*>(MEM_SRAM) + offset;
+    }
+
+    void _command(uint8_t command)
+    {
+        *_memory(0x5555) = 0xAA;
+        *_memory(0x2AAA) = 0x55;
+        *_memory(0x5555) = command;
+    }
+
+    int _set_bank(int offset)
+    {
+        // 128KB chips have two 64KB banks:
+        if constexpr(size() > bank_size)
+        {
+            _command(0xB0);
+            *_memory(0) = uint8_t(offset / bank_size);
+        }
+
+        return offset % bank_size;
+    }
+}
+
+void read(void* destination, int size, int offset)
+{
+    auto destination_ptr = static_cast<uint8_t*>(destination);
+
+    while(size > 0)
+    {
+        int bank_offset = _set_bank(offset);
+        int bank_size_left = min(size, bank_size - bank_offset);
+        volatile uint8_t* source_ptr = _memory(bank_offset);
+
+        for(int index = 0; index < bank_size_left; ++index)
+        {
+            destination_ptr[index] = source_ptr[index];
+        }
+
+        destination_ptr += bank_size_left;
+        offset += bank_size_left;
+        size -= bank_size_left;
+    }
+}
+
+void start_erase_sector(int sector)
+{
+    int bank_offset = _set_bank(sector * sector_size());
+    _command(0x80);
+    *_memory(0x5555) = 0xAA;
+    *_memory(0x2AAA) = 0x55;
+    *_memory(bank_offset) = 0x30;
+}
+
+bool erase_sector_done(int sector)
+{
+    int bank_offset = _set_bank(sector * sector_size());
+    return *_memory(bank_offset) == 0xFF;
+}
+
+bool erase_sector(int sector)
+{
+    start_erase_sector(sector);
+
+    for(int index = 0; index < max_erase_status_reads; ++index)
+    {
+        if(erase_sector_done(sector))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool write(const uint8_t* source, int size, int offset)
+{
+    int current_bank = -1;
+
+    for(int index = 0; index < size; ++index)
+    {
+        uint8_t value = source[index];
+
+        // Erased bytes are 0xFF, so they don't need to be programmed:
+        if(value != 0xFF)
+        {
+            int byte_offset = offset + index;
+            int bank = byte_offset / bank_size;
+
+            if(bank != current_bank)
+            {
+                _set_bank(byte_offset);
+                current_bank = bank;
+            }
+
+            volatile uint8_t* destination_ptr = _memory(byte_offset % bank_size);
+            _command(0xA0);
+            *destination_ptr = value;
+
+            int status_reads = 0;
+
+            while(*destination_ptr != value)
+            {
+                if(++status_reads == max_write_status_reads)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+}
@@ -5,6 +5,7 @@
 
 #include "../include/bn_hw_game_pak.h"
 
+#include "bn_array.h"
 #include "../include/bn_hw_tonc.h"
 
 namespace bn::hw::game_pak
@@ -13,6 +14,27 @@ namespace bn::hw::game_pak
 namespace
 {
     const unsigned rom_data[] = { 0x12345678, 0x00042069, 0xdeadbeef };
+
+    constexpr int probe_data_size = 64;
+
+    [[nodiscard]] constexpr unsigned _probe_value(int index)
+    {
+        // Consecutive words toggle most bits:
+        unsigned value = unsigned(index + 1) * 0x9E3779B9;
+        return index % 2 ? ~value : value;
+    }
+
+    constexpr array<unsigned, probe_data_size> probe_data = []()
+    {
+        array<unsigned, probe_data_size> result;
+
+        for(int index = 0; index < probe_data_size; ++index)
+        {
+            result[index] = _probe_value(index);
+        }
+
+        return result;
+    }();
 }
 
 bool _slow_game_pak()
@@ -45,4 +67,29 @@ bool _slow_game_pak()
     return a[0] != b[0] || a[1] != b[1] || a[2] != b[2] || a[0] != c[0] || a[1] != c[1] || a[2] != c[2];
 }
 
+bool _valid_wait_states(unsigned wait_states)
+{
+    auto data = reinterpret_cast<volatile const unsigned*>(probe_data.data());
+    bool valid = true;
+    REG_WAITCNT = wait_states;
+
+    for(int pass = 0; pass < 4; ++pass)
+    {
+        // Sequential reads:
+        for(int index = 0; index < probe_data_size; ++index)
+        {
+            valid &= data[index] == _probe_value(index);
+        }
+
+        // Non-sequential reads:
+        for(int index = probe_data_size - 1; index >= 0; index -= 3)
+        {
+            valid &= data[index] == _probe_value(index);
+        }
+    }
+
+    REG_WAITCNT = 0;
+    return valid;
+}
+
 }
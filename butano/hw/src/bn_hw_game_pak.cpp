@@ -5,7 +5,11 @@
 
 #include "../include/bn_hw_game_pak.h"
 
+#include "bn_config_sram.h"
+#include "bn_config_flash.h"
+#include "bn_config_eeprom.h"
 #include "bn_config_game_pak.h"
+#include "../include/bn_hw_sram.h"
 #include "../include/bn_hw_tonc.h"
 
 namespace bn::hw::game_pak
@@ -21,14 +25,181 @@ static_assert(BN_CFG_GAME_PAK_WAIT_STATE_SECOND == BN_GAME_PAK_WAIT_STATE_SECOND
         BN_CFG_GAME_PAK_WAIT_STATE_SECOND == BN_GAME_PAK_WAIT_STATE_SECOND_1 ||
         BN_CFG_GAME_PAK_WAIT_STATE_SECOND == BN_GAME_PAK_WAIT_STATE_SECOND_AUTO);
 
+static_assert(BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET < 0 ||
+        (BN_CFG_FLASH_SIZE == 0 && BN_CFG_EEPROM_SIZE == 0),
+        "Game Pak wait states probe result can be stored in SRAM only");
+
 [[nodiscard]] extern BN_CODE_EWRAM bool _slow_game_pak();
 
+[[nodiscard]] extern BN_CODE_EWRAM bool _valid_wait_states(unsigned wait_states);
+
+namespace
+{
+    constexpr unsigned first_wait_state_mask = 0x000C;
+    constexpr unsigned second_wait_state_mask = 0x0010;
+
+    class probe_result
+    {
+
+    public:
+        unsigned magic;
+        unsigned game_code;
+        uint16_t wait_states;
+        uint8_t complement_check;
+        uint8_t checksum;
+
+        [[nodiscard]] uint8_t calculate_checksum() const
+        {
+            auto bytes = reinterpret_cast<const uint8_t*>(this);
+            unsigned result = 0xA5;
+
+            for(int index = 0; index < int(sizeof(probe_result)) - 1; ++index)
+            {
+                result = (((result << 1) | (result >> 7)) & 0xFF) ^ bytes[index];
+            }
+
+            return uint8_t(result);
+        }
+    };
+
+    static_assert(sizeof(probe_result) == 12);
+
+    [[nodiscard]] probe_result _rom_probe_result(unsigned wait_states)
+    {
+        probe_result result;
+        result.magic = 0x53574E42; // "BNWS"
+        result.game_code = *reinterpret_cast<const unsigned*>(MEM_ROM + 0xAC);
+        result.wait_states = uint16_t(wait_states);
+        result.complement_check = *reinterpret_cast<const uint8_t*>(MEM_ROM + 0xBD);
+        result.checksum = result.calculate_checksum();
+        return result;
+    }
+
+    [[nodiscard]] bool _allowed_wait_states(unsigned wait_states)
+    {
+        if((wait_states & ~(first_wait_state_mask | second_wait_state_mask)) != 0)
+        {
+            return false;
+        }
+
+        if(BN_CFG_GAME_PAK_WAIT_STATE_FIRST != BN_GAME_PAK_WAIT_STATE_FIRST_AUTO &&
+                (wait_states & first_wait_state_mask) != unsigned(BN_CFG_GAME_PAK_WAIT_STATE_FIRST))
+        {
+            return false;
+        }
+
+        if(BN_CFG_GAME_PAK_WAIT_STATE_SECOND != BN_GAME_PAK_WAIT_STATE_SECOND_AUTO &&
+                (wait_states & second_wait_state_mask) != unsigned(BN_CFG_GAME_PAK_WAIT_STATE_SECOND))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] unsigned _probe_wait_states()
+    {
+        // Sorted by the cycles of a 4 words burst (first + 3 * second):
+        constexpr unsigned candidates[] = {
+            BN_GAME_PAK_WAIT_STATE_FIRST_2 | BN_GAME_PAK_WAIT_STATE_SECOND_1,
+            BN_GAME_PAK_WAIT_STATE_FIRST_3 | BN_GAME_PAK_WAIT_STATE_SECOND_1,
+            BN_GAME_PAK_WAIT_STATE_FIRST_4 | BN_GAME_PAK_WAIT_STATE_SECOND_1,
+            BN_GAME_PAK_WAIT_STATE_FIRST_2 | BN_GAME_PAK_WAIT_STATE_SECOND_2,
+            BN_GAME_PAK_WAIT_STATE_FIRST_3 | BN_GAME_PAK_WAIT_STATE_SECOND_2,
+            BN_GAME_PAK_WAIT_STATE_FIRST_4 | BN_GAME_PAK_WAIT_STATE_SECOND_2,
+            BN_GAME_PAK_WAIT_STATE_FIRST_8 | BN_GAME_PAK_WAIT_STATE_SECOND_1,
+            BN_GAME_PAK_WAIT_STATE_FIRST_8 | BN_GAME_PAK_WAIT_STATE_SECOND_2,
+        };
+
+        unsigned result = 0;
+
+        for(unsigned candidate : candidates)
+        {
+            if(_allowed_wait_states(candidate))
+            {
+                // The slowest allowed candidate is selected if all of them fail:
+                result = candidate;
+
+                if(_valid_wait_states(candidate))
+                {
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void _set_prefetch()
+    {
+        if(BN_CFG_GAME_PAK_PREFETCH_ENABLED)
+        {
+            BIT_SET(REG_WAITCNT_NV, WS_PREFETCH);
+        }
+        else
+        {
+            BIT_CLEAR(REG_WAITCNT_NV, WS_PREFETCH);
+        }
+    }
+
+    [[nodiscard]] unsigned _probed_wait_states()
+    {
+        if(BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET < 0)
+        {
+            return _probe_wait_states();
+        }
+
+        constexpr int sram_offset = BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET;
+        BIT_SET(REG_WAITCNT_NV, BN_CFG_SRAM_WAIT_STATE);
+
+        probe_result stored_result;
+        sram::read(&stored_result, int(sizeof(probe_result)), sram_offset);
+
+        probe_result expected_result = _rom_probe_result(stored_result.wait_states);
+        unsigned result;
+
+        if(stored_result.magic == expected_result.magic && stored_result.game_code == expected_result.game_code &&
+                stored_result.complement_check == expected_result.complement_check &&
+                stored_result.checksum == expected_result.checksum &&
+                _allowed_wait_states(stored_result.wait_states))
+        {
+            result = stored_result.wait_states;
+        }
+        else
+        {
+            result = _probe_wait_states();
+
+            probe_result new_result = _rom_probe_result(result);
+            BIT_SET(REG_WAITCNT_NV, BN_CFG_SRAM_WAIT_STATE);
+            sram::write(&new_result, int(sizeof(probe_result)), sram_offset);
+        }
+
+        REG_WAITCNT = 0;
+        return result;
+    }
+}
+
 bool init()
 {
     bool first_auto = BN_CFG_GAME_PAK_WAIT_STATE_FIRST == BN_GAME_PAK_WAIT_STATE_FIRST_AUTO;
     bool second_auto = BN_CFG_GAME_PAK_WAIT_STATE_SECOND == BN_GAME_PAK_WAIT_STATE_SECOND_AUTO;
     bool slow_game_pak = false;
 
+    if(BN_CFG_GAME_PAK_WAIT_STATE_PROBE_ENABLED && (first_auto || second_auto))
+    {
+        unsigned wait_states = _probed_wait_states();
+
+        // Slower than the wait states selected when a slow Game Pak is not detected:
+        unsigned first = wait_states & first_wait_state_mask;
+        unsigned second = wait_states & second_wait_state_mask;
+        slow_game_pak = first == BN_GAME_PAK_WAIT_STATE_FIRST_4 || first == BN_GAME_PAK_WAIT_STATE_FIRST_8 ||
+                second == BN_GAME_PAK_WAIT_STATE_SECOND_2;
+
+        BIT_SET(REG_WAITCNT_NV, wait_states);
+        _set_prefetch();
+        return slow_game_pak;
+    }
+
     if(first_auto || second_auto)
     {
         slow_game_pak = _slow_game_pak();
@@ -66,15 +237,7 @@ bool init()
         BIT_SET(REG_WAITCNT_NV, BN_CFG_GAME_PAK_WAIT_STATE_SECOND);
     }
 
-    if(BN_CFG_GAME_PAK_PREFETCH_ENABLED)
-    {
-        BIT_SET(REG_WAITCNT_NV, WS_PREFETCH);
-    }
-    else
-    {
-        BIT_CLEAR(REG_WAITCNT_NV, WS_PREFETCH);
-    }
-
+    _set_prefetch();
     return slow_game_pak;
 }
 
@@ -7,17 +7,21 @@
 
 LinkConnection* linkConnection = nullptr;
 
+#if BN_CFG_LINK_TRANSPORT == BN_LINK_TRANSPORT_WIRELESS
+    LinkWireless* linkWireless = nullptr;
+#endif
+
 namespace bn::hw::link
 {
 
 void _serial_intr()
 {
-    linkConnection->_onSerial();
+    _connection()->_onSerial();
 }
 
 void _timer_intr()
 {
-    linkConnection->_onTimer();
+    _connection()->_onTimer();
 }
 
 }
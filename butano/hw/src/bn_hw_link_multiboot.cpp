@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_link_multiboot.h"
+
+#include "../include/bn_hw_core.h"
+
+namespace bn::hw::link_multiboot
+{
+
+namespace
+{
+    // Normal mode clients are always the first one:
+    constexpr unsigned client_bit = 2;
+
+    // Palette animation shown by the client while receiving the image:
+    constexpr unsigned palette_data = 0xC1;
+
+    constexpr unsigned header_half_words = 0xC0 / 2;
+
+    constexpr int transfer_max_spins = 2048;
+
+    constexpr int client_data_timeout_frames = 60;
+
+    // The server must wait 1/16 seconds before starting the final transfer:
+    constexpr int boot_wait_frames = 4;
+
+    [[nodiscard]] bool _transfer(unsigned value, unsigned& response)
+    {
+        // The client drives SI low when it is ready to transfer:
+        int spins = transfer_max_spins;
+
+        while(REG_SIOCNT & SION_RECV_HIGH)
+        {
+            if(! --spins)
+            {
+                return false;
+            }
+        }
+
+        REG_SIODATA32 = value;
+        REG_SIOCNT = SIO_MODE_32BIT | SION_CLK_INT | SION_256KHZ | SION_ENABLE;
+        spins = transfer_max_spins;
+
+        while(REG_SIOCNT & SION_ENABLE)
+        {
+            if(! --spins)
+            {
+                return false;
+            }
+        }
+
+        // The client answers in the high half word of the received data:
+        response = REG_SIODATA32 >> 16;
+        return true;
+    }
+
+    [[nodiscard]] bool _transfer_expecting(unsigned value, unsigned expected_response)
+    {
+        unsigned response;
+        return _transfer(value, response) && response == expected_response;
+    }
+
+    [[nodiscard]] bool _wait_for_client(int timeout_frames)
+    {
+        for(int frame = 0; frame < timeout_frames; ++frame)
+        {
+            unsigned response;
+
+            if(_transfer(0x6200, response) && response == (0x7200 | client_bit))
+            {
+                return true;
+            }
+
+            core::wait_for_vblank();
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] bool _send_header(const uint8_t* image)
+    {
+        if(! _transfer_expecting(0x6100 | client_bit, 0x7200 | client_bit))
+        {
+            return false;
+        }
+
+        auto header = reinterpret_cast<const uint16_t*>(image);
+
+        for(unsigned index = 0; index < header_half_words; ++index)
+        {
+            unsigned response;
+
+            // The client answers with the remaining half words count and its bit:
+            if(! _transfer(header[index], response) || (response & 0xFF) != client_bit)
+            {
+                return false;
+            }
+        }
+
+        return _transfer_expecting(0x6200, client_bit) &&
+                _transfer_expecting(0x6200 | client_bit, 0x7200 | client_bit);
+    }
+
+    [[nodiscard]] bool _exchange_client_data(unsigned& client_data)
+    {
+        for(int frame = 0; frame < client_data_timeout_frames; ++frame)
+        {
+            unsigned response;
+
+            if(! _transfer(0x6300 | palette_data, response))
+            {
+                return false;
+            }
+
+            if((response & 0xFF00) == 0x7300)
+            {
+                client_data = response & 0xFF;
+                return true;
+            }
+
+            core::wait_for_vblank();
+        }
+
+        return false;
+    }
+}
+
+link_multiboot_result send(const uint8_t* image, int size, int timeout_frames)
+{
+    REG_RCNT = 0;
+    REG_SIOCNT = SIO_MODE_32BIT | SION_CLK_INT | SION_256KHZ;
+
+    if(! _wait_for_client(timeout_frames))
+    {
+        return link_multiboot_result::NO_CLIENT;
+    }
+
+    unsigned client_data;
+
+    if(! _send_header(image) || ! _exchange_client_data(client_data))
+    {
+        return link_multiboot_result::FAILURE;
+    }
+
+    // Absent clients data is 0xFF:
+    unsigned handshake_data = (0x11 + client_data + 0xFF + 0xFF) & 0xFF;
+
+    if(unsigned response; ! _transfer(0x6400 | handshake_data, response) || (response & 0xFF00) != 0x7300)
+    {
+        return link_multiboot_result::FAILURE;
+    }
+
+    for(int frame = 0; frame < boot_wait_frames; ++frame)
+    {
+        core::wait_for_vblank();
+    }
+
+    MultiBootParam param = {};
+    param.handshake_data = uint8_t(handshake_data);
+    param.client_data[0] = uint8_t(client_data);
+    param.client_data[1] = 0xFF;
+    param.client_data[2] = 0xFF;
+    param.palette_data = uint8_t(palette_data);
+    param.client_bit = uint8_t(client_bit);
+    param.boot_srcp = const_cast<uint8_t*>(image) + 0xC0;
+    param.boot_endp = const_cast<uint8_t*>(image) + size;
+
+    if(MultiBoot(&param, MBOOT_NORMAL))
+    {
+        return link_multiboot_result::FAILURE;
+    }
+
+    return link_multiboot_result::SUCCESS;
+}
+
+}
@@ -7,6 +7,7 @@
 
 #include "bn_random.h"
 #include "bn_config_ewram.h"
+#include "bn_config_memory.h"
 
 extern unsigned __iwram_start__;
 extern unsigned __iwram_top;
@@ -15,21 +16,75 @@ extern unsigned __ewram_start;
 extern unsigned __ewram_end;
 extern char __eheap_start[], __eheap_end[];
 
+// IWRAM overlays sections are defined in the devkitARM linker script:
+extern char __iwram_overlay_start[], __iwram_overlay_end[];
+extern char __load_start_iwram0[], __load_stop_iwram0[];
+extern char __load_start_iwram1[], __load_stop_iwram1[];
+extern char __load_start_iwram2[], __load_stop_iwram2[];
+extern char __load_start_iwram3[], __load_stop_iwram3[];
+extern char __load_start_iwram4[], __load_stop_iwram4[];
+extern char __load_start_iwram5[], __load_stop_iwram5[];
+extern char __load_start_iwram6[], __load_stop_iwram6[];
+extern char __load_start_iwram7[], __load_stop_iwram7[];
+extern char __load_start_iwram8[], __load_stop_iwram8[];
+extern char __load_start_iwram9[], __load_stop_iwram9[];
+
 namespace bn::hw::memory
 {
 
 static_assert(BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_2 ||
         BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_1);
 
-#if BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_1
-    namespace
-    {
+namespace
+{
+    #if BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_1
         BN_DATA_EWRAM unsigned ewram_data;
+    #endif
+
+    const char* const iwram_overlay_starts[] = {
+        __load_start_iwram0, __load_start_iwram1, __load_start_iwram2, __load_start_iwram3, __load_start_iwram4,
+        __load_start_iwram5, __load_start_iwram6, __load_start_iwram7, __load_start_iwram8, __load_start_iwram9
+    };
+
+    const char* const iwram_overlay_stops[] = {
+        __load_stop_iwram0, __load_stop_iwram1, __load_stop_iwram2, __load_stop_iwram3, __load_stop_iwram4,
+        __load_stop_iwram5, __load_stop_iwram6, __load_stop_iwram7, __load_stop_iwram8, __load_stop_iwram9
+    };
+
+    static_assert(sizeof(iwram_overlay_starts) / sizeof(*iwram_overlay_starts) == iwram_overlays_count());
+
+    constexpr unsigned stack_paint_value = 0xB7A5B7A5;
+
+    // Bytes below the current stack pointer which are not painted, so the painting function can't overwrite them:
+    constexpr int stack_paint_margin = 256;
+
+    [[nodiscard]] unsigned* _unused_iwram_start()
+    {
+        auto result = reinterpret_cast<unsigned>(__iwram_overlay_end);
+        result = (result + 3) & ~3U;
+        return reinterpret_cast<unsigned*>(result);
     }
-#endif
+
+    #if BN_CFG_MEMORY_STACK_PAINT_ENABLED
+        void _paint_stack_iwram()
+        {
+            unsigned* unused_iwram_start = _unused_iwram_start();
+            auto unused_iwram_end = reinterpret_cast<unsigned*>((stack_address() - stack_paint_margin) & ~3);
+
+            if(int words = unused_iwram_end - unused_iwram_start; words > 0)
+            {
+                set_words(stack_paint_value, words, unused_iwram_start);
+            }
+        }
+    #endif
+}
 
 void init()
 {
+    #if BN_CFG_MEMORY_STACK_PAINT_ENABLED
+        _paint_stack_iwram();
+    #endif
+
     #if BN_CFG_EWRAM_WAIT_STATE == BN_EWRAM_WAIT_STATE_1
         volatile unsigned& memctrl_register = *reinterpret_cast<unsigned*>(0x4000800);
         memctrl_register = 0x0E000020;
@@ -58,6 +113,25 @@ int used_stack_iwram(int current_stack_address)
     return iwram_top - iwram_stack;
 }
 
+int max_used_stack_iwram(int current_stack_address)
+{
+    #if BN_CFG_MEMORY_STACK_PAINT_ENABLED
+        // The stack grows downwards, so the lowest overwritten painted word is the stack peak:
+        const unsigned* iwram_ptr = _unused_iwram_start();
+        auto iwram_stack = reinterpret_cast<const unsigned*>(current_stack_address);
+
+        while(iwram_ptr < iwram_stack && *iwram_ptr == stack_paint_value)
+        {
+            ++iwram_ptr;
+        }
+
+        auto iwram_top = reinterpret_cast<const uint8_t*>(&__iwram_top);
+        return iwram_top - reinterpret_cast<const uint8_t*>(iwram_ptr);
+    #else
+        return used_stack_iwram(current_stack_address);
+    #endif
+}
+
 int used_static_iwram()
 {
     auto iwram_start = reinterpret_cast<uint8_t*>(&__iwram_start__);
@@ -65,6 +139,18 @@ int used_static_iwram()
     return iwram_end - iwram_start;
 }
 
+int used_overlays_iwram()
+{
+    return __iwram_overlay_end - __iwram_overlay_start;
+}
+
+int unused_iwram(int current_stack_address)
+{
+    auto iwram_start = reinterpret_cast<uint8_t*>(_unused_iwram_start());
+    auto iwram_top = reinterpret_cast<uint8_t*>(&__iwram_top);
+    return iwram_top - iwram_start - max_used_stack_iwram(current_stack_address);
+}
+
 int used_static_ewram()
 {
     auto ewram_start = reinterpret_cast<uint8_t*>(&__ewram_start);
@@ -82,4 +168,18 @@ char* ewram_heap_end()
     return __eheap_end;
 }
 
+int iwram_overlay_size(int id)
+{
+    return iwram_overlay_stops[id] - iwram_overlay_starts[id];
+}
+
+void load_iwram_overlay(int id)
+{
+    // Overlays sections are word aligned:
+    if(int words = iwram_overlay_size(id) / 4)
+    {
+        copy_words(iwram_overlay_starts[id], words, __iwram_overlay_start);
+    }
+}
+
 }
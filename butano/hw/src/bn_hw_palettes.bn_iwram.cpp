@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_palettes.h"
+
+namespace bn::hw::palettes
+{
+
+namespace
+{
+    [[gnu::always_inline]] inline unsigned _brightness_colors(unsigned colors, unsigned value)
+    {
+        // Channels are processed in parallel (two colors per word),
+        // leaving room for a carry bit after each of them to saturate the result:
+        unsigned red_blue = (colors & 0x7C1F7C1F) + (value * 0x04010401);
+        unsigned red_blue_overflow = (red_blue & 0x80208020) >> 5;
+        red_blue = (red_blue | (red_blue_overflow * 31)) & 0x7C1F7C1F;
+
+        unsigned green = ((colors >> 5) & 0x001F001F) + (value * 0x00010001);
+        unsigned green_overflow = (green & 0x00200020) >> 5;
+        green = (green | (green_overflow * 31)) & 0x001F001F;
+        return red_blue | (green << 5);
+    }
+}
+
+void _lut_effect(const color* source_colors_ptr, const uint8_t* lut, int count, color* destination_colors_ptr)
+{
+    auto tonc_src_ptr = reinterpret_cast<const COLOR*>(source_colors_ptr);
+    auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
+
+    for(int index = 0; index < count; ++index)
+    {
+        unsigned source_color = tonc_src_ptr[index];
+        unsigned red = lut[source_color & 31];
+        unsigned green = lut[(source_color >> 5) & 31];
+        unsigned blue = lut[(source_color >> 10) & 31];
+        tonc_dst_ptr[index] = COLOR(red | (green << 5) | (blue << 10));
+    }
+}
+
+void _brightness(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr)
+{
+    auto tonc_src_ptr = reinterpret_cast<const COLOR*>(source_colors_ptr);
+    auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
+
+    for(int index = 0; index < count; ++index)
+    {
+        tonc_dst_ptr[index] = COLOR(_brightness_colors(tonc_src_ptr[index], unsigned(value)));
+    }
+}
+
+void _aligned_brightness(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr)
+{
+    auto u32_src_ptr = reinterpret_cast<const uint32_t*>(source_colors_ptr);
+    auto u32_dst_ptr = reinterpret_cast<uint32_t*>(destination_colors_ptr);
+
+    for(int index = 0, limit = count / 2; index < limit; ++index)
+    {
+        u32_dst_ptr[index] = _brightness_colors(u32_src_ptr[index], unsigned(value));
+    }
+}
+
+}
@@ -6,6 +6,8 @@
 #include "../include/bn_hw_palettes.h"
 
 #include "bn_math.h"
+#include "bn_memory.h"
+#include "bn_alignment.h"
 
 namespace bn::hw::palettes
 {
@@ -14,7 +16,7 @@ namespace
 {
     constexpr int luts_size = 33 * 32;
 
-    constexpr array<uint8_t, luts_size> contrast_lut = []{
+    alignas(int) constexpr array<uint8_t, luts_size> contrast_lut = []{
         array<uint8_t, luts_size> lut;
         int lut_index = 0;
 
@@ -35,7 +37,7 @@ namespace
         return lut;
     }();
 
-    constexpr array<uint8_t, luts_size> intensity_lut = []{
+    alignas(int) constexpr array<uint8_t, luts_size> intensity_lut = []{
         array<uint8_t, luts_size> lut;
         int lut_index = 0;
 
@@ -57,16 +59,10 @@ namespace
 
     void lut_effect(const color* source_colors_ptr, const uint8_t* lut, int count, color* destination_colors_ptr)
     {
-        auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
-
-        for(int index = 0; index < count; ++index)
-        {
-            color color = source_colors_ptr[index];
-            int red = lut[color.red()];
-            int green = lut[color.green()];
-            int blue = lut[color.blue()];
-            tonc_dst_ptr[index] = RGB15(red, green, blue);
-        }
+        // LUTs are copied from ROM to the stack to avoid ROM wait states in the colors loop:
+        alignas(int) uint8_t stack_lut[32];
+        bn::memory::copy<32>(*lut, stack_lut[0]);
+        _lut_effect(source_colors_ptr, stack_lut, count, destination_colors_ptr);
     }
 
     constexpr int hue_shift_lut_size = 33 * 9;
@@ -118,15 +114,13 @@ namespace
 
 void brightness(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr)
 {
-    auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
-
-    for(int index = 0; index < count; ++index)
+    if(count % 2 == 0 && aligned<sizeof(int)>(source_colors_ptr) && aligned<sizeof(int)>(destination_colors_ptr))
     {
-        color color = source_colors_ptr[index];
-        int red = bn::min(color.red() + value, 31);
-        int green = bn::min(color.green() + value, 31);
-        int blue = bn::min(color.blue() + value, 31);
-        tonc_dst_ptr[index] = RGB15(red, green, blue);
+        _aligned_brightness(source_colors_ptr, value, count, destination_colors_ptr);
+    }
+    else
+    {
+        _brightness(source_colors_ptr, value, count, destination_colors_ptr);
     }
 }
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_rtc.h"
+
+namespace bn::hw::rtc
+{
+
+namespace
+{
+    // The real-time clock is a serial device driven with the cart GPIO pins 0 (clock), 1 (data) and 2 (select):
+    constexpr uint16_t sck_high = 1;
+    constexpr uint16_t sio_high = 2;
+    constexpr uint16_t cs_high = 4;
+
+    constexpr int reset_command = 0x60;
+    constexpr int status_command = 0x62;
+    constexpr int time_command = 0x64;
+    constexpr int read_command = 1;
+
+    constexpr int status_24_hours = 0x40;
+    constexpr int status_power_failure = 0x80;
+
+    [[nodiscard]] volatile uint16_t& _data_register()
+    {
+        return *reinterpret_cast<uint16_t*>(0x80000C4);
+    }
+
+    [[nodiscard]] volatile uint16_t& _direction_register()
+    {
+        return *reinterpret_cast<uint16_t*>(0x80000C6);
+    }
+
+    [[nodiscard]] volatile uint16_t& _control_register()
+    {
+        return *reinterpret_cast<uint16_t*>(0x80000C8);
+    }
+
+    void _set_direction(bool sio_output)
+    {
+        volatile uint16_t& direction_register = _direction_register();
+        uint16_t direction = direction_register & ~(sck_high | sio_high | cs_high);
+        direction |= sck_high | cs_high;
+
+        if(sio_output)
+        {
+            direction |= sio_high;
+        }
+
+        direction_register = direction;
+    }
+
+    void _start(int command)
+    {
+        volatile uint16_t& data_register = _data_register();
+        data_register = sck_high;
+        data_register = sck_high | cs_high;
+        _set_direction(true);
+
+        // Commands are sent most significant bit first:
+        for(int index = 7; index >= 0; --index)
+        {
+            auto bit = uint16_t(((command >> index) & 1) << 1);
+            data_register = bit | cs_high;
+            data_register = bit | cs_high;
+            data_register = bit | cs_high;
+            data_register = bit | cs_high | sck_high;
+        }
+    }
+
+    void _write_byte(int value)
+    {
+        volatile uint16_t& data_register = _data_register();
+
+        // Data is sent least significant bit first:
+        for(int index = 0; index < 8; ++index)
+        {
+            auto bit = uint16_t(((value >> index) & 1) << 1);
+            data_register = bit | cs_high;
+            data_register = bit | cs_high;
+            data_register = bit | cs_high;
+            data_register = bit | cs_high | sck_high;
+        }
+    }
+
+    [[nodiscard]] int _read_status()
+    {
+        _start(status_command | read_command);
+        _set_direction(false);
+
+        int result = read_byte();
+        stop();
+        return result;
+    }
+
+    void _write_status(int status)
+    {
+        _start(status_command);
+        _write_byte(status);
+        stop();
+    }
+}
+
+bool init()
+{
+    _control_register() = 1;
+
+    int status = _read_status();
+
+    if(status & status_power_failure)
+    {
+        _start(reset_command);
+        stop();
+        status = 0;
+    }
+
+    if(! (status & status_24_hours))
+    {
+        _write_status(status_24_hours);
+        status = _read_status();
+    }
+
+    // Without a real-time clock the data pin is not driven, so all status bits are equal:
+    return status != 0xFF && (status & status_24_hours);
+}
+
+void start_time_read()
+{
+    _start(time_command | read_command);
+    _set_direction(false);
+}
+
+int read_byte()
+{
+    volatile uint16_t& data_register = _data_register();
+    int result = 0;
+
+    // Data is received least significant bit first:
+    for(int index = 0; index < 8; ++index)
+    {
+        data_register = cs_high;
+        data_register = cs_high;
+        data_register = cs_high;
+        data_register = cs_high;
+        data_register = cs_high;
+        data_register = cs_high | sck_high;
+        result |= ((data_register & sio_high) >> 1) << index;
+    }
+
+    return result;
+}
+
+void stop()
+{
+    volatile uint16_t& data_register = _data_register();
+    data_register = sck_high;
+    data_register = sck_high;
+}
+
+}
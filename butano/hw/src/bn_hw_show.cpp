@@ -5,7 +5,7 @@
 
 #include "../include/bn_hw_show.h"
 
-#if BN_CFG_ASSERT_ENABLED || BN_CFG_PROFILER_ENABLED
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED || BN_CFG_PROFILER_ENABLED
     #include "bn_colors.h"
     #include "bn_string.h"
     #include "bn_display.h"
@@ -27,7 +27,7 @@ namespace bn::hw::show
 
 namespace
 {
-    #if BN_CFG_ASSERT_ENABLED || BN_CFG_PROFILER_ENABLED
+    #if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED || BN_CFG_PROFILER_ENABLED
         void init_tte()
         {
             bn::hw::display::set_show_mode();
@@ -42,7 +42,7 @@ namespace
     #endif
 }
 
-#if BN_CFG_ASSERT_ENABLED
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED
     void error(const string_view& condition, const string_view& file_name, const string_view& function, int line,
                const string_view& message)
     {
@@ -6,6 +6,8 @@
 #include "../include/bn_hw_sram.h"
 
 #include "bn_config_sram.h"
+#include "bn_config_flash.h"
+#include "bn_config_eeprom.h"
 #include "../include/bn_hw_tonc.h"
 
 namespace bn::hw::sram
@@ -19,7 +21,10 @@ static_assert(BN_CFG_SRAM_WAIT_STATE == BN_SRAM_WAIT_STATE_4 ||
 namespace
 {
     // https://forum.gbadev.org/viewtopic.php?f=4&t=2825
-    alignas(int) __attribute__((used)) const char save_type[] = "SRAM_V113";
+    // Flash and EEPROM backends provide their own save type string:
+    #if BN_CFG_FLASH_SIZE == 0 && BN_CFG_EEPROM_SIZE == 0
+        alignas(int) __attribute__((used)) const char save_type[] = "SRAM_V113";
+    #endif
 }
 
 void init()
@@ -5,8 +5,8 @@
 
 #include "../include/bn_hw_text.h"
 
-#include "bn_math.h"
 #include "bn_array.h"
+#include "bn_limits.h"
 #include "bn_string_view.h"
 
 extern "C"
@@ -19,183 +19,125 @@ namespace bn::hw::text
 
 namespace
 {
-    template<typename Type>
-    [[nodiscard]] int _to_string(Type value, char* output_data)
+    constexpr array<char, 200> digit_pairs = []()
     {
-        if(value < 0)
+        array<char, 200> result;
+
+        for(int index = 0; index < 100; ++index)
         {
-            *output_data = '-';
-            ++output_data;
-            return _to_string(-value, output_data) + 1;
+            result[index * 2] = char('0' + (index / 10));
+            result[(index * 2) + 1] = char('0' + (index % 10));
         }
 
-        array<char, 16> extra_array;
-        char* extra_data = extra_array.data();
-        char* current_extra_data = extra_data;
+        return result;
+    }();
 
-        do
+    [[nodiscard]] char* _write_backwards(uint32_t value, char* output_end)
+    {
+        while(value >= 100)
         {
-            auto digit = int(value % 10);
-            value /= 10;
-            *current_extra_data = char('0' + digit);
-            ++current_extra_data;
+            // value / 100 with a multiplication by its reciprocal (exact for all 32-bit values):
+            auto quotient = uint32_t((uint64_t(value) * 0x51EB851F) >> 37);
+            const char* pair = digit_pairs.data() + ((value - (quotient * 100)) * 2);
+            output_end -= 2;
+            output_end[0] = pair[0];
+            output_end[1] = pair[1];
+            value = quotient;
         }
-        while(value >= 500000000);
 
-        posprintf(output_data, "%l", long(value));
+        if(value >= 10)
+        {
+            const char* pair = digit_pairs.data() + (value * 2);
+            output_end -= 2;
+            output_end[0] = pair[0];
+            output_end[1] = pair[1];
+        }
+        else
+        {
+            --output_end;
+            *output_end = char('0' + value);
+        }
 
-        int size = string_view(output_data).size();
-        int extra_size = current_extra_data - extra_data;
+        return output_end;
+    }
 
-        for(int index = extra_size - 1; index >= 0; --index)
+    [[nodiscard]] char* _write_backwards(uint64_t value, char* output_end)
+    {
+        while(value > numeric_limits<uint32_t>::max())
         {
-            output_data[size] = extra_data[index];
+            // 64-bit divisions are slow, but they are done only once per 9 digits of values out of the 32-bit range:
+            uint64_t quotient = value / 1000000000;
+            auto remainder = uint32_t(value - (quotient * 1000000000));
+            char* chunk_begin = _write_backwards(remainder, output_end);
+            output_end -= 9;
+
+            while(chunk_begin != output_end)
+            {
+                --chunk_begin;
+                *chunk_begin = '0';
+            }
+
+            value = quotient;
+        }
+
+        return _write_backwards(uint32_t(value), output_end);
+    }
+
+    template<typename Type>
+    [[nodiscard]] int _parse(bool negative, Type abs_value, array<char, 32>& output)
+    {
+        array<char, 24> digits;
+        char* digits_end = digits.data() + digits.size();
+        const char* digits_begin = _write_backwards(abs_value, digits_end);
+        char* output_data = output.data();
+        int size = 0;
+
+        if(negative)
+        {
+            output_data[0] = '-';
+            size = 1;
+        }
+
+        while(digits_begin != digits_end)
+        {
+            output_data[size] = *digits_begin;
+            ++digits_begin;
             ++size;
         }
 
+        output_data[size] = 0;
         return size;
     }
 }
 
 int parse(int value, array<char, 32>& output)
 {
-    char* output_data = output.data();
-    int abs_value = abs(value);
-    int size;
-
-    if(abs_value < 65536)
-    {
-        posprintf(output_data, "%d", value);
-        size = string_view(output_data).size();
-    }
-    else if(abs_value < 500000000)
-    {
-        posprintf(output_data, "%l", long(value));
-        size = string_view(output_data).size();
-    }
-    else
-    {
-        size = _to_string(value, output_data);
-    }
-
-    return size;
+    return _parse(value < 0, value < 0 ? 0U - uint32_t(value) : uint32_t(value), output);
 }
 
 int parse(long value, array<char, 32>& output)
 {
-    char* output_data = output.data();
-    long abs_value = abs(value);
-    int size;
-
-    if(abs_value < 65536)
-    {
-        posprintf(output_data, "%d", int(value));
-        size = string_view(output_data).size();
-    }
-    else if(abs_value < 500000000)
-    {
-        posprintf(output_data, "%l", value);
-        size = string_view(output_data).size();
-    }
-    else
-    {
-        size = _to_string(value, output_data);
-    }
-
-    return size;
+    return _parse(value < 0, value < 0 ? 0U - uint32_t(value) : uint32_t(value), output);
 }
 
 int parse(int64_t value, array<char, 32>& output)
 {
-    char* output_data = output.data();
-    int64_t abs_value = abs(value);
-    int size;
-
-    if(abs_value < 65536)
-    {
-        posprintf(output_data, "%d", int(value));
-        size = string_view(output_data).size();
-    }
-    else if(abs_value < 500000000)
-    {
-        posprintf(output_data, "%l", long(value));
-        size = string_view(output_data).size();
-    }
-    else
-    {
-        size = _to_string(value, output_data);
-    }
-
-    return size;
+    return _parse(value < 0, value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value), output);
 }
 
 int parse(unsigned value, array<char, 32>& output)
 {
-    char* output_data = output.data();
-    int size;
-
-    if(value < 65536)
-    {
-        posprintf(output_data, "%d", int(value));
-        size = string_view(output_data).size();
-    }
-    else if(value < 500000000)
-    {
-        posprintf(output_data, "%l", long(value));
-        size = string_view(output_data).size();
-    }
-    else
-    {
-        size = _to_string(value, output_data);
-    }
-
-    return size;
+    return _parse(false, uint32_t(value), output);
 }
 
 int parse(unsigned long value, array<char, 32>& output)
 {
-    char* output_data = output.data();
-    int size;
-
-    if(value < 65536)
-    {
-        posprintf(output_data, "%d", int(value));
-        size = string_view(output_data).size();
-    }
-    else if(value < 500000000)
-    {
-        posprintf(output_data, "%l", long(value));
-        size = string_view(output_data).size();
-    }
-    else
-    {
-        size = _to_string(value, output_data);
-    }
-
-    return size;
+    return _parse(false, uint32_t(value), output);
 }
 
 int parse(uint64_t value, array<char, 32>& output)
 {
-    char* output_data = output.data();
-    int size;
-
-    if(value < 65536)
-    {
-        posprintf(output_data, "%d", int(value));
-        size = string_view(output_data).size();
-    }
-    else if(value < 500000000)
-    {
-        posprintf(output_data, "%l", long(value));
-        size = string_view(output_data).size();
-    }
-    else
-    {
-        size = _to_string(value, output_data);
-    }
-
-    return size;
+    return _parse(false, value, output);
 }
 
 int parse(const void* ptr, array<char, 32>& output)
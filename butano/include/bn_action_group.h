@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ACTION_GROUP_H
+#define BN_ACTION_GROUP_H
+
+/**
+ * @file
+ * bn::action_group header file.
+ *
+ * @ingroup action
+ */
+
+#include "bn_vector.h"
+
+namespace bn
+{
+
+/**
+ * @brief Stores actions of the same type contiguously and updates all of them in one pass.
+ *
+ * Actions with a `done()` method are not updated once they are done, and they can be removed with remove_done().
+ *
+ * @tparam Action Type of the stored actions.
+ * @tparam MaxSize Maximum number of stored actions.
+ *
+ * @ingroup action
+ */
+template<typename Action, int MaxSize>
+class action_group
+{
+
+public:
+    using action_type = Action; //!< Action type alias.
+    using iterator = typename vector<Action, MaxSize>::iterator; //!< Iterator alias.
+    using const_iterator = typename vector<Action, MaxSize>::const_iterator; //!< Const iterator alias.
+
+    /**
+     * @brief Returns the number of stored actions.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _actions.size();
+    }
+
+    /**
+     * @brief Returns the maximum possible number of stored actions.
+     */
+    [[nodiscard]] constexpr static int max_size()
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Indicates if it doesn't store any action.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _actions.empty();
+    }
+
+    /**
+     * @brief Indicates if it can't store any more actions.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _actions.full();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the stored actions.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _actions.begin();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the stored actions.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _actions.begin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the stored actions.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _actions.end();
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the stored actions.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _actions.end();
+    }
+
+    /**
+     * @brief Returns a const reference to the action stored at the specified index.
+     */
+    [[nodiscard]] const Action& operator[](int index) const
+    {
+        return _actions[index];
+    }
+
+    /**
+     * @brief Returns a reference to the action stored at the specified index.
+     */
+    [[nodiscard]] Action& operator[](int index)
+    {
+        return _actions[index];
+    }
+
+    /**
+     * @brief Inserts a copy of the given action at the end of the group.
+     * @return Reference to the inserted action.
+     */
+    Action& push_back(const Action& action)
+    {
+        _actions.push_back(action);
+        return _actions.back();
+    }
+
+    /**
+     * @brief Moves the given action to the end of the group.
+     * @return Reference to the inserted action.
+     */
+    Action& push_back(Action&& action)
+    {
+        _actions.push_back(move(action));
+        return _actions.back();
+    }
+
+    /**
+     * @brief Constructs and inserts an action at the end of the group.
+     * @param args Parameters of the action to insert.
+     * @return Reference to the inserted action.
+     */
+    template<typename... Args>
+    Action& emplace_back(Args&&... args)
+    {
+        return _actions.emplace_back(forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Removes all actions.
+     */
+    void clear()
+    {
+        _actions.clear();
+    }
+
+    /**
+     * @brief Updates all stored actions which are not done yet.
+     */
+    void update()
+    {
+        for(Action& action : _actions)
+        {
+            if constexpr(requires(const Action& done_action) { done_action.done(); })
+            {
+                if(! action.done())
+                {
+                    action.update();
+                }
+            }
+            else
+            {
+                action.update();
+            }
+        }
+    }
+
+    /**
+     * @brief Resets the properties of all stored actions to their initial state.
+     */
+    void reset()
+    {
+        for(Action& action : _actions)
+        {
+            action.reset();
+        }
+    }
+
+    /**
+     * @brief Indicates if all stored actions are done.
+     */
+    [[nodiscard]] bool done() const
+    requires(requires(const Action& action) { action.done(); })
+    {
+        for(const Action& action : _actions)
+        {
+            if(! action.done())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Removes the stored actions which are done, keeping the order of the remaining ones.
+     * @return Number of removed actions.
+     */
+    int remove_done()
+    requires(requires(const Action& action) { action.done(); })
+    {
+        return erase_if(_actions, [](const Action& action)
+        {
+            return action.done();
+        });
+    }
+
+private:
+    vector<Action, MaxSize> _actions;
+};
+
+}
+
+#endif
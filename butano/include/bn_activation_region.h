@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ACTIVATION_REGION_H
+#define BN_ACTIVATION_REGION_H
+
+/**
+ * @file
+ * bn::iactivation_region and bn::activation_region implementation header file.
+ *
+ * @ingroup camera
+ */
+
+#include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_camera_ptr.h"
+#include "bn_fixed_rect.h"
+#include "bn_sprite_handle.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::activation_region.
+ *
+ * An activation region tracks which registered objects are near a camera,
+ * so objects far outside the screen can be suspended and their update cost avoided.
+ *
+ * The region is the screen centered in the camera position, extended by a margin in each direction.
+ * An object is active while its rectangle intersects the region.
+ *
+ * A sprite can be attached to each object: it is hidden when the object is deactivated
+ * and shown again when the object is reactivated. The attached sprite is not owned by the region,
+ * so its bn::sprite_ptr must be kept alive while the object is registered
+ * (or it can be released and recreated in the update callbacks).
+ *
+ * @ingroup camera
+ */
+class iactivation_region
+{
+
+public:
+    iactivation_region(const iactivation_region& other) = delete;
+
+    iactivation_region& operator=(const iactivation_region& other) = delete;
+
+    /**
+     * @brief Returns the camera which the region follows.
+     */
+    [[nodiscard]] const camera_ptr& camera() const
+    {
+        return _camera;
+    }
+
+    /**
+     * @brief Sets the camera which the region follows.
+     */
+    void set_camera(const camera_ptr& camera)
+    {
+        _camera = camera;
+    }
+
+    /**
+     * @brief Returns the horizontal and vertical margins which extend the screen in each direction.
+     */
+    [[nodiscard]] const fixed_size& margin() const
+    {
+        return _margin;
+    }
+
+    /**
+     * @brief Sets the horizontal and vertical margins which extend the screen in each direction.
+     *
+     * Objects are not activated nor deactivated until update is called.
+     */
+    void set_margin(const fixed_size& margin);
+
+    /**
+     * @brief Returns the region in which objects are active, using the current camera position.
+     */
+    [[nodiscard]] fixed_rect region() const;
+
+    /**
+     * @brief Returns the number of registered objects.
+     */
+    [[nodiscard]] int objects_count() const
+    {
+        return _objects_count;
+    }
+
+    /**
+     * @brief Returns the maximum number of registered objects.
+     */
+    [[nodiscard]] int max_objects_count() const
+    {
+        return _objects.max_size();
+    }
+
+    /**
+     * @brief Registers a new object.
+     * @param rect Rectangle of the object (relative to the camera).
+     * @return ID of the new object. It is active if its rectangle intersects the region.
+     */
+    int add_object(const fixed_rect& rect);
+
+    /**
+     * @brief Registers a new object with an attached sprite.
+     * @param rect Rectangle of the object (relative to the camera).
+     * @param sprite Sprite to hide while the object is not active.
+     * @return ID of the new object. It is active if its rectangle intersects the region.
+     */
+    int add_object(const fixed_rect& rect, const sprite_ptr& sprite);
+
+    /**
+     * @brief Unregisters the object with the given ID.
+     *
+     * If its attached sprite was hidden by the region, it is shown again.
+     */
+    void remove_object(int id);
+
+    /**
+     * @brief Unregisters all objects.
+     */
+    void clear_objects();
+
+    /**
+     * @brief Returns the rectangle of the object with the given ID.
+     */
+    [[nodiscard]] const fixed_rect& object_rect(int id) const
+    {
+        return _object(id).rect;
+    }
+
+    /**
+     * @brief Sets the rectangle of the object with the given ID.
+     *
+     * The object is not activated nor deactivated until update is called.
+     */
+    void set_object_rect(int id, const fixed_rect& rect)
+    {
+        _object(id).rect = rect;
+    }
+
+    /**
+     * @brief Sets the position of the rectangle of the object with the given ID.
+     *
+     * The object is not activated nor deactivated until update is called.
+     */
+    void set_object_position(int id, const fixed_point& position)
+    {
+        _object(id).rect.set_position(position);
+    }
+
+    /**
+     * @brief Indicates if the object with the given ID is active or not.
+     */
+    [[nodiscard]] bool object_active(int id) const
+    {
+        return _object(id).active;
+    }
+
+    /**
+     * @brief Activates and deactivates objects depending on the current camera position.
+     *
+     * It should be called once per frame, after moving the camera.
+     */
+    void update()
+    {
+        update([](int){}, [](int){});
+    }
+
+    /**
+     * @brief Activates and deactivates objects depending on the current camera position.
+     *
+     * It should be called once per frame, after moving the camera.
+     *
+     * @param activate_function Function object called with the ID of each activated object,
+     * after showing its attached sprite.
+     * @param deactivate_function Function object called with the ID of each deactivated object,
+     * after hiding its attached sprite.
+     */
+    template<typename ActivateFunction, typename DeactivateFunction>
+    void update(const ActivateFunction& activate_function, const DeactivateFunction& deactivate_function)
+    {
+        fixed_rect region = this->region();
+        object_type* objects_data = _objects.data();
+
+        for(int id = 0, limit = _objects.size(); id < limit; ++id)
+        {
+            object_type& object = objects_data[id];
+
+            if(object.used)
+            {
+                bool active = region.intersects(object.rect);
+
+                if(active != object.active)
+                {
+                    _set_active(object, active);
+
+                    if(active)
+                    {
+                        activate_function(id);
+                    }
+                    else
+                    {
+                        deactivate_function(id);
+                    }
+                }
+            }
+        }
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    struct object_type
+    {
+        fixed_rect rect;
+        optional<sprite_handle> sprite;
+        bool used;
+        bool active;
+    };
+
+    iactivation_region(const camera_ptr& camera, const fixed_size& margin, ivector<object_type>& objects);
+
+    /// @endcond
+
+private:
+    camera_ptr _camera;
+    fixed_size _margin;
+    ivector<object_type>& _objects;
+    int _objects_count = 0;
+
+    [[nodiscard]] const object_type& _object(int id) const;
+
+    [[nodiscard]] object_type& _object(int id);
+
+    int _add_object(const fixed_rect& rect, const optional<sprite_handle>& sprite);
+
+    static void _set_active(object_type& object, bool active);
+};
+
+
+/**
+ * @brief Tracks which registered objects are near a camera,
+ * so objects far outside the screen can be suspended and their update cost avoided.
+ *
+ * @tparam MaxObjects Maximum number of registered objects.
+ *
+ * @ingroup camera
+ */
+template<int MaxObjects>
+class activation_region : public iactivation_region
+{
+    static_assert(MaxObjects > 0);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param camera Camera which the region follows.
+     * @param margin Horizontal and vertical margins which extend the screen in each direction.
+     */
+    activation_region(const camera_ptr& camera, const fixed_size& margin) :
+        iactivation_region(camera, margin, _objects_vector)
+    {
+    }
+
+private:
+    vector<object_type, MaxObjects> _objects_vector;
+};
+
+}
+
+#endif
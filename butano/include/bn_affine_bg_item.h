@@ -238,6 +238,37 @@ public:
      */
     [[nodiscard]] optional<affine_bg_map_ptr> create_new_map_optional() const;
 
+    /**
+     * @brief Searches for a affine_bg_map_ptr which references the information provided by this item.
+     * If it is not found, it creates a affine_bg_map_ptr which references it,
+     * uploading its tiles and map cells to VRAM in the next frames instead of in the next V-Blank.
+     *
+     * Keep the returned affine_bg_map_ptr alive while the current scene runs:
+     * a affine_bg_ptr created later with this item finds the prefetched data already uploaded.
+     *
+     * If a bg_blocks batch has already been started, the uploads are added to it.
+     *
+     * @param max_bytes_per_frame Maximum number of bytes to upload to VRAM each frame.
+     * @return affine_bg_map_ptr which references the information provided by this item.
+     */
+    [[nodiscard]] affine_bg_map_ptr prefetch(int max_bytes_per_frame) const;
+
+    /**
+     * @brief Searches for a affine_bg_map_ptr which references the information provided by this item.
+     * If it is not found, it creates a affine_bg_map_ptr which references it,
+     * uploading its tiles and map cells to VRAM in the next frames instead of in the next V-Blank.
+     *
+     * Keep the returned affine_bg_map_ptr alive while the current scene runs:
+     * a affine_bg_ptr created later with this item finds the prefetched data already uploaded.
+     *
+     * If a bg_blocks batch has already been started, the uploads are added to it.
+     *
+     * @param max_bytes_per_frame Maximum number of bytes to upload to VRAM each frame.
+     * @return affine_bg_map_ptr which references the information provided by this item if it has been found
+     * or it could be allocated; bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<affine_bg_map_ptr> prefetch_optional(int max_bytes_per_frame) const;
+
     /**
      * @brief Default equal operator.
      */
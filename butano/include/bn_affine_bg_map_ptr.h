@@ -312,6 +312,93 @@ public:
      */
     void reload_cells_ref();
 
+    /**
+     * @brief Sets the referenced map cells in the given rectangle and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param first_column Index of the first column of the rectangle.
+     * @param first_row Index of the first row of the rectangle.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param cell New map cell.
+     */
+    void fill_rect(int first_column, int first_row, int columns_count, int rows_count, affine_bg_map_cell cell);
+
+    /**
+     * @brief Copies a rectangle of the given map cells to the referenced map cells and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param source_map_item affine_bg_map_item which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     */
+    void copy_rect(const affine_bg_map_item& source_map_item, int source_column, int source_row, int columns_count,
+                   int rows_count, int destination_column, int destination_row);
+
+    /**
+     * @brief Copies a rectangle of the map cells referenced by the given map
+     * to the referenced map cells and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * The given map can be this map: overlapping rectangles are copied as if the source was copied first
+     * to a temporary buffer.
+     *
+     * @param source_map Map which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     */
+    void copy_rect(const affine_bg_map_ptr& source_map, int source_column, int source_row, int columns_count,
+                   int rows_count, int destination_column, int destination_row);
+
+    /**
+     * @brief Copies a rectangle of the given map cells to the referenced map cells,
+     * offsetting their tile index, and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param source_map_item affine_bg_map_item which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     * @param tiles_offset Number of tiles to add to the tile index of each copied map cell [0..255].
+     */
+    void blit_with_offset(const affine_bg_map_item& source_map_item, int source_column, int source_row,
+                          int columns_count, int rows_count, int destination_column, int destination_row,
+                          int tiles_offset);
+
+    /**
+     * @brief Copies a rectangle of the map cells referenced by the given map to the referenced map cells,
+     * offsetting their tile index, and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param source_map Map which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     * @param tiles_offset Number of tiles to add to the tile index of each copied map cell [0..255].
+     */
+    void blit_with_offset(const affine_bg_map_ptr& source_map, int source_column, int source_row,
+                          int columns_count, int rows_count, int destination_column, int destination_row,
+                          int tiles_offset);
+
     /**
      * @brief Returns the referenced tiles.
      */
@@ -435,6 +522,19 @@ struct hash<affine_bg_map_ptr>
     }
 };
 
+
+/**
+ * @brief affine_bg_map_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup affine_bg
+ * @ingroup bg_map
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<affine_bg_map_ptr> : true_type
+{
+};
+
 }
 
 #endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_AFFINE_BG_PERSPECTIVE_H
+#define BN_AFFINE_BG_PERSPECTIVE_H
+
+/**
+ * @file
+ * bn::affine_bg_perspective header file.
+ *
+ * @ingroup affine_bg
+ * @ingroup hblank_effect
+ */
+
+#include "bn_span.h"
+#include "bn_fixed.h"
+#include "bn_assert.h"
+#include "bn_display.h"
+
+namespace bn
+{
+
+/**
+ * @brief Generates the per-scanline affine registers values of a perspective (mode 7) floor.
+ *
+ * The generated values should be committed with affine_bg_pa_register_hbe_ptr, affine_bg_pc_register_hbe_ptr,
+ * affine_bg_dx_register_hbe_ptr and affine_bg_dy_register_hbe_ptr H-Blank effects.
+ *
+ * pb and pd registers are not generated, since dx and dy are reloaded each scanline.
+ *
+ * Lines above or at the horizon are filled with zeros, so they should be hidden with a window or other backgrounds.
+ *
+ * Values are regenerated only when needed: if only the horizontal and depth positions of the camera are updated,
+ * the cached per-line scales and rotations are reused.
+ *
+ * Keep in mind that it uses about 3.8KB of memory.
+ *
+ * @ingroup affine_bg
+ * @ingroup hblank_effect
+ */
+class affine_bg_perspective
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param x Horizontal position of the camera.
+     * @param y Height of the camera over the floor (it must be >= 0).
+     * @param z Depth position of the camera.
+     * @param angle Rotation angle of the camera in degrees, in the range [0, 360].
+     * @param horizon Screen line of the horizon, in the range [0, display::height()).
+     * @param focal_length Distance in pixels from the camera to the projection plane (it must be > 0).
+     *
+     * The horizontal field of view is 2 * atan((display::width() / 2) / focal_length).
+     */
+    affine_bg_perspective(fixed x, fixed y, fixed z, fixed angle, int horizon = 0,
+                          int focal_length = display::height());
+
+    /**
+     * @brief Returns the horizontal position of the camera.
+     */
+    [[nodiscard]] fixed x() const
+    {
+        return _x;
+    }
+
+    /**
+     * @brief Sets the horizontal position of the camera.
+     */
+    void set_x(fixed x)
+    {
+        if(x != _x)
+        {
+            _x = x;
+            _translation_updated = true;
+        }
+    }
+
+    /**
+     * @brief Returns the height of the camera over the floor.
+     */
+    [[nodiscard]] fixed y() const
+    {
+        return _y;
+    }
+
+    /**
+     * @brief Sets the height of the camera over the floor.
+     * @param y Height of the camera over the floor (it must be >= 0).
+     */
+    void set_y(fixed y)
+    {
+        BN_ASSERT(y >= 0, "Invalid y: ", y);
+
+        if(y != _y)
+        {
+            _y = y;
+            _lines_updated = true;
+        }
+    }
+
+    /**
+     * @brief Returns the depth position of the camera.
+     */
+    [[nodiscard]] fixed z() const
+    {
+        return _z;
+    }
+
+    /**
+     * @brief Sets the depth position of the camera.
+     */
+    void set_z(fixed z)
+    {
+        if(z != _z)
+        {
+            _z = z;
+            _translation_updated = true;
+        }
+    }
+
+    /**
+     * @brief Returns the rotation angle of the camera in degrees, in the range [0, 360].
+     */
+    [[nodiscard]] fixed angle() const
+    {
+        return _angle;
+    }
+
+    /**
+     * @brief Sets the rotation angle of the camera.
+     * @param angle Rotation angle of the camera in degrees, in the range [0, 360].
+     */
+    void set_angle(fixed angle)
+    {
+        BN_ASSERT(angle >= 0 && angle <= 360, "Angle must be in the range [0, 360]: ", angle);
+
+        if(angle != _angle)
+        {
+            _angle = angle;
+            _lines_updated = true;
+        }
+    }
+
+    /**
+     * @brief Returns the screen line of the horizon, in the range [0, display::height()).
+     */
+    [[nodiscard]] int horizon() const
+    {
+        return _horizon;
+    }
+
+    /**
+     * @brief Sets the screen line of the horizon.
+     * @param horizon Screen line of the horizon, in the range [0, display::height()).
+     */
+    void set_horizon(int horizon)
+    {
+        BN_ASSERT(horizon >= 0 && horizon < display::height(), "Invalid horizon: ", horizon);
+
+        if(horizon != _horizon)
+        {
+            _horizon = int16_t(horizon);
+            _lines_updated = true;
+        }
+    }
+
+    /**
+     * @brief Returns the distance in pixels from the camera to the projection plane.
+     */
+    [[nodiscard]] int focal_length() const
+    {
+        return _focal_length;
+    }
+
+    /**
+     * @brief Sets the distance in pixels from the camera to the projection plane.
+     * @param focal_length Distance in pixels from the camera to the projection plane (it must be > 0).
+     */
+    void set_focal_length(int focal_length)
+    {
+        BN_ASSERT(focal_length > 0, "Invalid focal length: ", focal_length);
+
+        if(focal_length != _focal_length)
+        {
+            _focal_length = focal_length;
+            _lines_updated = true;
+        }
+    }
+
+    /**
+     * @brief Returns the generated pa register values.
+     */
+    [[nodiscard]] span<const int16_t> pa_values() const
+    {
+        return span<const int16_t>(_pa_values);
+    }
+
+    /**
+     * @brief Returns the generated pc register values.
+     */
+    [[nodiscard]] span<const int16_t> pc_values() const
+    {
+        return span<const int16_t>(_pc_values);
+    }
+
+    /**
+     * @brief Returns the generated dx register values.
+     */
+    [[nodiscard]] span<const int> dx_values() const
+    {
+        return span<const int>(_dx_values);
+    }
+
+    /**
+     * @brief Returns the generated dy register values.
+     */
+    [[nodiscard]] span<const int> dy_values() const
+    {
+        return span<const int>(_dy_values);
+    }
+
+    /**
+     * @brief Regenerates the register values if the camera has been updated.
+     * @return `true` if the register values have been updated
+     * (and therefore the reload_values_ref method of their H-Blank effects must be called),
+     * otherwise `false`.
+     */
+    bool update();
+
+private:
+    alignas(int) int16_t _pa_values[display::height()];
+    alignas(int) int16_t _pc_values[display::height()];
+    int _dx_values[display::height()];
+    int _dy_values[display::height()];
+    int _x_offsets[display::height()];
+    int _y_offsets[display::height()];
+    fixed _x;
+    fixed _y;
+    fixed _z;
+    fixed _angle;
+    int _focal_length;
+    int16_t _horizon;
+    bool _lines_updated = true;
+    bool _translation_updated = true;
+
+    BN_CODE_IWRAM void _update_lines();
+
+    BN_CODE_IWRAM void _update_translation();
+};
+
+}
+
+#endif
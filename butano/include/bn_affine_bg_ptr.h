@@ -168,6 +168,9 @@ public:
      *
      * Big backgrounds are slower CPU wise and don't support wrapping
      * (they can't be moved beyond their boundaries), but can have any width or height multiple of 256 pixels.
+     *
+     * Rotated or scaled big backgrounds stream the bounding box of their visible area,
+     * so only the cells inside a 256x256 pixels window centered on it are shown properly.
      */
     [[nodiscard]] bool big() const;
 
@@ -663,6 +666,18 @@ struct hash<affine_bg_ptr>
     }
 };
 
+
+/**
+ * @brief affine_bg_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup affine_bg
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<affine_bg_ptr> : true_type
+{
+};
+
 }
 
 #endif
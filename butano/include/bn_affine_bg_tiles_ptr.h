@@ -284,6 +284,19 @@ struct hash<affine_bg_tiles_ptr>
     }
 };
 
+
+/**
+ * @brief affine_bg_tiles_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup affine_bg
+ * @ingroup tile
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<affine_bg_tiles_ptr> : true_type
+{
+};
+
 }
 
 #endif
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_AFFINE_MAT_ATTRIBUTES_LUT_H
+#define BN_AFFINE_MAT_ATTRIBUTES_LUT_H
+
+/**
+ * @file
+ * bn::affine_mat_attributes_lut header file.
+ *
+ * @ingroup affine_mat
+ */
+
+#include "bn_affine_mat_attributes.h"
+
+namespace bn
+{
+
+/**
+ * @brief Precalculated affine_mat_attributes for AnglesCount rotation angles and ScalesCount scales.
+ *
+ * Rotation angles are evenly spaced in the range [0..360),
+ * and scales are evenly spaced in the range [min_scale..max_scale].
+ *
+ * If it is declared as constexpr, it is generated at compile time and stored in ROM,
+ * so retrieving the attributes of a rotated and scaled matrix doesn't require
+ * calculating sines, cosines nor reciprocals at runtime.
+ *
+ * Keep in mind that each entry uses sizeof(affine_mat_attributes) bytes.
+ *
+ * @tparam AnglesCount Number of rotation angles.
+ * @tparam ScalesCount Number of scales.
+ *
+ * @ingroup affine_mat
+ */
+template<int AnglesCount, int ScalesCount>
+class affine_mat_attributes_lut
+{
+    static_assert(AnglesCount > 0);
+    static_assert(ScalesCount > 0);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param min_scale Scale of the entries with scale index 0.
+     * @param max_scale Scale of the entries with scale index ScalesCount - 1.
+     * @param horizontal_flip Indicates if the entries are flipped in the horizontal axis or not.
+     * @param vertical_flip Indicates if the entries are flipped in the vertical axis or not.
+     */
+    constexpr affine_mat_attributes_lut(fixed min_scale, fixed max_scale, bool horizontal_flip = false,
+                                        bool vertical_flip = false) :
+        _min_scale(min_scale),
+        _max_scale(max_scale)
+    {
+        BN_ASSERT(min_scale > 0, "Invalid min scale: ", min_scale);
+        BN_ASSERT(max_scale >= min_scale, "Invalid max scale: ", max_scale, " - ", min_scale);
+
+        for(int angle_index = 0; angle_index < AnglesCount; ++angle_index)
+        {
+            fixed angle = rotation_angle(angle_index);
+
+            for(int scale_index = 0; scale_index < ScalesCount; ++scale_index)
+            {
+                fixed lut_scale = scale(scale_index);
+                _items[(angle_index * ScalesCount) + scale_index] = affine_mat_attributes(
+                            angle, lut_scale, lut_scale, horizontal_flip, vertical_flip);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of rotation angles.
+     */
+    [[nodiscard]] constexpr static int angles_count()
+    {
+        return AnglesCount;
+    }
+
+    /**
+     * @brief Returns the number of scales.
+     */
+    [[nodiscard]] constexpr static int scales_count()
+    {
+        return ScalesCount;
+    }
+
+    /**
+     * @brief Returns the scale of the entries with scale index 0.
+     */
+    [[nodiscard]] constexpr fixed min_scale() const
+    {
+        return _min_scale;
+    }
+
+    /**
+     * @brief Returns the scale of the entries with scale index ScalesCount - 1.
+     */
+    [[nodiscard]] constexpr fixed max_scale() const
+    {
+        return _max_scale;
+    }
+
+    /**
+     * @brief Returns the rotation angle in degrees of the entries with the given angle index.
+     * @param angle_index Angle index in the range [0..AnglesCount).
+     * @return Rotation angle in degrees, in the range [0..360).
+     */
+    [[nodiscard]] constexpr static fixed rotation_angle(int angle_index)
+    {
+        BN_ASSERT(angle_index >= 0 && angle_index < AnglesCount, "Invalid angle index: ", angle_index);
+
+        return fixed::from_data(int((int64_t(fixed(360).data()) * angle_index) / AnglesCount));
+    }
+
+    /**
+     * @brief Returns the scale of the entries with the given scale index.
+     * @param scale_index Scale index in the range [0..ScalesCount).
+     * @return Scale in the range [min_scale..max_scale].
+     */
+    [[nodiscard]] constexpr fixed scale(int scale_index) const
+    {
+        BN_ASSERT(scale_index >= 0 && scale_index < ScalesCount, "Invalid scale index: ", scale_index);
+
+        if constexpr(ScalesCount == 1)
+        {
+            return _min_scale;
+        }
+        else
+        {
+            int64_t range = _max_scale.data() - _min_scale.data();
+            return fixed::from_data(_min_scale.data() + int((range * scale_index) / (ScalesCount - 1)));
+        }
+    }
+
+    /**
+     * @brief Returns the index of the nearest rotation angle to the given one.
+     * @param rotation_angle Rotation angle in degrees, in the range [0..360].
+     * @return Angle index in the range [0..AnglesCount).
+     */
+    [[nodiscard]] constexpr static int angle_index(fixed rotation_angle)
+    {
+        BN_ASSERT(rotation_angle >= 0 && rotation_angle <= 360, "Invalid rotation angle: ", rotation_angle);
+
+        int64_t angle_data = fixed(360).data();
+        int result = int(((int64_t(rotation_angle.data()) * AnglesCount) + (angle_data / 2)) / angle_data);
+        return result == AnglesCount ? 0 : result;
+    }
+
+    /**
+     * @brief Returns the index of the nearest scale to the given one.
+     * @param scale Scale (it is clamped to the range [min_scale..max_scale]).
+     * @return Scale index in the range [0..ScalesCount).
+     */
+    [[nodiscard]] constexpr int scale_index(fixed scale) const
+    {
+        if constexpr(ScalesCount == 1)
+        {
+            return 0;
+        }
+        else
+        {
+            int64_t range = _max_scale.data() - _min_scale.data();
+
+            if(scale <= _min_scale || ! range)
+            {
+                return 0;
+            }
+
+            if(scale >= _max_scale)
+            {
+                return ScalesCount - 1;
+            }
+
+            int64_t offset = scale.data() - _min_scale.data();
+            return int(((offset * (ScalesCount - 1)) + (range / 2)) / range);
+        }
+    }
+
+    /**
+     * @brief Returns the attributes of the entry with the given indexes.
+     * @param angle_index Angle index in the range [0..AnglesCount).
+     * @param scale_index Scale index in the range [0..ScalesCount).
+     * @return A reference to the requested affine_mat_attributes.
+     */
+    [[nodiscard]] constexpr const affine_mat_attributes& attributes(int angle_index, int scale_index) const
+    {
+        BN_ASSERT(angle_index >= 0 && angle_index < AnglesCount, "Invalid angle index: ", angle_index);
+        BN_ASSERT(scale_index >= 0 && scale_index < ScalesCount, "Invalid scale index: ", scale_index);
+
+        return _items[(angle_index * ScalesCount) + scale_index];
+    }
+
+    /**
+     * @brief Returns the attributes of the entry nearest to the given rotation angle and scale.
+     * @param rotation_angle Rotation angle in degrees, in the range [0..360].
+     * @param scale Scale (it is clamped to the range [min_scale..max_scale]).
+     * @return A reference to the requested affine_mat_attributes.
+     */
+    [[nodiscard]] constexpr const affine_mat_attributes& nearest_attributes(fixed rotation_angle, fixed scale) const
+    {
+        return _items[(angle_index(rotation_angle) * ScalesCount) + scale_index(scale)];
+    }
+
+private:
+    affine_mat_attributes _items[AnglesCount * ScalesCount];
+    fixed _min_scale;
+    fixed _max_scale;
+};
+
+}
+
+#endif
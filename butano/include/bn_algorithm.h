@@ -10,6 +10,8 @@
  * @file
  * Standard library algorithm aliases header file.
  *
+ * It also contains algorithms not provided by the standard library, like bn::small_sort or bn::radix_sort.
+ *
  * @ingroup std
  */
 
@@ -46,10 +48,208 @@ namespace bn
 
     using std::sort;
     using std::stable_sort;
+    using std::partial_sort;
+    using std::nth_element;
 
     using std::reverse;
 
+    using std::unique;
+
     using std::swap_ranges;
+
+    /**
+     * @brief Sorts in ascending order the given 32-bit values by their highest key_bits bits.
+     *
+     * Lower bits can be used to store a payload, like the index of the sorted item:
+     * `(key << (32 - key_bits)) | index`.
+     *
+     * It is a stable LSD radix sort which runs in linear time, with one pass per each 8 bits of key.
+     *
+     * Its code is placed in IWRAM, so providing a temporary buffer allocated in IWRAM (like the stack) is recommended.
+     *
+     * @param values Pointer to the values to sort.
+     * @param count Number of values to sort.
+     * @param key_bits Number of bits of the sort key, in the range [1, 32].
+     * @param temp_values Pointer to a temporary buffer of at least count values.
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void radix_sort(unsigned* values, int count, int key_bits, unsigned* temp_values);
+
+    /**
+     * @brief Sorts the elements in the range [first, last) in ascending order.
+     *
+     * Up to 4 elements are sorted with sorting networks, and bigger ranges are sorted with insertion sort,
+     * so it is faster than bn::sort for small ranges (less than 64 elements or so), but much slower for big ones.
+     *
+     * It is not stable: the order of equal elements is not guaranteed to be preserved.
+     *
+     * @param first Iterator to the first element to sort.
+     * @param last Iterator to the element after the last one to sort.
+     * @param comp Function object which returns `true` if the first argument should be placed before the second one.
+     *
+     * @ingroup std
+     */
+    template<typename RandomIt, typename Compare>
+    constexpr void small_sort(RandomIt first, RandomIt last, const Compare& comp)
+    {
+        auto compare_swap = [&comp](RandomIt a, RandomIt b)
+        {
+            if(comp(*b, *a))
+            {
+                std::iter_swap(a, b);
+            }
+        };
+
+        switch(last - first)
+        {
+
+        case 0:
+        case 1:
+            break;
+
+        case 2:
+            compare_swap(first, first + 1);
+            break;
+
+        case 3:
+            compare_swap(first, first + 1);
+            compare_swap(first + 1, first + 2);
+            compare_swap(first, first + 1);
+            break;
+
+        case 4:
+            compare_swap(first, first + 1);
+            compare_swap(first + 2, first + 3);
+            compare_swap(first, first + 2);
+            compare_swap(first + 1, first + 3);
+            compare_swap(first + 1, first + 2);
+            break;
+
+        default:
+            for(RandomIt it = first + 1; it != last; ++it)
+            {
+                auto value = std::move(*it);
+                RandomIt hole = it;
+
+                for(RandomIt previous = hole - 1; comp(value, *previous); --previous)
+                {
+                    *hole = std::move(*previous);
+                    hole = previous;
+
+                    if(hole == first)
+                    {
+                        break;
+                    }
+                }
+
+                *hole = std::move(value);
+            }
+            break;
+        }
+    }
+
+    /**
+     * @brief Sorts the elements in the range [first, last) in ascending order with `operator<`.
+     *
+     * Up to 4 elements are sorted with sorting networks, and bigger ranges are sorted with insertion sort,
+     * so it is faster than bn::sort for small ranges (less than 64 elements or so), but much slower for big ones.
+     *
+     * It is not stable: the order of equal elements is not guaranteed to be preserved.
+     *
+     * @param first Iterator to the first element to sort.
+     * @param last Iterator to the element after the last one to sort.
+     *
+     * @ingroup std
+     */
+    template<typename RandomIt>
+    constexpr void small_sort(RandomIt first, RandomIt last)
+    {
+        small_sort(first, last, [](const auto& a, const auto& b)
+        {
+            return a < b;
+        });
+    }
+
+    /**
+     * @brief Sorts in ascending order the given integers with IWRAM code, like bn::small_sort.
+     * @param values Pointer to the values to sort.
+     * @param count Number of values to sort.
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void small_sort(int* values, int count);
+
+    /**
+     * @brief Sorts in ascending order the given 32-bit values with IWRAM code, like bn::small_sort.
+     *
+     * Lower bits can be used to store a payload, like the index of the sorted item:
+     * `(key << index_bits) | index`.
+     *
+     * @param values Pointer to the values to sort.
+     * @param count Number of values to sort.
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void small_sort(unsigned* values, int count);
+
+    /**
+     * @brief Rearranges the given integers with IWRAM code, so the value at the nth position is the one
+     * which would be there if they were sorted, previous values are not greater than it
+     * and next values are not less than it.
+     *
+     * It runs in linear time on average with a quickselect with median of three pivots.
+     *
+     * @param values Pointer to the values to rearrange.
+     * @param count Number of values to rearrange.
+     * @param nth Position of the value to select, in the range [0, count - 1].
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void nth_element(int* values, int count, int nth);
+
+    /**
+     * @brief Rearranges the given 32-bit values with IWRAM code, so the value at the nth position is the one
+     * which would be there if they were sorted, previous values are not greater than it
+     * and next values are not less than it.
+     *
+     * It runs in linear time on average with a quickselect with median of three pivots.
+     *
+     * @param values Pointer to the values to rearrange.
+     * @param count Number of values to rearrange.
+     * @param nth Position of the value to select, in the range [0, count - 1].
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void nth_element(unsigned* values, int count, int nth);
+
+    /**
+     * @brief Rearranges the given integers with IWRAM code, so the lowest middle values are placed
+     * at the beginning in ascending order. The order of the remaining values is unspecified.
+     *
+     * Useful to retrieve the nearest objects from a list of candidates, for example.
+     *
+     * @param values Pointer to the values to rearrange.
+     * @param count Number of values to rearrange.
+     * @param middle Number of values to sort, in the range [0, count].
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void partial_sort(int* values, int count, int middle);
+
+    /**
+     * @brief Rearranges the given 32-bit values with IWRAM code, so the lowest middle values are placed
+     * at the beginning in ascending order. The order of the remaining values is unspecified.
+     *
+     * Useful to retrieve the nearest objects from a list of candidates, for example.
+     *
+     * @param values Pointer to the values to rearrange.
+     * @param count Number of values to rearrange.
+     * @param middle Number of values to sort, in the range [0, count].
+     *
+     * @ingroup std
+     */
+    BN_CODE_IWRAM void partial_sort(unsigned* values, int count, int middle);
 }
 
 #endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ARENA_H
+#define BN_ARENA_H
+
+/**
+ * @file
+ * bn::iarena and bn::arena implementation header file.
+ *
+ * @ingroup memory
+ */
+
+#include <new>
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_arena_fwd.h"
+
+namespace bn
+{
+
+class iarena
+{
+
+public:
+    /**
+     * @brief Restores the used bytes of an arena when it goes out of scope,
+     * freeing all allocations made since its creation.
+     *
+     * Scopes can be nested.
+     */
+    class scope
+    {
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param arena Arena to restore when this scope goes out of scope.
+         */
+        explicit scope(iarena& arena) :
+            _arena(arena),
+            _marker(arena.marker())
+        {
+        }
+
+        scope(const scope& other) = delete;
+
+        scope& operator=(const scope& other) = delete;
+
+        /**
+         * @brief Destructor.
+         *
+         * It frees all allocations made in the arena since this scope was created.
+         */
+        ~scope()
+        {
+            _arena.reset(_marker);
+        }
+
+    private:
+        iarena& _arena;
+        int _marker;
+    };
+
+    iarena(const iarena& other) = delete;
+
+    iarena& operator=(const iarena& other) = delete;
+
+    /**
+     * @brief Returns the number of allocated bytes, including alignment padding.
+     */
+    [[nodiscard]] int used_bytes() const
+    {
+        return _used_bytes;
+    }
+
+    /**
+     * @brief Returns the maximum number of bytes that can be allocated.
+     */
+    [[nodiscard]] int max_bytes() const
+    {
+        return _max_bytes;
+    }
+
+    /**
+     * @brief Returns the number of bytes that still can be allocated, without considering alignment padding.
+     */
+    [[nodiscard]] int available_bytes() const
+    {
+        return _max_bytes - _used_bytes;
+    }
+
+    /**
+     * @brief Indicates if there's no allocated bytes or not.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _used_bytes == 0;
+    }
+
+    /**
+     * @brief Allocates uninitialized storage.
+     * @param bytes Bytes to allocate (it must be >= 0).
+     * @param alignment Alignment in bytes of the returned pointer (it must be a power of two).
+     * @return On success, returns the pointer to the beginning of newly allocated memory.
+     * On failure, returns `nullptr`.
+     *
+     * The allocated storage is freed with reset.
+     */
+    [[nodiscard]] void* alloc(int bytes, int alignment = alignof(int))
+    {
+        BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+        BN_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Invalid alignment: ", alignment);
+
+        uintptr_t buffer = reinterpret_cast<uintptr_t>(_buffer);
+        uintptr_t result = (buffer + unsigned(_used_bytes) + unsigned(alignment) - 1) & ~uintptr_t(alignment - 1);
+        int new_used_bytes = int(result - buffer) + bytes;
+
+        if(new_used_bytes > _max_bytes)
+        {
+            return nullptr;
+        }
+
+        _used_bytes = new_used_bytes;
+        return reinterpret_cast<void*>(result);
+    }
+
+    /**
+     * @brief Constructs a new object in the arena.
+     * @param args Parameters of the object to construct.
+     * @return On success, returns the pointer to the constructed object. On failure, returns `nullptr`.
+     *
+     * The constructed object destructor is never called, so it must be destroyed manually if needed.
+     */
+    template<typename Type, typename... Args>
+    [[nodiscard]] Type* create(Args&&... args)
+    {
+        void* result = alloc(int(sizeof(Type)), int(alignof(Type)));
+
+        if(! result)
+        {
+            return nullptr;
+        }
+
+        return ::new(result) Type(forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Returns a marker which allows to free all allocations made after this call with reset(int).
+     */
+    [[nodiscard]] int marker() const
+    {
+        return _used_bytes;
+    }
+
+    /**
+     * @brief Frees all allocations made after the given marker was returned.
+     * @param marker Value returned by marker().
+     */
+    void reset(int marker)
+    {
+        BN_ASSERT(marker >= 0 && marker <= _used_bytes, "Invalid marker: ", marker, " - ", _used_bytes);
+
+        _used_bytes = marker;
+    }
+
+    /**
+     * @brief Frees all allocations.
+     */
+    void reset()
+    {
+        _used_bytes = 0;
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    iarena(char* buffer, int max_bytes) :
+        _buffer(buffer),
+        _max_bytes(max_bytes)
+    {
+    }
+
+    /// @endcond
+
+private:
+    char* _buffer;
+    int _max_bytes;
+    int _used_bytes = 0;
+};
+
+
+template<int MaxBytes>
+class arena : public iarena
+{
+    static_assert(MaxBytes > 0);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    arena() :
+        iarena(_storage_buffer, MaxBytes)
+    {
+    }
+
+private:
+    alignas(int) char _storage_buffer[MaxBytes];
+};
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ARENA_FWD_H
+#define BN_ARENA_FWD_H
+
+/**
+ * @file
+ * bn::iarena, bn::arena and bn::arena_vector declaration header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    /**
+     * @brief Base class of bn::arena.
+     *
+     * Can be used as a reference type for all bn::arena allocators.
+     *
+     * @ingroup memory
+     */
+    class iarena;
+
+    /**
+     * @brief Bump allocator with a fixed size buffer.
+     *
+     * @tparam MaxBytes Maximum number of bytes that can be allocated.
+     *
+     * @ingroup memory
+     */
+    template<int MaxBytes>
+    class arena;
+
+    /**
+     * @brief bn::ivector whose elements are stored in a bn::iarena.
+     *
+     * @tparam Type Element type.
+     *
+     * @ingroup memory
+     */
+    template<typename Type>
+    class arena_vector;
+}
+
+#endif
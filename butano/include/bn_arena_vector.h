@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ARENA_VECTOR_H
+#define BN_ARENA_VECTOR_H
+
+/**
+ * @file
+ * bn::arena_vector implementation header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_arena.h"
+#include "bn_vector.h"
+
+namespace bn
+{
+
+template<typename Type>
+class arena_vector : public ivector<Type>
+{
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+    using iterator = Type*; //!< Iterator alias.
+    using const_iterator = const Type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    /**
+     * @brief Constructor.
+     * @param arena Arena in which the elements are stored.
+     * @param max_size Maximum number of elements that can be stored.
+     *
+     * The storage of the elements is allocated from the given arena when the vector is constructed,
+     * and it is freed when the arena is reset, not when the vector is destroyed.
+     */
+    arena_vector(iarena& arena, size_type max_size) :
+        ivector<Type>(_alloc(arena, max_size), max_size)
+    {
+    }
+
+    arena_vector(const arena_vector& other) = delete;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other arena_vector to copy.
+     * @return Reference to this.
+     */
+    arena_vector& operator=(const arena_vector& other)
+    {
+        ivector<Type>::operator=(other);
+        return *this;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other ivector to copy.
+     * @return Reference to this.
+     */
+    arena_vector& operator=(const ivector<Type>& other)
+    {
+        ivector<Type>::operator=(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other ivector to move.
+     * @return Reference to this.
+     */
+    arena_vector& operator=(ivector<Type>&& other) noexcept
+    {
+        ivector<Type>::operator=(move(other));
+        return *this;
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~arena_vector() noexcept = default;
+
+    /**
+     * @brief Destructor.
+     */
+    ~arena_vector() noexcept
+    requires(! is_trivially_destructible_v<Type>)
+    {
+        this->clear();
+    }
+
+private:
+    [[nodiscard]] static reference _alloc(iarena& arena, size_type max_size)
+    {
+        BN_ASSERT(max_size >= 0, "Invalid max size: ", max_size);
+
+        void* result = arena.alloc(max_size * int(sizeof(Type)), int(alignof(Type)));
+        BN_ASSERT(result, "Not enough space in arena: ", arena.available_bytes(), " - ",
+                  max_size * int(sizeof(Type)));
+
+        return *static_cast<pointer>(result);
+    }
+};
+
+}
+
+#endif
@@ -8,7 +8,7 @@
 
 /**
  * @file
- * BN_ASSERT and BN_ERROR header file.
+ * BN_ASSERT, BN_BASIC_ASSERT, BN_FULL_ASSERT and BN_ERROR header file.
  *
  * @ingroup assert
  */
@@ -51,6 +51,30 @@
  * @ingroup assert
  */
 
+/**
+ * @def BN_BASIC_ASSERT(condition, ...)
+ *
+ * Checks if the specified \a condition is true like BN_ASSERT,
+ * but it is also enabled when BN_CFG_ASSERT_ENABLED is `false` (if BN_CFG_ASSERT_BASIC_ENABLED is `true`).
+ *
+ * It should be used for cheap checks only, like bounds checks.
+ *
+ * When BN_CFG_ASSERT_ENABLED is `false`, the messages passed by argument are not evaluated nor shown.
+ *
+ * @ingroup assert
+ */
+
+/**
+ * @def BN_FULL_ASSERT(condition, ...)
+ *
+ * Checks if the specified \a condition is true like BN_ASSERT,
+ * but it is enabled only if BN_CFG_ASSERT_FULL_ENABLED is `true`.
+ *
+ * It should be used for expensive checks, like data consistency walks.
+ *
+ * @ingroup assert
+ */
+
 /**
  * @def BN_ERROR(...)
  *
@@ -82,50 +106,9 @@
  * @ingroup assert
  */
 
-#if BN_CFG_ASSERT_ENABLED || BN_DOXYGEN
-    #include "bn_sstream.h"
-    #include "bn_istring_base.h"
+static_assert(BN_CFG_ASSERT_ENABLED || ! BN_CFG_ASSERT_FULL_ENABLED, "Full asserts require BN_CFG_ASSERT_ENABLED");
 
-    #ifndef BN_ASSERT
-
-        #define BN_ASSERT(condition, ...) \
-            do \
-            { \
-                if(bn::is_constant_evaluated()) \
-                { \
-                    assert(condition); \
-                } \
-                else \
-                { \
-                    if(! (condition)) [[unlikely]] \
-                    { \
-                        constexpr _bn::assert::file_name<_bn::assert::file_name_size(__FILE__) + 1> _bn_assert_file_name(__FILE__); \
-                        _bn::assert::show_args(#condition, _bn_assert_file_name.characters, __func__, \
-                                __LINE__ __VA_OPT__(, ) __VA_ARGS__); \
-                    } \
-                } \
-            } while(false)
-
-    #endif
-
-    #ifndef BN_ERROR
-
-        #define BN_ERROR(...) \
-            do \
-            { \
-                if(bn::is_constant_evaluated()) \
-                { \
-                    assert(false); \
-                } \
-                else \
-                { \
-                    constexpr _bn::assert::file_name<_bn::assert::file_name_size(__FILE__) + 1> _bn_error_file_name(__FILE__); \
-                    _bn::assert::show_args("", _bn_error_file_name.characters, __func__, \
-                            __LINE__ __VA_OPT__(, ) __VA_ARGS__); \
-                } \
-            } while(false)
-
-    #endif
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED || BN_DOXYGEN
 
     /// @cond DO_NOT_DOCUMENT
 
@@ -183,7 +166,86 @@
 
         [[noreturn]] void show(const char* condition, const char* file_name, const char* function, int line,
                                const char* message);
+    }
+
+    /// @endcond
+
+#endif
+
+#if BN_CFG_ASSERT_ENABLED || BN_DOXYGEN
+    #include "bn_sstream.h"
+    #include "bn_istring_base.h"
+
+    #ifndef BN_ASSERT
+
+        #define BN_ASSERT(condition, ...) \
+            do \
+            { \
+                if(bn::is_constant_evaluated()) \
+                { \
+                    assert(condition); \
+                } \
+                else \
+                { \
+                    if(! (condition)) [[unlikely]] \
+                    { \
+                        constexpr _bn::assert::file_name<_bn::assert::file_name_size(__FILE__) + 1> _bn_assert_file_name(__FILE__); \
+                        _bn::assert::show_args(#condition, _bn_assert_file_name.characters, __func__, \
+                                __LINE__ __VA_OPT__(, ) __VA_ARGS__); \
+                    } \
+                } \
+            } while(false)
 
+    #endif
+
+    #ifndef BN_BASIC_ASSERT
+
+        #define BN_BASIC_ASSERT(condition, ...) \
+            BN_ASSERT(condition __VA_OPT__(, ) __VA_ARGS__)
+
+    #endif
+
+    #ifndef BN_FULL_ASSERT
+
+        #if BN_CFG_ASSERT_FULL_ENABLED || BN_DOXYGEN
+            #define BN_FULL_ASSERT(condition, ...) \
+                BN_ASSERT(condition __VA_OPT__(, ) __VA_ARGS__)
+        #else
+            #define BN_FULL_ASSERT(condition, ...) \
+                do \
+                { \
+                    if(bn::is_constant_evaluated()) \
+                    { \
+                        assert(condition); \
+                    } \
+                } while(false)
+        #endif
+
+    #endif
+
+    #ifndef BN_ERROR
+
+        #define BN_ERROR(...) \
+            do \
+            { \
+                if(bn::is_constant_evaluated()) \
+                { \
+                    assert(false); \
+                } \
+                else \
+                { \
+                    constexpr _bn::assert::file_name<_bn::assert::file_name_size(__FILE__) + 1> _bn_error_file_name(__FILE__); \
+                    _bn::assert::show_args("", _bn_error_file_name.characters, __func__, \
+                            __LINE__ __VA_OPT__(, ) __VA_ARGS__); \
+                } \
+            } while(false)
+
+    #endif
+
+    /// @cond DO_NOT_DOCUMENT
+
+    namespace _bn::assert
+    {
         [[noreturn]] void show(const char* condition, const char* file_name, const char* function, int line,
                                const bn::istring_base& message);
 
@@ -243,6 +305,51 @@
 
     #endif
 
+    #ifndef BN_BASIC_ASSERT
+
+        #if BN_CFG_ASSERT_BASIC_ENABLED
+            #define BN_BASIC_ASSERT(condition, ...) \
+                do \
+                { \
+                    if(bn::is_constant_evaluated()) \
+                    { \
+                        assert(condition); \
+                    } \
+                    else \
+                    { \
+                        if(! (condition)) [[unlikely]] \
+                        { \
+                            constexpr _bn::assert::file_name<_bn::assert::file_name_size(__FILE__) + 1> _bn_assert_file_name(__FILE__); \
+                            _bn::assert::show(#condition, _bn_assert_file_name.characters, __func__, __LINE__, ""); \
+                        } \
+                    } \
+                } while(false)
+        #else
+            #define BN_BASIC_ASSERT(condition, ...) \
+                do \
+                { \
+                    if(bn::is_constant_evaluated()) \
+                    { \
+                        assert(condition); \
+                    } \
+                } while(false)
+        #endif
+
+    #endif
+
+    #ifndef BN_FULL_ASSERT
+
+        #define BN_FULL_ASSERT(condition, ...) \
+            do \
+            { \
+                if(bn::is_constant_evaluated()) \
+                { \
+                    assert(condition); \
+                } \
+            } while(false)
+
+    #endif
+
     #ifndef BN_ERROR
 
         #define BN_ERROR(...) \
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ASSET_REGISTRY_H
+#define BN_ASSET_REGISTRY_H
+
+/**
+ * @file
+ * bn::asset_registry header file.
+ *
+ * @ingroup tool
+ */
+
+#include "bn_span.h"
+#include "bn_string_view.h"
+
+namespace bn
+{
+
+/**
+ * @brief Hash which identifies an asset item by its name, as calculated by the assets conversion tools.
+ *
+ * @ingroup tool
+ */
+class asset_hash
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    constexpr asset_hash() = default;
+
+    /**
+     * @brief Constructor.
+     * @param name Name of the asset item (the name of its file without extension).
+     */
+    constexpr explicit asset_hash(const string_view& name)
+    {
+        // 32-bit FNV-1a:
+        unsigned result = 0x811C9DC5;
+
+        for(char character : name)
+        {
+            result ^= uint8_t(character);
+            result *= 0x01000193;
+        }
+
+        _value = result;
+    }
+
+    /**
+     * @brief Constructor.
+     * @param value Hash value calculated by the assets conversion tools.
+     */
+    constexpr explicit asset_hash(unsigned value) :
+        _value(value)
+    {
+    }
+
+    /**
+     * @brief Returns the hash value.
+     */
+    [[nodiscard]] constexpr unsigned value() const
+    {
+        return _value;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(asset_hash a, asset_hash b) = default;
+
+    /**
+     * @brief Less than operator.
+     */
+    [[nodiscard]] constexpr friend bool operator<(asset_hash a, asset_hash b)
+    {
+        return a._value < b._value;
+    }
+
+private:
+    unsigned _value = 0;
+};
+
+
+/**
+ * @brief Entry of an asset registry table: the hash of an asset item and a pointer to it.
+ *
+ * @tparam Item Asset item type (sprite_item, regular_bg_item, etc).
+ *
+ * @ingroup tool
+ */
+template<typename Item>
+class asset_registry_entry
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param hash Hash of the name of the asset item.
+     * @param item Referenced asset item.
+     */
+    constexpr asset_registry_entry(unsigned hash, const Item& item) :
+        _hash(hash),
+        _item_ptr(&item)
+    {
+    }
+
+    /**
+     * @brief Returns the hash of the name of the asset item.
+     */
+    [[nodiscard]] constexpr asset_hash hash() const
+    {
+        return asset_hash(_hash);
+    }
+
+    /**
+     * @brief Returns the referenced asset item.
+     */
+    [[nodiscard]] constexpr const Item& item() const
+    {
+        return *_item_ptr;
+    }
+
+private:
+    unsigned _hash;
+    const Item* _item_ptr;
+};
+
+
+/**
+ * @brief Provides the registry table of the given asset item type.
+ *
+ * The assets conversion tools specialize it in the `bn_asset_registry_items.h` header file generated
+ * in the build folder, so it must be included before calling bn::asset_registry::find.
+ *
+ * Specializations return a `span<const asset_registry_entry<Item>>` from `entries()`, sorted by hash.
+ *
+ * @tparam Item Asset item type (sprite_item, regular_bg_item, etc).
+ *
+ * @ingroup tool
+ */
+template<typename Item>
+class asset_registry_table;
+
+}
+
+/**
+ * @brief Lookup of asset items by the hash of their name.
+ *
+ * The assets conversion tools generate a table sorted by hash in ROM for each asset item type,
+ * so asset items can be found with a binary search without spending RAM.
+ *
+ * @ingroup tool
+ */
+namespace bn::asset_registry
+{
+    /**
+     * @brief Searches the given asset item in the given table with a binary search.
+     * @param entries Asset registry table sorted by hash.
+     * @param hash Hash of the name of the asset item to search.
+     * @return Pointer to the asset item if it has been found; `nullptr` otherwise.
+     */
+    template<typename Item>
+    [[nodiscard]] constexpr const Item* find(const span<const asset_registry_entry<Item>>& entries, asset_hash hash)
+    {
+        int first = 0;
+        int count = entries.size();
+
+        while(count > 0)
+        {
+            int step = count / 2;
+            int middle = first + step;
+
+            if(entries[middle].hash() < hash)
+            {
+                first = middle + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        if(first < entries.size() && entries[first].hash() == hash)
+        {
+            return &entries[first].item();
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Searches the given asset item in the registry table generated by the assets conversion tools.
+     * @param hash Hash of the name of the asset item to search.
+     * @return Pointer to the asset item if it has been found; `nullptr` otherwise.
+     */
+    template<typename Item>
+    [[nodiscard]] constexpr const Item* find(asset_hash hash)
+    {
+        return find(asset_registry_table<Item>::entries(), hash);
+    }
+
+    /**
+     * @brief Searches the given asset item in the registry table generated by the assets conversion tools.
+     * @param name Name of the asset item to search (the name of its file without extension).
+     * @return Pointer to the asset item if it has been found; `nullptr` otherwise.
+     */
+    template<typename Item>
+    [[nodiscard]] constexpr const Item* find(const string_view& name)
+    {
+        return find<Item>(asset_hash(name));
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ATAN2_LUT_H
+#define BN_ATAN2_LUT_H
+
+/**
+ * @file
+ * bn::atan2_lut header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_array_fwd.h"
+
+namespace bn
+{
+
+/**
+ * @brief Size of the arc tangent LUT.
+ *
+ * @ingroup math
+ */
+constexpr int atan2_lut_size = 257;
+
+/**
+ * @brief Calculates the value to store in atan2_lut for the given index.
+ * @param lut_index atan2_lut index in the range [0, atan2_lut_size - 1].
+ * @return Arc tangent of lut_index / (atan2_lut_size - 1) (2π = 65536).
+ *
+ * @ingroup math
+ */
+[[nodiscard]] constexpr int calculate_atan2_lut_value(int lut_index)
+{
+    constexpr double pi = 3.1415926535897932384626433832795;
+    double t = double(lut_index) / (atan2_lut_size - 1);
+
+    // sqrt(1 + t * t) with Newton's method:
+    double s = 1 + (t * t);
+    double sqrt_s = 1;
+
+    for(int iteration = 0; iteration < 8; ++iteration)
+    {
+        sqrt_s = (sqrt_s + (s / sqrt_s)) / 2;
+    }
+
+    // atan(t) = 2 * atan(u), with u in the range [0, 0.415]:
+    double u = t / (1 + sqrt_s);
+    double u2 = u * u;
+    double term = u;
+    double atan_u = 0;
+
+    for(int index = 0; index < 24; ++index)
+    {
+        double fraction = term / ((2 * index) + 1);
+        atan_u += (index % 2) ? -fraction : fraction;
+        term *= u2;
+    }
+
+    double result = (2 * atan_u * 65536) / (2 * pi);
+    return int(result + 0.5);
+}
+
+/**
+ * @brief Arc tangent LUT of the first octant (2π = 65536).
+ *
+ * Entry i is the arc tangent of i / (atan2_lut_size - 1).
+ *
+ * @ingroup math
+ */
+extern const array<uint16_t, atan2_lut_size>& atan2_lut;
+
+}
+
+#endif
@@ -37,6 +37,56 @@ namespace bn::audio
      * but increases the possibility of visual bugs because of lack of V-Blank time.
      */
     void set_update_on_vblank(bool update_on_vblank);
+
+    /**
+     * @brief Returns the current software audio mixing rate (BN_AUDIO_MIXING_RATE_* macros).
+     */
+    [[nodiscard]] int mixing_rate();
+
+    /**
+     * @brief Sets the software audio mixing rate.
+     *
+     * Lower mixing rates reduce audio quality but free CPU time.
+     *
+     * The audio mixer is restarted when bn::core::update is called, stopping active music, sound effects and PCM streams,
+     * so it should be changed only between scenes.
+     *
+     * @param mixing_rate Software audio mixing rate (BN_AUDIO_MIXING_RATE_* macros).
+     * It must be less or equal than @ref BN_CFG_AUDIO_MAX_MIXING_RATE.
+     */
+    void set_mixing_rate(int mixing_rate);
+
+    /**
+     * @brief Returns the current maximum number of active music channels.
+     */
+    [[nodiscard]] int max_music_channels();
+
+    /**
+     * @brief Returns the current maximum number of active sound effects.
+     */
+    [[nodiscard]] int max_sound_channels();
+
+    /**
+     * @brief Sets the maximum number of active music channels and sound effects.
+     *
+     * Fewer channels free CPU time.
+     *
+     * The audio mixer is restarted when bn::core::update is called, stopping active music, sound effects and PCM streams,
+     * so they should be changed only between scenes.
+     *
+     * @param max_music_channels Maximum number of active music channels
+     * (in the range [1..@ref BN_CFG_AUDIO_MAX_MUSIC_CHANNELS]).
+     * @param max_sound_channels Maximum number of active sound effects
+     * (in the range [1..@ref BN_CFG_AUDIO_MAX_SOUND_CHANNELS]).
+     */
+    void set_max_channels(int max_music_channels, int max_sound_channels);
+
+    /**
+     * @brief Returns the timer ticks spent by the software audio mixer in the last frame.
+     *
+     * It is also reported by the profiler as `eng_audio_mixer` if @ref BN_CFG_PROFILER_LOG_ENGINE is enabled.
+     */
+    [[nodiscard]] int mixer_ticks();
 }
 
 #endif
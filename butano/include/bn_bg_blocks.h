@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BG_BLOCKS_H
+#define BN_BG_BLOCKS_H
+
+/**
+ * @file
+ * bn::bg_blocks header file.
+ *
+ * @ingroup bg
+ */
+
+#include "bn_common.h"
+
+/**
+ * @brief Background tiles and maps memory blocks related functions.
+ *
+ * @ingroup bg
+ */
+namespace bn::bg_blocks
+{
+    /**
+     * @brief Starts a batch of background tiles and maps uploads.
+     *
+     * The data of the background tiles and maps created from now on is not uploaded to VRAM
+     * until the batch is ended with end_batch.
+     *
+     * Backgrounds which reference tiles or maps not uploaded yet are not shown.
+     */
+    void begin_batch();
+
+    /**
+     * @brief Ends the current batch of background tiles and maps uploads.
+     *
+     * Background tiles and maps of the batch are uploaded in the next frames,
+     * in creation order and without exceeding the given number of bytes per frame
+     * (except when a single item is bigger than it).
+     *
+     * @param max_bytes_per_frame Maximum number of bytes to upload to VRAM each frame.
+     */
+    void end_batch(int max_bytes_per_frame);
+
+    /**
+     * @brief Indicates if there's a batch started or background tiles and maps of a batch not uploaded yet.
+     */
+    [[nodiscard]] bool batch_pending();
+}
+
+#endif
@@ -32,6 +32,7 @@ namespace bn
 {
 
 class color;
+class palette_cycle;
 class bg_palette_item;
 enum class bpp_mode : uint8_t;
 
@@ -232,6 +233,27 @@ public:
      */
     void set_rotate_count(int count);
 
+    /**
+     * @brief Returns the number of color cycles of this palette.
+     */
+    [[nodiscard]] int cycles_count() const;
+
+    /**
+     * @brief Adds a color cycle to this palette.
+     *
+     * Color cycles rotate the final colors of the palette when it is committed to the GBA,
+     * so the colors of this palette are not rewritten and applied palette effects are not recomputed.
+     *
+     * @param cycle Range of colors to rotate and rotation period.
+     * Its last color index must be lower than colors_count().
+     */
+    void add_cycle(const palette_cycle& cycle);
+
+    /**
+     * @brief Removes all color cycles of this palette.
+     */
+    void remove_cycles();
+
     /**
      * @brief Exchanges the contents of this bg_palette_ptr with those of the other one.
      * @param other bg_palette_ptr to exchange the contents with.
@@ -287,6 +309,19 @@ struct hash<bg_palette_ptr>
     }
 };
 
+
+/**
+ * @brief bg_palette_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup bg
+ * @ingroup palette
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<bg_palette_ptr> : true_type
+{
+};
+
 }
 
 #endif
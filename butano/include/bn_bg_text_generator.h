@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BG_TEXT_GENERATOR_H
+#define BN_BG_TEXT_GENERATOR_H
+
+/**
+ * @file
+ * bn::bg_text_generator header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+
+#include "bn_sprite_font.h"
+#include "bn_unordered_map.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_config_sprite_text.h"
+#include "bn_sprite_text_generator.h"
+
+namespace bn
+{
+
+/**
+ * @brief Prints text in a regular background from a given sprite_font, so it doesn't use any sprites.
+ *
+ * Each character is printed in one or more map cells, so only 4 bits per pixel fixed width fonts
+ * without space between characters are supported.
+ *
+ * Only the map rows modified since the last frame are uploaded to VRAM.
+ *
+ * By default, the background is placed so the top-left map cell is shown in the top-left corner of the screen.
+ *
+ * Keep in mind that it uses about 2KB of memory for the map cells.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+class bg_text_generator
+{
+
+public:
+    using alignment_type = sprite_text_generator::alignment_type; //!< Horizontal alignment type alias.
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     */
+    explicit bg_text_generator(const sprite_font& font);
+
+    bg_text_generator(const bg_text_generator& other) = delete;
+
+    bg_text_generator& operator=(const bg_text_generator& other) = delete;
+
+    /**
+     * @brief Returns the number of columns of the background map.
+     */
+    [[nodiscard]] constexpr static int columns()
+    {
+        return 32;
+    }
+
+    /**
+     * @brief Returns the number of rows of the background map.
+     */
+    [[nodiscard]] constexpr static int rows()
+    {
+        return 32;
+    }
+
+    /**
+     * @brief Returns the sprite font for drawing text.
+     */
+    [[nodiscard]] const sprite_font& font() const
+    {
+        return _font;
+    }
+
+    /**
+     * @brief Returns the background in which text is printed.
+     */
+    [[nodiscard]] const regular_bg_ptr& bg() const
+    {
+        return _bg;
+    }
+
+    /**
+     * @brief Returns the background in which text is printed.
+     */
+    [[nodiscard]] regular_bg_ptr& bg()
+    {
+        return _bg;
+    }
+
+    /**
+     * @brief Returns the horizontal alignment of the printed text.
+     */
+    [[nodiscard]] alignment_type alignment() const
+    {
+        return _alignment;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text.
+     */
+    void set_alignment(alignment_type alignment)
+    {
+        _alignment = alignment;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text to the left.
+     */
+    void set_left_alignment()
+    {
+        _alignment = alignment_type::LEFT;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text to the center.
+     */
+    void set_center_alignment()
+    {
+        _alignment = alignment_type::CENTER;
+    }
+
+    /**
+     * @brief Sets the horizontal alignment of the printed text to the right.
+     */
+    void set_right_alignment()
+    {
+        _alignment = alignment_type::RIGHT;
+    }
+
+    /**
+     * @brief Returns the width in map cells of the given text.
+     */
+    [[nodiscard]] int width(const string_view& text) const;
+
+    /**
+     * @brief Prints the given single line of text.
+     * @param column Map column of the text, considering the current alignment.
+     * @param row Map row of the top of the text.
+     * @param text Single line of text to print.
+     *
+     * Characters outside of the background map are not printed.
+     */
+    void print(int column, int row, const string_view& text);
+
+    /**
+     * @brief Erases the given map cells.
+     * @param column First map column to erase.
+     * @param row First map row to erase.
+     * @param columns_count Number of map columns to erase.
+     * @param rows_count Number of map rows to erase.
+     *
+     * Map cells outside of the background map are ignored.
+     */
+    void erase(int column, int row, int columns_count, int rows_count);
+
+    /**
+     * @brief Erases all printed text.
+     */
+    void clear();
+
+private:
+    alignas(int) regular_bg_map_cell _cells[32 * 32];
+    sprite_font _font;
+    unordered_map<int, int, BN_CFG_SPRITE_TEXT_MAX_UTF8_CHARACTERS> _utf8_characters_map;
+    regular_bg_map_ptr _map;
+    regular_bg_ptr _bg;
+    alignment_type _alignment = alignment_type::LEFT;
+    int8_t _character_columns;
+    int8_t _character_rows;
+
+    void _set_cell(int column, int row, int tile_index, int& first_dirty_row, int& last_dirty_row);
+
+    void _reload_rows(int first_dirty_row, int last_dirty_row);
+};
+
+}
+
+#endif
@@ -19,6 +19,14 @@
 namespace bn
 {
     using std::popcount;
+    using std::countl_zero;
+    using std::countl_one;
+    using std::countr_zero;
+    using std::countr_one;
+    using std::bit_ceil;
+    using std::bit_floor;
+    using std::bit_width;
+    using std::has_single_bit;
 }
 
 #endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BITMAP_BG_H
+#define BN_BITMAP_BG_H
+
+/**
+ * @file
+ * bn::bitmap_bg header file.
+ *
+ * @ingroup bitmap_bg
+ */
+
+#include "bn_span_fwd.h"
+#include "bn_config_bgs.h"
+
+namespace bn
+{
+    class size;
+    class point;
+}
+
+/**
+ * @brief Bitmap background related functions.
+ *
+ * The bitmap BG is a double buffered framebuffer of 8 bits per pixel (GBA mode 4).
+ *
+ * Drawing functions modify the back page, which is shown in the next core::update call.
+ * Only the pixels modified in the last frame are copied to the new back page after a page flip,
+ * so only changed regions must be redrawn.
+ *
+ * Pixels are indexes to the colors of the 8BPP BG palette (bn::bg_palette_ptr).
+ *
+ * Coordinates are framebuffer ones: (0, 0) is the top-left corner of the screen.
+ *
+ * It is available only if @ref BN_CFG_BGS_BITMAP_ENABLED is `true`.
+ *
+ * @ingroup bitmap_bg
+ */
+namespace bn::bitmap_bg
+{
+    /**
+     * @brief Returns the width of the bitmap BG in pixels.
+     */
+    [[nodiscard]] constexpr int width()
+    {
+        return 240;
+    }
+
+    /**
+     * @brief Returns the height of the bitmap BG in pixels.
+     */
+    [[nodiscard]] constexpr int height()
+    {
+        return 160;
+    }
+
+    /**
+     * @brief Indicates if the bitmap BG is shown or not.
+     */
+    [[nodiscard]] bool active();
+
+    /**
+     * @brief Clears both pages of the bitmap BG and shows it instead of the regular and affine BGs.
+     *
+     * Regular and affine BG tiles and maps can't be kept in VRAM while the bitmap BG is shown.
+     */
+    void start();
+
+    /**
+     * @brief Hides the bitmap BG.
+     */
+    void stop();
+
+    /**
+     * @brief Returns the number of pixels to show in the next page flip.
+     */
+    [[nodiscard]] int dirty_pixels_count();
+
+    /**
+     * @brief Fills the back page with the given color index.
+     */
+    void fill(int color_index);
+
+    /**
+     * @brief Fills a rectangle of the back page with the given color index.
+     * @param top_left Position of the top-left corner of the rectangle.
+     * @param dimensions Size in pixels of the rectangle.
+     * @param color_index Index of the color to fill the rectangle with.
+     *
+     * The rectangle is clipped to the screen boundaries.
+     */
+    void fill_rect(const point& top_left, const size& dimensions, int color_index);
+
+    /**
+     * @brief Copies the given pixels to the back page.
+     * @param pixels_ref Reference to the color indexes to copy, arranged in rows.
+     * @param pixels_dimensions Size in pixels of the given pixels.
+     * @param top_left Position of the top-left corner of the destination rectangle.
+     *
+     * The destination rectangle is clipped to the screen boundaries.
+     */
+    void copy_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions, const point& top_left);
+
+    /**
+     * @brief Copies the given pixels to the back page, skipping the ones with color index 0.
+     * @param pixels_ref Reference to the color indexes to copy, arranged in rows.
+     * @param pixels_dimensions Size in pixels of the given pixels.
+     * @param top_left Position of the top-left corner of the destination rectangle.
+     *
+     * The destination rectangle is clipped to the screen boundaries.
+     */
+    void copy_masked_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions,
+                          const point& top_left);
+
+    /**
+     * @brief Draws a line in the back page.
+     * @param a First point of the line (it must be inside the screen).
+     * @param b Second point of the line (it must be inside the screen).
+     * @param color_index Index of the color of the line.
+     */
+    void draw_line(const point& a, const point& b, int color_index);
+}
+
+#endif
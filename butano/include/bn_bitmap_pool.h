@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BITMAP_POOL_H
+#define BN_BITMAP_POOL_H
+
+/**
+ * @file
+ * bn::bitmap_pool implementation header file.
+ *
+ * @ingroup pool
+ */
+
+#include <new>
+#include "bn_bit.h"
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_bitmap_pool_fwd.h"
+
+namespace bn
+{
+
+template<typename Type, int MaxSize>
+class bitmap_pool
+{
+    static_assert(MaxSize > 0);
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+
+    /**
+     * @brief Const forward iterator over live elements in index order.
+     */
+    class const_iterator
+    {
+
+    public:
+        /**
+         * @brief Increments the position.
+         * @return Reference to this.
+         */
+        const_iterator& operator++()
+        {
+            _index = _pool->_next_index(_index + 1);
+            return *this;
+        }
+
+        /**
+         * @brief Returns a const reference to the pointed value.
+         */
+        [[nodiscard]] const_reference operator*() const
+        {
+            return _pool->_data()[_index];
+        }
+
+        /**
+         * @brief Returns a const pointer to the pointed value.
+         */
+        const_pointer operator->() const
+        {
+            return _pool->_data() + _index;
+        }
+
+        /**
+         * @brief Default equal operator.
+         */
+        [[nodiscard]] friend bool operator==(const const_iterator& a, const const_iterator& b) = default;
+
+    private:
+        friend class bitmap_pool;
+
+        const bitmap_pool* _pool;
+        int _index;
+
+        const_iterator(const bitmap_pool& pool, int index) :
+            _pool(&pool),
+            _index(index)
+        {
+        }
+    };
+
+    /**
+     * @brief Forward iterator over live elements in index order.
+     */
+    class iterator
+    {
+
+    public:
+        /**
+         * @brief Increments the position.
+         * @return Reference to this.
+         */
+        iterator& operator++()
+        {
+            _index = _pool->_next_index(_index + 1);
+            return *this;
+        }
+
+        /**
+         * @brief Returns a reference to the pointed value.
+         */
+        [[nodiscard]] reference operator*() const
+        {
+            return _pool->_data()[_index];
+        }
+
+        /**
+         * @brief Returns a pointer to the pointed value.
+         */
+        pointer operator->() const
+        {
+            return _pool->_data() + _index;
+        }
+
+        /**
+         * @brief Returns a const_iterator pointing to the same value.
+         */
+        operator const_iterator() const
+        {
+            return const_iterator(*_pool, _index);
+        }
+
+        /**
+         * @brief Default equal operator.
+         */
+        [[nodiscard]] friend bool operator==(const iterator& a, const iterator& b) = default;
+
+    private:
+        friend class bitmap_pool;
+
+        bitmap_pool* _pool;
+        int _index;
+
+        iterator(bitmap_pool& pool, int index) :
+            _pool(&pool),
+            _index(index)
+        {
+        }
+    };
+
+    /**
+     * @brief Default constructor.
+     */
+    bitmap_pool() = default;
+
+    bitmap_pool(const bitmap_pool& other) = delete;
+
+    bitmap_pool& operator=(const bitmap_pool& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~bitmap_pool() noexcept = default;
+
+    /**
+     * @brief Destructor.
+     *
+     * It destroys all live elements.
+     */
+    ~bitmap_pool() noexcept
+    requires(! is_trivially_destructible_v<Type>)
+    {
+        clear();
+    }
+
+    /**
+     * @brief Returns the number of live elements.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum possible number of live elements.
+     */
+    [[nodiscard]] constexpr size_type max_size() const
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Returns the remaining element capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return MaxSize - _size;
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any live element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == MaxSize;
+    }
+
+    /**
+     * @brief Returns a const iterator to the first live element.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return const_iterator(*this, _next_index(0));
+    }
+
+    /**
+     * @brief Returns an iterator to the first live element.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return iterator(*this, _next_index(0));
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the bitmap_pool.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return const_iterator(*this, MaxSize);
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the bitmap_pool.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return iterator(*this, MaxSize);
+    }
+
+    /**
+     * @brief Indicates if the given value belongs to the bitmap_pool or not.
+     */
+    [[nodiscard]] bool contains(const Type& value) const
+    {
+        const_pointer data = _data();
+        const_pointer value_ptr = &value;
+        return value_ptr >= data && value_ptr < data + MaxSize;
+    }
+
+    /**
+     * @brief Returns the index of the given value, which must belong to the bitmap_pool.
+     */
+    [[nodiscard]] size_type index(const Type& value) const
+    {
+        BN_ASSERT(contains(value), "Pool does not contain this value");
+
+        return &value - _data();
+    }
+
+    /**
+     * @brief Constructs a value inside of the bitmap_pool, in the free slot with the lowest index.
+     * @param args Parameters of the value to construct.
+     * @return Reference to the new value.
+     */
+    template<typename... Args>
+    [[nodiscard]] Type& create(Args&&... args)
+    {
+        BN_ASSERT(! full(), "Pool is full");
+
+        int word_index = 0;
+        unsigned free_bits = ~_used_words[0];
+
+        while(! free_bits)
+        {
+            ++word_index;
+            free_bits = ~_used_words[word_index];
+        }
+
+        int index = (word_index * 32) + countl_zero(free_bits);
+        _used_words[word_index] |= _bit(index);
+        ++_size;
+
+        Type* result = _data() + index;
+        ::new(result) Type(forward<Args>(args)...);
+        return *result;
+    }
+
+    /**
+     * @brief Destroys the given value, previously allocated with the create method.
+     */
+    void destroy(Type& value)
+    {
+        int index = this->index(value);
+        unsigned& used_word = _used_words[index / 32];
+        unsigned bit = _bit(index);
+        BN_ASSERT(used_word & bit, "Value is not allocated: ", index);
+
+        value.~Type();
+        used_word &= ~bit;
+        --_size;
+    }
+
+    /**
+     * @brief Destroys all live elements.
+     */
+    void clear()
+    {
+        if constexpr(! is_trivially_destructible_v<Type>)
+        {
+            pointer data = _data();
+
+            for(int index = _next_index(0); index < MaxSize; index = _next_index(index + 1))
+            {
+                data[index].~Type();
+            }
+        }
+
+        for(unsigned& used_word : _used_words)
+        {
+            used_word = 0;
+        }
+
+        _size = 0;
+    }
+
+private:
+    static constexpr int _words_count = (MaxSize + 31) / 32;
+
+    alignas(Type) char _buffer[sizeof(Type) * MaxSize];
+    unsigned _used_words[_words_count] = {};
+    int _size = 0;
+
+    // Slots are stored from the most significant bit, so they can be found with count leading zeros:
+    [[nodiscard]] static constexpr unsigned _bit(int index)
+    {
+        return 0x80000000u >> (index % 32);
+    }
+
+    [[nodiscard]] const_pointer _data() const
+    {
+        return reinterpret_cast<const_pointer>(_buffer);
+    }
+
+    [[nodiscard]] pointer _data()
+    {
+        return reinterpret_cast<pointer>(_buffer);
+    }
+
+    [[nodiscard]] int _next_index(int index) const
+    {
+        if(index >= MaxSize)
+        {
+            return MaxSize;
+        }
+
+        int word_index = index / 32;
+        unsigned used_bits = _used_words[word_index] & ((_bit(index) << 1) - 1);
+
+        while(! used_bits)
+        {
+            ++word_index;
+
+            if(word_index == _words_count)
+            {
+                return MaxSize;
+            }
+
+            used_bits = _used_words[word_index];
+        }
+
+        return (word_index * 32) + countl_zero(used_bits);
+    }
+};
+
+}
+
+#endif
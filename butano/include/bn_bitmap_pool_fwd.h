@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BITMAP_POOL_FWD_H
+#define BN_BITMAP_POOL_FWD_H
+
+/**
+ * @file
+ * bn::bitmap_pool declaration header file.
+ *
+ * @ingroup pool
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    /**
+     * @brief Pool implementation that uses a fixed size buffer and tracks occupancy with a bitmap.
+     *
+     * Free slots are found with count leading zeros instructions, and live elements can be iterated
+     * in index order without an external list.
+     *
+     * In contrast to bn::pool, live elements are destroyed in its destructor.
+     *
+     * @tparam Type Element type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     *
+     * @ingroup pool
+     */
+    template<typename Type, int MaxSize>
+    class bitmap_pool;
+}
+
+#endif
@@ -126,6 +126,100 @@ public:
         }
     };
 
+    /**
+     * @brief Forward iterator over the indexes of the bits set to `true` of an ibitset.
+     */
+    class set_bits_iterator
+    {
+
+    public:
+        /**
+         * @brief Returns the index of the referenced bit.
+         */
+        [[nodiscard]] constexpr int operator*() const
+        {
+            return _index;
+        }
+
+        /**
+         * @brief Moves the iterator to the next bit set to `true`.
+         * @return Reference to this.
+         */
+        constexpr set_bits_iterator& operator++()
+        {
+            _index = _bitset->find_next(_index);
+            return *this;
+        }
+
+        /**
+         * @brief Moves the iterator to the next bit set to `true`.
+         * @return Iterator before being moved.
+         */
+        constexpr set_bits_iterator operator++(int)
+        {
+            set_bits_iterator result = *this;
+            _index = _bitset->find_next(_index);
+            return result;
+        }
+
+        /**
+         * @brief Equal operator.
+         * @param a First set_bits_iterator to compare.
+         * @param b Second set_bits_iterator to compare.
+         * @return `true` if the first set_bits_iterator is equal to the second one, otherwise `false`.
+         */
+        [[nodiscard]] constexpr friend bool operator==(const set_bits_iterator& a, const set_bits_iterator& b)
+        {
+            return a._index == b._index;
+        }
+
+    private:
+        friend class ibitset;
+
+        const ibitset* _bitset;
+        int _index;
+
+        constexpr set_bits_iterator(const ibitset& bitset, int index) :
+            _bitset(&bitset),
+            _index(index)
+        {
+        }
+    };
+
+    /**
+     * @brief Iterable range over the indexes of the bits set to `true` of an ibitset.
+     */
+    class set_bits_range
+    {
+
+    public:
+        /**
+         * @brief Returns an iterator to the first bit set to `true`.
+         */
+        [[nodiscard]] constexpr set_bits_iterator begin() const
+        {
+            return set_bits_iterator(*_bitset, _bitset->find_first());
+        }
+
+        /**
+         * @brief Returns an iterator to the end of the range.
+         */
+        [[nodiscard]] constexpr set_bits_iterator end() const
+        {
+            return set_bits_iterator(*_bitset, _bitset->size());
+        }
+
+    private:
+        friend class ibitset;
+
+        const ibitset* _bitset;
+
+        constexpr explicit set_bits_range(const ibitset& bitset) :
+            _bitset(&bitset)
+        {
+        }
+    };
+
     ibitset(const ibitset& other) = delete;
 
     /**
@@ -374,6 +468,49 @@ public:
         return true;
     }
 
+    /**
+     * @brief Returns the index of the first bit set to `true`, or size() if all bits are `false`.
+     */
+    [[nodiscard]] constexpr int find_first() const
+    {
+        return _find_from_element(0);
+    }
+
+    /**
+     * @brief Returns the index of the first bit set to `true` after the specified one,
+     * or size() if there's no such bit.
+     */
+    [[nodiscard]] constexpr int find_next(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < size(), "Invalid index: ", index, " - ", size());
+
+        int next_index = index + 1;
+        int element_index = next_index >> _bits_per_element_log2;
+
+        if(element_index < _num_elements)
+        {
+            unsigned element = unsigned(_data[element_index]) >> (next_index & (_bits_per_element - 1));
+
+            if(element)
+            {
+                return next_index + countr_zero(element);
+            }
+        }
+
+        return _find_from_element(element_index + 1);
+    }
+
+    /**
+     * @brief Returns an iterable range with the indexes of the bits set to `true`.
+     *
+     * Iterating it takes time proportional to the number of elements plus the number of set bits,
+     * instead of the number of bits.
+     */
+    [[nodiscard]] constexpr set_bits_range set_bits() const
+    {
+        return set_bits_range(*this);
+    }
+
     /**
      * @brief Sets the bits to the result of binary AND of this ibitset and the given one.
      * @param other Another ibitset.
@@ -525,6 +662,19 @@ private:
     {
         return element_t(1) << (index & (_bits_per_element - 1));
     }
+
+    [[nodiscard]] constexpr int _find_from_element(int element_index) const
+    {
+        for(int num_elements = _num_elements; element_index < num_elements; ++element_index)
+        {
+            if(unsigned element = _data[element_index])
+            {
+                return (element_index << _bits_per_element_log2) + countr_zero(element);
+            }
+        }
+
+        return size();
+    }
 };
 
 
@@ -156,6 +156,40 @@ public:
      */
     void set_position(const fixed_point& position);
 
+    /**
+     * @brief Returns the expected movement of the camera per frame.
+     *
+     * It is not applied to the camera position: it is used only to predict it.
+     */
+    [[nodiscard]] const fixed_point& velocity() const;
+
+    /**
+     * @brief Sets the expected movement of the camera per frame.
+     *
+     * It is not applied to the camera position: it is used only to predict it.
+     */
+    void set_velocity(const fixed_point& velocity);
+
+    /**
+     * @brief Returns the expected change of the camera velocity per frame.
+     */
+    [[nodiscard]] const fixed_point& acceleration() const;
+
+    /**
+     * @brief Sets the expected change of the camera velocity per frame.
+     */
+    void set_acceleration(const fixed_point& acceleration);
+
+    /**
+     * @brief Returns the predicted position of the camera after the given number of frames,
+     * with sub-pixel precision.
+     *
+     * Each frame, velocity is increased by acceleration before moving the camera.
+     *
+     * @param frames Number of frames to predict (it must be >= 0).
+     */
+    [[nodiscard]] fixed_point predicted_position(int frames) const;
+
     /**
      * @brief Exchanges the contents of this camera_ptr with those of the other one.
      * @param other camera_ptr to exchange the contents with.
@@ -210,6 +244,18 @@ struct hash<camera_ptr>
     }
 };
 
+
+/**
+ * @brief camera_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup camera
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<camera_ptr> : true_type
+{
+};
+
 }
 
 #endif
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_COLLISION_GRID_H
+#define BN_COLLISION_GRID_H
+
+/**
+ * @file
+ * bn::icollision_grid and bn::collision_grid implementation header file.
+ *
+ * @ingroup math
+ */
+
+#include <new>
+#include "bn_bit.h"
+#include "bn_vector.h"
+#include "bn_fixed_rect.h"
+#include "bn_power_of_two.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::collision_grid.
+ *
+ * A collision grid is a uniform grid of cells which stores rectangles (items) in the cell of their top-left corner,
+ * so collision queries only test the items stored near the queried area instead of all of them.
+ *
+ * Items must not be wider or taller than a cell.
+ *
+ * The grid is centered in the origin: it covers columns() * cell_size() pixels horizontally
+ * and rows() * cell_size() pixels vertically. Items out of the grid are stored in its border cells,
+ * so they are still found by queries, but they are slower.
+ *
+ * Items are identified by an ID returned when they are added, which stays valid until they are removed.
+ *
+ * Queries run in IWRAM.
+ *
+ * @ingroup math
+ */
+class icollision_grid
+{
+
+public:
+    icollision_grid(const icollision_grid& other) = delete;
+
+    icollision_grid& operator=(const icollision_grid& other) = delete;
+
+    /**
+     * @brief Returns the number of columns of cells of the grid.
+     */
+    [[nodiscard]] int columns() const
+    {
+        return _columns;
+    }
+
+    /**
+     * @brief Returns the number of rows of cells of the grid.
+     */
+    [[nodiscard]] int rows() const
+    {
+        return _rows;
+    }
+
+    /**
+     * @brief Returns the width and the height of a cell in pixels.
+     */
+    [[nodiscard]] int cell_size() const
+    {
+        return 1 << _cell_shift;
+    }
+
+    /**
+     * @brief Returns the number of stored items.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum possible number of stored items.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Indicates if it doesn't store any item.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if it can't store any more items.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Indicates if the given ID references a stored item or not.
+     */
+    [[nodiscard]] bool contains_id(int id) const
+    {
+        return id >= 0 && id < _max_size && _items[id].cell >= 0;
+    }
+
+    /**
+     * @brief Returns the rectangle of the item referenced by the given ID.
+     */
+    [[nodiscard]] fixed_rect rect(int id) const;
+
+    /**
+     * @brief Sets the rectangle of the item referenced by the given ID.
+     *
+     * The item is moved to another cell only if the cell of its top-left corner has changed.
+     *
+     * @return `true` if the item has been moved to another cell; `false` otherwise.
+     */
+    bool update(int id, const fixed_rect& rect);
+
+    /**
+     * @brief Inserts the IDs of the items which intersect the given rectangle at the end of the given vector.
+     */
+    BN_CODE_IWRAM void query_rect(const fixed_rect& rect, ivector<int>& ids) const;
+
+    /**
+     * @brief Inserts the IDs of the items which intersect the segment between the given points
+     * at the end of the given vector.
+     *
+     * The cells inside the bounding box of the segment are visited, so long diagonal segments are slower.
+     */
+    BN_CODE_IWRAM void query_segment(const fixed_point& a, const fixed_point& b, ivector<int>& ids) const;
+
+    /**
+     * @brief Inserts the IDs of each pair of intersecting items at the end of the given vector.
+     *
+     * Each pair is inserted only once.
+     */
+    BN_CODE_IWRAM void query_pairs(ivector<pair<int, int>>& pairs) const;
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class item_type
+    {
+
+    public:
+        int left;
+        int top;
+        int right;
+        int bottom;
+        int16_t cell;
+        int16_t next;
+        int16_t previous;
+    };
+
+    icollision_grid(item_type* items, int16_t* cells, int max_size, int columns, int rows, int cell_shift) :
+        _items(items),
+        _cells(cells),
+        _max_size(max_size),
+        _columns(int16_t(columns)),
+        _rows(int16_t(rows)),
+        _cell_shift(int16_t(cell_shift))
+    {
+    }
+
+    [[nodiscard]] int _add(const fixed_rect& rect);
+
+    void _remove(int id);
+
+    void _clear();
+
+    /// @endcond
+
+private:
+    item_type* _items;
+    int16_t* _cells;
+    int _max_size;
+    int _size = 0;
+    int _first_free = -1;
+    int16_t _columns;
+    int16_t _rows;
+    int16_t _cell_shift;
+
+    [[nodiscard]] int _column(int x) const
+    {
+        int column = (x >> (fixed::precision() + _cell_shift)) + (_columns / 2);
+        return clamp(column, 0, _columns - 1);
+    }
+
+    [[nodiscard]] int _row(int y) const
+    {
+        int row = (y >> (fixed::precision() + _cell_shift)) + (_rows / 2);
+        return clamp(row, 0, _rows - 1);
+    }
+
+    void _set_rect(const fixed_rect& rect, item_type& item) const;
+
+    void _link(int id, int cell);
+
+    void _unlink(int id);
+};
+
+
+/**
+ * @brief Uniform grid collision broadphase.
+ *
+ * @tparam Type Element type of the values attached to the stored items.
+ * @tparam Columns Number of columns of cells of the grid.
+ * @tparam Rows Number of rows of cells of the grid.
+ * @tparam CellSize Width and height of a cell in pixels (it must be a power of two).
+ * @tparam MaxSize Maximum number of stored items.
+ *
+ * @ingroup math
+ */
+template<typename Type, int Columns, int Rows, int CellSize, int MaxSize>
+class collision_grid : public icollision_grid
+{
+    static_assert(Columns > 0 && Rows > 0 && Columns * Rows <= 32767);
+    static_assert(power_of_two(CellSize));
+    static_assert(MaxSize > 0 && MaxSize <= 32767);
+
+public:
+    using value_type = Type; //!< Value type alias.
+
+    /**
+     * @brief Default constructor.
+     */
+    collision_grid() :
+        icollision_grid(_items_buffer, _cells_buffer, MaxSize, Columns, Rows, countr_zero(unsigned(CellSize)))
+    {
+        _clear();
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~collision_grid()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Returns a const reference to the value attached to the item referenced by the given ID.
+     */
+    [[nodiscard]] const Type& value(int id) const
+    {
+        BN_ASSERT(contains_id(id), "Invalid id: ", id);
+
+        return *_value_ptr(id);
+    }
+
+    /**
+     * @brief Returns a reference to the value attached to the item referenced by the given ID.
+     */
+    [[nodiscard]] Type& value(int id)
+    {
+        BN_ASSERT(contains_id(id), "Invalid id: ", id);
+
+        return *_value_ptr(id);
+    }
+
+    /**
+     * @brief Adds a new item.
+     * @param value Value attached to the new item.
+     * @param rect Rectangle of the new item.
+     * @return ID of the new item.
+     */
+    int add(const Type& value, const fixed_rect& rect)
+    {
+        int id = _add(rect);
+        ::new(_value_ptr(id)) Type(value);
+        return id;
+    }
+
+    /**
+     * @brief Adds a new item, constructing its value in place.
+     * @param rect Rectangle of the new item.
+     * @param args Parameters of the value attached to the new item.
+     * @return ID of the new item.
+     */
+    template<typename... Args>
+    int emplace(const fixed_rect& rect, Args&&... args)
+    {
+        int id = _add(rect);
+        ::new(_value_ptr(id)) Type(forward<Args>(args)...);
+        return id;
+    }
+
+    /**
+     * @brief Removes the item referenced by the given ID.
+     */
+    void remove(int id)
+    {
+        BN_ASSERT(contains_id(id), "Invalid id: ", id);
+
+        _value_ptr(id)->~Type();
+        _remove(id);
+    }
+
+    /**
+     * @brief Removes all items.
+     */
+    void clear()
+    {
+        for(int id = 0; id < MaxSize; ++id)
+        {
+            if(contains_id(id))
+            {
+                _value_ptr(id)->~Type();
+            }
+        }
+
+        _clear();
+    }
+
+private:
+    item_type _items_buffer[MaxSize];
+    int16_t _cells_buffer[Columns * Rows];
+    alignas(Type) char _values_buffer[sizeof(Type) * MaxSize];
+
+    [[nodiscard]] const Type* _value_ptr(int id) const
+    {
+        return reinterpret_cast<const Type*>(_values_buffer) + id;
+    }
+
+    [[nodiscard]] Type* _value_ptr(int id)
+    {
+        return reinterpret_cast<Type*>(_values_buffer) + id;
+    }
+};
+
+}
+
+#endif
@@ -21,13 +21,21 @@ namespace bn
 /**
  * @brief Specifies the available compression types.
  *
+ * LZ77_HUFFMAN data is decompressed to an EWRAM staging buffer allocated with bn::memory::ewram_alloc first,
+ * so it is better to decompress it before VBlank
+ * (for example, with BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES for sprite tiles).
+ *
  * @ingroup tool
  */
 enum class compression_type : uint8_t
 {
     NONE, //!< Uncompressed data.
     LZ77, //!< LZ77 compressed data.
-    RUN_LENGTH //!< Run-length compressed data.
+    RUN_LENGTH, //!< Run-length compressed data.
+    CHUNKED, //!< Big map split in 32x32 cells chunks, each one compressed on its own with LZ77, run-length or LZ4.
+    LZ4, //!< LZ4 compressed data, decompressed by software faster than LZ77 compressed data.
+    HUFFMAN, //!< Huffman compressed data, decompressed by the GBA BIOS slower than LZ77 compressed data.
+    LZ77_HUFFMAN //!< LZ77 compressed data compressed again with Huffman, smaller but slower to decompress.
 };
 
 }
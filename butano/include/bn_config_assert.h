@@ -26,6 +26,32 @@
     #define BN_CFG_ASSERT_ENABLED true
 #endif
 
+/**
+ * @def BN_CFG_ASSERT_BASIC_ENABLED
+ *
+ * Specifies if BN_BASIC_ASSERT must be enabled when BN_CFG_ASSERT_ENABLED is `false`.
+ *
+ * In that case, BN_BASIC_ASSERT doesn't show the messages passed by argument.
+ *
+ * @ingroup assert
+ */
+#ifndef BN_CFG_ASSERT_BASIC_ENABLED
+    #define BN_CFG_ASSERT_BASIC_ENABLED true
+#endif
+
+/**
+ * @def BN_CFG_ASSERT_FULL_ENABLED
+ *
+ * Specifies if BN_FULL_ASSERT must be enabled or not.
+ *
+ * BN_FULL_ASSERT can't be enabled if BN_CFG_ASSERT_ENABLED is `false`.
+ *
+ * @ingroup assert
+ */
+#ifndef BN_CFG_ASSERT_FULL_ENABLED
+    #define BN_CFG_ASSERT_FULL_ENABLED BN_CFG_ASSERT_ENABLED
+#endif
+
 /**
  * @def BN_CFG_ASSERT_BUFFER_SIZE
  *
@@ -18,7 +18,7 @@
 /**
  * @def BN_CFG_AUDIO_MIXING_RATE
  *
- * Specifies software audio mixing rate in KHz.
+ * Specifies the initial software audio mixing rate in KHz (it can be changed with bn::audio::set_mixing_rate).
  *
  * Values not specified in BN_AUDIO_MIXING_RATE_* macros are not allowed.
  *
@@ -28,6 +28,57 @@
     #define BN_CFG_AUDIO_MIXING_RATE BN_AUDIO_MIXING_RATE_16_KHZ
 #endif
 
+/**
+ * @def BN_CFG_AUDIO_MAX_MIXING_RATE
+ *
+ * Specifies the highest software audio mixing rate in KHz that can be set with bn::audio::set_mixing_rate.
+ *
+ * Mixing buffers are allocated for this rate, so it must be greater or equal than @ref BN_CFG_AUDIO_MIXING_RATE.
+ *
+ * Values not specified in BN_AUDIO_MIXING_RATE_* macros are not allowed.
+ *
+ * @ingroup audio
+ */
+#ifndef BN_CFG_AUDIO_MAX_MIXING_RATE
+    #define BN_CFG_AUDIO_MAX_MIXING_RATE BN_CFG_AUDIO_MIXING_RATE
+#endif
+
+/**
+ * @def BN_CFG_AUDIO_MIXING_BUFFER_IWRAM
+ *
+ * Specifies if the Maxmod mixing buffer must be placed in IWRAM or in EWRAM.
+ *
+ * The mixer accumulates the samples of all active channels in this buffer,
+ * so placing it in IWRAM reduces the software mixer CPU usage a lot.
+ *
+ * Its size depends on @ref BN_CFG_AUDIO_MAX_MIXING_RATE (2112 bytes at 31 KHz).
+ *
+ * Maxmod places its mixing routines in IWRAM by itself.
+ *
+ * The software mixer CPU usage is reported by bn::audio::mixer_ticks.
+ *
+ * @ingroup audio
+ */
+#ifndef BN_CFG_AUDIO_MIXING_BUFFER_IWRAM
+    #define BN_CFG_AUDIO_MIXING_BUFFER_IWRAM true
+#endif
+
+/**
+ * @def BN_CFG_AUDIO_WAVE_BUFFER_IWRAM
+ *
+ * Specifies if the Maxmod output wave buffer must be placed in IWRAM or in EWRAM.
+ *
+ * The mixer writes its output in this buffer once per frame and DMA reads it all the time,
+ * so placing it in IWRAM reduces the software mixer CPU usage a little at the cost of more IWRAM usage.
+ *
+ * Its size depends on @ref BN_CFG_AUDIO_MAX_MIXING_RATE (2112 bytes at 31 KHz).
+ *
+ * @ingroup audio
+ */
+#ifndef BN_CFG_AUDIO_WAVE_BUFFER_IWRAM
+    #define BN_CFG_AUDIO_WAVE_BUFFER_IWRAM false
+#endif
+
 /**
  * @def BN_CFG_AUDIO_MAX_MUSIC_CHANNELS
  *
@@ -39,6 +90,19 @@
     #define BN_CFG_AUDIO_MAX_MUSIC_CHANNELS 16
 #endif
 
+/**
+ * @def BN_CFG_AUDIO_MAX_MUSIC_EVENTS
+ *
+ * Specifies the maximum number of music events (song message effects) stored per frame.
+ *
+ * It must be a power of two.
+ *
+ * @ingroup music
+ */
+#ifndef BN_CFG_AUDIO_MAX_MUSIC_EVENTS
+    #define BN_CFG_AUDIO_MAX_MUSIC_EVENTS 8
+#endif
+
 /**
  * @def BN_CFG_AUDIO_MAX_SOUND_CHANNELS
  *
@@ -50,6 +114,24 @@
     #define BN_CFG_AUDIO_MAX_SOUND_CHANNELS 4
 #endif
 
+/**
+ * @def BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES
+ *
+ * Specifies the maximum number of frames since a sound effect was played
+ * to collapse a new instance of it (same sound item and same speed and panning) into the active one.
+ *
+ * Collapsed instances don't use a new mixer channel: the volume of the active instance is increased instead,
+ * so the number of channels and the software mixer CPU usage stay bounded
+ * when the same sound effect is stacked a lot.
+ *
+ * If it is 0, only sound effects played more than once in the same frame are merged.
+ *
+ * @ingroup sound
+ */
+#ifndef BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES
+    #define BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES 0
+#endif
+
 /**
  * @def BN_CFG_AUDIO_MAX_COMMANDS
  *
@@ -57,6 +139,9 @@
  *
  * This queue is processed and cleared when bn::core::update() is called.
  *
+ * Sound effects played more than once in the same frame and music volume and position changes are merged,
+ * and if the queue is full sound effects with the lowest priority are discarded.
+ *
  * @ingroup audio
  */
 #ifndef BN_CFG_AUDIO_MAX_COMMANDS
@@ -26,6 +26,22 @@
     #define BN_CFG_BG_BLOCKS_MAX_ITEMS 16
 #endif
 
+/**
+ * @def BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+ *
+ * Specifies the number of decompressed chunks of bn::compression_type::CHUNKED big maps
+ * that can be kept in EWRAM at the same time.
+ *
+ * Each chunk uses 2KB. If it is 0, chunked big maps are not supported.
+ * Otherwise it must be at least 2, but 4 per chunked big map is recommended
+ * (one for each chunk that can be shown on screen at the same time).
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+    #define BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE 0
+#endif
+
 /**
  * @def BN_CFG_BG_BLOCKS_LOG_ENABLED
  *
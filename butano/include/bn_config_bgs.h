@@ -28,4 +28,35 @@
     #define BN_CFG_BGS_MAX_ITEMS 4
 #endif
 
+/**
+ * @def BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+ *
+ * Specifies how many extra rows of regular BGs with big maps must be copied to VRAM
+ * in the direction in which they are moving vertically.
+ *
+ * If it is greater than zero, the rows of regular BGs with big maps are copied to VRAM before V-Blank,
+ * so only new columns are copied during V-Blank.
+ *
+ * It must be in the range [0..8].
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+    #define BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS 0
+#endif
+
+/**
+ * @def BN_CFG_BGS_BITMAP_ENABLED
+ *
+ * Specifies if the bitmap BG can be shown or not.
+ *
+ * The pages of the bitmap BG overlap the first 512 sprite tiles,
+ * so if it is `true` those sprite tiles are never used.
+ *
+ * @ingroup bitmap_bg
+ */
+#ifndef BN_CFG_BGS_BITMAP_ENABLED
+    #define BN_CFG_BGS_BITMAP_ENABLED false
+#endif
+
 #endif
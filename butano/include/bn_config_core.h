@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_CORE_H
+#define BN_CONFIG_CORE_H
+
+/**
+ * @file
+ * Core configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_CORE_MAX_IDLE_TASKS
+ *
+ * Specifies the maximum number of pending tasks posted with bn::core::post_idle_task.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_CORE_MAX_IDLE_TASKS
+    #define BN_CFG_CORE_MAX_IDLE_TASKS 8
+#endif
+
+/**
+ * @def BN_CFG_CORE_MAX_TASKS
+ *
+ * Specifies the maximum number of bn::task objects that can be run by bn::core::update at the same time.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_CORE_MAX_TASKS
+    #define BN_CFG_CORE_MAX_TASKS 8
+#endif
+
+/**
+ * @def BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED
+ *
+ * Specifies if CPU and V-Blank usage statistics are collected while keypad commands or runs passed to
+ * bn::core::init are being replayed.
+ *
+ * When the replay ends, a summary is printed with bn::log, followed by the profiler results
+ * if the profiler is enabled, and by a `-- REPLAY BENCHMARK END ---` line,
+ * so replays can be used as automated performance tests.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED
+    #define BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_CORE_NESTED_IRQS_ENABLED
+ *
+ * Specifies if H-Blank and link IRQs can interrupt the V-Blank handler while it commits HDMA, audio, display,
+ * sprites, backgrounds and palettes changes.
+ *
+ * It makes the latency of H-Blank effects and link transfers deterministic when the V-Blank handler takes long,
+ * at the cost of making it a bit slower.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_CORE_NESTED_IRQS_ENABLED
+    #define BN_CFG_CORE_NESTED_IRQS_ENABLED false
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_EEPROM_H
+#define BN_CONFIG_EEPROM_H
+
+/**
+ * @file
+ * EEPROM configuration header file.
+ *
+ * @ingroup eeprom
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_EEPROM_SIZE
+ *
+ * Specifies the size in bytes of the Game Pak EEPROM.
+ *
+ * Allowed values are 0 (EEPROM is disabled), 512 and 8 * 1024.
+ *
+ * Flash and EEPROM can't be enabled at the same time, and bn::sram must not be used if EEPROM is enabled.
+ *
+ * @ingroup eeprom
+ */
+#ifndef BN_CFG_EEPROM_SIZE
+    #define BN_CFG_EEPROM_SIZE 0
+#endif
+
+#endif
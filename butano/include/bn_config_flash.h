@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_FLASH_H
+#define BN_CONFIG_FLASH_H
+
+/**
+ * @file
+ * Flash configuration header file.
+ *
+ * @ingroup flash
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_FLASH_SIZE
+ *
+ * Specifies the size in bytes of the Game Pak flash memory.
+ *
+ * Allowed values are 0 (flash is disabled), 64 * 1024 and 128 * 1024.
+ *
+ * Flash and EEPROM can't be enabled at the same time, and bn::sram must not be used if flash is enabled.
+ *
+ * @ingroup flash
+ */
+#ifndef BN_CFG_FLASH_SIZE
+    #define BN_CFG_FLASH_SIZE 0
+#endif
+
+/**
+ * @def BN_CFG_FLASH_WRITER_TASK_BYTES
+ *
+ * Specifies the maximum number of bytes compared or programmed by each idle task posted by bn::iflash_writer.
+ *
+ * @ingroup flash
+ */
+#ifndef BN_CFG_FLASH_WRITER_TASK_BYTES
+    #define BN_CFG_FLASH_WRITER_TASK_BYTES 32
+#endif
+
+#endif
@@ -55,4 +55,36 @@
     #define BN_CFG_GAME_PAK_WAIT_STATE_SECOND BN_GAME_PAK_WAIT_STATE_SECOND_AUTO
 #endif
 
+/**
+ * @def BN_CFG_GAME_PAK_WAIT_STATE_PROBE_ENABLED
+ *
+ * Specifies if the Game Pak wait states with `AUTO` values are selected with an extended probe.
+ *
+ * The probe reads a test pattern from ROM with each wait states setting, from the fastest to the slowest one,
+ * and selects the first one which reads the test pattern without errors.
+ *
+ * If it is disabled, only the slow Game Pak check is done.
+ *
+ * @ingroup game_pak
+ */
+#ifndef BN_CFG_GAME_PAK_WAIT_STATE_PROBE_ENABLED
+    #define BN_CFG_GAME_PAK_WAIT_STATE_PROBE_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET
+ *
+ * Specifies the SRAM offset in bytes where the result of the Game Pak wait states probe is stored,
+ * so later boots don't need to run it again.
+ *
+ * The probe result takes 12 bytes, which must not be used by the save data of the game.
+ *
+ * If it is negative, the probe result is not stored.
+ *
+ * @ingroup game_pak
+ */
+#ifndef BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET
+    #define BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET -1
+#endif
+
 #endif
@@ -29,4 +29,35 @@
     #define BN_CFG_HBES_MAX_ITEMS 6
 #endif
 
+/**
+ * @def BN_CFG_HBES_MAX_COMPOSITES
+ *
+ * Specifies the maximum number of pairs of 16-bit H-Blank effects composited in a single 32-bit stream.
+ *
+ * Two effects which write to adjacent 16-bit registers (like the horizontal and vertical position of a regular BG)
+ * are merged in one 32-bit write per scanline, reducing H-Blank interrupt latency.
+ *
+ * Each composite uses display::height() * 8 bytes of EWRAM.
+ *
+ * @ingroup hblank_effect
+ */
+#ifndef BN_CFG_HBES_MAX_COMPOSITES
+    #define BN_CFG_HBES_MAX_COMPOSITES 2
+#endif
+
+/**
+ * @def BN_CFG_HBES_DATA_IWRAM
+ *
+ * Specifies if the H-Blank effects output buffers must be placed in IWRAM instead of in EWRAM.
+ *
+ * IWRAM has no wait states and a 32-bit bus, so it speeds up H-Blank effects update
+ * and reduces H-Blank interrupt latency, but IWRAM is small:
+ * its usage can be checked with bn::memory::used_static_iwram.
+ *
+ * @ingroup hblank_effect
+ */
+#ifndef BN_CFG_HBES_DATA_IWRAM
+    #define BN_CFG_HBES_DATA_IWRAM false
+#endif
+
 #endif
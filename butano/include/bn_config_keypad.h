@@ -26,4 +26,19 @@
     #define BN_CFG_KEYPAD_LOG_ENABLED false
 #endif
 
+/**
+ * @def BN_CFG_KEYPAD_LOG_BINARY
+ *
+ * Specifies if the keypad logger writes run-length encoded keypad states instead of keypad commands.
+ *
+ * Each run is logged as a `0xNNNN,` hexadecimal word which can be pasted into a `uint16_t` array
+ * and replayed with bn::core::init(const span<const uint16_t>&).
+ * The lower 10 bits of each word store the held keys, and the upper 6 bits store the number of frames minus one.
+ *
+ * @ingroup keypad
+ */
+#ifndef BN_CFG_KEYPAD_LOG_BINARY
+    #define BN_CFG_KEYPAD_LOG_BINARY false
+#endif
+
 #endif
@@ -13,8 +13,41 @@
  * @ingroup link
  */
 
+#include "bn_link_transport.h"
 #include "bn_link_baud_rate.h"
 
+/**
+ * @def BN_CFG_LINK_TRANSPORT
+ *
+ * Specifies the hardware used for link communication.
+ *
+ * Values not specified in BN_LINK_TRANSPORT_* macros are not allowed.
+ *
+ * The wireless adapter sends pending messages in batches of up to 20 words for the host and 4 words for clients,
+ * so it allows to send more messages per frame with less CPU usage than the link cable.
+ *
+ * With the wireless adapter, the first GBA which doesn't find another one with the same game ID
+ * becomes the host (player 0), and the other ones join its room as clients.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_TRANSPORT
+    #define BN_CFG_LINK_TRANSPORT BN_LINK_TRANSPORT_CABLE
+#endif
+
+/**
+ * @def BN_CFG_LINK_WIRELESS_GAME_ID
+ *
+ * Specifies the identifier of the game broadcasted by the wireless adapter, in the range [0, 65535].
+ *
+ * Only GBAs with the same game ID can be connected with the wireless adapter.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_WIRELESS_GAME_ID
+    #define BN_CFG_LINK_WIRELESS_GAME_ID 0x7B6E
+#endif
+
 /**
  * @def BN_CFG_LINK_BAUD_RATE
  *
@@ -22,6 +55,8 @@
  *
  * Values not specified in BN_LINK_BAUD_RATE_* macros are not allowed.
  *
+ * It is used with the link cable only.
+ *
  * @ingroup link
  */
 #ifndef BN_CFG_LINK_BAUD_RATE
@@ -36,6 +71,8 @@
  * If this parameter is too low, some messages will be lost,
  * but if it is too high, CPU usage will increase a lot.
  *
+ * With the wireless adapter, it specifies how much time the GBA has to wait between data exchanges instead.
+ *
  * @ingroup link
  */
 #ifndef BN_CFG_LINK_SEND_WAIT
@@ -53,15 +90,44 @@
     #define BN_CFG_LINK_MAX_MESSAGES 8
 #endif
 
+/**
+ * @def BN_CFG_LINK_MAX_PACKET_SIZE
+ *
+ * Specifies the maximum number of words of a packet sent with bn::link::send(const span<const uint16_t>&).
+ *
+ * Each packet takes three more messages than its size, so BN_CFG_LINK_MAX_MESSAGES
+ * must be big enough to store at least one packet of the maximum size.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_MAX_PACKET_SIZE
+    #define BN_CFG_LINK_MAX_PACKET_SIZE 4
+#endif
+
 /**
  * @def BN_CFG_LINK_MAX_MISSING_MESSAGES
  *
  * Specifies the maximum number of missing messages before resetting the communication.
  *
+ * It is used with the link cable only.
+ *
  * @ingroup link
  */
 #ifndef BN_CFG_LINK_MAX_MISSING_MESSAGES
     #define BN_CFG_LINK_MAX_MISSING_MESSAGES 4
 #endif
 
+/**
+ * @def BN_CFG_LINK_LOCKSTEP_MAX_FRAMES
+ *
+ * Specifies the number of frames of input history stored by bn::link_lockstep.
+ *
+ * It must be a power of two, and the input delay of a bn::link_lockstep must be less than half of it.
+ *
+ * @ingroup link
+ */
+#ifndef BN_CFG_LINK_LOCKSTEP_MAX_FRAMES
+    #define BN_CFG_LINK_LOCKSTEP_MAX_FRAMES 16
+#endif
+
 #endif
@@ -13,6 +13,7 @@
  * @ingroup log
  */
 
+#include "bn_log_level.h"
 #include "bn_log_backend.h"
 
 /**
@@ -50,4 +51,50 @@
     #define BN_CFG_LOG_MAX_SIZE 0x100
 #endif
 
+/**
+ * @def BN_CFG_LOG_LEVEL
+ *
+ * Specifies the default log level threshold of the subsystems.
+ *
+ * BN_LOG_LEVEL sites with a level greater than the threshold of their subsystem are not compiled.
+ *
+ * Values not specified in BN_LOG_LEVEL_* macros are not allowed.
+ *
+ * @ingroup log
+ */
+#ifndef BN_CFG_LOG_LEVEL
+    #define BN_CFG_LOG_LEVEL BN_LOG_LEVEL_DEBUG
+#endif
+
+/**
+ * @def BN_CFG_LOG_SUBSYSTEM_LEVELS
+ *
+ * Specifies a comma separated list with the log level thresholds of the first subsystems.
+ *
+ * Subsystems not present in this list use BN_CFG_LOG_LEVEL as threshold.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * // Subsystem 0 logs errors only, subsystem 1 logs everything and subsystem 2 logs nothing:
+ * #define BN_CFG_LOG_SUBSYSTEM_LEVELS BN_LOG_LEVEL_ERROR, BN_LOG_LEVEL_DEBUG, BN_LOG_LEVEL_NONE
+ * @endcode
+ *
+ * @ingroup log
+ */
+#ifndef BN_CFG_LOG_SUBSYSTEM_LEVELS
+    #define BN_CFG_LOG_SUBSYSTEM_LEVELS
+#endif
+
+/**
+ * @def BN_CFG_LOG_DEFERRED_BUFFER_SIZE
+ *
+ * Specifies the size in bytes of the buffer in which BN_LOG_DEFERRED stores its parameters.
+ *
+ * @ingroup log
+ */
+#ifndef BN_CFG_LOG_DEFERRED_BUFFER_SIZE
+    #define BN_CFG_LOG_DEFERRED_BUFFER_SIZE 0x1000
+#endif
+
 #endif
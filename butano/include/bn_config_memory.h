@@ -28,4 +28,67 @@
     #define BN_CFG_MEMORY_MAX_EWRAM_ALLOC_ITEMS 16
 #endif
 
+/**
+ * @def BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+ *
+ * Specifies the size in bytes of the pages from which small EWRAM allocations (up to 128 bytes) are carved.
+ *
+ * Small allocations are grouped in 16, 32, 64 and 128 bytes size classes, and each page of a size class
+ * uses only one of the BN_CFG_MEMORY_MAX_EWRAM_ALLOC_ITEMS memory blocks,
+ * so many small objects can be allocated without increasing it.
+ *
+ * An empty page of each size class is kept allocated to avoid rebuilding it each time,
+ * so bn::memory::used_alloc_ewram returns the size of the pages instead of the size of the allocated objects.
+ *
+ * If it is 0, small allocations are not grouped in pages.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+    #define BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE 0
+#endif
+
+/**
+ * @def BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+ *
+ * Specifies if EWRAM allocations must be tracked or not.
+ *
+ * If it is enabled, allocation counts per frame, peak usage and the tag or caller address of each live block
+ * are recorded, and they can be printed with bn::memory::log_ewram_usage.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+    #define BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_MEMORY_EWRAM_TRACKING_MAX_BLOCKS
+ *
+ * Specifies the maximum number of live EWRAM blocks whose tag or caller address can be recorded
+ * when @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `true`.
+ *
+ * Blocks allocated when this limit has been reached are still counted, but they are reported as untracked.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_MEMORY_EWRAM_TRACKING_MAX_BLOCKS
+    #define BN_CFG_MEMORY_EWRAM_TRACKING_MAX_BLOCKS 64
+#endif
+
+/**
+ * @def BN_CFG_MEMORY_STACK_PAINT_ENABLED
+ *
+ * Specifies if the free IWRAM must be painted by bn::core::init to track the stack peak or not.
+ *
+ * Painting the free IWRAM writes up to 32KB at boot, so it can be disabled to reduce the time to the first frame.
+ * If it is disabled, bn::memory::max_used_stack_iwram and bn::memory::unused_iwram
+ * only take into account the current stack usage.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_MEMORY_STACK_PAINT_ENABLED
+    #define BN_CFG_MEMORY_STACK_PAINT_ENABLED true
+#endif
+
 #endif
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_PALETTES_H
+#define BN_CONFIG_PALETTES_H
+
+/**
+ * @file
+ * Color palettes configuration header file.
+ *
+ * @ingroup palette
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_PALETTES_MAX_CYCLES
+ *
+ * Specifies the maximum number of bn::palette_cycle items that can be active at the same time
+ * in the sprite palettes or in the background palettes.
+ *
+ * @ingroup palette
+ */
+#ifndef BN_CFG_PALETTES_MAX_CYCLES
+    #define BN_CFG_PALETTES_MAX_CYCLES 32
+#endif
+
+/**
+ * @def BN_CFG_PALETTES_DATA_IWRAM
+ *
+ * Specifies if the sprite and background palettes banks must be placed in IWRAM instead of in EWRAM.
+ *
+ * IWRAM has no wait states and a 32-bit bus, so it speeds up palette effects,
+ * but IWRAM is small: its usage can be checked with bn::memory::used_static_iwram.
+ *
+ * @ingroup palette
+ */
+#ifndef BN_CFG_PALETTES_DATA_IWRAM
+    #define BN_CFG_PALETTES_DATA_IWRAM false
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_PCM_STREAM_H
+#define BN_CONFIG_PCM_STREAM_H
+
+/**
+ * @file
+ * PCM stream configuration header file.
+ *
+ * @ingroup pcm_stream
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_PCM_STREAM_ENABLED
+ *
+ * Specifies if PCM streams can be played with bn::pcm_stream or not.
+ *
+ * If it is enabled, DMA channel 2 is reserved for Direct Sound B, so medium priority HDMA is not available.
+ *
+ * @ingroup pcm_stream
+ */
+#ifndef BN_CFG_PCM_STREAM_ENABLED
+    #define BN_CFG_PCM_STREAM_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_PCM_STREAM_BUFFER_FRAMES
+ *
+ * Specifies the number of frames of decoded samples stored in the PCM stream buffer.
+ *
+ * Bigger buffers allow to skip more frames without audio glitches, at the cost of more EWRAM usage.
+ *
+ * @ingroup pcm_stream
+ */
+#ifndef BN_CFG_PCM_STREAM_BUFFER_FRAMES
+    #define BN_CFG_PCM_STREAM_BUFFER_FRAMES 4
+#endif
+
+/**
+ * @def BN_CFG_PCM_STREAM_MAX_DECODE_FRAMES
+ *
+ * Specifies the maximum number of frames of samples decoded each time bn::core::update() is called,
+ * which bounds the PCM stream decoding CPU usage per frame.
+ *
+ * @ingroup pcm_stream
+ */
+#ifndef BN_CFG_PCM_STREAM_MAX_DECODE_FRAMES
+    #define BN_CFG_PCM_STREAM_MAX_DECODE_FRAMES 2
+#endif
+
+#endif
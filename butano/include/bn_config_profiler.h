@@ -42,6 +42,9 @@
  *
  * Specifies if each Butano subsystem must be profiled separately or not.
  *
+ * If it is `true`, each subsystem update and commit is profiled as a child of the general update and commit
+ * code blocks.
+ *
  * @ref BN_CFG_PROFILER_LOG_ENGINE must be `true` to enable Butano subsystems profiling.
  *
  * @ingroup profiler
@@ -61,4 +64,75 @@
     #define BN_CFG_PROFILER_MAX_ENTRIES 64
 #endif
 
+/**
+ * @def BN_CFG_PROFILER_MAX_DEPTH
+ *
+ * Specifies the maximum number of nested code blocks that can be profiled at the same time.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_MAX_DEPTH
+    #define BN_CFG_PROFILER_MAX_DEPTH 8
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_FRAMES_HISTORY
+ *
+ * Specifies the number of frames whose per code block elapsed time is stored by the profiler,
+ * so they can be printed with bn::profiler::log_frames.
+ *
+ * If it is 0, per frame elapsed time is not stored.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_FRAMES_HISTORY
+    #define BN_CFG_PROFILER_FRAMES_HISTORY 0
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_FRAMES_HISTORY_MAX_ENTRIES
+ *
+ * Specifies the maximum number of code blocks whose per frame elapsed time is stored by the profiler.
+ *
+ * Code blocks are stored in the order in which they are first profiled.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_FRAMES_HISTORY_MAX_ENTRIES
+    #define BN_CFG_PROFILER_FRAMES_HISTORY_MAX_ENTRIES 16
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_OVERLAY_MAX_SPRITES
+ *
+ * Specifies the maximum number of sprites used by a bn::profiler_overlay to show the profiling results.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_OVERLAY_MAX_SPRITES
+    #define BN_CFG_PROFILER_OVERLAY_MAX_SPRITES 64
+#endif
+
+/**
+ * @def BN_CFG_RASTER_MARKS_ENABLED
+ *
+ * Specifies if raster marks (see @ref BN_RASTER_MARK) are recorded or not.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_RASTER_MARKS_ENABLED
+    #define BN_CFG_RASTER_MARKS_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_RASTER_MARKS_MAX_ITEMS
+ *
+ * Specifies the maximum number of raster marks that can be recorded per frame.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_RASTER_MARKS_MAX_ITEMS
+    #define BN_CFG_RASTER_MARKS_MAX_ITEMS 32
+#endif
+
 #endif
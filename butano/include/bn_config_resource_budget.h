@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_RESOURCE_BUDGET_H
+#define BN_CONFIG_RESOURCE_BUDGET_H
+
+/**
+ * @file
+ * Resource budget configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_TILES
+ *
+ * Specifies the number of sprite tiles which bn::resource_budget must consider already used
+ * (by sprite texts or the profiler overlays, for example).
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_TILES
+    #define BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_TILES 0
+#endif
+
+/**
+ * @def BN_CFG_RESOURCE_BUDGET_RESERVED_BG_BLOCKS
+ *
+ * Specifies the number of BG blocks (2KB each) which bn::resource_budget must consider already used.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_RESOURCE_BUDGET_RESERVED_BG_BLOCKS
+    #define BN_CFG_RESOURCE_BUDGET_RESERVED_BG_BLOCKS 0
+#endif
+
+/**
+ * @def BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_PALETTES
+ *
+ * Specifies the number of 16 color sprite palette banks which bn::resource_budget must consider already used.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_PALETTES
+    #define BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_PALETTES 0
+#endif
+
+/**
+ * @def BN_CFG_RESOURCE_BUDGET_RESERVED_BG_PALETTES
+ *
+ * Specifies the number of 16 color BG palette banks which bn::resource_budget must consider already used.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_RESOURCE_BUDGET_RESERVED_BG_PALETTES
+    #define BN_CFG_RESOURCE_BUDGET_RESERVED_BG_PALETTES 0
+#endif
+
+#endif
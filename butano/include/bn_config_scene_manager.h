@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_SCENE_MANAGER_H
+#define BN_CONFIG_SCENE_MANAGER_H
+
+/**
+ * @file
+ * Scene manager configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_SCENE_MANAGER_MAX_ITEMS
+ *
+ * Specifies the maximum number of items of each type (sprite items, regular BG items, sprite palette items
+ * and BG palette items) that can be kept resident by a bn::scene_manager.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_SCENE_MANAGER_MAX_ITEMS
+    #define BN_CFG_SCENE_MANAGER_MAX_ITEMS 32
+#endif
+
+#endif
@@ -26,4 +26,26 @@
     #define BN_CFG_SPRITE_TEXT_MAX_UTF8_CHARACTERS 64
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TEXT_CACHE_MAX_ITEMS
+ *
+ * Specifies the maximum number of generated texts that can be stored in a bn::sprite_text_cache.
+ *
+ * @ingroup text
+ */
+#ifndef BN_CFG_SPRITE_TEXT_CACHE_MAX_ITEMS
+    #define BN_CFG_SPRITE_TEXT_CACHE_MAX_ITEMS 4
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE
+ *
+ * Specifies the maximum size in bytes of a text that can be stored in a bn::sprite_text_cache.
+ *
+ * @ingroup text
+ */
+#ifndef BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE
+    #define BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE 16
+#endif
+
 #endif
@@ -13,7 +13,7 @@
  * @ingroup sprite
  */
 
-#include "bn_common.h"
+#include "bn_sprite_tiles_allocation_policy.h"
 
 /**
  * @def BN_CFG_SPRITE_TILES_MAX_ITEMS
@@ -27,6 +27,68 @@
     #define BN_CFG_SPRITE_TILES_MAX_ITEMS 128
 #endif
 
+/**
+ * @def BN_CFG_SPRITE_TILES_ALLOCATION_POLICY
+ *
+ * Specifies how sprite tiles are placed in VRAM.
+ *
+ * Values not specified in BN_SPRITE_TILES_ALLOCATION_POLICY_* macros are not allowed.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_ALLOCATION_POLICY
+    #define BN_CFG_SPRITE_TILES_ALLOCATION_POLICY BN_SPRITE_TILES_ALLOCATION_POLICY_BEST_FIT
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_CACHE_ENABLED
+ *
+ * Specifies if sprite tiles created from sprite_tiles_item objects must be kept in VRAM
+ * after they are not referenced anymore, until the VRAM they use is needed by other sprite tiles.
+ *
+ * It avoids uploading again animation frames which are shown now and then,
+ * like when a lot of sprites run the same sprite_animate_action with different phases.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_CACHE_ENABLED
+    #define BN_CFG_SPRITE_TILES_CACHE_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+ *
+ * Specifies the maximum number of sprite tiles bytes that can be uploaded to VRAM in each frame.
+ *
+ * Tile sets which don't fit in the budget are uploaded in the next frames,
+ * in the same order they were requested, so their sprites keep showing the previous tiles meanwhile.
+ *
+ * At least one tile set is uploaded per frame, even if it exceeds the budget.
+ *
+ * If it is 0, there's no limit (all pending tile sets are uploaded in each frame).
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+    #define BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES 0
+#endif
+
+/**
+ * @def BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+ *
+ * Specifies the size in tiles of the EWRAM buffer used to decompress sprite tiles before VBlank.
+ *
+ * Compressed sprite tiles which fit in the buffer are decompressed in bn::core::update before VBlank,
+ * so they are copied to VRAM in VBlank instead of being decompressed to it.
+ *
+ * If it is 0, compressed sprite tiles are always decompressed directly to VRAM in VBlank.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+    #define BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES 0
+#endif
+
 /**
  * @def BN_CFG_SPRITE_TILES_LOG_ENABLED
  *
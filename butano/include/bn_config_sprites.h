@@ -43,4 +43,233 @@
     #define BN_CFG_SPRITES_MAX_SORT_LAYERS 16
 #endif
 
+/**
+ * @def BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+ *
+ * Specifies if sprites must be sorted in a fixed bucket per sort key (BG priority and z order)
+ * instead of in BN_CFG_SPRITES_MAX_SORT_LAYERS layers created on demand.
+ *
+ * Changing the BG priority or the z order of a sprite is faster when it is enabled,
+ * and there's no limit on the number of used sort layers,
+ * but z orders must be in the range defined by BN_CFG_SPRITES_BUCKET_SORT_MIN_Z_ORDER
+ * and BN_CFG_SPRITES_BUCKET_SORT_Z_ORDERS.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+    #define BN_CFG_SPRITES_BUCKET_SORT_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_BUCKET_SORT_MIN_Z_ORDER
+ *
+ * Specifies the minimum sprite z order if BN_CFG_SPRITES_BUCKET_SORT_ENABLED is true.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_BUCKET_SORT_MIN_Z_ORDER
+    #define BN_CFG_SPRITES_BUCKET_SORT_MIN_Z_ORDER -64
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_BUCKET_SORT_Z_ORDERS
+ *
+ * Specifies the number of sprite z orders starting from BN_CFG_SPRITES_BUCKET_SORT_MIN_Z_ORDER
+ * if BN_CFG_SPRITES_BUCKET_SORT_ENABLED is true.
+ *
+ * Each z order takes four buckets (one per BG priority) of EWRAM.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_BUCKET_SORT_Z_ORDERS
+    #define BN_CFG_SPRITES_BUCKET_SORT_Z_ORDERS 128
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MAX_Y_SORT_LAYERS
+ *
+ * Specifies the maximum number of sprite sort layers (BG priority and z order pairs)
+ * that can be sorted by their vertical position at the same time (see bn::sprites::set_y_sort_enabled).
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MAX_Y_SORT_LAYERS
+    #define BN_CFG_SPRITES_MAX_Y_SORT_LAYERS 4
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+ *
+ * Specifies if sprites attached to a camera must be grouped in coarse world cells.
+ *
+ * When it is enabled, moving a camera only updates the sprites placed in the cells near the screen,
+ * so the cost of moving a camera scales with the number of visible cells instead of with the number of sprites.
+ *
+ * It is useful for big worlds with lots of sprites outside of the screen.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+    #define BN_CFG_SPRITES_CAMERA_CELLS_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_CAMERA_CELL_SIZE
+ *
+ * Specifies the width and the height in pixels of each camera cell.
+ *
+ * It must be a power of two and it is only used if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED is true.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_CAMERA_CELL_SIZE
+    #define BN_CFG_SPRITES_CAMERA_CELL_SIZE 64
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_CAMERA_GRID_SIZE
+ *
+ * Specifies the number of columns and rows of the camera cells grid.
+ *
+ * Cells outside of the grid wrap around, so the grid covers a world area of
+ * (BN_CFG_SPRITES_CAMERA_CELL_SIZE * BN_CFG_SPRITES_CAMERA_GRID_SIZE) pixels squared before aliasing.
+ *
+ * It must be a power of two and it is only used if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED is true.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_CAMERA_GRID_SIZE
+    #define BN_CFG_SPRITES_CAMERA_GRID_SIZE 16
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_SOA
+ *
+ * Specifies if the sprite fields read every frame to check if sprites are on screen
+ * (hardware position, half dimensions and visibility flags) must be stored in a packed array in IWRAM
+ * instead of inside each sprite.
+ *
+ * When it is enabled, checking which sprites are on screen is a linear sweep over a small and fast array,
+ * at the cost of 16 bytes of IWRAM per sprite.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_SOA
+    #define BN_CFG_SPRITES_SOA false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+ *
+ * Specifies if the affine mats created by bn::sprite_ptr when rotating, scaling or shearing a sprite
+ * without an affine mat must be shared among all sprites with equal affine mat attributes
+ * (see bn::sprite_affine_mat_ptr::create_shared).
+ *
+ * When a sprite with a shared affine mat is rotated, scaled, sheared or flipped with bn::sprite_ptr methods,
+ * it is moved to another shared affine mat instead of modifying the one it shares with other sprites.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+    #define BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+ *
+ * Specifies if the last BN_CFG_SPRITES_MULTIPLEXER_HANDLES hardware sprite handles must be rewritten
+ * with HDMA in each H-Blank, so more than 128 sprites can be shown at the same time.
+ *
+ * The screen is divided in BN_CFG_SPRITES_MULTIPLEXER_BANDS horizontal bands,
+ * and the sprites that don't fit in the other hardware sprite handles are assigned to the bands they overlap.
+ * If a sprite doesn't fit in all of its bands, it is not shown
+ * (see bn::sprites::multiplexer_dropped_sprites_count).
+ *
+ * When it is enabled, medium priority HDMA is not available, the affine mats stored in the multiplexed handles
+ * can't be used and OAM access during H-Blank is enabled, which reduces the number of sprite pixels
+ * that can be drawn per scanline.
+ *
+ * It can't be enabled if BN_CFG_PCM_STREAM_ENABLED is `true`.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+    #define BN_CFG_SPRITES_MULTIPLEXER_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+ *
+ * Specifies the number of hardware sprite handles rewritten in each H-Blank
+ * if BN_CFG_SPRITES_MULTIPLEXER_ENABLED is `true`, which is the maximum number of multiplexed sprites per band.
+ *
+ * It must be a multiple of 4. Each handle takes 2576 bytes of EWRAM.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXER_HANDLES
+    #define BN_CFG_SPRITES_MULTIPLEXER_HANDLES 16
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_MULTIPLEXER_BANDS
+ *
+ * Specifies the number of horizontal bands in which the screen is divided
+ * if BN_CFG_SPRITES_MULTIPLEXER_ENABLED is `true`.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_MULTIPLEXER_BANDS
+    #define BN_CFG_SPRITES_MULTIPLEXER_BANDS 4
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+ *
+ * Specifies if the OBJ rendering cycles spent in each scanline must be estimated each frame
+ * from the shape, size and affine state of the hardware sprite handles.
+ *
+ * Sprites that don't fit in the cycles budget of a scanline are not drawn (or are drawn partially) by the GBA,
+ * so it is useful to diagnose disappearing sprites (see bn::sprites::worst_scanline_cycles).
+ *
+ * Sprites handles rewritten by the sprites multiplexer are not analyzed.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+    #define BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_EARLY_COMMIT_ENABLED
+ *
+ * Specifies if the hardware sprite handles built by bn::core::update must be copied to OAM with DMA
+ * as the first commit of the V-Blank handler, before updating HDMA and audio.
+ *
+ * It reduces the time in which OAM is being written after the V-Blank start,
+ * so late OAM writes are less likely to reach the first displayed scanlines.
+ *
+ * The low priority HDMA channel is used for the copy, and it is restarted afterwards.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_EARLY_COMMIT_ENABLED
+    #define BN_CFG_SPRITES_EARLY_COMMIT_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_SPRITES_DATA_IWRAM
+ *
+ * Specifies if the sprites manager data (sprites sorting layers and hardware handles) must be placed in IWRAM
+ * instead of in EWRAM.
+ *
+ * IWRAM has no wait states and a 32-bit bus, so it speeds up sprites update,
+ * but IWRAM is small: its usage can be checked with bn::memory::used_static_iwram.
+ *
+ * @ingroup sprite
+ */
+#ifndef BN_CFG_SPRITES_DATA_IWRAM
+    #define BN_CFG_SPRITES_DATA_IWRAM false
+#endif
+
 #endif
@@ -28,4 +28,15 @@
     #define BN_CFG_SRAM_WAIT_STATE BN_SRAM_WAIT_STATE_8
 #endif
 
+/**
+ * @def BN_CFG_SRAM_WRITER_TASK_BYTES
+ *
+ * Specifies the maximum number of bytes compared and written to SRAM by each idle task posted by bn::isram_writer.
+ *
+ * @ingroup sram
+ */
+#ifndef BN_CFG_SRAM_WRITER_TASK_BYTES
+    #define BN_CFG_SRAM_WRITER_TASK_BYTES 256
+#endif
+
 #endif
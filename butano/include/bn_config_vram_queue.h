@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_VRAM_QUEUE_H
+#define BN_CONFIG_VRAM_QUEUE_H
+
+/**
+ * @file
+ * VRAM queue configuration header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_VRAM_QUEUE_MAX_ITEMS
+ *
+ * Specifies the maximum number of pending writes that can be queued with bn::vram_queue::push.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_VRAM_QUEUE_MAX_ITEMS
+    #define BN_CFG_VRAM_QUEUE_MAX_ITEMS 16
+#endif
+
+/**
+ * @def BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES
+ *
+ * Specifies the maximum number of bytes that can be committed in each frame by sprite tiles,
+ * background tiles and maps and bn::vram_queue writes together.
+ *
+ * Queued writes are committed with the bytes left by sprite tiles and background tiles and maps,
+ * and writes which don't fit in the budget are committed in the next frames.
+ *
+ * At least one queued write is committed per frame, even if it exceeds the budget.
+ *
+ * If it is 0, there's no limit (all queued writes are committed in each frame).
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES
+    #define BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES 0
+#endif
+
+#endif
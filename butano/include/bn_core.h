@@ -19,6 +19,7 @@
 namespace bn
 {
     class string_view;
+    class vblank_stats;
 }
 
 namespace bn::keypad
@@ -33,6 +34,8 @@ namespace bn::keypad
  */
 namespace bn::core
 {
+    using idle_task_type = void(*)(); //!< Idle task function type alias.
+
     /**
      * @brief This function must be called before using Butano, and it must be called only once.
      */
@@ -46,6 +49,15 @@ namespace bn::core
      */
     void init(const string_view& keypad_commands);
 
+    /**
+     * @brief This function must be called before using Butano, and it must be called only once.
+     * @param keypad_runs Run-length encoded keypad states recorded with the binary keypad logger
+     * (see BN_CFG_KEYPAD_LOG_BINARY).
+     *
+     * Instead of reading the keypad of the GBA, these keypad states are replayed.
+     */
+    void init(const span<const uint16_t>& keypad_runs);
+
     /**
      * @brief Returns the number of frames to skip.
      *
@@ -60,11 +72,99 @@ namespace bn::core
      */
     void set_skip_frames(int skip_frames);
 
+    /**
+     * @brief Indicates if the logic-only fast-forward mode is enabled or not.
+     */
+    [[nodiscard]] bool fast_forward_enabled();
+
+    /**
+     * @brief Enables or disables the logic-only fast-forward mode.
+     *
+     * When it is enabled, update doesn't wait for the next V-Blank, so frames are run back-to-back
+     * as fast as the CPU allows. It is intended for headless simulations, like soak tests with keypad replays.
+     *
+     * All subsystems are still updated, and VRAM commit queues are still flushed,
+     * but display, sprite, BG and palette registers are not committed and audio is not mixed.
+     * Pending register changes are committed when fast-forward mode is disabled.
+     *
+     * Enabling or disabling it resets the fast-forward frames counter.
+     *
+     * @param enabled `true` to enable the fast-forward mode, `false` to disable it.
+     */
+    void set_fast_forward_enabled(bool enabled);
+
+    /**
+     * @brief Returns the number of frames updated since the fast-forward mode was enabled.
+     */
+    [[nodiscard]] int fast_forward_frames();
+
+    /**
+     * @brief Returns the number of frames updated per second since the fast-forward mode was enabled,
+     * or 0 if no frames have been updated yet.
+     */
+    [[nodiscard]] int fast_forward_frames_per_second();
+
+    /**
+     * @brief Returns the maximum number of frames to skip when adaptive frame skipping is enabled,
+     * or 0 if it is disabled.
+     */
+    [[nodiscard]] int max_adaptive_skip_frames();
+
+    /**
+     * @brief Enables or disables adaptive frame skipping.
+     *
+     * When it is enabled, the number of frames to skip is increased each time update takes more time than the
+     * current frame rate allows, and it is decreased when the last update would have fit with one less skip frame.
+     *
+     * Audio and keypad are updated each screen refresh regardless of the number of frames to skip.
+     *
+     * @param max_adaptive_skip_frames Maximum number of frames to skip, or 0 to disable adaptive frame skipping.
+     */
+    void set_max_adaptive_skip_frames(int max_adaptive_skip_frames);
+
     /**
      * @brief Updates the screen and all of Butano's subsystems.
      */
     void update();
 
+    /**
+     * @brief Posts a task to be run by update after Butano's subsystems have been updated,
+     * in the idle time until the next V-Blank.
+     *
+     * Tasks are run in posting order, and a task is run only if there's enough idle time left in the current frame,
+     * so long jobs should be split in small slices (each slice can post the next one).
+     *
+     * The idle time used by tasks is not taken into account by last_cpu_usage.
+     *
+     * @param task Function to run.
+     * @param max_ticks Maximum number of timer ticks that the task can take
+     * (it must be > 0 and < timers::ticks_per_frame()).
+     */
+    void post_idle_task(idle_task_type task, int max_ticks);
+
+    /**
+     * @brief Returns the number of posted tasks which have not been run yet.
+     */
+    [[nodiscard]] int pending_idle_tasks_count();
+
+    /**
+     * @brief Removes all posted tasks which have not been run yet.
+     */
+    void clear_idle_tasks();
+
+    /**
+     * @brief Halts the CPU until a keypad key is pressed or the given number of frames has elapsed,
+     * without updating Butano's subsystems.
+     *
+     * It is intended for static screens like menus or pause screens:
+     * audio and H-Blank effects keep working, but other changes made since the last update() call
+     * are not committed to the GBA until the next update() call.
+     *
+     * @param max_frames Maximum number of frames to wait (>= 1).
+     * @return `true` if a keypad key has been pressed, otherwise `false`.
+     */
+    bool wait_for_keypad(int max_frames);
+
     /**
      * @brief Sleeps the GBA until the given keypad key is pressed.
      */
@@ -89,6 +189,13 @@ namespace bn::core
      */
     [[nodiscard]] fixed current_cpu_usage();
 
+    /**
+     * @brief Returns the timer ticks spent by init before its first screen refresh.
+     *
+     * It can be used to measure the time to the first frame, which doesn't include the startup code run before main.
+     */
+    [[nodiscard]] int init_ticks();
+
     /**
      * @brief Returns the CPU usage of the last elapsed frame.
      *
@@ -104,6 +211,12 @@ namespace bn::core
      */
     [[nodiscard]] fixed last_vblank_usage();
 
+    /**
+     * @brief Returns the elapsed time and transferred bytes of each step committed to the GBA
+     * in the last screen refresh.
+     */
+    [[nodiscard]] const vblank_stats& last_vblank_stats();
+
     /**
      * @brief Indicates if a slow game pak like the SuperCard SD has been detected or not.
      */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CRC32_H
+#define BN_CRC32_H
+
+/**
+ * @file
+ * bn::crc32 header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    /**
+     * @brief Computes the CRC-32 (IEEE 802.3) checksum of the given data.
+     *
+     * It is computed with a lookup table stored in IWRAM.
+     *
+     * @param data Pointer to the data to hash.
+     * @param size Size in bytes of the data to hash.
+     * @param crc Checksum of the previous data, so a checksum can be computed in multiple calls.
+     * @return Checksum of the previous data and the given data.
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] BN_CODE_IWRAM uint32_t crc32(const void* data, int size, uint32_t crc = 0);
+}
+
+#endif
@@ -34,8 +34,10 @@ namespace bn
      *
      * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
      *
+     * Since its maximum size must be a power of two, indexes are wrapped with a bit mask instead of a modulo.
+     *
      * @tparam Type Element type.
-     * @tparam MaxSize Maximum number of elements that can be stored.
+     * @tparam MaxSize Maximum number of elements that can be stored (it must be a power of two).
      *
      * @ingroup deque
      */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DMG_SOUND_H
+#define BN_DMG_SOUND_H
+
+/**
+ * @file
+ * bn::dmg_sound header file.
+ *
+ * @ingroup dmg_sound
+ */
+
+#include "bn_span.h"
+#include "bn_fixed.h"
+#include "bn_dmg_sound_channel.h"
+
+namespace bn
+{
+    class dmg_sound_step;
+    class dmg_sound_item;
+}
+
+/**
+ * @brief DMG sound channels related functions.
+ *
+ * The four legacy DMG sound channels are generated by the hardware,
+ * so they don't use Direct Sound nor the software mixer.
+ *
+ * Sequenced sound effects and channel changes are committed to the hardware once per frame by bn::core::update.
+ *
+ * @ingroup dmg_sound
+ */
+namespace bn::dmg_sound
+{
+    /**
+     * @brief Plays the sequenced sound effect specified by the given dmg_sound_item,
+     * stopping the previous one played on its channel.
+     */
+    void play(const dmg_sound_item& item);
+
+    /**
+     * @brief Plays the given step on the specified channel until it is stopped,
+     * stopping the sound effect played on it.
+     *
+     * The frames of the step are ignored.
+     *
+     * @param channel DMG sound channel to modify.
+     * @param step Step to play.
+     * It must have been built for a channel of the same kind (a square wave step for a square wave channel, etc).
+     */
+    void play(dmg_sound_channel channel, const dmg_sound_step& step);
+
+    /**
+     * @brief Indicates if the specified channel is playing a sound effect or a step or not.
+     *
+     * Only sequenced sound effects stop automatically.
+     */
+    [[nodiscard]] bool playing(dmg_sound_channel channel);
+
+    /**
+     * @brief Stops the sound effect or the step played on the specified channel.
+     */
+    void stop(dmg_sound_channel channel);
+
+    /**
+     * @brief Stops the sound effects and the steps played on all channels.
+     */
+    void stop_all();
+
+    /**
+     * @brief Sets the wave pattern of the bn::dmg_sound_channel::WAVE channel.
+     * @param wave_pattern_ref 32 4-bit samples, two samples per byte, high nibble first.
+     *
+     * Wave sound effects set their own wave pattern when they are played.
+     */
+    void set_wave_pattern(const span<const uint8_t>& wave_pattern_ref);
+
+    /**
+     * @brief Returns the master volume of the DMG sound channels, in the range [0..1].
+     */
+    [[nodiscard]] fixed volume();
+
+    /**
+     * @brief Sets the master volume of the DMG sound channels.
+     * @param volume Volume level, in the range [0..1].
+     */
+    void set_volume(fixed volume);
+}
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DMG_SOUND_CHANNEL_H
+#define BN_DMG_SOUND_CHANNEL_H
+
+/**
+ * @file
+ * bn::dmg_sound_channel header file.
+ *
+ * @ingroup dmg_sound
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Available DMG sound channels.
+ *
+ * @ingroup dmg_sound
+ */
+enum class dmg_sound_channel : uint8_t
+{
+    SQUARE_1, //!< Square wave channel with frequency sweep.
+    SQUARE_2, //!< Square wave channel.
+    WAVE, //!< Programmable wave channel.
+    NOISE //!< Noise channel.
+};
+
+}
+
+#endif
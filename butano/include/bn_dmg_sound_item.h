@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DMG_SOUND_ITEM_H
+#define BN_DMG_SOUND_ITEM_H
+
+/**
+ * @file
+ * bn::dmg_sound_item header file.
+ *
+ * @ingroup dmg_sound
+ * @ingroup tool
+ */
+
+#include "bn_span.h"
+#include "bn_dmg_sound_step.h"
+#include "bn_dmg_sound_channel.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to play sequenced DMG sound effects.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.json file
+ * found in the audio folders.
+ *
+ * @ingroup dmg_sound
+ * @ingroup tool
+ */
+class dmg_sound_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param channel DMG sound channel used to play the sound effect.
+     * @param steps_ref Reference to the steps of the sound effect.
+     * @param wave_pattern_ref Reference to the wave pattern used by the bn::dmg_sound_channel::WAVE channel
+     * (32 4-bit samples, two samples per byte, high nibble first).
+     * It must be empty for the other channels.
+     *
+     * The steps and the wave pattern are not copied but referenced,
+     * so they should outlive the dmg_sound_item to avoid dangling references.
+     */
+    constexpr dmg_sound_item(dmg_sound_channel channel, const span<const dmg_sound_step>& steps_ref,
+                             const span<const uint8_t>& wave_pattern_ref = span<const uint8_t>()) :
+        _steps_ref(steps_ref),
+        _wave_pattern_ref(wave_pattern_ref),
+        _channel(channel)
+    {
+        BN_ASSERT(! steps_ref.empty(), "Steps ref is empty");
+        BN_ASSERT(channel == dmg_sound_channel::WAVE ? wave_pattern_ref.size() == 16 : wave_pattern_ref.empty(),
+                  "Invalid wave pattern ref size: ", wave_pattern_ref.size());
+    }
+
+    /**
+     * @brief Returns the DMG sound channel used to play the sound effect.
+     */
+    [[nodiscard]] constexpr dmg_sound_channel channel() const
+    {
+        return _channel;
+    }
+
+    /**
+     * @brief Returns the reference to the steps of the sound effect.
+     */
+    [[nodiscard]] constexpr const span<const dmg_sound_step>& steps_ref() const
+    {
+        return _steps_ref;
+    }
+
+    /**
+     * @brief Returns the reference to the wave pattern used by the bn::dmg_sound_channel::WAVE channel.
+     */
+    [[nodiscard]] constexpr const span<const uint8_t>& wave_pattern_ref() const
+    {
+        return _wave_pattern_ref;
+    }
+
+    /**
+     * @brief Returns the duration of the sound effect in frames.
+     */
+    [[nodiscard]] constexpr int frames() const
+    {
+        int result = 0;
+
+        for(const dmg_sound_step& step : _steps_ref)
+        {
+            result += step.frames();
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Plays the sound effect specified by this item, stopping the previous one played on its channel.
+     */
+    void play() const;
+
+private:
+    span<const dmg_sound_step> _steps_ref;
+    span<const uint8_t> _wave_pattern_ref;
+    dmg_sound_channel _channel;
+};
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DMG_SOUND_STEP_H
+#define BN_DMG_SOUND_STEP_H
+
+/**
+ * @file
+ * bn::dmg_sound_step header file.
+ *
+ * @ingroup dmg_sound
+ */
+
+#include "bn_assert.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the GBA sound registers values of a DMG sound channel for a number of frames.
+ *
+ * Steps should be built with the square, wave and noise static functions,
+ * and they must be played with a channel of the same kind.
+ *
+ * @ingroup dmg_sound
+ */
+class dmg_sound_step
+{
+
+public:
+    /**
+     * @brief Returns a step for a square wave channel.
+     * @param frequency Tone frequency in Hz, in the range [64..131072].
+     * @param volume Initial volume level, in the range [0..15].
+     * @param frames Number of frames to keep this step, in the range [1..255].
+     * @param duty Wave duty cycle, in the range [0..3] (12.5%, 25%, 50% or 75%).
+     * @param envelope_step_time Time between volume envelope steps in 1/64 seconds, in the range [0..7]
+     * (0 disables the volume envelope).
+     * @param envelope_increase Indicates if the volume envelope increases the volume or decreases it.
+     * @param restart Indicates if the sound must be restarted (the volume envelope is applied only if it is).
+     * @return The requested step.
+     */
+    [[nodiscard]] static constexpr dmg_sound_step square(
+            int frequency, int volume, int frames, int duty = 2, int envelope_step_time = 0,
+            bool envelope_increase = false, bool restart = true)
+    {
+        BN_ASSERT(frequency >= 64 && frequency <= 131072, "Invalid frequency: ", frequency);
+        BN_ASSERT(duty >= 0 && duty <= 3, "Invalid duty: ", duty);
+
+        return dmg_sound_step(_envelope_control(volume, envelope_step_time, envelope_increase) | (duty << 6),
+                              _frequency_control(2048 - (131072 / frequency), restart), 0, frames);
+    }
+
+    /**
+     * @brief Returns a step for the programmable wave channel.
+     * @param frequency Frequency in Hz of a whole wave pattern, in the range [32..65536].
+     * @param volume Volume level, in the range [0..4] (0%, 25%, 50%, 75% or 100%).
+     * @param frames Number of frames to keep this step, in the range [1..255].
+     * @param restart Indicates if the wave pattern must be restarted.
+     * @return The requested step.
+     */
+    [[nodiscard]] static constexpr dmg_sound_step wave(int frequency, int volume, int frames, bool restart = true)
+    {
+        BN_ASSERT(frequency >= 32 && frequency <= 65536, "Invalid frequency: ", frequency);
+        BN_ASSERT(volume >= 0 && volume <= 4, "Invalid volume: ", volume);
+
+        constexpr uint16_t volume_controls[] = { 0, 3 << 13, 2 << 13, 1 << 15, 1 << 13 };
+        return dmg_sound_step(volume_controls[volume], _frequency_control(2048 - (65536 / frequency), restart), 0,
+                              frames);
+    }
+
+    /**
+     * @brief Returns a step for the noise channel.
+     * @param divider Frequency divider ratio, in the range [0..7].
+     * @param shift Frequency shift, in the range [0..13].
+     * @param volume Initial volume level, in the range [0..15].
+     * @param frames Number of frames to keep this step, in the range [1..255].
+     * @param seven_steps Indicates if the noise generator uses 7 bits instead of 15 (more regular noise).
+     * @param envelope_step_time Time between volume envelope steps in 1/64 seconds, in the range [0..7]
+     * (0 disables the volume envelope).
+     * @param envelope_increase Indicates if the volume envelope increases the volume or decreases it.
+     * @param restart Indicates if the sound must be restarted (the volume envelope is applied only if it is).
+     * @return The requested step.
+     */
+    [[nodiscard]] static constexpr dmg_sound_step noise(
+            int divider, int shift, int volume, int frames, bool seven_steps = false, int envelope_step_time = 0,
+            bool envelope_increase = false, bool restart = true)
+    {
+        BN_ASSERT(divider >= 0 && divider <= 7, "Invalid divider: ", divider);
+        BN_ASSERT(shift >= 0 && shift <= 13, "Invalid shift: ", shift);
+
+        int frequency = divider | (int(seven_steps) << 3) | (shift << 4);
+        return dmg_sound_step(_envelope_control(volume, envelope_step_time, envelope_increase),
+                              frequency | (int(restart) << 15), 0, frames);
+    }
+
+    /**
+     * @brief Constructor.
+     * @param control Value of the control GBA register of the channel.
+     * @param frequency Value of the frequency GBA register of the channel.
+     * @param sweep Value of the sweep GBA register (used by the bn::dmg_sound_channel::SQUARE_1 channel only).
+     * @param frames Number of frames to keep this step, in the range [1..255].
+     */
+    constexpr dmg_sound_step(int control, int frequency, int sweep, int frames) :
+        _control(uint16_t(control)),
+        _frequency(uint16_t(frequency)),
+        _sweep(uint8_t(sweep)),
+        _frames(uint8_t(frames))
+    {
+        BN_ASSERT(frames >= 1 && frames <= 255, "Invalid frames: ", frames);
+    }
+
+    /**
+     * @brief Returns a copy of this step with frequency sweep
+     * (it is applied by the bn::dmg_sound_channel::SQUARE_1 channel only).
+     * @param sweep_shift Frequency change shift, in the range [0..7].
+     * @param sweep_step_time Time between sweep steps in 1/128 seconds, in the range [0..7] (0 disables the sweep).
+     * @param sweep_decrease Indicates if the sweep decreases the frequency or increases it.
+     * @return The requested step.
+     */
+    [[nodiscard]] constexpr dmg_sound_step with_sweep(int sweep_shift, int sweep_step_time,
+                                                      bool sweep_decrease = false) const
+    {
+        BN_ASSERT(sweep_shift >= 0 && sweep_shift <= 7, "Invalid sweep shift: ", sweep_shift);
+        BN_ASSERT(sweep_step_time >= 0 && sweep_step_time <= 7, "Invalid sweep step time: ", sweep_step_time);
+
+        return dmg_sound_step(_control, _frequency, sweep_shift | (int(sweep_decrease) << 3) | (sweep_step_time << 4),
+                              _frames);
+    }
+
+    /**
+     * @brief Returns the value of the control GBA register of the channel.
+     */
+    [[nodiscard]] constexpr int control() const
+    {
+        return _control;
+    }
+
+    /**
+     * @brief Returns the value of the frequency GBA register of the channel.
+     */
+    [[nodiscard]] constexpr int frequency() const
+    {
+        return _frequency;
+    }
+
+    /**
+     * @brief Returns the value of the sweep GBA register.
+     */
+    [[nodiscard]] constexpr int sweep() const
+    {
+        return _sweep;
+    }
+
+    /**
+     * @brief Returns the number of frames to keep this step.
+     */
+    [[nodiscard]] constexpr int frames() const
+    {
+        return _frames;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const dmg_sound_step& a, const dmg_sound_step& b) = default;
+
+private:
+    uint16_t _control;
+    uint16_t _frequency;
+    uint8_t _sweep;
+    uint8_t _frames;
+
+    [[nodiscard]] static constexpr int _envelope_control(int volume, int envelope_step_time, bool envelope_increase)
+    {
+        BN_ASSERT(volume >= 0 && volume <= 15, "Invalid volume: ", volume);
+        BN_ASSERT(envelope_step_time >= 0 && envelope_step_time <= 7,
+                  "Invalid envelope step time: ", envelope_step_time);
+
+        return (envelope_step_time << 8) | (int(envelope_increase) << 11) | (volume << 12);
+    }
+
+    [[nodiscard]] static constexpr int _frequency_control(int rate, bool restart)
+    {
+        return rate | (int(restart) << 15);
+    }
+};
+
+}
+
+#endif
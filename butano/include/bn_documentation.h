@@ -109,6 +109,14 @@
  * @ingroup bg
  */
 
+/**
+ * @defgroup bitmap_bg Bitmap background
+ *
+ * Background which shows a framebuffer of 8 bits per pixel (GBA mode 4).
+ *
+ * @ingroup bg
+ */
+
 /**
  * @defgroup sprite Sprites
  *
@@ -186,6 +194,24 @@
  * @ingroup audio
  */
 
+/**
+ * @defgroup pcm_stream PCM streams
+ *
+ * IMA ADPCM audio streamed from ROM with Direct Sound B.
+ *
+ * It must be enabled with BN_CFG_PCM_STREAM_ENABLED.
+ *
+ * @ingroup audio
+ */
+
+/**
+ * @defgroup dmg_sound DMG sound effects
+ *
+ * Sound effects generated by the legacy DMG sound channels, without using the software mixer.
+ *
+ * @ingroup audio
+ */
+
 /**
  * @defgroup keypad Keypad
  *
@@ -194,6 +220,9 @@
  * Keypad logging can be enabled or disabled by overloading the definition of @a BN_CFG_KEYPAD_LOG_ENABLED @a .
  *
  * Recorded key presses can be replayed later by passing the log to @a bn::core::init() @a .
+ *
+ * If @a BN_CFG_KEYPAD_LOG_BINARY @a is `true`, run-length encoded keypad states are logged instead,
+ * which are much smaller than keypad commands.
  */
 
 /**
@@ -235,6 +264,9 @@
  *
  * They are also higher level than HDMA, so they should be your first option.
  *
+ * Register values H-Blank effects (like bn::affine_bg_pa_register_hbe_ptr) read tables stored in ROM directly,
+ * so they don't copy them to an internal buffer.
+ *
  * @ingroup display
  */
 
@@ -284,12 +316,38 @@
  * @ingroup game_pak
  */
 
+/**
+ * @defgroup flash Game Pak flash
+ *
+ * Allows game or application data to be saved in Game Pak flash memory when the GBA is turned off.
+ *
+ * It must be enabled with BN_CFG_FLASH_SIZE.
+ *
+ * @ingroup game_pak
+ */
+
+/**
+ * @defgroup eeprom Game Pak EEPROM
+ *
+ * Allows game or application data to be saved in Game Pak EEPROM when the GBA is turned off.
+ *
+ * It must be enabled with BN_CFG_EEPROM_SIZE.
+ *
+ * @ingroup game_pak
+ */
+
 /**
  * @defgroup rumble Rumble
  *
  * It allows your GBA to vibrate, if the cart supports it.
  */
 
+/**
+ * @defgroup rtc Real-time clock
+ *
+ * It allows to retrieve the current date and time, if the cart has a real-time clock.
+ */
+
 /**
  * @defgroup camera Cameras
  *
@@ -311,6 +369,10 @@
  *
  * It can be enabled or disabled by overloading the definition of @a BN_CFG_ASSERT_ENABLED @a .
  *
+ * Cheap checks done with BN_BASIC_ASSERT can stay enabled when it is disabled
+ * (see @a BN_CFG_ASSERT_BASIC_ENABLED @a ), and expensive checks done with BN_FULL_ASSERT can be disabled
+ * while keeping the other ones (see @a BN_CFG_ASSERT_FULL_ENABLED @a ).
+ *
  * Note that these asserts can be used in constexpr contexts (is_constant_evaluated() returns `true`).
  */
 
@@ -325,6 +387,9 @@
  *
  * It supports printing on only one emulator at once.
  * The supported emulator can be changed by overloading the definition of @a BN_CFG_LOG_BACKEND @a .
+ *
+ * BN_LOG_DEFERRED avoids formatting messages in hot paths,
+ * storing its parameters until BN_LOG_DEFERRED_FLUSH is called.
  */
 
 /**
@@ -366,6 +431,15 @@
  * @ingroup container
  */
 
+/**
+ * @defgroup spsc_ring Single producer single consumer ring buffer
+ *
+ * Ring buffer with the capacity defined at compile time, which allows to pass data from interrupt handlers
+ * to the main loop (or vice versa) without disabling interrupts.
+ *
+ * @ingroup container
+ */
+
 /**
  * @defgroup deque Deque
  *
@@ -430,6 +504,26 @@
  * @ingroup container
  */
 
+/**
+ * @defgroup flat_map Flat map
+ *
+ * `std::flat_map` like container with the capacity defined at compile time.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @ingroup container
+ */
+
+/**
+ * @defgroup flat_set Flat set
+ *
+ * `std::flat_set` like container with the capacity defined at compile time.
+ *
+ * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+ *
+ * @ingroup container
+ */
+
 /**
  * @defgroup unordered_set Unordered set
  *
@@ -993,21 +1087,46 @@
  * * `"type"`: must be `"sprite"` for sprites.
  * * `"height"`: height of each sprite image in pixels.
  * For example, if the specified height is 32, an image with 128 pixels of height contains 4 sprite images.
+ * * `"palette_group"`: optional field which specifies the name of a palette group.
+ * The colors of the 16 color sprites of the same palette group are packed in as few palettes as possible,
+ * and their color indexes are remapped to them, so sprites with the same palette share one palette bank at runtime.
  * * `"tiles_compression"`: optional field which specifies the compression of the tiles data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  * * `"compression"`: optional field which specifies the compression of the tiles and the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
+ * * `"tiles_deltas"`: optional field which specifies if a bn::sprite_tiles_delta_item named `<name>_tiles_delta`
+ * must be generated too, so sequential animations can upload to VRAM only the tiles words which change
+ * (see bn::sprite_tiles_ptr::set_tiles_ref). It requires uncompressed tiles and more than one sprite image.
+ * * `"repeated_graphics_reduction"`: optional field which specifies if repeated sprite images must be stored once,
+ * so they are uploaded to VRAM once too when they are shown at the same time (default is `false`).
+ * It requires uncompressed tiles and it can't be enabled with `"tiles_deltas"` or in sprite fonts.
+ * * `"quarter_rotations"`: optional field which specifies if a copy of each sprite image rotated 90 degrees
+ * counterclockwise must be stored after the original ones, so square sprites can be rotated by multiples of 90 degrees
+ * without an affine matrix (see bn::sprite_ptr::set_quarter_rotation). Default is `false`.
+ * It requires square sprites and uncompressed tiles, and it can't be enabled with `"tiles_deltas"`.
  *
  * If the conversion process has finished successfully,
  * a bn::sprite_item should have been generated in the `build` folder.
@@ -1051,7 +1170,21 @@
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
+ * * `"tiles_deltas"`: optional field which specifies if a bn::sprite_tiles_delta_item named `<name>_tiles_delta`
+ * must be generated too, so sequential animations can upload to VRAM only the tiles words which change
+ * (see bn::sprite_tiles_ptr::set_tiles_ref). It requires uncompressed tiles and more than one tiles set.
+ * * `"repeated_graphics_reduction"`: optional field which specifies if repeated tiles sets must be stored once,
+ * so they are uploaded to VRAM once too when they are shown at the same time (default is `false`).
+ * It requires uncompressed tiles and it can't be enabled with `"tiles_deltas"` or in sprite fonts.
+ * * `"quarter_rotations"`: optional field which specifies if a copy of each tiles set rotated 90 degrees
+ * counterclockwise must be stored after the original ones, so square sprites can be rotated by multiples of 90 degrees
+ * without an affine matrix (see bn::sprite_ptr::set_quarter_rotation). Default is `false`.
+ * It requires square sprites and uncompressed tiles, and it can't be enabled with `"tiles_deltas"`.
  *
  * If the conversion process has finished successfully,
  * a bn::sprite_tiles_item should have been generated in the `build` folder.
@@ -1085,6 +1218,10 @@
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  *
  * If the conversion process has finished successfully,
@@ -1126,6 +1263,11 @@
  *   * `"bpp_4_auto"`: up to 16 colors per @ref tile "tile".
  * Butano tries to quantize the image to fit the color palette into the required one.
  * It is not supported if an external bn::bg_palette_item is referenced with `"palette_item"`.
+ *   * `"bpp_4_auto_lossy"`: up to 16 colors per @ref tile "tile".
+ * Like `"bpp_4_auto"`, but if the image doesn't fit in 16 palette banks,
+ * the least used colors of each tile and of each palette bank are replaced with the nearest ones.
+ * The number of changed pixels is shown in the build output.
+ * It is not supported if an external bn::bg_palette_item is referenced with `"palette_item"`.
  *   * `"bpp_4_manual"`: up to 16 colors per @ref tile "tile".
  * Butano expects that the image color palette is already valid for this mode.
  *   * `"bpp_4"`: `"bpp_4_manual"` alias.
@@ -1135,25 +1277,46 @@
  * (`true` by default).
  * * `"flipped_tiles_reduction"`: optional field which specifies if flipped tiles must be reduced or not
  * (`true` by default).
+ * * `"tiles_report"`: optional field which specifies if a report with the number of unique tiles and
+ * the VRAM blocks saved by removing repeated and flipped tiles must be written in the build folder or not
+ * (`false` by default).
  * * `"tiles_compression"`: optional field which specifies the compression of the tiles data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  * * `"map_compression"`: optional field which specifies the compression of the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"chunked"`: big map split in 32x32 cells chunks, each one compressed on its own.
+ *     It requires @ref BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE to be greater than zero.
  * * `"compression"`: optional field which specifies the compression of the tiles, the colors and the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  *
  * If the conversion process has finished successfully,
@@ -1195,21 +1358,39 @@
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  * * `"map_compression"`: optional field which specifies the compression of the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
+ *   * `"chunked"`: big map split in 32x32 cells chunks, each one compressed on its own.
+ *     It requires @ref BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE to be greater than zero.
  * * `"compression"`: optional field which specifies the compression of the tiles, the colors and the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  *
  * If the conversion process has finished successfully,
@@ -1248,6 +1429,10 @@
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: Run-length compressed data.
+ *   * `"lz4"`: LZ4 compressed data (bigger than LZ77 compressed data, but faster to decompress).
+ *   * `"huffman"`: Huffman compressed data (slower to decompress than LZ77 compressed data, ignored by `"auto"`).
+ *   * `"lz77_huffman"`: LZ77 compressed data compressed again with Huffman (smaller but slower to decompress
+ *     than LZ77 compressed data, ignored by `"auto"`).
  *   * `"auto"`: uses the option which gives the smallest data size.
  *
  * If the conversion process has finished successfully,
@@ -1265,6 +1450,155 @@
  * @endcode
  *
  *
+ * @subsection import_tile_collision_map Tile collision maps
+ *
+ * Tile collision maps store a collision value for each 8x8 cell of an image,
+ * usually painted over a copy of a background map.
+ *
+ * The collision value of each cell is the most used color index of its pixels, and it must be in the range [0..3].
+ *
+ * An example of the `*.json` files required for tile collision maps is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "tile_collision_map"
+ * }
+ * @endcode
+ *
+ * The fields for tile collision maps are the following:
+ * * `"type"`: must be `"tile_collision_map"` for tile collision maps.
+ * * `"bits_per_cell"`: optional field which specifies the bits used by each collision value (1 or 2).
+ * By default it is 1 if all collision values are 0 or 1, and 2 otherwise.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::tile_collision_map_item should have been generated in the `build` folder.
+ *
+ * For example, from two files named `level.bmp` and `level.json`,
+ * a header file named `bn_tile_collision_map_items_level.h` is generated in the `build` folder.
+ *
+ * You can use this header to run collision queries with bn::tile_collision_map:
+ *
+ * @code{.cpp}
+ * #include "bn_tile_collision_map.h"
+ * #include "bn_tile_collision_map_items_level.h"
+ *
+ * bn::tile_collision_map collision_map(bn::tile_collision_map_items::level);
+ * bn::fixed_point delta = collision_map.sweep(player_rect, player_velocity);
+ * @endcode
+ *
+ *
+ * @subsection import_meta_sprite Meta sprites
+ *
+ * Meta sprites show images bigger or with a more complex shape than a hardware sprite
+ * by covering their opaque 8x8 tiles with one or more hardware sprites, which are moved as a unit.
+ *
+ * The sprites which cover the image are chosen to reduce the pixels drawn per scanline:
+ * each sprite costs its area in tiles plus a fixed cost per sprite, to avoid using too many small sprites.
+ *
+ * An example of the `*.json` files required for meta sprites is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "meta_sprite"
+ * }
+ * @endcode
+ *
+ * The fields for meta sprites are the following:
+ * * `"type"`: must be `"meta_sprite"` for meta sprites.
+ * * `"sprite_cost"`: optional field which specifies the cost in tiles of each hardware sprite when choosing them.
+ * Higher values give less sprites, and lower values give less drawn pixels. By default it is 2.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::meta_sprite_item should have been generated in the `build` folder.
+ *
+ * For example, from two files named `boss.bmp` and `boss.json`,
+ * a header file named `bn_meta_sprite_items_boss.h` is generated in the `build` folder.
+ *
+ * You can use this header to create a bn::meta_sprite:
+ *
+ * @code{.cpp}
+ * #include "bn_meta_sprite.h"
+ * #include "bn_meta_sprite_items_boss.h"
+ *
+ * bn::meta_sprite<16> boss(bn::meta_sprite_items::boss);
+ * boss.set_position(32, -16);
+ * @endcode
+ *
+ *
+ * @subsection import_video Videos
+ *
+ * Videos are stored as a dictionary of tiles and the changes of each frame, and they are played
+ * with bn::video_player.
+ *
+ * The frames of the video must be placed one below the other in the same image.
+ *
+ * An example of the `*.json` files required for videos is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "video",
+ *     "height": 160,
+ *     "frame_duration": 2
+ * }
+ * @endcode
+ *
+ * The fields for videos are the following:
+ * * `"type"`: must be `"video"` for videos.
+ * * `"height"`: height of each frame in pixels. It must be a multiple of 8 and less or equal than 256.
+ * The width of the frames is the width of the image, which must be less or equal than 256 too.
+ * * `"frame_duration"`: optional field which specifies the number of game frames each video frame is shown.
+ * By default it is 1.
+ * * `"bpp_mode"`: optional field which specifies the bits per pixel of the tiles:
+ *   * `"bpp_8"`: up to 256 colors.
+ *   * `"bpp_4"`: up to 16 colors.
+ * By default it is `"bpp_4"` if the image has 16 colors or less, and `"bpp_8"` otherwise.
+ * * `"max_tiles"`: optional field which specifies the maximum number of tiles of the dictionary.
+ * The tiles of two consecutive frames must fit in it. By default it is 1024 for 4BPP videos and 512 for 8BPP videos.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::video_item should have been generated in the `build` folder.
+ *
+ * For example, from two files named `intro.bmp` and `intro.json`,
+ * a header file named `bn_video_items_intro.h` is generated in the `build` folder.
+ *
+ * You can use this header to play the video with bn::video_player:
+ *
+ * @code{.cpp}
+ * #include "bn_video_player.h"
+ * #include "bn_video_items_intro.h"
+ *
+ * bn::video_player video_player(bn::video_items::intro);
+ *
+ * while(! video_player.done())
+ * {
+ *     video_player.update();
+ *     bn::core::update();
+ * }
+ * @endcode
+ *
+ *
+ * @subsection import_asset_registry Asset registry
+ *
+ * Besides a header file for each image, a header file named `bn_asset_registry_items.h` is generated
+ * in the `build` folder.
+ *
+ * It contains a table in ROM for each image type, sorted by the hash of the image names,
+ * so items can be found by name at runtime with bn::asset_registry::find
+ * (for example, when the names of the items are read from level data):
+ *
+ * @code{.cpp}
+ * #include "bn_asset_registry_items.h"
+ *
+ * if(const bn::sprite_item* sprite_item = bn::asset_registry::find<bn::sprite_item>("image"))
+ * {
+ *     bn::sprite_ptr sprite = sprite_item->create_sprite(0, 0);
+ * }
+ * @endcode
+ *
+ * Since `bn_asset_registry_items.h` includes the header files of all images,
+ * it should be included only where items are looked up by name.
+ *
+ *
  * @section import_audio Audio
  *
  * By default audio files go into the `audio` folder of your project.
@@ -1314,6 +1648,46 @@
  *
  * bn::sound_items::sfx.play();
  * @endcode
+ *
+ *
+ * @subsection import_dmg_sound DMG sound effects
+ *
+ * Sequenced sound effects for the DMG sound channels are JSON files (files with `*.json` extension)
+ * stored in the audio folders. For example:
+ *
+ * @code{.json}
+ * {
+ *     "channel": "square_1",
+ *     "steps": [
+ *         { "frames": 3, "frequency": 880, "duty": 1, "sweep_shift": 2, "sweep_step_time": 1 },
+ *         { "frames": 5, "frequency": 1760, "volume": 8, "envelope_step_time": 1 }
+ *     ]
+ * }
+ * @endcode
+ *
+ * The `channel` field specifies the DMG sound channel of the sound effect:
+ * `square_1`, `square_2`, `wave` or `noise`.
+ *
+ * Each step is kept during its `frames` field. Besides, steps have these fields:
+ * * Square wave channels: `frequency` (in Hz), `volume` (0-15), `duty` (0-3),
+ * `envelope_step_time` (0-7), `envelope_increase` and `restart`.
+ * `square_1` steps also have `sweep_shift` (0-7), `sweep_step_time` (0-7) and `sweep_decrease`.
+ * * Wave channel: `frequency` (in Hz), `volume` (0-4) and `restart`.
+ * The `wave_pattern` field of the file specifies its 32 4-bit samples.
+ * * Noise channel: `divider` (0-7), `shift` (0-13), `seven_steps`, `volume` (0-15),
+ * `envelope_step_time` (0-7), `envelope_increase` and `restart`.
+ *
+ * See bn::dmg_sound_step for more information about these fields.
+ *
+ * If the conversion process has finished successfully,
+ * a bn::dmg_sound_item object under the `bn::dmg_sound_items` namespace
+ * should have been generated in the `build` folder for each DMG sound file:
+ *
+ * @code{.cpp}
+ * #include "bn_dmg_sound_items_blip.h"
+ *
+ * bn::dmg_sound_items::blip.play();
+ * @endcode
  */
 
 
@@ -1788,6 +2162,167 @@
  * * bn::string and bn::string_view compatibility improved.
  * * bn::string construction, assignment and append optimized.
  * * Slot index added to palettes manager status log.
+ * * Sprites OAM commit split in multiple chunks to reduce V-Blank time when only far apart sprites are updated.
+ * * Sprites attached to a camera can be grouped in coarse world cells to reduce camera update time (see BN_CFG_SPRITES_CAMERA_CELLS_ENABLED).
+ * * bn::sprite_ptr::create_batch added to create several sprites with the same bn::sprite_builder at once.
+ * * Sprites hot fields can be stored in a packed array in IWRAM with `BN_CFG_SPRITES_SOA`, so on screen checks are a linear sweep over it.
+ * * Sprites can be sorted in fixed buckets per sort key with `BN_CFG_SPRITES_BUCKET_SORT_ENABLED`, removing the sort layers limit.
+ * * Sprite tiles VRAM uploads per frame can be limited with `BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES`.
+ * * `bn::sprite_tiles::commit_queue_size` and `bn::sprite_tiles::deferred_commits_count` added.
+ * * Compressed sprite tiles can be decompressed before VBlank with `BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES`.
+ * * Sprite tiles allocation policy can be specified with `BN_CFG_SPRITE_TILES_ALLOCATION_POLICY`.
+ * * `bn::sprite_tiles::largest_free_block_tiles_count` and `bn::sprite_tiles::fragmentation_ratio` added.
+ * * `bn::sprite_tiles::defragment` added.
+ * * Unused sprite tiles can be kept in VRAM until it is needed with `BN_CFG_SPRITE_TILES_CACHE_ENABLED`.
+ * * `bn::sprite_tiles::cache_hits_count`, `bn::sprite_tiles::cache_misses_count` and `bn::sprite_tiles::reset_cache_counters` added.
+ * * Sprite affine mats can be shared among all sprites with equal attributes with bn::sprite_affine_mat_ptr::create_shared and `BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED`.
+ * * bn::affine_mat_attributes_lut added.
+ * * Big map rows of regular BGs can be copied to VRAM before V-Blank with `BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS`.
+ * * Big maps with <code>chunked</code> map compression added. See <code>BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE</code> to learn how to enable them.
+ * * Regular BGs tiles report added (see <code>tiles_report</code> field in the import guide).
+ * * BG blocks allocation optimized.
+ * * <code>bn::bg_blocks::begin_batch</code> and <code>bn::bg_blocks::end_batch</code> added to spread background tiles and maps uploads over multiple frames.
+ * * <code>bn::regular_bg_item::prefetch</code> and <code>bn::affine_bg_item::prefetch</code> added to upload backgrounds over multiple frames before creating them.
+ * * Sprites palette groups added (see <code>palette_group</code> field in the import guide).
+ * * Brightness, contrast and intensity palette effects optimized.
+ * * H-Blank effects which write to adjacent 16-bit registers are composited in a single 32-bit stream (see `BN_CFG_HBES_MAX_COMPOSITES`).
+ * * H-Blank effects skip the hardware entries rebuild when their new output values are the same as the previous ones.
+ * * Medium priority HDMA added (see bn::hdma::medium_priority_start), so up to three HDMA streams can be active at the same time.
+ * * Overlapping HDMA destinations are reported when a HDMA stream is started.
+ * * bn::affine_bg_perspective added: it generates the per-scanline affine registers values of a perspective (mode 7) floor.
+ * * bn::polygon_rasterizer added: it rasterizes filled polygons into one horizontal span per screen line, ready to be committed with HDMA or H-Blank effects.
+ * * bn::radix_sort added: it sorts 32-bit values by their highest bits in linear time with IWRAM code.
+ * * `bn::make_reciprocal_lut` and `bn::lut_divide` added.
+ * * IWRAM batch math functions added: `bn::transform_points`, `bn::add_scaled`, `bn::lerp` and `bn::dot`.
+ * * `bn::particle_system` added.
+ * * `bn::sprite_text_cache` added to reuse the sprite tiles of texts generated by `bn::sprite_text_generator`.
+ * * `bn::sprite_text_generator::update_digits` added.
+ * * `bn::bg_text_generator` added.
+ * * `bn::regular_bg_map_ptr::reload_cells_ref` can upload only the specified map rows.
+ * * bn::core::set_max_adaptive_skip_frames added.
+ * * bn::core::post_idle_task added.
+ * * bn::task coroutines added.
+ * * Nested profiler code blocks supported.
+ * * bn::profiler_overlay added.
+ * * bn::profiler::log_frames added.
+ * * bn::core::last_vblank_stats added.
+ * * bn::memory::copy with compile-time elements count added.
+ * * bn::memory::ewram_realloc grows and shrinks in-place when possible.
+ * * Small EWRAM allocations can be grouped in size-class slab pages with `BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE`.
+ * * `bn::arena` bump allocator and `bn::arena_vector` added.
+ * * IWRAM overlays support added: code and data can be placed in them with `BN_CODE_IWRAM_OVERLAY` and `BN_DATA_IWRAM_OVERLAY`, and loaded with `bn::iwram_overlay::load`.
+ * * `bn::unordered_map` and `bn::unordered_set` use Robin Hood hashing with backward shift deletion.
+ * * `bn::flat_map` and `bn::flat_set` containers added.
+ * * `bn::spsc_ring` wait-free single producer single consumer ring buffer added.
+ * * `bn::bitmap_pool` added: it finds free slots with count leading zeros and iterates live elements in index order.
+ * * bn::inplace_function added: a callable wrapper which never allocates memory.
+ * * bn::ibitset::find_first, bn::ibitset::find_next and bn::ibitset::set_bits added.
+ * * bn::link::send(const span<const uint16_t>&) and bn::link::receive_packet added: they allow to send and receive multi-word packets.
+ * * bn::link::receive doesn't block the link connection anymore.
+ * * bn::link_lockstep added: it provides deterministic lockstep input exchange through the link cable.
+ * * bn::sram_writer added: it writes only the changed bytes to SRAM, spreading writes across multiple frames.
+ * * bn::crc32 added.
+ * * bn::save_store added: it stores checksummed records in two SRAM slots, so they survive power loss while saving.
+ * * Game Pak flash and EEPROM support added (bn::flash, bn::flash_writer and bn::eeprom).
+ * * Binary keypad logger added (BN_CFG_KEYPAD_LOG_BINARY): its run-length encoded keypad states can be replayed with bn::core::init(const span<const uint16_t>&).
+ * * Replay benchmark mode added (BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED): it logs CPU and V-Blank usage statistics when keypad replays end.
+ * * Audio mixing rate and channel counts can be changed at runtime with bn::audio::set_mixing_rate and bn::audio::set_max_channels, and the audio mixer cost is reported by the profiler.
+ * * Audio commands are merged when possible, and sound effects with the lowest priority are discarded when the audio commands queue is full.
+ * * IMA ADPCM streams can be played from ROM with bn::pcm_stream if BN_CFG_PCM_STREAM_ENABLED is true.
+ * * Moving a camera only updates the sprites, backgrounds and rect windows attached to it.
+ * * camera velocity and acceleration hints (bn::camera_ptr::set_velocity and bn::camera_ptr::set_acceleration) can be used to predict the camera position with sub-pixel precision (bn::camera_ptr::predicted_position).
+ * * sprites multiplexer (BN_CFG_SPRITES_MULTIPLEXER_ENABLED) allows to show more than 128 sprites by rewriting the last hardware sprite handles with HDMA in each H-Blank.
+ * * sprites scanlines analysis (BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED) estimates the OBJ rendering cycles of each scanline, reports the worst one (bn::sprites::worst_scanline_cycles) and can flicker the sprites of overloaded scanlines (bn::sprites::set_scanlines_flicker_enabled).
+ * * bn::regular_bg_map_ptr::set_cell and bn::regular_bg_map_ptr::reload_cells_ref with a rectangle upload only the modified map cells to VRAM.
+ * * bn::regular_bg_tile_animation added: it replaces only a range of the tiles of a regular_bg_tiles_ptr for animated water or lava tiles.
+ * * Rotated or scaled big affine BGs stream the bounding box of their visible area.
+ * * bn::bitmap_bg added: a double buffered mode 4 framebuffer with dirty rect tracking, shown if BN_CFG_BGS_BITMAP_ENABLED is true.
+ * * bn::tile_canvas added: it draws pixels into regular BG tiles and uploads only the modified ones.
+ * * `bn::window_shape` added to rasterize circles, ellipses and convex polygons into rect window H-Blank boundaries.
+ * * `bn::collision_grid` added: a uniform grid collision broadphase with rectangle, segment and pair queries.
+ * * `bn::tile_collision_map` added: swept AABB and raycast queries against packed collision maps generated with the new `tile_collision_map` graphics type.
+ * * `bn::action_group` added to store actions of the same type contiguously and update them in one pass.
+ * * Easing LUTs (`bn::easing_lut` and `bn::ease`) and `bn::timeline` keyframe tracks added.
+ * * bn::format and bn::format_ref parse format strings at compile time (see bn::format_string).
+ * * Integer to string conversion without posprintf nor divisions for values in the 32-bit range.
+ * * bn::asset_registry added: it finds asset items by the hash of their name with a binary search on tables in ROM generated by the assets conversion tools.
+ * * bn::rom_stream added: it reads Game Pak ROM data in sequential bursts.
+ * * Game Pak wait states extended probe added (see BN_CFG_GAME_PAK_WAIT_STATE_PROBE_ENABLED and BN_CFG_GAME_PAK_WAIT_STATE_PROBE_SRAM_OFFSET).
+ * * LZ4 compression type (`"lz4"` in the assets JSON files), decompressed by software in IWRAM faster than LZ77.
+ * * Huffman and LZ77 + Huffman compression types (`"huffman"` and `"lz77_huffman"` in the assets JSON files). The graphics tool reports the compression ratio and the estimated decompression cost of each compressed asset.
+ * * Sprite tiles deltas (see `tiles_deltas` field in the import guide and bn::sprite_tiles_delta_item), so sequential animations upload to VRAM only the tiles words which change.
+ * * `bn::video_player` added: plays videos generated with the new `video` graphics type, streaming a tiles dictionary and double buffered map cells with a bytes budget per update.
+ * * Assets tool rebuilds assets when the content of their files or of the tool changes, instead of checking modification times.
+ * * Assets tool processes items one by one in its pool of processes, so slow items don't delay other ones.
+ * * Sprites repeated graphics reduction (see `repeated_graphics_reduction` field in the import guide and bn::sprite_tiles_item::graphics_indexes_ref), so repeated sprite images are stored and uploaded to VRAM once.
+ * * `bn::meta_sprite` added: moves as a unit the hardware sprites which cover an image generated with the new `meta_sprite` graphics type.
+ * * bn::sprite_ptr::set_tiles_offset and bn::sprite_sheet_animate_action added: sprites can be animated changing only their tile index in a tile sheet already in VRAM.
+ * * bn::tile_canvas::draw_textured_triangle and bn::tile_canvas::draw_textured_hline added: textured polygons can be drawn by software with an IWRAM span filler.
+ * * bn::fixed_t::wide_multiplication, bn::fixed_t::saturating_addition and bn::fixed_t::saturating_subtraction added.
+ * * Brightness palette effect processes two colors per word.
+ * * Only modified palette banks are committed to the GBA.
+ * * Palette cycles (`bn::palette_cycle`) rotate ranges of colors of a palette when it is committed to the GBA.
+ * * `BN_LOG_DEFERRED` stores log parameters without formatting them, so they can be printed later with `BN_LOG_DEFERRED_FLUSH`.
+ * * `BN_LOG_LEVEL` logs messages of a given level and subsystem. Disabled levels are not compiled, and subsystems can be enabled or disabled at runtime.
+ * * `BN_BASIC_ASSERT` and `BN_FULL_ASSERT` assert tiers added: basic asserts stay enabled when `BN_CFG_ASSERT_ENABLED` is `false` and full asserts can be disabled with `BN_CFG_ASSERT_FULL_ENABLED`.
+ * * `bn::core::wait_for_keypad` halts the CPU on static screens until a keypad key is pressed, without updating Butano's subsystems.
+ * * V-Blank commit sequence skipped on static frames.
+ * * `bn::scoped_timer` and `bn::timers::ticks_to_microseconds` added.
+ * * `bn::random::get_unbiased_int`, `bn::random::fill` and `bn::random::split` added.
+ * * `bn::interpolated_lut_sin`, `bn::interpolated_lut_cos`, `bn::lut_atan2` and `bn::degrees_lut_atan2` added.
+ * * Profiler code block ids hashed at compile time.
+ * * `bn::split_screen` added to show a regular BG with its own position, camera and attributes in each horizontal band of the screen.
+ * * `bn::node` added to build transform hierarchies of sprites and regular BGs propagated in one pass by `bn::core::update`.
+ * * `bn::entity_table` added to store entity components in contiguous arrays, with built-in sprite and collision grid systems.
+ * * scene_manager added to keep scene resources resident in VRAM, with build time budget checks.
+ * * bn::grid_pathfinder added: resumable A*, jump point search and flow fields over a grid of movement costs.
+ * * Bulk map cell operations added: regular_bg_map_ptr and affine_bg_map_ptr fill_rect, copy_rect and blit_with_offset.
+ * * BN_CFG_SPRITES_EARLY_COMMIT_ENABLED added: sprites are copied to OAM with DMA at the start of the V-Blank handler.
+ * * BN_CFG_CORE_NESTED_IRQS_ENABLED added: H-Blank and link IRQs can interrupt the V-Blank handler commit steps.
+ * * `bn::sprite_reuse_hbes` added to override the attributes of a sprite in horizontal bands of the screen, generating and caching the required H-Blank effects.
+ * * bn::small_sort added, and IWRAM bn::small_sort, bn::nth_element and bn::partial_sort overloads for integers added.
+ * * bn::memory::max_used_stack_iwram, bn::memory::used_overlays_iwram, bn::memory::unused_iwram and bn::memory::log_iwram_usage added to track the IWRAM stack peak.
+ * * Real-time clock support added (see bn::rtc): the current date and time are read asynchronously once per second and advanced with a hardware timer in between.
+ * * Multiboot support added: images can be sent with bn::link_multiboot::send, and the `multiboot` make target builds LZ77 compressed multiboot images which decompress themselves on boot.
+ * * Wireless adapter link transport added (see `BN_CFG_LINK_TRANSPORT`).
+ * * DMG sound channels support added (see `bn::dmg_sound`).
+ * * Maxmod mixing and wave buffers placement can be specified with `BN_CFG_AUDIO_MIXING_BUFFER_IWRAM` and `BN_CFG_AUDIO_WAVE_BUFFER_IWRAM`.
+ * * Music events (song message effects) are available through `bn::music::events`.
+ * * Identical sound effects played in a short time span can be collapsed into one channel with `BN_CFG_AUDIO_SOUND_COLLAPSE_FRAMES`.
+ * * `bn::sprite_text_generator::wrap` splits text in lines in a single pass.
+ * * UTF-8 decoding and sprite text printable ASCII runs are faster.
+ * * `bn::is_trivially_relocatable` trait added: `bn::ivector` insert and erase shift trivially relocatable elements (like `bn::sprite_ptr`) with one memmove call.
+ * * Display, mosaic, blending and window registers are written only when their value changes.
+ * * `bn::vertical_gradient` and `bn::make_vertical_gradient` generate H-Blank effect tables from keyframes.
+ * * Register values H-Blank effects read tables stored in ROM without copying them.
+ * * Sprites manager, palettes banks and H-Blank effects data can be placed in IWRAM with `BN_CFG_SPRITES_DATA_IWRAM`, `BN_CFG_PALETTES_DATA_IWRAM` and `BN_CFG_HBES_DATA_IWRAM`.
+ * * `bn::uint_least_for` added to select the smallest unsigned integer type which can store a given maximum value.
+ * * Sprite tiles and BG blocks managers list links and free lists use the smallest fitting index type.
+ * * `bn::sprite_handle` added: a non-owning, trivially copyable sprite reference which doesn't modify usages counts.
+ * * `bn::activation_region` added to activate and deactivate objects (and their sprites) depending on their distance to a camera.
+ * * Auto double size mode is decided once per affine matrix update, with hysteresis to avoid toggling it near the threshold.
+ * * `bn::length`, `bn::length_approx`, `bn::normalize` and `bn::normalize_approx` added for `bn::fixed_point` vectors.
+ * * `BN_RASTER_MARK` added to record the screen line and timer ticks of colored marks, optionally showing them as backdrop raster bars.
+ * * bn::sram::write_compressed and bn::sram::read_compressed added.
+ * * bn::sram_compressed_writer added.
+ * * bn::core::init_ticks added.
+ * * @ref BN_CFG_MEMORY_STACK_PAINT_ENABLED added.
+ * * Link connection is initialized when it is used for the first time, to reduce boot time.
+ * * bn::sprite_ptr::set_quarter_rotation added: square sprites can be rotated by multiples of 90 degrees without an affine matrix (see `quarter_rotations` field in the import guide).
+ * * bn::link::stats, bn::link::reset_stats and bn::link_stats added.
+ * * bn::link_clock_sync added.
+ * * bn::pool_ptr and bn::arena_ptr added: pointer sized bn::unique_ptr aliases which return their objects to a bn::ipool or destroy them in a bn::iarena.
+ * * Affine BGs with the same rotation, scale, shear and flip attributes share their affine matrix registers.
+ * * Affine BG map dimensions changes only update the translation of the affine matrix.
+ * * bn::occupancy_overlay added: it shows a map of the used sprite tiles, BG blocks, sprite handles, sprite affine matrices and palettes on top of the game.
+ * * bn::hdma::publish, bn::hdma::displayed_source and bn::hdma_triple_buffer added: published HDMA sources are taken at the next V-Blank, so tables can be produced as late as possible.
+ * * `"bpp_4_auto_lossy"` regular BG BPP mode added: it quantizes 8BPP images into up to 16 4BPP palette banks, replacing the least used colors if needed and reporting the changed pixels.
+ * * bn::resource_budget added: it checks at compile time if sprite, regular BG and affine BG items fit in VRAM and in the palette banks at the same time.
+ * * BGs commit only the registers that have changed, skipping the ones written by H-Blank effects.
+ * * bn::sprites::set_y_sort_enabled added: it keeps the sprites of a BG priority and z order sorted by their vertical position.
+ * * bn::core logic-only fast-forward mode added for headless simulations.
+ * * EWRAM allocation tracking added (see BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED).
+ * * bn::vram_queue added: V-Blank budgeted VRAM, palette RAM and OAM writes (see BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES).
  *
  *
  * @section changelog_8_9_0 8.9.0
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_EASING_H
+#define BN_EASING_H
+
+/**
+ * @file
+ * bn::easing_type and easing LUT header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_fixed.h"
+#include "bn_array_fwd.h"
+
+namespace bn
+{
+
+/**
+ * @brief Specifies the available easing functions.
+ *
+ * @ingroup math
+ */
+enum class easing_type : uint8_t
+{
+    LINEAR, //!< Constant speed.
+    QUAD_IN, //!< Quadratic acceleration from zero velocity.
+    QUAD_OUT, //!< Quadratic deceleration to zero velocity.
+    QUAD_IN_OUT, //!< Quadratic acceleration until halfway, then deceleration.
+    CUBIC_IN, //!< Cubic acceleration from zero velocity.
+    CUBIC_OUT, //!< Cubic deceleration to zero velocity.
+    CUBIC_IN_OUT, //!< Cubic acceleration until halfway, then deceleration.
+    BACK_IN, //!< Goes slightly backwards before accelerating.
+    BACK_OUT, //!< Overshoots the end before settling.
+    BACK_IN_OUT, //!< Goes slightly backwards at the start and overshoots the end.
+    ELASTIC_IN, //!< Exponentially growing oscillation.
+    ELASTIC_OUT, //!< Exponentially decaying oscillation around the end.
+    ELASTIC_IN_OUT //!< Growing oscillation until halfway, then decaying oscillation.
+};
+
+/**
+ * @brief Number of available easing functions.
+ *
+ * @ingroup math
+ */
+constexpr int easing_types_count = int(easing_type::ELASTIC_IN_OUT) + 1;
+
+/**
+ * @brief Size of the LUT of each easing function.
+ *
+ * @ingroup math
+ */
+constexpr int easing_lut_size = 257;
+
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn
+{
+    constexpr double easing_pi = 3.1415926535897932384626433832795;
+
+    [[nodiscard]] constexpr double easing_sin(double x)
+    {
+        constexpr double two_pi = 2 * easing_pi;
+
+        while(x > easing_pi)
+        {
+            x -= two_pi;
+        }
+
+        while(x < -easing_pi)
+        {
+            x += two_pi;
+        }
+
+        double term = x;
+        double result = x;
+
+        for(int index = 1; index < 12; ++index)
+        {
+            term *= -(x * x) / ((2 * index) * (2 * index + 1));
+            result += term;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] constexpr double easing_exp2(double x)
+    {
+        double result = 1;
+
+        while(x >= 1)
+        {
+            result *= 2;
+            x -= 1;
+        }
+
+        while(x < 0)
+        {
+            result /= 2;
+            x += 1;
+        }
+
+        // 2^x = e^(x * ln(2)) for x in [0, 1):
+        double y = x * 0.69314718055994530942;
+        double term = 1;
+        double fraction = 1;
+
+        for(int index = 1; index < 16; ++index)
+        {
+            term *= y / index;
+            fraction += term;
+        }
+
+        return result * fraction;
+    }
+
+    [[nodiscard]] constexpr double easing_value(bn::easing_type type, double t)
+    {
+        constexpr double back_c1 = 1.70158;
+        constexpr double back_c2 = back_c1 * 1.525;
+        constexpr double back_c3 = back_c1 + 1;
+        constexpr double elastic_c4 = (2 * easing_pi) / 3;
+        constexpr double elastic_c5 = (2 * easing_pi) / 4.5;
+
+        switch(type)
+        {
+
+        case bn::easing_type::LINEAR:
+            return t;
+
+        case bn::easing_type::QUAD_IN:
+            return t * t;
+
+        case bn::easing_type::QUAD_OUT:
+            return 1 - ((1 - t) * (1 - t));
+
+        case bn::easing_type::QUAD_IN_OUT:
+            return t < 0.5 ? 2 * t * t : 1 - (((2 - 2 * t) * (2 - 2 * t)) / 2);
+
+        case bn::easing_type::CUBIC_IN:
+            return t * t * t;
+
+        case bn::easing_type::CUBIC_OUT:
+            return 1 - ((1 - t) * (1 - t) * (1 - t));
+
+        case bn::easing_type::CUBIC_IN_OUT:
+            return t < 0.5 ? 4 * t * t * t : 1 - (((2 - 2 * t) * (2 - 2 * t) * (2 - 2 * t)) / 2);
+
+        case bn::easing_type::BACK_IN:
+            return (back_c3 * t * t * t) - (back_c1 * t * t);
+
+        case bn::easing_type::BACK_OUT:
+            return 1 + (back_c3 * (t - 1) * (t - 1) * (t - 1)) + (back_c1 * (t - 1) * (t - 1));
+
+        case bn::easing_type::BACK_IN_OUT:
+            if(t < 0.5)
+            {
+                return ((2 * t) * (2 * t) * (((back_c2 + 1) * 2 * t) - back_c2)) / 2;
+            }
+
+            return (((2 * t - 2) * (2 * t - 2) * (((back_c2 + 1) * (2 * t - 2)) + back_c2)) + 2) / 2;
+
+        case bn::easing_type::ELASTIC_IN:
+            if(t <= 0 || t >= 1)
+            {
+                return t;
+            }
+
+            return -easing_exp2(10 * t - 10) * easing_sin((10 * t - 10.75) * elastic_c4);
+
+        case bn::easing_type::ELASTIC_OUT:
+            if(t <= 0 || t >= 1)
+            {
+                return t;
+            }
+
+            return (easing_exp2(-10 * t) * easing_sin((10 * t - 0.75) * elastic_c4)) + 1;
+
+        case bn::easing_type::ELASTIC_IN_OUT:
+            if(t <= 0 || t >= 1)
+            {
+                return t;
+            }
+
+            if(t < 0.5)
+            {
+                return -(easing_exp2(20 * t - 10) * easing_sin((20 * t - 11.125) * elastic_c5)) / 2;
+            }
+
+            return ((easing_exp2(-20 * t + 10) * easing_sin((20 * t - 11.125) * elastic_c5)) / 2) + 1;
+
+        default:
+            return t;
+        }
+    }
+}
+
+/// @endcond
+
+namespace bn
+{
+
+/**
+ * @brief Calculates the value to store in the easing LUT of the given easing function for the given index.
+ * @param type Easing function.
+ * @param lut_index LUT index in the range [0, easing_lut_size).
+ * @return Eased value in 4.12 format (4096 = 1).
+ *
+ * @ingroup math
+ */
+[[nodiscard]] constexpr int calculate_easing_lut_value(easing_type type, int lut_index)
+{
+    double t = double(lut_index) / (easing_lut_size - 1);
+    double value = _bn::easing_value(type, t) * fixed::scale();
+    return int(value >= 0 ? value + 0.5 : value - 0.5);
+}
+
+/**
+ * @brief Easing LUTs of 16bit values in 4.12 format, one after another in the order of bn::easing_type.
+ *
+ * @ingroup math
+ */
+extern const array<int16_t, easing_lut_size * easing_types_count>& easing_lut;
+
+/**
+ * @brief Returns the value of the given easing function using a LUT, with linear interpolation between entries.
+ * @param type Easing function.
+ * @param progress Progress in the range [0, 1].
+ * @return Eased progress: 0 when progress is 0, and 1 when it is 1.
+ * Some easing functions return values out of the range [0, 1] in between.
+ *
+ * @ingroup math
+ */
+[[nodiscard]] fixed ease(easing_type type, fixed progress);
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_EEPROM_H
+#define BN_EEPROM_H
+
+/**
+ * @file
+ * bn::eeprom header file.
+ *
+ * @ingroup eeprom
+ */
+
+#include "bn_assert.h"
+#include "../hw/include/bn_hw_eeprom_constants.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::eeprom
+{
+    [[nodiscard]] bool unsafe_write(const void* source, int size, int offset);
+
+    void unsafe_read(void* destination, int size, int offset);
+}
+
+/// @endcond
+
+
+/**
+ * @brief EEPROM related functions.
+ *
+ * Only changed blocks of 8 bytes are written, but each block takes several milliseconds to be written
+ * and interrupts are disabled meanwhile, so big writes can make the game skip frames.
+ *
+ * EEPROM size is specified with BN_CFG_EEPROM_SIZE.
+ *
+ * @ingroup eeprom
+ */
+namespace bn::eeprom
+{
+    /**
+     * @brief Returns the total EEPROM size in bytes.
+     */
+    [[nodiscard]] constexpr int size()
+    {
+        return hw::eeprom::size();
+    }
+
+    /**
+     * @brief Copies the given value into EEPROM.
+     * @param source Value to copy.
+     * @return `true` if the value has been written successfully, otherwise `false`.
+     */
+    template<typename Type>
+    bool write(const Type& source)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+
+        return _bn::eeprom::unsafe_write(&source, int(sizeof(Type)), 0);
+    }
+
+    /**
+     * @brief Copies the given value into EEPROM.
+     * @param source Value to copy.
+     * @param offset The given value is copied into EEPROM start address + this offset.
+     * @return `true` if the value has been written successfully, otherwise `false`.
+     */
+    template<typename Type>
+    bool write_offset(const Type& source, int offset)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+        BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+        BN_ASSERT(int(sizeof(Type)) + offset <= size(),
+                   "Size and offset are too high: ", sizeof(Type), " - ", offset);
+
+        return _bn::eeprom::unsafe_write(&source, int(sizeof(Type)), offset);
+    }
+
+    /**
+     * @brief Copies EEPROM data into the given value.
+     * @param destination EEPROM data is copied into this value.
+     */
+    template<typename Type>
+    void read(Type& destination)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+
+        _bn::eeprom::unsafe_read(&destination, int(sizeof(Type)), 0);
+    }
+
+    /**
+     * @brief Copies EEPROM data into the given value.
+     * @param destination EEPROM data is copied into this value.
+     * @param offset Copying starts from EEPROM start address + this offset.
+     */
+    template<typename Type>
+    void read_offset(Type& destination, int offset)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+        BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+        BN_ASSERT(int(sizeof(Type)) + offset <= size(),
+                   "Size and offset are too high: ", sizeof(Type), " - ", offset);
+
+        _bn::eeprom::unsafe_read(&destination, int(sizeof(Type)), offset);
+    }
+}
+
+#endif
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ENTITY_TABLE_H
+#define BN_ENTITY_TABLE_H
+
+/**
+ * @file
+ * bn::entity_table header file.
+ *
+ * @ingroup container
+ */
+
+#include <new>
+#include "bn_span.h"
+#include "bn_utility.h"
+#include "bn_sprite_ptr.h"
+#include "bn_type_traits.h"
+#include "bn_collision_grid.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn
+{
+    template<typename Component, int MaxSize>
+    class entity_table_column
+    {
+
+    public:
+        [[nodiscard]] const Component* _column_data() const
+        {
+            return reinterpret_cast<const Component*>(_components_buffer);
+        }
+
+        [[nodiscard]] Component* _column_data()
+        {
+            return reinterpret_cast<Component*>(_components_buffer);
+        }
+
+    private:
+        alignas(Component) char _components_buffer[sizeof(Component) * MaxSize];
+    };
+}
+
+/// @endcond
+
+namespace bn
+{
+
+/**
+ * @brief Archetype table which stores the components of a set of entities in contiguous arrays,
+ * one per component type.
+ *
+ * Systems are loops which iterate linearly over the component arrays (see for_each),
+ * so they are much more cache and branch friendly than updating scattered game objects one by one.
+ *
+ * Entities are identified by an ID returned when they are added, which stays valid until they are removed.
+ * When an entity is removed, the last one is moved to its slot to keep the component arrays contiguous.
+ *
+ * If the table is stored in a global variable, it is placed in IWRAM
+ * (or in EWRAM if the variable is declared with BN_DATA_EWRAM).
+ *
+ * @tparam MaxSize Maximum number of entities.
+ * @tparam Components Component types of each entity (they can't be repeated).
+ *
+ * @ingroup container
+ */
+template<int MaxSize, typename... Components>
+class entity_table : private _bn::entity_table_column<Components, MaxSize>...
+{
+    static_assert(MaxSize > 0 && MaxSize <= 32767);
+    static_assert(sizeof...(Components) > 0);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    entity_table()
+    {
+        _clear();
+    }
+
+    entity_table(const entity_table& other) = delete;
+
+    entity_table& operator=(const entity_table& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~entity_table()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Indicates if entities have a component of the given type or not.
+     */
+    template<typename Component>
+    [[nodiscard]] constexpr static bool has_component()
+    {
+        return (is_same_v<Component, Components> || ...);
+    }
+
+    /**
+     * @brief Returns the number of stored entities.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum possible number of stored entities.
+     */
+    [[nodiscard]] constexpr static int max_size()
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Indicates if it doesn't store any entity.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if it can't store any more entities.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == MaxSize;
+    }
+
+    /**
+     * @brief Indicates if the given ID references a stored entity or not.
+     */
+    [[nodiscard]] bool contains_id(int id) const
+    {
+        return id >= 0 && id < MaxSize && _indexes[id] >= 0;
+    }
+
+    /**
+     * @brief Returns the ID of the entity stored in the given position of the component arrays.
+     */
+    [[nodiscard]] int id(int index) const
+    {
+        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+
+        return _ids[index];
+    }
+
+    /**
+     * @brief Returns the position in the component arrays of the entity referenced by the given ID.
+     */
+    [[nodiscard]] int index(int id) const
+    {
+        BN_ASSERT(contains_id(id), "Invalid id: ", id);
+
+        return _indexes[id];
+    }
+
+    /**
+     * @brief Returns the components of the given type of all stored entities.
+     */
+    template<typename Component>
+    [[nodiscard]] span<const Component> components() const
+    {
+        return span<const Component>(_data<Component>(), _size);
+    }
+
+    /**
+     * @brief Returns the components of the given type of all stored entities.
+     */
+    template<typename Component>
+    [[nodiscard]] span<Component> components()
+    {
+        return span<Component>(_data<Component>(), _size);
+    }
+
+    /**
+     * @brief Returns a const reference to the component of the given type
+     * of the entity referenced by the given ID.
+     */
+    template<typename Component>
+    [[nodiscard]] const Component& get(int id) const
+    {
+        return _data<Component>()[index(id)];
+    }
+
+    /**
+     * @brief Returns a reference to the component of the given type of the entity referenced by the given ID.
+     */
+    template<typename Component>
+    [[nodiscard]] Component& get(int id)
+    {
+        return _data<Component>()[index(id)];
+    }
+
+    /**
+     * @brief Adds a new entity.
+     * @param components Components of the new entity.
+     * @return ID of the new entity.
+     */
+    int add(const Components&... components)
+    {
+        BN_BASIC_ASSERT(! full(), "Entity table is full");
+
+        int index = _size;
+        (::new(_data<Components>() + index) Components(components), ...);
+        return _add_index();
+    }
+
+    /**
+     * @brief Adds a new entity.
+     * @param components Components of the new entity.
+     * @return ID of the new entity.
+     */
+    int add(Components&&... components)
+    {
+        BN_BASIC_ASSERT(! full(), "Entity table is full");
+
+        int index = _size;
+        (::new(_data<Components>() + index) Components(move(components)), ...);
+        return _add_index();
+    }
+
+    /**
+     * @brief Removes the entity referenced by the given ID.
+     *
+     * The last stored entity is moved to its position in the component arrays.
+     */
+    void remove(int id)
+    {
+        _remove_index(index(id));
+    }
+
+    /**
+     * @brief Removes all entities.
+     */
+    void clear()
+    {
+        for(int index = 0; index < _size; ++index)
+        {
+            (_data<Components>()[index].~Components(), ...);
+        }
+
+        _clear();
+    }
+
+    /**
+     * @brief Calls the given function for each stored entity, linearly iterating over the component arrays.
+     *
+     * Entities must not be added nor removed from the function (use remove_if to remove them).
+     *
+     * @tparam Selected Component types of the parameters of the function.
+     * If none are specified, it receives all entity components in the order of the table declaration.
+     * @param function Function called with references to the selected components of each entity.
+     */
+    template<typename... Selected, typename Function>
+    void for_each(const Function& function)
+    {
+        if constexpr(sizeof...(Selected) == 0)
+        {
+            for_each<Components...>(function);
+        }
+        else
+        {
+            static_assert((has_component<Selected>() && ...), "Invalid component");
+
+            for(int index = 0, limit = _size; index < limit; ++index)
+            {
+                function(_data<Selected>()[index]...);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the entities for which the given function returns `true`.
+     * @tparam Selected Component types of the parameters of the function.
+     * If none are specified, it receives all entity components in the order of the table declaration.
+     * @param function Function called with references to the selected components of each entity.
+     * @return Number of removed entities.
+     */
+    template<typename... Selected, typename Function>
+    int remove_if(const Function& function)
+    {
+        if constexpr(sizeof...(Selected) == 0)
+        {
+            return remove_if<Components...>(function);
+        }
+        else
+        {
+            static_assert((has_component<Selected>() && ...), "Invalid component");
+
+            int old_size = _size;
+
+            // Iterated backwards, so the entity moved to a removed slot has already been tested:
+            for(int index = old_size - 1; index >= 0; --index)
+            {
+                if(function(_data<Selected>()[index]...))
+                {
+                    _remove_index(index);
+                }
+            }
+
+            return old_size - _size;
+        }
+    }
+
+private:
+    int16_t _indexes[MaxSize];
+    int16_t _ids[MaxSize];
+    int _size = 0;
+
+    template<typename Component>
+    [[nodiscard]] const Component* _data() const
+    {
+        static_assert(has_component<Component>(), "Invalid component");
+
+        return static_cast<const _bn::entity_table_column<Component, MaxSize>&>(*this)._column_data();
+    }
+
+    template<typename Component>
+    [[nodiscard]] Component* _data()
+    {
+        static_assert(has_component<Component>(), "Invalid component");
+
+        return static_cast<_bn::entity_table_column<Component, MaxSize>&>(*this)._column_data();
+    }
+
+    [[nodiscard]] int _add_index()
+    {
+        // IDs of removed entities are stored after the last stored entity:
+        int index = _size;
+        int id = _ids[index];
+        _indexes[id] = int16_t(index);
+        _size = index + 1;
+        return id;
+    }
+
+    void _remove_index(int index)
+    {
+        int last_index = _size - 1;
+        int id = _ids[index];
+
+        if(index != last_index)
+        {
+            ((_data<Components>()[index] = move(_data<Components>()[last_index])), ...);
+
+            int last_id = _ids[last_index];
+            _ids[index] = int16_t(last_id);
+            _indexes[last_id] = int16_t(index);
+        }
+
+        (_data<Components>()[last_index].~Components(), ...);
+        _ids[last_index] = int16_t(id);
+        _indexes[id] = -1;
+        _size = last_index;
+    }
+
+    void _clear()
+    {
+        for(int index = 0; index < MaxSize; ++index)
+        {
+            _indexes[index] = -1;
+            _ids[index] = int16_t(index);
+        }
+
+        _size = 0;
+    }
+};
+
+
+/**
+ * @brief Built-in entity component which keeps an item of a collision grid
+ * centered in the fixed_point component of its entity.
+ *
+ * @ingroup container
+ */
+class entity_collider
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param grid_id ID of the collision grid item.
+     * @param dimensions Size of the collision grid item.
+     */
+    constexpr entity_collider(int grid_id, const fixed_size& dimensions) :
+        _dimensions(dimensions),
+        _grid_id(grid_id)
+    {
+    }
+
+    /**
+     * @brief Returns the ID of the collision grid item.
+     */
+    [[nodiscard]] constexpr int grid_id() const
+    {
+        return _grid_id;
+    }
+
+    /**
+     * @brief Returns the size of the collision grid item.
+     */
+    [[nodiscard]] constexpr const fixed_size& dimensions() const
+    {
+        return _dimensions;
+    }
+
+    /**
+     * @brief Sets the size of the collision grid item.
+     */
+    constexpr void set_dimensions(const fixed_size& dimensions)
+    {
+        _dimensions = dimensions;
+    }
+
+private:
+    fixed_size _dimensions;
+    int _grid_id;
+};
+
+
+/**
+ * @brief Moves the sprite_ptr component of each entity to its fixed_point component.
+ *
+ * @ingroup container
+ */
+template<int MaxSize, typename... Components>
+void update_entity_sprites(entity_table<MaxSize, Components...>& table)
+{
+    table.template for_each<fixed_point, sprite_ptr>([](const fixed_point& position, sprite_ptr& sprite)
+    {
+        sprite.set_position(position);
+    });
+}
+
+/**
+ * @brief Moves the collision grid item referenced by the entity_collider component of each entity
+ * to its fixed_point component.
+ *
+ * @ingroup container
+ */
+template<int MaxSize, typename... Components>
+void update_entity_colliders(entity_table<MaxSize, Components...>& table, icollision_grid& grid)
+{
+    table.template for_each<fixed_point, entity_collider>(
+                [&grid](const fixed_point& position, const entity_collider& collider)
+    {
+        grid.update(collider.grid_id(), fixed_rect(position, collider.dimensions()));
+    });
+}
+
+}
+
+#endif
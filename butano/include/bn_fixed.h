@@ -281,6 +281,50 @@ public:
         return from_data((_data * other._data) / scale());
     }
 
+    /**
+     * @brief Returns the multiplication of this value by the given fixed point value,
+     * using a 64-bit product of the 32-bit values to avoid overflow.
+     *
+     * It is faster than safe_multiplication (it only needs a single long multiply and a shift),
+     * but the result is rounded towards minus infinity instead of towards zero.
+     */
+    [[nodiscard]] constexpr fixed_t wide_multiplication(fixed_t other) const
+    {
+        return from_data(int((int64_t(_data) * other._data) >> Precision));
+    }
+
+    /**
+     * @brief Returns the addition of this value and the given fixed point value,
+     * clamping the result to the range of fixed_t instead of overflowing.
+     */
+    [[nodiscard]] constexpr fixed_t saturating_addition(fixed_t other) const
+    {
+        int result;
+
+        if(__builtin_add_overflow(_data, other._data, &result))
+        {
+            result = other._data > 0 ? numeric_limits<int>::max() : numeric_limits<int>::min();
+        }
+
+        return from_data(result);
+    }
+
+    /**
+     * @brief Returns the subtraction of the given fixed point value to this value,
+     * clamping the result to the range of fixed_t instead of overflowing.
+     */
+    [[nodiscard]] constexpr fixed_t saturating_subtraction(fixed_t other) const
+    {
+        int result;
+
+        if(__builtin_sub_overflow(_data, other._data, &result))
+        {
+            result = other._data < 0 ? numeric_limits<int>::max() : numeric_limits<int>::min();
+        }
+
+        return from_data(result);
+    }
+
     /**
      * @brief Returns the division of this value by the given integer value.
      */
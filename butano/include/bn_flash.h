@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLASH_H
+#define BN_FLASH_H
+
+/**
+ * @file
+ * bn::flash header file.
+ *
+ * @ingroup flash
+ */
+
+#include "bn_assert.h"
+#include "../hw/include/bn_hw_flash_constants.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::flash
+{
+    [[nodiscard]] bool unsafe_write(const void* source, int size, int offset);
+
+    void unsafe_read(void* destination, int size, int offset);
+}
+
+/// @endcond
+
+
+/**
+ * @brief Flash related functions.
+ *
+ * Only bytes of the sectors which have been changed are erased and programmed, but erasing a sector is slow,
+ * so bn::flash_writer should be used to write big data without blocking the game.
+ *
+ * Flash size is specified with BN_CFG_FLASH_SIZE.
+ *
+ * Atmel flash chips are not supported.
+ *
+ * @ingroup flash
+ */
+namespace bn::flash
+{
+    /**
+     * @brief Returns the total Flash size in bytes.
+     */
+    [[nodiscard]] constexpr int size()
+    {
+        return hw::flash::size();
+    }
+
+    /**
+     * @brief Returns the size in bytes of each flash sector.
+     */
+    [[nodiscard]] constexpr int sector_size()
+    {
+        return hw::flash::sector_size();
+    }
+
+    /**
+     * @brief Copies the given value into Flash.
+     * @param source Value to copy.
+     * @return `true` if the value has been written successfully, otherwise `false`.
+     */
+    template<typename Type>
+    bool write(const Type& source)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+
+        return _bn::flash::unsafe_write(&source, int(sizeof(Type)), 0);
+    }
+
+    /**
+     * @brief Copies the given value into Flash.
+     * @param source Value to copy.
+     * @param offset The given value is copied into Flash start address + this offset.
+     * @return `true` if the value has been written successfully, otherwise `false`.
+     */
+    template<typename Type>
+    bool write_offset(const Type& source, int offset)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+        BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+        BN_ASSERT(int(sizeof(Type)) + offset <= size(),
+                   "Size and offset are too high: ", sizeof(Type), " - ", offset);
+
+        return _bn::flash::unsafe_write(&source, int(sizeof(Type)), offset);
+    }
+
+    /**
+     * @brief Copies Flash data into the given value.
+     * @param destination Flash data is copied into this value.
+     */
+    template<typename Type>
+    void read(Type& destination)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+
+        _bn::flash::unsafe_read(&destination, int(sizeof(Type)), 0);
+    }
+
+    /**
+     * @brief Copies Flash data into the given value.
+     * @param destination Flash data is copied into this value.
+     * @param offset Copying starts from Flash start address + this offset.
+     */
+    template<typename Type>
+    void read_offset(Type& destination, int offset)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) <= size(), "Size is too high");
+        BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+        BN_ASSERT(int(sizeof(Type)) + offset <= size(),
+                   "Size and offset are too high: ", sizeof(Type), " - ", offset);
+
+        _bn::flash::unsafe_read(&destination, int(sizeof(Type)), offset);
+    }
+}
+
+#endif
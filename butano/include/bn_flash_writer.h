@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLASH_WRITER_H
+#define BN_FLASH_WRITER_H
+
+/**
+ * @file
+ * bn::iflash_writer and bn::flash_writer header file.
+ *
+ * @ingroup flash
+ */
+
+#include "bn_flash.h"
+#include "bn_memory.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::flash_writer.
+ *
+ * It keeps a copy of a range of flash sectors in RAM, and it erases and programs the sectors which have been changed
+ * with idle tasks (see core::post_idle_task), so the long sector erase cycles don't block the game.
+ *
+ * If core::clear_idle_tasks is called, pending writes are committed only when update or flush are called.
+ *
+ * Keep in mind that flash must not be written with bn::flash functions until all writers are done.
+ *
+ * @ingroup flash
+ */
+class iflash_writer
+{
+
+public:
+    iflash_writer(const iflash_writer& other) = delete;
+
+    iflash_writer& operator=(const iflash_writer& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * Pending writes are flushed before destroying the writer.
+     */
+    ~iflash_writer();
+
+    /**
+     * @brief Returns the number of managed flash sectors.
+     */
+    [[nodiscard]] int sectors_count() const
+    {
+        return _sectors_count;
+    }
+
+    /**
+     * @brief Returns the flash offset of the first managed sector.
+     */
+    [[nodiscard]] int offset() const
+    {
+        return _first_sector * flash::sector_size();
+    }
+
+    /**
+     * @brief Indicates if all writes have been committed to flash or not.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _state == state_type::IDLE;
+    }
+
+    /**
+     * @brief Processes the next step of the pending writes.
+     *
+     * Each step compares or programs up to BN_CFG_FLASH_WRITER_TASK_BYTES bytes, or checks if a sector has been erased.
+     */
+    void update();
+
+    /**
+     * @brief Commits all pending writes to flash.
+     */
+    void flush();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    iflash_writer(uint8_t* data, int sectors_count, int offset);
+
+    void _write(const void* source, int size);
+
+    /// @endcond
+
+private:
+    enum class state_type : uint8_t
+    {
+        IDLE,
+        COMPARE,
+        ERASE,
+        PROGRAM
+    };
+
+    uint8_t* _data;
+    iflash_writer* _next_writer = nullptr;
+    int _sectors_count;
+    int _first_sector;
+    int _sector_index = 0;
+    int _byte_index = 0;
+    state_type _state = state_type::IDLE;
+    bool _restart = false;
+    bool _queued = false;
+
+    void _next_sector();
+
+    void _enqueue();
+
+    void _dequeue();
+
+    static void _update_queued();
+};
+
+
+/**
+ * @brief Writes the given type to flash asynchronously, erasing and programming only the sectors which
+ * have been changed.
+ *
+ * The bytes of the last sector which are not occupied by the given type are preserved.
+ *
+ * @tparam Type Type of the data to write. It must be trivially copyable.
+ *
+ * @ingroup flash
+ */
+template<typename Type>
+class flash_writer : public iflash_writer
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+    static_assert(int(sizeof(Type)) <= flash::size(), "Size is too high");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset Flash offset of the data. It must be a multiple of flash::sector_size().
+     *
+     * The managed sectors are read from flash.
+     */
+    explicit flash_writer(int offset = 0) :
+        iflash_writer(_data_buffer, _sectors_count, offset)
+    {
+    }
+
+    /**
+     * @brief Returns the last written value, which may not have been committed to flash yet.
+     */
+    [[nodiscard]] Type value() const
+    {
+        Type result;
+        memory::copy(_data_buffer[0], int(sizeof(Type)), *reinterpret_cast<uint8_t*>(&result));
+        return result;
+    }
+
+    /**
+     * @brief Queues the given value to be written to flash.
+     *
+     * It is copied into RAM immediately, and the changed sectors are written to flash by idle tasks.
+     */
+    void write(const Type& source)
+    {
+        _write(&source, int(sizeof(Type)));
+    }
+
+private:
+    static constexpr int _sectors_count = (int(sizeof(Type)) + flash::sector_size() - 1) / flash::sector_size();
+
+    alignas(int) uint8_t _data_buffer[_sectors_count * flash::sector_size()];
+};
+
+}
+
+#endif
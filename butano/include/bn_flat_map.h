@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_MAP_H
+#define BN_FLAT_MAP_H
+
+/**
+ * @file
+ * bn::flat_map implementation header file.
+ *
+ * @ingroup flat_map
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_flat_map_fwd.h"
+
+namespace bn
+{
+
+template<typename Key, typename Value, int MaxSize, typename KeyCompare>
+class flat_map
+{
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using mapped_type = Value; //!< Value type alias.
+    using value_type = pair<key_type, mapped_type>; //!< (Key, Value) pair type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using key_compare = KeyCompare; //!< Key comparison functor alias.
+    using reference = value_type&; //!< (Key, Value) pair reference alias.
+    using const_reference = const value_type&; //!< (Key, Value) pair const reference alias.
+    using pointer = value_type*; //!< (Key, Value) pair pointer alias.
+    using const_pointer = const value_type*; //!< (Key, Value) pair const pointer alias.
+    using iterator = value_type*; //!< Iterator alias.
+    using const_iterator = const value_type*; //!< Const iterator alias.
+
+    /**
+     * @brief Returns a const iterator to the beginning of the flat_map.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _values.begin();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the flat_map.
+     *
+     * Keys must not be modified through it.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _values.begin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the flat_map.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _values.end();
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the flat_map.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _values.end();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the flat_map.
+     */
+    [[nodiscard]] const_iterator cbegin() const
+    {
+        return _values.cbegin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the flat_map.
+     */
+    [[nodiscard]] const_iterator cend() const
+    {
+        return _values.cend();
+    }
+
+    /**
+     * @brief Returns a span of the stored (Key, Value) pairs, sorted by key.
+     */
+    [[nodiscard]] span<const value_type> values_ref() const
+    {
+        return span<const value_type>(_values.data(), _values.size());
+    }
+
+    /**
+     * @brief Returns the current elements count.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _values.size();
+    }
+
+    /**
+     * @brief Returns the maximum possible elements count.
+     */
+    [[nodiscard]] constexpr size_type max_size() const
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Returns the remaining element capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return _values.available();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _values.empty();
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _values.full();
+    }
+
+    /**
+     * @brief Returns a const iterator to the first element whose key is not less than the given one.
+     */
+    [[nodiscard]] const_iterator lower_bound(const key_type& key) const
+    {
+        return const_cast<flat_map&>(*this).lower_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator to the first element whose key is not less than the given one.
+     */
+    [[nodiscard]] iterator lower_bound(const key_type& key)
+    {
+        return _lower_bound(begin(), end(), key);
+    }
+
+    /**
+     * @brief Returns a const iterator to the first element whose key is greater than the given one.
+     */
+    [[nodiscard]] const_iterator upper_bound(const key_type& key) const
+    {
+        return const_cast<flat_map&>(*this).upper_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator to the first element whose key is greater than the given one.
+     */
+    [[nodiscard]] iterator upper_bound(const key_type& key)
+    {
+        return bn::upper_bound(begin(), end(), key, [](const key_type& other_key, const value_type& value)
+        {
+            return key_compare()(other_key, value.first);
+        });
+    }
+
+    /**
+     * @brief Indicates if the specified key is contained in this flat_map.
+     */
+    [[nodiscard]] bool contains(const key_type& key) const
+    {
+        return find(key) != end();
+    }
+
+    /**
+     * @brief Counts the number of elements with the specified key.
+     */
+    [[nodiscard]] size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] const_iterator find(const key_type& key) const
+    {
+        return const_cast<flat_map&>(*this).find(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Iterator to the (Key, Value) pair if it exists, otherwise end().
+     */
+    [[nodiscard]] iterator find(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+        iterator end_it = end();
+
+        if(it != end_it && ! key_compare()(key, it->first))
+        {
+            return it;
+        }
+
+        return end_it;
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Const reference to the value stored with the specified key.
+     */
+    [[nodiscard]] const mapped_type& at(const key_type& key) const
+    {
+        return const_cast<flat_map&>(*this).at(key);
+    }
+
+    /**
+     * @brief Searches for a given key.
+     * @param key Key to search for.
+     * @return Reference to the value stored with the specified key.
+     */
+    [[nodiscard]] mapped_type& at(const key_type& key)
+    {
+        iterator it = find(key);
+        BN_ASSERT(it != end(), "Key not found");
+
+        return it->second;
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const value_type& value)
+    {
+        return insert(value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param value (Key, Value) pair to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(value_type&& value)
+    {
+        iterator it = lower_bound(value.first);
+
+        if(it != end() && ! key_compare()(value.first, it->first))
+        {
+            return end();
+        }
+
+        return _values.insert(it, move(value));
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert(value_type(key, mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair.
+     * @param key Key to insert.
+     * @param mapped_value Value to insert.
+     * @return Iterator pointing to the inserted (Key, Value) pair if the key does not exist, otherwise end().
+     */
+    iterator insert(const key_type& key, mapped_type&& mapped_value)
+    {
+        return insert(value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Inserts the (Key, Value) pairs of the given range, sorting all elements only once.
+     * @param first Iterator to the first (Key, Value) pair to insert.
+     * @param last Iterator following the last (Key, Value) pair to insert.
+     *
+     * Pairs whose key is already stored are not inserted.
+     * If the range contains more than one pair with the same key, only one of them is inserted.
+     */
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last)
+    {
+        size_type old_size = _values.size();
+
+        for(; first != last; ++first)
+        {
+            const value_type& value = *first;
+            iterator old_end = begin() + old_size;
+            iterator it = _lower_bound(begin(), old_end, value.first);
+
+            if(it == old_end || key_compare()(value.first, it->first))
+            {
+                _values.push_back(value);
+            }
+        }
+
+        if(_values.size() != old_size)
+        {
+            bn::sort(begin(), end(), [](const value_type& a, const value_type& b)
+            {
+                return key_compare()(a.first, b.first);
+            });
+
+            iterator unique_end = bn::unique(begin(), end(), [](const value_type& a, const value_type& b)
+            {
+                return ! key_compare()(a.first, b.first) && ! key_compare()(b.first, a.first);
+            });
+
+            _values.erase(unique_end, end());
+        }
+    }
+
+    /**
+     * @brief Inserts a copy of the given (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const key_type& key, const mapped_type& mapped_value)
+    {
+        return insert_or_assign(key, mapped_type(mapped_value));
+    }
+
+    /**
+     * @brief Inserts a moved (Key, Value) pair
+     * or replaces the value with the given one if the key is found.
+     * @param key Key to insert or assign.
+     * @param mapped_value Value to insert or assign.
+     * @return Iterator pointing to the inserted or assigned (Key, Value) pair.
+     */
+    iterator insert_or_assign(const key_type& key, mapped_type&& mapped_value)
+    {
+        iterator it = lower_bound(key);
+
+        if(it != end() && ! key_compare()(key, it->first))
+        {
+            it->second = move(mapped_value);
+            return it;
+        }
+
+        return _values.insert(it, value_type(key, move(mapped_value)));
+    }
+
+    /**
+     * @brief Returns a reference to the value that is mapped to the given key,
+     * performing an insertion if such key does not already exist.
+     * @param key Key to search for.
+     * @return Reference to the value that is mapped to the given key.
+     */
+    [[nodiscard]] mapped_type& operator[](const key_type& key)
+    {
+        iterator it = lower_bound(key);
+
+        if(it == end() || key_compare()(key, it->first))
+        {
+            it = _values.insert(it, value_type(key, mapped_type()));
+        }
+
+        return it->second;
+    }
+
+    /**
+     * @brief Erases an element.
+     * @param position Iterator to the element to erase.
+     * @return Iterator following the erased element.
+     */
+    iterator erase(const_iterator position)
+    {
+        return _values.erase(position);
+    }
+
+    /**
+     * @brief Erases an element.
+     * @param key Key to erase.
+     * @return `true` if the elements was erased, otherwise `false`.
+     */
+    bool erase(const key_type& key)
+    {
+        iterator it = find(key);
+
+        if(it != end())
+        {
+            _values.erase(it);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Erases all elements that satisfy the specified predicate.
+     * @param map flat_map from which to erase.
+     * @param pred Unary predicate which returns ​true if the element should be erased.
+     * @return Number of erased elements.
+     */
+    template<class Pred>
+    friend size_type erase_if(flat_map& map, const Pred& pred)
+    {
+        return erase_if(map._values, pred);
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    {
+        _values.clear();
+    }
+
+    /**
+     * @brief Exchanges the contents of this flat_map with those of the other one.
+     * @param other flat_map to exchange the contents with.
+     */
+    void swap(flat_map& other)
+    {
+        _values.swap(other._values);
+    }
+
+    /**
+     * @brief Exchanges the contents of a flat_map with those of another one.
+     * @param a First flat_map to exchange the contents with.
+     * @param b Second flat_map to exchange the contents with.
+     */
+    friend void swap(flat_map& a, flat_map& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First flat_map to compare.
+     * @param b Second flat_map to compare.
+     * @return `true` if the first flat_map is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const flat_map& a, const flat_map& b)
+    {
+        return a._values == b._values;
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First flat_map to compare.
+     * @param b Second flat_map to compare.
+     * @return `true` if the first flat_map is not equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator!=(const flat_map& a, const flat_map& b)
+    {
+        return ! (a == b);
+    }
+
+    /**
+     * @brief Less than operator.
+     * @param a First flat_map to compare.
+     * @param b Second flat_map to compare.
+     * @return `true` if the first flat_map is lexicographically less than the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<(const flat_map& a, const flat_map& b)
+    {
+        return a._values < b._values;
+    }
+
+private:
+    vector<value_type, MaxSize> _values;
+
+    [[nodiscard]] static iterator _lower_bound(iterator first, iterator last, const key_type& key)
+    {
+        return bn::lower_bound(first, last, key, [](const value_type& value, const key_type& other_key)
+        {
+            return key_compare()(value.first, other_key);
+        });
+    }
+};
+
+}
+
+#endif
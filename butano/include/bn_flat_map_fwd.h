@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_MAP_FWD_H
+#define BN_FLAT_MAP_FWD_H
+
+/**
+ * @file
+ * bn::flat_map declaration header file.
+ *
+ * @ingroup flat_map
+ */
+
+#include "bn_functional.h"
+
+namespace bn
+{
+    /**
+     * @brief `std::flat_map` like container with a fixed size buffer.
+     *
+     * Elements are stored in a bn::vector sorted by key, so they are searched with a binary search.
+     * For a small number of elements, this is usually faster than hashing.
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * @tparam Key Key type.
+     * @tparam Value Value type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     * @tparam KeyCompare Functor used to sort keys.
+     *
+     * @ingroup flat_map
+     */
+    template<typename Key, typename Value, int MaxSize, typename KeyCompare = less<Key>>
+    class flat_map;
+}
+
+#endif
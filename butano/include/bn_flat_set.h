@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_SET_H
+#define BN_FLAT_SET_H
+
+/**
+ * @file
+ * bn::flat_set implementation header file.
+ *
+ * @ingroup flat_set
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_flat_set_fwd.h"
+
+namespace bn
+{
+
+template<typename Key, int MaxSize, typename KeyCompare>
+class flat_set
+{
+
+public:
+    using key_type = Key; //!< Key type alias.
+    using value_type = Key; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using key_compare = KeyCompare; //!< Key comparison functor alias.
+    using reference = value_type&; //!< Value reference alias.
+    using const_reference = const value_type&; //!< Value const reference alias.
+    using pointer = value_type*; //!< Value pointer alias.
+    using const_pointer = const value_type*; //!< Value const pointer alias.
+    using iterator = value_type*; //!< Iterator alias.
+    using const_iterator = const value_type*; //!< Const iterator alias.
+
+    /**
+     * @brief Returns a const iterator to the beginning of the flat_set.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+        return _values.begin();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning of the flat_set.
+     *
+     * Values must not be modified through it.
+     */
+    [[nodiscard]] iterator begin()
+    {
+        return _values.begin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the flat_set.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+        return _values.end();
+    }
+
+    /**
+     * @brief Returns an iterator to the end of the flat_set.
+     */
+    [[nodiscard]] iterator end()
+    {
+        return _values.end();
+    }
+
+    /**
+     * @brief Returns a const iterator to the beginning of the flat_set.
+     */
+    [[nodiscard]] const_iterator cbegin() const
+    {
+        return _values.cbegin();
+    }
+
+    /**
+     * @brief Returns a const iterator to the end of the flat_set.
+     */
+    [[nodiscard]] const_iterator cend() const
+    {
+        return _values.cend();
+    }
+
+    /**
+     * @brief Returns a span of the stored values, in ascending order.
+     */
+    [[nodiscard]] span<const value_type> values_ref() const
+    {
+        return span<const value_type>(_values.data(), _values.size());
+    }
+
+    /**
+     * @brief Returns the current elements count.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return _values.size();
+    }
+
+    /**
+     * @brief Returns the maximum possible elements count.
+     */
+    [[nodiscard]] constexpr size_type max_size() const
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Returns the remaining element capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return _values.available();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _values.empty();
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _values.full();
+    }
+
+    /**
+     * @brief Returns a const iterator to the first element which is not less than the given one.
+     */
+    [[nodiscard]] const_iterator lower_bound(const key_type& key) const
+    {
+        return const_cast<flat_set&>(*this).lower_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator to the first element which is not less than the given one.
+     */
+    [[nodiscard]] iterator lower_bound(const key_type& key)
+    {
+        return _lower_bound(begin(), end(), key);
+    }
+
+    /**
+     * @brief Returns a const iterator to the first element which is greater than the given one.
+     */
+    [[nodiscard]] const_iterator upper_bound(const key_type& key) const
+    {
+        return const_cast<flat_set&>(*this).upper_bound(key);
+    }
+
+    /**
+     * @brief Returns an iterator to the first element which is greater than the given one.
+     */
+    [[nodiscard]] iterator upper_bound(const key_type& key)
+    {
+        return bn::upper_bound(begin(), end(), key, [](const key_type& other_key, const value_type& value)
+        {
+            return key_compare()(other_key, value);
+        });
+    }
+
+    /**
+     * @brief Indicates if the specified value is contained in this flat_set.
+     */
+    [[nodiscard]] bool contains(const key_type& key) const
+    {
+        return find(key) != end();
+    }
+
+    /**
+     * @brief Counts the number of elements equivalent to the given one.
+     */
+    [[nodiscard]] size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Searches for a given value.
+     * @param key Value to search for.
+     * @return Const iterator to the value if it exists, otherwise end().
+     */
+    [[nodiscard]] const_iterator find(const key_type& key) const
+    {
+        return const_cast<flat_set&>(*this).find(key);
+    }
+
+    /**
+     * @brief Searches for a given value.
+     * @param key Value to search for.
+     * @return Iterator to the value if it exists, otherwise end().
+     */
+    [[nodiscard]] iterator find(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+        iterator end_it = end();
+
+        if(it != end_it && ! key_compare()(key, *it))
+        {
+            return it;
+        }
+
+        return end_it;
+    }
+
+    /**
+     * @brief Inserts a copy of the given value.
+     * @param value Value to insert.
+     * @return Iterator pointing to the inserted value if it does not exist, otherwise end().
+     */
+    iterator insert(const value_type& value)
+    {
+        return insert(value_type(value));
+    }
+
+    /**
+     * @brief Inserts a moved value.
+     * @param value Value to insert.
+     * @return Iterator pointing to the inserted value if it does not exist, otherwise end().
+     */
+    iterator insert(value_type&& value)
+    {
+        iterator it = lower_bound(value);
+
+        if(it != end() && ! key_compare()(value, *it))
+        {
+            return end();
+        }
+
+        return _values.insert(it, move(value));
+    }
+
+    /**
+     * @brief Inserts the values of the given range, sorting all elements only once.
+     * @param first Iterator to the first value to insert.
+     * @param last Iterator following the last value to insert.
+     *
+     * Values already stored are not inserted.
+     * If the range contains equivalent values, only one of them is inserted.
+     */
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last)
+    {
+        size_type old_size = _values.size();
+
+        for(; first != last; ++first)
+        {
+            const value_type& value = *first;
+            iterator old_end = begin() + old_size;
+            iterator it = _lower_bound(begin(), old_end, value);
+
+            if(it == old_end || key_compare()(value, *it))
+            {
+                _values.push_back(value);
+            }
+        }
+
+        if(_values.size() != old_size)
+        {
+            bn::sort(begin(), end(), [](const value_type& a, const value_type& b)
+            {
+                return key_compare()(a, b);
+            });
+
+            iterator unique_end = bn::unique(begin(), end(), [](const value_type& a, const value_type& b)
+            {
+                return ! key_compare()(a, b) && ! key_compare()(b, a);
+            });
+
+            _values.erase(unique_end, end());
+        }
+    }
+
+    /**
+     * @brief Erases an element.
+     * @param position Iterator to the element to erase.
+     * @return Iterator following the erased element.
+     */
+    iterator erase(const_iterator position)
+    {
+        return _values.erase(position);
+    }
+
+    /**
+     * @brief Erases an element.
+     * @param key Value to erase.
+     * @return `true` if the elements was erased, otherwise `false`.
+     */
+    bool erase(const key_type& key)
+    {
+        iterator it = find(key);
+
+        if(it != end())
+        {
+            _values.erase(it);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Erases all elements that satisfy the specified predicate.
+     * @param set flat_set from which to erase.
+     * @param pred Unary predicate which returns ​true if the element should be erased.
+     * @return Number of erased elements.
+     */
+    template<class Pred>
+    friend size_type erase_if(flat_set& set, const Pred& pred)
+    {
+        return erase_if(set._values, pred);
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear()
+    {
+        _values.clear();
+    }
+
+    /**
+     * @brief Exchanges the contents of this flat_set with those of the other one.
+     * @param other flat_set to exchange the contents with.
+     */
+    void swap(flat_set& other)
+    {
+        _values.swap(other._values);
+    }
+
+    /**
+     * @brief Exchanges the contents of a flat_set with those of another one.
+     * @param a First flat_set to exchange the contents with.
+     * @param b Second flat_set to exchange the contents with.
+     */
+    friend void swap(flat_set& a, flat_set& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First flat_set to compare.
+     * @param b Second flat_set to compare.
+     * @return `true` if the first flat_set is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const flat_set& a, const flat_set& b)
+    {
+        return a._values == b._values;
+    }
+
+    /**
+     * @brief Not equal operator.
+     * @param a First flat_set to compare.
+     * @param b Second flat_set to compare.
+     * @return `true` if the first flat_set is not equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator!=(const flat_set& a, const flat_set& b)
+    {
+        return ! (a == b);
+    }
+
+    /**
+     * @brief Less than operator.
+     * @param a First flat_set to compare.
+     * @param b Second flat_set to compare.
+     * @return `true` if the first flat_set is lexicographically less than the second one, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator<(const flat_set& a, const flat_set& b)
+    {
+        return a._values < b._values;
+    }
+
+private:
+    vector<value_type, MaxSize> _values;
+
+    [[nodiscard]] static iterator _lower_bound(iterator first, iterator last, const key_type& key)
+    {
+        return bn::lower_bound(first, last, key, [](const value_type& value, const key_type& other_key)
+        {
+            return key_compare()(value, other_key);
+        });
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FLAT_SET_FWD_H
+#define BN_FLAT_SET_FWD_H
+
+/**
+ * @file
+ * bn::flat_set declaration header file.
+ *
+ * @ingroup flat_set
+ */
+
+#include "bn_functional.h"
+
+namespace bn
+{
+    /**
+     * @brief `std::flat_set` like container with a fixed size buffer.
+     *
+     * Elements are stored in a bn::vector in ascending order, so they are searched with a binary search.
+     * For a small number of elements, this is usually faster than hashing.
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * @tparam Key Element type.
+     * @tparam MaxSize Maximum number of elements that can be stored.
+     * @tparam KeyCompare Functor used to sort elements.
+     *
+     * @ingroup flat_set
+     */
+    template<typename Key, int MaxSize, typename KeyCompare = less<Key>>
+    class flat_set;
+}
+
+#endif
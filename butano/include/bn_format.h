@@ -8,157 +8,245 @@
 
 /**
  * @file
- * bn::format and bn::format_ref header file.
+ * bn::format_string, bn::format and bn::format_ref header file.
  *
  * @ingroup string
  */
 
+#include "bn_limits.h"
 #include "bn_string.h"
 
 /// @cond DO_NOT_DOCUMENT
 
 namespace _bn
 {
-    void format(bn::ostringstream& stream, const char* format_begin, const char* format_end);
+    void invalid_format_string(const char* error);
 
-    template<typename Type>
-    void format(bn::ostringstream& stream, const char* format_begin, const char* format_end, const Type& value)
+    void format_escaped(bn::ostringstream& stream, const char* format_begin, const char* format_end);
+}
+
+/// @endcond
+
+
+namespace bn
+{
+
+/**
+ * @brief Format string parsed at compile time.
+ *
+ * It is built from a string literal in a consteval constructor, which splits the format string
+ * in the literal segments placed around each replacement field,
+ * so formatting the arguments only appends the literal segments and the arguments in order.
+ *
+ * The format string consists of:
+ * * Ordinary characters (except `{` and `}`), which are copied unchanged to the output.
+ * * Escape sequences `{{` and `}}`, which are replaced with `{` and `}` respectively in the output.
+ * * Replacement fields, with the following format: `{}`.
+ *
+ * A format string with single `{` or `}` characters or with more replacement fields than arguments
+ * doesn't compile.
+ *
+ * @tparam Args Types of the arguments to be formatted.
+ *
+ * @ingroup string
+ */
+template<class... Args>
+class format_string
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param format String literal representing the format string.
+     */
+    template<int Size>
+    consteval format_string(const char (&format)[Size]) :
+        _format(format)
     {
-        while(format_begin != format_end)
+        if(Size > numeric_limits<int16_t>::max())
+        {
+            _bn::invalid_format_string("Format is too long");
+        }
+
+        const char* format_end = format + Size - 1;
+        const char* segment_begin = format;
+        const char* format_it = format;
+        bool escaped = false;
+
+        while(format_it != format_end)
         {
-            char character = *format_begin;
-            ++format_begin;
+            char character = *format_it;
+            ++format_it;
 
-            if(character == '{') [[unlikely]]
+            if(character == '{')
             {
-                BN_ASSERT(format_begin != format_end, "Format contains a single '{' character");
+                if(format_it == format_end)
+                {
+                    _bn::invalid_format_string("Format contains a single '{' character");
+                }
 
-                char next_character = *format_begin;
-                ++format_begin;
+                char next_character = *format_it;
+                ++format_it;
 
-                if(next_character == '{') [[unlikely]]
+                if(next_character == '{')
                 {
-                    stream.append(next_character);
+                    escaped = true;
                 }
                 else
                 {
-                    BN_ASSERT(next_character == '}', "Format contains a single '{' character");
-
-                    stream << value;
-                    format(stream, format_begin, format_end);
-                    return;
+                    if(next_character != '}')
+                    {
+                        _bn::invalid_format_string("Format contains a single '{' character");
+                    }
+
+                    if(_fields_count == int(sizeof...(Args)))
+                    {
+                        _bn::invalid_format_string("Not enough arguments");
+                    }
+
+                    _add_segment(segment_begin, format_it - 2, escaped);
+                    ++_fields_count;
+                    segment_begin = format_it;
+                    escaped = false;
                 }
             }
-            else if(character == '}') [[unlikely]]
+            else if(character == '}')
             {
-                BN_ASSERT(format_begin != format_end, "Format contains a single '}' character");
-                BN_ASSERT(*format_begin == '}', "Format contains a single '}' character");
+                if(format_it == format_end || *format_it != '}')
+                {
+                    _bn::invalid_format_string("Format contains a single '}' character");
+                }
 
-                ++format_begin;
-                stream.append('}');
-            }
-            else
-            {
-                stream.append(character);
+                ++format_it;
+                escaped = true;
             }
         }
+
+        _add_segment(segment_begin, format_end, escaped);
     }
 
-    template<typename Type, typename... Args>
-    void format(bn::ostringstream& stream, const char* format_begin, const char* format_end, const Type& value,
-                const Args&... args)
+    /**
+     * @brief Returns the number of replacement fields of the format string.
+     */
+    [[nodiscard]] constexpr int fields_count() const
     {
-        while(format_begin != format_end)
-        {
-            char character = *format_begin;
-            ++format_begin;
+        return _fields_count;
+    }
 
-            if(character == '{') [[unlikely]]
-            {
-                BN_ASSERT(format_begin != format_end, "Format contains a single '{' character");
+    /**
+     * @brief Appends the formatted arguments to the given ostringstream.
+     * @param stream Output ostringstream.
+     * @param args Arguments to be formatted. They are used in order when processing the format string.
+     */
+    void append(ostringstream& stream, const Args&... args) const
+    {
+        int field_index = 0;
+        (_append_field(stream, field_index, args), ...);
+        _append_segment(stream, _segments[_fields_count]);
+    }
 
-                char next_character = *format_begin;
-                ++format_begin;
+private:
+    class segment_type
+    {
 
-                if(next_character == '{') [[unlikely]]
-                {
-                    stream.append(next_character);
-                }
-                else
-                {
-                    BN_ASSERT(next_character == '}', "Format contains a single '{' character");
+    public:
+        int16_t begin = 0;
+        int16_t size = 0;
+        bool escaped = false;
+    };
 
-                    stream << value;
-                    format(stream, format_begin, format_end, args...);
-                    return;
-                }
-            }
-            else if(character == '}') [[unlikely]]
-            {
-                BN_ASSERT(format_begin != format_end, "Format contains a single '}' character");
-                BN_ASSERT(*format_begin == '}', "Format contains a single '}' character");
+    const char* _format;
+    segment_type _segments[sizeof...(Args) + 1] = {};
+    int _fields_count = 0;
 
-                ++format_begin;
-                stream.append('}');
-            }
-            else
-            {
-                stream.append(character);
-            }
+    consteval void _add_segment(const char* segment_begin, const char* segment_end, bool escaped)
+    {
+        segment_type& segment = _segments[_fields_count];
+        segment.begin = int16_t(segment_begin - _format);
+        segment.size = int16_t(segment_end - segment_begin);
+        segment.escaped = escaped;
+    }
+
+    void _append_segment(ostringstream& stream, const segment_type& segment) const
+    {
+        const char* segment_begin = _format + segment.begin;
+
+        if(segment.escaped) [[unlikely]]
+        {
+            _bn::format_escaped(stream, segment_begin, segment_begin + segment.size);
+        }
+        else if(segment.size)
+        {
+            stream.append(segment_begin, segment.size);
         }
     }
-}
 
-/// @endcond
+    template<typename Type>
+    void _append_field(ostringstream& stream, int& field_index, const Type& value) const
+    {
+        if(field_index < _fields_count)
+        {
+            _append_segment(stream, _segments[field_index]);
+            stream << value;
+            ++field_index;
+        }
+    }
+};
 
+/// @cond DO_NOT_DOCUMENT
 
-namespace bn
-{
+template<class... Args>
+using format_string_t = format_string<type_identity_t<Args>...>;
+
+/// @endcond
 
 /**
  * @brief Format the given arguments according to the given format string, and return the result as a string.
  * @tparam MaxSize Maximum number of characters that can be stored in the output string.
  * @tparam Args Types of the arguments to be formatted.
- * @param format string_view representing the format string.
- *
- * The format string consists of:
- * * Ordinary characters (except `{` and `}`), which are copied unchanged to the output.
- * * Escape sequences `{{` and `}}`, which are replaced with `{` and `}` respectively in the output.
- * * Replacement fields, with the following format: `{}`.
- *
+ * @param format Format string, parsed at compile time (see bn::format_string).
  * @param args Arguments to be formatted. They are used in order when processing the format string.
  * @return A string holding the formatted result.
  *
  * @ingroup string
  */
 template<int MaxSize, class... Args>
-[[nodiscard]] string<MaxSize> format(const string_view& format, const Args&... args)
+[[nodiscard]] string<MaxSize> format(const format_string_t<Args...>& format, const Args&... args)
 {
     string<MaxSize> result;
     ostringstream stream(result);
-    _bn::format(stream, format.begin(), format.end(), args...);
+    format.append(stream, args...);
     return result;
 }
 
 /**
  * @brief Format the given arguments according to the given format string, storing the result in the given string.
  * @param string The result of the formatting is stored in this string.
- * @param format string_view representing the format string.
- *
- * The format string consists of:
- * * Ordinary characters (except `{` and `}`), which are copied unchanged to the output.
- * * Escape sequences `{{` and `}}`, which are replaced with `{` and `}` respectively in the output.
- * * Replacement fields, with the following format: `{}`.
- *
+ * @param format Format string, parsed at compile time (see bn::format_string).
  * @param args Arguments to be formatted. They are used in order when processing the format string.
  *
  * @ingroup string
  */
 template<class... Args>
-void format_ref(istring_base& string, const string_view& format, const Args&... args)
+void format_ref(istring_base& string, const format_string_t<Args...>& format, const Args&... args)
 {
     ostringstream stream(string);
-    _bn::format(stream, format.begin(), format.end(), args...);
+    format.append(stream, args...);
+}
+
+/**
+ * @brief Format the given arguments according to the given format string,
+ * appending the result to the given ostringstream.
+ * @param stream The result of the formatting is appended to this ostringstream.
+ * @param format Format string, parsed at compile time (see bn::format_string).
+ * @param args Arguments to be formatted. They are used in order when processing the format string.
+ *
+ * @ingroup string
+ */
+template<class... Args>
+void format_ref(ostringstream& stream, const format_string_t<Args...>& format, const Args&... args)
+{
+    format.append(stream, args...);
 }
 
 }
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_GRID_PATHFINDER_H
+#define BN_GRID_PATHFINDER_H
+
+/**
+ * @file
+ * bn::igrid_pathfinder and bn::grid_pathfinder implementation header file.
+ *
+ * @ingroup math
+ */
+
+#include "bn_point.h"
+#include "bn_vector.h"
+#include "bn_tile_collision_map.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::grid_pathfinder.
+ *
+ * A grid pathfinder searches paths between the cells of a grid in which each cell has a movement cost.
+ * Cells with cost 0 are blocked, and cells outside of the grid are blocked too.
+ *
+ * Moving to an orthogonal neighbor costs 10 times the cost of the destination cell.
+ * Moving to a diagonal neighbor costs 14 times the cost of the destination cell,
+ * and it is allowed only if both orthogonal cells between them are not blocked (corners can't be cut).
+ *
+ * Searches are resumable: each update call expands a fixed number of cells at most,
+ * so searches can be spread across multiple frames with bn::task or with core idle tasks:
+ *
+ * @code{.cpp}
+ * bn::task path_task(bn::igrid_pathfinder& pathfinder, const bn::point& start, const bn::point& goal)
+ * {
+ *     pathfinder.search_path(start, goal);
+ *
+ *     while(pathfinder.update(64) == bn::igrid_pathfinder::status_type::SEARCHING)
+ *     {
+ *         co_await bn::next_frame();
+ *     }
+ * }
+ * @endcode
+ *
+ * The open list is a binary heap with decrease-key, so each cell is stored at most once in it,
+ * and searches run in IWRAM.
+ *
+ * A pathfinder keeps the state of only one search at a time,
+ * so several pathfinders are required to search several paths at the same time.
+ *
+ * @ingroup math
+ */
+class igrid_pathfinder
+{
+
+public:
+    /**
+     * @brief Available search algorithms.
+     */
+    enum class algorithm_type : uint8_t
+    {
+        A_STAR_4, //!< A* with orthogonal moves only.
+        A_STAR_8, //!< A* with orthogonal and diagonal moves.
+        JUMP_POINT_SEARCH //!< Jump point search with orthogonal and diagonal moves, ignoring cell costs.
+    };
+
+    /**
+     * @brief Available search states.
+     */
+    enum class status_type : uint8_t
+    {
+        IDLE, //!< No search has been started.
+        SEARCHING, //!< The current search has not been finished yet.
+        FOUND, //!< A path has been found, or a flow field has been completed.
+        NOT_FOUND //!< The goal of the current path search is not reachable from its start.
+    };
+
+    igrid_pathfinder(const igrid_pathfinder& other) = delete;
+
+    igrid_pathfinder& operator=(const igrid_pathfinder& other) = delete;
+
+    /**
+     * @brief Returns the number of columns of the grid.
+     */
+    [[nodiscard]] int width() const
+    {
+        return _width;
+    }
+
+    /**
+     * @brief Returns the number of rows of the grid.
+     */
+    [[nodiscard]] int height() const
+    {
+        return _height;
+    }
+
+    /**
+     * @brief Indicates if the specified cell is inside of the grid or not.
+     */
+    [[nodiscard]] bool contains(int x, int y) const
+    {
+        return x >= 0 && y >= 0 && x < _width && y < _height;
+    }
+
+    /**
+     * @brief Returns the movement cost of the specified cell, or 0 if it is blocked or outside of the grid.
+     */
+    [[nodiscard]] int cost(int x, int y) const
+    {
+        return contains(x, y) ? _costs[(y * _width) + x] : 0;
+    }
+
+    /**
+     * @brief Sets the movement cost of the specified cell.
+     * @param x Column of the cell.
+     * @param y Row of the cell.
+     * @param cost Movement cost in the range [0, 255]. If it is 0, the cell is blocked.
+     *
+     * Costs should not be changed while searching, since changes are taken into account only partially.
+     */
+    void set_cost(int x, int y, int cost);
+
+    /**
+     * @brief Sets the same movement cost to all cells of the grid.
+     * @param cost Movement cost in the range [0, 255]. If it is 0, all cells are blocked.
+     */
+    void fill_costs(int cost);
+
+    /**
+     * @brief Sets the movement costs of the grid from the cells of the given collision map.
+     * @param map Collision map whose top-left cells are read.
+     * @param solid_values_mask Mask of the collision values which block movement.
+     * @param walkable_cost Movement cost of the cells which don't block movement, in the range [1, 255].
+     */
+    void set_costs(const tile_collision_map& map,
+                   unsigned solid_values_mask = tile_collision_map::default_solid_values_mask(),
+                   int walkable_cost = 1);
+
+    /**
+     * @brief Returns the state of the current search.
+     */
+    [[nodiscard]] status_type status() const
+    {
+        return _status;
+    }
+
+    /**
+     * @brief Indicates if the current search generates a flow field or a path.
+     */
+    [[nodiscard]] bool flow_field() const
+    {
+        return _flow_field;
+    }
+
+    /**
+     * @brief Starts a path search, cancelling the current one.
+     * @param start Origin cell of the path.
+     * @param goal Destination cell of the path.
+     * @param algorithm Search algorithm.
+     *
+     * The search is performed by subsequent update calls.
+     */
+    void search_path(const point& start, const point& goal, algorithm_type algorithm = algorithm_type::A_STAR_8);
+
+    /**
+     * @brief Starts the generation of a flow field which leads all cells of the grid to the given goal,
+     * cancelling the current search.
+     *
+     * Flow fields are useful to move crowds to the same destination,
+     * since the next cell of each unit is obtained with a neighbors lookup (see flow_direction).
+     *
+     * @param goal Destination cell.
+     * @param diagonal_moves Indicates if diagonal moves are allowed or not.
+     *
+     * The flow field is generated by subsequent update calls.
+     */
+    void search_flow_field(const point& goal, bool diagonal_moves = true);
+
+    /**
+     * @brief Resumes the current search.
+     * @param max_expanded_cells Maximum number of cells to expand (it must be > 0).
+     * @return State of the current search after this call.
+     */
+    BN_CODE_IWRAM status_type update(int max_expanded_cells);
+
+    /**
+     * @brief Cancels the current search.
+     */
+    void cancel()
+    {
+        _status = status_type::IDLE;
+    }
+
+    /**
+     * @brief Returns the cost of the found path.
+     */
+    [[nodiscard]] int path_cost() const;
+
+    /**
+     * @brief Inserts the cells of the found path, from its start to its goal (both included),
+     * at the end of the given vector.
+     */
+    void path(ivector<point>& cells) const;
+
+    /**
+     * @brief Returns the number of cells of the found path, including both its start and its goal.
+     */
+    [[nodiscard]] int path_size() const;
+
+    /**
+     * @brief Returns the cost to reach the goal of the flow field from the specified cell,
+     * or -1 if it has not been reached.
+     *
+     * Costs are final only after the flow field has been completed.
+     */
+    [[nodiscard]] int flow_cost(int x, int y) const;
+
+    /**
+     * @brief Returns the displacement to the next cell towards the goal of the flow field from the specified cell,
+     * or (0, 0) if the specified cell is the goal or it has not been reached.
+     *
+     * Directions are final only after the flow field has been completed.
+     */
+    [[nodiscard]] point flow_direction(int x, int y) const;
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class cell_type
+    {
+
+    public:
+        int g;
+        int f;
+        int16_t parent;
+        int16_t heap_index;
+    };
+
+    igrid_pathfinder(cell_type* cells, uint8_t* costs, uint16_t* stamps, int16_t* heap, int width, int height);
+
+    /// @endcond
+
+private:
+    cell_type* _cells;
+    uint8_t* _costs;
+    uint16_t* _stamps;
+    int16_t* _heap;
+    int _heap_size = 0;
+    int _row_reciprocal;
+    int _goal = 0;
+    int16_t _goal_x = 0;
+    int16_t _goal_y = 0;
+    uint16_t _stamp = 0;
+    int16_t _width;
+    int16_t _height;
+    algorithm_type _algorithm = algorithm_type::A_STAR_8;
+    status_type _status = status_type::IDLE;
+    bool _flow_field = false;
+
+    [[nodiscard]] bool _walkable(int x, int y) const
+    {
+        return contains(x, y) && _costs[(y * _width) + x];
+    }
+
+    [[nodiscard]] bool _visited(int cell) const
+    {
+        return _stamps[cell] == _stamp;
+    }
+
+    void _coordinates(int cell, int& x, int& y) const
+    {
+        // Divisions are avoided with a reciprocal which underestimates the row at most by one:
+        y = (cell * _row_reciprocal) >> 16;
+        x = cell - (y * _width);
+
+        if(x >= _width)
+        {
+            x -= _width;
+            ++y;
+        }
+    }
+
+    void _start(const point& first_cell, const point& goal);
+
+    [[nodiscard]] BN_CODE_IWRAM int _heuristic(int x, int y) const;
+
+    BN_CODE_IWRAM void _relax(int x, int y, int parent, int g);
+
+    [[nodiscard]] BN_CODE_IWRAM int _pop();
+
+    BN_CODE_IWRAM void _sift_up(int heap_index);
+
+    BN_CODE_IWRAM void _sift_down(int heap_index);
+
+    BN_CODE_IWRAM void _expand_neighbors(int cell);
+
+    BN_CODE_IWRAM void _expand_jump_points(int cell);
+
+    [[nodiscard]] BN_CODE_IWRAM bool _jump(int dx, int dy, int& x, int& y) const;
+};
+
+
+/**
+ * @brief Resumable A*, jump point search and flow fields over a grid of movement costs.
+ *
+ * It requires 17 bytes per cell, so big grids should be declared with BN_DATA_EWRAM.
+ *
+ * @tparam Width Number of columns of the grid.
+ * @tparam Height Number of rows of the grid.
+ *
+ * @ingroup math
+ */
+template<int Width, int Height>
+class grid_pathfinder : public igrid_pathfinder
+{
+    static_assert(Width > 0 && Height > 0 && Width * Height <= 32767);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param cost Initial movement cost of all cells, in the range [0, 255].
+     */
+    explicit grid_pathfinder(int cost = 1) :
+        igrid_pathfinder(_cells_buffer, _costs_buffer, _stamps_buffer, _heap_buffer, Width, Height)
+    {
+        fill_costs(cost);
+    }
+
+private:
+    cell_type _cells_buffer[Width * Height];
+    uint16_t _stamps_buffer[Width * Height] = {};
+    int16_t _heap_buffer[Width * Height];
+    uint8_t _costs_buffer[Width * Height];
+};
+
+}
+
+#endif
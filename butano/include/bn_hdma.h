@@ -36,6 +36,8 @@ namespace bn::hdma
      *
      * If the elements overlap, the behavior is undefined.
      *
+     * If the destination overlaps the destination of another running HDMA stream, an error is raised.
+     *
      * @param source_ref Const reference to the memory location to copy from.
      * @param elements Number of elements to copy (not bytes).
      * @param destination_ref Reference to the memory location to copy to.
@@ -47,6 +49,96 @@ namespace bn::hdma
      */
     void stop();
 
+    /**
+     * @brief Publishes the memory location referenced by source_ref as the HDMA source for the next frame.
+     *
+     * Unlike start, the published source is taken at the next V-Blank even if bn::core::update
+     * has not been called, so tables can be produced as late as possible.
+     * If several sources are published before the next V-Blank, only the last one is used.
+     *
+     * The published source must not be modified until it has been replaced by another one
+     * (see displayed_source), so three tables are needed to produce a new one while the other two are in use
+     * (see bn::hdma_triple_buffer).
+     *
+     * It must not be mixed with start calls in the same frame.
+     *
+     * @param source_ref Const reference to the memory location to copy from.
+     * @param elements Number of elements to copy (not bytes).
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    /**
+     * @brief Returns the HDMA source used in the current frame, or `nullptr` if HDMA is not active.
+     */
+    [[nodiscard]] const uint16_t* displayed_source();
+
+    /**
+     * @brief Indicates if medium priority HDMA is active or not.
+     *
+     * Medium priority HDMA runs alongside low and high priority HDMA,
+     * so up to three HDMA streams can be active at the same time.
+     *
+     * It is not available if @ref BN_CFG_PCM_STREAM_ENABLED or @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED are `true`.
+     */
+    [[nodiscard]] bool medium_priority_running();
+
+    /**
+     * @brief Start copying each frame with medium priority the given amount of elements
+     * from the memory location referenced by source_ref to the memory location referenced by destination_ref.
+     *
+     * The elements are not copied but referenced,
+     * so they should be alive while HDMA is running to avoid dangling references.
+     *
+     * If the elements overlap, the behavior is undefined.
+     *
+     * If the destination overlaps the destination of another running HDMA stream, an error is raised.
+     *
+     * It is not available if @ref BN_CFG_PCM_STREAM_ENABLED or @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED are `true`.
+     *
+     * @param source_ref Const reference to the memory location to copy from.
+     * @param elements Number of elements to copy (not bytes).
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void medium_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    /**
+     * @brief Stops copying elements each frame with medium priority.
+     *
+     * It is not available if @ref BN_CFG_PCM_STREAM_ENABLED or @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED are `true`.
+     */
+    void medium_priority_stop();
+
+    /**
+     * @brief Publishes the memory location referenced by source_ref
+     * as the medium priority HDMA source for the next frame.
+     *
+     * Unlike medium_priority_start, the published source is taken at the next V-Blank even if bn::core::update
+     * has not been called, so tables can be produced as late as possible.
+     * If several sources are published before the next V-Blank, only the last one is used.
+     *
+     * The published source must not be modified until it has been replaced by another one
+     * (see medium_priority_displayed_source), so three tables are needed to produce a new one
+     * while the other two are in use (see bn::hdma_triple_buffer).
+     *
+     * It must not be mixed with medium_priority_start calls in the same frame.
+     *
+     * It is not available if @ref BN_CFG_PCM_STREAM_ENABLED or @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED are `true`.
+     *
+     * @param source_ref Const reference to the memory location to copy from.
+     * @param elements Number of elements to copy (not bytes).
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void medium_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    /**
+     * @brief Returns the medium priority HDMA source used in the current frame,
+     * or `nullptr` if medium priority HDMA is not active.
+     *
+     * It is not available if @ref BN_CFG_PCM_STREAM_ENABLED or @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED are `true`.
+     */
+    [[nodiscard]] const uint16_t* medium_priority_displayed_source();
+
     /**
      * @brief Indicates if high priority HDMA is active or not.
      *
@@ -63,6 +155,8 @@ namespace bn::hdma
      *
      * If the elements overlap, the behavior is undefined.
      *
+     * If the destination overlaps the destination of another running HDMA stream, an error is raised.
+     *
      * High priority HDMA can cause issues with audio, so avoid it unless necessary.
      *
      * @param source_ref Const reference to the memory location to copy from.
@@ -77,6 +171,32 @@ namespace bn::hdma
      * High priority HDMA can cause issues with audio, so avoid it unless necessary.
      */
     void high_priority_stop();
+
+    /**
+     * @brief Publishes the memory location referenced by source_ref
+     * as the high priority HDMA source for the next frame.
+     *
+     * Unlike high_priority_start, the published source is taken at the next V-Blank even if bn::core::update
+     * has not been called, so tables can be produced as late as possible.
+     * If several sources are published before the next V-Blank, only the last one is used.
+     *
+     * The published source must not be modified until it has been replaced by another one
+     * (see high_priority_displayed_source), so three tables are needed to produce a new one
+     * while the other two are in use (see bn::hdma_triple_buffer).
+     *
+     * It must not be mixed with high_priority_start calls in the same frame.
+     *
+     * @param source_ref Const reference to the memory location to copy from.
+     * @param elements Number of elements to copy (not bytes).
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void high_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    /**
+     * @brief Returns the high priority HDMA source used in the current frame,
+     * or `nullptr` if high priority HDMA is not active.
+     */
+    [[nodiscard]] const uint16_t* high_priority_displayed_source();
 }
 
 #endif
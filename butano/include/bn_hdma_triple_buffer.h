@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HDMA_TRIPLE_BUFFER_H
+#define BN_HDMA_TRIPLE_BUFFER_H
+
+/**
+ * @file
+ * bn::hdma_triple_buffer header file.
+ *
+ * @ingroup hdma
+ */
+
+#include "bn_span.h"
+#include "bn_hdma.h"
+#include "bn_display.h"
+
+namespace bn
+{
+
+/**
+ * @brief Three HDMA source tables rotated with bn::hdma::publish.
+ *
+ * A new table is written in the back table while the other two are displayed or waiting for the next V-Blank,
+ * so tables can be updated late in the frame without tearing.
+ *
+ * @tparam Elements Number of elements copied in each screen line.
+ *
+ * @ingroup hdma
+ */
+template<int Elements>
+class hdma_triple_buffer
+{
+    static_assert(Elements > 0);
+
+public:
+    /**
+     * @brief Returns the number of elements of each table.
+     */
+    [[nodiscard]] static constexpr int table_size()
+    {
+        return Elements * display::height();
+    }
+
+    /**
+     * @brief Returns the table which can be written.
+     */
+    [[nodiscard]] span<uint16_t> back()
+    {
+        return span<uint16_t>(_tables[_back_index], table_size());
+    }
+
+    /**
+     * @brief Publishes the back table with bn::hdma::publish and selects a new back table.
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void publish(uint16_t& destination_ref)
+    {
+        hdma::publish(_tables[_back_index][0], Elements, destination_ref);
+        _select_back(hdma::displayed_source());
+    }
+
+    /**
+     * @brief Publishes the back table with bn::hdma::medium_priority_publish and selects a new back table.
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void medium_priority_publish(uint16_t& destination_ref)
+    {
+        hdma::medium_priority_publish(_tables[_back_index][0], Elements, destination_ref);
+        _select_back(hdma::medium_priority_displayed_source());
+    }
+
+    /**
+     * @brief Publishes the back table with bn::hdma::high_priority_publish and selects a new back table.
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    void high_priority_publish(uint16_t& destination_ref)
+    {
+        hdma::high_priority_publish(_tables[_back_index][0], Elements, destination_ref);
+        _select_back(hdma::high_priority_displayed_source());
+    }
+
+private:
+    alignas(int) uint16_t _tables[3][table_size()];
+    int _back_index = 0;
+
+    void _select_back(const uint16_t* displayed_source)
+    {
+        // The new back table is neither the published one nor the displayed one.
+        // If the V-Blank swap happens after reading the displayed source, the published table becomes displayed
+        // and the previous displayed table is free too:
+        int published_index = _back_index;
+
+        for(int index = 0; index < 3; ++index)
+        {
+            if(index != published_index && _tables[index] != displayed_source)
+            {
+                _back_index = index;
+                return;
+            }
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_INPLACE_FUNCTION_H
+#define BN_INPLACE_FUNCTION_H
+
+/**
+ * @file
+ * bn::inplace_function implementation header file.
+ *
+ * @ingroup functional
+ */
+
+#include <new>
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_type_traits.h"
+#include "bn_inplace_function_fwd.h"
+
+namespace bn
+{
+
+template<typename Result, typename... Args, int MaxSize>
+class inplace_function<Result(Args...), MaxSize>
+{
+    static_assert(MaxSize >= int(sizeof(void*)));
+
+public:
+    using result_type = Result; //!< Result type alias.
+
+    /**
+     * @brief Default constructor.
+     *
+     * It creates an empty inplace_function.
+     */
+    inplace_function() = default;
+
+    /**
+     * @brief Constructor.
+     *
+     * It creates an empty inplace_function.
+     */
+    inplace_function(decltype(nullptr))
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param callable Function, function object or lambda to store.
+     *
+     * It must fit in MaxSize bytes and it must be copy constructible.
+     */
+    template<typename Callable>
+    requires(! is_same_v<decay_t<Callable>, inplace_function>)
+    inplace_function(Callable&& callable)
+    {
+        _create(forward<Callable>(callable));
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other inplace_function to copy.
+     */
+    inplace_function(const inplace_function& other) :
+        _ops(other._ops)
+    {
+        if(_ops)
+        {
+            _ops->copy(other._storage, _storage);
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other inplace_function to move.
+     *
+     * The other inplace_function is left empty.
+     */
+    inplace_function(inplace_function&& other) noexcept :
+        _ops(other._ops)
+    {
+        if(_ops)
+        {
+            _ops->relocate(other._storage, _storage);
+            other._ops = nullptr;
+        }
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other inplace_function to copy.
+     * @return Reference to this.
+     */
+    inplace_function& operator=(const inplace_function& other)
+    {
+        if(this != &other)
+        {
+            reset();
+
+            if(other._ops)
+            {
+                other._ops->copy(other._storage, _storage);
+                _ops = other._ops;
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other inplace_function to move.
+     * @return Reference to this.
+     *
+     * The other inplace_function is left empty.
+     */
+    inplace_function& operator=(inplace_function&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+
+            if(other._ops)
+            {
+                other._ops->relocate(other._storage, _storage);
+                _ops = other._ops;
+                other._ops = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Assignment operator.
+     * @param callable Function, function object or lambda to store.
+     * @return Reference to this.
+     *
+     * It must fit in MaxSize bytes and it must be copy constructible.
+     */
+    template<typename Callable>
+    requires(! is_same_v<decay_t<Callable>, inplace_function>)
+    inplace_function& operator=(Callable&& callable)
+    {
+        reset();
+        _create(forward<Callable>(callable));
+        return *this;
+    }
+
+    /**
+     * @brief Assignment operator.
+     * @return Reference to this.
+     *
+     * It destroys the stored callable, if any.
+     */
+    inplace_function& operator=(decltype(nullptr))
+    {
+        reset();
+        return *this;
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~inplace_function() noexcept
+    {
+        reset();
+    }
+
+    /**
+     * @brief Returns the maximum size in bytes of the stored callable.
+     */
+    [[nodiscard]] static constexpr int max_size()
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Indicates if it stores a callable or not.
+     */
+    [[nodiscard]] explicit operator bool() const
+    {
+        return _ops;
+    }
+
+    /**
+     * @brief Calls the stored callable, which must exist.
+     * @param args Parameters of the call.
+     * @return The stored callable result.
+     */
+    Result operator()(Args... args) const
+    {
+        BN_ASSERT(_ops, "Function is empty");
+
+        return _ops->invoke(const_cast<char*>(_storage), forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys the stored callable, if any.
+     */
+    void reset()
+    {
+        if(const ops_type* ops = _ops)
+        {
+            _ops = nullptr;
+            ops->destroy(_storage);
+        }
+    }
+
+    /**
+     * @brief Exchanges the contents of this inplace_function with those of the other one.
+     * @param other inplace_function to exchange the contents with.
+     */
+    void swap(inplace_function& other)
+    {
+        inplace_function temp(move(other));
+        other = move(*this);
+        *this = move(temp);
+    }
+
+    /**
+     * @brief Exchanges the contents of an inplace_function with those of another one.
+     * @param a First inplace_function to exchange the contents with.
+     * @param b Second inplace_function to exchange the contents with.
+     */
+    friend void swap(inplace_function& a, inplace_function& b)
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param function inplace_function to compare.
+     * @return `true` if the given inplace_function is empty, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const inplace_function& function, decltype(nullptr))
+    {
+        return ! function._ops;
+    }
+
+private:
+    class ops_type
+    {
+
+    public:
+        Result (*invoke)(char* storage, Args&&... args);
+        void (*copy)(const char* source, char* destination);
+        void (*relocate)(char* source, char* destination);
+        void (*destroy)(char* storage);
+    };
+
+    template<typename Callable>
+    class callable_ops
+    {
+
+    public:
+        [[nodiscard]] static Callable& get(char* storage)
+        {
+            return *reinterpret_cast<Callable*>(storage);
+        }
+
+        static Result invoke(char* storage, Args&&... args)
+        {
+            return get(storage)(forward<Args>(args)...);
+        }
+
+        static void copy(const char* source, char* destination)
+        {
+            ::new(destination) Callable(get(const_cast<char*>(source)));
+        }
+
+        static void relocate(char* source, char* destination)
+        {
+            Callable& source_callable = get(source);
+            ::new(destination) Callable(move(source_callable));
+            source_callable.~Callable();
+        }
+
+        static void destroy(char* storage)
+        {
+            get(storage).~Callable();
+        }
+
+        static constexpr ops_type ops = { invoke, copy, relocate, destroy };
+    };
+
+    alignas(void*) char _storage[MaxSize];
+    const ops_type* _ops = nullptr;
+
+    template<typename Callable>
+    void _create(Callable&& callable)
+    {
+        using callable_type = decay_t<Callable>;
+        static_assert(sizeof(callable_type) <= unsigned(MaxSize), "Callable is too big");
+        static_assert(alignof(callable_type) <= alignof(void*), "Callable alignment is too big");
+
+        ::new(_storage) callable_type(forward<Callable>(callable));
+        _ops = &callable_ops<callable_type>::ops;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_INPLACE_FUNCTION_FWD_H
+#define BN_INPLACE_FUNCTION_FWD_H
+
+/**
+ * @file
+ * bn::inplace_function declaration header file.
+ *
+ * @ingroup functional
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    /**
+     * @brief `std::function` like callable wrapper which stores the target in a fixed size buffer,
+     * so it never allocates memory.
+     *
+     * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
+     *
+     * @tparam Signature Function signature, like `void(int)`.
+     * @tparam MaxSize Maximum size in bytes of the stored callable.
+     *
+     * @ingroup functional
+     */
+    template<typename Signature, int MaxSize = 16>
+    class inplace_function;
+}
+
+#endif
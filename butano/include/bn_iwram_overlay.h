@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_IWRAM_OVERLAY_H
+#define BN_IWRAM_OVERLAY_H
+
+/**
+ * @file
+ * bn::iwram_overlay header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_optional.h"
+
+/**
+ * @brief IWRAM overlays related functions.
+ *
+ * IWRAM overlays are code and data sections linked at the same IWRAM address but stored separately in ROM,
+ * so each one can use all the IWRAM left by the code and data which is always loaded.
+ *
+ * Code and data are placed in an overlay with the `BN_CODE_IWRAM_OVERLAY(id)` and `BN_DATA_IWRAM_OVERLAY(id)`
+ * macros, and only the last loaded overlay can be called or accessed:
+ *
+ * @code{.cpp}
+ * BN_CODE_IWRAM_OVERLAY(0) void race_update(race_data& data);
+ *
+ * bn::iwram_overlay::load(0);
+ * race_update(data);
+ * @endcode
+ *
+ * @ingroup memory
+ */
+namespace bn::iwram_overlay
+{
+    /**
+     * @brief Returns the number of available IWRAM overlays.
+     */
+    [[nodiscard]] int count();
+
+    /**
+     * @brief Returns the size in bytes of the given IWRAM overlay.
+     * @param id IWRAM overlay index ([0..count())).
+     */
+    [[nodiscard]] int size(int id);
+
+    /**
+     * @brief Returns the index of the last loaded IWRAM overlay, if any.
+     */
+    [[nodiscard]] optional<int> loaded_id();
+
+    /**
+     * @brief Copies the given IWRAM overlay from ROM to IWRAM, replacing the previous loaded one.
+     * @param id IWRAM overlay index ([0..count())).
+     *
+     * If the given overlay is already loaded, it is not copied again.
+     *
+     * The code of the previous loaded overlay can't be running when this function is called.
+     */
+    void load(int id);
+
+    /**
+     * @brief Copies the given IWRAM overlay from ROM to IWRAM, replacing the previous loaded one,
+     * even if it was already loaded (for example, to restore its initial data).
+     * @param id IWRAM overlay index ([0..count())).
+     *
+     * The code of the previous loaded overlay can't be running when this function is called.
+     */
+    void reload(int id);
+}
+
+#endif
@@ -13,11 +13,14 @@
  * @ingroup link
  */
 
+#include "bn_span_fwd.h"
 #include "bn_optional_fwd.h"
 
 namespace bn
 {
+    class link_stats;
     class link_state;
+    class link_packet;
 }
 
 /**
@@ -43,10 +46,52 @@ namespace bn::link
      */
     [[nodiscard]] optional<link_state> receive();
 
+    /**
+     * @brief Sends a packet to the other players.
+     *
+     * Packet words are queued and sent by the link interrupt handlers,
+     * so a whole packet can be sent without blocking the main thread.
+     *
+     * Keep in mind that the packet can be lost before being received by other players,
+     * and that packets must not be mixed with the messages sent with send(int).
+     *
+     * To sync state every frame, set BN_CFG_LINK_BAUD_RATE to BN_LINK_BAUD_RATE_115200_BPS
+     * and decrease BN_CFG_LINK_SEND_WAIT.
+     *
+     * @param packet Words to send, in the range [0..65532].
+     * Its size must be in the range [1..BN_CFG_LINK_MAX_PACKET_SIZE].
+     * @return `true` if the packet has been queued, or `false` if there's not enough space for it
+     * in the outgoing messages queue.
+     */
+    bool send(const span<const uint16_t>& packet);
+
+    /**
+     * @brief Returns the next completed packet sent by other players, if any.
+     *
+     * Incomplete and corrupted packets are discarded.
+     *
+     * Packets and messages are read from the same queues,
+     * so this function must not be mixed with receive().
+     */
+    [[nodiscard]] optional<link_packet> receive_packet();
+
     /**
      * @brief Deactivates the communication with other players until send() or receive() are called.
      */
     void deactivate();
+
+    /**
+     * @brief Returns the counters of the link communication, to tune BN_CFG_LINK_BAUD_RATE
+     * and BN_CFG_LINK_SEND_WAIT from measured data.
+     *
+     * Round-trip time and clock offset between players can be measured with bn::link_clock_sync.
+     */
+    [[nodiscard]] link_stats stats();
+
+    /**
+     * @brief Sets to zero the counters of the link communication.
+     */
+    void reset_stats();
 }
 
 #endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_CLOCK_SYNC_H
+#define BN_LINK_CLOCK_SYNC_H
+
+/**
+ * @file
+ * bn::link_clock_sync header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_timer.h"
+#include "bn_optional.h"
+#include "bn_config_link.h"
+
+namespace bn
+{
+
+class link_packet;
+
+/**
+ * @brief Estimates the round trip time of link packets and the clock offset with other players.
+ *
+ * Each ping sent with send_ping() is answered by the other players with their local time,
+ * so the round trip time and the clock offset of each player can be estimated.
+ *
+ * The last 8 samples of each player are kept, and the clock offset of the sample with the lowest round trip time
+ * is reported, since it is the one less affected by queuing delays.
+ *
+ * The resolution of the estimates is limited by how often packets are received,
+ * which usually is once per frame.
+ *
+ * Since bn::link_lockstep reads all received packets, clock synchronization should be done before starting
+ * a lockstep session, for example to choose its input delay with latency_frames().
+ *
+ * @ingroup link
+ */
+class link_clock_sync
+{
+    static_assert(BN_CFG_LINK_MAX_PACKET_SIZE >= 3);
+
+public:
+    /**
+     * @brief Default constructor.
+     *
+     * It starts the local clock.
+     */
+    link_clock_sync();
+
+    /**
+     * @brief Returns the number of ticks elapsed since this object was built, in the range [0..(2^30) - 1].
+     */
+    [[nodiscard]] int local_ticks() const;
+
+    /**
+     * @brief Sends a ping to the other players.
+     * @return `true` if the ping could be sent, otherwise `false`.
+     */
+    bool send_ping();
+
+    /**
+     * @brief Receives all pending packets, answering pings and processing pongs.
+     *
+     * Packets not sent by bn::link_clock_sync objects are discarded.
+     */
+    void update();
+
+    /**
+     * @brief Answers the given packet if it is a ping, or updates the estimates if it is a pong.
+     *
+     * It allows to mix clock synchronization packets with other link packets.
+     *
+     * @param packet Received packet.
+     * @return `true` if the given packet was sent by a bn::link_clock_sync object, otherwise `false`.
+     */
+    bool read_packet(const link_packet& packet);
+
+    /**
+     * @brief Returns the number of samples stored for the specified player.
+     * @param player_id Player ID, in the range [0..3].
+     */
+    [[nodiscard]] int samples_count(int player_id) const;
+
+    /**
+     * @brief Returns the lowest stored round trip time with the specified player in ticks,
+     * or `bn::nullopt` if no samples have been stored.
+     * @param player_id Player ID, in the range [0..3].
+     */
+    [[nodiscard]] optional<int> rtt_ticks(int player_id) const;
+
+    /**
+     * @brief Returns the estimated number of ticks that the clock of the specified player is ahead of the local one,
+     * or `bn::nullopt` if no samples have been stored.
+     * @param player_id Player ID, in the range [0..3].
+     */
+    [[nodiscard]] optional<int> offset_ticks(int player_id) const;
+
+    /**
+     * @brief Returns the estimated local time of the specified player (local_ticks() + offset_ticks()),
+     * or `bn::nullopt` if no samples have been stored.
+     * @param player_id Player ID, in the range [0..3].
+     */
+    [[nodiscard]] optional<int> remote_ticks(int player_id) const;
+
+    /**
+     * @brief Returns the number of frames that the half of the highest round trip time with other players lasts,
+     * rounded up, or `bn::nullopt` if no samples have been stored.
+     *
+     * It can be used as the input delay of a bn::link_lockstep session.
+     */
+    [[nodiscard]] optional<int> latency_frames() const;
+
+    /**
+     * @brief Removes all stored samples.
+     */
+    void reset();
+
+private:
+    class sample
+    {
+
+    public:
+        int rtt;
+        int offset;
+    };
+
+    class player_samples
+    {
+
+    public:
+        sample samples[8];
+        int8_t count = 0;
+        int8_t next = 0;
+        int8_t best = 0;
+    };
+
+    class ping
+    {
+
+    public:
+        int ticks = 0;
+        int seq = -1;
+    };
+
+    timer _timer;
+    player_samples _players[4];
+    ping _pings[16];
+    int _ping_seq = 0;
+
+    void _add_sample(int player_id, int rtt, int offset);
+};
+
+}
+
+#endif
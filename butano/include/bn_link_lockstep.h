@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_LOCKSTEP_H
+#define BN_LINK_LOCKSTEP_H
+
+/**
+ * @file
+ * bn::link_lockstep header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_span.h"
+#include "bn_optional.h"
+#include "bn_config_link.h"
+#include "bn_power_of_two.h"
+
+namespace bn
+{
+
+class link_packet;
+
+/**
+ * @brief Deterministic lockstep layer built on top of link packets.
+ *
+ * Each player sends only its input of each frame, and the game is updated only when the inputs of all players
+ * for the next frame have been received.
+ *
+ * Input packets include the input of the previous frame, so a single lost packet doesn't stall the game.
+ *
+ * State snapshots can be sent too, compressed as the differences with the last sent snapshot,
+ * so players can be resynced when needed.
+ *
+ * Packets sent with this class must not be mixed with other link packets or messages.
+ *
+ * @ingroup link
+ */
+class link_lockstep
+{
+    static_assert(power_of_two(BN_CFG_LINK_LOCKSTEP_MAX_FRAMES));
+    static_assert(BN_CFG_LINK_MAX_PACKET_SIZE >= 3);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param players_count Number of players of the session, in the range [2..4].
+     * @param input_delay Number of frames that local inputs are delayed to hide link latency.
+     * It must be in the range [0..(BN_CFG_LINK_LOCKSTEP_MAX_FRAMES / 2) - 1].
+     */
+    link_lockstep(int players_count, int input_delay);
+
+    /**
+     * @brief Returns the number of players of the session.
+     */
+    [[nodiscard]] int players_count() const
+    {
+        return _players_count;
+    }
+
+    /**
+     * @brief Returns the number of frames that local inputs are delayed to hide link latency.
+     */
+    [[nodiscard]] int input_delay() const
+    {
+        return _input_delay;
+    }
+
+    /**
+     * @brief Returns the number of frames advanced with advance().
+     */
+    [[nodiscard]] int frame() const
+    {
+        return _frame;
+    }
+
+    /**
+     * @brief Sends the local input and receives the packets sent by other players.
+     *
+     * It must be called once per frame.
+     *
+     * @param local_input Input of this player, in the range [0..65532].
+     */
+    void update(int local_input);
+
+    /**
+     * @brief Advances to the next frame if the inputs of all players for it have been received.
+     * @return `true` if the frame has been advanced, otherwise `false`.
+     */
+    bool advance();
+
+    /**
+     * @brief Returns the input of the specified player for the last advanced frame.
+     * @param player_id Player ID, in the range [0..players_count() - 1].
+     */
+    [[nodiscard]] int input(int player_id) const;
+
+    /**
+     * @brief Returns the input of the specified player for the specified frame,
+     * or `bn::nullopt` if it is not stored in the input history.
+     *
+     * It allows to replay previous frames when rolling back the game state.
+     *
+     * @param frame Frame number.
+     * @param player_id Player ID, in the range [0..players_count() - 1].
+     */
+    [[nodiscard]] optional<int> history_input(int frame, int player_id) const;
+
+    /**
+     * @brief Returns the number of frames by which the slowest remote player is behind this player.
+     */
+    [[nodiscard]] int latency() const;
+
+    /**
+     * @brief Returns the number of frames of other players whose input packets have not been received.
+     */
+    [[nodiscard]] int lost_packets() const
+    {
+        return _lost_packets;
+    }
+
+    /**
+     * @brief Returns the number of advance() calls that couldn't advance to the next frame.
+     */
+    [[nodiscard]] int stalled_frames() const
+    {
+        return _stalled_frames;
+    }
+
+    /**
+     * @brief Sets the buffer which stores the snapshots sent by other players.
+     *
+     * The snapshot differences received in update() are applied to this buffer.
+     */
+    void set_remote_snapshot(span<uint16_t> remote_snapshot)
+    {
+        _remote_snapshot = remote_snapshot;
+    }
+
+    /**
+     * @brief Sends the words of the given snapshot which differ from the last sent snapshot.
+     * @param snapshot Current snapshot, with words in the range [0..65532] and at most 16384 words.
+     * @param sent_snapshot Last sent snapshot. Sent words are copied to it,
+     * so the remaining differences can be sent later if the outgoing messages queue is full.
+     * @return Number of sent packets.
+     */
+    int send_snapshot(const span<const uint16_t>& snapshot, span<uint16_t> sent_snapshot);
+
+    /**
+     * @brief Restarts the session from the first frame, clearing the input history and the counters.
+     */
+    void reset();
+
+private:
+    class history_entry
+    {
+
+    public:
+        int frame = -1;
+        uint16_t inputs[4] = {};
+        uint8_t received_players = 0;
+    };
+
+    history_entry _history[BN_CFG_LINK_LOCKSTEP_MAX_FRAMES];
+    int _last_remote_frames[4];
+    span<uint16_t> _remote_snapshot;
+    int _players_count;
+    int _input_delay;
+    int _frame = 0;
+    int _local_frame = 0;
+    int _lost_packets = 0;
+    int _stalled_frames = 0;
+
+    void _store_input(int frame, int player_id, int input);
+
+    void _read_packet(const link_packet& packet);
+};
+
+}
+
+#endif
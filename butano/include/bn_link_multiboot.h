@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_MULTIBOOT_H
+#define BN_LINK_MULTIBOOT_H
+
+/**
+ * @file
+ * bn::link_multiboot header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_span_fwd.h"
+#include "bn_link_multiboot_result.h"
+
+/**
+ * @brief Multiboot related functions.
+ *
+ * Multiboot allows to boot a GBA without a cart with an image sent through a link cable,
+ * so local multiplayer doesn't need every player to own a cart.
+ *
+ * Images are sent in normal mode at 256 kbps, so only one client is supported.
+ *
+ * Multiboot images can be built with the `multiboot` make target, which generates a `<TARGET>_mb.gba` file
+ * with the code and data linked in EWRAM, and a `<TARGET>_mb_lz.gba` file with the same image
+ * LZ77 compressed and a small stub which decompresses it when the client boots.
+ * Compressed images are usually much smaller, so they are transferred much faster.
+ *
+ * To send an image, rename it with the `.bin` extension and add it to a data folder of the server project:
+ *
+ * @code{.cpp}
+ * #include "client_mb_lz_bin.h"
+ *
+ * bn::span<const uint8_t> client_image(client_mb_lz_bin, client_mb_lz_bin_size);
+ * bn::link_multiboot_result result = bn::link_multiboot::send(client_image);
+ * @endcode
+ *
+ * @ingroup link
+ */
+namespace bn::link_multiboot
+{
+    /**
+     * @brief Returns the minimum size in bytes of a multiboot image.
+     */
+    [[nodiscard]] constexpr int min_image_size()
+    {
+        return 0x100;
+    }
+
+    /**
+     * @brief Returns the maximum size in bytes of a multiboot image.
+     */
+    [[nodiscard]] constexpr int max_image_size()
+    {
+        return 0x40000;
+    }
+
+    /**
+     * @brief Sends a multiboot image to a GBA without a cart connected with a link cable.
+     *
+     * It blocks until the image has been sent or the transfer has failed,
+     * and the link communication is deactivated before starting it (see bn::link::deactivate).
+     *
+     * @param image Multiboot image to send.
+     * Its size must be a multiple of 16 in the range [min_image_size(), max_image_size()].
+     * @param timeout_frames Number of frames to wait for a client before giving up (it must be > 0).
+     * @return Result of the transfer.
+     */
+    [[nodiscard]] link_multiboot_result send(const span<const uint8_t>& image, int timeout_frames = 300);
+}
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_MULTIBOOT_RESULT_H
+#define BN_LINK_MULTIBOOT_RESULT_H
+
+/**
+ * @file
+ * bn::link_multiboot_result header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Specifies the available results of a multiboot transfer.
+ *
+ * @ingroup link
+ */
+enum class link_multiboot_result : uint8_t
+{
+    SUCCESS, //!< The client has received the image and it is booting it.
+    NO_CLIENT, //!< No client has answered before the timeout.
+    FAILURE //!< The client has stopped answering or it has rejected the image.
+};
+
+}
+
+#endif
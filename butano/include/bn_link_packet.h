@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_PACKET_H
+#define BN_LINK_PACKET_H
+
+/**
+ * @file
+ * bn::link_packet header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_config_link.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the words of a packet provided by a player.
+ *
+ * @ingroup link
+ */
+class link_packet
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param player_id ID of the player who sent the packet, in the range [0..3].
+     * @param words Words of the packet, in the range [0..65532].
+     */
+    link_packet(int player_id, const span<const uint16_t>& words) :
+        _player_id(player_id)
+    {
+        BN_ASSERT(player_id >= 0 && player_id <= 3, "Invalid player id: ", player_id);
+        BN_ASSERT(! words.empty(), "Packet is empty");
+
+        for(uint16_t word : words)
+        {
+            _words.push_back(word);
+        }
+    }
+
+    /**
+     * @brief Returns the ID of the player who sent the packet.
+     */
+    [[nodiscard]] int player_id() const
+    {
+        return _player_id;
+    }
+
+    /**
+     * @brief Returns the words of the packet.
+     */
+    [[nodiscard]] span<const uint16_t> words() const
+    {
+        return span<const uint16_t>(_words.data(), _words.size());
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] friend bool operator==(const link_packet& a, const link_packet& b) = default;
+
+private:
+    vector<uint16_t, BN_CFG_LINK_MAX_PACKET_SIZE> _words;
+    int _player_id;
+};
+
+}
+
+#endif
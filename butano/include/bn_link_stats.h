@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_STATS_H
+#define BN_LINK_STATS_H
+
+/**
+ * @file
+ * bn::link_stats header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Counters of the link communication since it was activated for the first time
+ * or since bn::link::reset_stats was called.
+ *
+ * Packets are sent as multiple words (see bn::link::send).
+ *
+ * @ingroup link
+ */
+class link_stats
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param sent_words Number of words transferred to other players.
+     * @param received_words Number of words received from other players.
+     * @param dropped_sent_words Number of words discarded because the outgoing messages queue was full.
+     * @param dropped_received_words Number of words discarded because an incoming messages queue was full.
+     * @param resets Number of times the connection has been reset after a timeout or an error.
+     */
+    constexpr link_stats(int sent_words, int received_words, int dropped_sent_words, int dropped_received_words,
+                         int resets) :
+        _sent_words(sent_words),
+        _received_words(received_words),
+        _dropped_sent_words(dropped_sent_words),
+        _dropped_received_words(dropped_received_words),
+        _resets(resets)
+    {
+    }
+
+    /**
+     * @brief Returns the number of words transferred to other players.
+     */
+    [[nodiscard]] constexpr int sent_words() const
+    {
+        return _sent_words;
+    }
+
+    /**
+     * @brief Returns the number of words received from other players.
+     */
+    [[nodiscard]] constexpr int received_words() const
+    {
+        return _received_words;
+    }
+
+    /**
+     * @brief Returns the number of words discarded because the outgoing messages queue was full
+     * (including the ones of the packets which didn't fit in it).
+     *
+     * If it grows, messages are being sent faster than the link can transfer them:
+     * increase BN_CFG_LINK_BAUD_RATE or decrease BN_CFG_LINK_SEND_WAIT.
+     */
+    [[nodiscard]] constexpr int dropped_sent_words() const
+    {
+        return _dropped_sent_words;
+    }
+
+    /**
+     * @brief Returns the number of words discarded because an incoming messages queue was full.
+     *
+     * If it grows, messages are not being read fast enough.
+     */
+    [[nodiscard]] constexpr int dropped_received_words() const
+    {
+        return _dropped_received_words;
+    }
+
+    /**
+     * @brief Returns the number of times the connection has been reset after a timeout or an error.
+     *
+     * Messages queued when a reset happens are lost.
+     */
+    [[nodiscard]] constexpr int resets() const
+    {
+        return _resets;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const link_stats& a, const link_stats& b) = default;
+
+private:
+    int _sent_words;
+    int _received_words;
+    int _dropped_sent_words;
+    int _dropped_received_words;
+    int _resets;
+};
+
+}
+
+#endif
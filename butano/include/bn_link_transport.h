@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LINK_TRANSPORT_H
+#define BN_LINK_TRANSPORT_H
+
+/**
+ * @file
+ * Available link communication transports header file.
+ *
+ * @ingroup link
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_LINK_TRANSPORT_CABLE
+ *
+ * Link cable in multi-player mode.
+ *
+ * @ingroup link
+ */
+#define BN_LINK_TRANSPORT_CABLE     0
+
+/**
+ * @def BN_LINK_TRANSPORT_WIRELESS
+ *
+ * Wireless adapter.
+ *
+ * @ingroup link
+ */
+#define BN_LINK_TRANSPORT_WIRELESS  1
+
+#endif
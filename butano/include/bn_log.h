@@ -43,6 +43,30 @@
  * @ingroup log
  */
 
+/**
+ * @def BN_LOG_LEVEL(level, subsystem, ...)
+ *
+ * Prints in one line of text the representation of the given parameters
+ * if the given log level and subsystem are enabled.
+ *
+ * Sites with a level greater than the threshold of their subsystem
+ * (specified by BN_CFG_LOG_LEVEL and BN_CFG_LOG_SUBSYSTEM_LEVELS) are not compiled.
+ *
+ * The compiled ones can be enabled or disabled at runtime with bn::set_log_subsystems_mask.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * constexpr int link_subsystem = 3;
+ * BN_LOG_LEVEL(BN_LOG_LEVEL_WARN, link_subsystem, "Link timeout: ", frames);
+ * @endcode
+ *
+ * @param level Log level of the message (one of the BN_LOG_LEVEL_* macros except BN_LOG_LEVEL_NONE).
+ * @param subsystem Constant expression in the range [0..31] which identifies the subsystem of the message.
+ *
+ * @ingroup log
+ */
+
 #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
     #include "bn_sstream.h"
     #include "bn_istring_base.h"
@@ -57,6 +81,40 @@
             bn::log(_bn_istring); \
         } while(false)
 
+    #define BN_LOG_LEVEL(level, subsystem, ...) \
+        do \
+        { \
+            if constexpr(_bn::log_level::enabled<(level), (subsystem)>()) \
+            { \
+                if(_bn::log_level::subsystems_mask & (1u << (subsystem))) \
+                { \
+                    BN_LOG(__VA_ARGS__); \
+                } \
+            } \
+        } while(false)
+
+    /// @cond DO_NOT_DOCUMENT
+
+    namespace _bn::log_level
+    {
+        constexpr int levels[] = { BN_CFG_LOG_LEVEL, BN_CFG_LOG_SUBSYSTEM_LEVELS };
+
+        extern unsigned subsystems_mask;
+
+        template<int Level, int Subsystem>
+        [[nodiscard]] constexpr bool enabled()
+        {
+            static_assert(Level >= BN_LOG_LEVEL_FATAL && Level <= BN_LOG_LEVEL_DEBUG, "Invalid level");
+            static_assert(Subsystem >= 0 && Subsystem < 32, "Invalid subsystem");
+
+            constexpr int levels_count = int(sizeof(levels) / sizeof(int));
+            constexpr int subsystem_index = Subsystem + 1;
+            return Level <= (subsystem_index < levels_count ? levels[subsystem_index] : levels[0]);
+        }
+    }
+
+    /// @endcond
+
     namespace bn
     {
         /**
@@ -65,12 +123,41 @@
          * @ingroup log
          */
         void log(const istring_base& message);
+
+        /**
+         * @brief Returns a mask which indicates the subsystems for which compiled BN_LOG_LEVEL sites are enabled.
+         *
+         * Bit N of the mask corresponds to subsystem N.
+         *
+         * @ingroup log
+         */
+        [[nodiscard]] inline unsigned log_subsystems_mask()
+        {
+            return _bn::log_level::subsystems_mask;
+        }
+
+        /**
+         * @brief Sets a mask which indicates the subsystems for which compiled BN_LOG_LEVEL sites are enabled.
+         *
+         * Bit N of the mask corresponds to subsystem N.
+         *
+         * @ingroup log
+         */
+        inline void set_log_subsystems_mask(unsigned mask)
+        {
+            _bn::log_level::subsystems_mask = mask;
+        }
     }
 #else
     #define BN_LOG(...) \
         do \
         { \
         } while(false)
+
+    #define BN_LOG_LEVEL(level, subsystem, ...) \
+        do \
+        { \
+        } while(false)
 #endif
 
 #endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LOG_DEFERRED_H
+#define BN_LOG_DEFERRED_H
+
+/**
+ * @file
+ * BN_LOG_DEFERRED header file.
+ *
+ * @ingroup log
+ */
+
+#include "bn_config_log.h"
+#include "bn_config_doxygen.h"
+
+/**
+ * @def BN_LOG_DEFERRED(...)
+ *
+ * Stores the given parameters in a buffer without formatting them,
+ * so they can be printed in one line of text later with BN_LOG_DEFERRED_FLUSH().
+ *
+ * It is much cheaper than BN_LOG, so it can be called in hot paths without ruining timings.
+ *
+ * Parameters must be trivially copyable. Pointers (like string literals) are stored instead of the pointed data,
+ * so they should outlive the next BN_LOG_DEFERRED_FLUSH() call to avoid dangling references.
+ *
+ * If the buffer is full, the parameters are discarded
+ * and the number of discarded lines is printed by the next BN_LOG_DEFERRED_FLUSH() call.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * BN_LOG_DEFERRED("Enemy position: ", enemy_x, " - ", enemy_y);
+ * @endcode
+ *
+ * Custom parameter types are supported by overloading bn::ostringstream::operator<<.
+ *
+ * @ingroup log
+ */
+
+/**
+ * @def BN_LOG_DEFERRED_FLUSH()
+ *
+ * Prints the parameters stored with BN_LOG_DEFERRED and clears the buffer,
+ * so it should be called outside hot paths.
+ *
+ * @ingroup log
+ */
+
+#if BN_CFG_LOG_ENABLED || BN_DOXYGEN
+    #include "bn_sstream.h"
+    #include "bn_type_traits.h"
+
+    #define BN_LOG_DEFERRED(...) \
+        do \
+        { \
+            _bn::log_deferred::push(__VA_ARGS__); \
+        } while(false)
+
+    #define BN_LOG_DEFERRED_FLUSH() \
+        do \
+        { \
+            _bn::log_deferred::flush(); \
+        } while(false)
+
+    /// @cond DO_NOT_DOCUMENT
+
+    namespace _bn::log_deferred
+    {
+        using formatter = const unsigned*(*)(const unsigned* data, bn::ostringstream& stream);
+
+        constexpr int formatter_words = (sizeof(formatter) + sizeof(unsigned) - 1) / sizeof(unsigned);
+
+        template<typename Type>
+        [[nodiscard]] constexpr int arg_words()
+        {
+            return formatter_words + int((sizeof(Type) + sizeof(unsigned) - 1) / sizeof(unsigned));
+        }
+
+        template<typename Type>
+        const unsigned* format_arg(const unsigned* data, bn::ostringstream& stream)
+        {
+            alignas(Type) char value_storage[sizeof(Type)];
+            __builtin_memcpy(value_storage, data, sizeof(Type));
+            stream << *reinterpret_cast<const Type*>(value_storage);
+            return data + (arg_words<Type>() - formatter_words);
+        }
+
+        template<typename Type>
+        unsigned* write_arg(const Type& value, unsigned* data)
+        {
+            static_assert(bn::is_trivially_copyable_v<Type>, "Parameters must be trivially copyable");
+
+            formatter arg_formatter = &format_arg<Type>;
+            __builtin_memcpy(data, &arg_formatter, sizeof(formatter));
+            __builtin_memcpy(data + formatter_words, &value, sizeof(Type));
+            return data + arg_words<Type>();
+        }
+
+        [[nodiscard]] unsigned* alloc(int words);
+
+        void flush();
+
+        template<typename... Args>
+        void push(const Args&... args)
+        {
+            constexpr int words = 1 + (0 + ... + arg_words<bn::decay_t<Args>>());
+
+            if(unsigned* data = alloc(words))
+            {
+                *data = words;
+                ++data;
+                ((data = write_arg<bn::decay_t<Args>>(args, data)), ...);
+            }
+        }
+    }
+
+    /// @endcond
+#else
+    #define BN_LOG_DEFERRED(...) \
+        do \
+        { \
+        } while(false)
+
+    #define BN_LOG_DEFERRED_FLUSH() \
+        do \
+        { \
+        } while(false)
+#endif
+
+#endif
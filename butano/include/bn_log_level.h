@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_LOG_LEVEL_H
+#define BN_LOG_LEVEL_H
+
+/**
+ * @file
+ * Available log levels header file.
+ *
+ * @ingroup log
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_LOG_LEVEL_NONE
+ *
+ * Log level threshold which disables all log sites of a subsystem.
+ *
+ * @ingroup log
+ */
+#define BN_LOG_LEVEL_NONE     -1
+
+/**
+ * @def BN_LOG_LEVEL_FATAL
+ *
+ * Log level for unrecoverable errors.
+ *
+ * @ingroup log
+ */
+#define BN_LOG_LEVEL_FATAL    0
+
+/**
+ * @def BN_LOG_LEVEL_ERROR
+ *
+ * Log level for errors.
+ *
+ * @ingroup log
+ */
+#define BN_LOG_LEVEL_ERROR    1
+
+/**
+ * @def BN_LOG_LEVEL_WARN
+ *
+ * Log level for warnings.
+ *
+ * @ingroup log
+ */
+#define BN_LOG_LEVEL_WARN     2
+
+/**
+ * @def BN_LOG_LEVEL_INFO
+ *
+ * Log level for information messages.
+ *
+ * @ingroup log
+ */
+#define BN_LOG_LEVEL_INFO     3
+
+/**
+ * @def BN_LOG_LEVEL_DEBUG
+ *
+ * Log level for debug messages.
+ *
+ * @ingroup log
+ */
+#define BN_LOG_LEVEL_DEBUG    4
+
+#endif
@@ -13,9 +13,13 @@
  * @ingroup math
  */
 
+#include "bn_bit.h"
 #include "bn_array.h"
 #include "bn_fixed.h"
 #include "bn_sin_lut.h"
+#include "bn_span_fwd.h"
+#include "bn_atan2_lut.h"
+#include "bn_fixed_point.h"
 #include "bn_reciprocal_lut.h"
 #include "bn_rule_of_three_approximation.h"
 
@@ -31,6 +35,8 @@ namespace _bn
 
 namespace bn
 {
+    class affine_mat_attributes;
+
     /**
      * @brief Returns the absolute value of the given value.
      *
@@ -184,6 +190,51 @@ namespace bn
         }
     }
 
+    /**
+     * @brief Calculates the sine value of an angle using a LUT with linear interpolation.
+     *
+     * It is much faster than bn::sin and much more precise than bn::lut_sin.
+     *
+     * @param angle Angle (2π = 1).
+     * @return Sine value in the range [-1, 1].
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed interpolated_lut_sin(fixed_t<16> angle)
+    {
+        if(is_constant_evaluated())
+        {
+            return sin(angle);
+        }
+        else
+        {
+            constexpr int fraction_bits = 5;
+            static_assert((sin_lut_size - 1) << fraction_bits == 65536);
+
+            int lut_angle = angle.data() & 0xFFFF;
+            int lut_index = lut_angle >> fraction_bits;
+            int fraction = lut_angle & ((1 << fraction_bits) - 1);
+            int first_value = sin_lut._data[lut_index];
+            int second_value = sin_lut._data[lut_index + 1];
+            return fixed::from_data(first_value + (((second_value - first_value) * fraction) >> fraction_bits));
+        }
+    }
+
+    /**
+     * @brief Calculates the cosine value of an angle using a LUT with linear interpolation.
+     *
+     * It is much faster than bn::cos and much more precise than bn::lut_cos.
+     *
+     * @param angle Angle (2π = 1).
+     * @return Cosine value in the range [-1, 1].
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed interpolated_lut_cos(fixed_t<16> angle)
+    {
+        return interpolated_lut_sin(fixed_t<16>::from_data(angle.data() + 16384));
+    }
+
     /**
      * @brief Calculates the cosine value of an angle.
      * @param angle Angle (2π = 1).
@@ -374,6 +425,306 @@ namespace bn
             return reciprocal_lut._data[lut_value];
         }
     }
+
+    /**
+     * @brief Computes the arc tangent of y/x using the signs of arguments to determine the correct quadrant.
+     *
+     * It doesn't divide: the ratio of the arguments is calculated with bn::reciprocal_lut
+     * and the arc tangent is interpolated from bn::atan2_lut, so it is faster than bn::atan2.
+     *
+     * @param y Vertical value.
+     * @param x Horizontal value.
+     * @return Arc tangent of y/x in the range [-0.5, 0.5] (2π = 1).
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed_t<16> lut_atan2(int y, int x)
+    {
+        if(y == 0 && x == 0)
+        {
+            return 0;
+        }
+
+        unsigned abs_y = y < 0 ? 0u - unsigned(y) : unsigned(y);
+        unsigned abs_x = x < 0 ? 0u - unsigned(x) : unsigned(x);
+        bool steep = abs_y > abs_x;
+        unsigned numerator = steep ? abs_x : abs_y;
+        unsigned denominator = steep ? abs_y : abs_x;
+
+        // numerator / denominator in fixed_t<20> format, refined with the remainder to hide reciprocal LUT errors:
+        int ratio;
+
+        if(denominator < unsigned(reciprocal_lut_size))
+        {
+            int num = int(numerator);
+            int den = int(denominator);
+            int reciprocal = lut_reciprocal(den).data();
+            ratio = num * reciprocal;
+
+            int remainder = (num << 20) - (ratio * den);
+            ratio += (remainder * reciprocal) >> 20;
+        }
+        else
+        {
+            // Approximate the reciprocal with the denominator most significant bits:
+            int shift = bit_width(denominator) - 10;
+            int64_t num = numerator;
+            int64_t den = denominator;
+            int64_t reciprocal = lut_reciprocal(int(denominator >> shift)).data();
+            int64_t long_ratio = (num * reciprocal) >> shift;
+
+            int64_t remainder = (num << 20) - (long_ratio * den);
+            long_ratio += (remainder * reciprocal) >> (20 + shift);
+            ratio = int(long_ratio);
+        }
+
+        constexpr int fraction_bits = 20 - 8;
+        static_assert(atan2_lut_size - 1 == 1 << (20 - fraction_bits));
+
+        int result;
+
+        if(ratio >= 1 << 20)
+        {
+            result = 8192;
+        }
+        else
+        {
+            int lut_index = ratio >> fraction_bits;
+            int fraction = ratio & ((1 << fraction_bits) - 1);
+            int first_value;
+            int second_value;
+
+            if(is_constant_evaluated())
+            {
+                first_value = calculate_atan2_lut_value(lut_index);
+                second_value = calculate_atan2_lut_value(lut_index + 1);
+            }
+            else
+            {
+                first_value = atan2_lut._data[lut_index];
+                second_value = atan2_lut._data[lut_index + 1];
+            }
+
+            int rounding = 1 << (fraction_bits - 1);
+            result = first_value + ((((second_value - first_value) * fraction) + rounding) >> fraction_bits);
+        }
+
+        if(steep)
+        {
+            result = 16384 - result;
+        }
+
+        if(x < 0)
+        {
+            result = 32768 - result;
+        }
+
+        if(y < 0)
+        {
+            result = -result;
+        }
+
+        return fixed_t<16>::from_data(result);
+    }
+
+    /**
+     * @brief Computes the arc tangent of y/x using the signs of arguments to determine the correct quadrant.
+     *
+     * It doesn't divide: the ratio of the arguments is calculated with bn::reciprocal_lut
+     * and the arc tangent is interpolated from bn::atan2_lut, so it is faster than bn::degrees_atan2.
+     *
+     * @param y Vertical value.
+     * @param x Horizontal value.
+     * @return Arc tangent of y/x in degrees in the range [-180, 180].
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed degrees_lut_atan2(int y, int x)
+    {
+        return fixed::from_data((lut_atan2(y, x).data() * 360) / (1 << 4));
+    }
+
+    /**
+     * @brief Returns the exact length of the given vector.
+     *
+     * The squared length is accumulated with 64-bit precision, so it doesn't overflow with long vectors.
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed length(const fixed_point& value)
+    {
+        int64_t x = value.x().data();
+        int64_t y = value.y().data();
+        auto squared_length = uint64_t((x * x) + (y * y));
+        int shift = 0;
+
+        while(squared_length > uint64_t(numeric_limits<int>::max()))
+        {
+            squared_length >>= 2;
+            ++shift;
+        }
+
+        return fixed::from_data(sqrt(int(squared_length)) << shift);
+    }
+
+    /**
+     * @brief Returns an approximation of the length of the given vector.
+     *
+     * It uses the alpha max plus beta min algorithm, so it doesn't calculate any square root,
+     * but its error can be up to about 4%.
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed length_approx(const fixed_point& value)
+    {
+        int64_t x = bn::abs(value.x().data());
+        int64_t y = bn::abs(value.y().data());
+        int64_t max_value = x > y ? x : y;
+        int64_t min_value = x > y ? y : x;
+        return fixed::from_data(int(((max_value * 123) + (min_value * 51)) >> 7));
+    }
+
+    /**
+     * @brief Returns the given vector scaled to length 1.
+     *
+     * Both components are multiplied by the same reciprocal of the length,
+     * so only one square root and one division are done.
+     *
+     * @param value Vector to normalize.
+     * @return Normalized vector, or (0, 0) if the given vector has length 0.
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed_point normalize(const fixed_point& value)
+    {
+        int64_t x = value.x().data();
+        int64_t y = value.y().data();
+        auto squared_length = uint64_t((x * x) + (y * y));
+
+        if(! squared_length)
+        {
+            return fixed_point();
+        }
+
+        // The squared length is scaled to 29 or 30 bits, so the length and its reciprocal keep 15 bits of precision:
+        int shift = (int(bit_width(squared_length)) - 29) >> 1;
+
+        if(shift >= 0)
+        {
+            squared_length >>= shift * 2;
+        }
+        else
+        {
+            squared_length <<= -shift * 2;
+        }
+
+        int64_t reciprocal = 0x80000000u / unsigned(sqrt(int(squared_length)));
+        shift += 31 - fixed::precision();
+
+        return fixed_point(fixed::from_data(int((x * reciprocal) >> shift)),
+                           fixed::from_data(int((y * reciprocal) >> shift)));
+    }
+
+    /**
+     * @brief Returns the given vector scaled to an approximation of length 1.
+     *
+     * It doesn't calculate any square root nor division: the reciprocal of length_approx is retrieved
+     * from bn::reciprocal_lut and the result is refined with one Newton-Raphson step,
+     * so the error of the returned vector length is usually below 0.5%.
+     *
+     * @param value Vector to normalize.
+     * @return Normalized vector, or (0, 0) if the given vector has length 0.
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] constexpr fixed_point normalize_approx(const fixed_point& value)
+    {
+        unsigned length_data = unsigned(length_approx(value).data());
+
+        if(! length_data)
+        {
+            return fixed_point();
+        }
+
+        // The length is reduced to 10 bits, so it fits in the reciprocal LUT:
+        int shift = length_data > 0x3FF ? int(bit_width(length_data)) - 10 : 0;
+        int64_t reciprocal = lut_reciprocal(int(length_data >> shift)).data();
+        shift += 20 - fixed::precision();
+
+        auto x = int((value.x().data() * reciprocal) >> shift);
+        auto y = int((value.y().data() * reciprocal) >> shift);
+
+        // Newton-Raphson step for the inverse square root of the squared length of the approximation:
+        constexpr int one = fixed(1).data();
+        int squared_length = ((x * x) + (y * y)) >> fixed::precision();
+        int scale = ((3 * one) - squared_length) >> 1;
+
+        return fixed_point(fixed::from_data((x * scale) >> fixed::precision()),
+                           fixed::from_data((y * scale) >> fixed::precision()));
+    }
+
+    /**
+     * @brief Multiplies each one of the given points by the matrix of the given affine_mat_attributes.
+     *
+     * Each point (x, y) is replaced by (pa * x + pb * y, pc * x + pd * y),
+     * where pa, pb, pc and pd are the register values of the given affine_mat_attributes.
+     *
+     * Its code is placed in IWRAM and it is compiled in ARM mode,
+     * so it is much faster than transforming each point separately.
+     *
+     * @param points Points to transform.
+     * @param affine_mat_attributes Attributes of the transformation matrix.
+     *
+     * @ingroup math
+     */
+    BN_CODE_IWRAM void transform_points(span<fixed_point> points, const affine_mat_attributes& affine_mat_attributes);
+
+    /**
+     * @brief Adds to each one of the given points the point with the same index of the given deltas,
+     * multiplied by the given scale.
+     *
+     * Its code is placed in IWRAM and it is compiled in ARM mode,
+     * so it is much faster than updating each point separately.
+     *
+     * @param points Points to update.
+     * @param deltas Points to add (it must have the same size as points).
+     * @param scale Multiplier of the added points.
+     *
+     * @ingroup math
+     */
+    BN_CODE_IWRAM void add_scaled(span<fixed_point> points, span<const fixed_point> deltas, fixed scale);
+
+    /**
+     * @brief Moves each one of the given points toward the point with the same index of the given targets.
+     *
+     * Each point p is replaced by p + ((target - p) * weight).
+     *
+     * Its code is placed in IWRAM and it is compiled in ARM mode,
+     * so it is much faster than interpolating each point separately.
+     *
+     * @param points Points to update.
+     * @param targets Target points (it must have the same size as points).
+     * @param weight Interpolation weight, usually in the range [0, 1].
+     *
+     * @ingroup math
+     */
+    BN_CODE_IWRAM void lerp(span<fixed_point> points, span<const fixed_point> targets, fixed weight);
+
+    /**
+     * @brief Returns the dot product of the given vectors.
+     *
+     * Products are accumulated with 64-bit precision before being rounded down to fixed precision.
+     *
+     * Its code is placed in IWRAM and it is compiled in ARM mode,
+     * so it is much faster than accumulating each product separately.
+     *
+     * @param a First vector.
+     * @param b Second vector (it must have the same size as a).
+     * @return Sum of the products of the elements of a and b with the same index.
+     *
+     * @ingroup math
+     */
+    [[nodiscard]] BN_CODE_IWRAM fixed dot(span<const fixed> a, span<const fixed> b);
 }
 
 #endif
@@ -61,6 +61,8 @@ namespace bn::memory
      * On failure, returns `nullptr`.
      *
      * To avoid a memory leak, the returned pointer must be deallocated with bn::memory::ewram_free.
+     *
+     * If BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE is not 0, allocations up to 128 bytes are carved from shared pages.
      */
     [[nodiscard]] void* ewram_alloc(int bytes);
 
@@ -88,6 +90,8 @@ namespace bn::memory
      * On success, the original pointer ptr is invalidated and any access to it is undefined behavior
      * (even if reallocation was in-place).
      *
+     * Storage is shrunk in-place, and it is grown in-place if the storage after it is free and big enough.
+     *
      * To avoid a memory leak, the returned pointer must be deallocated with bn::memory::ewram_free.
      */
     [[nodiscard]] void* ewram_realloc(void* ptr, int new_bytes);
@@ -129,16 +133,104 @@ namespace bn::memory
      */
     [[nodiscard]] int available_items_ewram();
 
+    /**
+     * @brief Returns the size in bytes of the biggest storage that can be allocated in EWRAM
+     * with bn::memory::ewram_alloc, bn::memory::ewram_calloc and bn::memory::ewram_realloc.
+     */
+    [[nodiscard]] int largest_available_alloc_ewram();
+
+    /**
+     * @brief Returns the tag recorded with the EWRAM blocks allocated from now on,
+     * or `nullptr` if their caller address is recorded instead.
+     *
+     * It always returns `nullptr` if @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `false`.
+     */
+    [[nodiscard]] const char* ewram_alloc_tag();
+
+    /**
+     * @brief Sets the tag recorded with the EWRAM blocks allocated from now on.
+     * @param tag Null-terminated string with static storage duration,
+     * or `nullptr` to record the caller address of each block instead.
+     *
+     * It does nothing if @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `false`.
+     */
+    void set_ewram_alloc_tag(const char* tag);
+
+    /**
+     * @brief Returns the maximum bytes allocated in EWRAM at the same time since bn::core::init was called.
+     *
+     * It always returns 0 if @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `false`.
+     */
+    [[nodiscard]] int max_used_alloc_ewram();
+
+    /**
+     * @brief Returns the number of EWRAM allocations and reallocations of the last elapsed frame.
+     *
+     * It always returns 0 if @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `false`.
+     */
+    [[nodiscard]] int last_frame_allocs_ewram();
+
+    /**
+     * @brief Returns the maximum number of EWRAM allocations and reallocations in a single frame
+     * since bn::core::init was called.
+     *
+     * It always returns 0 if @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `false`.
+     */
+    [[nodiscard]] int max_frame_allocs_ewram();
+
+    /**
+     * @brief Prints with bn::log the EWRAM allocated bytes and items, and the biggest free block.
+     *
+     * If @ref BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED is `true`, it also prints peak usage, allocation counts
+     * and the size and tag (or caller address) of each live block.
+     *
+     * It does nothing if the log is disabled (see @ref BN_CFG_LOG_ENABLED).
+     */
+    void log_ewram_usage();
+
     /**
      * @brief Returns the IWRAM used by the stack in bytes.
      */
     [[nodiscard]] int used_stack_iwram();
 
+    /**
+     * @brief Returns the maximum IWRAM used by the stack in bytes since bn::core::init was called.
+     *
+     * The free IWRAM is painted with a known value by bn::core::init, so the stack peak is found
+     * by searching the lowest overwritten address. Since it is a linear search, it should not be called every frame.
+     *
+     * The returned value also includes the stack used before painting and a small safety margin.
+     *
+     * If @ref BN_CFG_MEMORY_STACK_PAINT_ENABLED is `false`, the current stack usage is returned.
+     */
+    [[nodiscard]] int max_used_stack_iwram();
+
     /**
      * @brief Returns the bytes of all static objects in IWRAM.
      */
     [[nodiscard]] int used_static_iwram();
 
+    /**
+     * @brief Returns the IWRAM bytes reserved for overlays (the size of the biggest one, see bn::iwram_overlay).
+     */
+    [[nodiscard]] int used_overlays_iwram();
+
+    /**
+     * @brief Returns the IWRAM bytes which have never been used since bn::core::init was called:
+     * the ones not used by static objects, overlays nor by the stack peak (see bn::memory::max_used_stack_iwram).
+     *
+     * It is a linear search, so it should not be called every frame.
+     */
+    [[nodiscard]] int unused_iwram();
+
+    /**
+     * @brief Prints with bn::log the IWRAM used by static objects, overlays and the stack (current and peak),
+     * and the IWRAM which has never been used.
+     *
+     * It does nothing if the log is disabled (see @ref BN_CFG_LOG_ENABLED).
+     */
+    void log_iwram_usage();
+
     /**
      * @brief Returns the bytes of all static objects in EWRAM.
      */
@@ -176,6 +268,46 @@ namespace bn::memory
         }
     }
 
+    /**
+     * @brief Copies a fixed amount of elements from the object referenced by source_ref
+     * to the object referenced by destination_ref.
+     *
+     * Small word aligned copies are unrolled inline (usually with ldm/stm instructions),
+     * so they don't pay the function call overhead of the generic copy.
+     *
+     * If the source and destination objects overlap, the behavior is undefined.
+     *
+     * @tparam Elements Number of elements to copy (not bytes).
+     * @param source_ref Const reference to the memory location to copy from.
+     * @param destination_ref Reference to the memory location to copy to.
+     */
+    template<int Elements, typename Type>
+    void copy(const Type& source_ref, Type& destination_ref)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(Elements >= 0, "Invalid elements");
+
+        constexpr unsigned bytes = unsigned(Elements) * sizeof(Type);
+        constexpr int max_inline_words = 16;
+
+        if constexpr(bytes && bytes % 4 == 0 && bytes / 4 <= max_inline_words)
+        {
+            if(aligned<4>(source_ref) && aligned<4>(destination_ref))
+            {
+                // Word aligned block copies are expanded inline by the compiler:
+                struct [[gnu::may_alias]] words_block
+                {
+                    unsigned words[bytes / 4];
+                };
+
+                *reinterpret_cast<words_block*>(&destination_ref) = *reinterpret_cast<const words_block*>(&source_ref);
+                return;
+            }
+        }
+
+        copy(source_ref, Elements, destination_ref);
+    }
+
     /**
      * @brief Clears (set to zero) the memory of the given amount of elements
      * from the object referenced by destination_ref.
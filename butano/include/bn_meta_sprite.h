@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_META_SPRITE_H
+#define BN_META_SPRITE_H
+
+/**
+ * @file
+ * bn::imeta_sprite and bn::meta_sprite implementation header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_meta_sprite_item.h"
+
+namespace bn
+{
+
+class camera_ptr;
+
+/**
+ * @brief Base class of bn::meta_sprite.
+ *
+ * A meta sprite shows an image bigger or with a more complex shape than a hardware sprite,
+ * covering it with the hardware sprites (pieces) of a meta_sprite_item which are moved as a unit.
+ *
+ * @ingroup sprite
+ */
+class imeta_sprite
+{
+
+public:
+    imeta_sprite(const imeta_sprite& other) = delete;
+
+    imeta_sprite& operator=(const imeta_sprite& other) = delete;
+
+    /**
+     * @brief Returns the meta_sprite_item used to create the pieces.
+     */
+    [[nodiscard]] const meta_sprite_item& item() const
+    {
+        return _item;
+    }
+
+    /**
+     * @brief Returns the hardware sprites of the pieces.
+     */
+    [[nodiscard]] span<const sprite_ptr> sprites() const
+    {
+        return span<const sprite_ptr>(_sprites.data(), _sprites.size());
+    }
+
+    /**
+     * @brief Returns the horizontal position of the center of the meta sprite.
+     */
+    [[nodiscard]] fixed x() const
+    {
+        return _position.x();
+    }
+
+    /**
+     * @brief Returns the vertical position of the center of the meta sprite.
+     */
+    [[nodiscard]] fixed y() const
+    {
+        return _position.y();
+    }
+
+    /**
+     * @brief Returns the position of the center of the meta sprite.
+     */
+    [[nodiscard]] const fixed_point& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the horizontal position of the center of the meta sprite.
+     */
+    void set_x(fixed x);
+
+    /**
+     * @brief Sets the vertical position of the center of the meta sprite.
+     */
+    void set_y(fixed y);
+
+    /**
+     * @brief Sets the position of the center of the meta sprite.
+     * @param x Horizontal position of the center of the meta sprite.
+     * @param y Vertical position of the center of the meta sprite.
+     */
+    void set_position(fixed x, fixed y);
+
+    /**
+     * @brief Sets the position of the center of the meta sprite.
+     */
+    void set_position(const fixed_point& position);
+
+    /**
+     * @brief Indicates if the meta sprite is flipped in the horizontal axis or not.
+     */
+    [[nodiscard]] bool horizontal_flip() const
+    {
+        return _horizontal_flip;
+    }
+
+    /**
+     * @brief Sets if the meta sprite must be flipped in the horizontal axis or not.
+     */
+    void set_horizontal_flip(bool horizontal_flip);
+
+    /**
+     * @brief Indicates if the meta sprite is flipped in the vertical axis or not.
+     */
+    [[nodiscard]] bool vertical_flip() const
+    {
+        return _vertical_flip;
+    }
+
+    /**
+     * @brief Sets if the meta sprite must be flipped in the vertical axis or not.
+     */
+    void set_vertical_flip(bool vertical_flip);
+
+    /**
+     * @brief Returns the priority of the pieces relative to backgrounds.
+     */
+    [[nodiscard]] int bg_priority() const
+    {
+        return _sprites.front().bg_priority();
+    }
+
+    /**
+     * @brief Sets the priority of the pieces relative to backgrounds.
+     * @param bg_priority Priority in the range [0..3].
+     */
+    void set_bg_priority(int bg_priority);
+
+    /**
+     * @brief Returns the priority of the pieces relative to other ones.
+     */
+    [[nodiscard]] int z_order() const
+    {
+        return _sprites.front().z_order();
+    }
+
+    /**
+     * @brief Sets the priority of the pieces relative to other ones.
+     * @param z_order Priority in the range [sprites::min_z_order()..sprites::max_z_order()].
+     */
+    void set_z_order(int z_order);
+
+    /**
+     * @brief Indicates if the meta sprite must be committed to the GBA or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _sprites.front().visible();
+    }
+
+    /**
+     * @brief Sets if the meta sprite must be committed to the GBA or not.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @brief Returns the camera_ptr attached to the pieces (if any).
+     */
+    [[nodiscard]] const optional<camera_ptr>& camera() const
+    {
+        return _sprites.front().camera();
+    }
+
+    /**
+     * @brief Sets the camera_ptr attached to the pieces.
+     */
+    void set_camera(const optional<camera_ptr>& camera);
+
+    /**
+     * @brief Removes the camera_ptr attached to the pieces (if any).
+     */
+    void remove_camera();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    imeta_sprite(const meta_sprite_item& item, const fixed_point& position, ivector<sprite_ptr>& sprites) :
+        _item(item),
+        _sprites(sprites),
+        _position(position)
+    {
+    }
+
+    void _create_sprites();
+
+    /// @endcond
+
+private:
+    meta_sprite_item _item;
+    ivector<sprite_ptr>& _sprites;
+    fixed_point _position;
+    bool _horizontal_flip = false;
+    bool _vertical_flip = false;
+
+    void _update_positions();
+};
+
+
+/**
+ * @brief Shows an image bigger or with a more complex shape than a hardware sprite,
+ * covering it with the hardware sprites (pieces) of a meta_sprite_item which are moved as a unit.
+ *
+ * @tparam MaxSprites Maximum number of pieces.
+ *
+ * @ingroup sprite
+ */
+template<int MaxSprites>
+class meta_sprite : public imeta_sprite
+{
+    static_assert(MaxSprites > 0);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item meta_sprite_item used to create the pieces.
+     * @param position Position of the center of the meta sprite.
+     */
+    explicit meta_sprite(const meta_sprite_item& item, const fixed_point& position = fixed_point()) :
+        imeta_sprite(item, position, _sprites_vector)
+    {
+        _create_sprites();
+    }
+
+private:
+    vector<sprite_ptr, MaxSprites> _sprites_vector;
+};
+
+}
+
+#endif
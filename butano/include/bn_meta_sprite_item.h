@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_META_SPRITE_ITEM_H
+#define BN_META_SPRITE_ITEM_H
+
+/**
+ * @file
+ * bn::meta_sprite_piece and bn::meta_sprite_item header file.
+ *
+ * @ingroup sprite
+ * @ingroup tool
+ */
+
+#include "bn_size.h"
+#include "bn_sprite_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Hardware sprite of a meta_sprite_item.
+ *
+ * @ingroup sprite
+ * @ingroup tool
+ */
+class meta_sprite_piece
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param x Horizontal position of the center of the piece relative to the center of the meta sprite.
+     * @param y Vertical position of the center of the piece relative to the center of the meta sprite.
+     * @param shape_size Shape and size of the piece.
+     * @param tiles_offset Index of the first tile of the piece in the tiles of the meta sprite.
+     */
+    constexpr meta_sprite_piece(int x, int y, const sprite_shape_size& shape_size, int tiles_offset) :
+        _shape_size(shape_size),
+        _x(int16_t(x)),
+        _y(int16_t(y)),
+        _tiles_offset(uint16_t(tiles_offset))
+    {
+        BN_ASSERT(tiles_offset >= 0 && tiles_offset < 65536, "Invalid tiles offset: ", tiles_offset);
+    }
+
+    /**
+     * @brief Returns the horizontal position of the center of the piece relative to the center of the meta sprite.
+     */
+    [[nodiscard]] constexpr int x() const
+    {
+        return _x;
+    }
+
+    /**
+     * @brief Returns the vertical position of the center of the piece relative to the center of the meta sprite.
+     */
+    [[nodiscard]] constexpr int y() const
+    {
+        return _y;
+    }
+
+    /**
+     * @brief Returns the shape and size of the piece.
+     */
+    [[nodiscard]] constexpr const sprite_shape_size& shape_size() const
+    {
+        return _shape_size;
+    }
+
+    /**
+     * @brief Returns the index of the first tile of the piece in the tiles of the meta sprite.
+     */
+    [[nodiscard]] constexpr int tiles_offset() const
+    {
+        return _tiles_offset;
+    }
+
+private:
+    sprite_shape_size _shape_size;
+    int16_t _x;
+    int16_t _y;
+    uint16_t _tiles_offset;
+};
+
+
+/**
+ * @brief Contains the required information to generate a meta_sprite: an image bigger or with a more complex shape
+ * than a hardware sprite, covered with one or more hardware sprites.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `meta_sprite` type.
+ *
+ * The tiles, the colors and the pieces are not copied but referenced,
+ * so they should outlive the meta_sprite_item to avoid dangling references.
+ *
+ * @ingroup sprite
+ * @ingroup tool
+ */
+class meta_sprite_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the tiles of all pieces.
+     * @param palette_item It creates the color palette of the pieces.
+     * @param pieces_ref Reference to the pieces.
+     * @param dimensions Size in pixels of the meta sprite.
+     */
+    constexpr meta_sprite_item(const span<const tile>& tiles_ref, const sprite_palette_item& palette_item,
+                               const span<const meta_sprite_piece>& pieces_ref, const size& dimensions) :
+        _tiles_ref(tiles_ref),
+        _palette_item(palette_item),
+        _pieces_ref(pieces_ref),
+        _dimensions(dimensions)
+    {
+        BN_ASSERT(! pieces_ref.empty(), "There's no pieces");
+        BN_ASSERT(dimensions.width() > 0 && dimensions.height() > 0,
+                  "Invalid dimensions: ", dimensions.width(), " - ", dimensions.height());
+
+        for(const meta_sprite_piece& piece : pieces_ref)
+        {
+            BN_ASSERT(piece.tiles_offset() + piece.shape_size().tiles_count(palette_item.bpp()) <= tiles_ref.size(),
+                      "Invalid piece tiles: ", piece.tiles_offset(), " - ", tiles_ref.size());
+        }
+    }
+
+    /**
+     * @brief Returns the reference to the tiles of all pieces.
+     */
+    [[nodiscard]] constexpr const span<const tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Returns the item used to create the color palette of the pieces.
+     */
+    [[nodiscard]] constexpr const sprite_palette_item& palette_item() const
+    {
+        return _palette_item;
+    }
+
+    /**
+     * @brief Returns the reference to the pieces.
+     */
+    [[nodiscard]] constexpr const span<const meta_sprite_piece>& pieces_ref() const
+    {
+        return _pieces_ref;
+    }
+
+    /**
+     * @brief Returns the size in pixels of the meta sprite.
+     */
+    [[nodiscard]] constexpr const size& dimensions() const
+    {
+        return _dimensions;
+    }
+
+    /**
+     * @brief Returns a sprite_item which creates the hardware sprite of the piece indicated by piece_index.
+     */
+    [[nodiscard]] constexpr sprite_item piece_sprite_item(int piece_index) const
+    {
+        BN_ASSERT(piece_index >= 0 && piece_index < _pieces_ref.size(),
+                  "Invalid piece index: ", piece_index, " - ", _pieces_ref.size());
+
+        const meta_sprite_piece& piece = _pieces_ref[piece_index];
+        const sprite_shape_size& shape_size = piece.shape_size();
+        bpp_mode bpp = _palette_item.bpp();
+        span<const tile> piece_tiles_ref(_tiles_ref.data() + piece.tiles_offset(), shape_size.tiles_count(bpp));
+        return sprite_item(shape_size, sprite_tiles_item(piece_tiles_ref, bpp), _palette_item);
+    }
+
+private:
+    span<const tile> _tiles_ref;
+    sprite_palette_item _palette_item;
+    span<const meta_sprite_piece> _pieces_ref;
+    size _dimensions;
+};
+
+}
+
+#endif
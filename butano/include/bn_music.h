@@ -13,6 +13,7 @@
  * @ingroup music
  */
 
+#include "bn_span.h"
 #include "bn_fixed_fwd.h"
 
 namespace bn
@@ -94,6 +95,17 @@ namespace bn::music
      * @param volume Volume level, in the range [0..1].
      */
     void set_volume(fixed volume);
+
+    /**
+     * @brief Returns the parameters of the song message effects (`SFx` in IT and S3M files, `EFx` in MOD and XM files)
+     * processed by the active music in the last frame, in the order in which they were processed.
+     *
+     * Events are queued by the software mixer when it processes them, and are delivered by bn::core::update,
+     * so they can be used to sync gameplay and visuals with the active music without polling its position.
+     *
+     * If there's more than @ref BN_CFG_AUDIO_MAX_MUSIC_EVENTS events in the same frame, the last ones are discarded.
+     */
+    [[nodiscard]] span<const uint8_t> events();
 }
 
 #endif
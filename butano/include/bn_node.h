@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_NODE_H
+#define BN_NODE_H
+
+/**
+ * @file
+ * bn::node header file.
+ *
+ * @ingroup sprite
+ * @ingroup regular_bg
+ */
+
+#include "bn_optional.h"
+#include "bn_sprite_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_regular_bg_ptr.h"
+
+namespace bn
+{
+
+class node;
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace nodes_manager
+{
+    void update();
+}
+
+/// @endcond
+
+/**
+ * @brief Element of a transform hierarchy.
+ *
+ * The position of a node is relative to its parent (if any).
+ * The sprite and the regular background attached to a node are placed in its world position.
+ *
+ * Moved nodes are not propagated immediately:
+ * all of them are propagated in one pass by core::update, before updating sprites and backgrounds.
+ * This way, the positions of the items attached to a composite object are updated only once per frame,
+ * no matter how many of its nodes have been moved.
+ *
+ * Nodes can't be copied nor moved, since parents and children reference each other.
+ * When a node is destroyed, its children become root nodes retaining their relative positions.
+ *
+ * @ingroup sprite
+ * @ingroup regular_bg
+ */
+class node
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param position Position of the node relative to its parent (if any).
+     */
+    explicit node(const fixed_point& position = fixed_point());
+
+    /**
+     * @brief Destructor.
+     */
+    ~node();
+
+    node(const node& other) = delete;
+
+    node& operator=(const node& other) = delete;
+
+    /**
+     * @brief Returns the horizontal position of the node relative to its parent (if any).
+     */
+    [[nodiscard]] fixed x() const
+    {
+        return _position.x();
+    }
+
+    /**
+     * @brief Returns the vertical position of the node relative to its parent (if any).
+     */
+    [[nodiscard]] fixed y() const
+    {
+        return _position.y();
+    }
+
+    /**
+     * @brief Returns the position of the node relative to its parent (if any).
+     */
+    [[nodiscard]] const fixed_point& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Sets the horizontal position of the node relative to its parent (if any).
+     */
+    void set_x(fixed x);
+
+    /**
+     * @brief Sets the vertical position of the node relative to its parent (if any).
+     */
+    void set_y(fixed y);
+
+    /**
+     * @brief Sets the position of the node relative to its parent (if any).
+     * @param x Horizontal position of the node relative to its parent (if any).
+     * @param y Vertical position of the node relative to its parent (if any).
+     */
+    void set_position(fixed x, fixed y);
+
+    /**
+     * @brief Sets the position of the node relative to its parent (if any).
+     */
+    void set_position(const fixed_point& position);
+
+    /**
+     * @brief Returns the absolute position of the node calculated in the last core::update call.
+     */
+    [[nodiscard]] const fixed_point& world_position() const
+    {
+        return _world_position;
+    }
+
+    /**
+     * @brief Returns the parent of the node (if any).
+     */
+    [[nodiscard]] const node* parent() const
+    {
+        return _parent;
+    }
+
+    /**
+     * @brief Sets the parent of the node.
+     *
+     * The parent can't be the node itself nor one of its descendants.
+     */
+    void set_parent(node& parent);
+
+    /**
+     * @brief Removes the parent of the node (if any), so it becomes a root node.
+     */
+    void remove_parent();
+
+    /**
+     * @brief Returns the sprite attached to the node (if any).
+     */
+    [[nodiscard]] const optional<sprite_ptr>& sprite() const
+    {
+        return _sprite;
+    }
+
+    /**
+     * @brief Attaches a sprite to the node, so it is placed in the world position of the node.
+     */
+    void set_sprite(sprite_ptr sprite);
+
+    /**
+     * @brief Removes the sprite attached to the node (if any).
+     */
+    void remove_sprite();
+
+    /**
+     * @brief Returns the regular background attached to the node (if any).
+     */
+    [[nodiscard]] const optional<regular_bg_ptr>& regular_bg() const
+    {
+        return _regular_bg;
+    }
+
+    /**
+     * @brief Attaches a regular background to the node, so it is placed in the world position of the node.
+     */
+    void set_regular_bg(regular_bg_ptr regular_bg);
+
+    /**
+     * @brief Removes the regular background attached to the node (if any).
+     */
+    void remove_regular_bg();
+
+private:
+    friend void nodes_manager::update();
+
+    fixed_point _position;
+    fixed_point _world_position;
+    optional<sprite_ptr> _sprite;
+    optional<regular_bg_ptr> _regular_bg;
+    node* _parent = nullptr;
+    node* _first_child = nullptr;
+    node* _next_sibling = nullptr;
+    node* _next_dirty = nullptr;
+    bool _dirty = false;
+
+    void _set_dirty();
+
+    void _unlink_from_parent();
+
+    [[nodiscard]] bool _dirty_ancestor() const;
+
+    void _propagate();
+};
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_OCCUPANCY_OVERLAY_H
+#define BN_OCCUPANCY_OVERLAY_H
+
+/**
+ * @file
+ * bn::occupancy_overlay header file.
+ *
+ * @ingroup profiler
+ */
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Shows a map of the occupied hardware resources on top of the game while it's running.
+ *
+ * From top to bottom, the map shows sprite tiles VRAM, BG blocks VRAM, sprite handles (OAM),
+ * sprite affine matrices and sprite and BG palettes, so fragmentation and leaks can be spotted while playing.
+ *
+ * Each cell is colored by its owner: sprite tiles are green, BG tiles are blue, BG maps are cyan,
+ * sprite handles are yellow, sprite affine matrices are orange, sprite palettes are magenta and BG palettes are purple.
+ * Free cells are dark gray, and cells which are going to be released are red.
+ *
+ * Cells changed in the last two refreshes are white.
+ *
+ * The overlay is toggled by pressing `Start` while `L` and `R` are held.
+ *
+ * While it's visible, the overlay uses two 64x64 sprites, their 128 tiles and a sprite palette,
+ * which are shown in the map too.
+ *
+ * @ingroup profiler
+ */
+class occupancy_overlay
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param refresh_frames Number of update calls between each refresh of the overlay (it must be > 0).
+     */
+    explicit occupancy_overlay(int refresh_frames = 30);
+
+    occupancy_overlay(const occupancy_overlay& other) = delete;
+
+    occupancy_overlay& operator=(const occupancy_overlay& other) = delete;
+
+    /**
+     * @brief Returns the number of update calls between each refresh of the overlay.
+     */
+    [[nodiscard]] int refresh_frames() const
+    {
+        return _refresh_frames;
+    }
+
+    /**
+     * @brief Indicates if the overlay is shown or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _visible;
+    }
+
+    /**
+     * @brief Sets if the overlay must be shown or not.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @brief Checks the toggle keys and refreshes the overlay if needed.
+     *
+     * It should be called once per frame.
+     */
+    void update();
+
+private:
+    static constexpr int _cells_count = 1024 + 32 + 128 + 32 + 16 + 16;
+
+    vector<sprite_ptr, 2> _sprites;
+    vector<sprite_tiles_ptr, 2> _tiles;
+    uint8_t _cells[_cells_count];
+    int _refresh_frames;
+    int _counter = 0;
+    bool _visible = false;
+
+    void _refresh();
+};
+
+}
+
+#endif
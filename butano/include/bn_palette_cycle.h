@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PALETTE_CYCLE_H
+#define BN_PALETTE_CYCLE_H
+
+/**
+ * @file
+ * bn::palette_cycle header file.
+ *
+ * @ingroup palette
+ */
+
+#include "bn_assert.h"
+
+namespace bn
+{
+
+/**
+ * @brief Describes a range of colors of a color palette which are rotated one position to the right
+ * each given number of frames, like waterfalls or neon signs.
+ *
+ * Colors are rotated when the palettes are committed to the GBA,
+ * so the effects applied to the palette are not computed again.
+ *
+ * @ingroup palette
+ */
+class palette_cycle
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param start_index Index of the first color of the range in the palette.
+     * @param length Number of colors of the range (>= 2).
+     * @param period Number of frames between rotations (>= 1).
+     */
+    constexpr palette_cycle(int start_index, int length, int period) :
+        _start_index(uint8_t(start_index)),
+        _length(uint16_t(length)),
+        _period(uint16_t(period))
+    {
+        BN_ASSERT(start_index >= 0 && start_index < 256, "Invalid start index: ", start_index);
+        BN_ASSERT(length >= 2 && start_index + length <= 256, "Invalid length: ", start_index, " - ", length);
+        BN_ASSERT(period >= 1 && period < 65536, "Invalid period: ", period);
+    }
+
+    /**
+     * @brief Returns the index of the first color of the range in the palette.
+     */
+    [[nodiscard]] constexpr int start_index() const
+    {
+        return _start_index;
+    }
+
+    /**
+     * @brief Returns the number of colors of the range.
+     */
+    [[nodiscard]] constexpr int length() const
+    {
+        return _length;
+    }
+
+    /**
+     * @brief Returns the number of frames between rotations.
+     */
+    [[nodiscard]] constexpr int period() const
+    {
+        return _period;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const palette_cycle& a, const palette_cycle& b) = default;
+
+private:
+    uint8_t _start_index;
+    uint16_t _length;
+    uint16_t _period;
+};
+
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PARTICLE_SYSTEM_H
+#define BN_PARTICLE_SYSTEM_H
+
+/**
+ * @file
+ * bn::particle_system header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_sprites.h"
+#include "bn_optional.h"
+#include "bn_camera_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_palette_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Manages short-lived sprites which share the same graphics, like sparks or debris.
+ *
+ * Particles don't use Butano's sprites manager: they are written directly to a range of reserved hardware sprite
+ * handles (see sprites::set_reserved_handles_count), so creating, moving and destroying them is much cheaper than
+ * doing the same with sprite_ptr objects.
+ *
+ * Particles are sorted by creation order, they are not affected by affine transformations
+ * and they are destroyed automatically when their lifetime expires.
+ *
+ * Particles are stored as structure of arrays and they are updated by code placed in IWRAM.
+ *
+ * Keep in mind that it uses about 2.3KB of memory.
+ *
+ * @ingroup sprite
+ */
+class particle_system
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param shape_size Shape and size of the particles.
+     * @param tiles Smart pointer to a sprite tile set.
+     * @param palette Smart pointer to a sprite palette.
+     * @param first_handle_index Index of the first reserved hardware sprite handle used by the particles.
+     * @param max_particles Maximum number of particles.
+     *
+     * All hardware sprite handles in the range [first_handle_index, first_handle_index + max_particles)
+     * must be reserved.
+     */
+    particle_system(const sprite_shape_size& shape_size, sprite_tiles_ptr tiles, sprite_palette_ptr palette,
+                    int first_handle_index, int max_particles);
+
+    particle_system(const particle_system& other) = delete;
+
+    particle_system& operator=(const particle_system& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * It hides the hardware sprite handles used by the particles.
+     */
+    ~particle_system();
+
+    /**
+     * @brief Returns the shape and size of the particles.
+     */
+    [[nodiscard]] const sprite_shape_size& shape_size() const
+    {
+        return _shape_size;
+    }
+
+    /**
+     * @brief Returns the tiles used by the particles.
+     */
+    [[nodiscard]] const sprite_tiles_ptr& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Returns the color palette used by the particles.
+     */
+    [[nodiscard]] const sprite_palette_ptr& palette() const
+    {
+        return _palette;
+    }
+
+    /**
+     * @brief Returns the index of the first reserved hardware sprite handle used by the particles.
+     */
+    [[nodiscard]] int first_handle_index() const
+    {
+        return _first_handle_index;
+    }
+
+    /**
+     * @brief Returns the maximum number of particles.
+     */
+    [[nodiscard]] int max_size() const
+    {
+        return _max_size;
+    }
+
+    /**
+     * @brief Returns the number of alive particles.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Indicates if there are no alive particles.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Indicates if no more particles can be added.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return _size == _max_size;
+    }
+
+    /**
+     * @brief Returns the velocity increment applied to all particles each time update is called.
+     */
+    [[nodiscard]] const fixed_point& acceleration() const
+    {
+        return _acceleration;
+    }
+
+    /**
+     * @brief Sets the velocity increment applied to all particles each time update is called.
+     */
+    void set_acceleration(const fixed_point& acceleration)
+    {
+        _acceleration = acceleration;
+    }
+
+    /**
+     * @brief Returns the priority of the particles relative to backgrounds.
+     */
+    [[nodiscard]] int bg_priority() const
+    {
+        return _bg_priority;
+    }
+
+    /**
+     * @brief Sets the priority of the particles relative to backgrounds.
+     *
+     * Particles with higher priority are drawn first (and therefore can be covered by later backgrounds).
+     *
+     * @param bg_priority Priority relative to backgrounds in the range [0..3].
+     */
+    void set_bg_priority(int bg_priority);
+
+    /**
+     * @brief Indicates if blending must be applied to the particles or not.
+     */
+    [[nodiscard]] bool blending_enabled() const
+    {
+        return _blending_enabled;
+    }
+
+    /**
+     * @brief Sets if blending must be applied to the particles or not.
+     */
+    void set_blending_enabled(bool blending_enabled)
+    {
+        _blending_enabled = blending_enabled;
+    }
+
+    /**
+     * @brief Indicates if the particles must be committed to the GBA or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _visible;
+    }
+
+    /**
+     * @brief Sets if the particles must be committed to the GBA or not.
+     */
+    void set_visible(bool visible)
+    {
+        _visible = visible;
+    }
+
+    /**
+     * @brief Returns the camera_ptr attached to the particles (if any).
+     */
+    [[nodiscard]] const optional<camera_ptr>& camera() const
+    {
+        return _camera;
+    }
+
+    /**
+     * @brief Sets the camera_ptr attached to the particles.
+     */
+    void set_camera(const camera_ptr& camera)
+    {
+        _camera = camera;
+    }
+
+    /**
+     * @brief Sets the camera_ptr attached to the particles.
+     */
+    void set_camera(camera_ptr&& camera)
+    {
+        _camera = move(camera);
+    }
+
+    /**
+     * @brief Removes the camera_ptr attached to the particles (if any).
+     */
+    void remove_camera()
+    {
+        _camera.reset();
+    }
+
+    /**
+     * @brief Adds a new particle.
+     * @param position Position of the center of the particle.
+     * @param velocity Position increment applied to the particle each time update is called.
+     * @param frames Number of update calls in which the particle is displayed before being destroyed
+     * (it must be > 0).
+     * @return `true` if the particle has been added, or `false` if there's no room for it.
+     */
+    bool add(const fixed_point& position, const fixed_point& velocity, int frames);
+
+    /**
+     * @brief Destroys all particles.
+     */
+    void clear()
+    {
+        _size = 0;
+    }
+
+    /**
+     * @brief Moves the particles, destroys the expired ones
+     * and writes the remaining ones to their reserved hardware sprite handles.
+     *
+     * It should be called once per frame, before calling core::update.
+     */
+    void update();
+
+private:
+    int _xs[hw::sprites::count()];
+    int _ys[hw::sprites::count()];
+    int _velocity_xs[hw::sprites::count()];
+    int _velocity_ys[hw::sprites::count()];
+    uint16_t _frames[hw::sprites::count()];
+    sprite_shape_size _shape_size;
+    sprite_tiles_ptr _tiles;
+    sprite_palette_ptr _palette;
+    optional<camera_ptr> _camera;
+    fixed_point _acceleration;
+    int _first_handle_index;
+    int _max_size;
+    int _size = 0;
+    int _last_committed_size = 0;
+    int8_t _bg_priority = 3;
+    bool _blending_enabled = false;
+    bool _visible = true;
+
+    [[nodiscard]] BN_CODE_IWRAM int _update_particles();
+
+    BN_CODE_IWRAM void _write_handles(int hw_x, int hw_y, int attr0, int attr1, int attr2, void* handles) const;
+};
+
+}
+
+#endif
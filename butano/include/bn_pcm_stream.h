@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PCM_STREAM_H
+#define BN_PCM_STREAM_H
+
+/**
+ * @file
+ * bn::pcm_stream header file.
+ *
+ * @ingroup pcm_stream
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    class pcm_stream_item;
+}
+
+/**
+ * @brief PCM stream related functions.
+ *
+ * PCM streams are decoded from ROM each time bn::core::update() is called
+ * and played with Direct Sound B alongside Maxmod music and sound effects.
+ *
+ * They must be enabled with @ref BN_CFG_PCM_STREAM_ENABLED.
+ *
+ * @ingroup pcm_stream
+ */
+namespace bn::pcm_stream
+{
+    /**
+     * @brief Indicates if currently there's any PCM stream playing or not.
+     */
+    [[nodiscard]] bool playing();
+
+    /**
+     * @brief Plays the PCM stream specified by the given pcm_stream_item with loop enabled.
+     *
+     * Its mixing rate must be equal to the current bn::audio::mixing_rate().
+     */
+    void play(const pcm_stream_item& item);
+
+    /**
+     * @brief Plays the PCM stream specified by the given pcm_stream_item.
+     *
+     * Its mixing rate must be equal to the current bn::audio::mixing_rate().
+     *
+     * @param item Specifies the PCM stream to play.
+     * @param loop Indicates if it must be played until it is stopped manually or until end.
+     */
+    void play(const pcm_stream_item& item, bool loop);
+
+    /**
+     * @brief Stops playback of the active PCM stream.
+     */
+    void stop();
+
+    /**
+     * @brief Indicates if the active PCM stream has been paused or not.
+     */
+    [[nodiscard]] bool paused();
+
+    /**
+     * @brief Pauses playback of the active PCM stream.
+     */
+    void pause();
+
+    /**
+     * @brief Resumes playback of the paused PCM stream.
+     */
+    void resume();
+
+    /**
+     * @brief Returns the index of the sample of the active PCM stream which is being played.
+     *
+     * Its precision is one frame.
+     */
+    [[nodiscard]] int position();
+
+    /**
+     * @brief Returns the timer ticks spent decoding samples in the last call to bn::core::update().
+     */
+    [[nodiscard]] int decode_ticks();
+
+    /**
+     * @brief Returns the number of frames in which the PCM stream has not been decoded in time.
+     *
+     * It can be reduced by increasing @ref BN_CFG_PCM_STREAM_BUFFER_FRAMES
+     * or @ref BN_CFG_PCM_STREAM_MAX_DECODE_FRAMES.
+     */
+    [[nodiscard]] int underruns();
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PCM_STREAM_ITEM_H
+#define BN_PCM_STREAM_ITEM_H
+
+/**
+ * @file
+ * bn::pcm_stream_item header file.
+ *
+ * @ingroup pcm_stream
+ */
+
+#include "bn_span.h"
+#include "bn_assert.h"
+#include "bn_audio_mixing_rate.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to play a PCM stream.
+ *
+ * Samples are mono IMA ADPCM nibbles (the low nibble of each byte comes first),
+ * encoded with an initial predictor and step index of 0.
+ *
+ * @ingroup pcm_stream
+ */
+class pcm_stream_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param data_ref Reference to the IMA ADPCM encoded samples.
+     * @param samples_count Number of encoded samples (two per byte).
+     * @param mixing_rate Software audio mixing rate used to encode the samples (BN_AUDIO_MIXING_RATE_* macros).
+     * Samples are played at the current bn::audio::mixing_rate().
+     */
+    constexpr pcm_stream_item(const span<const uint8_t>& data_ref, int samples_count, int mixing_rate) :
+        _data_ref(data_ref),
+        _samples_count(samples_count),
+        _mixing_rate(mixing_rate)
+    {
+        BN_ASSERT(samples_count > 0 && samples_count <= data_ref.size() * 2,
+                  "Invalid samples count: ", samples_count, " - ", data_ref.size());
+        BN_ASSERT(mixing_rate >= BN_AUDIO_MIXING_RATE_8_KHZ && mixing_rate <= BN_AUDIO_MIXING_RATE_31_KHZ,
+                  "Invalid mixing rate: ", mixing_rate);
+    }
+
+    /**
+     * @brief Returns the reference to the IMA ADPCM encoded samples.
+     */
+    [[nodiscard]] constexpr const span<const uint8_t>& data_ref() const
+    {
+        return _data_ref;
+    }
+
+    /**
+     * @brief Returns the number of encoded samples.
+     */
+    [[nodiscard]] constexpr int samples_count() const
+    {
+        return _samples_count;
+    }
+
+    /**
+     * @brief Returns the software audio mixing rate used to encode the samples (BN_AUDIO_MIXING_RATE_* macros).
+     */
+    [[nodiscard]] constexpr int mixing_rate() const
+    {
+        return _mixing_rate;
+    }
+
+    /**
+     * @brief Plays the PCM stream with loop enabled.
+     */
+    void play() const;
+
+    /**
+     * @brief Plays the PCM stream.
+     * @param loop Indicates if it must be played until it is stopped manually or until end.
+     */
+    void play(bool loop) const;
+
+private:
+    span<const uint8_t> _data_ref;
+    int _samples_count;
+    int _mixing_rate;
+};
+
+}
+
+#endif
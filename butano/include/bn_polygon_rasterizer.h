@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_POLYGON_RASTERIZER_H
+#define BN_POLYGON_RASTERIZER_H
+
+/**
+ * @file
+ * bn::polygon_rasterizer header file.
+ *
+ * @ingroup hdma
+ */
+
+#include "bn_assert.h"
+#include "bn_display.h"
+#include "bn_span_fwd.h"
+#include "bn_fixed_point.h"
+
+namespace bn
+{
+
+/**
+ * @brief Rasterizes filled polygons into one horizontal span per screen line,
+ * ready to be committed with HDMA or H-Blank effects (windows boundaries, sprite attributes, etc).
+ *
+ * The spans of all added polygons are merged, so each line span covers all the polygons which intersect it.
+ *
+ * Both convex and concave polygons are supported,
+ * but since each line stores only one span, the gaps of a concave polygon in a line are filled.
+ *
+ * @ingroup hdma
+ */
+class polygon_rasterizer
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    polygon_rasterizer()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Removes all added polygons.
+     */
+    void clear();
+
+    /**
+     * @brief Adds a polygon to the rasterized spans.
+     * @param vertices Polygon vertices (at least three), relative to the center of the screen.
+     *
+     * Vertices can be in clockwise or counterclockwise order, and polygons can be partially or totally out of screen.
+     */
+    void add_polygon(const span<const fixed_point>& vertices);
+
+    /**
+     * @brief Indicates if no polygon intersects the screen.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _minimum_y > _maximum_y;
+    }
+
+    /**
+     * @brief Returns the first screen line intersected by a polygon.
+     */
+    [[nodiscard]] int minimum_y() const
+    {
+        return _minimum_y;
+    }
+
+    /**
+     * @brief Returns the last screen line intersected by a polygon.
+     */
+    [[nodiscard]] int maximum_y() const
+    {
+        return _maximum_y;
+    }
+
+    /**
+     * @brief Returns the first pixel of the span of the given screen line,
+     * in the range [0, display::width()].
+     */
+    [[nodiscard]] int left(int y) const
+    {
+        BN_ASSERT(y >= 0 && y < display::height(), "Invalid y: ", y);
+
+        return _lefts[y];
+    }
+
+    /**
+     * @brief Returns the pixel past the last one of the span of the given screen line,
+     * in the range [0, display::width()].
+     *
+     * If it is less or equal than left(y), the line is empty.
+     */
+    [[nodiscard]] int right(int y) const
+    {
+        BN_ASSERT(y >= 0 && y < display::height(), "Invalid y: ", y);
+
+        return _rights[y];
+    }
+
+private:
+    alignas(int) int16_t _lefts[display::height()];
+    alignas(int) int16_t _rights[display::height()];
+    int _minimum_y;
+    int _maximum_y;
+
+    BN_CODE_IWRAM void _add_edge(int x0, int y0, int x1, int y1);
+};
+
+}
+
+#endif
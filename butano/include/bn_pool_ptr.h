@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_POOL_PTR_H
+#define BN_POOL_PTR_H
+
+/**
+ * @file
+ * bn::pool_ptr and bn::arena_ptr implementation header file.
+ *
+ * @ingroup pool
+ */
+
+#include "bn_pool.h"
+#include "bn_arena.h"
+#include "bn_unique_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Deleter which returns objects to the given bn::ipool.
+ *
+ * The pool is a template parameter, so the deleter is empty and a bn::pool_ptr is as large as a pointer.
+ *
+ * @tparam Type Type of the objects to delete.
+ * @tparam Pool bn::ipool from which the objects have been allocated. It must have static storage duration.
+ *
+ * @ingroup pool
+ */
+template<typename Type, auto& Pool>
+struct pool_delete
+{
+    /**
+     * @brief Destroys the object pointed by the given pointer and returns its memory to the pool in O(1).
+     */
+    void operator()(Type* ptr) const
+    {
+        if(ptr)
+        {
+            ipool<Type>& pool = Pool;
+            pool.destroy(*ptr);
+        }
+    }
+};
+
+
+/**
+ * @brief Deleter which only destroys objects allocated in a bn::iarena.
+ *
+ * Arena memory can't be freed per object, so it is reclaimed with bn::iarena::reset or a bn::iarena::scope.
+ *
+ * @tparam Type Type of the objects to delete.
+ *
+ * @ingroup pool
+ */
+template<typename Type>
+struct arena_delete
+{
+    /**
+     * @brief Calls the destructor of the object pointed by the given pointer.
+     */
+    void operator()(Type* ptr) const
+    {
+        if(ptr)
+        {
+            ptr->~Type();
+        }
+    }
+};
+
+
+/**
+ * @brief bn::unique_ptr which returns its managed object to the given bn::ipool when it is disposed.
+ *
+ * It is as large as a pointer, and allocating and disposing objects never touches the heap,
+ * so it is suitable for short-lived objects like bullets or effects.
+ *
+ * @tparam Type Type of the managed object.
+ * @tparam Pool bn::ipool from which the managed object has been allocated.
+ * It must have static storage duration.
+ *
+ * @ingroup pool
+ */
+template<typename Type, auto& Pool>
+using pool_ptr = unique_ptr<Type, pool_delete<Type, Pool>>;
+
+
+/**
+ * @brief bn::unique_ptr which calls the destructor of an object allocated in a bn::iarena when it is disposed.
+ *
+ * It is as large as a pointer. It must be disposed before the arena memory of its managed object is reclaimed.
+ *
+ * @tparam Type Type of the managed object.
+ *
+ * @ingroup pool
+ */
+template<typename Type>
+using arena_ptr = unique_ptr<Type, arena_delete<Type>>;
+
+
+/**
+ * @brief Constructs an object in the given bn::ipool and wraps it in a bn::pool_ptr.
+ *
+ * The pool must not be full.
+ *
+ * @tparam Type Type of the object to construct.
+ * @tparam Pool bn::ipool in which the object is constructed. It must have static storage duration.
+ * @param args Parameters of the object to construct.
+ * @return bn::pool_ptr which manages the constructed object.
+ *
+ * @ingroup pool
+ */
+template<typename Type, auto& Pool, typename... Args>
+[[nodiscard]] pool_ptr<Type, Pool> make_pool_ptr(Args&&... args)
+{
+    ipool<Type>& pool = Pool;
+    return pool_ptr<Type, Pool>(&pool.create(forward<Args>(args)...));
+}
+
+
+/**
+ * @brief Constructs an object in the given bn::iarena and wraps it in a bn::arena_ptr.
+ * @tparam Type Type of the object to construct.
+ * @param arena bn::iarena in which the object is constructed.
+ * @param args Parameters of the object to construct.
+ * @return bn::arena_ptr which manages the constructed object, or an empty bn::arena_ptr if the arena is full.
+ *
+ * @ingroup pool
+ */
+template<typename Type, typename... Args>
+[[nodiscard]] arena_ptr<Type> make_arena_ptr(iarena& arena, Args&&... args)
+{
+    return arena_ptr<Type>(arena.create<Type>(forward<Args>(args)...));
+}
+
+}
+
+#endif
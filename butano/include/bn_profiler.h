@@ -21,7 +21,11 @@
  *
  * Defines the start of a code block in which elapsed time is going to be measured.
  *
- * @param id Small text string which identifies the code block.
+ * Code blocks can be nested up to @ref BN_CFG_PROFILER_MAX_DEPTH levels:
+ * the elapsed time of a code block includes the elapsed time of its children.
+ *
+ * @param id Small string literal which identifies the code block.
+ * Its hash is calculated at compile time, so profiling a code block only costs the timer reads.
  *
  * @ingroup profiler
  */
@@ -56,6 +60,18 @@
          * @brief Stops the execution and shows the profiling results on the screen.
          */
         [[noreturn]] void show();
+
+        /**
+         * @brief Prints with bn::log the elapsed time per code block of the last frames
+         * (see @ref BN_CFG_PROFILER_FRAMES_HISTORY).
+         *
+         * The first lines have the format `id,<index>,<code block id>`,
+         * and they are followed by one line per frame with the format `f,<index 0 ticks>,<index 1 ticks>,...`,
+         * from the oldest frame to the newest one.
+         *
+         * It does nothing if the log is disabled (see @ref BN_CFG_LOG_ENABLED).
+         */
+        void log_frames();
     }
 
     /// @cond DO_NOT_DOCUMENT
@@ -65,24 +81,47 @@
         struct ticks
         {
             int64_t total = 0;
+            const char* parent_id = nullptr;
+            int count = 0;
+            int min = 0;
             int max = 0;
+            int history_index = -1;
         };
 
         using ticks_map = bn::unordered_map<const char*, ticks, BN_CFG_PROFILER_MAX_ENTRIES * 2>;
 
+        [[nodiscard]] consteval unsigned id_hash(const char* id)
+        {
+            // FNV-1a:
+            unsigned result = 0x811C9DC5;
+
+            while(*id)
+            {
+                result ^= uint8_t(*id);
+                result *= 0x01000193;
+                ++id;
+            }
+
+            return result;
+        }
+
         void start(const char* id, unsigned id_hash);
 
         void stop();
 
+        void add(const char* id, unsigned id_hash, int timer_ticks);
+
         [[nodiscard]] const ticks_map& ticks_per_entry();
 
         void reset();
+
+        void next_frame();
     }
 
     /// @endcond
 
     #define BN_PROFILER_START(id) \
-        _bn::profiler::start(id, bn::hash<const char*>()(id))
+        _bn::profiler::start(id, _bn::profiler::id_hash(id))
 
     #define BN_PROFILER_STOP() \
         _bn::profiler::stop()
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PROFILER_OVERLAY_H
+#define BN_PROFILER_OVERLAY_H
+
+/**
+ * @file
+ * bn::profiler_overlay header file.
+ *
+ * @ingroup profiler
+ */
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_config_profiler.h"
+
+namespace bn
+{
+
+class sprite_text_generator;
+
+/**
+ * @brief Shows the profiling results on top of the game while it's running.
+ *
+ * For each profiled code block, the minimum, average and maximum elapsed time per call
+ * since the last refresh are shown as percentages of a frame, with children just below their parents.
+ *
+ * The overlay is toggled by pressing `Select` while `L` and `R` are held.
+ *
+ * Since profiling results are reset each time the overlay is refreshed (while it's visible),
+ * profiler::show can't be used at the same time.
+ *
+ * If the profiler is disabled (see @ref BN_CFG_PROFILER_ENABLED), update does nothing.
+ *
+ * @ingroup profiler
+ */
+class profiler_overlay
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param text_generator Text generator used to print the profiling results.
+     * @param refresh_frames Number of update calls between each refresh of the overlay (it must be > 0).
+     */
+    explicit profiler_overlay(sprite_text_generator& text_generator, int refresh_frames = 30);
+
+    profiler_overlay(const profiler_overlay& other) = delete;
+
+    profiler_overlay& operator=(const profiler_overlay& other) = delete;
+
+    /**
+     * @brief Returns the number of update calls between each refresh of the overlay.
+     */
+    [[nodiscard]] int refresh_frames() const
+    {
+        return _refresh_frames;
+    }
+
+    /**
+     * @brief Indicates if the overlay is shown or not.
+     */
+    [[nodiscard]] bool visible() const
+    {
+        return _visible;
+    }
+
+    /**
+     * @brief Sets if the overlay must be shown or not.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @brief Checks the toggle keys and refreshes the overlay if needed.
+     *
+     * It should be called once per frame, outside of any profiled code block.
+     */
+    void update();
+
+private:
+    vector<sprite_ptr, BN_CFG_PROFILER_OVERLAY_MAX_SPRITES> _sprites;
+    sprite_text_generator* _text_generator;
+    int _refresh_frames;
+    int _counter = 0;
+    bool _visible = false;
+
+    void _refresh();
+};
+
+}
+
+#endif
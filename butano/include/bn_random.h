@@ -15,6 +15,7 @@
 
 #include "bn_fixed.h"
 #include "bn_assert.h"
+#include "bn_span_fwd.h"
 
 namespace bn
 {
@@ -32,6 +33,11 @@ class random
 {
 
 public:
+    /**
+     * @brief Default constructor.
+     */
+    constexpr random() = default;
+
     /**
      * @brief Returns a random unsigned integer greater or equal than 0,
      * modifying its internal seed in the process.
@@ -129,10 +135,85 @@ public:
         return minimum + fixed::from_data(int(result));
     }
 
+    /**
+     * @brief Returns a random signed integer in the range [0..limit) without bias,
+     * modifying its internal seed in the process.
+     *
+     * It uses a multiplication instead of a modulo, so it is faster than get_int(int) on the GBA
+     * (a division is done only in the rare case that a generated value must be discarded).
+     *
+     * See https://arxiv.org/abs/1805.10941
+     *
+     * @param limit Returned value is lower than this value.
+     * @return Random signed integer in the range [0..limit).
+     */
+    [[nodiscard]] constexpr int get_unbiased_int(int limit)
+    {
+        BN_ASSERT(limit > 0, "Invalid limit: ", limit);
+
+        auto unsigned_limit = unsigned(limit);
+        uint64_t multiplication = uint64_t(get()) * unsigned_limit;
+        auto low = unsigned(multiplication);
+
+        if(low < unsigned_limit) [[unlikely]]
+        {
+            unsigned threshold = (0 - unsigned_limit) % unsigned_limit;
+
+            while(low < threshold)
+            {
+                multiplication = uint64_t(get()) * unsigned_limit;
+                low = unsigned(multiplication);
+            }
+        }
+
+        return int(multiplication >> 32);
+    }
+
+    /**
+     * @brief Fills the given span with random unsigned integers, modifying its internal seed in the process.
+     *
+     * The generated values are the same as the ones returned by calling get() once per element.
+     */
+    BN_CODE_IWRAM void fill(const span<unsigned>& values);
+
+    /**
+     * @brief Returns a new random number generator with a seed derived from the internal seed of this one,
+     * modifying it in the process.
+     *
+     * Both generators are deterministic and produce different streams of numbers,
+     * so independent systems (like particles and enemies in a replay) can have their own generator.
+     */
+    [[nodiscard]] constexpr random split()
+    {
+        random result;
+        result._x = _mix(get());
+        result._y = _mix(get());
+        result._z = _mix(get());
+
+        // Zero seeds are not valid:
+        if(! (result._x | result._y | result._z)) [[unlikely]]
+        {
+            result._x = 123456789;
+        }
+
+        return result;
+    }
+
 private:
     unsigned _x = 123456789;
     unsigned _y = 362436069;
     unsigned _z = 521288629;
+
+    [[nodiscard]] static constexpr unsigned _mix(unsigned value)
+    {
+        // MurmurHash3 finalizer:
+        value ^= value >> 16;
+        value *= 0x85EBCA6B;
+        value ^= value >> 13;
+        value *= 0xC2B2AE35;
+        value ^= value >> 16;
+        return value;
+    }
 };
 
 }
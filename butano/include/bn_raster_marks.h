@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RASTER_MARKS_H
+#define BN_RASTER_MARKS_H
+
+/**
+ * @file
+ * Raster marks header file.
+ *
+ * @ingroup profiler
+ */
+
+#include "bn_config_doxygen.h"
+#include "bn_config_profiler.h"
+
+/**
+ * @def BN_RASTER_MARK
+ *
+ * Records the current screen line (VCOUNT) and timer ticks together with the given color,
+ * so the layout of the frame time can be shown as colored bars.
+ *
+ * Marks of the last frame can be retrieved with bn::raster_marks::last_frame_marks.
+ *
+ * It does nothing if @ref BN_CFG_RASTER_MARKS_ENABLED is `false`.
+ *
+ * @param color bn::color which identifies the code that follows the mark.
+ *
+ * @ingroup profiler
+ */
+
+#if BN_CFG_RASTER_MARKS_ENABLED || BN_DOXYGEN
+    #include "bn_color.h"
+    #include "bn_span_fwd.h"
+
+    namespace bn
+    {
+        /**
+         * @brief Screen line and timer ticks recorded by @ref BN_RASTER_MARK.
+         *
+         * @ingroup profiler
+         */
+        class raster_mark
+        {
+
+        public:
+            /**
+             * @brief Constructor.
+             * @param mark_color bn::color which identifies the code that follows the mark.
+             * @param line Screen line (VCOUNT) when the mark was recorded, in the range [0, 227].
+             * @param ticks Timer ticks elapsed since the start of the frame when the mark was recorded.
+             */
+            constexpr raster_mark(color mark_color, int line, int ticks) :
+                _ticks(ticks),
+                _color(mark_color),
+                _line(uint16_t(line))
+            {
+            }
+
+            /**
+             * @brief Returns the bn::color which identifies the code that follows the mark.
+             */
+            [[nodiscard]] constexpr color mark_color() const
+            {
+                return _color;
+            }
+
+            /**
+             * @brief Returns the screen line (VCOUNT) when the mark was recorded, in the range [0, 227].
+             *
+             * Lines in the range [160, 227] belong to the V-Blank period.
+             */
+            [[nodiscard]] constexpr int line() const
+            {
+                return _line;
+            }
+
+            /**
+             * @brief Returns the timer ticks elapsed since the start of the frame when the mark was recorded.
+             *
+             * The frame starts when bn::core::update returns.
+             */
+            [[nodiscard]] constexpr int ticks() const
+            {
+                return _ticks;
+            }
+
+        private:
+            int _ticks;
+            color _color;
+            uint16_t _line;
+        };
+    }
+
+    /**
+     * @brief Raster marks related functions.
+     *
+     * @ingroup profiler
+     */
+    namespace bn::raster_marks
+    {
+        /**
+         * @brief Returns the marks recorded in the last frame, sorted by time.
+         *
+         * Marks recorded after the first @ref BN_CFG_RASTER_MARKS_MAX_ITEMS ones of a frame are ignored.
+         */
+        [[nodiscard]] span<const raster_mark> last_frame_marks();
+
+        /**
+         * @brief Indicates if each mark writes its color to the backdrop color register or not.
+         */
+        [[nodiscard]] bool backdrop_enabled();
+
+        /**
+         * @brief Sets if each mark must write its color to the backdrop color register or not.
+         *
+         * If it is enabled, each mark changes the backdrop color immediately,
+         * so the screen lines drawn while the marked code runs show colored raster bars on real hardware.
+         *
+         * The original backdrop color is restored when bn::core::update is called.
+         */
+        void set_backdrop_enabled(bool backdrop_enabled);
+    }
+
+    /// @cond DO_NOT_DOCUMENT
+
+    namespace _bn::raster_marks
+    {
+        void mark(bn::color color);
+
+        void next_frame();
+    }
+
+    /// @endcond
+
+    #define BN_RASTER_MARK(color) \
+        _bn::raster_marks::mark(color)
+#else
+    #define BN_RASTER_MARK(color) \
+        do \
+        { \
+        } while(false)
+#endif
+
+#endif
@@ -13,9 +13,9 @@
  * @ingroup math
  */
 
+#include "bn_array.h"
 #include "bn_fixed.h"
 #include "bn_assert.h"
-#include "bn_array_fwd.h"
 
 namespace bn
 {
@@ -48,6 +48,93 @@ constexpr int reciprocal_lut_size = 1025;
  */
 extern const array<fixed_t<20>, reciprocal_lut_size>& reciprocal_lut;
 
+/**
+ * @brief Calculates the value to store in a LUT generated with make_reciprocal_lut for the given value.
+ * @tparam Precision Number of fractional bits of the returned value, in the range [1, 30].
+ * @param lut_value LUT index (>= 0).
+ * @return Reciprocal of the given value (1 / value) rounded up, or 1 if the given value is 0.
+ *
+ * @ingroup math
+ */
+template<int Precision>
+[[nodiscard]] constexpr fixed_t<Precision> calculate_reciprocal_lut_entry(int lut_value)
+{
+    static_assert(Precision > 0 && Precision <= 30, "Invalid precision");
+    BN_ASSERT(lut_value >= 0, "Value must be greater or equal than 0: ", lut_value);
+
+    constexpr int one = 1 << Precision;
+
+    if(lut_value < 2)
+    {
+        return fixed_t<Precision>::from_data(one);
+    }
+
+    return fixed_t<Precision>::from_data((one + lut_value - 1) / lut_value);
+}
+
+/**
+ * @brief Generates a reciprocal LUT with the given size and precision.
+ *
+ * If the result is stored in a constexpr variable, it is generated at compile time and placed in ROM.
+ * If it is stored in a non const global variable, it is placed in IWRAM
+ * (or in EWRAM if the variable is declared with BN_DATA_EWRAM).
+ *
+ * @tparam Size Number of LUT entries (> 1).
+ * @tparam Precision Number of fractional bits of the LUT entries, in the range [1, 30].
+ * @return Array in which each entry stores the value returned by calculate_reciprocal_lut_entry for its index.
+ *
+ * @ingroup math
+ */
+template<int Size, int Precision>
+[[nodiscard]] constexpr array<fixed_t<Precision>, Size> make_reciprocal_lut()
+{
+    static_assert(Size > 1, "Invalid size");
+
+    array<fixed_t<Precision>, Size> result;
+
+    for(int index = 0; index < Size; ++index)
+    {
+        result[index] = calculate_reciprocal_lut_entry<Precision>(index);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Divides the given integers using a LUT generated with make_reciprocal_lut.
+ *
+ * If the absolute value of the denominator is out of the LUT range,
+ * the division is done with the division operator instead.
+ *
+ * The result is exact when abs(numerator) * (abs(denominator) - 1) < 2 ^ Precision.
+ * Otherwise, it can be slightly greater than the real quotient.
+ *
+ * Since the numerator is not scaled, fixed point numerators can be divided by passing their internal data.
+ *
+ * @param numerator Dividend.
+ * @param denominator Divisor (it can't be 0).
+ * @param lut Reciprocal LUT generated with make_reciprocal_lut.
+ * @return numerator / denominator rounded toward zero, like the division operator.
+ *
+ * @ingroup math
+ */
+template<int Size, int Precision>
+[[nodiscard]] constexpr int lut_divide(int numerator, int denominator, const array<fixed_t<Precision>, Size>& lut)
+{
+    BN_ASSERT(denominator, "Denominator is zero");
+
+    unsigned abs_denominator = denominator < 0 ? 0 - unsigned(denominator) : unsigned(denominator);
+
+    if(abs_denominator >= unsigned(Size))
+    {
+        return numerator / denominator;
+    }
+
+    uint64_t abs_numerator = numerator < 0 ? 0 - unsigned(numerator) : unsigned(numerator);
+    auto result = int((abs_numerator * unsigned(lut[int(abs_denominator)].data())) >> Precision);
+    return (numerator < 0) == (denominator < 0) ? result : -result;
+}
+
 }
 
 #endif
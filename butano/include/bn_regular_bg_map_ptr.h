@@ -24,6 +24,7 @@ namespace bn
 {
 
 class size;
+class point;
 class bg_palette_ptr;
 class bg_palette_item;
 class regular_bg_item;
@@ -323,6 +324,141 @@ public:
      */
     void reload_cells_ref();
 
+    /**
+     * @brief Uploads the given rows of the referenced map cells to VRAM again
+     * to make visible the possible changes in them.
+     *
+     * Only uncompressed maps with 32 or 64 columns are uploaded partially, the other ones are uploaded entirely.
+     *
+     * @param first_row Index of the first row to upload.
+     * @param rows_count Number of rows to upload (it must be > 0).
+     */
+    void reload_cells_ref(int first_row, int rows_count);
+
+    /**
+     * @brief Uploads the given rectangle of the referenced map cells to VRAM again
+     * to make visible the possible changes in them.
+     *
+     * Pending rectangles are merged in their bounding box,
+     * and only uncompressed maps with 32 or 64 columns are uploaded partially.
+     *
+     * @param first_column Index of the first column to upload.
+     * @param first_row Index of the first row to upload.
+     * @param columns_count Number of columns to upload (it must be > 0).
+     * @param rows_count Number of rows to upload (it must be > 0).
+     */
+    void reload_cells_ref(int first_column, int first_row, int columns_count, int rows_count);
+
+    /**
+     * @brief Sets the referenced map cell in the specified map coordinates and uploads it to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param map_x Horizontal position of the map cell [0..dimensions().width()).
+     * @param map_y Vertical position of the map cell [0..dimensions().height()).
+     * @param cell New map cell.
+     */
+    void set_cell(int map_x, int map_y, regular_bg_map_cell cell);
+
+    /**
+     * @brief Sets the referenced map cell in the specified map coordinates and uploads it to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param map_position Position of the map cell.
+     * @param cell New map cell.
+     */
+    void set_cell(const point& map_position, regular_bg_map_cell cell);
+
+    /**
+     * @brief Sets the referenced map cells in the given rectangle and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param first_column Index of the first column of the rectangle.
+     * @param first_row Index of the first row of the rectangle.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param cell New map cell.
+     */
+    void fill_rect(int first_column, int first_row, int columns_count, int rows_count, regular_bg_map_cell cell);
+
+    /**
+     * @brief Copies a rectangle of the given map cells to the referenced map cells and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param source_map_item regular_bg_map_item which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     */
+    void copy_rect(const regular_bg_map_item& source_map_item, int source_column, int source_row, int columns_count,
+                   int rows_count, int destination_column, int destination_row);
+
+    /**
+     * @brief Copies a rectangle of the map cells referenced by the given map
+     * to the referenced map cells and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * The given map can be this map: overlapping rectangles are copied as if the source was copied first
+     * to a temporary buffer.
+     *
+     * @param source_map Map which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     */
+    void copy_rect(const regular_bg_map_ptr& source_map, int source_column, int source_row, int columns_count,
+                   int rows_count, int destination_column, int destination_row);
+
+    /**
+     * @brief Copies a rectangle of the given map cells to the referenced map cells,
+     * offsetting their tile index and palette bank, and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param source_map_item regular_bg_map_item which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     * @param tiles_offset Number of tiles to add to the tile index of each copied map cell [0..1023].
+     * @param palette_banks_offset Number of palette banks to add to the palette bank of each copied map cell [0..15].
+     */
+    void blit_with_offset(const regular_bg_map_item& source_map_item, int source_column, int source_row,
+                          int columns_count, int rows_count, int destination_column, int destination_row,
+                          int tiles_offset, int palette_banks_offset);
+
+    /**
+     * @brief Copies a rectangle of the map cells referenced by the given map to the referenced map cells,
+     * offsetting their tile index and palette bank, and uploads them to VRAM again.
+     *
+     * The referenced map cells must be uncompressed and must not be placed in ROM.
+     *
+     * @param source_map Map which references the uncompressed map cells to copy.
+     * @param source_column Index of the first column of the rectangle to copy.
+     * @param source_row Index of the first row of the rectangle to copy.
+     * @param columns_count Number of columns of the rectangle (it must be > 0).
+     * @param rows_count Number of rows of the rectangle (it must be > 0).
+     * @param destination_column Index of the first column of the destination rectangle.
+     * @param destination_row Index of the first row of the destination rectangle.
+     * @param tiles_offset Number of tiles to add to the tile index of each copied map cell [0..1023].
+     * @param palette_banks_offset Number of palette banks to add to the palette bank of each copied map cell [0..15].
+     */
+    void blit_with_offset(const regular_bg_map_ptr& source_map, int source_column, int source_row,
+                          int columns_count, int rows_count, int destination_column, int destination_row,
+                          int tiles_offset, int palette_banks_offset);
+
     /**
      * @brief Returns the referenced tiles.
      */
@@ -477,6 +613,19 @@ struct hash<regular_bg_map_ptr>
     }
 };
 
+
+/**
+ * @brief regular_bg_map_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup regular_bg
+ * @ingroup bg_map
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<regular_bg_map_ptr> : true_type
+{
+};
+
 }
 
 #endif
@@ -536,6 +536,18 @@ struct hash<regular_bg_ptr>
     }
 };
 
+
+/**
+ * @brief regular_bg_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup regular_bg
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<regular_bg_ptr> : true_type
+{
+};
+
 }
 
 #endif
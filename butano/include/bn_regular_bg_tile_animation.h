@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_TILE_ANIMATION_H
+#define BN_REGULAR_BG_TILE_ANIMATION_H
+
+/**
+ * @file
+ * bn::regular_bg_tile_animation header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ * @ingroup action
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_limits.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_tiles_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Replaces a range of the tiles handled by a regular_bg_tiles_ptr
+ * when the animation is updated a given number of times.
+ *
+ * Only the animated range is uploaded to VRAM, and only when its frame changes,
+ * so the cost of the animation doesn't depend on the size of the maps that reference the animated tiles.
+ *
+ * Since the animated tiles are shared, all maps which reference them (water or lava tiles for example)
+ * are animated at the same time.
+ *
+ * Each frame is a group of consecutive tiles of a regular_bg_tiles_item with the same size as the animated range.
+ *
+ * @tparam MaxSize Maximum number of indexes to frames to store.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ * @ingroup action
+ */
+template<int MaxSize>
+class regular_bg_tile_animation
+{
+    static_assert(MaxSize > 1);
+
+public:
+    /**
+     * @brief Generates a regular_bg_tile_animation which loops over the given frames only once.
+     * @param tiles regular_bg_tiles_ptr to copy.
+     * @param first_tile Index of the first tile to replace (each 8BPP tile takes two indexes).
+     * @param tiles_count Number of tiles to replace (each 8BPP tile takes two indexes).
+     * @param wait_updates Number of times the animation must be updated before changing the replaced tiles.
+     * @param frames_item regular_bg_tiles_item which references the tiles of the frames.
+     * @param frames_indexes Indexes of the frames to reference in frames_item.
+     * @return The requested regular_bg_tile_animation.
+     */
+    [[nodiscard]] static regular_bg_tile_animation once(
+            const regular_bg_tiles_ptr& tiles, int first_tile, int tiles_count, int wait_updates,
+            const regular_bg_tiles_item& frames_item, const span<const uint16_t>& frames_indexes)
+    {
+        return regular_bg_tile_animation(
+                    tiles, first_tile, tiles_count, wait_updates, frames_item, false, frames_indexes);
+    }
+
+    /**
+     * @brief Generates a regular_bg_tile_animation which loops over the given frames only once.
+     * @param tiles regular_bg_tiles_ptr to move.
+     * @param first_tile Index of the first tile to replace (each 8BPP tile takes two indexes).
+     * @param tiles_count Number of tiles to replace (each 8BPP tile takes two indexes).
+     * @param wait_updates Number of times the animation must be updated before changing the replaced tiles.
+     * @param frames_item regular_bg_tiles_item which references the tiles of the frames.
+     * @param frames_indexes Indexes of the frames to reference in frames_item.
+     * @return The requested regular_bg_tile_animation.
+     */
+    [[nodiscard]] static regular_bg_tile_animation once(
+            regular_bg_tiles_ptr&& tiles, int first_tile, int tiles_count, int wait_updates,
+            const regular_bg_tiles_item& frames_item, const span<const uint16_t>& frames_indexes)
+    {
+        return regular_bg_tile_animation(
+                    move(tiles), first_tile, tiles_count, wait_updates, frames_item, false, frames_indexes);
+    }
+
+    /**
+     * @brief Generates a regular_bg_tile_animation which loops over the given frames forever.
+     * @param tiles regular_bg_tiles_ptr to copy.
+     * @param first_tile Index of the first tile to replace (each 8BPP tile takes two indexes).
+     * @param tiles_count Number of tiles to replace (each 8BPP tile takes two indexes).
+     * @param wait_updates Number of times the animation must be updated before changing the replaced tiles.
+     * @param frames_item regular_bg_tiles_item which references the tiles of the frames.
+     * @param frames_indexes Indexes of the frames to reference in frames_item.
+     * @return The requested regular_bg_tile_animation.
+     */
+    [[nodiscard]] static regular_bg_tile_animation forever(
+            const regular_bg_tiles_ptr& tiles, int first_tile, int tiles_count, int wait_updates,
+            const regular_bg_tiles_item& frames_item, const span<const uint16_t>& frames_indexes)
+    {
+        return regular_bg_tile_animation(
+                    tiles, first_tile, tiles_count, wait_updates, frames_item, true, frames_indexes);
+    }
+
+    /**
+     * @brief Generates a regular_bg_tile_animation which loops over the given frames forever.
+     * @param tiles regular_bg_tiles_ptr to move.
+     * @param first_tile Index of the first tile to replace (each 8BPP tile takes two indexes).
+     * @param tiles_count Number of tiles to replace (each 8BPP tile takes two indexes).
+     * @param wait_updates Number of times the animation must be updated before changing the replaced tiles.
+     * @param frames_item regular_bg_tiles_item which references the tiles of the frames.
+     * @param frames_indexes Indexes of the frames to reference in frames_item.
+     * @return The requested regular_bg_tile_animation.
+     */
+    [[nodiscard]] static regular_bg_tile_animation forever(
+            regular_bg_tiles_ptr&& tiles, int first_tile, int tiles_count, int wait_updates,
+            const regular_bg_tiles_item& frames_item, const span<const uint16_t>& frames_indexes)
+    {
+        return regular_bg_tile_animation(
+                    move(tiles), first_tile, tiles_count, wait_updates, frames_item, true, frames_indexes);
+    }
+
+    /**
+     * @brief Replaces the animated tiles when the given amount of update calls are done.
+     */
+    void update()
+    {
+        BN_ASSERT(! done(), "Animation is done");
+
+        if(_current_wait_updates)
+        {
+            --_current_wait_updates;
+        }
+        else
+        {
+            int current_frames_indexes_index = _current_frames_indexes_index;
+            int current_frame_index = _frames_indexes[current_frames_indexes_index];
+            _current_wait_updates = _wait_updates;
+
+            if(current_frames_indexes_index == 0 ||
+                    _frames_indexes[current_frames_indexes_index - 1] != current_frame_index)
+            {
+                _tiles.set_tiles_frame(_first_tile, frame_tiles_ref(current_frame_index));
+            }
+
+            if(_forever && current_frames_indexes_index == _frames_indexes.size() - 1)
+            {
+                _current_frames_indexes_index = 0;
+            }
+            else
+            {
+                ++_current_frames_indexes_index;
+            }
+        }
+    }
+
+    /**
+     * @brief Indicates if the animation must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_frames_indexes_index == _frames_indexes.size();
+    }
+
+    /**
+     * @brief Returns the regular_bg_tiles_ptr to modify.
+     */
+    [[nodiscard]] const regular_bg_tiles_ptr& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Returns the index of the first replaced tile.
+     */
+    [[nodiscard]] int first_tile() const
+    {
+        return _first_tile;
+    }
+
+    /**
+     * @brief Returns the number of replaced tiles.
+     */
+    [[nodiscard]] int tiles_count() const
+    {
+        return _tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of times the animation must be updated before changing the replaced tiles.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Returns the regular_bg_tiles_item which references the tiles of the frames.
+     */
+    [[nodiscard]] const regular_bg_tiles_item& frames_item() const
+    {
+        return _frames_item;
+    }
+
+    /**
+     * @brief Returns the indexes of the frames to reference in the given regular_bg_tiles_item.
+     */
+    [[nodiscard]] const ivector<uint16_t>& frames_indexes() const
+    {
+        return _frames_indexes;
+    }
+
+    /**
+     * @brief Returns the tiles of the specified frame.
+     * @param frame_index Index of the frame in the given regular_bg_tiles_item.
+     * @return Reference to the tiles of the requested frame.
+     */
+    [[nodiscard]] span<const tile> frame_tiles_ref(int frame_index) const
+    {
+        return _frames_item.tiles_ref().subspan(frame_index * _tiles_count, _tiles_count);
+    }
+
+    /**
+     * @brief Indicates if the animation can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the current index of the given frames_indexes
+     * (not the current index of the frame to reference in the given regular_bg_tiles_item).
+     */
+    [[nodiscard]] int current_index() const
+    {
+        return _current_frames_indexes_index;
+    }
+
+private:
+    regular_bg_tiles_ptr _tiles;
+    regular_bg_tiles_item _frames_item;
+    vector<uint16_t, MaxSize> _frames_indexes;
+    uint16_t _first_tile;
+    uint16_t _tiles_count;
+    uint16_t _wait_updates = 0;
+    uint16_t _current_frames_indexes_index = 0;
+    uint16_t _current_wait_updates = 0;
+    bool _forever = true;
+
+    regular_bg_tile_animation(const regular_bg_tiles_ptr& tiles, int first_tile, int tiles_count, int wait_updates,
+                              const regular_bg_tiles_item& frames_item, bool forever,
+                              const span<const uint16_t>& frames_indexes) :
+        _tiles(tiles),
+        _frames_item(frames_item),
+        _first_tile(uint16_t(first_tile)),
+        _tiles_count(uint16_t(tiles_count)),
+        _wait_updates(uint16_t(wait_updates)),
+        _forever(forever)
+    {
+        _init(first_tile, tiles_count, wait_updates, frames_indexes);
+    }
+
+    regular_bg_tile_animation(regular_bg_tiles_ptr&& tiles, int first_tile, int tiles_count, int wait_updates,
+                              const regular_bg_tiles_item& frames_item, bool forever,
+                              const span<const uint16_t>& frames_indexes) :
+        _tiles(move(tiles)),
+        _frames_item(frames_item),
+        _first_tile(uint16_t(first_tile)),
+        _tiles_count(uint16_t(tiles_count)),
+        _wait_updates(uint16_t(wait_updates)),
+        _forever(forever)
+    {
+        _init(first_tile, tiles_count, wait_updates, frames_indexes);
+    }
+
+    void _init(int first_tile, int tiles_count, int wait_updates, const span<const uint16_t>& frames_indexes)
+    {
+        BN_ASSERT(first_tile >= 0 && tiles_count > 0 && first_tile + tiles_count <= _tiles.tiles_count(),
+                   "Invalid tiles range: ", first_tile, " - ", tiles_count, " - ", _tiles.tiles_count());
+        BN_ASSERT(_frames_item.compression() == compression_type::NONE, "Compressed frames are not supported");
+        BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+        BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+                   "Too much wait updates: ", wait_updates);
+        BN_ASSERT(frames_indexes.size() > 1 && frames_indexes.size() <= MaxSize,
+                   "Invalid frames indexes: ", frames_indexes.size());
+
+        [[maybe_unused]] int frames_count = _frames_item.tiles_ref().size() / tiles_count;
+
+        for(uint16_t frame_index : frames_indexes)
+        {
+            BN_ASSERT(frame_index < frames_count, "Invalid frame index: ", frame_index, " - ", frames_count);
+
+            _frames_indexes.push_back(frame_index);
+        }
+    }
+};
+
+}
+
+#endif
@@ -219,6 +219,18 @@ public:
      */
     void reload_tiles_ref();
 
+    /**
+     * @brief Uploads the given tiles to VRAM in the next V-Blank, replacing only a range of the handled ones.
+     *
+     * The given tiles are not copied but referenced, so they should outlive the next V-Blank.
+     *
+     * Tiles uploaded to VRAM again (with reload_tiles_ref for example) override the replaced range.
+     *
+     * @param first_tile Index of the first tile to replace (each 8BPP tile takes two indexes).
+     * @param tiles_ref Reference to the tiles to upload to VRAM.
+     */
+    void set_tiles_frame(int first_tile, const span<const tile>& tiles_ref);
+
     /**
      * @brief Returns the allocated memory in VRAM
      * if this regular_bg_tiles_ptr was created with allocate or allocate_optional; bn::nullopt otherwise.
@@ -288,6 +300,19 @@ struct hash<regular_bg_tiles_ptr>
     }
 };
 
+
+/**
+ * @brief regular_bg_tiles_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<regular_bg_tiles_ptr> : true_type
+{
+};
+
 }
 
 #endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RESOURCE_BUDGET_H
+#define BN_RESOURCE_BUDGET_H
+
+/**
+ * @file
+ * bn::resource_budget header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_algorithm.h"
+#include "bn_sprite_item.h"
+#include "bn_affine_bg_item.h"
+#include "bn_regular_bg_item.h"
+#include "bn_config_resource_budget.h"
+#include "../hw/include/bn_hw_bg_blocks_constants.h"
+#include "../hw/include/bn_hw_sprite_tiles_constants.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::resource_budget
+{
+    constexpr int palettes_count = 16;
+    constexpr int colors_per_palette = 16;
+    constexpr int tiles_per_bg_block = 2048 / int(sizeof(bn::tile));
+    constexpr int cells_per_bg_block = 1024;
+
+    class usage
+    {
+
+    public:
+        int sprite_tiles = 0;
+        int sprite_bpp_4_palettes = 0;
+        int sprite_bpp_8_palettes = 0;
+        int bg_blocks = 0;
+        int bg_bpp_4_palettes = 0;
+        int bg_bpp_8_palettes = 0;
+
+        constexpr usage& operator+=(const usage& other)
+        {
+            sprite_tiles += other.sprite_tiles;
+            sprite_bpp_4_palettes += other.sprite_bpp_4_palettes;
+            sprite_bpp_8_palettes = bn::max(sprite_bpp_8_palettes, other.sprite_bpp_8_palettes);
+            bg_blocks += other.bg_blocks;
+            bg_bpp_4_palettes += other.bg_bpp_4_palettes;
+            bg_bpp_8_palettes = bn::max(bg_bpp_8_palettes, other.bg_bpp_8_palettes);
+            return *this;
+        }
+    };
+
+    [[nodiscard]] constexpr int palettes(int colors_count)
+    {
+        return (colors_count + colors_per_palette - 1) / colors_per_palette;
+    }
+
+    [[nodiscard]] constexpr int blocks(int units_count, int units_per_block)
+    {
+        return (units_count + units_per_block - 1) / units_per_block;
+    }
+
+    constexpr void add_sprite_palette(const bn::sprite_palette_item& palette_item, usage& result)
+    {
+        int palettes_count = palettes(palette_item.colors_ref().size());
+
+        if(palette_item.bpp() == bn::bpp_mode::BPP_8)
+        {
+            result.sprite_bpp_8_palettes = bn::max(result.sprite_bpp_8_palettes, palettes_count);
+        }
+        else
+        {
+            result.sprite_bpp_4_palettes += palettes_count;
+        }
+    }
+
+    constexpr void add_bg_palette(const bn::bg_palette_item& palette_item, usage& result)
+    {
+        // 4BPP palettes with more than 16 colors (multiple palette banks) are allowed:
+        int palettes_count = palettes(palette_item.colors_ref().size());
+
+        if(palette_item.bpp() == bn::bpp_mode::BPP_8)
+        {
+            result.bg_bpp_8_palettes = bn::max(result.bg_bpp_8_palettes, palettes_count);
+        }
+        else
+        {
+            result.bg_bpp_4_palettes += palettes_count;
+        }
+    }
+
+    [[nodiscard]] constexpr usage item_usage(const bn::sprite_tiles_item& tiles_item)
+    {
+        // Only one graphic is committed to VRAM at the same time:
+        usage result;
+        result.sprite_tiles = tiles_item.tiles_count_per_graphic();
+        return result;
+    }
+
+    [[nodiscard]] constexpr usage item_usage(const bn::sprite_palette_item& palette_item)
+    {
+        usage result;
+        add_sprite_palette(palette_item, result);
+        return result;
+    }
+
+    [[nodiscard]] constexpr usage item_usage(const bn::sprite_item& item)
+    {
+        usage result = item_usage(item.tiles_item());
+        add_sprite_palette(item.palette_item(), result);
+        return result;
+    }
+
+    [[nodiscard]] constexpr usage item_usage(const bn::bg_palette_item& palette_item)
+    {
+        usage result;
+        add_bg_palette(palette_item, result);
+        return result;
+    }
+
+    [[nodiscard]] constexpr usage item_usage(const bn::regular_bg_item& item)
+    {
+        // Big maps only keep a 32x32 cells canvas in VRAM:
+        const bn::regular_bg_map_item& map_item = item.map_item();
+        int map_cells = item.big() ? 32 * 32 : map_item.dimensions().width() * map_item.dimensions().height();
+
+        usage result;
+        result.bg_blocks = blocks(item.tiles_item().tiles_ref().size(), tiles_per_bg_block) +
+                blocks(map_cells, cells_per_bg_block);
+        add_bg_palette(item.palette_item(), result);
+        return result;
+    }
+
+    [[nodiscard]] constexpr usage item_usage(const bn::affine_bg_item& item)
+    {
+        // Affine map cells are bytes, and big maps only keep a 32x32 cells canvas in VRAM:
+        const bn::affine_bg_map_item& map_item = item.map_item();
+        int map_cells = item.big() ? 32 * 32 : map_item.dimensions().width() * map_item.dimensions().height();
+
+        usage result;
+        result.bg_blocks = blocks(item.tiles_item().tiles_ref().size(), tiles_per_bg_block) +
+                blocks(map_cells / 2, cells_per_bg_block);
+        add_bg_palette(item.palette_item(), result);
+        return result;
+    }
+}
+
+/// @endcond
+
+
+namespace bn
+{
+
+/**
+ * @brief Checks at compile time if the given items fit in VRAM and in the palette banks at the same time.
+ *
+ * The generated `bn::sprite_items`, `bn::regular_bg_items` and `bn::affine_bg_items` items (and sprite tiles,
+ * sprite palette and BG palette items) can be checked, taking into account the resources reserved with
+ * @ref BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_TILES, @ref BN_CFG_RESOURCE_BUDGET_RESERVED_BG_BLOCKS,
+ * @ref BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_PALETTES and @ref BN_CFG_RESOURCE_BUDGET_RESERVED_BG_PALETTES.
+ *
+ * bn::resource_budget::fits static_asserts if the items don't fit, for example:
+ *
+ * @code{.cpp}
+ * static_assert(bn::resource_budget<bn::sprite_items::hero, bn::regular_bg_items::sky>::fits());
+ * @endcode
+ *
+ * The budget is an upper bound: only one graphic of each sprite item is counted,
+ * but palettes shared by several items are counted once per item, and VRAM fragmentation is not counted.
+ *
+ * @tparam Items Items used at the same time by a scene.
+ *
+ * @ingroup core
+ */
+template<const auto&... Items>
+class resource_budget
+{
+    static constexpr _bn::resource_budget::usage _usage()
+    {
+        _bn::resource_budget::usage result;
+        ((result += _bn::resource_budget::item_usage(Items)), ...);
+        return result;
+    }
+
+public:
+    /**
+     * @brief Returns the number of sprite tiles required by the items, including the reserved ones.
+     */
+    [[nodiscard]] static constexpr int sprite_tiles_count()
+    {
+        return _usage().sprite_tiles + BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_TILES;
+    }
+
+    /**
+     * @brief Returns the number of BG blocks (2KB each) required by the items tiles and maps,
+     * including the reserved ones.
+     */
+    [[nodiscard]] static constexpr int bg_blocks_count()
+    {
+        return _usage().bg_blocks + BN_CFG_RESOURCE_BUDGET_RESERVED_BG_BLOCKS;
+    }
+
+    /**
+     * @brief Returns the number of 16 color sprite palette banks required by the items, including the reserved ones.
+     *
+     * 8BPP palettes share the first banks, so only the biggest one is counted.
+     */
+    [[nodiscard]] static constexpr int sprite_palettes_count()
+    {
+        _bn::resource_budget::usage usage = _usage();
+        return usage.sprite_bpp_4_palettes + usage.sprite_bpp_8_palettes +
+                BN_CFG_RESOURCE_BUDGET_RESERVED_SPRITE_PALETTES;
+    }
+
+    /**
+     * @brief Returns the number of 16 color BG palette banks required by the items, including the reserved ones.
+     *
+     * 8BPP palettes share the first banks, so only the biggest one is counted.
+     */
+    [[nodiscard]] static constexpr int bg_palettes_count()
+    {
+        _bn::resource_budget::usage usage = _usage();
+        return usage.bg_bpp_4_palettes + usage.bg_bpp_8_palettes + BN_CFG_RESOURCE_BUDGET_RESERVED_BG_PALETTES;
+    }
+
+    /**
+     * @brief Indicates if the items fit in VRAM and in the palette banks at the same time.
+     *
+     * If they don't fit, it static_asserts with the exhausted resource instead of returning `false`.
+     */
+    [[nodiscard]] static constexpr bool fits()
+    {
+        static_assert(sprite_tiles_count() <= hw::sprite_tiles::tiles_count(), "Sprite tiles don't fit in VRAM");
+        static_assert(bg_blocks_count() <= hw::bg_maps::blocks_count(), "BG tiles and maps don't fit in VRAM");
+        static_assert(sprite_palettes_count() <= _bn::resource_budget::palettes_count,
+                      "Sprite palettes don't fit in the sprite palette banks");
+        static_assert(bg_palettes_count() <= _bn::resource_budget::palettes_count,
+                      "BG palettes don't fit in the BG palette banks");
+
+        return true;
+    }
+};
+
+}
+
+#endif
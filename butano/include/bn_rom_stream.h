@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_ROM_STREAM_H
+#define BN_ROM_STREAM_H
+
+/**
+ * @file
+ * bn::rom_stream header file.
+ *
+ * @ingroup game_pak
+ */
+
+#include "bn_span.h"
+#include "bn_assert.h"
+#include "bn_type_traits.h"
+
+namespace bn
+{
+
+/**
+ * @brief Sequential reader of Game Pak ROM data.
+ *
+ * Game Pak ROM accesses are much faster when they are sequential, so small reads are served from a RAM buffer
+ * which is refilled in bursts of consecutive ROM words, and big reads are copied directly in bursts.
+ *
+ * Refills are done with code placed in IWRAM, so instruction fetches don't break the sequential ROM accesses
+ * and the Game Pak prefetch buffer (see BN_CFG_GAME_PAK_PREFETCH_ENABLED) is kept for the code running from ROM.
+ *
+ * The read data is not copied but referenced, so it should outlive the rom_stream to avoid dangling references.
+ *
+ * @ingroup game_pak
+ */
+class rom_stream
+{
+
+public:
+    /**
+     * @brief Returns the size in bytes of the RAM buffer used to serve small reads.
+     */
+    [[nodiscard]] constexpr static int buffer_size()
+    {
+        return 64;
+    }
+
+    /**
+     * @brief Constructor.
+     * @param data_ref Referenced data to read.
+     *
+     * The read data is not copied but referenced, so it should outlive the rom_stream to avoid dangling references.
+     */
+    explicit rom_stream(const span<const uint8_t>& data_ref) :
+        _data(data_ref.data()),
+        _size(data_ref.size())
+    {
+    }
+
+    /**
+     * @brief Returns the referenced data.
+     */
+    [[nodiscard]] span<const uint8_t> data_ref() const
+    {
+        return span<const uint8_t>(_data, _size);
+    }
+
+    /**
+     * @brief Returns the size in bytes of the referenced data.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the position in bytes of the next read.
+     */
+    [[nodiscard]] int position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Returns the number of bytes which have not been read yet.
+     */
+    [[nodiscard]] int remaining_bytes() const
+    {
+        return _size - _position;
+    }
+
+    /**
+     * @brief Indicates if all bytes have been read.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _position == _size;
+    }
+
+    /**
+     * @brief Sets the position in bytes of the next read.
+     * @param position Position in the range [0..size()].
+     */
+    void seek(int position)
+    {
+        BN_ASSERT(position >= 0 && position <= _size, "Invalid position: ", position, " - ", _size);
+
+        _position = position;
+    }
+
+    /**
+     * @brief Skips the given number of bytes.
+     * @param bytes Number of bytes to skip, in the range [0..remaining_bytes()].
+     */
+    void skip(int bytes)
+    {
+        BN_ASSERT(bytes >= 0 && bytes <= remaining_bytes(), "Invalid bytes: ", bytes, " - ", remaining_bytes());
+
+        _position += bytes;
+    }
+
+    /**
+     * @brief Reads the given number of bytes.
+     * @param bytes Number of bytes to read, in the range [0..remaining_bytes()].
+     * @param destination Memory location of the read bytes.
+     */
+    void read(int bytes, void* destination);
+
+    /**
+     * @brief Reads an unsigned 8-bit integer.
+     */
+    [[nodiscard]] uint8_t read_u8()
+    {
+        return *_buffered(1);
+    }
+
+    /**
+     * @brief Reads an unsigned 16-bit integer in little endian format.
+     */
+    [[nodiscard]] uint16_t read_u16()
+    {
+        const uint8_t* bytes = _buffered(2);
+        return uint16_t(bytes[0] | (bytes[1] << 8));
+    }
+
+    /**
+     * @brief Reads an unsigned 32-bit integer in little endian format.
+     */
+    [[nodiscard]] unsigned read_u32()
+    {
+        const uint8_t* bytes = _buffered(4);
+        return unsigned(bytes[0]) | (unsigned(bytes[1]) << 8) | (unsigned(bytes[2]) << 16) |
+                (unsigned(bytes[3]) << 24);
+    }
+
+    /**
+     * @brief Reads a trivially copyable object.
+     */
+    template<typename Type>
+    [[nodiscard]] Type read()
+    {
+        static_assert(is_trivially_copyable_v<Type>, "Type is not trivially copyable");
+
+        Type result;
+        read(int(sizeof(Type)), &result);
+        return result;
+    }
+
+private:
+    alignas(int) uint8_t _buffer[64];
+    const uint8_t* _data;
+    int _size;
+    int _position = 0;
+    int _buffer_position = 0;
+    int _buffer_bytes = 0;
+
+    [[nodiscard]] const uint8_t* _buffered(int bytes)
+    {
+        BN_ASSERT(bytes <= remaining_bytes(), "Not enough bytes: ", bytes, " - ", remaining_bytes());
+
+        int buffer_index = _position - _buffer_position;
+
+        if(buffer_index < 0 || buffer_index + bytes > _buffer_bytes) [[unlikely]]
+        {
+            _refill();
+            buffer_index = 0;
+        }
+
+        _position += bytes;
+        return _buffer + buffer_index;
+    }
+
+    BN_CODE_IWRAM void _refill();
+};
+
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RTC_H
+#define BN_RTC_H
+
+/**
+ * @file
+ * bn::rtc header file.
+ *
+ * @ingroup rtc
+ */
+
+#include "bn_optional.h"
+#include "bn_rtc_time.h"
+
+/**
+ * @brief Real-time clock related functions.
+ *
+ * Reading the cart real-time clock is slow, so the date and time are read from it once per second at most.
+ * Reads are split across multiple frames, and between them the last read date and time are advanced
+ * with a hardware timer, so retrieving the current date and time costs almost nothing.
+ *
+ * The real-time clock is disabled while the GBA is asleep (see bn::core::sleep),
+ * so the date and time are read again when it is woken up.
+ *
+ * Rumble and the real-time clock can't be used at the same time.
+ *
+ * @ingroup rtc
+ */
+namespace bn::rtc
+{
+    /**
+     * @brief Indicates if the cart has a real-time clock or not.
+     *
+     * The real-time clock is probed the first time this function is called,
+     * and it is enabled in 24 hours mode if needed.
+     */
+    [[nodiscard]] bool active();
+
+    /**
+     * @brief Returns the current date and time if the cart has a real-time clock; bn::nullopt otherwise.
+     *
+     * The first time this function is called the date and time are read synchronously,
+     * and then they are updated asynchronously once per second by bn::core::update.
+     */
+    [[nodiscard]] optional<rtc_time> time();
+}
+
+#endif
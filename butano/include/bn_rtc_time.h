@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_RTC_TIME_H
+#define BN_RTC_TIME_H
+
+/**
+ * @file
+ * bn::rtc_time header file.
+ *
+ * @ingroup rtc
+ */
+
+#include "bn_assert.h"
+
+namespace bn
+{
+
+/**
+ * @brief Date and time provided by a cart real-time clock.
+ *
+ * @ingroup rtc
+ */
+class rtc_time
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param year Year in the range [2000, 2099].
+     * @param month Month in the range [1, 12].
+     * @param month_day Day of the month in the range [1, days_in_month(year, month)].
+     * @param week_day Day of the week in the range [0, 6].
+     * @param hour Hour in the range [0, 23].
+     * @param minute Minute in the range [0, 59].
+     * @param second Second in the range [0, 59].
+     */
+    constexpr rtc_time(int year, int month, int month_day, int week_day, int hour, int minute, int second) :
+        _year(int16_t(year)),
+        _month(int8_t(month)),
+        _month_day(int8_t(month_day)),
+        _week_day(int8_t(week_day)),
+        _hour(int8_t(hour)),
+        _minute(int8_t(minute)),
+        _second(int8_t(second))
+    {
+        BN_ASSERT(year >= 2000 && year <= 2099, "Invalid year: ", year);
+        BN_ASSERT(month >= 1 && month <= 12, "Invalid month: ", month);
+        BN_ASSERT(month_day >= 1 && month_day <= days_in_month(year, month), "Invalid month day: ", month_day);
+        BN_ASSERT(week_day >= 0 && week_day <= 6, "Invalid week day: ", week_day);
+        BN_ASSERT(hour >= 0 && hour <= 23, "Invalid hour: ", hour);
+        BN_ASSERT(minute >= 0 && minute <= 59, "Invalid minute: ", minute);
+        BN_ASSERT(second >= 0 && second <= 59, "Invalid second: ", second);
+    }
+
+    /**
+     * @brief Returns the number of days of the given month.
+     * @param year Year in the range [2000, 2099].
+     * @param month Month in the range [1, 12].
+     */
+    [[nodiscard]] constexpr static int days_in_month(int year, int month)
+    {
+        if(month == 2)
+        {
+            // All years multiple of 4 in the range [2000, 2099] are leap years:
+            return year % 4 == 0 ? 29 : 28;
+        }
+
+        return month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31;
+    }
+
+    /**
+     * @brief Returns the year, in the range [2000, 2099].
+     */
+    [[nodiscard]] constexpr int year() const
+    {
+        return _year;
+    }
+
+    /**
+     * @brief Returns the month, in the range [1, 12].
+     */
+    [[nodiscard]] constexpr int month() const
+    {
+        return _month;
+    }
+
+    /**
+     * @brief Returns the day of the month, in the range [1, 31].
+     */
+    [[nodiscard]] constexpr int month_day() const
+    {
+        return _month_day;
+    }
+
+    /**
+     * @brief Returns the day of the week, in the range [0, 6].
+     *
+     * Which week day is the first one depends on how the real-time clock was set.
+     */
+    [[nodiscard]] constexpr int week_day() const
+    {
+        return _week_day;
+    }
+
+    /**
+     * @brief Returns the hour, in the range [0, 23].
+     */
+    [[nodiscard]] constexpr int hour() const
+    {
+        return _hour;
+    }
+
+    /**
+     * @brief Returns the minute, in the range [0, 59].
+     */
+    [[nodiscard]] constexpr int minute() const
+    {
+        return _minute;
+    }
+
+    /**
+     * @brief Returns the second, in the range [0, 59].
+     */
+    [[nodiscard]] constexpr int second() const
+    {
+        return _second;
+    }
+
+    /**
+     * @brief Returns the seconds elapsed since the start of the day.
+     */
+    [[nodiscard]] constexpr int day_seconds() const
+    {
+        return (((_hour * 60) + _minute) * 60) + _second;
+    }
+
+    /**
+     * @brief Returns a copy of this date and time advanced by the given number of seconds.
+     * @param seconds Number of seconds to advance (it must be >= 0).
+     *
+     * The year wraps around to 2000 after 2099.
+     */
+    [[nodiscard]] constexpr rtc_time advanced(int seconds) const
+    {
+        BN_ASSERT(seconds >= 0, "Invalid seconds: ", seconds);
+
+        int second = _second + seconds;
+        int minute = _minute + (second / 60);
+        int hour = _hour + (minute / 60);
+        int days = hour / 24;
+        int year = _year;
+        int month = _month;
+        int month_day = _month_day + days;
+        int week_day = (_week_day + days) % 7;
+
+        for(int month_days = days_in_month(year, month); month_day > month_days;
+            month_days = days_in_month(year, month))
+        {
+            month_day -= month_days;
+            ++month;
+
+            if(month > 12)
+            {
+                month = 1;
+                year = year == 2099 ? 2000 : year + 1;
+            }
+        }
+
+        return rtc_time(year, month, month_day, week_day, hour % 24, minute % 60, second % 60);
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a First rtc_time to compare.
+     * @param b Second rtc_time to compare.
+     * @return `true` if the first rtc_time is equal to the second one, otherwise `false`.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const rtc_time& a, const rtc_time& b) = default;
+
+private:
+    int16_t _year;
+    int8_t _month;
+    int8_t _month_day;
+    int8_t _week_day;
+    int8_t _hour;
+    int8_t _minute;
+    int8_t _second;
+};
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SAVE_STORE_H
+#define BN_SAVE_STORE_H
+
+/**
+ * @file
+ * bn::isave_store and bn::save_store header file.
+ *
+ * @ingroup sram
+ */
+
+#include "bn_sram.h"
+#include "bn_optional_fwd.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::save_store.
+ *
+ * It stores records in two SRAM slots, each one with a header containing a sequence number
+ * and a CRC-32 checksum of the record.
+ *
+ * Records are always written to the inactive slot, and its header is written after the record,
+ * so the previous record survives if the GBA is turned off while saving.
+ *
+ * Only the slot headers are read on construction. The record checksum is validated when it is loaded,
+ * and the other slot is loaded if it doesn't match.
+ *
+ * @ingroup sram
+ */
+class isave_store
+{
+
+public:
+    isave_store(const isave_store& other) = delete;
+
+    isave_store& operator=(const isave_store& other) = delete;
+
+    /**
+     * @brief Returns the SRAM size in bytes required to store records of the given size.
+     */
+    [[nodiscard]] static constexpr int sram_size(int record_size)
+    {
+        return _slot_size(record_size) * 2;
+    }
+
+    /**
+     * @brief Returns the size in bytes of each record.
+     */
+    [[nodiscard]] int record_size() const
+    {
+        return _record_size;
+    }
+
+    /**
+     * @brief Returns the SRAM offset of the first slot.
+     */
+    [[nodiscard]] int offset() const
+    {
+        return _offset;
+    }
+
+    /**
+     * @brief Returns the index of the slot which stores the last saved record,
+     * or `bn::nullopt` if there's no valid record.
+     */
+    [[nodiscard]] optional<int> active_slot() const;
+
+    /**
+     * @brief Returns the sequence number of the last saved record, or 0 if there's no valid record.
+     */
+    [[nodiscard]] unsigned sequence() const
+    {
+        return _sequence;
+    }
+
+    /**
+     * @brief Indicates if there's no valid record header.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _active_slot < 0;
+    }
+
+    /**
+     * @brief Invalidates the headers of both slots.
+     */
+    void clear();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isave_store(int record_size, int offset);
+
+    [[nodiscard]] bool _load(void* destination);
+
+    void _save(const void* source);
+
+    /// @endcond
+
+private:
+    static constexpr int _header_size = 16;
+
+    int _record_size;
+    int _offset;
+    unsigned _sequence = 0;
+    int _active_slot = -1;
+
+    [[nodiscard]] static constexpr int _slot_size(int record_size)
+    {
+        return _header_size + ((record_size + 3) & ~3);
+    }
+
+    [[nodiscard]] int _slot_offset(int slot) const
+    {
+        return _offset + (slot * _slot_size(_record_size));
+    }
+
+    [[nodiscard]] bool _read_header(int slot, unsigned& sequence, unsigned& crc) const;
+
+    [[nodiscard]] bool _load_slot(int slot, void* destination) const;
+};
+
+
+/**
+ * @brief Stores values of the given type in two SRAM slots, so they survive power loss while saving.
+ *
+ * @tparam Type Type of the records to store. It must be trivially copyable.
+ *
+ * @ingroup sram
+ */
+template<typename Type>
+class save_store : public isave_store
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+    static_assert(sram_size(int(sizeof(Type))) <= sram::size(), "Size is too high");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset SRAM offset of the first slot.
+     *
+     * Only the slot headers are read from SRAM.
+     */
+    explicit save_store(int offset = 0) :
+        isave_store(int(sizeof(Type)), offset)
+    {
+    }
+
+    /**
+     * @brief Loads the last saved record.
+     * @param destination The record is copied into this value.
+     * @return `true` if a record with a valid checksum has been found, otherwise `false`.
+     */
+    [[nodiscard]] bool load(Type& destination)
+    {
+        return _load(&destination);
+    }
+
+    /**
+     * @brief Saves the given record into the inactive slot.
+     * @param source Record to save.
+     */
+    void save(const Type& source)
+    {
+        _save(&source);
+    }
+};
+
+}
+
+#endif
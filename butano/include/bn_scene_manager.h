@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SCENE_MANAGER_H
+#define BN_SCENE_MANAGER_H
+
+/**
+ * @file
+ * bn::scene_manager header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_vector.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_scene_resources.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_config_scene_manager.h"
+
+namespace bn
+{
+
+/**
+ * @brief Keeps the resources of the current scene resident in VRAM and in the palettes RAM.
+ *
+ * When the next scene is loaded, the resources shared with the current one stay resident,
+ * the ones used only by the current scene are released
+ * and the ones used only by the next scene are created (regular BGs are prefetched over several frames).
+ *
+ * Sprites and backgrounds created later from the resident items find their data already in VRAM,
+ * so scene transitions are short and predictable.
+ *
+ * @ingroup core
+ */
+class scene_manager
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    scene_manager() = default;
+
+    scene_manager(const scene_manager& other) = delete;
+
+    scene_manager& operator=(const scene_manager& other) = delete;
+
+    /**
+     * @brief Returns the number of resident sprite items.
+     */
+    [[nodiscard]] int sprite_items_count() const
+    {
+        return _sprite_items.size();
+    }
+
+    /**
+     * @brief Returns the number of resident regular BG items.
+     */
+    [[nodiscard]] int regular_bg_items_count() const
+    {
+        return _regular_bg_items.size();
+    }
+
+    /**
+     * @brief Returns the number of resident additional sprite palette items.
+     */
+    [[nodiscard]] int sprite_palette_items_count() const
+    {
+        return _sprite_palette_items.size();
+    }
+
+    /**
+     * @brief Returns the number of resident additional BG palette items.
+     */
+    [[nodiscard]] int bg_palette_items_count() const
+    {
+        return _bg_palette_items.size();
+    }
+
+    /**
+     * @brief Releases the resources used only by the current scene and creates the ones used only by the given one.
+     * @param resources Resources of the next scene.
+     * In debug builds it is verified that they fit in VRAM and in the palettes RAM (see scene_resources::fits).
+     * @param max_bg_bytes_per_frame Maximum number of bytes of regular BG tiles and maps to upload to VRAM each frame.
+     */
+    void load(const scene_resources& resources, int max_bg_bytes_per_frame);
+
+    /**
+     * @brief Releases all resident resources.
+     */
+    void clear();
+
+private:
+    struct sprite_item_resources
+    {
+        sprite_item item;
+        sprite_tiles_ptr tiles;
+        sprite_palette_ptr palette;
+    };
+
+    struct regular_bg_item_resources
+    {
+        regular_bg_item item;
+        regular_bg_map_ptr map;
+    };
+
+    struct sprite_palette_item_resources
+    {
+        sprite_palette_item item;
+        sprite_palette_ptr palette;
+    };
+
+    struct bg_palette_item_resources
+    {
+        bg_palette_item item;
+        bg_palette_ptr palette;
+    };
+
+    vector<sprite_item_resources, BN_CFG_SCENE_MANAGER_MAX_ITEMS> _sprite_items;
+    vector<regular_bg_item_resources, BN_CFG_SCENE_MANAGER_MAX_ITEMS> _regular_bg_items;
+    vector<sprite_palette_item_resources, BN_CFG_SCENE_MANAGER_MAX_ITEMS> _sprite_palette_items;
+    vector<bg_palette_item_resources, BN_CFG_SCENE_MANAGER_MAX_ITEMS> _bg_palette_items;
+};
+
+}
+
+#endif
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SCENE_RESOURCES_H
+#define BN_SCENE_RESOURCES_H
+
+/**
+ * @file
+ * bn::scene_resources header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_span.h"
+#include "bn_sprite_item.h"
+#include "bn_regular_bg_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Set of resources used by a scene, kept resident in VRAM by a bn::scene_manager.
+ *
+ * Since items are usually constexpr, the VRAM and palettes budget of a scene can be validated at build time:
+ *
+ * @code{.cpp}
+ * constexpr bn::sprite_item title_sprite_items[] = { bn::sprite_items::logo, bn::sprite_items::cursor };
+ * constexpr bn::regular_bg_item title_bg_items[] = { bn::regular_bg_items::title };
+ * constexpr bn::scene_resources title_resources(title_sprite_items, title_bg_items);
+ * static_assert(title_resources.fits());
+ * @endcode
+ *
+ * Compressed items are accounted by the size of their referenced data instead of by their decompressed size.
+ *
+ * @ingroup core
+ */
+class scene_resources
+{
+
+public:
+    /**
+     * @brief Returns the number of 4BPP tiles available to sprites.
+     */
+    [[nodiscard]] constexpr static int max_sprite_tiles_count()
+    {
+        return 1024;
+    }
+
+    /**
+     * @brief Returns the number of 2KB blocks available to BG tiles and maps.
+     */
+    [[nodiscard]] constexpr static int max_bg_blocks_count()
+    {
+        return 32;
+    }
+
+    /**
+     * @brief Returns the number of 16 colors palettes available to sprites or to BGs.
+     */
+    [[nodiscard]] constexpr static int max_palettes_count()
+    {
+        return 16;
+    }
+
+    /**
+     * @brief Constructor.
+     * @param sprite_items Sprite items whose first tile set and palette are kept resident.
+     * @param regular_bg_items Regular BG items whose tiles, map and palette are kept resident.
+     * @param sprite_palette_items Additional sprite palette items kept resident.
+     * @param bg_palette_items Additional BG palette items kept resident.
+     *
+     * Items are not copied but referenced, so they should outlive the scene_resources to avoid dangling references.
+     */
+    constexpr scene_resources(const span<const sprite_item>& sprite_items,
+                              const span<const regular_bg_item>& regular_bg_items = span<const regular_bg_item>(),
+                              const span<const sprite_palette_item>& sprite_palette_items =
+                                    span<const sprite_palette_item>(),
+                              const span<const bg_palette_item>& bg_palette_items = span<const bg_palette_item>()) :
+        _sprite_items(sprite_items),
+        _regular_bg_items(regular_bg_items),
+        _sprite_palette_items(sprite_palette_items),
+        _bg_palette_items(bg_palette_items)
+    {
+    }
+
+    /**
+     * @brief Returns the referenced sprite items.
+     */
+    [[nodiscard]] constexpr const span<const sprite_item>& sprite_items() const
+    {
+        return _sprite_items;
+    }
+
+    /**
+     * @brief Returns the referenced regular BG items.
+     */
+    [[nodiscard]] constexpr const span<const regular_bg_item>& regular_bg_items() const
+    {
+        return _regular_bg_items;
+    }
+
+    /**
+     * @brief Returns the referenced additional sprite palette items.
+     */
+    [[nodiscard]] constexpr const span<const sprite_palette_item>& sprite_palette_items() const
+    {
+        return _sprite_palette_items;
+    }
+
+    /**
+     * @brief Returns the referenced additional BG palette items.
+     */
+    [[nodiscard]] constexpr const span<const bg_palette_item>& bg_palette_items() const
+    {
+        return _bg_palette_items;
+    }
+
+    /**
+     * @brief Returns the number of 4BPP sprite tiles required by the scene.
+     */
+    [[nodiscard]] constexpr int sprite_tiles_count() const
+    {
+        int result = 0;
+
+        for(int index = 0, limit = _sprite_items.size(); index < limit; ++index)
+        {
+            const sprite_tiles_item& tiles_item = _sprite_items[index].tiles_item();
+            bool repeated = false;
+
+            for(int other_index = 0; other_index < index; ++other_index)
+            {
+                repeated |= _sprite_items[other_index].tiles_item().tiles_ref().data() == tiles_item.tiles_ref().data();
+            }
+
+            if(! repeated)
+            {
+                result += tiles_item.tiles_count_per_graphic();
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of 2KB BG blocks required by the scene.
+     */
+    [[nodiscard]] constexpr int bg_blocks_count() const
+    {
+        constexpr int tiles_per_block = 2048 / int(sizeof(tile));
+        constexpr int cells_per_block = 2048 / int(sizeof(regular_bg_map_cell));
+
+        int result = 0;
+
+        for(int index = 0, limit = _regular_bg_items.size(); index < limit; ++index)
+        {
+            const regular_bg_item& item = _regular_bg_items[index];
+            const regular_bg_tiles_item& tiles_item = item.tiles_item();
+            const regular_bg_map_item& map_item = item.map_item();
+            bool repeated_tiles = false;
+            bool repeated_map = false;
+
+            for(int other_index = 0; other_index < index; ++other_index)
+            {
+                const regular_bg_item& other_item = _regular_bg_items[other_index];
+                repeated_tiles |= other_item.tiles_item().tiles_ref().data() == tiles_item.tiles_ref().data();
+                repeated_map |= &other_item.map_item().cells_ref() == &map_item.cells_ref();
+            }
+
+            if(! repeated_tiles)
+            {
+                result += (tiles_item.tiles_ref().size() + tiles_per_block - 1) / tiles_per_block;
+            }
+
+            if(! repeated_map)
+            {
+                const size& dimensions = map_item.dimensions();
+                int cells = dimensions.width() * dimensions.height();
+                result += (cells + cells_per_block - 1) / cells_per_block;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of 16 colors sprite palettes required by the scene.
+     */
+    [[nodiscard]] constexpr int sprite_palettes_count() const
+    {
+        int result = 0;
+
+        for(int index = 0, limit = _sprite_items.size(); index < limit; ++index)
+        {
+            const sprite_palette_item& palette_item = _sprite_items[index].palette_item();
+            bool repeated = false;
+
+            for(int other_index = 0; other_index < index; ++other_index)
+            {
+                repeated |= _sprite_items[other_index].palette_item().colors_ref().data() ==
+                        palette_item.colors_ref().data();
+            }
+
+            if(! repeated)
+            {
+                result += _palettes_count(palette_item.colors_ref().size());
+            }
+        }
+
+        for(int index = 0, limit = _sprite_palette_items.size(); index < limit; ++index)
+        {
+            const sprite_palette_item& palette_item = _sprite_palette_items[index];
+            bool repeated = false;
+
+            for(const sprite_item& item : _sprite_items)
+            {
+                repeated |= item.palette_item().colors_ref().data() == palette_item.colors_ref().data();
+            }
+
+            for(int other_index = 0; other_index < index; ++other_index)
+            {
+                repeated |= _sprite_palette_items[other_index].colors_ref().data() == palette_item.colors_ref().data();
+            }
+
+            if(! repeated)
+            {
+                result += _palettes_count(palette_item.colors_ref().size());
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of 16 colors BG palettes required by the scene.
+     */
+    [[nodiscard]] constexpr int bg_palettes_count() const
+    {
+        int result = 0;
+
+        for(int index = 0, limit = _regular_bg_items.size(); index < limit; ++index)
+        {
+            const bg_palette_item& palette_item = _regular_bg_items[index].palette_item();
+            bool repeated = false;
+
+            for(int other_index = 0; other_index < index; ++other_index)
+            {
+                repeated |= _regular_bg_items[other_index].palette_item().colors_ref().data() ==
+                        palette_item.colors_ref().data();
+            }
+
+            if(! repeated)
+            {
+                result += _palettes_count(palette_item.colors_ref().size());
+            }
+        }
+
+        for(int index = 0, limit = _bg_palette_items.size(); index < limit; ++index)
+        {
+            const bg_palette_item& palette_item = _bg_palette_items[index];
+            bool repeated = false;
+
+            for(const regular_bg_item& item : _regular_bg_items)
+            {
+                repeated |= item.palette_item().colors_ref().data() == palette_item.colors_ref().data();
+            }
+
+            for(int other_index = 0; other_index < index; ++other_index)
+            {
+                repeated |= _bg_palette_items[other_index].colors_ref().data() == palette_item.colors_ref().data();
+            }
+
+            if(! repeated)
+            {
+                result += _palettes_count(palette_item.colors_ref().size());
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Indicates if all resources of the scene fit in VRAM and in the palettes RAM at the same time or not.
+     */
+    [[nodiscard]] constexpr bool fits() const
+    {
+        return sprite_tiles_count() <= max_sprite_tiles_count() && bg_blocks_count() <= max_bg_blocks_count() &&
+                sprite_palettes_count() <= max_palettes_count() && bg_palettes_count() <= max_palettes_count();
+    }
+
+private:
+    span<const sprite_item> _sprite_items;
+    span<const regular_bg_item> _regular_bg_items;
+    span<const sprite_palette_item> _sprite_palette_items;
+    span<const bg_palette_item> _bg_palette_items;
+
+    [[nodiscard]] constexpr static int _palettes_count(int colors_count)
+    {
+        return (colors_count + 15) / 16;
+    }
+};
+
+}
+
+#endif
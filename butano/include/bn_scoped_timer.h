@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SCOPED_TIMER_H
+#define BN_SCOPED_TIMER_H
+
+/**
+ * @file
+ * bn::scoped_timer header file.
+ *
+ * @ingroup timer
+ */
+
+#include "bn_timer.h"
+
+namespace bn
+{
+
+/**
+ * @brief Adds the number of ticks elapsed during its lifetime to the referenced counter when it is destroyed.
+ *
+ * Example:
+ *
+ * @code{.cpp}
+ * int update_ticks = 0;
+ *
+ * {
+ *     bn::scoped_timer update_timer(update_ticks);
+ *     update();
+ * }
+ * @endcode
+ *
+ * @ingroup timer
+ */
+class scoped_timer
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param ticks_ref Reference to the counter to which add the elapsed ticks.
+     * It should outlive the scoped_timer to avoid dangling references.
+     */
+    explicit scoped_timer(int& ticks_ref) :
+        _ticks_ref(ticks_ref)
+    {
+    }
+
+    scoped_timer(const scoped_timer& other) = delete;
+
+    scoped_timer& operator=(const scoped_timer& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * It adds the elapsed ticks to the referenced counter.
+     */
+    ~scoped_timer()
+    {
+        _ticks_ref += _timer.elapsed_ticks();
+    }
+
+    /**
+     * @brief Returns the number of ticks elapsed since this scoped_timer was built.
+     */
+    [[nodiscard]] int elapsed_ticks() const
+    {
+        return _timer.elapsed_ticks();
+    }
+
+private:
+    int& _ticks_ref;
+    timer _timer;
+};
+
+}
+
+#endif
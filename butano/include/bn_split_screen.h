@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPLIT_SCREEN_H
+#define BN_SPLIT_SCREEN_H
+
+/**
+ * @file
+ * bn::isplit_screen and bn::split_screen implementation header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup hblank_effect
+ */
+
+#include "bn_array.h"
+#include "bn_point.h"
+#include "bn_vector.h"
+#include "bn_display.h"
+#include "bn_optional.h"
+#include "bn_camera_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_regular_bg_attributes.h"
+#include "bn_regular_bg_position_hbe_ptr.h"
+#include "bn_regular_bg_attributes_hbe_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::split_screen.
+ *
+ * A split screen divides the screen in horizontal bands (regions) in which a regular background is shown
+ * with its own position, camera and attributes, generating and caching the required H-Blank effects.
+ *
+ * Each region starts in a screen horizontal line and ends where the next one starts.
+ * Lines above the first region show the regular background as usual.
+ *
+ * To split more than one background (for example, to show two independent views of the same level),
+ * one split screen must be created per background, sharing the same cameras.
+ *
+ * @ingroup regular_bg
+ * @ingroup hblank_effect
+ */
+class isplit_screen
+{
+
+public:
+    isplit_screen(const isplit_screen& other) = delete;
+
+    isplit_screen& operator=(const isplit_screen& other) = delete;
+
+    /**
+     * @brief Returns the regular background modified by this split screen.
+     */
+    [[nodiscard]] const regular_bg_ptr& bg() const
+    {
+        return _bg;
+    }
+
+    /**
+     * @brief Returns the number of regions.
+     */
+    [[nodiscard]] int regions_count() const
+    {
+        return _regions.size();
+    }
+
+    /**
+     * @brief Returns the maximum number of regions.
+     */
+    [[nodiscard]] int max_regions_count() const
+    {
+        return _regions.max_size();
+    }
+
+    /**
+     * @brief Adds a new region at the bottom of the screen.
+     * @param top_line First screen horizontal line of the region, in the range [1, display::height() - 1].
+     * It must be greater than the top line of the last region.
+     * @param position Position of the regular background in the region.
+     */
+    void add_region(int top_line, const fixed_point& position);
+
+    /**
+     * @brief Returns the first screen horizontal line of the region with the given index.
+     */
+    [[nodiscard]] int region_top_line(int index) const
+    {
+        return _region(index).top_line;
+    }
+
+    /**
+     * @brief Returns the position of the regular background in the region with the given index.
+     */
+    [[nodiscard]] const fixed_point& region_position(int index) const
+    {
+        return _region(index).position;
+    }
+
+    /**
+     * @brief Sets the position of the regular background in the region with the given index.
+     */
+    void set_region_position(int index, const fixed_point& position)
+    {
+        _region(index).position = position;
+    }
+
+    /**
+     * @brief Returns the camera_ptr attached to the region with the given index (if any).
+     */
+    [[nodiscard]] const optional<camera_ptr>& region_camera(int index) const
+    {
+        return _region(index).camera;
+    }
+
+    /**
+     * @brief Sets the camera_ptr attached to the region with the given index.
+     */
+    void set_region_camera(int index, const camera_ptr& camera)
+    {
+        _region(index).camera = camera;
+    }
+
+    /**
+     * @brief Removes the camera_ptr attached to the region with the given index (if any).
+     */
+    void remove_region_camera(int index)
+    {
+        _region(index).camera.reset();
+    }
+
+    /**
+     * @brief Returns the attributes of the regular background in the region with the given index (if any).
+     *
+     * If a region has no attributes, the regular background ones are used.
+     */
+    [[nodiscard]] const optional<regular_bg_attributes>& region_attributes(int index) const
+    {
+        return _region(index).attributes;
+    }
+
+    /**
+     * @brief Sets the attributes of the regular background in the region with the given index.
+     */
+    void set_region_attributes(int index, const regular_bg_attributes& attributes);
+
+    /**
+     * @brief Removes the attributes of the regular background in the region with the given index (if any),
+     * so the regular background ones are used instead.
+     */
+    void remove_region_attributes(int index);
+
+    /**
+     * @brief Regenerates the H-Blank effects if the regular background, a region or their cameras have been moved.
+     *
+     * It should be called once per frame.
+     *
+     * Changes of the regular background attributes are only taken into account
+     * when a region attributes are set or removed.
+     */
+    void update();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    struct region_type
+    {
+        fixed_point position;
+        optional<camera_ptr> camera;
+        optional<regular_bg_attributes> attributes;
+        point view;
+        int top_line;
+    };
+
+    isplit_screen(const regular_bg_ptr& bg, ivector<region_type>& regions);
+
+    /// @endcond
+
+private:
+    regular_bg_ptr _bg;
+    ivector<region_type>& _regions;
+    array<fixed, display::height()> _horizontal_deltas;
+    array<fixed, display::height()> _vertical_deltas;
+    regular_bg_position_hbe_ptr _horizontal_hbe;
+    regular_bg_position_hbe_ptr _vertical_hbe;
+    vector<regular_bg_attributes, display::height()> _attributes;
+    optional<regular_bg_attributes_hbe_ptr> _attributes_hbe;
+    point _view;
+    bool _update_positions = true;
+    bool _update_attributes = false;
+
+    [[nodiscard]] const region_type& _region(int index) const;
+
+    [[nodiscard]] region_type& _region(int index);
+
+    void _commit_positions();
+
+    void _commit_attributes();
+};
+
+
+/**
+ * @brief Divides the screen in horizontal bands (regions) in which a regular background is shown
+ * with its own position, camera and attributes, generating and caching the required H-Blank effects.
+ *
+ * @tparam MaxRegions Maximum number of regions.
+ *
+ * @ingroup regular_bg
+ * @ingroup hblank_effect
+ */
+template<int MaxRegions>
+class split_screen : public isplit_screen
+{
+    static_assert(MaxRegions > 0 && MaxRegions < display::height());
+
+public:
+    /**
+     * @brief Constructor.
+     * @param bg Regular background to split.
+     */
+    explicit split_screen(const regular_bg_ptr& bg) :
+        isplit_screen(bg, _regions_vector)
+    {
+    }
+
+private:
+    vector<region_type, MaxRegions> _regions_vector;
+};
+
+}
+
+#endif
@@ -65,6 +65,21 @@ public:
      */
     [[nodiscard]] static optional<sprite_affine_mat_ptr> create_optional(const affine_mat_attributes& attributes);
 
+    /**
+     * @brief Returns an affine transformation matrix created with this method with the same attributes if there's one;
+     * otherwise it creates a new one with the specified attributes.
+     *
+     * Sprites rotated, scaled, sheared or flipped with bn::sprite_ptr methods don't modify a shared matrix,
+     * they are moved to another shared matrix instead.
+     *
+     * Keep in mind that modifying a shared matrix with sprite_affine_mat_ptr methods
+     * modifies it for all of its owners.
+     *
+     * @param attributes affine_mat_attributes of the output matrix.
+     * @return The requested sprite_affine_mat_ptr.
+     */
+    [[nodiscard]] static sprite_affine_mat_ptr create_shared(const affine_mat_attributes& attributes);
+
     /**
      * @brief Copy constructor.
      * @param other sprite_affine_mat_ptr to copy.
@@ -234,6 +249,11 @@ public:
      */
     [[nodiscard]] bool flipped_identity() const;
 
+    /**
+     * @brief Indicates if this matrix has been created with create_shared or not.
+     */
+    [[nodiscard]] bool shared() const;
+
     /**
      * @brief Exchanges the contents of this sprite_affine_mat_ptr with those of the other one.
      * @param other sprite_affine_mat_ptr to exchange the contents with.
@@ -289,6 +309,19 @@ struct hash<sprite_affine_mat_ptr>
     }
 };
 
+
+/**
+ * @brief sprite_affine_mat_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup sprite
+ * @ingroup affine_mat
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<sprite_affine_mat_ptr> : true_type
+{
+};
+
 }
 
 #endif
@@ -20,6 +20,7 @@
 #include "bn_limits.h"
 #include "bn_sprite_ptr.h"
 #include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_shape_size.h"
 #include "bn_sprite_tiles_item.h"
 
 namespace bn
@@ -33,6 +34,9 @@ namespace bn
  * Each time the tile set of a sprite_ptr must be changed, it is searched for and created if it has not been found,
  * so the tile sets are not cached.
  *
+ * Actions which show the same tile set at the same time share it,
+ * and if BN_CFG_SPRITE_TILES_CACHE_ENABLED is true, tile sets are kept in VRAM after they are not shown anymore.
+ *
  * @tparam MaxSize Maximum number of indexes to sprite tile sets to store.
  *
  * @ingroup sprite
@@ -689,6 +693,308 @@ template<typename ...Args>
                 array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
 }
 
+
+// sheet animation
+
+
+/**
+ * @brief Changes the tile set of a sprite_ptr when the action is updated a given number of times.
+ *
+ * This action differs from sprite_animate_action in that in this action all sprite tile sets to use
+ * are kept in VRAM as a single tile sheet, and only the tile index of the sprite is updated when the tile set
+ * must be changed, so it is faster and no tiles are uploaded during the animation, but takes more VRAM.
+ *
+ * The tile sets of the given sprite_tiles_item should not be referenced separately
+ * while the tile sheet is used (see sprite_tiles_ptr::create_sheet).
+ *
+ * @tparam MaxSize Maximum number of indexes to sprite tile sets to store.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup action
+ */
+template<int MaxSize>
+class sprite_sheet_animate_action
+{
+    static_assert(MaxSize > 1);
+
+public:
+    /**
+     * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets only once.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+     * @param graphics_indexes Indexes of the tile sets to reference in the given sprite_tiles_item.
+     * @return The requested sprite_sheet_animate_action.
+     */
+    [[nodiscard]] static sprite_sheet_animate_action once(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_sheet_animate_action(sprite, wait_updates, tiles_item, false, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets only once.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+     * @param graphics_indexes Indexes of the tile sets to reference in the given sprite_tiles_item.
+     * @return The requested sprite_sheet_animate_action.
+     */
+    [[nodiscard]] static sprite_sheet_animate_action once(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_sheet_animate_action(move(sprite), wait_updates, tiles_item, false, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets forever.
+     * @param sprite sprite_ptr to copy.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+     * @param graphics_indexes Indexes of the tile sets to reference in the given sprite_tiles_item.
+     * @return The requested sprite_sheet_animate_action.
+     */
+    [[nodiscard]] static sprite_sheet_animate_action forever(
+            const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_sheet_animate_action(sprite, wait_updates, tiles_item, true, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets forever.
+     * @param sprite sprite_ptr to move.
+     * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+     * @param graphics_indexes Indexes of the tile sets to reference in the given sprite_tiles_item.
+     * @return The requested sprite_sheet_animate_action.
+     */
+    [[nodiscard]] static sprite_sheet_animate_action forever(
+            sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+            const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_sheet_animate_action(move(sprite), wait_updates, tiles_item, true, graphics_indexes);
+    }
+
+    /**
+     * @brief Changes the tile set of the given sprite_ptr when the given amount of update calls are done.
+     */
+    void update()
+    {
+        BN_ASSERT(! done(), "Action is done");
+
+        if(_current_wait_updates)
+        {
+            --_current_wait_updates;
+        }
+        else
+        {
+            int current_graphics_indexes_index = _current_graphics_indexes_index;
+            _current_wait_updates = _wait_updates;
+            _sprite.set_tiles_offset(_tiles_item.graphics_tiles_offset(
+                                         _graphics_indexes[current_graphics_indexes_index]));
+
+            if(_forever && current_graphics_indexes_index == _graphics_indexes.size() - 1)
+            {
+                _current_graphics_indexes_index = 0;
+            }
+            else
+            {
+                ++_current_graphics_indexes_index;
+            }
+        }
+    }
+
+    /**
+     * @brief Indicates if the action must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_graphics_indexes_index == _graphics_indexes.size();
+    }
+
+    /**
+     * @brief Returns the sprite_ptr to modify.
+     */
+    [[nodiscard]] const sprite_ptr& sprite() const
+    {
+        return _sprite;
+    }
+
+    /**
+     * @brief Returns the number of times the action must be updated before changing the tiles of the given sprite_ptr.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Returns the sprite_tiles_item used to create the tile sheet to use by the given sprite_ptr.
+     */
+    [[nodiscard]] const sprite_tiles_item& tiles_item() const
+    {
+        return _tiles_item;
+    }
+
+    /**
+     * @brief Returns the indexes of the tile sets to reference in the given sprite_tiles_item.
+     */
+    [[nodiscard]] const ivector<uint16_t>& graphics_indexes() const
+    {
+        return _graphics_indexes;
+    }
+
+    /**
+     * @brief Indicates if the action can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the current index of the given graphics_indexes
+     * (not the current index of the tile set to reference in the given tiles_item).
+     */
+    [[nodiscard]] int current_index() const
+    {
+        return _current_graphics_indexes_index;
+    }
+
+private:
+    sprite_ptr _sprite;
+    sprite_tiles_item _tiles_item;
+    vector<uint16_t, MaxSize> _graphics_indexes;
+    uint16_t _wait_updates = 0;
+    uint16_t _current_graphics_indexes_index = 0;
+    uint16_t _current_wait_updates = 0;
+    bool _forever = true;
+
+    sprite_sheet_animate_action(const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+                                bool forever, const span<const uint16_t>& graphics_indexes) :
+        _sprite(sprite),
+        _tiles_item(tiles_item),
+        _wait_updates(uint16_t(wait_updates)),
+        _forever(forever)
+    {
+        _init(wait_updates, graphics_indexes);
+    }
+
+    sprite_sheet_animate_action(sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item,
+                                bool forever, const span<const uint16_t>& graphics_indexes) :
+        _sprite(move(sprite)),
+        _tiles_item(tiles_item),
+        _wait_updates(uint16_t(wait_updates)),
+        _forever(forever)
+    {
+        _init(wait_updates, graphics_indexes);
+    }
+
+    void _init([[maybe_unused]] int wait_updates, const span<const uint16_t>& graphics_indexes)
+    {
+        BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+        BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+                   "Too much wait updates: ", wait_updates);
+        BN_ASSERT(graphics_indexes.size() > 1 && graphics_indexes.size() <= MaxSize,
+                   "Invalid graphics indexes: ", graphics_indexes.size());
+        BN_ASSERT(_tiles_item.tiles_count_per_graphic() == _sprite.shape_size().tiles_count(_tiles_item.bpp()),
+                  "Invalid tiles count per graphic: ", _tiles_item.tiles_count_per_graphic(), " - ",
+                  _sprite.shape_size().tiles_count(_tiles_item.bpp()));
+
+        for(uint16_t graphics_index : graphics_indexes)
+        {
+            _graphics_indexes.push_back(graphics_index);
+        }
+
+        _sprite.set_tiles(sprite_tiles_ptr::create_sheet(_tiles_item),
+                          _tiles_item.graphics_tiles_offset(graphics_indexes[0]));
+    }
+};
+
+
+/**
+ * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets only once.
+ * @param sprite sprite_ptr to copy.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+ * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+ * @return The requested sprite_sheet_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_sheet_animate_action_once(
+        const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_sheet_animate_action<sizeof...(Args)>::once(
+                sprite, wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+
+/**
+ * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets only once.
+ * @param sprite sprite_ptr to move.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+ * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+ * @return The requested sprite_sheet_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_sheet_animate_action_once(
+        sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_sheet_animate_action<sizeof...(Args)>::once(
+                move(sprite), wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+
+/**
+ * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets forever.
+ * @param sprite sprite_ptr to copy.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+ * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+ * @return The requested sprite_sheet_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_sheet_animate_action_forever(
+        const sprite_ptr& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_sheet_animate_action<sizeof...(Args)>::forever(
+                sprite, wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+
+/**
+ * @brief Generates a sprite_sheet_animate_action which loops over the given sprite tile sets forever.
+ * @param sprite sprite_ptr to move.
+ * @param wait_updates Number of times the action must be updated before changing the tiles of the given sprite_ptr.
+ * @param tiles_item It creates the tile sheet to use by the given sprite_ptr.
+ * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+ * @return The requested sprite_sheet_animate_action.
+ *
+ * @ingroup sprite
+ */
+template<typename ...Args>
+[[nodiscard]] auto create_sprite_sheet_animate_action_forever(
+        sprite_ptr&& sprite, int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_sheet_animate_action<sizeof...(Args)>::forever(
+                move(sprite), wait_updates, tiles_item,
+                array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
 }
 
 #endif
@@ -21,6 +21,10 @@ namespace bn
 /**
  * @brief Specifies the area a sprite uses to be drawn when it has an attached sprite_affine_mat_ptr.
  *
+ * With sprite_double_size_mode::AUTO, double size is decided once per sprite_affine_mat_ptr update,
+ * and once enabled it is kept until the matrix is a bit inside of the regular size bounds,
+ * so sprites rotating or scaling near the threshold don't toggle it every frame.
+ *
  * @ingroup sprite
  */
 enum class sprite_double_size_mode : uint8_t
@@ -111,6 +111,7 @@ public:
         _space_between_characters(space_between_characters)
     {
         BN_ASSERT(item.tiles_item().compression() == compression_type::NONE, "Compressed tiles not supported");
+        BN_ASSERT(item.tiles_item().graphics_indexes_ref().empty(), "Repeated graphics reduction not supported");
         BN_ASSERT(item.tiles_item().graphics_count() >= minimum_graphics + utf8_characters_ref.size(),
                    "Invalid graphics count or UTF-8 characters count: ", item.tiles_item().graphics_count(), " - ",
                    utf8_characters_ref.size(), " - ", minimum_graphics + utf8_characters_ref.size());
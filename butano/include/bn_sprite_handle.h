@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_HANDLE_H
+#define BN_SPRITE_HANDLE_H
+
+/**
+ * @file
+ * bn::sprite_handle header file.
+ *
+ * @ingroup sprite
+ */
+
+#include "bn_sprite_ptr.h"
+#include "bn_type_traits.h"
+
+namespace bn
+{
+
+/**
+ * @brief Non-owning, trivially copyable reference to a sprite.
+ *
+ * Unlike bn::sprite_ptr, copying or destroying a sprite_handle doesn't modify the usages count of the sprite,
+ * so it can be stored and passed around for free in hot loops (for example, in a bullets pool).
+ *
+ * A sprite_handle doesn't keep the sprite alive: it is valid only while at least one bn::sprite_ptr
+ * which references the same sprite exists.
+ * Its owner (usually a pool which also holds the sprite_ptr objects) must ensure it is not used after that.
+ *
+ * Only the most frequently modified attributes are exposed;
+ * the rest of them can be modified with the owning bn::sprite_ptr.
+ *
+ * @ingroup sprite
+ */
+class sprite_handle
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param sprite bn::sprite_ptr which references the sprite to handle.
+     */
+    explicit sprite_handle(const sprite_ptr& sprite) :
+        _handle(const_cast<void*>(sprite.handle()))
+    {
+    }
+
+    /**
+     * @brief Returns the horizontal position of the sprite (relative to its camera, if it has one).
+     */
+    [[nodiscard]] fixed x() const;
+
+    /**
+     * @brief Sets the horizontal position of the sprite (relative to its camera, if it has one).
+     */
+    void set_x(fixed x);
+
+    /**
+     * @brief Returns the vertical position of the sprite (relative to its camera, if it has one).
+     */
+    [[nodiscard]] fixed y() const;
+
+    /**
+     * @brief Sets the vertical position of the sprite (relative to its camera, if it has one).
+     */
+    void set_y(fixed y);
+
+    /**
+     * @brief Returns the position of the sprite (relative to its camera, if it has one).
+     */
+    [[nodiscard]] const fixed_point& position() const;
+
+    /**
+     * @brief Sets the position of the sprite (relative to its camera, if it has one).
+     * @param x Horizontal position of the sprite (relative to its camera, if it has one).
+     * @param y Vertical position of the sprite (relative to its camera, if it has one).
+     */
+    void set_position(fixed x, fixed y);
+
+    /**
+     * @brief Sets the position of the sprite (relative to its camera, if it has one).
+     */
+    void set_position(const fixed_point& position);
+
+    /**
+     * @brief Returns the index of the first tile of the sprite in its tiles.
+     */
+    [[nodiscard]] int tiles_offset() const;
+
+    /**
+     * @brief Sets the index of the first tile of the sprite in its tiles.
+     * @param tiles_offset Index of the first tile of the sprite in its tiles.
+     * It must be even if the tiles are 8BPP.
+     */
+    void set_tiles_offset(int tiles_offset);
+
+    /**
+     * @brief Returns the priority relative to other sprites.
+     *
+     * Sprites with higher z orders are drawn first (and therefore can be covered by later sprites).
+     */
+    [[nodiscard]] int z_order() const;
+
+    /**
+     * @brief Sets the priority relative to other sprites.
+     *
+     * Sprites with higher z orders are drawn first (and therefore can be covered by later sprites).
+     *
+     * @param z_order Priority relative to other sprites in the range [-32767..32767].
+     */
+    void set_z_order(int z_order);
+
+    /**
+     * @brief Indicates if the sprite is flipped in the horizontal axis or not.
+     */
+    [[nodiscard]] bool horizontal_flip() const;
+
+    /**
+     * @brief Sets if the sprite is flipped in the horizontal axis or not.
+     */
+    void set_horizontal_flip(bool horizontal_flip);
+
+    /**
+     * @brief Indicates if the sprite is flipped in the vertical axis or not.
+     */
+    [[nodiscard]] bool vertical_flip() const;
+
+    /**
+     * @brief Sets if the sprite is flipped in the vertical axis or not.
+     */
+    void set_vertical_flip(bool vertical_flip);
+
+    /**
+     * @brief Indicates if the sprite must be committed to the GBA or not.
+     */
+    [[nodiscard]] bool visible() const;
+
+    /**
+     * @brief Sets if the sprite must be committed to the GBA or not.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @brief Returns the internal handle.
+     */
+    [[nodiscard]] const void* handle() const
+    {
+        return _handle;
+    }
+
+    /**
+     * @brief Equal operator.
+     * @param a sprite_handle to compare.
+     * @param b bn::sprite_ptr to compare.
+     * @return `true` if the given objects reference the same sprite, otherwise `false`.
+     */
+    [[nodiscard]] friend bool operator==(const sprite_handle& a, const sprite_ptr& b)
+    {
+        return a._handle == b.handle();
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] friend bool operator==(const sprite_handle& a, const sprite_handle& b) = default;
+
+private:
+    void* _handle;
+};
+
+
+/**
+ * @brief Hash support for sprite_handle.
+ *
+ * @ingroup sprite
+ * @ingroup functional
+ */
+template<>
+struct hash<sprite_handle>
+{
+    /**
+     * @brief Returns the hash of the given sprite_handle.
+     */
+    [[nodiscard]] unsigned operator()(const sprite_handle& value) const
+    {
+        return make_hash(value.handle());
+    }
+};
+
+static_assert(is_trivially_copyable_v<sprite_handle>);
+
+}
+
+#endif
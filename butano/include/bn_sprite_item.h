@@ -75,7 +75,7 @@ public:
     {
         BN_ASSERT(tiles_item.bpp() == palette_item.bpp(), "Tiles and color palette BPP are different");
         BN_ASSERT(tiles_item.tiles_ref().size() ==
-                  _shape_size.tiles_count(palette_item.bpp()) * tiles_item.graphics_count(),
+                  _shape_size.tiles_count(palette_item.bpp()) * tiles_item.stored_graphics_count(),
                   "Invalid shape or size");
     }
 
@@ -24,6 +24,7 @@ namespace bn
 {
 
 class color;
+class palette_cycle;
 class sprite_palette_item;
 enum class bpp_mode : uint8_t;
 
@@ -224,6 +225,27 @@ public:
      */
     void set_rotate_count(int count);
 
+    /**
+     * @brief Returns the number of color cycles of this palette.
+     */
+    [[nodiscard]] int cycles_count() const;
+
+    /**
+     * @brief Adds a color cycle to this palette.
+     *
+     * Color cycles rotate the final colors of the palette when it is committed to the GBA,
+     * so the colors of this palette are not rewritten and applied palette effects are not recomputed.
+     *
+     * @param cycle Range of colors to rotate and rotation period.
+     * Its last color index must be lower than colors_count().
+     */
+    void add_cycle(const palette_cycle& cycle);
+
+    /**
+     * @brief Removes all color cycles of this palette.
+     */
+    void remove_cycles();
+
     /**
      * @brief Exchanges the contents of this sprite_palette_ptr with those of the other one.
      * @param other sprite_palette_ptr to exchange the contents with.
@@ -279,6 +301,19 @@ struct hash<sprite_palette_ptr>
     }
 };
 
+
+/**
+ * @brief sprite_palette_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup sprite
+ * @ingroup palette
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<sprite_palette_ptr> : true_type
+{
+};
+
 }
 
 #endif
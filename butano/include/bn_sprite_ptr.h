@@ -14,7 +14,9 @@
  */
 
 #include "bn_utility.h"
+#include "bn_span_fwd.h"
 #include "bn_fixed_fwd.h"
+#include "bn_vector_fwd.h"
 #include "bn_functional.h"
 #include "bn_optional_fwd.h"
 
@@ -200,6 +202,20 @@ public:
      */
     [[nodiscard]] static optional<sprite_ptr> create_optional(sprite_builder&& builder);
 
+    /**
+     * @brief Creates a sprite_ptr for each one of the given positions, with the rest of the attributes
+     * of the given sprite_builder.
+     *
+     * Creating several sprites with the same sprite_builder at once is faster than creating them one by one,
+     * since its tiles and its color palette are retrieved only once and the new sprites are sorted together.
+     *
+     * @param builder sprite_builder reference. Its position is ignored.
+     * @param positions Position of each new sprite.
+     * @param output_sprites Created sprites are stored in this vector.
+     */
+    static void create_batch(const sprite_builder& builder, const span<const fixed_point>& positions,
+                             ivector<sprite_ptr>& output_sprites);
+
     /**
      * @brief Copy constructor.
      * @param other sprite_ptr to copy.
@@ -348,6 +364,32 @@ public:
      */
     void set_tiles(const sprite_tiles_item& tiles_item, const sprite_shape_size& shape_size, int graphics_index);
 
+    /**
+     * @brief Sets the tiles used by this sprite, referencing them from the given tiles offset,
+     * so a tile sheet with multiple animation frames can stay in VRAM.
+     *
+     * @param sheet_tiles sprite_tiles_ptr to copy.
+     * It must contain at least the tiles of the current shape and size of the sprite from the given tiles offset.
+     * @param tiles_offset Index of the first tile of the sprite in sheet_tiles.
+     */
+    void set_tiles(const sprite_tiles_ptr& sheet_tiles, int tiles_offset);
+
+    /**
+     * @brief Returns the index of the first tile of this sprite in its tiles.
+     */
+    [[nodiscard]] int tiles_offset() const;
+
+    /**
+     * @brief Sets the index of the first tile of this sprite in its tiles.
+     *
+     * Only the tile index of the sprite is updated, so it is way faster than replacing its tiles:
+     * animation frames of a tile sheet already in VRAM can be shown without uploading tiles again.
+     *
+     * @param tiles_offset Index of the first tile of this sprite in its tiles.
+     * It must be even if the tiles are 8BPP.
+     */
+    void set_tiles_offset(int tiles_offset);
+
     /**
      * @brief Returns the color palette used by this sprite.
      */
@@ -631,6 +673,21 @@ public:
      */
     void set_vertical_flip(bool vertical_flip);
 
+    /**
+     * @brief Replaces the tiles and the flips of this sprite, so it is shown rotated by a multiple of 90 degrees
+     * without using a sprite_affine_mat_ptr.
+     *
+     * The sprite must be square and it must not have an attached sprite_affine_mat_ptr.
+     *
+     * @param tiles_item It creates the sprite tiles to use by this sprite.
+     * It must be generated with the `"quarter_rotations"` option (see @ref import_sprite):
+     * the first half of its tile sets are the original ones,
+     * and the second half are the same tile sets rotated 90 degrees counterclockwise.
+     * @param graphics_index Index of the original tile set to reference in tiles_item.
+     * @param quarter_rotation Number of 90 degrees counterclockwise rotations, in the range [0..3].
+     */
+    void set_quarter_rotation(const sprite_tiles_item& tiles_item, int graphics_index, int quarter_rotation);
+
     /**
      * @brief Indicates if the mosaic effect must be applied to this sprite or not.
      */
@@ -901,6 +958,18 @@ struct hash<sprite_ptr>
     }
 };
 
+
+/**
+ * @brief sprite_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup sprite
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<sprite_ptr> : true_type
+{
+};
+
 }
 
 #endif
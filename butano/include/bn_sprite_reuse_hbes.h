@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_REUSE_HBES_H
+#define BN_SPRITE_REUSE_HBES_H
+
+/**
+ * @file
+ * bn::isprite_reuse_hbes and bn::sprite_reuse_hbes implementation header file.
+ *
+ * @ingroup sprite
+ * @ingroup hblank_effect
+ */
+
+#include "bn_vector.h"
+#include "bn_display.h"
+#include "bn_optional.h"
+#include "bn_sprite_first_attributes.h"
+#include "bn_sprite_third_attributes.h"
+#include "bn_sprite_third_attributes_hbe_ptr.h"
+#include "bn_sprite_first_attributes_hbe_ptr.h"
+#include "bn_sprite_regular_second_attributes.h"
+#include "bn_sprite_regular_second_attributes_hbe_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::sprite_reuse_hbes.
+ *
+ * A sprite reuse HBEs object overrides the attributes of a sprite in horizontal bands of the screen (slots),
+ * generating and caching the required H-Blank effects.
+ *
+ * It allows to show the same sprite more than once per frame (for example, to build a big fake sprite
+ * from the same graphics reused in several bands, or to multiplex a sprite between different objects)
+ * by overriding its position, flips, visibility, tiles, palette or priority in each slot.
+ *
+ * Each slot covers the screen horizontal lines in the range [top_line, bottom_line).
+ * Slots can overlap: if they do, the attributes of the last added slot are used.
+ * Lines not covered by any slot show the sprite as usual.
+ *
+ * Only the attributes overridden by at least one slot generate an H-Blank effect,
+ * and an H-Blank effect is reloaded only when its attributes table changes.
+ *
+ * To reuse more than one sprite, one sprite reuse HBEs object must be created per sprite.
+ *
+ * @ingroup sprite
+ * @ingroup hblank_effect
+ */
+class isprite_reuse_hbes
+{
+
+public:
+    isprite_reuse_hbes(const isprite_reuse_hbes& other) = delete;
+
+    isprite_reuse_hbes& operator=(const isprite_reuse_hbes& other) = delete;
+
+    /**
+     * @brief Returns the sprite modified by this object.
+     */
+    [[nodiscard]] const sprite_ptr& sprite() const
+    {
+        return _sprite;
+    }
+
+    /**
+     * @brief Returns the number of slots.
+     */
+    [[nodiscard]] int slots_count() const
+    {
+        return _slots.size();
+    }
+
+    /**
+     * @brief Returns the maximum number of slots.
+     */
+    [[nodiscard]] int max_slots_count() const
+    {
+        return _slots.max_size();
+    }
+
+    /**
+     * @brief Adds a new slot without overridden attributes.
+     * @param top_line First screen horizontal line of the slot, in the range [0, display::height() - 1].
+     * @param bottom_line Screen horizontal line after the last one of the slot,
+     * in the range [top_line + 1, display::height()].
+     * @return Index of the new slot.
+     */
+    int add_slot(int top_line, int bottom_line);
+
+    /**
+     * @brief Removes all slots.
+     */
+    void clear_slots();
+
+    /**
+     * @brief Returns the first screen horizontal line of the slot with the given index.
+     */
+    [[nodiscard]] int slot_top_line(int index) const
+    {
+        return _slot(index).top_line;
+    }
+
+    /**
+     * @brief Returns the screen horizontal line after the last one of the slot with the given index.
+     */
+    [[nodiscard]] int slot_bottom_line(int index) const
+    {
+        return _slot(index).bottom_line;
+    }
+
+    /**
+     * @brief Sets the screen horizontal lines covered by the slot with the given index.
+     * @param index Slot index.
+     * @param top_line First screen horizontal line of the slot, in the range [0, display::height() - 1].
+     * @param bottom_line Screen horizontal line after the last one of the slot,
+     * in the range [top_line + 1, display::height()].
+     */
+    void set_slot_lines(int index, int top_line, int bottom_line);
+
+    /**
+     * @brief Returns the attributes to commit to the first GBA register of the sprite
+     * in the slot with the given index (if any).
+     */
+    [[nodiscard]] const optional<sprite_first_attributes>& slot_first_attributes(int index) const
+    {
+        return _slot(index).first_attributes;
+    }
+
+    /**
+     * @brief Sets the attributes to commit to the first GBA register of the sprite in the slot with the given index.
+     */
+    void set_slot_first_attributes(int index, const sprite_first_attributes& first_attributes);
+
+    /**
+     * @brief Removes the attributes to commit to the first GBA register of the sprite
+     * in the slot with the given index (if any), so the sprite ones are used instead.
+     */
+    void remove_slot_first_attributes(int index);
+
+    /**
+     * @brief Returns the attributes to commit to the second GBA register of the sprite
+     * in the slot with the given index (if any).
+     */
+    [[nodiscard]] const optional<sprite_regular_second_attributes>& slot_second_attributes(int index) const
+    {
+        return _slot(index).second_attributes;
+    }
+
+    /**
+     * @brief Sets the attributes to commit to the second GBA register of the sprite in the slot with the given index.
+     *
+     * The sprite must not be affine.
+     */
+    void set_slot_second_attributes(int index, const sprite_regular_second_attributes& second_attributes);
+
+    /**
+     * @brief Removes the attributes to commit to the second GBA register of the sprite
+     * in the slot with the given index (if any), so the sprite ones are used instead.
+     */
+    void remove_slot_second_attributes(int index);
+
+    /**
+     * @brief Returns the attributes to commit to the third GBA register of the sprite
+     * in the slot with the given index (if any).
+     */
+    [[nodiscard]] const optional<sprite_third_attributes>& slot_third_attributes(int index) const
+    {
+        return _slot(index).third_attributes;
+    }
+
+    /**
+     * @brief Sets the attributes to commit to the third GBA register of the sprite in the slot with the given index.
+     */
+    void set_slot_third_attributes(int index, const sprite_third_attributes& third_attributes);
+
+    /**
+     * @brief Removes the attributes to commit to the third GBA register of the sprite
+     * in the slot with the given index (if any), so the sprite ones are used instead.
+     */
+    void remove_slot_third_attributes(int index);
+
+    /**
+     * @brief Regenerates the attributes tables and the H-Blank effects of the modified slots.
+     *
+     * It should be called once per frame.
+     *
+     * Changes of the sprite attributes are only taken into account when slots are modified.
+     */
+    void update();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    struct slot_type
+    {
+        optional<sprite_first_attributes> first_attributes;
+        optional<sprite_regular_second_attributes> second_attributes;
+        optional<sprite_third_attributes> third_attributes;
+        int16_t top_line;
+        int16_t bottom_line;
+    };
+
+    isprite_reuse_hbes(const sprite_ptr& sprite, ivector<slot_type>& slots);
+
+    /// @endcond
+
+private:
+    sprite_ptr _sprite;
+    ivector<slot_type>& _slots;
+    vector<sprite_first_attributes, display::height()> _first_attributes;
+    vector<sprite_regular_second_attributes, display::height()> _second_attributes;
+    vector<sprite_third_attributes, display::height()> _third_attributes;
+    optional<sprite_first_attributes_hbe_ptr> _first_attributes_hbe;
+    optional<sprite_regular_second_attributes_hbe_ptr> _second_attributes_hbe;
+    optional<sprite_third_attributes_hbe_ptr> _third_attributes_hbe;
+    bool _update_first_attributes = false;
+    bool _update_second_attributes = false;
+    bool _update_third_attributes = false;
+
+    [[nodiscard]] const slot_type& _slot(int index) const;
+
+    [[nodiscard]] slot_type& _slot(int index);
+
+    void _update_slot(const slot_type& slot);
+};
+
+
+/**
+ * @brief Overrides the attributes of a sprite in horizontal bands of the screen (slots),
+ * generating and caching the required H-Blank effects.
+ *
+ * @tparam MaxSlots Maximum number of slots.
+ *
+ * @ingroup sprite
+ * @ingroup hblank_effect
+ */
+template<int MaxSlots>
+class sprite_reuse_hbes : public isprite_reuse_hbes
+{
+    static_assert(MaxSlots > 0 && MaxSlots <= display::height());
+
+public:
+    /**
+     * @brief Constructor.
+     * @param sprite Sprite to reuse.
+     */
+    explicit sprite_reuse_hbes(const sprite_ptr& sprite) :
+        isprite_reuse_hbes(sprite, _slots_vector)
+    {
+    }
+
+private:
+    vector<slot_type, MaxSlots> _slots_vector;
+};
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TEXT_CACHE_H
+#define BN_SPRITE_TEXT_CACHE_H
+
+/**
+ * @file
+ * bn::sprite_text_cache header file.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+
+#include "bn_string.h"
+#include "bn_vector.h"
+#include "bn_sprite_item.h"
+#include "bn_fixed_point.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_config_sprite_text.h"
+
+namespace bn
+{
+
+class sprite_ptr;
+class sprite_text_generator;
+
+/**
+ * @brief Stores the sprite tiles of texts generated by a sprite_text_generator,
+ * so generating the same text again doesn't require painting it.
+ *
+ * Cached texts are identified by their font, their palette, their alignment and their sprite layout.
+ *
+ * When the cache is full, the oldest cached text is replaced.
+ *
+ * Keep in mind that cached sprite tiles are not released until the cache is cleared or destroyed.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+class sprite_text_cache
+{
+
+public:
+    /**
+     * @brief Returns the number of cached texts.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _items.size();
+    }
+
+    /**
+     * @brief Returns the maximum number of cached texts.
+     */
+    [[nodiscard]] constexpr static int max_size()
+    {
+        return BN_CFG_SPRITE_TEXT_CACHE_MAX_ITEMS;
+    }
+
+    /**
+     * @brief Returns the maximum size in bytes of a cached text.
+     */
+    [[nodiscard]] constexpr static int max_text_size()
+    {
+        return BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE;
+    }
+
+    /**
+     * @brief Indicates if there's no cached texts.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _items.empty();
+    }
+
+    /**
+     * @brief Removes all cached texts, releasing their sprite tiles.
+     */
+    void clear()
+    {
+        _items.clear();
+    }
+
+private:
+    friend class sprite_text_generator;
+
+    class sprite_entry
+    {
+
+    public:
+        sprite_tiles_ptr tiles;
+        fixed_point offset;
+        sprite_shape_size shape_size;
+    };
+
+    class item_type
+    {
+
+    public:
+        sprite_item font_item;
+        sprite_palette_item palette_item;
+        string<BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE> text;
+        vector<sprite_entry, BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE> sprites;
+        unsigned text_hash;
+        uint8_t alignment;
+        bool one_sprite_per_character;
+    };
+
+    vector<item_type, BN_CFG_SPRITE_TEXT_CACHE_MAX_ITEMS> _items;
+
+    [[nodiscard]] const item_type* _find(const sprite_text_generator& generator, const string_view& text,
+                                         unsigned text_hash, bool one_sprite_per_character) const;
+
+    [[nodiscard]] bool _generate(const sprite_text_generator& generator, const item_type& item,
+                                 const fixed_point& position, bool allow_failure,
+                                 ivector<sprite_ptr>& output_sprites) const;
+
+    void _insert(const sprite_text_generator& generator, const string_view& text, unsigned text_hash,
+                 bool one_sprite_per_character, const fixed_point& position,
+                 const span<const sprite_ptr>& generated_sprites);
+};
+
+}
+
+#endif
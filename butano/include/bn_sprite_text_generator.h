@@ -25,6 +25,7 @@ namespace bn
 
 class sprite_ptr;
 class fixed_point;
+class sprite_text_cache;
 
 /**
  * @brief Generates sprites containing text from a given sprite_font.
@@ -186,11 +187,69 @@ public:
         _one_sprite_per_character = one_sprite_per_character;
     }
 
+    /**
+     * @brief Returns the sprite_text_cache used to reuse the sprite tiles of previously generated texts (if any).
+     */
+    [[nodiscard]] sprite_text_cache* cache() const
+    {
+        return _cache;
+    }
+
+    /**
+     * @brief Sets the sprite_text_cache used to reuse the sprite tiles of previously generated texts.
+     * @param cache Pointer to the sprite_text_cache to use, or `nullptr` to disable caching.
+     *
+     * The given sprite_text_cache must outlive this sprite_text_generator (or be removed before being destroyed).
+     */
+    void set_cache(sprite_text_cache* cache)
+    {
+        _cache = cache;
+    }
+
     /**
      * @brief Returns the width in pixels of the given text.
      */
     [[nodiscard]] int width(const string_view& text) const;
 
+    /**
+     * @brief Splits the given text in lines which can be printed with generate.
+     *
+     * Text is processed in a single pass, so it is faster than measuring growing substrings with width.
+     *
+     * Lines are broken at spaces when possible and at `\n` characters,
+     * and they are not wider than the given width unless a word doesn't fit in a line.
+     *
+     * @tparam MaxLines Maximum size of the returned string_view vector.
+     * @param text Text to split.
+     * @param max_width Maximum width in pixels of each line.
+     * @return string_view vector containing the lines of the given text
+     * (they are not copied but referenced, so the given text should outlive them).
+     */
+    template<int MaxLines>
+    [[nodiscard]] vector<string_view, MaxLines> wrap(const string_view& text, int max_width) const
+    {
+        vector<string_view, MaxLines> output_lines;
+        wrap(text, max_width, output_lines);
+        return output_lines;
+    }
+
+    /**
+     * @brief Splits the given text in lines which can be printed with generate.
+     *
+     * Text is processed in a single pass, so it is faster than measuring growing substrings with width.
+     *
+     * Lines are broken at spaces when possible and at `\n` characters,
+     * and they are not wider than the given width unless a word doesn't fit in a line.
+     *
+     * @param text Text to split.
+     * @param max_width Maximum width in pixels of each line.
+     * @param output_lines The lines of the given text are stored in this vector
+     * (they are not copied but referenced, so the given text should outlive them).
+     *
+     * Keep in mind that this vector is not cleared before splitting the text.
+     */
+    void wrap(const string_view& text, int max_width, ivector<string_view>& output_lines) const;
+
     /**
      * @brief Generates text sprites for the given single line of text.
      * @tparam MaxSprites Maximum size of the returned sprite_ptr vector.
@@ -270,10 +329,44 @@ public:
     [[nodiscard]] bool generate_optional(const fixed_point& position, const string_view& text,
                                          ivector<sprite_ptr>& output_sprites) const;
 
+    /**
+     * @brief Updates the text sprites generated for old_text so they print the given text instead.
+     *
+     * If one sprite per character is generated, both texts have the same size and they only differ in digits
+     * of the same width, only the tiles of the changed digits are replaced.
+     *
+     * Otherwise, the given vector is cleared and the text sprites are generated again.
+     *
+     * @param x Horizontal position of the first generated sprite, considering the current alignment.
+     * @param y Vertical position of the first generated sprite, considering the current alignment.
+     * @param old_text Single line of text printed by the given text sprites.
+     * @param text Single line of text to print.
+     * @param output_sprites Vector which contains only the text sprites generated for old_text.
+     */
+    void update_digits(fixed x, fixed y, const string_view& old_text, const string_view& text,
+                       ivector<sprite_ptr>& output_sprites) const;
+
+    /**
+     * @brief Updates the text sprites generated for old_text so they print the given text instead.
+     *
+     * If one sprite per character is generated, both texts have the same size and they only differ in digits
+     * of the same width, only the tiles of the changed digits are replaced.
+     *
+     * Otherwise, the given vector is cleared and the text sprites are generated again.
+     *
+     * @param position Position of the first generated sprite, considering the current alignment.
+     * @param old_text Single line of text printed by the given text sprites.
+     * @param text Single line of text to print.
+     * @param output_sprites Vector which contains only the text sprites generated for old_text.
+     */
+    void update_digits(const fixed_point& position, const string_view& old_text, const string_view& text,
+                       ivector<sprite_ptr>& output_sprites) const;
+
 private:
     sprite_font _font;
     sprite_palette_item _palette_item;
     unordered_map<int, int, BN_CFG_SPRITE_TEXT_MAX_UTF8_CHARACTERS> _utf8_characters_map;
+    sprite_text_cache* _cache = nullptr;
     int8_t _bg_priority = 3;
     int8_t _z_order = 0;
     alignment_type _alignment = alignment_type::LEFT;
@@ -283,6 +376,12 @@ private:
     bool _font_one_sprite_per_character;
 
     void _init();
+
+    [[nodiscard]] bool _generate_impl(const fixed_point& position, const string_view& text, bool allow_failure,
+                                      ivector<sprite_ptr>& output_sprites) const;
+
+    [[nodiscard]] bool _update_digits(const string_view& old_text, const string_view& text,
+                                      ivector<sprite_ptr>& output_sprites) const;
 };
 
 }
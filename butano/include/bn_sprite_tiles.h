@@ -14,6 +14,7 @@
  * @ingroup tile
  */
 
+#include "bn_fixed_fwd.h"
 #include "bn_config_log.h"
 #include "bn_config_doxygen.h"
 
@@ -35,6 +36,19 @@ namespace bn::sprite_tiles
      */
     [[nodiscard]] int available_tiles_count();
 
+    /**
+     * @brief Returns the number of tiles of the biggest free VRAM block available for sprite tiles.
+     *
+     * Creating sprite tiles bigger than this block fails even if available_tiles_count() is bigger.
+     */
+    [[nodiscard]] int largest_free_block_tiles_count();
+
+    /**
+     * @brief Returns how fragmented the VRAM available for sprite tiles is,
+     * from 0 (all available tiles are in one block) to 1 (available tiles are scattered in lots of small blocks).
+     */
+    [[nodiscard]] fixed fragmentation_ratio();
+
     /**
      * @brief Returns the number of used sprite tile sets created with sprite_tiles_ptr static constructors.
      */
@@ -46,6 +60,49 @@ namespace bn::sprite_tiles
      */
     [[nodiscard]] int available_items_count();
 
+    /**
+     * @brief Returns how many times requested sprite tiles were already in VRAM,
+     * so they were shared instead of uploaded again.
+     */
+    [[nodiscard]] int cache_hits_count();
+
+    /**
+     * @brief Returns how many times requested sprite tiles were not in VRAM.
+     */
+    [[nodiscard]] int cache_misses_count();
+
+    /**
+     * @brief Sets cache_hits_count() and cache_misses_count() to zero.
+     */
+    void reset_cache_counters();
+
+    /**
+     * @brief Returns the number of sprite tile sets waiting to be uploaded to VRAM.
+     */
+    [[nodiscard]] int commit_queue_size();
+
+    /**
+     * @brief Returns the number of sprite tile sets that didn't fit in the last frame upload budget
+     * (see BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES).
+     */
+    [[nodiscard]] int deferred_commits_count();
+
+    /**
+     * @brief Moves used sprite tiles towards the start of VRAM to merge free blocks.
+     *
+     * Only tile sets which fit in max_tiles_count are moved, so it can be called once per frame
+     * to defragment VRAM incrementally.
+     *
+     * Moved tiles are copied in the next VBlank and sprite_ptr objects are updated automatically,
+     * but spans returned by sprite_tiles_ptr::vram and sprite HBlank effects are not updated.
+     *
+     * Sprite tiles created or allocated after calling it in the same frame are uploaded in the next VBlank,
+     * so sprite_tiles_ptr::allocate fails until then.
+     *
+     * @param max_tiles_count Maximum number of tiles to move.
+     */
+    void defragment(int max_tiles_count);
+
     #if BN_CFG_LOG_ENABLED || BN_DOXYGEN
         /**
          * @brief Logs the current status of the sprite tiles manager.
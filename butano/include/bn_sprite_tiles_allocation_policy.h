@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TILES_ALLOCATION_POLICY_H
+#define BN_SPRITE_TILES_ALLOCATION_POLICY_H
+
+/**
+ * @file
+ * Available sprite tiles allocation policies header file.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_SPRITE_TILES_ALLOCATION_POLICY_BEST_FIT
+ *
+ * Sprite tiles are allocated at the start of the smallest free block that can hold them.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ */
+#define BN_SPRITE_TILES_ALLOCATION_POLICY_BEST_FIT  1
+
+/**
+ * @def BN_SPRITE_TILES_ALLOCATION_POLICY_BUDDY
+ *
+ * Sprite tiles are allocated in the smallest free block that can hold them
+ * at a start tile aligned to their tiles count rounded up to the next power of two.
+ *
+ * Keeping tile sets aligned like buddy blocks reduces fragmentation when lots of tile sets
+ * of different sizes are created and destroyed, at the cost of some unused tiles between them.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ */
+#define BN_SPRITE_TILES_ALLOCATION_POLICY_BUDDY     2
+
+#endif
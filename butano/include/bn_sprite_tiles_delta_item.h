@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TILES_DELTA_ITEM_H
+#define BN_SPRITE_TILES_DELTA_ITEM_H
+
+/**
+ * @file
+ * bn::sprite_tiles_delta_item header file.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup tool
+ */
+
+#include "bn_assert.h"
+#include "bn_alignment.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the differences between each tile set of an uncompressed sprite_tiles_item and the previous one.
+ *
+ * The assets conversion tools generate an object of this type in the build folder
+ * for each *.bmp file with `tiles_deltas` field enabled.
+ *
+ * The differences of each tile set are stored as runs of changed 32-bit words: each run starts with a header word
+ * with its offset in words in the high half word and its size in words in the low half word,
+ * followed by the new words. The differences of each tile set end with a zero header word.
+ *
+ * The differences of the first tile set are calculated against the last one, so looping animations are supported.
+ *
+ * The referenced differences are not copied, so they should outlive the sprite_tiles_delta_item
+ * to avoid dangling references.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup tool
+ */
+class sprite_tiles_delta_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param deltas_ref Reference to the offsets in words of the differences of each tile set,
+     * followed by the differences themselves.
+     *
+     * The referenced differences are not copied, so they should outlive the sprite_tiles_delta_item
+     * to avoid dangling references.
+     *
+     * @param graphics_count Number of tile sets (> 1).
+     */
+    constexpr sprite_tiles_delta_item(const uint32_t& deltas_ref, int graphics_count) :
+        _deltas_ptr(&deltas_ref),
+        _graphics_count(graphics_count)
+    {
+        BN_ASSERT(aligned<alignof(int)>(&deltas_ref), "Deltas are not aligned");
+        BN_ASSERT(graphics_count > 1, "Invalid graphics count: ", graphics_count);
+    }
+
+    /**
+     * @brief Returns the number of tile sets.
+     */
+    [[nodiscard]] constexpr int graphics_count() const
+    {
+        return _graphics_count;
+    }
+
+    /**
+     * @brief Returns the runs of changed words of the specified tile set against the previous one.
+     * @param graphics_index Index of the tile set.
+     */
+    [[nodiscard]] constexpr const uint32_t* graphics_delta_ptr(int graphics_index) const
+    {
+        BN_ASSERT(graphics_index >= 0 && graphics_index < _graphics_count,
+                  "Invalid graphics index: ", graphics_index, " - ", _graphics_count);
+
+        return _deltas_ptr + _deltas_ptr[graphics_index];
+    }
+
+private:
+    const uint32_t* _deltas_ptr;
+    int _graphics_count;
+};
+
+}
+
+#endif
@@ -138,6 +138,53 @@ public:
         _tiles_count_per_graphic = tcpg;
     }
 
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to one or more different sprite tile sets.
+     *
+     * The tiles are not copied but referenced, so they should outlive the sprite_tiles_item
+     * to avoid dangling references.
+     *
+     * @param bpp tiles_ref bits per pixel.
+     * @param graphics_indexes_ref Reference to the index in tiles_ref of the sprite tile set of each graphic,
+     * so repeated sprite tile sets are stored once.
+     *
+     * The indexes are not copied but referenced, so they should outlive the sprite_tiles_item
+     * to avoid dangling references.
+     */
+    constexpr sprite_tiles_item(const span<const tile>& tiles_ref, bpp_mode bpp,
+                                const span<const uint16_t>& graphics_indexes_ref) :
+        _tiles_ref(tiles_ref),
+        _graphics_indexes_ptr(graphics_indexes_ref.data()),
+        _graphics_count(graphics_indexes_ref.size()),
+        _tiles_count_per_graphic(0),
+        _compression(uint8_t(compression_type::NONE)),
+        _bpp(uint8_t(bpp))
+    {
+        int graphics_count = graphics_indexes_ref.size();
+        BN_ASSERT(graphics_count > 0 && graphics_count < 65536, "Invalid graphics count: ", graphics_count);
+
+        int stored_graphics_count = 0;
+
+        for(uint16_t graphics_index : graphics_indexes_ref)
+        {
+            if(graphics_index >= stored_graphics_count)
+            {
+                stored_graphics_count = graphics_index + 1;
+            }
+        }
+
+        BN_ASSERT(stored_graphics_count <= tiles_ref.size(),
+                  "Invalid tiles or graphics count: ", tiles_ref.size(), " - ", stored_graphics_count);
+        BN_ASSERT(tiles_ref.size() % stored_graphics_count == 0,
+                  "Invalid tiles or graphics count: ", tiles_ref.size(), " - ", stored_graphics_count);
+
+        int tcpg = tiles_ref.size() / stored_graphics_count;
+        BN_ASSERT(valid_tiles_count(tcpg, bpp), "Invalid tiles count per graphic: ", tcpg, " - ", int(bpp));
+
+        _tiles_count_per_graphic = tcpg;
+    }
+
     /**
      * @brief Returns the reference to one or more sprite tile sets.
      *
@@ -165,6 +212,25 @@ public:
         return _graphics_count;
     }
 
+    /**
+     * @brief Returns the number of different sprite tile sets stored in tiles_ref.
+     *
+     * It is less than graphics_count() if repeated sprite tile sets are stored once.
+     */
+    [[nodiscard]] constexpr int stored_graphics_count() const
+    {
+        return _tiles_ref.size() / _tiles_count_per_graphic;
+    }
+
+    /**
+     * @brief Returns the reference to the index in tiles_ref of the sprite tile set of each graphic
+     * if repeated sprite tile sets are stored once; an empty span otherwise.
+     */
+    [[nodiscard]] constexpr span<const uint16_t> graphics_indexes_ref() const
+    {
+        return span<const uint16_t>(_graphics_indexes_ptr, _graphics_indexes_ptr ? _graphics_count : 0);
+    }
+
     /**
      * @brief Returns the number of sprite tiles contained in each sprite tile set.
      */
@@ -196,9 +262,32 @@ public:
                   "Invalid graphics index: ", graphics_index, " - ", _graphics_count);
 
         int tiles_count = _tiles_count_per_graphic;
+
+        if(const uint16_t* graphics_indexes_ptr = _graphics_indexes_ptr)
+        {
+            graphics_index = graphics_indexes_ptr[graphics_index];
+        }
+
         return span<const tile>(_tiles_ref.data() + (graphics_index * tiles_count), tiles_count);
     }
 
+    /**
+     * @brief Returns the index of the first tile of the sprite tile set indicated by graphics_index in tiles_ref.
+     */
+    [[nodiscard]] constexpr int graphics_tiles_offset(int graphics_index) const
+    {
+        BN_ASSERT(graphics_index >= 0, "Invalid graphics index: ", graphics_index);
+        BN_ASSERT(graphics_index < _graphics_count,
+                  "Invalid graphics index: ", graphics_index, " - ", _graphics_count);
+
+        if(const uint16_t* graphics_indexes_ptr = _graphics_indexes_ptr)
+        {
+            graphics_index = graphics_indexes_ptr[graphics_index];
+        }
+
+        return graphics_index * _tiles_count_per_graphic;
+    }
+
     /**
      * @brief Returns the compression type.
      */
@@ -375,6 +464,7 @@ public:
 
 private:
     span<const tile> _tiles_ref;
+    const uint16_t* _graphics_indexes_ptr = nullptr;
 
     uint16_t _graphics_count;
 
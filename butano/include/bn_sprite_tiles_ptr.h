@@ -24,6 +24,7 @@ namespace bn
 
 class tile;
 class sprite_tiles_item;
+class sprite_tiles_delta_item;
 enum class bpp_mode : uint8_t;
 enum class compression_type : uint8_t;
 
@@ -126,6 +127,24 @@ public:
      */
     [[nodiscard]] static sprite_tiles_ptr allocate(int tiles_count, bpp_mode bpp);
 
+    /**
+     * @brief Searches for a sprite_tiles_ptr which references all tile sets of the given sprite_tiles_item.
+     * If it is not found, it creates a sprite_tiles_ptr which references them.
+     *
+     * It allows to animate sprites with sprite_ptr::set_tiles_offset without uploading tiles again.
+     *
+     * The sprite tiles system does not support multiple sprite_tiles_ptr items referencing to the same tiles,
+     * so the tile sets of the given sprite_tiles_item should not be referenced separately at the same time.
+     *
+     * The tiles are not copied but referenced,
+     * so they should outlive the sprite_tiles_ptr to avoid dangling references.
+     *
+     * @param tiles_item sprite_tiles_item which references the tiles to search or handle.
+     * @return sprite_tiles_ptr which references tiles_item.tiles_ref() if it has been found;
+     * otherwise it returns a sprite_tiles_ptr which references them.
+     */
+    [[nodiscard]] static sprite_tiles_ptr create_sheet(const sprite_tiles_item& tiles_item);
+
     /**
      * @brief Searches for a sprite_tiles_ptr which references the given tiles.
      * If it is not found, it creates a sprite_tiles_ptr which references them.
@@ -290,6 +309,26 @@ public:
      */
     void set_tiles_ref(const sprite_tiles_item& tiles_item, int graphics_index);
 
+    /**
+     * @brief Sets the tiles to handle, uploading to VRAM only the tiles words which are different
+     * from the previous tile set of the given sprite_tiles_item.
+     *
+     * If the handled tiles are not the previous tile set (for example, when animations are not sequential)
+     * or they have not been uploaded to VRAM yet, all tiles are uploaded to VRAM as with set_tiles_ref.
+     *
+     * Remember that the sprite tiles system does not support multiple sprite_tiles_ptr items
+     * referencing to the same tiles.
+     *
+     * Remember also that the tiles are not copied but referenced,
+     * so they should outlive the sprite_tiles_ptr to avoid dangling references.
+     *
+     * @param tiles_item Uncompressed sprite_tiles_item which references the tiles to handle.
+     * @param graphics_index Index of the tile set to reference in sprite_tiles_item.
+     * @param delta_item Differences between each tile set of the given sprite_tiles_item and the previous one.
+     */
+    void set_tiles_ref(const sprite_tiles_item& tiles_item, int graphics_index,
+                       const sprite_tiles_delta_item& delta_item);
+
     /**
      * @brief Uploads the referenced tiles to VRAM again to make visible the possible changes in them.
      */
@@ -364,6 +403,19 @@ struct hash<sprite_tiles_ptr>
     }
 };
 
+
+/**
+ * @brief sprite_tiles_ptr only holds a handle, so it can be relocated with a raw memory copy.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup std
+ */
+template<>
+struct is_trivially_relocatable<sprite_tiles_ptr> : true_type
+{
+};
+
 }
 
 #endif
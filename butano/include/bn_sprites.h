@@ -13,6 +13,7 @@
  * @ingroup sprite
  */
 
+#include "bn_config_sprites.h"
 #include "../hw/include/bn_hw_sprites_constants.h"
 
 /**
@@ -86,6 +87,134 @@ namespace bn::sprites
      */
     void set_reserved_handles_count(int reserved_handles_count);
 
+    /**
+     * @brief Indicates if the sprites with the given BG priority and z order are sorted by their vertical position.
+     * @param bg_priority BG priority of the sprites.
+     * @param z_order Z order of the sprites.
+     */
+    [[nodiscard]] bool y_sort_enabled(int bg_priority, int z_order);
+
+    /**
+     * @brief Sets if the sprites with the given BG priority and z order must be sorted by their vertical position.
+     *
+     * When it is enabled, sprites placed lower on screen are drawn on top of the others,
+     * so top-down games don't need to update the z order of their sprites every frame.
+     *
+     * Sprites are sorted once per frame with an incremental pass,
+     * which is fast when their order changes little between frames.
+     * bn::sprite_ptr::put_above and bn::sprite_ptr::put_below have no effect on sorted sprites.
+     *
+     * Up to @ref BN_CFG_SPRITES_MAX_Y_SORT_LAYERS BG priority and z order pairs can be sorted at the same time.
+     *
+     * @param bg_priority BG priority of the sprites to sort
+     * ([sprites::min_bg_priority()..sprites::max_bg_priority()] range).
+     * @param z_order Z order of the sprites to sort ([sprites::min_z_order()..sprites::max_z_order()] range).
+     * @param enabled `true` if the sprites must be sorted by their vertical position, otherwise `false`.
+     */
+    void set_y_sort_enabled(int bg_priority, int z_order, bool enabled);
+
+    /**
+     * @brief Returns the number of OBJ rendering cycles available in each scanline.
+     *
+     * A regular sprite spends its width in cycles, and an affine sprite spends 10 cycles plus twice the width
+     * of its area (which is doubled with double size).
+     *
+     * The budget is reduced if @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED is `true`,
+     * since OAM can be accessed during H-Blank.
+     */
+    [[nodiscard]] constexpr int max_scanline_cycles()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXER_ENABLED ? 954 : 1210;
+    }
+
+    /**
+     * @brief Returns the scanline with the most OBJ rendering cycles requested in the last update.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED is `true`.
+     */
+    [[nodiscard]] int worst_scanline();
+
+    /**
+     * @brief Returns the OBJ rendering cycles requested by the worst scanline in the last update.
+     *
+     * If it is greater than max_scanline_cycles(), some sprites of that scanline are not drawn.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED is `true`.
+     */
+    [[nodiscard]] int worst_scanline_cycles();
+
+    /**
+     * @brief Returns the number of scanlines that requested more than max_scanline_cycles() in the last update.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED is `true`.
+     */
+    [[nodiscard]] int overloaded_scanlines_count();
+
+    /**
+     * @brief Returns the number of hardware sprite handles that are not drawn (or are drawn partially)
+     * in any scanline in the last update, because the higher priority ones spent all the cycles.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED is `true`.
+     */
+    [[nodiscard]] int scanlines_dropped_sprites_count();
+
+    /**
+     * @brief Indicates if the sprites of overloaded scanlines are flickered or not.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED is `true`.
+     */
+    [[nodiscard]] bool scanlines_flicker_enabled();
+
+    /**
+     * @brief Sets if the sprites of overloaded scanlines must be flickered or not.
+     *
+     * When it is enabled, every other frame the highest priority sprites of the overloaded scanlines are hidden,
+     * so the lowest priority ones that would be dropped by the GBA are shown.
+     *
+     * Reserved handles are never hidden.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED is `true`.
+     */
+    void set_scanlines_flicker_enabled(bool enabled);
+
+    /**
+     * @brief Returns the number of horizontal bands in which the screen is divided by the sprites multiplexer
+     * (see @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED).
+     */
+    [[nodiscard]] constexpr int multiplexer_bands_count()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXER_BANDS;
+    }
+
+    /**
+     * @brief Returns the maximum number of sprites that the sprites multiplexer can show in each band
+     * (see @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED).
+     */
+    [[nodiscard]] constexpr int multiplexer_max_band_sprites()
+    {
+        return BN_CFG_SPRITES_MULTIPLEXER_HANDLES;
+    }
+
+    /**
+     * @brief Returns the number of sprites shown by the sprites multiplexer in the given band
+     * in the last update.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED is `true`.
+     *
+     * @param band Band index (it must be >= 0 and < multiplexer_bands_count()).
+     */
+    [[nodiscard]] int multiplexed_sprites_count(int band);
+
+    /**
+     * @brief Returns the number of sprites overlapping the given band that were not shown
+     * in the last update because the sprites multiplexer ran out of handles in any of their bands.
+     *
+     * It is only available if @ref BN_CFG_SPRITES_MULTIPLEXER_ENABLED is `true`.
+     *
+     * @param band Band index (it must be >= 0 and < multiplexer_bands_count()).
+     */
+    [[nodiscard]] int multiplexer_dropped_sprites_count(int band);
+
     /**
      * @brief Reloads the internal attributes of all sprites (including the reserved ones).
      *
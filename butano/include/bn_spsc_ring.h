@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPSC_RING_H
+#define BN_SPSC_RING_H
+
+/**
+ * @file
+ * bn::spsc_ring implementation header file.
+ *
+ * @ingroup spsc_ring
+ */
+
+#include "bn_span.h"
+#include "bn_algorithm.h"
+#include "bn_power_of_two.h"
+#include "bn_spsc_ring_fwd.h"
+
+namespace bn
+{
+
+template<typename Type, int MaxSize>
+class spsc_ring
+{
+    static_assert(power_of_two(MaxSize));
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+
+    spsc_ring() = default;
+
+    spsc_ring(const spsc_ring& other) = delete;
+
+    spsc_ring& operator=(const spsc_ring& other) = delete;
+
+    /**
+     * @brief Returns the current elements count.
+     *
+     * If it is not called from the producer or the consumer context,
+     * it can be outdated as soon as it is returned.
+     */
+    [[nodiscard]] size_type size() const
+    {
+        return int(_tail - _head);
+    }
+
+    /**
+     * @brief Returns the maximum possible elements count.
+     */
+    [[nodiscard]] constexpr size_type max_size() const
+    {
+        return MaxSize;
+    }
+
+    /**
+     * @brief Returns the remaining element capacity.
+     */
+    [[nodiscard]] size_type available() const
+    {
+        return MaxSize - size();
+    }
+
+    /**
+     * @brief Indicates if it doesn't contain any element.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _tail == _head;
+    }
+
+    /**
+     * @brief Indicates if it can't contain any more elements.
+     */
+    [[nodiscard]] bool full() const
+    {
+        return size() == MaxSize;
+    }
+
+    /**
+     * @brief Inserts a copy of the given value at the end. It must be called only from the producer context.
+     * @param value Value to insert.
+     * @return `true` if the value was inserted, or `false` if the ring buffer is full.
+     */
+    bool push(const_reference value)
+    {
+        unsigned tail = _tail;
+
+        if(tail - _head == unsigned(MaxSize))
+        {
+            return false;
+        }
+
+        // The consumer must have released the slot before it is overwritten:
+        BN_BARRIER;
+        _buffer[tail & _mask] = value;
+
+        // The slot must be written before it is published to the consumer:
+        BN_BARRIER;
+        _tail = tail + 1;
+        return true;
+    }
+
+    /**
+     * @brief Inserts copies of the given values at the end. It must be called only from the producer context.
+     * @param values Values to insert.
+     * @return Number of inserted values, which is less than the given ones if the ring buffer becomes full.
+     */
+    size_type push(const span<const value_type>& values)
+    {
+        unsigned tail = _tail;
+        int count = min(values.size(), MaxSize - int(tail - _head));
+        BN_BARRIER;
+
+        const value_type* values_data = values.data();
+
+        for(int index = 0; index < count; ++index)
+        {
+            _buffer[(tail + unsigned(index)) & _mask] = values_data[index];
+        }
+
+        BN_BARRIER;
+        _tail = tail + unsigned(count);
+        return count;
+    }
+
+    /**
+     * @brief Removes the first element. It must be called only from the consumer context.
+     * @param value Reference to the value to assign the removed element to.
+     * @return `true` if an element was removed, or `false` if the ring buffer is empty.
+     */
+    bool pop(reference value)
+    {
+        unsigned head = _head;
+
+        if(_tail == head)
+        {
+            return false;
+        }
+
+        // The slot must not be read before it is published by the producer:
+        BN_BARRIER;
+        value = _buffer[head & _mask];
+
+        // The slot must be read before it is released to the producer:
+        BN_BARRIER;
+        _head = head + 1;
+        return true;
+    }
+
+    /**
+     * @brief Removes the first elements. It must be called only from the consumer context.
+     * @param values Span to assign the removed elements to.
+     * @return Number of removed elements, which is less than the size of the given span
+     * if the ring buffer becomes empty.
+     */
+    size_type pop(span<value_type> values)
+    {
+        unsigned head = _head;
+        int count = min(values.size(), int(_tail - head));
+        BN_BARRIER;
+
+        value_type* values_data = values.data();
+
+        for(int index = 0; index < count; ++index)
+        {
+            values_data[index] = _buffer[(head + unsigned(index)) & _mask];
+        }
+
+        BN_BARRIER;
+        _head = head + unsigned(count);
+        return count;
+    }
+
+    /**
+     * @brief Removes all elements. It must be called only from the consumer context.
+     */
+    void clear()
+    {
+        _head = _tail;
+    }
+
+private:
+    static constexpr unsigned _mask = unsigned(MaxSize) - 1;
+
+    value_type _buffer[MaxSize] = {};
+    volatile unsigned _head = 0;
+    volatile unsigned _tail = 0;
+};
+
+}
+
+#endif
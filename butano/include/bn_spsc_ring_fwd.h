@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPSC_RING_FWD_H
+#define BN_SPSC_RING_FWD_H
+
+/**
+ * @file
+ * bn::spsc_ring declaration header file.
+ *
+ * @ingroup spsc_ring
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+    /**
+     * @brief Wait-free single producer single consumer ring buffer with a fixed size buffer.
+     *
+     * Elements can be pushed from an interrupt handler and popped from the main loop (or vice versa)
+     * without disabling interrupts, as long as only one context pushes and only one context pops.
+     *
+     * @tparam Type Element type.
+     * @tparam MaxSize Maximum number of elements that can be stored (it must be a power of two).
+     *
+     * @ingroup spsc_ring
+     */
+    template<typename Type, int MaxSize>
+    class spsc_ring;
+}
+
+#endif
@@ -23,6 +23,14 @@ namespace _bn::sram
     void unsafe_write(const void* source, int size, int offset);
 
     void unsafe_read(void* destination, int size, int offset);
+
+    int unsafe_write_compressed(const void* source, int size, int offset);
+
+    [[nodiscard]] bool unsafe_read_compressed(void* destination, int size, int offset);
+
+    [[nodiscard]] int compress(const void* source, int size, void* destination, int max_size);
+
+    [[nodiscard]] bool decompress(const volatile uint8_t* source, int source_size, void* destination, int size);
 }
 
 /// @endcond
@@ -43,6 +51,15 @@ namespace bn::sram
         return hw::sram::size();
     }
 
+    /**
+     * @brief Returns the maximum size in bytes of the given number of bytes once compressed
+     * with write_compressed (incompressible data takes a little more than the original).
+     */
+    [[nodiscard]] constexpr int max_compressed_size(int size)
+    {
+        return size + (size / 255) + 16;
+    }
+
     /**
      * @brief Copies the given value into SRAM.
      * @param source Value to copy.
@@ -102,6 +119,78 @@ namespace bn::sram
 
         _bn::sram::unsafe_read(&destination, int(sizeof(Type)), offset);
     }
+
+    /**
+     * @brief Compresses the given value into SRAM with LZ4, so values bigger than SRAM can be stored
+     * if they are compressible enough.
+     *
+     * The header is written at the end, so if the write is interrupted (for example, by switching off the console),
+     * read_compressed returns `false` instead of reading corrupted data.
+     *
+     * @param source Value to compress.
+     * @return Size in bytes of the compressed data.
+     */
+    template<typename Type>
+    int write_compressed(const Type& source)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) < 1 << 24, "Size is too high");
+
+        return _bn::sram::unsafe_write_compressed(&source, int(sizeof(Type)), 0);
+    }
+
+    /**
+     * @brief Compresses the given value into SRAM with LZ4, so values bigger than SRAM can be stored
+     * if they are compressible enough.
+     *
+     * The header is written at the end, so if the write is interrupted (for example, by switching off the console),
+     * read_compressed_offset returns `false` instead of reading corrupted data.
+     *
+     * @param source Value to compress.
+     * @param offset The compressed data is copied into SRAM start address + this offset.
+     * @return Size in bytes of the compressed data.
+     */
+    template<typename Type>
+    int write_compressed_offset(const Type& source, int offset)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) < 1 << 24, "Size is too high");
+        BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+
+        return _bn::sram::unsafe_write_compressed(&source, int(sizeof(Type)), offset);
+    }
+
+    /**
+     * @brief Decompresses SRAM data written with write_compressed into the given value.
+     * @param destination SRAM data is decompressed into this value.
+     * @return `true` if valid compressed data of the given type was found, otherwise `false`
+     * (the contents of the given value are undefined in that case).
+     */
+    template<typename Type>
+    [[nodiscard]] bool read_compressed(Type& destination)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) < 1 << 24, "Size is too high");
+
+        return _bn::sram::unsafe_read_compressed(&destination, int(sizeof(Type)), 0);
+    }
+
+    /**
+     * @brief Decompresses SRAM data written with write_compressed_offset into the given value.
+     * @param destination SRAM data is decompressed into this value.
+     * @param offset Decompression starts from SRAM start address + this offset.
+     * @return `true` if valid compressed data of the given type was found, otherwise `false`
+     * (the contents of the given value are undefined in that case).
+     */
+    template<typename Type>
+    [[nodiscard]] bool read_compressed_offset(Type& destination, int offset)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(int(sizeof(Type)) < 1 << 24, "Size is too high");
+        BN_ASSERT(offset >= 0 && offset < size(), "Invalid offset: ", offset);
+
+        return _bn::sram::unsafe_read_compressed(&destination, int(sizeof(Type)), offset);
+    }
 }
 
 #endif
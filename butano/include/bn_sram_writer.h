@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SRAM_WRITER_H
+#define BN_SRAM_WRITER_H
+
+/**
+ * @file
+ * bn::isram_writer, bn::sram_writer and bn::sram_compressed_writer header file.
+ *
+ * @ingroup sram
+ */
+
+#include "bn_sram.h"
+#include "bn_memory.h"
+
+namespace bn
+{
+
+/**
+ * @brief Base class of bn::sram_writer.
+ *
+ * It keeps a shadow copy of an SRAM range in RAM, so only the bytes which differ from it are written to SRAM.
+ *
+ * Pending writes are spread across multiple frames with idle tasks (see core::post_idle_task),
+ * so saving big data doesn't hitch the game.
+ *
+ * If core::clear_idle_tasks is called, pending writes are committed only when update or flush are called.
+ *
+ * @ingroup sram
+ */
+class isram_writer
+{
+
+public:
+    isram_writer(const isram_writer& other) = delete;
+
+    isram_writer& operator=(const isram_writer& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * Pending writes are flushed before destroying the writer.
+     */
+    ~isram_writer();
+
+    /**
+     * @brief Returns the size in bytes of the managed SRAM range.
+     */
+    [[nodiscard]] int size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns the SRAM offset of the managed range.
+     */
+    [[nodiscard]] int offset() const
+    {
+        return _offset;
+    }
+
+    /**
+     * @brief Returns the number of bytes which have not been compared with the shadow copy yet.
+     */
+    [[nodiscard]] int pending_bytes() const
+    {
+        return _size - _next_index;
+    }
+
+    /**
+     * @brief Indicates if all writes have been committed to SRAM or not.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _next_index == _size;
+    }
+
+    /**
+     * @brief Compares and writes up to the specified number of pending bytes.
+     * @param max_bytes Maximum number of bytes to process (it must be > 0).
+     */
+    void update(int max_bytes);
+
+    /**
+     * @brief Writes all pending bytes to SRAM.
+     */
+    void flush();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isram_writer(uint8_t* data, uint8_t* shadow, int size, int offset);
+
+    void _write(const void* source);
+
+    void _write_compressed(const void* source, int size);
+
+    [[nodiscard]] bool _read_compressed(void* destination, int size) const;
+
+    /// @endcond
+
+private:
+    uint8_t* _data;
+    uint8_t* _shadow;
+    isram_writer* _next_writer = nullptr;
+    int _size;
+    int _offset;
+    int _next_index;
+    bool _queued = false;
+
+    void _enqueue();
+
+    void _dequeue();
+
+    static void _update_queued();
+};
+
+
+/**
+ * @brief Writes the given type to SRAM asynchronously, writing only the bytes which have been changed.
+ *
+ * @tparam Type Type of the data to write. It must be trivially copyable.
+ *
+ * @ingroup sram
+ */
+template<typename Type>
+class sram_writer : public isram_writer
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+    static_assert(int(sizeof(Type)) <= sram::size(), "Size is too high");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset SRAM offset of the data.
+     *
+     * The shadow copy is read from SRAM.
+     */
+    explicit sram_writer(int offset = 0) :
+        isram_writer(_data_buffer, _shadow_buffer, int(sizeof(Type)), offset)
+    {
+    }
+
+    /**
+     * @brief Returns the last written value, which may not have been committed to SRAM yet.
+     */
+    [[nodiscard]] Type value() const
+    {
+        Type result;
+        memory::copy(_data_buffer[0], int(sizeof(Type)), *reinterpret_cast<uint8_t*>(&result));
+        return result;
+    }
+
+    /**
+     * @brief Queues the given value to be written to SRAM.
+     *
+     * It is copied into RAM immediately, and its changed bytes are written to SRAM by idle tasks.
+     */
+    void write(const Type& source)
+    {
+        _write(&source);
+    }
+
+private:
+    alignas(int) uint8_t _data_buffer[sizeof(Type)];
+    alignas(int) uint8_t _shadow_buffer[sizeof(Type)];
+};
+
+
+/**
+ * @brief Compresses the given type into SRAM with LZ4 asynchronously, writing only the bytes which have been changed.
+ *
+ * Compressed data can be read with sram::read_compressed_offset.
+ *
+ * Since only the changed bytes are written, saving data which has been changed at the end
+ * (appended replay frames, for example) writes only the bytes after the first change.
+ *
+ * @tparam Type Type of the data to write. It must be trivially copyable.
+ * @tparam MaxCompressedSize Size in bytes of the managed SRAM range.
+ * By default it is big enough to store incompressible data.
+ *
+ * @ingroup sram
+ */
+template<typename Type, int MaxCompressedSize = sram::max_compressed_size(int(sizeof(Type)))>
+class sram_compressed_writer : public isram_writer
+{
+    static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+    static_assert(int(sizeof(Type)) < 1 << 24, "Size is too high");
+    static_assert(MaxCompressedSize > 4 && MaxCompressedSize <= sram::size(), "Invalid max compressed size");
+
+public:
+    /**
+     * @brief Constructor.
+     * @param offset SRAM offset of the compressed data.
+     *
+     * The shadow copy is read from SRAM.
+     */
+    explicit sram_compressed_writer(int offset = 0) :
+        isram_writer(_data_buffer, _shadow_buffer, MaxCompressedSize, offset)
+    {
+    }
+
+    /**
+     * @brief Decompresses the last written value, which may not have been committed to SRAM yet.
+     * @param destination The last written value is decompressed into this value.
+     * @return `true` if a valid value has been written or read from SRAM, otherwise `false`.
+     */
+    [[nodiscard]] bool read(Type& destination) const
+    {
+        return _read_compressed(&destination, int(sizeof(Type)));
+    }
+
+    /**
+     * @brief Queues the given value to be compressed into SRAM.
+     *
+     * It is compressed into RAM immediately, and its changed bytes are written to SRAM by idle tasks.
+     */
+    void write(const Type& source)
+    {
+        _write_compressed(&source, int(sizeof(Type)));
+    }
+
+private:
+    alignas(int) uint8_t _data_buffer[MaxCompressedSize];
+    alignas(int) uint8_t _shadow_buffer[MaxCompressedSize];
+};
+
+}
+
+#endif
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TASK_H
+#define BN_TASK_H
+
+/**
+ * @file
+ * bn::task header file.
+ *
+ * @ingroup core
+ */
+
+#include <coroutine>
+#include "bn_assert.h"
+#include "bn_memory.h"
+#include "bn_utility.h"
+
+namespace bn
+{
+
+/**
+ * @brief Coroutine which allows to spread long computations across multiple frames.
+ *
+ * A task is suspended when it's created, and it can be resumed manually with update or automatically
+ * by core::update after calling run.
+ *
+ * Inside a task, `co_await bn::next_frame()` suspends it until the next frame,
+ * and `co_await bn::yield()` suspends it only if its ticks budget for the current frame has been exhausted.
+ *
+ * Coroutine frames are allocated with bn::memory::ewram_alloc.
+ *
+ * @ingroup core
+ */
+class task
+{
+
+public:
+    /**
+     * @brief Coroutine promise, required by the C++ coroutines machinery.
+     */
+    class promise_type
+    {
+
+    public:
+        /**
+         * @brief Allocates a coroutine frame with bn::memory::ewram_alloc.
+         */
+        [[nodiscard]] static void* operator new(decltype(sizeof(0)) bytes)
+        {
+            void* result = memory::ewram_alloc(int(bytes));
+            BN_ASSERT(result, "Task frame allocation failed: ", int(bytes));
+
+            return result;
+        }
+
+        /**
+         * @brief Deallocates a coroutine frame with bn::memory::ewram_free.
+         */
+        static void operator delete(void* ptr)
+        {
+            memory::ewram_free(ptr);
+        }
+
+        /**
+         * @brief Returns the task which owns this coroutine.
+         */
+        [[nodiscard]] task get_return_object()
+        {
+            return task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        /**
+         * @brief Suspends the task when it's created.
+         */
+        [[nodiscard]] std::suspend_always initial_suspend() noexcept
+        {
+            return std::suspend_always();
+        }
+
+        /**
+         * @brief Suspends the task when it's finished, so it can be destroyed by its owner.
+         */
+        [[nodiscard]] std::suspend_always final_suspend() noexcept
+        {
+            return std::suspend_always();
+        }
+
+        /**
+         * @brief Called when the task is finished.
+         */
+        void return_void()
+        {
+        }
+
+        /**
+         * @brief Called when an exception escapes the task.
+         */
+        void unhandled_exception()
+        {
+            BN_ERROR("Unhandled task exception");
+        }
+
+        /**
+         * @brief Returns the maximum number of timer ticks that the task can run per frame.
+         */
+        [[nodiscard]] int max_ticks() const
+        {
+            return _max_ticks;
+        }
+
+        /**
+         * @brief Resumes the task until it waits for the next frame, it's finished
+         * or its ticks budget for the current frame is exhausted.
+         * @return `true` if the task has been finished, otherwise `false`.
+         */
+        bool update();
+
+    private:
+        friend class task;
+        friend class task_next_frame;
+        friend class task_yield;
+
+        int _max_ticks = 0;
+        bool _wait_next_frame = true;
+        bool _running = false;
+    };
+
+    /**
+     * @brief Move constructor.
+     * @param other task to move.
+     */
+    task(task&& other) noexcept :
+        _handle(other._handle)
+    {
+        other._handle = nullptr;
+    }
+
+    task(const task& other) = delete;
+
+    /**
+     * @brief Move assignment operator.
+     * @param other task to move.
+     * @return Reference to this.
+     */
+    task& operator=(task&& other) noexcept
+    {
+        bn::swap(_handle, other._handle);
+        return *this;
+    }
+
+    task& operator=(const task& other) = delete;
+
+    /**
+     * @brief Destructor.
+     *
+     * It stops and destroys the coroutine.
+     */
+    ~task();
+
+    /**
+     * @brief Indicates if the task has been finished or not.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return ! _handle || _handle.done();
+    }
+
+    /**
+     * @brief Indicates if the task is resumed by core::update or not.
+     */
+    [[nodiscard]] bool running() const
+    {
+        return _handle && _handle.promise()._running;
+    }
+
+    /**
+     * @brief Returns the maximum number of timer ticks that the task can run per frame.
+     */
+    [[nodiscard]] int max_ticks() const
+    {
+        return _handle ? _handle.promise()._max_ticks : 0;
+    }
+
+    /**
+     * @brief Resumes the task each time core::update is called, until it's finished or stopped.
+     * @param max_ticks Maximum number of timer ticks that the task can run per frame (it must be >= 0).
+     * If it is 0, the task is resumed only once per frame.
+     *
+     * Keep in mind that a task can exceed its ticks budget, since it is checked only when `bn::yield()` is awaited.
+     */
+    void run(int max_ticks = 0);
+
+    /**
+     * @brief Stops resuming the task each time core::update is called.
+     */
+    void stop();
+
+    /**
+     * @brief Resumes the task until it waits for the next frame, it's finished
+     * or its ticks budget for the current frame is exhausted.
+     * @return `true` if the task has been finished, otherwise `false`.
+     */
+    bool update();
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+
+    explicit task(std::coroutine_handle<promise_type> handle) :
+        _handle(handle)
+    {
+    }
+};
+
+
+/**
+ * @brief Awaitable which suspends a task until the next frame.
+ *
+ * @ingroup core
+ */
+class task_next_frame
+{
+
+public:
+    /**
+     * @brief Indicates that the task must be always suspended.
+     */
+    [[nodiscard]] constexpr bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Marks the given task as waiting for the next frame.
+     */
+    void await_suspend(std::coroutine_handle<task::promise_type> handle) const noexcept
+    {
+        handle.promise()._wait_next_frame = true;
+    }
+
+    /**
+     * @brief Called when the task is resumed.
+     */
+    constexpr void await_resume() const noexcept
+    {
+    }
+};
+
+
+/**
+ * @brief Awaitable which suspends a task until the next frame only if its ticks budget has been exhausted.
+ *
+ * @ingroup core
+ */
+class task_yield
+{
+
+public:
+    /**
+     * @brief Indicates that the task must be always suspended, so its ticks budget can be checked.
+     */
+    [[nodiscard]] constexpr bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Marks the given task as able to continue in the current frame.
+     */
+    void await_suspend(std::coroutine_handle<task::promise_type> handle) const noexcept
+    {
+        handle.promise()._wait_next_frame = false;
+    }
+
+    /**
+     * @brief Called when the task is resumed.
+     */
+    constexpr void await_resume() const noexcept
+    {
+    }
+};
+
+
+/**
+ * @brief Returns an awaitable which suspends a task until the next frame.
+ *
+ * @ingroup core
+ */
+[[nodiscard]] constexpr task_next_frame next_frame()
+{
+    return task_next_frame();
+}
+
+/**
+ * @brief Returns an awaitable which suspends a task until the next frame
+ * only if its ticks budget for the current frame has been exhausted.
+ *
+ * @ingroup core
+ */
+[[nodiscard]] constexpr task_yield yield()
+{
+    return task_yield();
+}
+
+}
+
+#endif
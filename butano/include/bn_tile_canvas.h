@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TILE_CANVAS_H
+#define BN_TILE_CANVAS_H
+
+/**
+ * @file
+ * bn::tile_canvas header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+
+#include "bn_span.h"
+#include "bn_assert.h"
+#include "bn_bpp_mode.h"
+#include "bn_tile_canvas_texture.h"
+#include "bn_regular_bg_tiles_ptr.h"
+
+namespace bn
+{
+
+class point;
+class fixed_point;
+
+/**
+ * @brief Draws pixels into regular BG tiles like a framebuffer.
+ *
+ * Pixels are drawn into tiles stored in RAM, and only the modified tiles are uploaded to VRAM
+ * (in the next V-Blank after calling update).
+ *
+ * Tiles are arranged in rows: the tile of the pixel (x, y) is (y / 8) * columns() + (x / 8),
+ * so a regular BG map which references them in that order shows the canvas.
+ *
+ * Pixels are indexes to the colors of the palette of the BG which shows the canvas.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+class tile_canvas
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the tiles in RAM in which pixels are drawn.
+     * They should outlive the tile_canvas to avoid dangling references.
+     * @param width Width in pixels of the canvas (it must be a multiple of 8).
+     * @param height Height in pixels of the canvas (it must be a multiple of 8).
+     * @param bpp Bits per pixel of the canvas.
+     *
+     * The regular BG tiles shown by the canvas are allocated in VRAM and uploaded in the next update call.
+     */
+    tile_canvas(const span<tile>& tiles_ref, int width, int height, bpp_mode bpp);
+
+    /**
+     * @brief Returns the width in pixels of the canvas.
+     */
+    [[nodiscard]] int width() const
+    {
+        return _width;
+    }
+
+    /**
+     * @brief Returns the height in pixels of the canvas.
+     */
+    [[nodiscard]] int height() const
+    {
+        return _height;
+    }
+
+    /**
+     * @brief Returns the number of columns of tiles of the canvas.
+     */
+    [[nodiscard]] int columns() const
+    {
+        return _width / 8;
+    }
+
+    /**
+     * @brief Returns the number of rows of tiles of the canvas.
+     */
+    [[nodiscard]] int rows() const
+    {
+        return _height / 8;
+    }
+
+    /**
+     * @brief Returns the bits per pixel of the canvas.
+     */
+    [[nodiscard]] bpp_mode bpp() const
+    {
+        return _bpp;
+    }
+
+    /**
+     * @brief Returns the regular BG tiles in VRAM shown by the canvas.
+     */
+    [[nodiscard]] const regular_bg_tiles_ptr& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Returns the tiles in RAM in which pixels are drawn.
+     */
+    [[nodiscard]] const span<tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Indicates if there are modified tiles not uploaded to VRAM yet.
+     */
+    [[nodiscard]] bool dirty() const
+    {
+        return _first_dirty_tile <= _last_dirty_tile;
+    }
+
+    /**
+     * @brief Fills the canvas with the given color index.
+     */
+    void fill(int color_index);
+
+    /**
+     * @brief Sets the color index of the given pixel.
+     * @param x Horizontal position of the pixel (it must be inside the canvas).
+     * @param y Vertical position of the pixel (it must be inside the canvas).
+     * @param color_index Color index to set.
+     */
+    void plot(int x, int y, int color_index)
+    {
+        BN_ASSERT(x >= 0 && x < _width && y >= 0 && y < _height, "Invalid pixel: ", x, " - ", y);
+
+        _plot(x, y, color_index);
+    }
+
+    /**
+     * @brief Draws a horizontal line.
+     * @param x Horizontal position of the first pixel of the line.
+     * @param y Vertical position of the line.
+     * @param length Number of pixels of the line.
+     * @param color_index Color index of the line.
+     *
+     * The line is clipped to the canvas boundaries.
+     */
+    void draw_hline(int x, int y, int length, int color_index);
+
+    /**
+     * @brief Copies the given pixels to the canvas, skipping the ones with color index 0.
+     * @param pixels_ref Reference to the color indexes to copy (one byte per pixel), arranged in rows.
+     * @param pixels_width Width in pixels of the given pixels.
+     * @param x Horizontal position of the top-left corner of the destination rectangle.
+     * @param y Vertical position of the top-left corner of the destination rectangle.
+     *
+     * The destination rectangle is clipped to the canvas boundaries.
+     */
+    void blit(const span<const uint8_t>& pixels_ref, int pixels_width, int x, int y);
+
+    /**
+     * @brief Draws a horizontal line sampling the given texture.
+     * @param x Horizontal position of the first pixel of the line.
+     * @param y Vertical position of the line.
+     * @param length Number of pixels of the line.
+     * @param texture Texture to sample (it must have the same bits per pixel as the canvas).
+     * @param uv Texture coordinates of the first pixel of the line.
+     * @param uv_delta Increment of the texture coordinates per pixel.
+     *
+     * The line is clipped to the canvas boundaries. All texels are drawn, including the ones with color index 0.
+     */
+    void draw_textured_hline(int x, int y, int length, const tile_canvas_texture& texture, const fixed_point& uv,
+                             const fixed_point& uv_delta);
+
+    /**
+     * @brief Draws a triangle mapping the given texture to it.
+     * @param p0 First vertex of the triangle.
+     * @param p1 Second vertex of the triangle.
+     * @param p2 Third vertex of the triangle.
+     * @param texture Texture to sample (it must have the same bits per pixel as the canvas).
+     * @param uv0 Texture coordinates of the first vertex.
+     * @param uv1 Texture coordinates of the second vertex.
+     * @param uv2 Texture coordinates of the third vertex.
+     *
+     * The mapping is affine, so its texture coordinates increments are computed once per triangle.
+     *
+     * The triangle is clipped to the canvas boundaries. All texels are drawn, including the ones with color index 0.
+     */
+    void draw_textured_triangle(const point& p0, const point& p1, const point& p2, const tile_canvas_texture& texture,
+                                const fixed_point& uv0, const fixed_point& uv1, const fixed_point& uv2);
+
+    /**
+     * @brief Uploads the modified tiles to VRAM in the next V-Blank.
+     */
+    void update();
+
+private:
+    regular_bg_tiles_ptr _tiles;
+    span<tile> _tiles_ref;
+    int16_t _width;
+    int16_t _height;
+    int _first_dirty_tile;
+    int _last_dirty_tile;
+    bpp_mode _bpp;
+
+    BN_CODE_IWRAM void _plot(int x, int y, int color_index);
+
+    BN_CODE_IWRAM void _draw_hline(int x, int y, int length, int color_index);
+
+    BN_CODE_IWRAM void _blit(const uint8_t* pixels_ptr, int pixels_pitch, int x, int y, int width, int height);
+
+    BN_CODE_IWRAM void _draw_textured_hline(int x, int y, int length, const tile_canvas_texture& texture,
+                                            int u, int v, int du, int dv);
+};
+
+}
+
+#endif
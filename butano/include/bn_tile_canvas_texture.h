@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TILE_CANVAS_TEXTURE_H
+#define BN_TILE_CANVAS_TEXTURE_H
+
+/**
+ * @file
+ * bn::tile_canvas_texture header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+
+#include "bn_span.h"
+#include "bn_tile.h"
+#include "bn_assert.h"
+#include "bn_bpp_mode.h"
+#include "bn_power_of_two.h"
+
+namespace bn
+{
+
+/**
+ * @brief Tiles sampled by the textured drawing methods of bn::tile_canvas.
+ *
+ * Tiles are arranged in rows like in a tile_canvas or in a 1D mapped sprite tile set:
+ * the tile of the texel (u, v) is (v / 8) * (width() / 8) + (u / 8).
+ *
+ * Since the width and the height of the texture are powers of two, texture coordinates wrap around it.
+ *
+ * @ingroup regular_bg
+ * @ingroup tile
+ */
+class tile_canvas_texture
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to the tiles of the texture.
+     * They should outlive the tile_canvas_texture to avoid dangling references.
+     * @param width Width in pixels of the texture (it must be a power of two greater or equal than 8).
+     * @param height Height in pixels of the texture (it must be a power of two greater or equal than 8).
+     * @param bpp Bits per pixel of the texture.
+     */
+    constexpr tile_canvas_texture(const span<const tile>& tiles_ref, int width, int height, bpp_mode bpp) :
+        _tiles_ref(tiles_ref),
+        _width(int16_t(width)),
+        _height(int16_t(height)),
+        _columns_shift(0),
+        _bpp(bpp)
+    {
+        BN_ASSERT(width >= 8 && power_of_two(width), "Invalid width: ", width);
+        BN_ASSERT(height >= 8 && power_of_two(height), "Invalid height: ", height);
+        BN_ASSERT(tiles_ref.size() >= (width / 8) * (height / 8) * (bpp == bpp_mode::BPP_4 ? 1 : 2),
+                  "Invalid tiles count: ", tiles_ref.size(), " - ", width, " - ", height);
+
+        for(int columns = width / 8; columns > 1; columns /= 2)
+        {
+            ++_columns_shift;
+        }
+    }
+
+    /**
+     * @brief Returns the reference to the tiles of the texture.
+     */
+    [[nodiscard]] constexpr const span<const tile>& tiles_ref() const
+    {
+        return _tiles_ref;
+    }
+
+    /**
+     * @brief Returns the width in pixels of the texture.
+     */
+    [[nodiscard]] constexpr int width() const
+    {
+        return _width;
+    }
+
+    /**
+     * @brief Returns the height in pixels of the texture.
+     */
+    [[nodiscard]] constexpr int height() const
+    {
+        return _height;
+    }
+
+    /**
+     * @brief Returns the base 2 logarithm of the number of columns of tiles of the texture.
+     */
+    [[nodiscard]] constexpr int columns_shift() const
+    {
+        return _columns_shift;
+    }
+
+    /**
+     * @brief Returns the bits per pixel of the texture.
+     */
+    [[nodiscard]] constexpr bpp_mode bpp() const
+    {
+        return _bpp;
+    }
+
+private:
+    span<const tile> _tiles_ref;
+    int16_t _width;
+    int16_t _height;
+    int8_t _columns_shift;
+    bpp_mode _bpp;
+};
+
+}
+
+#endif
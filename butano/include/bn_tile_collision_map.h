@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TILE_COLLISION_MAP_H
+#define BN_TILE_COLLISION_MAP_H
+
+/**
+ * @file
+ * bn::tile_collision_map header file.
+ *
+ * @ingroup bg_map
+ */
+
+#include "bn_optional.h"
+#include "bn_fixed_rect.h"
+#include "bn_tile_collision_map_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Collision queries against the packed cells of a tile_collision_map_item.
+ *
+ * Positions are in pixels relative to the top-left corner of the map, and each cell is 8x8 pixels.
+ *
+ * Queries take a mask of the collision values which block movement: if the bit `1 << value` is set,
+ * cells with that collision value are solid.
+ *
+ * The referenced item should outlive the tile_collision_map to avoid dangling references.
+ *
+ * @ingroup bg_map
+ */
+class tile_collision_map
+{
+
+public:
+    /**
+     * @brief Result of a successful raycast.
+     *
+     * @ingroup bg_map
+     */
+    class raycast_hit
+    {
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param position Position in which the ray enters the hit cell.
+         * @param cell Position of the hit cell.
+         * @param value Collision value of the hit cell.
+         */
+        constexpr raycast_hit(const fixed_point& position, const point& cell, int value) :
+            _position(position),
+            _cell(cell),
+            _value(value)
+        {
+        }
+
+        /**
+         * @brief Returns the position in which the ray enters the hit cell.
+         */
+        [[nodiscard]] constexpr const fixed_point& position() const
+        {
+            return _position;
+        }
+
+        /**
+         * @brief Returns the position of the hit cell.
+         */
+        [[nodiscard]] constexpr const point& cell() const
+        {
+            return _cell;
+        }
+
+        /**
+         * @brief Returns the collision value of the hit cell.
+         */
+        [[nodiscard]] constexpr int value() const
+        {
+            return _value;
+        }
+
+    private:
+        fixed_point _position;
+        point _cell;
+        int _value;
+    };
+
+    /**
+     * @brief Returns the mask which makes all cells with a collision value different than zero solid.
+     */
+    [[nodiscard]] constexpr static unsigned default_solid_values_mask()
+    {
+        return 0b1110;
+    }
+
+    /**
+     * @brief Constructor.
+     * @param item Collision map item to query.
+     * @param outside_value Collision value of the cells outside of the map.
+     */
+    explicit tile_collision_map(const tile_collision_map_item& item, int outside_value = 0);
+
+    /**
+     * @brief Returns the queried collision map item.
+     */
+    [[nodiscard]] const tile_collision_map_item& item() const
+    {
+        return *_item_ptr;
+    }
+
+    /**
+     * @brief Returns the collision value of the cells outside of the map.
+     */
+    [[nodiscard]] int outside_value() const
+    {
+        return _outside_value;
+    }
+
+    /**
+     * @brief Returns the collision value of the specified cell, or outside_value() if it is outside of the map.
+     */
+    [[nodiscard]] int value(int x, int y) const
+    {
+        const size& dimensions = _item_ptr->dimensions();
+
+        if(x < 0 || y < 0 || x >= dimensions.width() || y >= dimensions.height())
+        {
+            return _outside_value;
+        }
+
+        return _item_ptr->cell(x, y);
+    }
+
+    /**
+     * @brief Returns the collision value of the cell which contains the given position.
+     */
+    [[nodiscard]] int value(const fixed_point& position) const
+    {
+        return value(position.x().right_shift_integer() >> 3, position.y().right_shift_integer() >> 3);
+    }
+
+    /**
+     * @brief Moves the given rectangle by the given delta, stopping it at the first solid cells.
+     *
+     * The horizontal movement is resolved first, and then the vertical one.
+     *
+     * @param rect Rectangle to move. It should not overlap solid cells.
+     * @param delta Requested displacement.
+     * @param solid_values_mask Mask of the collision values which block movement.
+     * @return Displacement which moves the rectangle without overlapping solid cells.
+     * If a component is different than the requested one, the rectangle has hit a solid cell in that axis.
+     */
+    [[nodiscard]] fixed_point sweep(const fixed_rect& rect, const fixed_point& delta,
+                                    unsigned solid_values_mask = default_solid_values_mask()) const;
+
+    /**
+     * @brief Finds the first solid cell intersected by the segment between the given points.
+     * @param origin First point of the segment.
+     * @param end Last point of the segment.
+     * @param solid_values_mask Mask of the collision values which block the ray.
+     * @return The first hit if the segment intersects a solid cell; bn::nullopt otherwise.
+     */
+    [[nodiscard]] optional<raycast_hit> raycast(const fixed_point& origin, const fixed_point& end,
+                                                unsigned solid_values_mask = default_solid_values_mask()) const;
+
+private:
+    const tile_collision_map_item* _item_ptr;
+    int _outside_value;
+
+    [[nodiscard]] bool _solid(int x, int y, unsigned solid_values_mask) const
+    {
+        return (solid_values_mask >> value(x, y)) & 1;
+    }
+
+    [[nodiscard]] BN_CODE_IWRAM int _sweep_x(int left, int top, int right, int bottom, int delta,
+                                             unsigned solid_values_mask) const;
+
+    [[nodiscard]] BN_CODE_IWRAM int _sweep_y(int left, int top, int right, int bottom, int delta,
+                                             unsigned solid_values_mask) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TILE_COLLISION_MAP_ITEM_H
+#define BN_TILE_COLLISION_MAP_ITEM_H
+
+/**
+ * @file
+ * bn::tile_collision_map_item header file.
+ *
+ * @ingroup bg_map
+ * @ingroup tool
+ */
+
+#include "bn_size.h"
+#include "bn_assert.h"
+#include "bn_alignment.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the collision value of each 8x8 cell of a map, packed in 1 or 2 bits per cell.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `tile_collision_map` type.
+ *
+ * Each row of cells starts at a new 32-bit word, with the first cell in the least significant bits.
+ *
+ * The packed cells are not copied but referenced, so they should outlive the tile_collision_map_item
+ * to avoid dangling references.
+ *
+ * @ingroup bg_map
+ * @ingroup tool
+ */
+class tile_collision_map_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param cells_ref Reference to the packed collision values.
+     *
+     * The packed cells are not copied but referenced, so they should outlive the tile_collision_map_item
+     * to avoid dangling references.
+     *
+     * @param dimensions Size in cells of the collision map.
+     * @param bits_per_cell Bits per collision value (1 or 2).
+     */
+    constexpr tile_collision_map_item(const uint32_t& cells_ref, const size& dimensions, int bits_per_cell) :
+        _cells_ptr(&cells_ref),
+        _dimensions(dimensions),
+        _bits_per_cell(int8_t(bits_per_cell))
+    {
+        BN_ASSERT(aligned<alignof(int)>(&cells_ref), "Collision cells are not aligned");
+        BN_ASSERT(dimensions.width() > 0 && dimensions.height() > 0,
+                  "Invalid dimensions: ", dimensions.width(), " - ", dimensions.height());
+        BN_ASSERT(bits_per_cell == 1 || bits_per_cell == 2, "Invalid bits per cell: ", bits_per_cell);
+    }
+
+    /**
+     * @brief Returns the referenced packed collision values.
+     */
+    [[nodiscard]] constexpr const uint32_t& cells_ref() const
+    {
+        return *_cells_ptr;
+    }
+
+    /**
+     * @brief Returns the size in cells of the collision map.
+     */
+    [[nodiscard]] constexpr const size& dimensions() const
+    {
+        return _dimensions;
+    }
+
+    /**
+     * @brief Returns the bits used by each collision value (1 or 2).
+     */
+    [[nodiscard]] constexpr int bits_per_cell() const
+    {
+        return _bits_per_cell;
+    }
+
+    /**
+     * @brief Returns the number of 32-bit words of each row of cells.
+     */
+    [[nodiscard]] constexpr int words_per_row() const
+    {
+        return ((_dimensions.width() * _bits_per_cell) + 31) / 32;
+    }
+
+    /**
+     * @brief Returns the collision value of the specified cell.
+     * @param x Horizontal position of the cell [0..dimensions().width()).
+     * @param y Vertical position of the cell [0..dimensions().height()).
+     * @return The collision value of the specified cell, in the range [0..(1 << bits_per_cell())).
+     */
+    [[nodiscard]] constexpr int cell(int x, int y) const
+    {
+        BN_ASSERT(x >= 0 && x < _dimensions.width(), "Invalid x: ", x, " - ", _dimensions.width());
+        BN_ASSERT(y >= 0 && y < _dimensions.height(), "Invalid y: ", y, " - ", _dimensions.height());
+
+        int bits_per_cell = _bits_per_cell;
+        int bit = x * bits_per_cell;
+        uint32_t word = _cells_ptr[(y * words_per_row()) + (bit / 32)];
+        return int((word >> (bit % 32)) & ((1U << bits_per_cell) - 1));
+    }
+
+private:
+    const uint32_t* _cells_ptr;
+    size _dimensions;
+    int8_t _bits_per_cell;
+};
+
+}
+
+#endif
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TIMELINE_H
+#define BN_TIMELINE_H
+
+/**
+ * @file
+ * bn::itimeline and bn::timeline implementation header file.
+ *
+ * @ingroup action
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_easing.h"
+
+namespace bn
+{
+
+/**
+ * @brief Value of a timeline track in a given frame.
+ *
+ * @ingroup action
+ */
+class timeline_keyframe
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param frame Frame of the keyframe (>= 0).
+     * @param value Value of the track in the given frame.
+     * @param easing Easing function used to reach this keyframe from the previous one.
+     */
+    constexpr timeline_keyframe(int frame, fixed value, easing_type easing = easing_type::LINEAR) :
+        _value(value),
+        _frame(frame),
+        _easing(easing)
+    {
+        BN_ASSERT(frame >= 0, "Invalid frame: ", frame);
+    }
+
+    /**
+     * @brief Returns the frame of the keyframe.
+     */
+    [[nodiscard]] constexpr int frame() const
+    {
+        return _frame;
+    }
+
+    /**
+     * @brief Returns the value of the track in the frame of the keyframe.
+     */
+    [[nodiscard]] constexpr fixed value() const
+    {
+        return _value;
+    }
+
+    /**
+     * @brief Returns the easing function used to reach this keyframe from the previous one.
+     */
+    [[nodiscard]] constexpr easing_type easing() const
+    {
+        return _easing;
+    }
+
+private:
+    fixed _value;
+    int _frame;
+    easing_type _easing;
+};
+
+
+/**
+ * @brief Base class of bn::timeline.
+ *
+ * A timeline drives properties (positions, scales, palette fade intensities, blending alphas, etc)
+ * from tracks of keyframes, one fixed point property per track.
+ *
+ * Tracks are evaluated incrementally: per frame, the progress of each track is increased
+ * without divisions or trigonometric calls, and the eased value is read from easing_lut.
+ *
+ * A track setter is called only when the value of its track changes:
+ *
+ * @code{.cpp}
+ * timeline.add_track(x_keyframes, [](void* target_ptr, bn::fixed x)
+ * {
+ *     static_cast<bn::sprite_ptr*>(target_ptr)->set_x(x);
+ * }, &sprite);
+ * @endcode
+ *
+ * @ingroup action
+ */
+class itimeline
+{
+
+public:
+    /**
+     * @brief Function which writes the value of a track into its property.
+     * @param target_ptr Target object provided when the track was added.
+     * @param value New value of the track.
+     */
+    using setter_type = void(*)(void* target_ptr, fixed value);
+
+    itimeline(const itimeline& other) = delete;
+
+    itimeline& operator=(const itimeline& other) = delete;
+
+    /**
+     * @brief Returns the current frame.
+     */
+    [[nodiscard]] int frame() const
+    {
+        return _frame;
+    }
+
+    /**
+     * @brief Returns the frame of the last keyframe of all tracks.
+     */
+    [[nodiscard]] int duration_frames() const
+    {
+        return _duration_frames;
+    }
+
+    /**
+     * @brief Indicates if the timeline goes back to its first frame when the last one is reached.
+     */
+    [[nodiscard]] bool looping() const
+    {
+        return _looping;
+    }
+
+    /**
+     * @brief Sets if the timeline goes back to its first frame when the last one is reached.
+     */
+    void set_looping(bool looping)
+    {
+        _looping = looping;
+    }
+
+    /**
+     * @brief Indicates if the last frame has been reached and the timeline is not looping.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return ! _looping && _frame >= _duration_frames;
+    }
+
+    /**
+     * @brief Returns the number of tracks.
+     */
+    [[nodiscard]] int tracks_count() const
+    {
+        return _tracks.size();
+    }
+
+    /**
+     * @brief Returns the maximum number of tracks.
+     */
+    [[nodiscard]] int max_tracks_count() const
+    {
+        return _tracks.max_size();
+    }
+
+    /**
+     * @brief Adds a track and writes its value in the current frame.
+     * @param keyframes_ref Reference to the keyframes of the track, sorted by frame without repeated frames.
+     *
+     * The keyframes are not copied but referenced, so they should outlive the timeline
+     * to avoid dangling references.
+     *
+     * @param setter Function which writes the value of the track into its property.
+     * @param target_ptr Object passed to the setter.
+     */
+    void add_track(const span<const timeline_keyframe>& keyframes_ref, setter_type setter, void* target_ptr);
+
+    /**
+     * @brief Removes all tracks.
+     */
+    void clear();
+
+    /**
+     * @brief Goes back to the first frame, writing the first value of each track.
+     */
+    void reset();
+
+    /**
+     * @brief Advances one frame, writing the new value of each track.
+     */
+    void update();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    class track_type
+    {
+
+    public:
+        span<const timeline_keyframe> keyframes_ref;
+        setter_type setter;
+        void* target_ptr;
+        int progress;
+        int progress_increment;
+        int keyframe_index;
+        fixed value;
+    };
+
+    explicit itimeline(ivector<track_type>& tracks) :
+        _tracks(tracks)
+    {
+    }
+
+    /// @endcond
+
+private:
+    ivector<track_type>& _tracks;
+    int _frame = 0;
+    int _duration_frames = 0;
+    bool _looping = false;
+
+    void _start_track(track_type& track);
+
+    void _update_track(track_type& track);
+
+    void _start_segment(track_type& track);
+
+    [[nodiscard]] fixed _value(const track_type& track) const;
+};
+
+
+/**
+ * @brief Drives properties from tracks of keyframes.
+ *
+ * @tparam MaxTracks Maximum number of tracks.
+ *
+ * @ingroup action
+ */
+template<int MaxTracks>
+class timeline : public itimeline
+{
+    static_assert(MaxTracks > 0);
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    timeline() :
+        itimeline(_tracks_vector)
+    {
+    }
+
+private:
+    vector<track_type, MaxTracks> _tracks_vector;
+};
+
+}
+
+#endif
@@ -23,6 +23,9 @@ namespace bn
  *
  * One timer tick is equivalent to 64 CPU clock cycles.
  *
+ * Ticks are counted with two cascaded hardware timers, so elapsed times up to 2^31 ticks (more than two hours)
+ * are measured without overflows.
+ *
  * @ingroup timer
  */
 class timer
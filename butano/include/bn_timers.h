@@ -45,6 +45,17 @@ namespace bn::timers
     {
         return hw::timers::divisor();
     }
+
+    /**
+     * @brief Converts the given number of ticks to microseconds (rounded down) without divisions.
+     */
+    [[nodiscard]] constexpr int64_t ticks_to_microseconds(int64_t ticks)
+    {
+        // One tick is 64 / 16777216 seconds, which is exactly 15625 / 4096 microseconds:
+        static_assert(hw::timers::divisor() == 64);
+
+        return (ticks * 15625) >> 12;
+    }
 }
 
 #endif
@@ -75,7 +75,56 @@ namespace bn
     using std::remove_cv;
     using std::remove_cv_t;
 
+    using std::type_identity;
+    using std::type_identity_t;
+
     using std::is_constant_evaluated;
+
+    using std::integral_constant;
+    using std::bool_constant;
+    using std::true_type;
+    using std::false_type;
+
+    using std::conditional;
+    using std::conditional_t;
+
+    /**
+     * @brief Checks if objects of the given type can be moved to another address with a raw memory copy,
+     * without calling the move constructor nor the destructor of the moved from object.
+     *
+     * Trivially copyable types are trivially relocatable by default,
+     * and types which only hold a handle to an engine resource specialize it.
+     *
+     * It allows containers like bn::ivector to shift elements with one memmove call.
+     *
+     * @ingroup std
+     */
+    template<typename Type>
+    struct is_trivially_relocatable : bool_constant<is_trivially_copyable_v<Type>>
+    {
+    };
+
+    /**
+     * @brief Checks if objects of the given type can be moved to another address with a raw memory copy,
+     * without calling the move constructor nor the destructor of the moved from object.
+     *
+     * @ingroup std
+     */
+    template<typename Type>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Type>::value;
+
+    /**
+     * @brief Smallest unsigned integer type which can store any value in the range [0, MaxValue].
+     *
+     * It allows to size indexes and links of containers from their compile-time capacity.
+     *
+     * @tparam MaxValue Maximum value to store.
+     *
+     * @ingroup std
+     */
+    template<unsigned MaxValue>
+    using uint_least_for = conditional_t<MaxValue <= 0xFF, uint8_t,
+            conditional_t<MaxValue <= 0xFFFF, uint16_t, uint32_t>>;
 }
 
 #endif
@@ -72,10 +72,10 @@ public:
         {
             size_type index = _index;
             size_type last_valid_index = _map->_last_valid_index;
-            const bool* allocated = _map->_allocated;
+            const uint16_t* distances = _map->_distances;
             ++index;
 
-            while(index <= last_valid_index && ! allocated[index])
+            while(index <= last_valid_index && ! distances[index])
             {
                 ++index;
             }
@@ -97,10 +97,10 @@ public:
         {
             int index = _index;
             int first_valid_index = _map->_first_valid_index;
-            const bool* allocated = _map->_allocated;
+            const uint16_t* distances = _map->_distances;
             --index;
 
-            while(index >= first_valid_index && ! allocated[index])
+            while(index >= first_valid_index && ! distances[index])
             {
                 --index;
             }
@@ -217,10 +217,10 @@ public:
         {
             size_type index = _index;
             size_type last_valid_index = _map->_last_valid_index;
-            const bool* allocated = _map->_allocated;
+            const uint16_t* distances = _map->_distances;
             ++index;
 
-            while(index <= last_valid_index && ! allocated[index])
+            while(index <= last_valid_index && ! distances[index])
             {
                 ++index;
             }
@@ -242,10 +242,10 @@ public:
         {
             int index = _index;
             int first_valid_index = _map->_first_valid_index;
-            const bool* allocated = _map->_allocated;
+            const uint16_t* distances = _map->_distances;
             --index;
 
-            while(index >= first_valid_index && ! allocated[index])
+            while(index >= first_valid_index && ! distances[index])
             {
                 --index;
             }
@@ -580,21 +580,21 @@ public:
         }
 
         const_pointer storage = _storage;
-        const bool* allocated = _allocated;
+        const uint16_t* distances = _distances;
         key_equal key_equal_functor;
         size_type index = _index(key_hash);
-        size_type max_size = _max_size_minus_one + 1;
-        size_type its = 0;
+        int distance = 1;
 
-        while(its < max_size && allocated[index])
+        // A key can't be stored after a slot closer to its own ideal one:
+        while(distances[index] >= distance)
         {
-            if(key_equal_functor(key, storage[index].first))
+            if(distances[index] == distance && key_equal_functor(key, storage[index].first))
             {
                 return iterator(index, *this);
             }
 
             index = _index(index + 1);
-            ++its;
+            ++distance;
         }
 
         return end();
@@ -706,29 +706,67 @@ public:
      */
     iterator insert_hash(hash_type key_hash, value_type&& value)
     {
-        size_type index = _index(key_hash);
         pointer storage = _storage;
-        bool* allocated = _allocated;
+        uint16_t* distances = _distances;
         key_equal key_equal_functor;
-        size_type current_index = index;
+        size_type index = _index(key_hash);
+        int distance = 1;
 
-        while(allocated[current_index])
+        while(distances[index] >= distance)
         {
-            if(key_equal_functor(value.first, storage[current_index].first))
+            if(distances[index] == distance && key_equal_functor(value.first, storage[index].first))
             {
                 return end();
             }
 
-            current_index = _index(current_index + 1);
-            BN_ASSERT(current_index != index, "All indices are allocated");
+            index = _index(index + 1);
+            ++distance;
+        }
+
+        BN_ASSERT(! full(), "All indices are allocated");
+
+        size_type result_index = index;
+
+        if(int displaced_distance = distances[index])
+        {
+            // Elements closer to their ideal slot are displaced to the following ones:
+            value_type displaced_value(move(storage[index]));
+            storage[index].~value_type();
+            ::new(storage + index) value_type(move(value));
+            distances[index] = uint16_t(distance);
+            index = _index(index + 1);
+            ++displaced_distance;
+
+            while(int current_distance = distances[index])
+            {
+                if(current_distance < displaced_distance)
+                {
+                    value_type next_displaced_value(move(storage[index]));
+                    storage[index].~value_type();
+                    ::new(storage + index) value_type(move(displaced_value));
+                    distances[index] = uint16_t(displaced_distance);
+                    displaced_value.~value_type();
+                    ::new(&displaced_value) value_type(move(next_displaced_value));
+                    displaced_distance = current_distance;
+                }
+
+                index = _index(index + 1);
+                ++displaced_distance;
+            }
+
+            ::new(storage + index) value_type(move(displaced_value));
+            distances[index] = uint16_t(displaced_distance);
+        }
+        else
+        {
+            ::new(storage + index) value_type(move(value));
+            distances[index] = uint16_t(distance);
         }
 
-        ::new(storage + current_index) value_type(move(value));
-        allocated[current_index] = true;
-        _first_valid_index = min(_first_valid_index, current_index);
-        _last_valid_index = max(_last_valid_index, current_index);
+        _first_valid_index = min(_first_valid_index, index);
+        _last_valid_index = max(_last_valid_index, index);
         ++_size;
-        return iterator(current_index, *this);
+        return iterator(result_index, *this);
     }
 
     /**
@@ -915,72 +953,21 @@ public:
      */
     iterator erase(const const_iterator& position)
     {
-        bool* allocated = _allocated;
         size_type index = position._index;
-        BN_ASSERT(allocated[index], "Index is not allocated: ", index);
-
-        pointer storage = _storage;
-        storage[index].~value_type();
-        allocated[index] = false;
-        --_size;
+        _erase_index(index);
 
         if(! _size)
         {
-            _first_valid_index = max_size();
-            _last_valid_index = 0;
             return end();
         }
 
-        size_type first_valid_index = _first_valid_index;
-
-        if(index == first_valid_index)
-        {
-            while(! allocated[first_valid_index])
-            {
-                ++first_valid_index;
-            }
-
-            _first_valid_index = first_valid_index;
-        }
-
+        // The following element could have been moved to the erased one slot:
+        const uint16_t* distances = _distances;
         size_type last_valid_index = _last_valid_index;
 
-        if(index == last_valid_index)
-        {
-            while(! allocated[last_valid_index])
-            {
-                --last_valid_index;
-            }
-
-            _last_valid_index = last_valid_index;
-        }
-
-        size_type next_index = _index(index + 1);
-        int reinsert_count = 0;
-
-        while(allocated[next_index])
-        {
-            ++reinsert_count;
-            next_index = _index(next_index + 1);
-        }
-
-        next_index = _index(index + 1);
-        _size -= reinsert_count;
-
-        for(int reinsert_index = 0; reinsert_index < reinsert_count; ++reinsert_index)
-        {
-            value_type temp_value(move(storage[next_index]));
-            storage[next_index].~value_type();
-            allocated[next_index] = false;
-            insert(move(temp_value));
-            next_index = _index(next_index + 1);
-        }
-
-        last_valid_index = _last_valid_index;
-
         while(index <= last_valid_index)
         {
-            if(allocated[index])
+            if(distances[index])
             {
                 return iterator(index, *this);
             }
@@ -1030,32 +1017,24 @@ public:
     friend size_type erase_if(iunordered_map& map, const Pred& pred)
     {
         size_type erased_count = 0;
-        pointer storage = map._storage;
-        bool* allocated = map._allocated;
-        size_type first_valid_index = map.max_size();
-        size_type last_valid_index = 0;
+        const_pointer storage = map._storage;
+        const uint16_t* distances = map._distances;
+        size_type index = map._first_valid_index;
 
-        for(size_type index = map._first_valid_index, last = map._last_valid_index; index <= last; ++index)
+        while(index <= map._last_valid_index)
         {
-            if(allocated[index])
+            if(distances[index] && pred(storage[index]))
             {
-                if(allocated[index] && pred(storage[index]))
-                {
-                    storage[index].~value_type();
-                    allocated[index] = false;
-                    ++erased_count;
-                }
-                else
-                {
-                    first_valid_index = min(index, first_valid_index);
-                    last_valid_index = max(index, last_valid_index);
-                }
+                // The index is not incremented, since the following element could have been moved to it:
+                map._erase_index(index);
+                ++erased_count;
+            }
+            else
+            {
+                ++index;
             }
         }
 
-        map._size -= erased_count;
-        map._first_valid_index = first_valid_index;
-        map._last_valid_index = last_valid_index;
         return erased_count;
     }
 
@@ -1069,33 +1048,17 @@ public:
             BN_ASSERT(_max_size_minus_one == other._max_size_minus_one,
                        "Invalid max size: ", max_size(), " - ", other.max_size());
 
-            pointer storage = _storage;
             pointer other_storage = other._storage;
-            bool* allocated = _allocated;
-            bool* other_allocated = other._allocated;
-            size_type size = _size;
-            size_type first_valid_index = min(_first_valid_index, other._first_valid_index);
-            size_type last_valid_index = max(_last_valid_index, other._last_valid_index);
+            const uint16_t* other_distances = other._distances;
 
-            for(size_type index = first_valid_index; index <= last_valid_index; ++index)
+            for(size_type index = other._first_valid_index, last = other._last_valid_index; index <= last; ++index)
             {
-                if(other_allocated[index])
+                if(other_distances[index])
                 {
-                    if(allocated[index])
-                    {
-                        storage[index] = move(other_storage[index]);
-                    }
-                    else
-                    {
-                        ::new(storage + index) value_type(move(other_storage[index]));
-                        ++size;
-                    }
+                    insert_or_assign(move(other_storage[index]));
                 }
             }
 
-            _size = size;
-            _first_valid_index = first_valid_index;
-            _last_valid_index = last_valid_index;
             other.clear();
         }
     }
@@ -1108,7 +1071,7 @@ public:
         if(_size)
         {
             size_type max_size = _max_size_minus_one + 1;
-            memory::clear(max_size, *_allocated);
+            memory::clear(max_size, *_distances);
             _first_valid_index = max_size;
             _last_valid_index = 0;
             _size = 0;
@@ -1124,20 +1087,20 @@ public:
         if(_size)
         {
             pointer storage = _storage;
-            bool* allocated = _allocated;
+            uint16_t* distances = _distances;
             size_type first_valid_index = _first_valid_index;
             size_type last_valid_index = _last_valid_index;
 
             for(size_type index = first_valid_index; index <= last_valid_index; ++index)
             {
-                if(allocated[index])
+                if(distances[index])
                 {
                     storage[index].~value_type();
                 }
             }
 
             size_type max_size = _max_size_minus_one + 1;
-            memory::clear(max_size, *allocated);
+            memory::clear(max_size, *distances);
             _first_valid_index = max_size;
             _last_valid_index = 0;
             _size = 0;
@@ -1199,35 +1162,36 @@ public:
 
             pointer storage = _storage;
             pointer other_storage = other._storage;
-            bool* allocated = _allocated;
-            bool* other_allocated = other._allocated;
+            uint16_t* distances = _distances;
+            uint16_t* other_distances = other._distances;
             size_type first_valid_index = min(_first_valid_index, other._first_valid_index);
             size_type last_valid_index = max(_last_valid_index, other._last_valid_index);
 
             for(size_type index = first_valid_index; index <= last_valid_index; ++index)
             {
-                if(other_allocated[index])
+                if(other_distances[index])
                 {
-                    if(allocated[index])
+                    if(distances[index])
                     {
                         bn::swap(storage[index], other_storage[index]);
+                        bn::swap(distances[index], other_distances[index]);
                     }
                     else
                     {
                         ::new(storage + index) value_type(move(other_storage[index]));
                         other_storage[index].~value_type();
-                        other_allocated[index] = false;
-                        allocated[index] = true;
+                        distances[index] = other_distances[index];
+                        other_distances[index] = 0;
                     }
                 }
                 else
                 {
-                    if(allocated[index])
+                    if(distances[index])
                     {
                         ::new(other_storage + index) value_type(move(storage[index]));
                         storage[index].~value_type();
-                        allocated[index] = false;
-                        other_allocated[index] = true;
+                        other_distances[index] = distances[index];
+                        distances[index] = 0;
                     }
                 }
             }
@@ -1266,17 +1230,17 @@ public:
 
         const_pointer a_storage = a._storage;
         const_pointer b_storage = b._storage;
-        const bool* a_allocated = a._allocated;
-        const bool* b_allocated = b._allocated;
+        const uint16_t* a_distances = a._distances;
+        const uint16_t* b_distances = b._distances;
 
         for(size_type index = first_valid_index; index <= last_valid_index; ++index)
         {
-            if(a_allocated[index] != b_allocated[index])
+            if(a_distances[index] != b_distances[index])
             {
                 return false;
             }
 
-            if(a_allocated[index] && a_storage[index] != b_storage[index])
+            if(a_distances[index] && a_storage[index] != b_storage[index])
             {
                 return false;
             }
@@ -1347,9 +1311,9 @@ public:
 protected:
     /// @cond DO_NOT_DOCUMENT
 
-    iunordered_map(reference storage, bool& allocated, size_type max_size) :
+    iunordered_map(reference storage, uint16_t& distances, size_type max_size) :
         _storage(&storage),
-        _allocated(&allocated),
+        _distances(&distances),
         _max_size_minus_one(max_size - 1),
         _first_valid_index(max_size)
     {
@@ -1359,14 +1323,14 @@ protected:
     {
         const_pointer other_storage = other._storage;
         pointer storage = _storage;
-        bool* allocated = _allocated;
+        uint16_t* distances = _distances;
         size_type first_valid_index = other._first_valid_index;
         size_type last_valid_index = other._last_valid_index;
-        memory::copy(*other._allocated, other.max_size(), *allocated);
+        memory::copy(*other._distances, other.max_size(), *distances);
 
         for(size_type index = first_valid_index; index <= last_valid_index; ++index)
         {
-            if(allocated[index])
+            if(distances[index])
             {
                 ::new(storage + index) value_type(other_storage[index]);
             }
@@ -1381,15 +1345,15 @@ protected:
     {
         pointer other_storage = other._storage;
         pointer storage = _storage;
-        bool* allocated = _allocated;
+        uint16_t* distances = _distances;
         size_type first_valid_index = other._first_valid_index;
         size_type last_valid_index = other._last_valid_index;
         int other_max_size = other.max_size();
-        memory::copy(*other._allocated, other_max_size, *allocated);
+        memory::copy(*other._distances, other_max_size, *distances);
 
         for(size_type index = first_valid_index; index <= last_valid_index; ++index)
         {
-            if(allocated[index])
+            if(distances[index])
             {
                 ::new(storage + index) value_type(move(other_storage[index]));
             }
@@ -1405,7 +1369,7 @@ protected:
 
 private:
     pointer _storage;
-    bool* _allocated;
+    uint16_t* _distances;
     size_type _max_size_minus_one;
     size_type _first_valid_index;
     size_type _last_valid_index = 0;
@@ -1415,6 +1379,61 @@ private:
     {
         return key_hash & _max_size_minus_one;
     }
+
+    void _erase_index(size_type index)
+    {
+        pointer storage = _storage;
+        uint16_t* distances = _distances;
+        BN_ASSERT(distances[index], "Index is not allocated: ", index);
+
+        storage[index].~value_type();
+        --_size;
+
+        // Backward shift deletion: following elements which are not in their ideal slot are moved back:
+        size_type next_index = _index(index + 1);
+
+        while(distances[next_index] > 1)
+        {
+            ::new(storage + index) value_type(move(storage[next_index]));
+            storage[next_index].~value_type();
+            distances[index] = uint16_t(distances[next_index] - 1);
+            index = next_index;
+            next_index = _index(next_index + 1);
+        }
+
+        distances[index] = 0;
+
+        if(! _size)
+        {
+            _first_valid_index = max_size();
+            _last_valid_index = 0;
+            return;
+        }
+
+        size_type first_valid_index = _first_valid_index;
+
+        if(index == first_valid_index)
+        {
+            while(! distances[first_valid_index])
+            {
+                ++first_valid_index;
+            }
+
+            _first_valid_index = first_valid_index;
+        }
+
+        size_type last_valid_index = _last_valid_index;
+
+        if(index == last_valid_index)
+        {
+            while(! distances[last_valid_index])
+            {
+                --last_valid_index;
+            }
+
+            _last_valid_index = last_valid_index;
+        }
+    }
 };
 
 
@@ -1422,6 +1441,7 @@ template<typename Key, typename Value, int MaxSize, typename KeyHash, typename K
 class unordered_map : public iunordered_map<Key, Value, KeyHash, KeyEqual>
 {
     static_assert(power_of_two(MaxSize));
+    static_assert(MaxSize <= 32768);
 
 public:
     using key_type = Key; //!< Key type alias.
@@ -1442,7 +1462,7 @@ public:
      */
     unordered_map() :
         iunordered_map<Key, Value, KeyHash, KeyEqual>(
-            *reinterpret_cast<pointer>(_storage_buffer), *_allocated_buffer, MaxSize)
+            *reinterpret_cast<pointer>(_storage_buffer), *_distances_buffer, MaxSize)
     {
     }
 
@@ -1576,7 +1596,7 @@ private:
     static constexpr unsigned _alignment = alignof(value_type) > alignof(int) ? alignof(value_type) : alignof(int);
 
     alignas(_alignment) char _storage_buffer[sizeof(value_type) * MaxSize];
-    bool _allocated_buffer[MaxSize] = {};
+    uint16_t _distances_buffer[MaxSize] = {};
 };
 
 }
@@ -37,6 +37,9 @@ namespace bn
      *
      * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
      *
+     * Elements are stored with Robin Hood hashing, so insertions and erasures can move other elements
+     * (invalidating iterators and references to them).
+     *
      * @tparam Key Key type.
      * @tparam Value Value type.
      * @tparam MaxSize Maximum number of elements that can be stored.
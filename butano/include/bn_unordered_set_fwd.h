@@ -36,6 +36,9 @@ namespace bn
      *
      * It doesn't throw exceptions. Instead, asserts are used to ensure valid usage.
      *
+     * Elements are stored with Robin Hood hashing, so insertions and erasures can move other elements
+     * (invalidating iterators and references to them).
+     *
      * @tparam Key Element type.
      * @tparam MaxSize Maximum number of elements that can be stored.
      * @tparam KeyHash Functor used to calculate the hash of a given key.
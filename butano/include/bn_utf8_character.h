@@ -68,52 +68,38 @@ public:
     constexpr explicit utf8_character(const char& text_ref)
     {
         const char* src = &text_ref;
-        auto ch8 = unsigned(*src);
+        auto ch8 = unsigned(uint8_t(*src));
 
         if(ch8 < 0x80)
         {
             // 7bit
             _data = int(ch8);
+            _size = 1;
+            return;
         }
-        else if(0xC0 <= ch8 && ch8 < 0xE0)
-        {
-            // 11bit
-            _data = (*src++ & 0x1F) << 6;
-            BN_ASSERT((*src >> 6) == 2, "Invalid UTF-8 character");
-
-            _data |= (*src++ & 0x3F) << 0;
-        }
-        else if(0xE0 <= ch8 && ch8 < 0xF0)
-        {
-            // 16bit
-            _data  = (*src++ & 0x0F) << 12;
-            BN_ASSERT((*src >> 6) == 2, "Invalid UTF-8 character");
 
-            _data |= (*src++ & 0x3F) <<  6;
-            BN_ASSERT((*src >> 6) == 2, "Invalid UTF-8 character");
+        // Size and leading byte mask are indexed by the five most significant bits of the leading byte:
+        constexpr uint8_t sizes[32] = {
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3, 3, 4, 0
+        };
 
-            _data |= (*src++ & 0x3F) <<  0;
-        }
-        else if(0xF0 <= ch8 && ch8 < 0xF8)
-        {
-            // 21bit
-            _data  = (*src++ & 0x0F) << 18;
-            BN_ASSERT((*src >> 6) == 2, "Invalid UTF-8 character");
+        constexpr uint8_t masks[5] = { 0, 0x7F, 0x1F, 0x0F, 0x07 };
 
-            _data |= (*src++ & 0x3F) << 12;
-            BN_ASSERT((*src >> 6) == 2, "Invalid UTF-8 character");
+        int size = sizes[ch8 >> 3];
+        BN_ASSERT(size, "Invalid UTF-8 character");
 
-            _data |= (*src++ & 0x3F) <<  6;
-            BN_ASSERT((*src >> 6) == 2, "Invalid UTF-8 character");
+        int data = int(ch8 & masks[size]);
 
-            _data |= (*src++ & 0x3F) <<  0;
-        }
-        else
+        for(int index = 1; index < size; ++index)
         {
-            BN_ERROR("Invalid UTF-8 character");
+            auto continuation = unsigned(uint8_t(src[index]));
+            BN_ASSERT((continuation >> 6) == 2, "Invalid UTF-8 character");
+
+            data = (data << 6) | int(continuation & 0x3F);
         }
 
-        _size = src - &text_ref;
+        _data = data;
+        _size = size;
     }
 
     /**
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VBLANK_STATS_H
+#define BN_VBLANK_STATS_H
+
+/**
+ * @file
+ * bn::vblank_stats header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+namespace bn
+{
+
+/**
+ * @brief Elapsed time and transferred bytes of each step committed to the GBA in a V-Blank.
+ *
+ * All ticks are timer ticks elapsed since the start of the V-Blank.
+ *
+ * @ingroup core
+ */
+class vblank_stats
+{
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    constexpr vblank_stats() = default;
+
+    /**
+     * @brief Constructor.
+     * @param vblank_handler_ticks Ticks spent committing display, sprites, backgrounds, palettes and HDMA
+     * in the V-Blank interrupt handler.
+     * @param hblank_effects_ticks Ticks spent committing H-Blank effects.
+     * @param sprite_tiles_ticks Ticks spent committing sprite tiles.
+     * @param sprite_tiles_bytes Number of bytes of sprite tiles committed to VRAM (uncompressed size).
+     * @param big_maps_ticks Ticks spent committing big background maps.
+     * @param bg_blocks_ticks Ticks spent committing background tiles and maps.
+     * @param bg_blocks_bytes Number of bytes of background tiles and maps committed to VRAM
+     * (uncompressed size).
+     * @param vram_queue_ticks Ticks spent committing bn::vram_queue writes.
+     * @param vram_queue_bytes Number of bytes of bn::vram_queue writes committed.
+     * @param audio_ticks Ticks spent committing audio.
+     * @param gpio_keypad_ticks Ticks spent committing GPIO and updating keypad.
+     */
+    constexpr vblank_stats(int vblank_handler_ticks, int hblank_effects_ticks, int sprite_tiles_ticks,
+                           int sprite_tiles_bytes, int big_maps_ticks, int bg_blocks_ticks, int bg_blocks_bytes,
+                           int vram_queue_ticks, int vram_queue_bytes, int audio_ticks, int gpio_keypad_ticks) :
+        _vblank_handler_ticks(vblank_handler_ticks),
+        _hblank_effects_ticks(hblank_effects_ticks),
+        _sprite_tiles_ticks(sprite_tiles_ticks),
+        _sprite_tiles_bytes(sprite_tiles_bytes),
+        _big_maps_ticks(big_maps_ticks),
+        _bg_blocks_ticks(bg_blocks_ticks),
+        _bg_blocks_bytes(bg_blocks_bytes),
+        _vram_queue_ticks(vram_queue_ticks),
+        _vram_queue_bytes(vram_queue_bytes),
+        _audio_ticks(audio_ticks),
+        _gpio_keypad_ticks(gpio_keypad_ticks)
+    {
+    }
+
+    /**
+     * @brief Returns the ticks spent committing display, sprites, backgrounds, palettes and HDMA
+     * in the V-Blank interrupt handler.
+     */
+    [[nodiscard]] constexpr int vblank_handler_ticks() const
+    {
+        return _vblank_handler_ticks;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing H-Blank effects.
+     */
+    [[nodiscard]] constexpr int hblank_effects_ticks() const
+    {
+        return _hblank_effects_ticks;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing sprite tiles.
+     */
+    [[nodiscard]] constexpr int sprite_tiles_ticks() const
+    {
+        return _sprite_tiles_ticks;
+    }
+
+    /**
+     * @brief Returns the number of bytes of sprite tiles committed to VRAM (uncompressed size).
+     */
+    [[nodiscard]] constexpr int sprite_tiles_bytes() const
+    {
+        return _sprite_tiles_bytes;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing big background maps.
+     */
+    [[nodiscard]] constexpr int big_maps_ticks() const
+    {
+        return _big_maps_ticks;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing background tiles and maps.
+     */
+    [[nodiscard]] constexpr int bg_blocks_ticks() const
+    {
+        return _bg_blocks_ticks;
+    }
+
+    /**
+     * @brief Returns the number of bytes of background tiles and maps committed to VRAM (uncompressed size).
+     */
+    [[nodiscard]] constexpr int bg_blocks_bytes() const
+    {
+        return _bg_blocks_bytes;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing bn::vram_queue writes.
+     */
+    [[nodiscard]] constexpr int vram_queue_ticks() const
+    {
+        return _vram_queue_ticks;
+    }
+
+    /**
+     * @brief Returns the number of bytes of bn::vram_queue writes committed.
+     */
+    [[nodiscard]] constexpr int vram_queue_bytes() const
+    {
+        return _vram_queue_bytes;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing audio.
+     */
+    [[nodiscard]] constexpr int audio_ticks() const
+    {
+        return _audio_ticks;
+    }
+
+    /**
+     * @brief Returns the ticks spent committing GPIO and updating keypad.
+     */
+    [[nodiscard]] constexpr int gpio_keypad_ticks() const
+    {
+        return _gpio_keypad_ticks;
+    }
+
+    /**
+     * @brief Returns the ticks spent in all commit steps.
+     *
+     * If it is greater than timers::ticks_per_vblank(), V-Blank has been overrun.
+     */
+    [[nodiscard]] constexpr int total_ticks() const
+    {
+        return _vblank_handler_ticks + _hblank_effects_ticks + _sprite_tiles_ticks + _big_maps_ticks +
+                _bg_blocks_ticks + _vram_queue_ticks + _audio_ticks + _gpio_keypad_ticks;
+    }
+
+    /**
+     * @brief Returns the number of bytes committed to VRAM (uncompressed size).
+     */
+    [[nodiscard]] constexpr int total_bytes() const
+    {
+        return _sprite_tiles_bytes + _bg_blocks_bytes + _vram_queue_bytes;
+    }
+
+private:
+    int _vblank_handler_ticks = 0;
+    int _hblank_effects_ticks = 0;
+    int _sprite_tiles_ticks = 0;
+    int _sprite_tiles_bytes = 0;
+    int _big_maps_ticks = 0;
+    int _bg_blocks_ticks = 0;
+    int _bg_blocks_bytes = 0;
+    int _vram_queue_ticks = 0;
+    int _vram_queue_bytes = 0;
+    int _audio_ticks = 0;
+    int _gpio_keypad_ticks = 0;
+};
+
+}
+
+#endif
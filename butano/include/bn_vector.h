@@ -235,7 +235,7 @@ public:
      */
     [[nodiscard]] const_reference operator[](size_type index) const
     {
-        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+        BN_BASIC_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
 
         return _data[index];
     }
@@ -245,7 +245,7 @@ public:
      */
     [[nodiscard]] reference operator[](size_type index)
     {
-        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+        BN_BASIC_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
 
         return _data[index];
     }
@@ -255,7 +255,7 @@ public:
      */
     [[nodiscard]] const_reference at(size_type index) const
     {
-        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+        BN_BASIC_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
 
         return _data[index];
     }
@@ -265,7 +265,7 @@ public:
      */
     [[nodiscard]] reference at(size_type index)
     {
-        BN_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
+        BN_BASIC_ASSERT(index >= 0 && index < _size, "Invalid index: ", index, " - ", _size);
 
         return _data[index];
     }
@@ -316,7 +316,7 @@ public:
      */
     void push_back(const_reference value)
     {
-        BN_ASSERT(! full(), "Vector is full");
+        BN_BASIC_ASSERT(! full(), "Vector is full");
 
         ::new(_data + _size) value_type(value);
         ++_size;
@@ -328,7 +328,7 @@ public:
      */
     void push_back(value_type&& value)
     {
-        BN_ASSERT(! full(), "Vector is full");
+        BN_BASIC_ASSERT(! full(), "Vector is full");
 
         ::new(_data + _size) value_type(move(value));
         ++_size;
@@ -342,7 +342,7 @@ public:
     template<typename... Args>
     reference emplace_back(Args&&... args)
     {
-        BN_ASSERT(! full(), "Vector is full");
+        BN_BASIC_ASSERT(! full(), "Vector is full");
 
         Type* result = _data + _size;
         ::new(result) value_type(forward<Args>(args)...);
@@ -370,18 +370,13 @@ public:
     iterator insert(const_iterator position, const_reference value)
     {
         BN_ASSERT(position >= begin() && position <= end(), "Invalid position");
-        BN_ASSERT(! full(), "Vector is full");
+        BN_BASIC_ASSERT(! full(), "Vector is full");
 
         auto non_const_position = const_cast<iterator>(position);
         iterator last = end();
         ::new(_data + _size) value_type(value);
         ++_size;
-
-        for(iterator it = non_const_position; it != last; ++it)
-        {
-            bn::swap(*it, *last);
-        }
-
+        _move_last(non_const_position, last);
         return non_const_position;
     }
 
@@ -394,18 +389,13 @@ public:
     iterator insert(const_iterator position, value_type&& value)
     {
         BN_ASSERT(position >= begin() && position <= end(), "Invalid position");
-        BN_ASSERT(! full(), "Vector is full");
+        BN_BASIC_ASSERT(! full(), "Vector is full");
 
         auto non_const_position = const_cast<iterator>(position);
         iterator last = end();
         ::new(_data + _size) value_type(move(value));
         ++_size;
-
-        for(iterator it = non_const_position; it != last; ++it)
-        {
-            bn::swap(*it, *last);
-        }
-
+        _move_last(non_const_position, last);
         return non_const_position;
     }
 
@@ -419,18 +409,13 @@ public:
     iterator emplace(const_iterator position, Args&&... args)
     {
         BN_ASSERT(position >= begin() && position <= end(), "Invalid position");
-        BN_ASSERT(! full(), "Vector is full");
+        BN_BASIC_ASSERT(! full(), "Vector is full");
 
         auto non_const_position = const_cast<iterator>(position);
         iterator last = end();
         ::new(_data + _size) value_type(forward<Args>(args)...);
         ++_size;
-
-        for(iterator it = non_const_position; it != last; ++it)
-        {
-            bn::swap(*it, *last);
-        }
-
+        _move_last(non_const_position, last);
         return non_const_position;
     }
 
@@ -450,14 +435,23 @@ public:
 
         iterator last = end();
 
-        while(it != last)
+        if constexpr(is_trivially_relocatable_v<Type>)
         {
-            iterator next = it + 1;
-            *it = move(*next);
-            it = next;
+            it->~value_type();
+            _relocate(it + 1, last - it, it);
+        }
+        else
+        {
+            while(it != last)
+            {
+                iterator next = it + 1;
+                *it = move(*next);
+                it = next;
+            }
+
+            _data[_size].~value_type();
         }
 
-        _data[_size].~value_type();
         return non_const_position;
     }
 
@@ -492,17 +486,29 @@ public:
                 iterator erase_last = end();
                 _size -= delete_count;
 
-                while(erase_next != erase_last)
+                if constexpr(is_trivially_relocatable_v<Type>)
                 {
-                    *erase_it = move(*erase_next);
-                    ++erase_it;
-                    ++erase_next;
-                }
+                    for(iterator it = erase_it; it != erase_next; ++it)
+                    {
+                        it->~value_type();
+                    }
 
-                while(erase_it != erase_last)
+                    _relocate(erase_next, erase_last - erase_next, erase_it);
+                }
+                else
                 {
-                    erase_it->~value_type();
-                    ++erase_it;
+                    while(erase_next != erase_last)
+                    {
+                        *erase_it = move(*erase_next);
+                        ++erase_it;
+                        ++erase_next;
+                    }
+
+                    while(erase_it != erase_last)
+                    {
+                        erase_it->~value_type();
+                        ++erase_it;
+                    }
                 }
             }
         }
@@ -883,6 +889,31 @@ private:
     pointer _data;
     size_type _size;
     size_type _max_size;
+
+    static void _relocate(const_pointer source, size_type count, pointer destination)
+    {
+        __builtin_memmove(static_cast<void*>(destination), static_cast<const void*>(source),
+                          unsigned(count) * sizeof(value_type));
+    }
+
+    static void _move_last(iterator position, iterator last)
+    {
+        if constexpr(is_trivially_relocatable_v<Type>)
+        {
+            // The last element bytes are saved, the previous ones are shifted with one memmove call:
+            alignas(value_type) char last_storage[sizeof(value_type)];
+            __builtin_memcpy(last_storage, static_cast<const void*>(last), sizeof(value_type));
+            _relocate(position, last - position, position + 1);
+            __builtin_memcpy(static_cast<void*>(position), last_storage, sizeof(value_type));
+        }
+        else
+        {
+            for(iterator it = position; it != last; ++it)
+            {
+                bn::swap(*it, *last);
+            }
+        }
+    }
 };
 
 
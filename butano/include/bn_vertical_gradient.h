@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VERTICAL_GRADIENT_H
+#define BN_VERTICAL_GRADIENT_H
+
+/**
+ * @file
+ * bn::vertical_gradient_keyframe, bn::vertical_gradient and vertical gradient generation functions header file.
+ *
+ * @ingroup hblank_effect
+ */
+
+#include "bn_span.h"
+#include "bn_array.h"
+#include "bn_color.h"
+#include "bn_vector.h"
+#include "bn_display.h"
+#include "bn_blending_fade_alpha.h"
+
+/// @cond DO_NOT_DOCUMENT
+
+namespace _bn::vertical_gradient
+{
+    class channel
+    {
+
+    public:
+        constexpr channel(int first_value, int last_value, int lines) :
+            _value((first_value << 16) + 0x8000),
+            _delta(((last_value - first_value) << 16) / lines)
+        {
+        }
+
+        [[nodiscard]] constexpr int next()
+        {
+            int result = _value >> 16;
+            _value += _delta;
+            return result;
+        }
+
+    private:
+        int _value;
+        int _delta;
+    };
+
+    constexpr void fill_segment(bn::blending_fade_alpha first_value, bn::blending_fade_alpha last_value, int lines,
+                                bn::blending_fade_alpha* output)
+    {
+        channel alpha_channel(first_value.value().data(), last_value.value().data(), lines);
+
+        for(int index = 0; index < lines; ++index)
+        {
+            output[index] = bn::blending_fade_alpha(bn::fixed::from_data(alpha_channel.next()));
+        }
+    }
+
+    constexpr void fill_segment(bn::color first_value, bn::color last_value, int lines, bn::color* output)
+    {
+        channel red_channel(first_value.red(), last_value.red(), lines);
+        channel green_channel(first_value.green(), last_value.green(), lines);
+        channel blue_channel(first_value.blue(), last_value.blue(), lines);
+
+        for(int index = 0; index < lines; ++index)
+        {
+            output[index] = bn::color(red_channel.next(), green_channel.next(), blue_channel.next());
+        }
+    }
+}
+
+/// @endcond
+
+namespace bn
+{
+
+/**
+ * @brief Value of a vertical gradient in a screen horizontal line.
+ *
+ * @tparam Value Gradient value type (bn::blending_fade_alpha or bn::color).
+ *
+ * @ingroup hblank_effect
+ */
+template<typename Value>
+class vertical_gradient_keyframe
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param line Screen horizontal line of the keyframe, in the range [0, display::height() - 1].
+     * @param value Gradient value in the given screen horizontal line.
+     */
+    constexpr vertical_gradient_keyframe(int line, const Value& value) :
+        _value(value),
+        _line(int16_t(line))
+    {
+        BN_ASSERT(line >= 0 && line < display::height(), "Invalid line: ", line);
+    }
+
+    /**
+     * @brief Returns the screen horizontal line of the keyframe.
+     */
+    [[nodiscard]] constexpr int line() const
+    {
+        return _line;
+    }
+
+    /**
+     * @brief Returns the gradient value in the screen horizontal line of the keyframe.
+     */
+    [[nodiscard]] constexpr const Value& value() const
+    {
+        return _value;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const vertical_gradient_keyframe& a,
+                                                   const vertical_gradient_keyframe& b) = default;
+
+private:
+    Value _value;
+    int16_t _line;
+};
+
+
+/**
+ * @brief Fills a table with a value per screen horizontal line interpolating linearly the given keyframes,
+ * so it can be used by an H-Blank effect (a bn::blending_fade_alpha_hbe_ptr for depth fog
+ * or a bn::bg_palette_color_hbe_ptr for a sky gradient, for example).
+ *
+ * Lines before the first keyframe and after the last one get the value of the nearest keyframe.
+ *
+ * @tparam Value Gradient value type (bn::blending_fade_alpha or bn::color).
+ * @param keyframes Gradient keyframes, sorted by line. It can't be empty.
+ * @param output Destination table. Its size must be equal to display::height().
+ *
+ * @ingroup hblank_effect
+ */
+template<typename Value>
+constexpr void fill_vertical_gradient(const span<const vertical_gradient_keyframe<Value>>& keyframes,
+                                      span<Value> output)
+{
+    int keyframes_count = keyframes.size();
+    BN_ASSERT(keyframes_count, "There's no keyframes");
+    BN_ASSERT(output.size() == display::height(), "Invalid output size: ", output.size());
+
+    Value* output_data = output.data();
+    const vertical_gradient_keyframe<Value>* previous_keyframe = &keyframes[0];
+    int line = 0;
+
+    for(; line < previous_keyframe->line(); ++line)
+    {
+        output_data[line] = previous_keyframe->value();
+    }
+
+    for(int index = 1; index < keyframes_count; ++index)
+    {
+        const vertical_gradient_keyframe<Value>* keyframe = &keyframes[index];
+        int lines = keyframe->line() - line;
+        BN_ASSERT(lines >= 0, "Keyframes are not sorted: ", index);
+
+        if(lines)
+        {
+            _bn::vertical_gradient::fill_segment(previous_keyframe->value(), keyframe->value(), lines,
+                                                 output_data + line);
+            line += lines;
+        }
+
+        previous_keyframe = keyframe;
+    }
+
+    for(; line < display::height(); ++line)
+    {
+        output_data[line] = previous_keyframe->value();
+    }
+}
+
+/**
+ * @brief Generates a table with a value per screen horizontal line interpolating linearly the given keyframes.
+ *
+ * It can be evaluated at compile time, so static gradients can be stored in ROM.
+ *
+ * Lines before the first keyframe and after the last one get the value of the nearest keyframe.
+ *
+ * @tparam Value Gradient value type (bn::blending_fade_alpha or bn::color).
+ * @param keyframes Gradient keyframes, sorted by line. It can't be empty.
+ * @return Table with a gradient value per screen horizontal line.
+ *
+ * @ingroup hblank_effect
+ */
+template<typename Value>
+[[nodiscard]] constexpr array<Value, display::height()> make_vertical_gradient(
+        const span<const vertical_gradient_keyframe<Value>>& keyframes)
+{
+    array<Value, display::height()> result;
+    fill_vertical_gradient(keyframes, span<Value>(result));
+    return result;
+}
+
+
+/**
+ * @brief Caches a table with a value per screen horizontal line generated from gradient keyframes,
+ * regenerating it only when the keyframes change.
+ *
+ * @tparam Value Gradient value type (bn::blending_fade_alpha or bn::color).
+ * @tparam MaxKeyframes Maximum number of keyframes.
+ *
+ * @ingroup hblank_effect
+ */
+template<typename Value, int MaxKeyframes>
+class vertical_gradient
+{
+    static_assert(MaxKeyframes > 0 && MaxKeyframes <= display::height());
+
+public:
+    using keyframe_type = vertical_gradient_keyframe<Value>; //!< Keyframe type alias.
+
+    /**
+     * @brief Constructor.
+     * @param keyframes Gradient keyframes, sorted by line. It can't be empty.
+     */
+    explicit vertical_gradient(const span<const keyframe_type>& keyframes)
+    {
+        set_keyframes(keyframes);
+        update();
+    }
+
+    /**
+     * @brief Returns the gradient keyframes.
+     */
+    [[nodiscard]] const ivector<keyframe_type>& keyframes() const
+    {
+        return _keyframes;
+    }
+
+    /**
+     * @brief Sets the gradient keyframes.
+     * @param keyframes Gradient keyframes, sorted by line. It can't be empty.
+     *
+     * The table is not regenerated until update is called.
+     */
+    void set_keyframes(const span<const keyframe_type>& keyframes)
+    {
+        BN_ASSERT(! keyframes.empty(), "There's no keyframes");
+        BN_ASSERT(keyframes.size() <= MaxKeyframes, "Too many keyframes: ", keyframes.size(), " - ", MaxKeyframes);
+
+        if(! equal(keyframes.begin(), keyframes.end(), _keyframes.begin(), _keyframes.end()))
+        {
+            _keyframes.clear();
+
+            for(const keyframe_type& keyframe : keyframes)
+            {
+                _keyframes.push_back(keyframe);
+            }
+
+            _update = true;
+        }
+    }
+
+    /**
+     * @brief Returns the table with a gradient value per screen horizontal line.
+     *
+     * It can be used to create an H-Blank effect, but it must be reloaded after update returns `true`.
+     */
+    [[nodiscard]] span<const Value> values_ref() const
+    {
+        return _values;
+    }
+
+    /**
+     * @brief Regenerates the table if the keyframes have changed since the last call.
+     * @return `true` if the table has been regenerated, otherwise `false`.
+     */
+    bool update()
+    {
+        if(! _update)
+        {
+            return false;
+        }
+
+        fill_vertical_gradient(span<const keyframe_type>(_keyframes.data(), _keyframes.size()), span<Value>(_values));
+        _update = false;
+        return true;
+    }
+
+private:
+    vector<keyframe_type, MaxKeyframes> _keyframes;
+    alignas(int) Value _values[display::height()];
+    bool _update = true;
+};
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VIDEO_ITEM_H
+#define BN_VIDEO_ITEM_H
+
+/**
+ * @file
+ * bn::video_item header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup tool
+ */
+
+#include "bn_assert.h"
+#include "bn_alignment.h"
+#include "bn_bg_palette_item.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to play a video with bn::video_player.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `video` type.
+ *
+ * Videos are shown with a 32x32 cells regular background, whose tiles are a dictionary updated by each frame.
+ *
+ * Frames are stored one after another as 32-bit words:
+ * * Header word: number of changed tiles in the high half word and number of map cells runs in the low half word.
+ * * Changed tiles: index of the tile in the dictionary followed by its words (8 per 4BPP tile, 16 per 8BPP tile).
+ * * Map cells runs: a word with the index of the first cell in the high half word and the number of cells
+ * in the low half word, followed by the cells (two per word, the first one in the low half word).
+ *
+ * Map cells are double buffered, so the map cells runs of each frame are relative to the frame before
+ * the previous one (and to map cells set to zero for the first two frames).
+ *
+ * Tiles used by the previous frame are never changed, so the dictionary can be updated out of VBlank.
+ * The first tile of the dictionary is always empty.
+ *
+ * The frames data is not copied but referenced, so it should outlive the video_item
+ * to avoid dangling references.
+ *
+ * @ingroup regular_bg
+ * @ingroup tool
+ */
+class video_item
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param frames_ref Reference to the frames data.
+     *
+     * The frames data is not copied but referenced, so it should outlive the video_item
+     * to avoid dangling references.
+     *
+     * @param palette_item Color palette of the video.
+     * @param tiles_count Number of tiles of the dictionary.
+     * @param frames_count Number of frames.
+     * @param frame_duration Number of game frames each video frame is shown.
+     */
+    constexpr video_item(const uint32_t& frames_ref, const bg_palette_item& palette_item, int tiles_count,
+                         int frames_count, int frame_duration) :
+        _frames_ptr(&frames_ref),
+        _palette_item(palette_item),
+        _tiles_count(int16_t(tiles_count)),
+        _frames_count(int16_t(frames_count)),
+        _frame_duration(int16_t(frame_duration))
+    {
+        BN_ASSERT(aligned<alignof(int)>(&frames_ref), "Frames data is not aligned");
+        BN_ASSERT(tiles_count > 0 && tiles_count <= (palette_item.bpp() == bpp_mode::BPP_8 ? 512 : 1024),
+                  "Invalid tiles count: ", tiles_count);
+        BN_ASSERT(frames_count > 0 && frames_count <= 32767, "Invalid frames count: ", frames_count);
+        BN_ASSERT(frame_duration > 0 && frame_duration <= 32767, "Invalid frame duration: ", frame_duration);
+    }
+
+    /**
+     * @brief Returns the referenced frames data.
+     */
+    [[nodiscard]] constexpr const uint32_t& frames_ref() const
+    {
+        return *_frames_ptr;
+    }
+
+    /**
+     * @brief Returns the color palette of the video.
+     */
+    [[nodiscard]] constexpr const bg_palette_item& palette_item() const
+    {
+        return _palette_item;
+    }
+
+    /**
+     * @brief Returns the number of tiles of the dictionary.
+     */
+    [[nodiscard]] constexpr int tiles_count() const
+    {
+        return _tiles_count;
+    }
+
+    /**
+     * @brief Returns the number of frames.
+     */
+    [[nodiscard]] constexpr int frames_count() const
+    {
+        return _frames_count;
+    }
+
+    /**
+     * @brief Returns the number of game frames each video frame is shown.
+     */
+    [[nodiscard]] constexpr int frame_duration() const
+    {
+        return _frame_duration;
+    }
+
+private:
+    const uint32_t* _frames_ptr;
+    bg_palette_item _palette_item;
+    int16_t _tiles_count;
+    int16_t _frames_count;
+    int16_t _frame_duration;
+};
+
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VIDEO_PLAYER_H
+#define BN_VIDEO_PLAYER_H
+
+/**
+ * @file
+ * bn::video_player header file.
+ *
+ * @ingroup regular_bg
+ */
+
+#include "bn_video_item.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+
+namespace bn
+{
+
+/**
+ * @brief Plays a video_item with a regular background.
+ *
+ * Each frame is decoded in one or more updates, without reading more than the given number of bytes per update
+ * (at least one changed tile or map cells run is decoded per update).
+ *
+ * The map cells of each frame are written in a map not visible on the screen, which is shown when the frame
+ * has been decoded and its time has been reached. At most one frame is shown per update.
+ *
+ * Frames are never skipped: if a frame can't be decoded in time, the video is delayed.
+ *
+ * @ingroup regular_bg
+ */
+class video_player
+{
+
+public:
+    /**
+     * @brief Constructor.
+     * @param item video_item to play.
+     * @param max_bytes_per_update Maximum number of bytes of frames data read per update (> 0).
+     */
+    explicit video_player(const video_item& item, int max_bytes_per_update = 4096);
+
+    /**
+     * @brief Returns the played video_item.
+     */
+    [[nodiscard]] const video_item& item() const
+    {
+        return _item;
+    }
+
+    /**
+     * @brief Returns the regular background used to show the video.
+     */
+    [[nodiscard]] const regular_bg_ptr& bg() const
+    {
+        return _bg;
+    }
+
+    /**
+     * @brief Returns the regular background used to show the video.
+     */
+    [[nodiscard]] regular_bg_ptr& bg()
+    {
+        return _bg;
+    }
+
+    /**
+     * @brief Returns the maximum number of bytes of frames data read per update.
+     */
+    [[nodiscard]] int max_bytes_per_update() const
+    {
+        return _max_bytes_per_update;
+    }
+
+    /**
+     * @brief Sets the maximum number of bytes of frames data read per update.
+     * @param max_bytes_per_update Maximum number of bytes of frames data read per update (> 0).
+     */
+    void set_max_bytes_per_update(int max_bytes_per_update);
+
+    /**
+     * @brief Returns the number of game frames elapsed since the video started.
+     */
+    [[nodiscard]] int elapsed_frames() const
+    {
+        return _elapsed_frames;
+    }
+
+    /**
+     * @brief Sets the number of game frames elapsed since the video started.
+     *
+     * It allows to synchronize the video with another clock, like the music or a timer.
+     *
+     * @param elapsed_frames Number of game frames elapsed since the video started (>= 0).
+     */
+    void set_elapsed_frames(int elapsed_frames);
+
+    /**
+     * @brief Returns the index of the frame shown on the screen, or -1 if no frame has been shown yet.
+     */
+    [[nodiscard]] int current_frame() const
+    {
+        return _shown_frames - 1;
+    }
+
+    /**
+     * @brief Indicates if the last frame has been shown.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _shown_frames == _item.frames_count();
+    }
+
+    /**
+     * @brief Decodes the next frame and shows it when its time has been reached.
+     *
+     * It must be called once per game frame.
+     */
+    void update();
+
+private:
+    video_item _item;
+    regular_bg_tiles_ptr _tiles;
+    regular_bg_map_ptr _maps[2];
+    regular_bg_ptr _bg;
+    const uint32_t* _data_ptr;
+    int _max_bytes_per_update;
+    int _elapsed_frames = 0;
+    int _shown_frames = 0;
+    int _pending_tiles = 0;
+    int _pending_runs = -1;
+
+    [[nodiscard]] bool _decode();
+};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VRAM_QUEUE_H
+#define BN_VRAM_QUEUE_H
+
+/**
+ * @file
+ * bn::vram_queue header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_assert.h"
+#include "bn_type_traits.h"
+
+/**
+ * @brief Functions to queue writes to VRAM, palette RAM and OAM which are committed in the next V-Blank.
+ *
+ * Queued writes are committed by bn::core::update right after sprite tiles and background tiles and maps,
+ * sharing their per-frame byte budget (see @ref BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES),
+ * so they don't tear nor collide with the engine's own commits.
+ *
+ * Palette RAM and OAM entries managed by Butano are overwritten each time they are updated,
+ * so only unused palettes and reserved sprite handles (see bn::sprites::set_reserved_handles_count)
+ * should be written.
+ *
+ * @ingroup memory
+ */
+namespace bn::vram_queue
+{
+    /**
+     * @brief Returns the number of writes that can be queued at the same time.
+     */
+    [[nodiscard]] int max_items();
+
+    /**
+     * @brief Returns the number of queued writes which have not been committed yet.
+     */
+    [[nodiscard]] int used_items_count();
+
+    /**
+     * @brief Returns the number of writes that still can be queued.
+     */
+    [[nodiscard]] int available_items_count();
+
+    /**
+     * @brief Indicates if no more writes can be queued.
+     */
+    [[nodiscard]] bool full();
+
+    /**
+     * @brief Queues a write of the given amount of bytes,
+     * which is committed in the next V-Blank if it fits in the per-frame byte budget.
+     *
+     * The bytes are not copied but referenced, so they should be alive and they should not be modified
+     * until the write is committed.
+     *
+     * @param source_ptr Pointer to the memory location to copy from. It must be aligned to a 2 bytes boundary.
+     * @param bytes Number of bytes to copy (it must be even, since VRAM doesn't allow byte writes).
+     * @param destination_ptr Pointer to the VRAM, palette RAM or OAM location to copy to.
+     * It must be aligned to a 2 bytes boundary.
+     * @param priority Writes with lower priority values are committed first,
+     * and writes with the same priority are committed in the same order they were queued.
+     * It must be in the range [0..3].
+     */
+    void push(const void* source_ptr, int bytes, void* destination_ptr, int priority = 0);
+
+    /**
+     * @brief Queues a write of the given amount of elements,
+     * which is committed in the next V-Blank if it fits in the per-frame byte budget.
+     *
+     * The elements are not copied but referenced, so they should be alive and they should not be modified
+     * until the write is committed.
+     *
+     * @param source_ref Const reference to the memory location to copy from.
+     * @param elements Number of elements to copy (not bytes).
+     * @param destination_ref Reference to the VRAM, palette RAM or OAM location to copy to.
+     * @param priority Writes with lower priority values are committed first,
+     * and writes with the same priority are committed in the same order they were queued.
+     * It must be in the range [0..3].
+     */
+    template<typename Type>
+    void push(const Type& source_ref, int elements, Type& destination_ref, int priority = 0)
+    {
+        static_assert(is_trivially_copyable<Type>(), "Type is not trivially copyable");
+        static_assert(sizeof(Type) % 2 == 0 && alignof(Type) >= 2, "Type is not half word aligned");
+        BN_ASSERT(elements >= 0, "Invalid elements: ", elements);
+
+        push(&source_ref, elements * int(sizeof(Type)), &destination_ref, priority);
+    }
+
+    /**
+     * @brief Removes all queued writes which have not been committed yet.
+     */
+    void clear();
+}
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_WINDOW_SHAPE_H
+#define BN_WINDOW_SHAPE_H
+
+/**
+ * @file
+ * bn::window_shape header file.
+ *
+ * @ingroup rect_window
+ * @ingroup hblank_effect
+ */
+
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_display.h"
+#include "bn_utility.h"
+#include "bn_fixed_point.h"
+
+namespace bn
+{
+
+/**
+ * @brief Rasterizes circles, ellipses and convex polygons into the horizontal boundaries of a rect window
+ * in each screen horizontal line, ready to be referenced by a rect_window_boundaries_hbe_ptr.
+ *
+ * The boundaries are absolute screen columns, so the horizontal boundaries of the rect window must be
+ * at the left side of the screen (-display::width() / 2) for the shape to be shown as it is.
+ *
+ * Shapes are rasterized only when their parameters change, so they can be set every frame with little cost:
+ *
+ * @code{.cpp}
+ * if(shape.set_circle(center, radius))
+ * {
+ *     boundaries_hbe.reload_deltas_ref();
+ * }
+ * @endcode
+ *
+ * @ingroup rect_window
+ * @ingroup hblank_effect
+ */
+class window_shape
+{
+
+public:
+    /**
+     * @brief Returns the maximum number of vertices of a polygon shape.
+     */
+    [[nodiscard]] constexpr static int max_polygon_vertices()
+    {
+        return 16;
+    }
+
+    /**
+     * @brief Default constructor.
+     *
+     * It creates an empty shape (the rect window is hidden in all screen lines).
+     */
+    window_shape()
+    {
+        _clear();
+    }
+
+    /**
+     * @brief Returns a reference to the horizontal boundaries of the shape in each screen horizontal line.
+     *
+     * Lines which don't intersect the shape have both boundaries set to zero.
+     */
+    [[nodiscard]] span<const pair<fixed, fixed>> boundaries_ref() const
+    {
+        return span<const pair<fixed, fixed>>(_boundaries);
+    }
+
+    /**
+     * @brief Indicates if no screen line intersects the shape.
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return _empty;
+    }
+
+    /**
+     * @brief Removes the shape, hiding the rect window in all screen lines.
+     * @return `true` if the boundaries have been modified; `false` otherwise.
+     */
+    bool clear();
+
+    /**
+     * @brief Rasterizes a filled circle.
+     * @param center Position of the center of the circle, relative to the center of the screen.
+     * @param radius Radius of the circle in pixels (it must be greater or equal than zero).
+     * @return `true` if the boundaries have been modified; `false` otherwise.
+     */
+    bool set_circle(const fixed_point& center, fixed radius)
+    {
+        return set_ellipse(center, radius, radius);
+    }
+
+    /**
+     * @brief Rasterizes a filled ellipse with axes parallel to the screen ones.
+     * @param center Position of the center of the ellipse, relative to the center of the screen.
+     * @param horizontal_radius Horizontal radius of the ellipse in pixels (it must be greater or equal than zero).
+     * @param vertical_radius Vertical radius of the ellipse in pixels (it must be greater or equal than zero).
+     * @return `true` if the boundaries have been modified; `false` otherwise.
+     */
+    bool set_ellipse(const fixed_point& center, fixed horizontal_radius, fixed vertical_radius);
+
+    /**
+     * @brief Rasterizes a filled convex polygon.
+     * @param vertices Polygon vertices (between three and max_polygon_vertices()),
+     * relative to the center of the screen.
+     *
+     * Vertices can be in clockwise or counterclockwise order.
+     *
+     * @return `true` if the boundaries have been modified; `false` otherwise.
+     */
+    bool set_polygon(const span<const fixed_point>& vertices);
+
+private:
+    enum class kind_type : uint8_t
+    {
+        NONE,
+        ELLIPSE,
+        POLYGON
+    };
+
+    pair<fixed, fixed> _boundaries[display::height()];
+    vector<fixed_point, 16> _vertices;
+    fixed_point _center;
+    fixed _horizontal_radius;
+    fixed _vertical_radius;
+    kind_type _kind;
+    bool _empty;
+
+    void _clear();
+
+    BN_CODE_IWRAM void _rasterize_ellipse();
+
+    BN_CODE_IWRAM void _rasterize_polygon();
+
+    BN_CODE_IWRAM void _add_edge(int x0, int y0, int x1, int y1);
+};
+
+}
+
+#endif
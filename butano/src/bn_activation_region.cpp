@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_activation_region.h"
+
+#include "bn_display.h"
+
+namespace bn
+{
+
+void iactivation_region::set_margin(const fixed_size& margin)
+{
+    BN_ASSERT(margin.width() >= 0 && margin.height() >= 0,
+              "Invalid margin: ", margin.width(), " - ", margin.height());
+
+    _margin = margin;
+}
+
+fixed_rect iactivation_region::region() const
+{
+    fixed_size dimensions(display::width() + (_margin.width() * 2), display::height() + (_margin.height() * 2));
+    return fixed_rect(_camera.position(), dimensions);
+}
+
+int iactivation_region::add_object(const fixed_rect& rect)
+{
+    return _add_object(rect, nullopt);
+}
+
+int iactivation_region::add_object(const fixed_rect& rect, const sprite_ptr& sprite)
+{
+    return _add_object(rect, sprite_handle(sprite));
+}
+
+void iactivation_region::remove_object(int id)
+{
+    object_type& object = _object(id);
+
+    if(! object.active)
+    {
+        _set_active(object, true);
+    }
+
+    object.sprite.reset();
+    object.used = false;
+    --_objects_count;
+
+    while(! _objects.empty() && ! _objects.back().used)
+    {
+        _objects.pop_back();
+    }
+}
+
+void iactivation_region::clear_objects()
+{
+    for(object_type& object : _objects)
+    {
+        if(object.used && ! object.active)
+        {
+            _set_active(object, true);
+        }
+    }
+
+    _objects.clear();
+    _objects_count = 0;
+}
+
+iactivation_region::iactivation_region(const camera_ptr& camera, const fixed_size& margin,
+                                       ivector<object_type>& objects) :
+    _camera(camera),
+    _objects(objects)
+{
+    set_margin(margin);
+}
+
+const iactivation_region::object_type& iactivation_region::_object(int id) const
+{
+    BN_ASSERT(id >= 0 && id < _objects.size() && _objects[id].used, "Invalid id: ", id);
+
+    return _objects[id];
+}
+
+iactivation_region::object_type& iactivation_region::_object(int id)
+{
+    BN_ASSERT(id >= 0 && id < _objects.size() && _objects[id].used, "Invalid id: ", id);
+
+    return _objects[id];
+}
+
+int iactivation_region::_add_object(const fixed_rect& rect, const optional<sprite_handle>& sprite)
+{
+    int result = 0;
+    int objects_size = _objects.size();
+
+    // Slots of removed objects are reused before growing the objects vector:
+    if(_objects_count < objects_size)
+    {
+        while(_objects[result].used)
+        {
+            ++result;
+        }
+    }
+    else
+    {
+        BN_ASSERT(! _objects.full(), "No more objects available");
+
+        result = objects_size;
+        _objects.push_back(object_type());
+    }
+
+    object_type& object = _objects[result];
+    object.rect = rect;
+    object.sprite = sprite;
+    object.used = true;
+    object.active = true;
+    ++_objects_count;
+
+    if(! region().intersects(rect))
+    {
+        _set_active(object, false);
+    }
+
+    return result;
+}
+
+void iactivation_region::_set_active(object_type& object, bool active)
+{
+    object.active = active;
+
+    if(sprite_handle* sprite = object.sprite.get())
+    {
+        sprite->set_visible(active);
+    }
+}
+
+}
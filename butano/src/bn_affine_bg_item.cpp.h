@@ -9,6 +9,7 @@
 #include "bn_optional.h"
 #include "bn_affine_bg_ptr.h"
 #include "bn_affine_bg_map_ptr.h"
+#include "bn_bg_blocks_manager.h"
 
 namespace bn
 {
@@ -69,4 +70,42 @@ optional<affine_bg_map_ptr> affine_bg_item::create_new_map_optional() const
     return affine_bg_map_ptr::create_new_optional(*this);
 }
 
+affine_bg_map_ptr affine_bg_item::prefetch(int max_bytes_per_frame) const
+{
+    bool batch_started = bg_blocks_manager::batch_started();
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::begin_batch();
+    }
+
+    affine_bg_map_ptr result = affine_bg_map_ptr::create(*this);
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::end_batch(max_bytes_per_frame);
+    }
+
+    return result;
+}
+
+optional<affine_bg_map_ptr> affine_bg_item::prefetch_optional(int max_bytes_per_frame) const
+{
+    bool batch_started = bg_blocks_manager::batch_started();
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::begin_batch();
+    }
+
+    optional<affine_bg_map_ptr> result = affine_bg_map_ptr::create_optional(*this);
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::end_batch(max_bytes_per_frame);
+    }
+
+    return result;
+}
+
 }
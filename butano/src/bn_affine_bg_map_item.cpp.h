@@ -45,6 +45,24 @@ affine_bg_map_item affine_bg_map_item::decompress(affine_bg_map_cell& decompress
         result._compression = compression_type::NONE;
         break;
 
+    case compression_type::LZ4:
+        hw::decompress::lz4(_cells_ptr, &decompressed_cells_ref);
+        result._cells_ptr = &decompressed_cells_ref;
+        result._compression = compression_type::NONE;
+        break;
+
+    case compression_type::HUFFMAN:
+        hw::decompress::huffman(_cells_ptr, &decompressed_cells_ref);
+        result._cells_ptr = &decompressed_cells_ref;
+        result._compression = compression_type::NONE;
+        break;
+
+    case compression_type::LZ77_HUFFMAN:
+        hw::decompress::lz77_huffman_wram(_cells_ptr, &decompressed_cells_ref);
+        result._cells_ptr = &decompressed_cells_ref;
+        result._compression = compression_type::NONE;
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(_compression));
         break;
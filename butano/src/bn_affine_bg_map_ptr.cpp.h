@@ -234,6 +234,47 @@ void affine_bg_map_ptr::reload_cells_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+void affine_bg_map_ptr::fill_rect(int first_column, int first_row, int columns_count, int rows_count,
+                                  affine_bg_map_cell cell)
+{
+    bg_blocks_manager::fill_affine_map_rect(_handle, first_column, first_row, columns_count, rows_count, cell);
+}
+
+void affine_bg_map_ptr::copy_rect(const affine_bg_map_item& source_map_item, int source_column, int source_row,
+                                  int columns_count, int rows_count, int destination_column, int destination_row)
+{
+    bg_blocks_manager::copy_affine_map_rect(_handle, source_map_item, source_column, source_row, columns_count,
+                                            rows_count, destination_column, destination_row, 0);
+}
+
+void affine_bg_map_ptr::copy_rect(const affine_bg_map_ptr& source_map, int source_column, int source_row,
+                                  int columns_count, int rows_count, int destination_column, int destination_row)
+{
+    blit_with_offset(source_map, source_column, source_row, columns_count, rows_count, destination_column,
+                     destination_row, 0);
+}
+
+void affine_bg_map_ptr::blit_with_offset(const affine_bg_map_item& source_map_item, int source_column,
+                                         int source_row, int columns_count, int rows_count, int destination_column,
+                                         int destination_row, int tiles_offset)
+{
+    bg_blocks_manager::copy_affine_map_rect(_handle, source_map_item, source_column, source_row, columns_count,
+                                            rows_count, destination_column, destination_row, tiles_offset);
+}
+
+void affine_bg_map_ptr::blit_with_offset(const affine_bg_map_ptr& source_map, int source_column, int source_row,
+                                         int columns_count, int rows_count, int destination_column,
+                                         int destination_row, int tiles_offset)
+{
+    optional<span<const affine_bg_map_cell>> source_cells_ref = source_map.cells_ref();
+    BN_ASSERT(source_cells_ref, "Source map has no referenced cells");
+
+    affine_bg_map_item source_map_item(*source_cells_ref->data(), source_map.dimensions(),
+                                       source_map.compression());
+    bg_blocks_manager::copy_affine_map_rect(_handle, source_map_item, source_column, source_row, columns_count,
+                                            rows_count, destination_column, destination_row, tiles_offset);
+}
+
 const affine_bg_tiles_ptr& affine_bg_map_ptr::tiles() const
 {
     return bg_blocks_manager::affine_map_tiles(_handle);
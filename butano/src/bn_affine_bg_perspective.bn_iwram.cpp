@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_affine_bg_perspective.h"
+
+#include "bn_math.h"
+
+namespace bn
+{
+
+void affine_bg_perspective::_update_lines()
+{
+    int first_line = _horizon + 1;
+
+    for(int index = 0; index < first_line; ++index)
+    {
+        _pa_values[index] = 0;
+        _pc_values[index] = 0;
+        _x_offsets[index] = 0;
+        _y_offsets[index] = 0;
+    }
+
+    // Scales have 12 fractional bits, sines and cosines 8:
+    int camera_y = _y.data() >> 4;
+    int camera_cos = degrees_lut_cos(_angle).data() >> 4;
+    int camera_sin = degrees_lut_sin(_angle).data() >> 4;
+    int focal_length = _focal_length;
+    const fixed_t<20>* reciprocals = reciprocal_lut.data();
+
+    for(int index = first_line; index < display::height(); ++index)
+    {
+        int reciprocal = reciprocals[index - _horizon].data() >> 4;
+        int scale = int((int64_t(camera_y) * reciprocal) >> 12);
+        int scale_cos = (scale * camera_cos) >> 8;
+        int scale_sin = (scale * camera_sin) >> 8;
+
+        _pa_values[index] = int16_t(scale_cos >> 4);
+        _pc_values[index] = int16_t(scale_sin >> 4);
+        _x_offsets[index] = (focal_length * scale_sin) - ((display::width() / 2) * scale_cos);
+        _y_offsets[index] = -(focal_length * scale_cos) - ((display::width() / 2) * scale_sin);
+    }
+}
+
+void affine_bg_perspective::_update_translation()
+{
+    int first_line = _horizon + 1;
+
+    for(int index = 0; index < first_line; ++index)
+    {
+        _dx_values[index] = 0;
+        _dy_values[index] = 0;
+    }
+
+    int camera_x = _x.data();
+    int camera_z = _z.data();
+
+    for(int index = first_line; index < display::height(); ++index)
+    {
+        _dx_values[index] = (camera_x + _x_offsets[index]) >> 4;
+        _dy_values[index] = (camera_z + _y_offsets[index]) >> 4;
+    }
+}
+
+}
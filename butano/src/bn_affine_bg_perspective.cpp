@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_affine_bg_perspective.h"
+
+namespace bn
+{
+
+affine_bg_perspective::affine_bg_perspective(fixed x, fixed y, fixed z, fixed angle, int horizon, int focal_length) :
+    _x(x),
+    _y(y),
+    _z(z),
+    _angle(angle),
+    _focal_length(focal_length),
+    _horizon(int16_t(horizon))
+{
+    BN_ASSERT(y >= 0, "Invalid y: ", y);
+    BN_ASSERT(angle >= 0 && angle <= 360, "Angle must be in the range [0, 360]: ", angle);
+    BN_ASSERT(horizon >= 0 && horizon < display::height(), "Invalid horizon: ", horizon);
+    BN_ASSERT(focal_length > 0, "Invalid focal length: ", focal_length);
+
+    update();
+}
+
+bool affine_bg_perspective::update()
+{
+    if(_lines_updated)
+    {
+        _lines_updated = false;
+        _translation_updated = false;
+        _update_lines();
+        _update_translation();
+        return true;
+    }
+
+    if(_translation_updated)
+    {
+        _translation_updated = false;
+        _update_translation();
+        return true;
+    }
+
+    return false;
+}
+
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_algorithm.h"
+
+#include "bn_assert.h"
+#include "bn_utility.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int small_sort_max_count = 32;
+
+    template<typename Type>
+    void _sort_three(Type* values, int first, int middle, int last)
+    {
+        if(values[middle] < values[first])
+        {
+            swap(values[middle], values[first]);
+        }
+
+        if(values[last] < values[middle])
+        {
+            swap(values[last], values[middle]);
+
+            if(values[middle] < values[first])
+            {
+                swap(values[middle], values[first]);
+            }
+        }
+    }
+
+    template<typename Type>
+    void _nth_element(Type* values, int count, int nth)
+    {
+        BN_ASSERT(nth >= 0 && nth < count, "Invalid nth: ", nth, " - ", count);
+
+        int left = 0;
+        int right = count - 1;
+
+        while(right - left >= small_sort_max_count)
+        {
+            // After sorting them, the first and the last values are sentinels of the partition loops:
+            int middle = (left + right) >> 1;
+            _sort_three(values, left, middle, right);
+
+            Type pivot = values[middle];
+            int i = left;
+            int j = right;
+
+            while(i <= j)
+            {
+                while(values[i] < pivot)
+                {
+                    ++i;
+                }
+
+                while(pivot < values[j])
+                {
+                    --j;
+                }
+
+                if(i <= j)
+                {
+                    swap(values[i], values[j]);
+                    ++i;
+                    --j;
+                }
+            }
+
+            if(nth <= j)
+            {
+                right = j;
+            }
+            else if(nth >= i)
+            {
+                left = i;
+            }
+            else
+            {
+                return;
+            }
+        }
+
+        small_sort(values + left, values + right + 1);
+    }
+
+    template<typename Type>
+    void _sift_down(Type* values, int count, int index)
+    {
+        Type value = values[index];
+
+        while(true)
+        {
+            int child = (index << 1) + 1;
+
+            if(child >= count)
+            {
+                break;
+            }
+
+            if(child + 1 < count && values[child] < values[child + 1])
+            {
+                ++child;
+            }
+
+            if(! (value < values[child]))
+            {
+                break;
+            }
+
+            values[index] = values[child];
+            index = child;
+        }
+
+        values[index] = value;
+    }
+
+    template<typename Type>
+    void _partial_sort(Type* values, int count, int middle)
+    {
+        BN_ASSERT(middle >= 0 && middle <= count, "Invalid middle: ", middle, " - ", count);
+
+        if(middle < count && middle > 0)
+        {
+            _nth_element(values, count, middle);
+        }
+
+        if(middle <= small_sort_max_count)
+        {
+            small_sort(values, values + middle);
+            return;
+        }
+
+        // Heap sort is used for big ranges to avoid the quadratic time of insertion sort:
+        for(int index = (middle >> 1) - 1; index >= 0; --index)
+        {
+            _sift_down(values, middle, index);
+        }
+
+        for(int last = middle - 1; last > 0; --last)
+        {
+            swap(values[0], values[last]);
+            _sift_down(values, last, 0);
+        }
+    }
+}
+
+void radix_sort(unsigned* values, int count, int key_bits, unsigned* temp_values)
+{
+    BN_ASSERT(count >= 0, "Invalid count: ", count);
+    BN_ASSERT(key_bits >= 1 && key_bits <= 32, "Invalid key bits: ", key_bits);
+
+    if(count < 2)
+    {
+        return;
+    }
+
+    unsigned* source_values = values;
+    unsigned* destination_values = temp_values;
+    int shift = 32 - key_bits;
+
+    // The first pass takes the lowest key bits which don't fit in a full 8 bits digit:
+    int digit_bits = key_bits % 8;
+
+    if(! digit_bits)
+    {
+        digit_bits = 8;
+    }
+
+    for(; shift < 32; shift += digit_bits, digit_bits = 8)
+    {
+        unsigned digit_mask = (1U << digit_bits) - 1;
+        int offsets[256] = {};
+
+        for(int index = 0; index < count; ++index)
+        {
+            ++offsets[(source_values[index] >> shift) & digit_mask];
+        }
+
+        // Skip passes in which all values share the same digit:
+        if(offsets[(source_values[0] >> shift) & digit_mask] == count)
+        {
+            continue;
+        }
+
+        int offset = 0;
+
+        for(int& digit_offset : offsets)
+        {
+            int next_offset = offset + digit_offset;
+            digit_offset = offset;
+            offset = next_offset;
+        }
+
+        for(int index = 0; index < count; ++index)
+        {
+            unsigned value = source_values[index];
+            destination_values[offsets[(value >> shift) & digit_mask]++] = value;
+        }
+
+        swap(source_values, destination_values);
+    }
+
+    if(source_values != values)
+    {
+        copy(source_values, source_values + count, values);
+    }
+}
+
+void small_sort(int* values, int count)
+{
+    BN_ASSERT(count >= 0, "Invalid count: ", count);
+
+    small_sort(values, values + count);
+}
+
+void small_sort(unsigned* values, int count)
+{
+    BN_ASSERT(count >= 0, "Invalid count: ", count);
+
+    small_sort(values, values + count);
+}
+
+void nth_element(int* values, int count, int nth)
+{
+    _nth_element(values, count, nth);
+}
+
+void nth_element(unsigned* values, int count, int nth)
+{
+    _nth_element(values, count, nth);
+}
+
+void partial_sort(int* values, int count, int middle)
+{
+    _partial_sort(values, count, middle);
+}
+
+void partial_sort(unsigned* values, int count, int middle)
+{
+    _partial_sort(values, count, middle);
+}
+
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_atan2_lut.h"
+
+#include "bn_array.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr array<uint16_t, atan2_lut_size> atan2_lut_impl = []{
+        array<uint16_t, atan2_lut_size> result;
+
+        for(int index = 0; index < atan2_lut_size; ++index)
+        {
+            result[index] = uint16_t(calculate_atan2_lut_value(index));
+        }
+
+        return result;
+    }();
+}
+
+const array<uint16_t, atan2_lut_size>& atan2_lut = atan2_lut_impl;
+
+}
@@ -20,4 +20,34 @@ void set_update_on_vblank(bool update_on_vblank)
     audio_manager::set_update_on_vblank(update_on_vblank);
 }
 
+int mixing_rate()
+{
+    return audio_manager::mixing_rate();
+}
+
+void set_mixing_rate(int mixing_rate)
+{
+    audio_manager::set_mixing_rate(mixing_rate);
+}
+
+int max_music_channels()
+{
+    return audio_manager::max_music_channels();
+}
+
+int max_sound_channels()
+{
+    return audio_manager::max_sound_channels();
+}
+
+void set_max_channels(int max_music_channels, int max_sound_channels)
+{
+    audio_manager::set_max_channels(max_music_channels, max_sound_channels);
+}
+
+int mixer_ticks()
+{
+    return audio_manager::mixer_ticks();
+}
+
 }
@@ -7,6 +7,7 @@
 
 #include "bn_vector.h"
 #include "bn_config_audio.h"
+#include "bn_pcm_stream_manager.h"
 #include "../hw/include/bn_hw_audio.h"
 
 #include "bn_audio.cpp.h"
@@ -72,6 +73,70 @@ namespace
             return command(SOUND_STOP_ALL);
         }
 
+        [[nodiscard]] static command reconfigure(int mixing_rate, int max_music_channels, int max_sound_channels)
+        {
+            return command(RECONFIGURE, mixing_rate, int16_t(max_music_channels), max_sound_channels);
+        }
+
+        [[nodiscard]] bool plays_sound() const
+        {
+            return _type == SOUND_PLAY || _type == SOUND_PLAY_EX;
+        }
+
+        [[nodiscard]] bool affects_sounds_only() const
+        {
+            return plays_sound() || _type == SOUND_STOP_ALL;
+        }
+
+        [[nodiscard]] bool stops_sounds() const
+        {
+            return _type == SOUND_STOP_ALL || _type == RECONFIGURE;
+        }
+
+        [[nodiscard]] bool restarts_music() const
+        {
+            return _type == MUSIC_PLAY || _type == MUSIC_STOP || _type == RECONFIGURE;
+        }
+
+        [[nodiscard]] int priority() const
+        {
+            return _priority;
+        }
+
+        [[nodiscard]] bool merge_sound(const command& other)
+        {
+            if(_type != other._type || _id != other._id || _speed != other._speed || _panning != other._panning)
+            {
+                return false;
+            }
+
+            _priority = max(_priority, other._priority);
+            _volume = max(_volume, other._volume);
+            return true;
+        }
+
+        [[nodiscard]] bool merge_music_volume(int volume)
+        {
+            if(_type != MUSIC_PLAY && _type != MUSIC_SET_VOLUME)
+            {
+                return false;
+            }
+
+            _volume = uint16_t(volume);
+            return true;
+        }
+
+        [[nodiscard]] bool merge_music_position(int position)
+        {
+            if(_type != MUSIC_SET_POSITION)
+            {
+                return false;
+            }
+
+            _id = position;
+            return true;
+        }
+
         void execute() const
         {
             switch(type(_type))
@@ -113,6 +178,10 @@ namespace
                 hw::audio::stop_all_sounds();
                 return;
 
+            case RECONFIGURE:
+                hw::audio::reconfigure(_id, _priority, _volume);
+                return;
+
             default:
                 BN_ERROR("Invalid type: ", int(_type));
                 return;
@@ -138,7 +207,8 @@ namespace
             MUSIC_SET_VOLUME,
             SOUND_PLAY,
             SOUND_PLAY_EX,
-            SOUND_STOP_ALL
+            SOUND_STOP_ALL,
+            RECONFIGURE
         };
 
         explicit command(type command_type, int id = 0, int16_t priority = 0, int volume = 0, bool loop = false,
@@ -160,7 +230,11 @@ namespace
 
     public:
         vector<command, BN_CFG_AUDIO_MAX_COMMANDS> commands;
+        vector<uint8_t, BN_CFG_AUDIO_MAX_MUSIC_EVENTS> music_events;
         fixed music_volume;
+        int mixing_rate = BN_CFG_AUDIO_MIXING_RATE;
+        int max_music_channels = BN_CFG_AUDIO_MAX_MUSIC_CHANNELS;
+        int max_sound_channels = BN_CFG_AUDIO_MAX_SOUND_CHANNELS;
         int music_position = 0;
         bool music_playing = false;
         bool music_paused = false;
@@ -188,6 +262,77 @@ namespace
     {
         return min(fixed_t<7>(panning + 1).data(), 255);
     }
+
+    [[nodiscard]] command* _lowest_priority_sound_command()
+    {
+        command* result = nullptr;
+
+        for(command& command : data.commands)
+        {
+            if(command.plays_sound() && (! result || command.priority() < result->priority()))
+            {
+                result = &command;
+            }
+        }
+
+        return result;
+    }
+
+    void _push_command(const command& new_command)
+    {
+        if(data.commands.full())
+        {
+            // Sound effects are evicted to make room for commands which can't be discarded:
+            command* evicted_command = _lowest_priority_sound_command();
+            BN_ASSERT(evicted_command, "No more audio commands available");
+
+            data.commands.erase(data.commands.begin() + (evicted_command - data.commands.data()));
+        }
+
+        data.commands.push_back(new_command);
+    }
+
+    void _push_sound_command(const command& sound_command)
+    {
+        // Sound effects played more than once in the same frame are merged:
+        for(auto it = data.commands.end(), begin = data.commands.begin(); it != begin; )
+        {
+            --it;
+
+            if(it->merge_sound(sound_command))
+            {
+                return;
+            }
+
+            if(it->stops_sounds())
+            {
+                break;
+            }
+        }
+
+        if(data.commands.full())
+        {
+            // The sound effect with the lowest priority is discarded:
+            command* evicted_command = _lowest_priority_sound_command();
+
+            if(! evicted_command || evicted_command->priority() >= sound_command.priority())
+            {
+                return;
+            }
+
+            data.commands.erase(data.commands.begin() + (evicted_command - data.commands.data()));
+        }
+
+        data.commands.push_back(sound_command);
+    }
+
+    void _reconfigure()
+    {
+        pcm_stream_manager::force_stop();
+        _push_command(command::reconfigure(data.mixing_rate, data.max_music_channels, data.max_sound_channels));
+        data.music_playing = false;
+        data.music_paused = false;
+    }
 }
 
 void init(func_type hp_vblank_function, func_type lp_vblank_function)
@@ -212,9 +357,7 @@ bool music_playing()
 
 void play_music(music_item item, fixed volume, bool loop)
 {
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
-
-    data.commands.push_back(command::music_play(item, loop, _hw_music_volume(volume)));
+    _push_command(command::music_play(item, loop, _hw_music_volume(volume)));
     data.music_volume = volume;
     data.music_playing = true;
     data.music_paused = false;
@@ -223,9 +366,8 @@ void play_music(music_item item, fixed volume, bool loop)
 void stop_music()
 {
     BN_ASSERT(data.music_playing, "There's no music playing");
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
 
-    data.commands.push_back(command::music_stop());
+    _push_command(command::music_stop());
     data.music_playing = false;
     data.music_paused = false;
 }
@@ -239,18 +381,16 @@ void pause_music()
 {
     BN_ASSERT(data.music_playing, "There's no music playing");
     BN_ASSERT(! data.music_paused, "Music is already paused");
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
 
-    data.commands.push_back(command::music_pause());
+    _push_command(command::music_pause());
     data.music_paused = true;
 }
 
 void resume_music()
 {
     BN_ASSERT(data.music_paused, "Music is not paused");
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
 
-    data.commands.push_back(command::music_resume());
+    _push_command(command::music_resume());
     data.music_paused = false;
 }
 
@@ -264,10 +404,26 @@ int music_position()
 void set_music_position(int position)
 {
     BN_ASSERT(data.music_playing, "There's no music playing");
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
 
-    data.commands.push_back(command::music_set_position(position));
     data.music_position = position;
+
+    // Position commands are merged until the music is restarted:
+    for(auto it = data.commands.end(), begin = data.commands.begin(); it != begin; )
+    {
+        --it;
+
+        if(it->merge_music_position(position))
+        {
+            return;
+        }
+
+        if(it->restarts_music())
+        {
+            break;
+        }
+    }
+
+    _push_command(command::music_set_position(position));
 }
 
 fixed music_volume()
@@ -280,32 +436,96 @@ fixed music_volume()
 void set_music_volume(fixed volume)
 {
     BN_ASSERT(data.music_playing, "There's no music playing");
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
 
-    data.commands.push_back(command::music_set_volume(_hw_music_volume(volume)));
+    int hw_volume = _hw_music_volume(volume);
     data.music_volume = volume;
+
+    // Volume commands are merged with the previous volume or play command:
+    for(auto it = data.commands.end(), begin = data.commands.begin(); it != begin; )
+    {
+        --it;
+
+        if(it->merge_music_volume(hw_volume))
+        {
+            return;
+        }
+
+        if(it->restarts_music())
+        {
+            break;
+        }
+    }
+
+    _push_command(command::music_set_volume(hw_volume));
 }
 
 void play_sound(int priority, sound_item item)
 {
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
-
-    data.commands.push_back(command::sound_play(priority, item));
+    _push_sound_command(command::sound_play(priority, item));
 }
 
 void play_sound(int priority, sound_item item, fixed volume, fixed speed, fixed panning)
 {
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
-
-    data.commands.push_back(command::sound_play(priority, item, _hw_sound_volume(volume), _hw_sound_speed(speed),
-                                                _hw_sound_panning(panning)));
+    _push_sound_command(command::sound_play(priority, item, _hw_sound_volume(volume), _hw_sound_speed(speed),
+                                            _hw_sound_panning(panning)));
 }
 
 void stop_all_sounds()
 {
-    BN_ASSERT(! data.commands.full(), "No more audio commands available");
+    // Sound effects played before stopping all of them are discarded:
+    erase_if(data.commands, [](const command& command)
+    {
+        return command.affects_sounds_only();
+    });
+
+    _push_command(command::sound_stop_all());
+}
+
+int mixing_rate()
+{
+    return data.mixing_rate;
+}
+
+void set_mixing_rate(int mixing_rate)
+{
+    BN_ASSERT(mixing_rate >= BN_AUDIO_MIXING_RATE_8_KHZ && mixing_rate <= BN_CFG_AUDIO_MAX_MIXING_RATE,
+              "Invalid mixing rate: ", mixing_rate, " - ", BN_CFG_AUDIO_MAX_MIXING_RATE);
+
+    if(mixing_rate != data.mixing_rate)
+    {
+        data.mixing_rate = mixing_rate;
+        _reconfigure();
+    }
+}
+
+int max_music_channels()
+{
+    return data.max_music_channels;
+}
+
+int max_sound_channels()
+{
+    return data.max_sound_channels;
+}
+
+void set_max_channels(int max_music_channels, int max_sound_channels)
+{
+    BN_ASSERT(max_music_channels > 0 && max_music_channels <= BN_CFG_AUDIO_MAX_MUSIC_CHANNELS,
+              "Invalid max music channels: ", max_music_channels, " - ", BN_CFG_AUDIO_MAX_MUSIC_CHANNELS);
+    BN_ASSERT(max_sound_channels > 0 && max_sound_channels <= BN_CFG_AUDIO_MAX_SOUND_CHANNELS,
+              "Invalid max sound channels: ", max_sound_channels, " - ", BN_CFG_AUDIO_MAX_SOUND_CHANNELS);
+
+    if(max_music_channels != data.max_music_channels || max_sound_channels != data.max_sound_channels)
+    {
+        data.max_music_channels = max_music_channels;
+        data.max_sound_channels = max_sound_channels;
+        _reconfigure();
+    }
+}
 
-    data.commands.push_back(command::sound_stop_all());
+int mixer_ticks()
+{
+    return hw::audio::mixer_ticks();
 }
 
 bool update_on_vblank()
@@ -327,6 +547,15 @@ void update()
 {
     hw::audio::update();
 
+    data.music_events.clear();
+
+    uint8_t music_event;
+
+    while(hw::audio::pop_music_event(music_event))
+    {
+        data.music_events.push_back(music_event);
+    }
+
     for(const command& command : data.commands)
     {
         command.execute();
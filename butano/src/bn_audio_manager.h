@@ -6,6 +6,7 @@
 #ifndef BN_AUDIO_MANAGER_H
 #define BN_AUDIO_MANAGER_H
 
+#include "bn_span.h"
 #include "bn_fixed_fwd.h"
 
 namespace bn
@@ -44,12 +45,26 @@ namespace bn::audio_manager
 
     void set_music_volume(fixed volume);
 
+    [[nodiscard]] span<const uint8_t> music_events();
+
     void play_sound(int priority, sound_item item);
 
     void play_sound(int priority, sound_item item, fixed volume, fixed speed, fixed panning);
 
     void stop_all_sounds();
 
+    [[nodiscard]] int mixing_rate();
+
+    void set_mixing_rate(int mixing_rate);
+
+    [[nodiscard]] int max_music_channels();
+
+    [[nodiscard]] int max_sound_channels();
+
+    void set_max_channels(int max_music_channels, int max_sound_channels);
+
+    [[nodiscard]] int mixer_ticks();
+
     [[nodiscard]] bool update_on_vblank();
 
     void set_update_on_vblank(bool update_on_vblank);
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_bg_blocks.h"
+
+#include "bn_bg_blocks_manager.h"
+
+namespace bn::bg_blocks
+{
+
+void begin_batch()
+{
+    bg_blocks_manager::begin_batch();
+}
+
+void end_batch(int max_bytes_per_frame)
+{
+    bg_blocks_manager::end_batch(max_bytes_per_frame);
+}
+
+bool batch_pending()
+{
+    return bg_blocks_manager::batch_pending();
+}
+
+}
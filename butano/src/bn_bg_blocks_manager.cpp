@@ -9,12 +9,15 @@
 #include "bn_string_view.h"
 #include "bn_bgs_manager.h"
 #include "bn_unordered_map.h"
+#include "bn_occupancy_cells.h"
 #include "bn_config_bg_blocks.h"
+#include "bn_bitmap_bg_manager.h"
 #include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_bg_blocks.h"
 
 #include "bn_bg_maps.cpp.h"
 #include "bn_bg_tiles.cpp.h"
+#include "bn_bg_blocks.cpp.h"
 #include "bn_regular_bg_map_ptr.cpp.h"
 #include "bn_regular_bg_map_item.cpp.h"
 #include "bn_regular_bg_tiles_ptr.cpp.h"
@@ -91,6 +94,21 @@ namespace
         return width != height || (width != 16 && width != 32 && width != 64 && width != 128);
     }
 
+    [[nodiscard]] constexpr bool _valid_map_compression(compression_type compression, bool big_map,
+                                                        [[maybe_unused]] int width, [[maybe_unused]] int height)
+    {
+        if(compression == compression_type::CHUNKED)
+        {
+            #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+                return big_map && width % 32 == 0 && height % 32 == 0;
+            #else
+                return false;
+            #endif
+        }
+
+        return compression == compression_type::NONE || ! big_map;
+    }
+
     [[nodiscard]] constexpr int _regular_map_blocks_count(int width, int height)
     {
         if(_big_regular_map(width, height))
@@ -115,6 +133,8 @@ namespace
     constexpr int max_items = BN_CFG_BG_BLOCKS_MAX_ITEMS;
     constexpr int max_list_items = max_items + 1;
 
+    using index_type = uint_least_for<max_list_items>;
+
 
     enum class status_type
     {
@@ -145,16 +165,21 @@ namespace
         uint16_t height = 0;
         uint8_t start_block = 0;
         uint8_t blocks_count = 0;
-        uint8_t next_index = max_list_items;
+        index_type next_index = max_list_items;
+        uint8_t commit_first_row = 0;
+        uint8_t commit_rows_count = 0; // If commit_rows_count == 0, all rows are committed.
+        uint8_t commit_first_column = 0;
+        uint8_t commit_columns_count = 0; // If commit_columns_count == 0, all columns are committed.
 
     private:
         unsigned _status: 2 = unsigned(status_type::FREE);
-        unsigned _compression: 2 = unsigned(compression_type::NONE);
+        unsigned _compression: 3 = unsigned(compression_type::NONE);
 
     public:
         bool is_tiles: 1 = false;
         bool is_affine: 1 = false;
         bool commit: 1 = false;
+        bool batch: 1 = false;
 
         [[nodiscard]] status_type status() const
         {
@@ -176,6 +201,63 @@ namespace
             _compression = unsigned(compression);
         }
 
+        void set_commit()
+        {
+            commit = true;
+            commit_rows_count = 0;
+        }
+
+        void set_commit_rows(int first_row, int rows_count)
+        {
+            set_commit_rect(0, first_row, 0, rows_count);
+        }
+
+        void set_commit_rect(int first_column, int first_row, int columns_count, int rows_count)
+        {
+            int last_row = first_row + rows_count;
+            int last_column = first_column + columns_count;
+
+            if(commit)
+            {
+                if(! commit_rows_count)
+                {
+                    return;
+                }
+
+                first_row = min(first_row, int(commit_first_row));
+                last_row = max(last_row, commit_first_row + commit_rows_count);
+
+                // Pending dirty rects are merged in their bounding box:
+                if(columns_count && commit_columns_count)
+                {
+                    first_column = min(first_column, int(commit_first_column));
+                    last_column = max(last_column, commit_first_column + commit_columns_count);
+                }
+                else
+                {
+                    first_column = 0;
+                    last_column = 0;
+                }
+            }
+
+            commit = true;
+            commit_first_row = uint8_t(first_row);
+            commit_rows_count = uint8_t(last_row - first_row);
+            commit_first_column = uint8_t(first_column);
+            commit_columns_count = uint8_t(last_column - first_column);
+        }
+
+        [[nodiscard]] int commit_cells_count() const
+        {
+            if(int rows_count = commit_rows_count)
+            {
+                int columns_count = commit_columns_count;
+                return rows_count * (columns_count ? columns_count : width);
+            }
+
+            return width * height;
+        }
+
         [[nodiscard]] int tiles_count() const
         {
             return _half_words_to_tiles(width);
@@ -268,7 +350,7 @@ namespace
 
             for(int index = 0; index < max_items; ++index)
             {
-                _free_indices[index] = int8_t(index + 1);
+                _free_indices[index] = index_type(index + 1);
             }
         }
 
@@ -324,11 +406,11 @@ namespace
 
     private:
         item_type _items[max_list_items];
-        vector<int8_t, max_items> _free_indices;
+        vector<index_type, max_items> _free_indices;
 
         void _join(int index, int new_index)
         {
-            _items[index].next_index = uint8_t(new_index);
+            _items[index].next_index = index_type(new_index);
         }
 
         void _insert_node_after(int index, int new_index)
@@ -341,7 +423,7 @@ namespace
         void _remove_node_after(int index)
         {
             auto next_index = int(_items[index].next_index);
-            _free_indices.push_back(int8_t(next_index));
+            _free_indices.push_back(index_type(next_index));
 
             auto next_next_index = int(_items[next_index].next_index);
             _join(index, next_next_index);
@@ -405,22 +487,181 @@ namespace
     };
 
 
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+        static_assert(BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE >= 2);
+
+        class big_map_chunk_type
+        {
+
+        public:
+            alignas(int) uint16_t cells[32 * 32];
+            const uint16_t* map_data = nullptr;
+            int index = 0;
+            unsigned stamp = 0;
+        };
+    #endif
+
+
+    class tiles_frame_type
+    {
+
+    public:
+        const tile* tiles_ptr;
+        index_type item_index;
+        uint16_t first_tile;
+        uint16_t tiles_count;
+    };
+
+
     class static_data
     {
 
     public:
         items_list items;
         unordered_map<const void*, int, max_items * 2> items_map;
-        vector<uint16_t, max_items> to_commit_items;
+        vector<index_type, max_items> free_items;
+        vector<index_type, max_items> to_commit_items;
+        vector<index_type, max_items> batch_items;
+        vector<tiles_frame_type, max_items> tiles_frames;
         int free_blocks_count = 0;
         int to_remove_blocks_count = 0;
+        int batch_max_bytes_per_frame = 0;
         bool check_commit = false;
         bool delay_commit = false;
+        bool batch_started = false;
+        bool batch_updated = false;
+
+        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+            big_map_chunk_type big_map_chunks[BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE];
+            unsigned big_map_chunks_stamp = 0;
+        #endif
     };
 
     BN_DATA_EWRAM static_data data;
 
 
+    template<typename Cell>
+    class big_map_source_data
+    {
+
+    public:
+        const Cell* first_data;
+        const Cell* second_data;
+        int pitch;
+    };
+
+
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+        [[nodiscard]] const uint16_t* _big_map_chunk_data(const item_type& item, int chunk_x, int chunk_y)
+        {
+            const uint16_t* map_data = item.data;
+            int chunk_index = (chunk_y * (item.width / 32)) + chunk_x;
+            unsigned stamp = ++data.big_map_chunks_stamp;
+            big_map_chunk_type* result = data.big_map_chunks;
+
+            for(big_map_chunk_type& chunk : data.big_map_chunks)
+            {
+                if(chunk.map_data == map_data && chunk.index == chunk_index)
+                {
+                    chunk.stamp = stamp;
+                    return chunk.cells;
+                }
+
+                if(chunk.stamp < result->stamp)
+                {
+                    result = &chunk;
+                }
+            }
+
+            auto chunk_offsets = reinterpret_cast<const uint32_t*>(map_data);
+            auto chunk_source_data = reinterpret_cast<const uint8_t*>(map_data) + chunk_offsets[chunk_index];
+            hw::bg_blocks::decompress_big_map_chunk(chunk_source_data, result->cells);
+            result->map_data = map_data;
+            result->index = chunk_index;
+            result->stamp = stamp;
+            return result->cells;
+        }
+    #endif
+
+    template<typename Cell>
+    [[nodiscard]] big_map_source_data<Cell> _big_map_row_source_data(const item_type& item, int x, int y)
+    {
+        big_map_source_data<Cell> result;
+
+        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+            // Chunks are as wide as the hardware map, so each row segment is inside only one chunk:
+            if(item.compression() == compression_type::CHUNKED)
+            {
+                int chunk_x = x / 32;
+                int chunk_y = y / 32;
+                int offset = (y & 31) * 32;
+                auto first_chunk_data = reinterpret_cast<const Cell*>(_big_map_chunk_data(item, chunk_x, chunk_y));
+                result.first_data = first_chunk_data + offset + (x & 31);
+
+                if(x & 31)
+                {
+                    auto second_chunk_data = reinterpret_cast<const Cell*>(
+                                _big_map_chunk_data(item, chunk_x + 1, chunk_y));
+                    result.second_data = second_chunk_data + offset;
+                }
+                else
+                {
+                    result.second_data = result.first_data;
+                }
+
+                result.pitch = 32;
+                return result;
+            }
+        #endif
+
+        int map_width = item.width;
+        result.first_data = reinterpret_cast<const Cell*>(item.data) + ((y * map_width) + x);
+        result.second_data = result.first_data + (32 - (x & 31));
+        result.pitch = map_width;
+        return result;
+    }
+
+    template<typename Cell>
+    [[nodiscard]] big_map_source_data<Cell> _big_map_col_source_data(const item_type& item, int x, int y)
+    {
+        big_map_source_data<Cell> result;
+
+        #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+            // Chunks are as high as the hardware map, so each column segment is inside only one chunk:
+            if(item.compression() == compression_type::CHUNKED)
+            {
+                int chunk_x = x / 32;
+                int chunk_y = y / 32;
+                int offset = x & 31;
+                auto first_chunk_data = reinterpret_cast<const Cell*>(_big_map_chunk_data(item, chunk_x, chunk_y));
+                result.first_data = first_chunk_data + ((y & 31) * 32) + offset;
+
+                if(y & 31)
+                {
+                    // Rows below the map are never shown:
+                    int second_chunk_y = min(chunk_y + 1, (item.height / 32) - 1);
+                    auto second_chunk_data = reinterpret_cast<const Cell*>(
+                                _big_map_chunk_data(item, chunk_x, second_chunk_y));
+                    result.second_data = second_chunk_data + offset;
+                }
+                else
+                {
+                    result.second_data = result.first_data;
+                }
+
+                result.pitch = 32;
+                return result;
+            }
+        #endif
+
+        int map_width = item.width;
+        result.first_data = reinterpret_cast<const Cell*>(item.data) + ((y * map_width) + x);
+        result.second_data = result.first_data + ((32 - (y & 31)) * map_width);
+        result.pitch = map_width;
+        return result;
+    }
+
+
     #if BN_CFG_BG_BLOCKS_LOG_ENABLED
         void _log_status()
         {
@@ -485,6 +726,20 @@ namespace
 
             BN_LOG(']');
 
+            BN_LOG("free_items: ", data.free_items.size());
+            BN_LOG('[');
+
+            for(int item_index : data.free_items)
+            {
+                const item_type& item = data.items.item(item_index);
+                BN_LOG("    ",
+                        "index: ", item_index,
+                        " - start_block: ", item.start_block,
+                        " - blocks_count: ", item.blocks_count);
+            }
+
+            BN_LOG(']');
+
             BN_LOG("free_blocks_count: ", data.free_blocks_count);
             BN_LOG("to_remove_blocks_count: ", data.to_remove_blocks_count);
             BN_LOG("check_commit: ", (data.check_commit ? "true" : "false"));
@@ -516,13 +771,15 @@ namespace
         {
             int id = items_map_iterator->second;
             item_type& item = data.items.item(id);
-            BN_ASSERT(tiles_data == item.data, "Tiles data does not match item tiles data: ",
-                      tiles_data, " - ", item.data);
-            BN_ASSERT(compression == item.compression(), "Tiles compression does not match item tiles compression: ",
-                      int(compression), " - ", int(item.compression()));
-            BN_ASSERT(half_words == item.width, "Tiles count does not match item tiles count: ",
-                      _half_words_to_tiles(half_words), " - ", item.tiles_count());
-            BN_ASSERT(affine == item.is_affine, "Item regular/affine tiles mismatch: ", affine, " - ", item.is_affine);
+            BN_FULL_ASSERT(tiles_data == item.data, "Tiles data does not match item tiles data: ",
+                           tiles_data, " - ", item.data);
+            BN_FULL_ASSERT(compression == item.compression(),
+                           "Tiles compression does not match item tiles compression: ",
+                           int(compression), " - ", int(item.compression()));
+            BN_FULL_ASSERT(half_words == item.width, "Tiles count does not match item tiles count: ",
+                           _half_words_to_tiles(half_words), " - ", item.tiles_count());
+            BN_FULL_ASSERT(affine == item.is_affine, "Item regular/affine tiles mismatch: ",
+                           affine, " - ", item.is_affine);
 
             switch(item.status())
             {
@@ -566,18 +823,18 @@ namespace
         {
             int id = items_map_iterator->second;
             item_type& item = data.items.item(id);
-            BN_ASSERT(map_item.dimensions().width() == item.width, "Width does not match item width: ",
-                      map_item.dimensions().width(), " - ", item.width);
-            BN_ASSERT(map_item.dimensions().height() == item.height, "Height does not match item height: ",
-                      map_item.dimensions().height(), " - ", item.height);
-            BN_ASSERT(map_item.compression() == item.compression(),
-                      "Map compression does not match item map compression: ",
-                      int(map_item.compression()), " - ", int(item.compression()));
-            BN_ASSERT(! item.is_affine, "Item is an affine map");
-            BN_ASSERT(! item.regular_tiles || tiles == *item.regular_tiles,
-                      "Tiles does not match item tiles: ", tiles.id(), " - ", item.regular_tiles->id());
-            BN_ASSERT(! item.palette || palette == *item.palette,
-                      "Palette does not match item palette: ", palette.id(), " - ", item.palette->id());
+            BN_FULL_ASSERT(map_item.dimensions().width() == item.width, "Width does not match item width: ",
+                           map_item.dimensions().width(), " - ", item.width);
+            BN_FULL_ASSERT(map_item.dimensions().height() == item.height, "Height does not match item height: ",
+                           map_item.dimensions().height(), " - ", item.height);
+            BN_FULL_ASSERT(map_item.compression() == item.compression(),
+                           "Map compression does not match item map compression: ",
+                           int(map_item.compression()), " - ", int(item.compression()));
+            BN_FULL_ASSERT(! item.is_affine, "Item is an affine map");
+            BN_FULL_ASSERT(! item.regular_tiles || tiles == *item.regular_tiles,
+                           "Tiles does not match item tiles: ", tiles.id(), " - ", item.regular_tiles->id());
+            BN_FULL_ASSERT(! item.palette || palette == *item.palette,
+                           "Palette does not match item palette: ", palette.id(), " - ", item.palette->id());
 
             switch(item.status())
             {
@@ -677,6 +934,66 @@ namespace
         return -1;
     }
 
+    [[nodiscard]] bool _partial_commit_allowed(const item_type& item)
+    {
+        return ! item.is_affine && ! item.batch && (item.width == 32 || item.width == 64) &&
+                ! _big_regular_map(item.width, item.height) && item.compression() == compression_type::NONE;
+    }
+
+    void _commit_regular_map_span(const item_type& item, int x, int y, int columns_count, unsigned tiles_offset,
+                                  unsigned palette_offset)
+    {
+        // Maps with 64 columns are stored in 32x32 blocks, as in VRAM:
+        int cell_index = (y * 32) + x;
+
+        if(item.width == 64)
+        {
+            cell_index = ((y / 32) * 2048) + ((x / 32) * 1024) + ((y % 32) * 32) + (x % 32);
+        }
+
+        const uint16_t* source_data_ptr = item.data + cell_index;
+        uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block) + cell_index;
+
+        if(tiles_offset || palette_offset)
+        {
+            uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
+            hw::bg_blocks::commit_offset(source_data_ptr, columns_count, offset, destination_vram_ptr);
+        }
+        else
+        {
+            hw::bg_blocks::commit(source_data_ptr, compression_type::NONE, columns_count, destination_vram_ptr);
+        }
+    }
+
+    void _commit_regular_map_rect(const item_type& item, unsigned tiles_offset, unsigned palette_offset)
+    {
+        int first_column = item.commit_first_column;
+        int columns_count = item.commit_columns_count;
+
+        if(! columns_count)
+        {
+            first_column = 0;
+            columns_count = item.width;
+        }
+
+        int last_column = first_column + columns_count;
+        int split_column = clamp(32, first_column, last_column);
+
+        for(int y = item.commit_first_row, last_y = y + item.commit_rows_count; y < last_y; ++y)
+        {
+            // Rows are split in the 32x32 blocks boundary:
+            if(int left_columns_count = split_column - first_column)
+            {
+                _commit_regular_map_span(item, first_column, y, left_columns_count, tiles_offset, palette_offset);
+            }
+
+            if(int right_columns_count = last_column - split_column)
+            {
+                _commit_regular_map_span(item, split_column, y, right_columns_count, tiles_offset, palette_offset);
+            }
+        }
+    }
+
     void _commit_item(const item_type& item)
     {
         const uint16_t* source_data_ptr = item.data;
@@ -736,6 +1053,23 @@ namespace
             auto palette_offset = unsigned(item.palette_offset());
             int half_words = item.width * item.height;
 
+            // Only uncompressed maps with 32 or 64 columns can be committed partially:
+            if(int rows_count = item.commit_rows_count)
+            {
+                int columns_count = item.commit_columns_count;
+
+                if(columns_count || item.width != 32)
+                {
+                    _commit_regular_map_rect(item, tiles_offset, palette_offset);
+                    return;
+                }
+
+                int first_cell = item.commit_first_row * item.width;
+                source_data_ptr += first_cell;
+                destination_vram_ptr += first_cell;
+                half_words = rows_count * item.width;
+            }
+
             if(compression != compression_type::NONE && (tiles_offset || palette_offset))
             {
                 hw::bg_blocks::commit(source_data_ptr, compression, half_words, destination_vram_ptr);
@@ -754,10 +1088,83 @@ namespace
         }
     }
 
+    constexpr auto blocks_count_lower_bound_comparator = [](int item_index, int blocks_count)
+    {
+        return data.items.item(item_index).blocks_count < blocks_count;
+    };
+
+    constexpr auto blocks_count_upper_bound_comparator = [](int blocks_count, int item_index)
+    {
+        return blocks_count < data.items.item(item_index).blocks_count;
+    };
+
+    void _insert_free_item(int id)
+    {
+        const item_type& item = data.items.item(id);
+        auto free_items_it = upper_bound(data.free_items.begin(), data.free_items.end(), int(item.blocks_count),
+                                         blocks_count_upper_bound_comparator);
+        data.free_items.insert(free_items_it, index_type(id));
+    }
+
+    void _erase_free_item(int id)
+    {
+        const item_type& item = data.items.item(id);
+        auto free_items_it = lower_bound(data.free_items.begin(), data.free_items.end(), int(item.blocks_count),
+                                         blocks_count_lower_bound_comparator);
+
+        while(*free_items_it != id)
+        {
+            ++free_items_it;
+        }
+
+        data.free_items.erase(free_items_it);
+    }
+
+    void _erase_batch_item(int id)
+    {
+        item_type& item = data.items.item(id);
+        item.batch = false;
+        data.batch_items.erase(find(data.batch_items.begin(), data.batch_items.end(), id));
+        data.batch_updated = true;
+    }
+
+    [[nodiscard]] int _commit_bytes(const item_type& item)
+    {
+        if(! item.data)
+        {
+            return 0;
+        }
+
+        if(item.is_tiles)
+        {
+            return item.width * 2;
+        }
+
+        if(item.is_affine)
+        {
+            return _big_affine_map(item.width, item.height) ? 0 : item.width * item.height;
+        }
+
+        if(_big_regular_map(item.width, item.height))
+        {
+            return 0;
+        }
+
+        return item.commit_cells_count() * 2;
+    }
+
     [[nodiscard]] int _create_item(int id, int padding_blocks_count, bool delay_commit, create_data&& create_data)
     {
+        BN_ASSERT(! bitmap_bg_manager::active(), "BG tiles and maps can't be created while the bitmap BG is active");
+
         item_type* item = &data.items.item(id);
         int blocks_count = create_data.blocks_count;
+        bool free_item = item->status() == status_type::FREE;
+
+        if(free_item)
+        {
+            _erase_free_item(id);
+        }
 
         if(padding_blocks_count)
         {
@@ -766,6 +1173,11 @@ namespace
             int new_item_blocks_count = item->blocks_count - padding_blocks_count;
             item->blocks_count = uint8_t(padding_blocks_count);
 
+            if(free_item)
+            {
+                _insert_free_item(id);
+            }
+
             item_type new_item;
             new_item.start_block = item->start_block + item->blocks_count;
             new_item.blocks_count = uint8_t(new_item_blocks_count);
@@ -791,6 +1203,11 @@ namespace
             {
                 item->blocks_count -= uint8_t(blocks_count);
 
+                if(item->status() == status_type::FREE)
+                {
+                    _insert_free_item(id);
+                }
+
                 item_type new_item;
                 new_item.start_block = uint8_t(start_block + item->blocks_count);
 
@@ -803,7 +1220,9 @@ namespace
                 item_type new_item;
                 new_item.start_block = uint8_t(start_block + blocks_count);
                 new_item.blocks_count = uint8_t(new_item_blocks_count);
-                data.items.insert_after(id, new_item);
+
+                auto new_item_iterator = data.items.insert_after(id, new_item);
+                _insert_free_item(new_item_iterator.id());
             }
         }
 
@@ -844,11 +1263,22 @@ namespace
 
         bool commit_item = false;
 
+        if(item->batch)
+        {
+            _erase_batch_item(id);
+        }
+
         if(data_ptr)
         {
             data.items_map.insert(data_ptr, id);
 
-            if(delay_commit)
+            if(data.batch_started)
+            {
+                item->batch = true;
+                data.batch_items.push_back(index_type(id));
+                data.batch_updated = true;
+            }
+            else if(delay_commit)
             {
                 commit_item = true;
                 data.check_commit = true;
@@ -860,6 +1290,7 @@ namespace
         }
 
         item->commit = commit_item;
+        item->commit_rows_count = 0;
 
         return id;
     }
@@ -895,17 +1326,60 @@ namespace
         return result;
     }
 
+    template<create_type create_type>
+    [[nodiscard]] ivector<index_type>::iterator _find_free_item(int blocks_count, bpp_mode bpp,
+                                                              int& padding_blocks_count)
+    {
+        // Free items are sorted by blocks count, so the first one which fits is the best one,
+        // unless a bigger one fits exactly because of its padding:
+        auto free_items_end = data.free_items.end();
+        auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, blocks_count,
+                                         blocks_count_lower_bound_comparator);
+        auto smallest_free_items_it = free_items_end;
+        int max_blocks_count = blocks_count + hw::bg_blocks::tiles_alignment_blocks_count();
+
+        while(free_items_it != free_items_end)
+        {
+            const item_type& item = data.items.item(*free_items_it);
+            int item_blocks_count = item.blocks_count;
+
+            if(smallest_free_items_it != free_items_end && item_blocks_count >= max_blocks_count)
+            {
+                break;
+            }
+
+            int item_padding_blocks_count = _padding_blocks_count<create_type>(item.start_block, blocks_count, bpp);
+            int requested_blocks_count = blocks_count + item_padding_blocks_count;
+
+            if(item_blocks_count == requested_blocks_count)
+            {
+                padding_blocks_count = item_padding_blocks_count;
+                return free_items_it;
+            }
+
+            if(item_blocks_count > requested_blocks_count && smallest_free_items_it == free_items_end)
+            {
+                smallest_free_items_it = free_items_it;
+                padding_blocks_count = item_padding_blocks_count;
+            }
+
+            ++free_items_it;
+        }
+
+        return smallest_free_items_it;
+    }
+
     template<create_type create_type>
     [[nodiscard]] int _create_impl(create_data&& create_data)
     {
-        auto begin = data.items.begin();
-        auto end = data.items.end();
         int blocks_count = create_data.blocks_count;
         int to_remove_blocks_count = data.to_remove_blocks_count;
 
         if(blocks_count <= to_remove_blocks_count)
         {
-            for(auto iterator = begin; iterator != end; ++iterator)
+            auto end = data.items.end();
+
+            for(auto iterator = data.items.begin(); iterator != end; ++iterator)
             {
                 const item_type& item = *iterator;
 
@@ -924,40 +1398,12 @@ namespace
 
         if(blocks_count <= data.free_blocks_count)
         {
-            auto smallest_iterator = end;
-            int smallest_blocks_count = numeric_limits<int>::max();
-            int smallest_padding_blocks_count = 0;
+            int padding_blocks_count = 0;
+            auto free_items_it = _find_free_item<create_type>(blocks_count, create_data.bpp, padding_blocks_count);
 
-            for(auto iterator = begin; iterator != end; ++iterator)
+            if(free_items_it != data.free_items.end())
             {
-                const item_type& item = *iterator;
-
-                if(item.status() == status_type::FREE)
-                {
-                    int padding_blocks_count = _padding_blocks_count<create_type>(
-                                item.start_block, blocks_count, create_data.bpp);
-                    int requested_blocks_count = blocks_count + padding_blocks_count;
-
-                    if(item.blocks_count > requested_blocks_count)
-                    {
-                        if(item.blocks_count < smallest_blocks_count)
-                        {
-                            smallest_iterator = iterator;
-                            smallest_blocks_count = item.blocks_count;
-                            smallest_padding_blocks_count = padding_blocks_count;
-                        }
-                    }
-                    else if(item.blocks_count == requested_blocks_count)
-                    {
-                        return _create_item(iterator.id(), padding_blocks_count, data.delay_commit, move(create_data));
-                    }
-                }
-            }
-
-            if(smallest_iterator != end)
-            {
-                return _create_item(smallest_iterator.id(), smallest_padding_blocks_count, data.delay_commit,
-                                    move(create_data));
+                return _create_item(*free_items_it, padding_blocks_count, data.delay_commit, move(create_data));
             }
         }
 
@@ -983,40 +1429,12 @@ namespace
 
         if(blocks_count <= data.free_blocks_count)
         {
-            auto end = data.items.end();
-            auto smallest_iterator = end;
-            int smallest_blocks_count = numeric_limits<int>::max();
-            int smallest_padding_blocks_count = 0;
-
-            for(auto iterator = data.items.begin(); iterator != end; ++iterator)
-            {
-                const item_type& item = *iterator;
-
-                if(item.status() == status_type::FREE)
-                {
-                    int padding_blocks_count = _padding_blocks_count<create_type>(
-                                item.start_block, blocks_count, create_data.bpp);
-                    int requested_blocks_count = blocks_count + padding_blocks_count;
-
-                    if(item.blocks_count > requested_blocks_count)
-                    {
-                        if(item.blocks_count < smallest_blocks_count)
-                        {
-                            smallest_iterator = iterator;
-                            smallest_blocks_count = item.blocks_count;
-                            smallest_padding_blocks_count = padding_blocks_count;
-                        }
-                    }
-                    else if(item.blocks_count == requested_blocks_count)
-                    {
-                        return _create_item(iterator.id(), padding_blocks_count, false, move(create_data));
-                    }
-                }
-            }
+            int padding_blocks_count = 0;
+            auto free_items_it = _find_free_item<create_type>(blocks_count, create_data.bpp, padding_blocks_count);
 
-            if(smallest_iterator != end)
+            if(free_items_it != data.free_items.end())
             {
-                return _create_item(smallest_iterator.id(), smallest_padding_blocks_count, false, move(create_data));
+                return _create_item(*free_items_it, padding_blocks_count, false, move(create_data));
             }
         }
 
@@ -1033,7 +1451,11 @@ namespace
         {
             current_item.blocks_count += adjacent_item.blocks_count;
 
-            if(adjacent_item_status == status_type::TO_REMOVE)
+            if(adjacent_item_status == status_type::FREE)
+            {
+                _erase_free_item(adjacent_id);
+            }
+            else
             {
                 if(adjacent_item.data)
                 {
@@ -1046,6 +1468,88 @@ namespace
 
         return remove;
     }
+
+    [[nodiscard]] int _first_block_column(int first_index, int last_index, int first_column)
+    {
+        // Maps with 64 columns are stored in 32x32 blocks, so rows are split in their boundaries:
+        int column = first_column + last_index - 1;
+        return max(last_index - 1 - (column % 32), first_index);
+    }
+
+    void _fill_regular_map_row(const regular_bg_map_item& map_item, int x, int y, int columns_count,
+                               regular_bg_map_cell cell)
+    {
+        auto cells_ptr = const_cast<uint16_t*>(&map_item.cells_ref());
+
+        for(int last_index = columns_count; last_index > 0; )
+        {
+            int first_index = _first_block_column(0, last_index, x);
+            uint16_t* span_cells_ptr = cells_ptr + map_item.cell_index(x + first_index, y);
+            hw::memory::set_half_words(cell, last_index - first_index, span_cells_ptr);
+            last_index = first_index;
+        }
+    }
+
+    void _copy_regular_map_row(const regular_bg_map_item& source_map_item, int source_x, int source_y,
+                               const regular_bg_map_item& map_item, int x, int y, int columns_count, uint16_t offset)
+    {
+        const uint16_t* source_cells_ptr = &source_map_item.cells_ref();
+        auto cells_ptr = const_cast<uint16_t*>(&map_item.cells_ref());
+
+        // Spans are copied from right to left if the destination can overlap the end of the source:
+        bool backward = x > source_x;
+        int first_index = 0;
+        int last_index = columns_count;
+
+        while(first_index < last_index)
+        {
+            int span_first_index;
+            int span_last_index;
+
+            if(backward)
+            {
+                span_first_index = max(_first_block_column(first_index, last_index, source_x),
+                                       _first_block_column(first_index, last_index, x));
+                span_last_index = last_index;
+                last_index = span_first_index;
+            }
+            else
+            {
+                span_first_index = first_index;
+                span_last_index = min(first_index + 32 - ((source_x + first_index) % 32),
+                                      first_index + 32 - ((x + first_index) % 32));
+                span_last_index = min(span_last_index, last_index);
+                first_index = span_last_index;
+            }
+
+            hw::bg_blocks::copy_regular_map_cells(
+                    source_cells_ptr + source_map_item.cell_index(source_x + span_first_index, source_y),
+                    span_last_index - span_first_index, offset,
+                    cells_ptr + map_item.cell_index(x + span_first_index, y));
+        }
+    }
+
+    [[nodiscard]] item_type& _writable_map_item(int id, bool affine)
+    {
+        item_type& item = data.items.item(id);
+        BN_ASSERT(item.data, "Item has no data");
+        BN_ASSERT(! item.is_tiles && item.is_affine == affine,
+                  affine ? "Item is not an affine map" : "Item is not a regular map");
+        BN_ASSERT(! hw::memory::in_rom(item.data), "Map cells are in ROM");
+        BN_ASSERT(item.compression() == compression_type::NONE, "Compressed map cells not supported: ",
+                  int(item.compression()));
+
+        return item;
+    }
+
+    void _check_map_rect([[maybe_unused]] int x, [[maybe_unused]] int y, [[maybe_unused]] int columns_count,
+                         [[maybe_unused]] int rows_count, [[maybe_unused]] const size& dimensions)
+    {
+        BN_ASSERT(x >= 0 && columns_count > 0 && x + columns_count <= dimensions.width(),
+                  "Invalid columns: ", x, " - ", columns_count, " - ", dimensions.width());
+        BN_ASSERT(y >= 0 && rows_count > 0 && y + rows_count <= dimensions.height(),
+                  "Invalid rows: ", y, " - ", rows_count, " - ", dimensions.height());
+    }
 }
 
 void init()
@@ -1056,6 +1560,7 @@ void init()
     new_item.blocks_count = hw::bg_tiles::blocks_count();
     data.items.init();
     data.items.push_front(new_item);
+    data.free_items.push_back(index_type(data.items.begin().id()));
     data.free_blocks_count = new_item.blocks_count;
 
     BN_BG_BLOCKS_LOG_STATUS();
@@ -1121,6 +1626,28 @@ int available_map_blocks_count()
     return data.free_blocks_count;
 }
 
+void fill_occupancy_cells(span<occupancy_cell_type> cells)
+{
+    int total_blocks = hw::bg_tiles::blocks_count();
+
+    for(const item_type& item : data.items)
+    {
+        status_type status = item.status();
+
+        if(status != status_type::FREE)
+        {
+            occupancy_cell_type type = occupancy_cell_type::TO_REMOVE;
+
+            if(status == status_type::USED)
+            {
+                type = item.is_tiles ? occupancy_cell_type::BG_TILES : occupancy_cell_type::BG_MAP;
+            }
+
+            set_occupancy_cells(item.start_block, item.blocks_count, total_blocks, type, cells);
+        }
+    }
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -1340,8 +1867,8 @@ int create_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles_ptr
 
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), palette.bpp()),
               "Invalid tiles count: ", tiles.tiles_count(), " - ", int(palette.bpp()));
-    BN_ASSERT(compression == compression_type::NONE || ! _big_regular_map(dimensions.width(), dimensions.height()),
-              "Compressed big regular maps are not supported");
+    BN_ASSERT(_valid_map_compression(compression, _big_regular_map(dimensions.width(), dimensions.height()), dimensions.width(), dimensions.height()),
+              "Map compression not supported: ", int(compression));
 
     result = _create_impl<create_type::MAP>(
                 create_data::from_regular_map(data_ptr, dimensions, compression, move(tiles), move(palette)));
@@ -1393,8 +1920,8 @@ int create_affine_map(const affine_bg_map_item& map_item, affine_bg_tiles_ptr&&
     }
 
     BN_ASSERT(palette.bpp() == bpp_mode::BPP_8, "BPP_4 affine maps not supported");
-    BN_ASSERT(compression == compression_type::NONE || ! _big_affine_map(dimensions.width(), dimensions.height()),
-              "Compressed big affine maps are not supported");
+    BN_ASSERT(_valid_map_compression(compression, _big_affine_map(dimensions.width(), dimensions.height()), dimensions.width(), dimensions.height()),
+              "Map compression not supported: ", int(compression));
 
     result = _create_impl<create_type::MAP>(
                 create_data::from_affine_map(data_ptr, dimensions, compression, move(tiles), move(palette)));
@@ -1531,8 +2058,8 @@ int create_new_regular_map(const regular_bg_map_item& map_item, regular_bg_tiles
 
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles.tiles_count(), palette.bpp()),
               "Invalid tiles count: ", tiles.tiles_count(), " - ", int(palette.bpp()));
-    BN_ASSERT(compression == compression_type::NONE || ! _big_regular_map(dimensions.width(), dimensions.height()),
-              "Compressed big regular maps are not supported");
+    BN_ASSERT(_valid_map_compression(compression, _big_regular_map(dimensions.width(), dimensions.height()), dimensions.width(), dimensions.height()),
+              "Map compression not supported: ", int(compression));
     BN_ASSERT(data.items_map.find(data_ptr) == data.items_map.end(),
               "Multiple copies of the same data not supported");
 
@@ -1579,8 +2106,8 @@ int create_new_affine_map(const affine_bg_map_item& map_item, affine_bg_tiles_pt
                      int(compression));
 
     BN_ASSERT(palette.bpp() == bpp_mode::BPP_8, "BPP_4 affine maps not supported");
-    BN_ASSERT(compression == compression_type::NONE || ! _big_affine_map(dimensions.width(), dimensions.height()),
-              "Compressed big affine maps are not supported");
+    BN_ASSERT(_valid_map_compression(compression, _big_affine_map(dimensions.width(), dimensions.height()), dimensions.width(), dimensions.height()),
+              "Map compression not supported: ", int(compression));
     BN_ASSERT(data.items_map.find(data_ptr) == data.items_map.end(),
               "Multiple copies of the same data not supported");
 
@@ -1930,7 +2457,7 @@ void set_regular_tiles_ref(int id, const regular_bg_tiles_item& tiles_item)
 
         item.data = data_ptr;
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -1938,7 +2465,7 @@ void set_regular_tiles_ref(int id, const regular_bg_tiles_item& tiles_item)
     else if(compression != item.compression())
     {
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -1971,7 +2498,7 @@ void set_affine_tiles_ref(int id, const affine_bg_tiles_item& tiles_item)
 
         item.data = data_ptr;
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -1979,7 +2506,7 @@ void set_affine_tiles_ref(int id, const affine_bg_tiles_item& tiles_item)
     else if(compression != item.compression())
     {
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -2001,8 +2528,8 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item)
               map_item.dimensions().width(), " - ", item.width);
     BN_ASSERT(map_item.dimensions().height() == item.height, "Map height does not match item map height: ",
               map_item.dimensions().height(), " - ", item.height);
-    BN_ASSERT(compression == compression_type::NONE || ! _big_regular_map(item.width, item.height),
-              "Compressed big regular maps are not supported");
+    BN_ASSERT(_valid_map_compression(compression, _big_regular_map(item.width, item.height), item.width, item.height),
+              "Map compression not supported: ", int(compression));
 
     if(item_data != data_ptr)
     {
@@ -2015,7 +2542,7 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item)
 
         item.data = data_ptr;
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -2023,7 +2550,7 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item)
     else if(compression != item.compression())
     {
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -2045,8 +2572,8 @@ void set_affine_map_cells_ref(int id, const affine_bg_map_item& map_item)
               map_item.dimensions().width(), " - ", item.width);
     BN_ASSERT(map_item.dimensions().height() == item.height, "Map height does not match item map height: ",
               map_item.dimensions().height(), " - ", item.height);
-    BN_ASSERT(compression == compression_type::NONE || ! _big_affine_map(item.width, item.height),
-              "Compressed big affine maps are not supported");
+    BN_ASSERT(_valid_map_compression(compression, _big_affine_map(item.width, item.height), item.width, item.height),
+              "Map compression not supported: ", int(compression));
 
     if(item_data != data_ptr)
     {
@@ -2059,7 +2586,7 @@ void set_affine_map_cells_ref(int id, const affine_bg_map_item& map_item)
 
         item.data = data_ptr;
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
@@ -2067,13 +2594,64 @@ void set_affine_map_cells_ref(int id, const affine_bg_map_item& map_item)
     else if(compression != item.compression())
     {
         item.set_compression(compression);
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
 }
 
+void fill_affine_map_rect(int id, int x, int y, int columns_count, int rows_count, affine_bg_map_cell cell)
+{
+    const item_type& item = _writable_map_item(id, true);
+    _check_map_rect(x, y, columns_count, rows_count, size(item.width, item.height));
+
+    auto cells_ptr = reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(item.data)) + (y * item.width) + x;
+
+    for(int row = 0; row < rows_count; ++row)
+    {
+        hw::memory::set_bytes(cell, columns_count, cells_ptr);
+        cells_ptr += item.width;
+    }
+
+    reload_rect(id, x, y, columns_count, rows_count);
+}
+
+void copy_affine_map_rect(int id, const affine_bg_map_item& source_map_item, int source_x, int source_y,
+                          int columns_count, int rows_count, int x, int y, int tiles_offset)
+{
+    const item_type& item = _writable_map_item(id, true);
+    int width = item.width;
+    _check_map_rect(x, y, columns_count, rows_count, size(width, item.height));
+    _check_map_rect(source_x, source_y, columns_count, rows_count, source_map_item.dimensions());
+    BN_ASSERT(tiles_offset >= 0 && tiles_offset < 256, "Invalid tiles offset: ", tiles_offset);
+
+    const uint8_t* source_cells_ptr = &source_map_item.cells_ref() + source_map_item.cell_index(source_x, source_y);
+    auto cells_ptr = reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(item.data)) + (y * width) + x;
+    int source_width = source_map_item.dimensions().width();
+    auto offset = uint8_t(tiles_offset);
+
+    // Rows are copied from bottom to top if the destination can overlap the source:
+    if(y > source_y)
+    {
+        for(int row = rows_count - 1; row >= 0; --row)
+        {
+            hw::bg_blocks::copy_affine_map_cells(source_cells_ptr + (row * source_width), columns_count, offset,
+                                                 cells_ptr + (row * width));
+        }
+    }
+    else
+    {
+        for(int row = 0; row < rows_count; ++row)
+        {
+            hw::bg_blocks::copy_affine_map_cells(source_cells_ptr + (row * source_width), columns_count, offset,
+                                                 cells_ptr + (row * width));
+        }
+    }
+
+    reload_rect(id, x, y, columns_count, rows_count);
+}
+
 void reload(int id)
 {
     BN_BG_BLOCKS_LOG("bg_blocks_manager - RELOAD: ", id, " - ", data.items.item(id).start_block);
@@ -2081,7 +2659,147 @@ void reload(int id)
     item_type& item = data.items.item(id);
     BN_ASSERT(item.data, "Item has no data");
 
-    item.commit = true;
+    item.set_commit();
+    data.check_commit = true;
+
+    BN_BG_BLOCKS_LOG_STATUS();
+}
+
+void set_regular_map_cell(int id, int x, int y, regular_bg_map_cell cell)
+{
+    item_type& item = data.items.item(id);
+    BN_ASSERT(item.data, "Item has no data");
+    BN_ASSERT(! item.is_tiles && ! item.is_affine, "Item is not a regular map");
+    BN_ASSERT(! hw::memory::in_rom(item.data), "Map cells are in ROM");
+
+    regular_bg_map_item map_item(*item.data, size(item.width, item.height), item.compression());
+    const_cast<uint16_t*>(item.data)[map_item.cell_index(x, y)] = cell;
+    reload_rect(id, x, y, 1, 1);
+}
+
+void fill_regular_map_rect(int id, int x, int y, int columns_count, int rows_count, regular_bg_map_cell cell)
+{
+    const item_type& item = _writable_map_item(id, false);
+    size dimensions(item.width, item.height);
+    _check_map_rect(x, y, columns_count, rows_count, dimensions);
+
+    regular_bg_map_item map_item(*item.data, dimensions);
+
+    for(int row = y, last_row = y + rows_count; row < last_row; ++row)
+    {
+        _fill_regular_map_row(map_item, x, row, columns_count, cell);
+    }
+
+    reload_rect(id, x, y, columns_count, rows_count);
+}
+
+void copy_regular_map_rect(int id, const regular_bg_map_item& source_map_item, int source_x, int source_y,
+                           int columns_count, int rows_count, int x, int y, int tiles_offset, int palette_banks_offset)
+{
+    const item_type& item = _writable_map_item(id, false);
+    size dimensions(item.width, item.height);
+    _check_map_rect(x, y, columns_count, rows_count, dimensions);
+    _check_map_rect(source_x, source_y, columns_count, rows_count, source_map_item.dimensions());
+    BN_ASSERT(tiles_offset >= 0 && tiles_offset < 1024, "Invalid tiles offset: ", tiles_offset);
+    BN_ASSERT(palette_banks_offset >= 0 && palette_banks_offset < 16,
+              "Invalid palette banks offset: ", palette_banks_offset);
+
+    regular_bg_map_item map_item(*item.data, dimensions);
+    uint16_t offset = hw::bg_blocks::regular_map_cells_offset(unsigned(tiles_offset), unsigned(palette_banks_offset));
+
+    // Rows are copied from bottom to top if the destination can overlap the source:
+    if(y > source_y)
+    {
+        for(int row = rows_count - 1; row >= 0; --row)
+        {
+            _copy_regular_map_row(source_map_item, source_x, source_y + row, map_item, x, y + row, columns_count,
+                                  offset);
+        }
+    }
+    else
+    {
+        for(int row = 0; row < rows_count; ++row)
+        {
+            _copy_regular_map_row(source_map_item, source_x, source_y + row, map_item, x, y + row, columns_count,
+                                  offset);
+        }
+    }
+
+    reload_rect(id, x, y, columns_count, rows_count);
+}
+
+void reload_rect(int id, int first_column, int first_row, int columns_count, int rows_count)
+{
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - RELOAD RECT: ", id, " - ", first_column, " - ", first_row, " - ",
+                     columns_count, " - ", rows_count);
+
+    item_type& item = data.items.item(id);
+    BN_ASSERT(item.data, "Item has no data");
+    BN_ASSERT(! item.is_tiles, "Item is not a map");
+    BN_ASSERT(first_column >= 0 && columns_count > 0 && first_column + columns_count <= item.width,
+              "Invalid columns: ", first_column, " - ", columns_count, " - ", item.width);
+    BN_ASSERT(first_row >= 0 && rows_count > 0 && first_row + rows_count <= item.height,
+              "Invalid rows: ", first_row, " - ", rows_count, " - ", item.height);
+
+    if(_partial_commit_allowed(item) && (columns_count < item.width || rows_count < item.height))
+    {
+        item.set_commit_rect(first_column, first_row, columns_count < item.width ? columns_count : 0, rows_count);
+    }
+    else
+    {
+        item.set_commit();
+    }
+
+    data.check_commit = true;
+
+    BN_BG_BLOCKS_LOG_STATUS();
+}
+
+void set_tiles_frame(int id, int first_tile, const span<const tile>& tiles_ref)
+{
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - SET TILES FRAME: ", id, " - ", first_tile, " - ", tiles_ref.size());
+
+    const item_type& item = data.items.item(id);
+    int tiles_count = tiles_ref.size();
+    BN_ASSERT(item.is_tiles, "Item is not a tiles one");
+    BN_ASSERT(first_tile >= 0 && tiles_count > 0 && first_tile + tiles_count <= item.tiles_count(),
+              "Invalid tiles range: ", first_tile, " - ", tiles_count, " - ", item.tiles_count());
+
+    // Pending frames of the same tiles range are replaced:
+    for(tiles_frame_type& tiles_frame : data.tiles_frames)
+    {
+        if(tiles_frame.item_index == id && tiles_frame.first_tile == first_tile &&
+                tiles_frame.tiles_count == tiles_count)
+        {
+            tiles_frame.tiles_ptr = tiles_ref.data();
+            return;
+        }
+    }
+
+    BN_ASSERT(! data.tiles_frames.full(), "No more tiles frames available");
+
+    data.tiles_frames.push_back({ tiles_ref.data(), index_type(id), uint16_t(first_tile), uint16_t(tiles_count) });
+}
+
+void reload_rows(int id, int first_row, int rows_count)
+{
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - RELOAD ROWS: ", id, " - ", first_row, " - ", rows_count);
+
+    item_type& item = data.items.item(id);
+    BN_ASSERT(item.data, "Item has no data");
+    BN_ASSERT(! item.is_tiles, "Item is not a map");
+    BN_ASSERT(first_row >= 0 && rows_count > 0 && first_row + rows_count <= item.height,
+              "Invalid rows: ", first_row, " - ", rows_count, " - ", item.height);
+
+    if(_partial_commit_allowed(item) && rows_count < item.height)
+    {
+        item.set_commit_rows(first_row, rows_count);
+    }
+    else
+    {
+        item.set_commit();
+    }
+
     data.check_commit = true;
 
     BN_BG_BLOCKS_LOG_STATUS();
@@ -2133,7 +2851,7 @@ void set_regular_map_tiles(int id, regular_bg_tiles_ptr&& tiles)
 
         if(item.regular_tiles_offset() != old_tiles_offset)
         {
-            item.commit = true;
+            item.set_commit();
             data.check_commit = true;
         }
     }
@@ -2170,7 +2888,7 @@ void set_affine_map_tiles(int id, affine_bg_tiles_ptr&& tiles)
 
         if(item.affine_tiles_offset() != old_tiles_offset)
         {
-            item.commit = true;
+            item.set_commit();
             data.check_commit = true;
         }
     }
@@ -2230,7 +2948,7 @@ void set_regular_map_palette(int id, bg_palette_ptr&& palette)
 
         if(item.regular_tiles_offset() != old_tiles_offset || item.palette_offset() != old_palette_offset)
         {
-            item.commit = true;
+            item.set_commit();
             data.check_commit = true;
         }
     }
@@ -2304,7 +3022,7 @@ void set_regular_map_tiles_and_palette(int id, regular_bg_tiles_ptr&& tiles, bg_
 
     if(item.regular_tiles_offset() != old_tiles_offset || item.palette_offset() != old_palette_offset)
     {
-        item.commit = true;
+        item.set_commit();
         data.check_commit = true;
     }
 }
@@ -2357,18 +3075,72 @@ bool must_commit(int id)
     return item.commit;
 }
 
-void update_regular_map_col(int id, int x, int y)
+bool resident(int id)
 {
     const item_type& item = data.items.item(id);
-    const uint16_t* source_data = item.data;
 
-    if(! source_data)
+    if(item.batch)
+    {
+        return false;
+    }
+
+    if(item.is_tiles)
+    {
+        return true;
+    }
+
+    if(item.is_affine)
+    {
+        const optional<affine_bg_tiles_ptr>& affine_tiles = item.affine_tiles;
+        return ! affine_tiles || ! data.items.item(affine_tiles->handle()).batch;
+    }
+
+    const optional<regular_bg_tiles_ptr>& regular_tiles = item.regular_tiles;
+    return ! regular_tiles || ! data.items.item(regular_tiles->handle()).batch;
+}
+
+bool batch_started()
+{
+    return data.batch_started;
+}
+
+void begin_batch()
+{
+    BN_ASSERT(! data.batch_started, "Batch already started");
+
+    data.batch_started = true;
+}
+
+void end_batch(int max_bytes_per_frame)
+{
+    BN_ASSERT(data.batch_started, "Batch not started");
+    BN_ASSERT(max_bytes_per_frame > 0, "Invalid max bytes per frame: ", max_bytes_per_frame);
+
+    data.batch_max_bytes_per_frame = max_bytes_per_frame;
+    data.batch_started = false;
+}
+
+bool batch_pending()
+{
+    return data.batch_started || ! data.batch_items.empty();
+}
+
+bool batch_updated()
+{
+    return data.batch_updated;
+}
+
+void update_regular_map_col(int id, int x, int y)
+{
+    const item_type& item = data.items.item(id);
+    if(! item.data)
     {
         return;
     }
 
-    int map_width = item.width;
-    source_data += ((y * map_width) + x);
+    big_map_source_data<uint16_t> source = _big_map_col_source_data<uint16_t>(item, x, y);
+    const uint16_t* source_data = source.first_data;
+    int source_pitch = source.pitch;
 
     int y_separator = y & 31;
     uint16_t* dest_data = hw::bg_blocks::vram(item.start_block) + ((y_separator * 32) + (x & 31));
@@ -2383,16 +3155,18 @@ void update_regular_map_col(int id, int x, int y)
         {
             *dest_data = *source_data + offset;
             dest_data += 32;
-            source_data += map_width;
+            source_data += source_pitch;
         }
 
         dest_data -= 1024;
 
+        source_data = source.second_data;
+
         for(int iy = 0; iy < y_separator; ++iy)
         {
             *dest_data = *source_data + offset;
             dest_data += 32;
-            source_data += map_width;
+            source_data += source_pitch;
         }
     }
     else
@@ -2401,16 +3175,18 @@ void update_regular_map_col(int id, int x, int y)
         {
             *dest_data = *source_data;
             dest_data += 32;
-            source_data += map_width;
+            source_data += source_pitch;
         }
 
         dest_data -= 1024;
 
+        source_data = source.second_data;
+
         for(int iy = 0; iy < y_separator; ++iy)
         {
             *dest_data = *source_data;
             dest_data += 32;
-            source_data += map_width;
+            source_data += source_pitch;
         }
     }
 }
@@ -2418,15 +3194,14 @@ void update_regular_map_col(int id, int x, int y)
 void update_affine_map_col(int id, int x, int y)
 {
     const item_type& item = data.items.item(id);
-    auto source_data = reinterpret_cast<const uint8_t*>(item.data);
-
-    if(! source_data)
+    if(! item.data)
     {
         return;
     }
 
-    int map_width = item.width;
-    source_data += ((y * map_width) + x);
+    big_map_source_data<uint8_t> source = _big_map_col_source_data<uint8_t>(item, x, y);
+    const uint8_t* source_data = source.first_data;
+    int source_pitch = source.pitch;
 
     int y_separator = y & 31;
     auto dest_data = reinterpret_cast<uint8_t*>(hw::bg_blocks::vram(item.start_block));
@@ -2442,18 +3217,20 @@ void update_affine_map_col(int id, int x, int y)
                 auto joined_value = uint16_t(((*source_data + tiles_offset) << 8) | (*u16_dest_data & 0xFF));
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
 
             dest_data -= 1024;
 
+            source_data = source.second_data;
+
             for(int iy = 0; iy < y_separator; ++iy)
             {
                 auto u16_dest_data = reinterpret_cast<uint16_t*>(dest_data - 1);
                 auto joined_value = uint16_t(((*source_data + tiles_offset) << 8) | (*u16_dest_data & 0xFF));
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
         }
         else
@@ -2464,18 +3241,20 @@ void update_affine_map_col(int id, int x, int y)
                 auto joined_value = uint16_t((*u16_dest_data & 0xFF00) | (*source_data + tiles_offset));
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
 
             dest_data -= 1024;
 
+            source_data = source.second_data;
+
             for(int iy = 0; iy < y_separator; ++iy)
             {
                 auto u16_dest_data = reinterpret_cast<uint16_t*>(dest_data);
                 auto joined_value = uint16_t((*u16_dest_data & 0xFF00) | (*source_data + tiles_offset));
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
         }
     }
@@ -2489,18 +3268,20 @@ void update_affine_map_col(int id, int x, int y)
                 auto joined_value = uint16_t((unsigned(*source_data) << 8) | (*u16_dest_data & 0xFF));
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
 
             dest_data -= 1024;
 
+            source_data = source.second_data;
+
             for(int iy = 0; iy < y_separator; ++iy)
             {
                 auto u16_dest_data = reinterpret_cast<uint16_t*>(dest_data - 1);
                 uint16_t joined_value = uint16_t((unsigned(*source_data) << 8) | (*u16_dest_data & 0xFF));
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
         }
         else
@@ -2511,18 +3292,20 @@ void update_affine_map_col(int id, int x, int y)
                 uint16_t joined_value = uint16_t((*u16_dest_data & 0xFF00) | *source_data);
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
 
             dest_data -= 1024;
 
+            source_data = source.second_data;
+
             for(int iy = 0; iy < y_separator; ++iy)
             {
                 auto u16_dest_data = reinterpret_cast<uint16_t*>(dest_data);
                 uint16_t joined_value = uint16_t((*u16_dest_data & 0xFF00) | *source_data);
                 *u16_dest_data = joined_value;
                 dest_data += 32;
-                source_data += map_width;
+                source_data += source_pitch;
             }
         }
     }
@@ -2531,14 +3314,13 @@ void update_affine_map_col(int id, int x, int y)
 void update_regular_map_row(int id, int x, int y)
 {
     const item_type& item = data.items.item(id);
-    const uint16_t* source_data = item.data;
-
-    if(! source_data)
+    if(! item.data)
     {
         return;
     }
 
-    source_data += ((y * item.width) + x);
+    big_map_source_data<uint16_t> source = _big_map_row_source_data<uint16_t>(item, x, y);
+    const uint16_t* source_data = source.first_data;
 
     int x_separator = x & 31;
     int elements = 32 - x_separator;
@@ -2550,14 +3332,14 @@ void update_regular_map_row(int id, int x, int y)
     {
         uint16_t offset = hw::bg_blocks::regular_map_cells_offset(tiles_offset, palette_offset);
         hw::bg_blocks::commit_offset(source_data, elements, offset, dest_data);
-        source_data += elements;
+        source_data = source.second_data;
         dest_data -= x_separator;
         hw::bg_blocks::commit_offset(source_data, x_separator, offset, dest_data);
     }
     else
     {
         hw::memory::copy_half_words(source_data, elements, dest_data);
-        source_data += elements;
+        source_data = source.second_data;
         dest_data -= x_separator;
         hw::memory::copy_half_words(source_data, x_separator, dest_data);
     }
@@ -2568,14 +3350,13 @@ void update_affine_map_row(int id, int x, int y)
     // BN_ASSERT(x % 2 == 0, "Invalid x: ", x);
 
     const item_type& item = data.items.item(id);
-    auto source_data = reinterpret_cast<const uint8_t*>(item.data);
-
-    if(! source_data)
+    if(! item.data)
     {
         return;
     }
 
-    source_data += ((y * item.width) + x);
+    big_map_source_data<uint8_t> source = _big_map_row_source_data<uint8_t>(item, x, y);
+    const uint8_t* source_data = source.first_data;
 
     int x_separator = x & 31;
     int elements = 32 - x_separator;
@@ -2587,7 +3368,7 @@ void update_affine_map_row(int id, int x, int y)
         uint16_t offset = hw::bg_blocks::affine_map_cells_offset(tiles_offset);
         hw::bg_blocks::commit_offset(reinterpret_cast<const uint16_t*>(source_data), elements / 2, offset,
                                      reinterpret_cast<uint16_t*>(dest_data));
-        source_data += elements;
+        source_data = source.second_data;
         dest_data -= x_separator;
         hw::bg_blocks::commit_offset(reinterpret_cast<const uint16_t*>(source_data), x_separator / 2, offset,
                                      reinterpret_cast<uint16_t*>(dest_data));
@@ -2595,24 +3376,45 @@ void update_affine_map_row(int id, int x, int y)
     else
     {
         hw::memory::copy_half_words(source_data, elements / 2, dest_data);
-        source_data += elements;
+        source_data = source.second_data;
         dest_data -= x_separator;
         hw::memory::copy_half_words(source_data, x_separator / 2, dest_data);
     }
 }
 
+void load_big_map_chunks([[maybe_unused]] int id, [[maybe_unused]] int x, [[maybe_unused]] int y)
+{
+    #if BN_CFG_BG_BLOCKS_BIG_MAP_CHUNKS_CACHE_SIZE
+        const item_type& item = data.items.item(id);
+
+        if(item.data && item.compression() == compression_type::CHUNKED)
+        {
+            int chunk_x = x / 32;
+            int chunk_y = y / 32;
+            int last_chunk_x = min((x + 31) / 32, (item.width / 32) - 1);
+            int last_chunk_y = min((y + 31) / 32, (item.height / 32) - 1);
+
+            for(int current_chunk_y = chunk_y; current_chunk_y <= last_chunk_y; ++current_chunk_y)
+            {
+                for(int current_chunk_x = chunk_x; current_chunk_x <= last_chunk_x; ++current_chunk_x)
+                {
+                    [[maybe_unused]] const uint16_t* chunk_data =
+                            _big_map_chunk_data(item, current_chunk_x, current_chunk_y);
+                }
+            }
+        }
+    #endif
+}
+
 void set_regular_map_position(int id, int x, int y)
 {
     const item_type& item = data.items.item(id);
-    const uint16_t* item_data = item.data;
-
-    if(! item_data)
+    if(! item.data)
     {
         return;
     }
 
     uint16_t* vram_data = hw::bg_blocks::vram(item.start_block);
-    int map_width = item.width;
     int x_separator = x & 31;
     int elements = 32 - x_separator;
     auto tiles_offset = unsigned(item.regular_tiles_offset());
@@ -2624,10 +3426,11 @@ void set_regular_map_position(int id, int x, int y)
 
         for(int row = y, row_limit = y + 22; row < row_limit; ++row)
         {
-            const uint16_t* source_data = item_data + ((row * map_width) + x);
+            big_map_source_data<uint16_t> source = _big_map_row_source_data<uint16_t>(item, x, row);
+            const uint16_t* source_data = source.first_data;
             uint16_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
             hw::bg_blocks::commit_offset(source_data, elements, offset, dest_data);
-            source_data += elements;
+            source_data = source.second_data;
             dest_data -= x_separator;
             hw::bg_blocks::commit_offset(source_data, x_separator, offset, dest_data);
         }
@@ -2636,30 +3439,28 @@ void set_regular_map_position(int id, int x, int y)
     {
         for(int row = y, row_limit = y + 22; row < row_limit; ++row)
         {
-            const uint16_t* source_data = item_data + ((row * map_width) + x);
+            big_map_source_data<uint16_t> source = _big_map_row_source_data<uint16_t>(item, x, row);
+            const uint16_t* source_data = source.first_data;
             uint16_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
             hw::memory::copy_half_words(source_data, elements, dest_data);
-            source_data += elements;
+            source_data = source.second_data;
             dest_data -= x_separator;
             hw::memory::copy_half_words(source_data, x_separator, dest_data);
         }
     }
 }
 
-void set_affine_map_position(int id, int x, int y)
+void set_affine_map_position(int id, int x, int y, int rows_count)
 {
     // BN_ASSERT(x % 2 == 0, "Invalid x: ", x);
 
     const item_type& item = data.items.item(id);
-    auto item_data = reinterpret_cast<const uint8_t*>(item.data);
-
-    if(! item_data)
+    if(! item.data)
     {
         return;
     }
 
     auto vram_data = reinterpret_cast<uint8_t*>(hw::bg_blocks::vram(item.start_block));
-    int map_width = item.width;
     int x_separator = x & 31;
     int elements = 32 - x_separator;
 
@@ -2667,13 +3468,14 @@ void set_affine_map_position(int id, int x, int y)
     {
         uint16_t offset = hw::bg_blocks::affine_map_cells_offset(tiles_offset);
 
-        for(int row = y, row_limit = y + 22; row < row_limit; ++row)
+        for(int row = y, row_limit = y + rows_count; row < row_limit; ++row)
         {
-            const uint8_t* source_data = item_data + ((row * map_width) + x);
+            big_map_source_data<uint8_t> source = _big_map_row_source_data<uint8_t>(item, x, row);
+            const uint8_t* source_data = source.first_data;
             uint8_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
             hw::bg_blocks::commit_offset(reinterpret_cast<const uint16_t*>(source_data), elements / 2, offset,
                                          reinterpret_cast<uint16_t*>(dest_data));
-            source_data += elements;
+            source_data = source.second_data;
             dest_data -= x_separator;
             hw::bg_blocks::commit_offset(reinterpret_cast<const uint16_t*>(source_data), x_separator / 2, offset,
                                          reinterpret_cast<uint16_t*>(dest_data));
@@ -2681,12 +3483,13 @@ void set_affine_map_position(int id, int x, int y)
     }
     else
     {
-        for(int row = y, row_limit = y + 22; row < row_limit; ++row)
+        for(int row = y, row_limit = y + rows_count; row < row_limit; ++row)
         {
-            const uint8_t* source_data = item_data + ((row * map_width) + x);
+            big_map_source_data<uint8_t> source = _big_map_row_source_data<uint8_t>(item, x, row);
+            const uint8_t* source_data = source.first_data;
             uint8_t* dest_data = vram_data + (((row & 31) * 32) + x_separator);
             hw::memory::copy_half_words(source_data, elements / 2, dest_data);
-            source_data += elements;
+            source_data = source.second_data;
             dest_data -= x_separator;
             hw::memory::copy_half_words(source_data, x_separator / 2, dest_data);
         }
@@ -2714,6 +3517,21 @@ void update()
 
             if(item_status == status_type::TO_REMOVE)
             {
+                if(item.batch)
+                {
+                    _erase_batch_item(iterator.id());
+                }
+
+                if(! data.tiles_frames.empty())
+                {
+                    int item_index = iterator.id();
+
+                    erase_if(data.tiles_frames, [item_index](const tiles_frame_type& tiles_frame)
+                    {
+                        return tiles_frame.item_index == item_index;
+                    });
+                }
+
                 if(const uint16_t* item_data = item.data)
                 {
                     data.items_map.erase(item_data);
@@ -2724,6 +3542,7 @@ void update()
                 item.height = 0;
                 item.set_status(status_type::FREE);
                 item.commit = false;
+                item.commit_rows_count = 0;
                 data.free_blocks_count += item.blocks_count;
 
                 auto next_iterator = iterator;
@@ -2750,11 +3569,13 @@ void update()
                         previous_iterator = before_previous_iterator;
                     }
                 }
+
+                _insert_free_item(iterator.id());
             }
             else if(item.commit)
             {
                 item.commit = false;
-                data.to_commit_items.push_back(iterator.id());
+                data.to_commit_items.push_back(index_type(iterator.id()));
             }
 
             before_previous_iterator = previous_iterator;
@@ -2766,24 +3587,73 @@ void update()
     }
 
     data.delay_commit = false;
+    data.batch_updated = false;
 }
 
-void commit()
+int commit()
 {
+    int result = 0;
+
     if(! data.to_commit_items.empty())
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT");
 
         for(int item_index : data.to_commit_items)
         {
-            const item_type& item = data.items.item(item_index);
+            item_type& item = data.items.item(item_index);
             _commit_item(item);
+            result += _commit_bytes(item);
+            item.commit_rows_count = 0;
         }
 
         data.to_commit_items.clear();
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
+
+    // Tiles frames are committed after the full items to override the tiles they replace:
+    if(! data.tiles_frames.empty())
+    {
+        for(const tiles_frame_type& tiles_frame : data.tiles_frames)
+        {
+            const item_type& item = data.items.item(tiles_frame.item_index);
+            auto source_ptr = reinterpret_cast<const uint16_t*>(tiles_frame.tiles_ptr);
+            uint16_t* destination_vram_ptr = hw::bg_blocks::vram(item.start_block) +
+                    (tiles_frame.first_tile * int(sizeof(tile) / sizeof(uint16_t)));
+            int half_words = tiles_frame.tiles_count * int(sizeof(tile) / sizeof(uint16_t));
+            hw::bg_blocks::commit(source_ptr, compression_type::NONE, half_words, destination_vram_ptr);
+            result += half_words * int(sizeof(uint16_t));
+        }
+
+        data.tiles_frames.clear();
+    }
+
+    // Batch items are uploaded in order, but at least one of them each frame to always make progress:
+    if(! data.batch_started && ! data.batch_items.empty())
+    {
+        int max_bytes = data.batch_max_bytes_per_frame;
+        int bytes = 0;
+
+        while(! data.batch_items.empty())
+        {
+            int item_index = data.batch_items.front();
+            item_type& item = data.items.item(item_index);
+            int item_bytes = _commit_bytes(item);
+
+            if(bytes && bytes + item_bytes > max_bytes)
+            {
+                break;
+            }
+
+            _commit_item(item);
+            _erase_batch_item(item_index);
+            bytes += item_bytes;
+        }
+
+        result += bytes;
+    }
+
+    return result;
 }
 
 }
@@ -25,6 +25,7 @@ namespace bn
     class regular_bg_tiles_item;
     enum class bpp_mode : uint8_t;
     enum class compression_type : uint8_t;
+    enum class occupancy_cell_type : uint8_t;
 }
 
 namespace bn::bg_blocks_manager
@@ -47,6 +48,8 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] int available_map_blocks_count();
 
+    void fill_occupancy_cells(span<occupancy_cell_type> cells);
+
     #if BN_CFG_LOG_ENABLED
         void log_status();
     #endif
@@ -127,10 +130,29 @@ namespace bn::bg_blocks_manager
 
     void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item);
 
+    void set_regular_map_cell(int id, int x, int y, regular_bg_map_cell cell);
+
+    void fill_regular_map_rect(int id, int x, int y, int columns_count, int rows_count, regular_bg_map_cell cell);
+
+    void copy_regular_map_rect(int id, const regular_bg_map_item& source_map_item, int source_x, int source_y,
+                               int columns_count, int rows_count, int x, int y, int tiles_offset,
+                               int palette_banks_offset);
+
     void set_affine_map_cells_ref(int id, const affine_bg_map_item& map_item);
 
+    void fill_affine_map_rect(int id, int x, int y, int columns_count, int rows_count, affine_bg_map_cell cell);
+
+    void copy_affine_map_rect(int id, const affine_bg_map_item& source_map_item, int source_x, int source_y,
+                              int columns_count, int rows_count, int x, int y, int tiles_offset);
+
     void reload(int id);
 
+    void reload_rows(int id, int first_row, int rows_count);
+
+    void reload_rect(int id, int first_column, int first_row, int columns_count, int rows_count);
+
+    void set_tiles_frame(int id, int first_tile, const span<const tile>& tiles_ref);
+
     [[nodiscard]] const regular_bg_tiles_ptr& regular_map_tiles(int id);
 
     [[nodiscard]] const affine_bg_tiles_ptr& affine_map_tiles(int id);
@@ -161,6 +183,18 @@ namespace bn::bg_blocks_manager
 
     [[nodiscard]] bool must_commit(int id);
 
+    [[nodiscard]] bool resident(int id);
+
+    [[nodiscard]] bool batch_started();
+
+    void begin_batch();
+
+    void end_batch(int max_bytes_per_frame);
+
+    [[nodiscard]] bool batch_pending();
+
+    [[nodiscard]] bool batch_updated();
+
     void update_regular_map_col(int id, int x, int y);
 
     void update_affine_map_col(int id, int x, int y);
@@ -171,11 +205,13 @@ namespace bn::bg_blocks_manager
 
     void set_regular_map_position(int id, int x, int y);
 
-    void set_affine_map_position(int id, int x, int y);
+    void set_affine_map_position(int id, int x, int y, int rows_count);
+
+    void load_big_map_chunks(int id, int x, int y);
 
     void update();
 
-    void commit();
+    [[nodiscard]] int commit();
 }
 
 #endif
@@ -37,9 +37,8 @@ public:
         {
             palette_target_id palette_target_id(target_id);
             int target_color = palette_target_id.params.final_color_index;
-            int first_color = commit_data_ptr->offset;
-            int last_color = first_color + commit_data_ptr->count - 1;
-            return target_color >= first_color && target_color <= last_color;
+            int target_bank = target_color / hw::palettes::colors_per_palette();
+            return commit_data_ptr->banks & (1u << target_bank);
         }
 
         return false;
@@ -34,7 +34,7 @@ public:
 
         if(palettes_bank::commit_data* commit_data_ptr = commit_data.get())
         {
-            return commit_data_ptr->offset == 0;
+            return commit_data_ptr->banks & 1;
         }
 
         return false;
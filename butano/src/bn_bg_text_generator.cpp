@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_bg_text_generator.h"
+
+#include "bn_memory.h"
+#include "bn_display.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_utf8_character.h"
+#include "bn_regular_bg_builder.h"
+#include "bn_regular_bg_map_item.h"
+#include "bn_regular_bg_tiles_ptr.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] regular_bg_map_ptr _create_map(const sprite_font& font, regular_bg_map_cell* cells)
+    {
+        const sprite_item& item = font.item();
+        const sprite_tiles_item& tiles_item = item.tiles_item();
+        const sprite_palette_item& palette_item = item.palette_item();
+        BN_ASSERT(font.character_widths_ref().empty(), "Variable width fonts not supported");
+        BN_ASSERT(! font.space_between_characters(),
+                  "Space between characters not supported: ", font.space_between_characters());
+        BN_ASSERT(tiles_item.bpp() == bpp_mode::BPP_4, "8BPP fonts not supported");
+        BN_ASSERT(tiles_item.compression() == compression_type::NONE, "Compressed fonts not supported");
+
+        // The first tile is left empty for spaces and erased cells:
+        span<const tile> source_tiles = tiles_item.tiles_ref();
+        int tiles_count = source_tiles.size() + 1;
+        regular_bg_tiles_ptr tiles = regular_bg_tiles_ptr::allocate(tiles_count, bpp_mode::BPP_4);
+        optional<span<tile>> tiles_vram = tiles.vram();
+        tile* tiles_vram_data = tiles_vram->data();
+        memory::clear(1, tiles_vram_data[0]);
+        memory::copy(source_tiles[0], source_tiles.size(), tiles_vram_data[1]);
+
+        bg_palette_item bg_palette_item(palette_item.colors_ref(), bpp_mode::BPP_4, palette_item.compression());
+        memory::clear(bg_text_generator::columns() * bg_text_generator::rows(), cells[0]);
+
+        regular_bg_map_item map_item(cells[0], size(bg_text_generator::columns(), bg_text_generator::rows()));
+        return regular_bg_map_ptr::create_new(map_item, move(tiles), bg_palette_item.create_palette());
+    }
+
+    [[nodiscard]] regular_bg_ptr _create_bg(const regular_bg_map_ptr& map)
+    {
+        regular_bg_builder builder(map);
+        builder.set_position((bg_text_generator::columns() * 4) - (display::width() / 2),
+                             (bg_text_generator::rows() * 4) - (display::height() / 2));
+        return builder.build();
+    }
+}
+
+bg_text_generator::bg_text_generator(const sprite_font& font) :
+    _font(font),
+    _map(_create_map(font, _cells)),
+    _bg(_create_bg(_map))
+{
+    int utf8_character_index = sprite_font::minimum_graphics;
+
+    for(const string_view& utf8_character_text : font.utf8_characters_ref())
+    {
+        utf8_character utf8_char(utf8_character_text.data());
+        _utf8_characters_map.insert(utf8_char.data(), utf8_character_index);
+        ++utf8_character_index;
+    }
+
+    const sprite_shape_size& shape_size = font.item().shape_size();
+    _character_columns = int8_t(shape_size.width() / 8);
+    _character_rows = int8_t(shape_size.height() / 8);
+}
+
+int bg_text_generator::width(const string_view& text) const
+{
+    const char* text_data = text.data();
+    int text_index = 0;
+    int text_size = text.size();
+    int result = 0;
+
+    while(text_index < text_size)
+    {
+        char character = text_data[text_index];
+
+        if(character == '\t')
+        {
+            result += _character_columns * 4;
+            ++text_index;
+        }
+        else
+        {
+            result += _character_columns;
+            text_index += character <= '~' ? 1 : utf8_character(text_data[text_index]).size();
+        }
+    }
+
+    return result;
+}
+
+void bg_text_generator::print(int column, int row, const string_view& text)
+{
+    switch(_alignment)
+    {
+
+    case alignment_type::LEFT:
+        break;
+
+    case alignment_type::CENTER:
+        column -= width(text) / 2;
+        break;
+
+    case alignment_type::RIGHT:
+        column -= width(text);
+        break;
+
+    default:
+        BN_ERROR("Invalid alignment: ", int(_alignment));
+        break;
+    }
+
+    const char* text_data = text.data();
+    int text_index = 0;
+    int text_size = text.size();
+    int character_columns = _character_columns;
+    int character_rows = _character_rows;
+    int tiles_per_character = character_columns * character_rows;
+    int first_dirty_row = rows();
+    int last_dirty_row = -1;
+
+    while(text_index < text_size)
+    {
+        char character = text_data[text_index];
+
+        if(character == ' ' || character == '\t')
+        {
+            int columns_count = character == ' ' ? character_columns : character_columns * 4;
+
+            for(int character_row = 0; character_row < character_rows; ++character_row)
+            {
+                for(int character_column = 0; character_column < columns_count; ++character_column)
+                {
+                    _set_cell(column + character_column, row + character_row, 0, first_dirty_row, last_dirty_row);
+                }
+            }
+
+            column += columns_count;
+            ++text_index;
+        }
+        else if(character >= '!')
+        {
+            int graphics_index;
+
+            if(character <= '~')
+            {
+                graphics_index = character - '!';
+                ++text_index;
+            }
+            else
+            {
+                utf8_character utf8_char(text_data[text_index]);
+                auto it = _utf8_characters_map.find(utf8_char.data());
+                BN_ASSERT(it != _utf8_characters_map.end(), "UTF-8 character not found: ", text);
+
+                graphics_index = it->second;
+                text_index += utf8_char.size();
+            }
+
+            int tile_index = 1 + (graphics_index * tiles_per_character);
+
+            for(int character_row = 0; character_row < character_rows; ++character_row)
+            {
+                for(int character_column = 0; character_column < character_columns; ++character_column)
+                {
+                    _set_cell(column + character_column, row + character_row, tile_index, first_dirty_row,
+                              last_dirty_row);
+                    ++tile_index;
+                }
+            }
+
+            column += character_columns;
+        }
+        else
+        {
+            BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+        }
+    }
+
+    _reload_rows(first_dirty_row, last_dirty_row);
+}
+
+void bg_text_generator::erase(int column, int row, int columns_count, int rows_count)
+{
+    BN_ASSERT(columns_count >= 0, "Invalid columns count: ", columns_count);
+    BN_ASSERT(rows_count >= 0, "Invalid rows count: ", rows_count);
+
+    int first_dirty_row = rows();
+    int last_dirty_row = -1;
+
+    for(int row_index = 0; row_index < rows_count; ++row_index)
+    {
+        for(int column_index = 0; column_index < columns_count; ++column_index)
+        {
+            _set_cell(column + column_index, row + row_index, 0, first_dirty_row, last_dirty_row);
+        }
+    }
+
+    _reload_rows(first_dirty_row, last_dirty_row);
+}
+
+void bg_text_generator::clear()
+{
+    erase(0, 0, columns(), rows());
+}
+
+void bg_text_generator::_set_cell(int column, int row, int tile_index, int& first_dirty_row, int& last_dirty_row)
+{
+    if(column >= 0 && column < columns() && row >= 0 && row < rows())
+    {
+        regular_bg_map_cell& cell = _cells[(row * columns()) + column];
+        auto new_cell = regular_bg_map_cell(tile_index);
+
+        if(cell != new_cell)
+        {
+            cell = new_cell;
+            first_dirty_row = min(first_dirty_row, row);
+            last_dirty_row = max(last_dirty_row, row);
+        }
+    }
+}
+
+void bg_text_generator::_reload_rows(int first_dirty_row, int last_dirty_row)
+{
+    if(first_dirty_row <= last_dirty_row)
+    {
+        _map.reload_cells_ref(first_dirty_row, last_dirty_row - first_dirty_row + 1);
+    }
+}
+
+}
@@ -14,6 +14,7 @@
 #include "bn_display_manager.h"
 #include "bn_bg_blocks_manager.h"
 #include "bn_affine_bg_mat_attributes.h"
+#include "bn_hblank_effects_manager.h"
 #include "../hw/include/bn_hw_bgs.h"
 #include "../hw/include/bn_hw_display.h"
 
@@ -33,6 +34,7 @@ namespace bn::bgs_manager
 namespace
 {
     static_assert(BN_CFG_BGS_MAX_ITEMS > 0);
+    static_assert(BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS >= 0 && BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS <= 8);
 
     class item_type
     {
@@ -53,11 +55,19 @@ namespace
         uint16_t old_big_map_y = 0;
         uint16_t new_big_map_x = 0;
         uint16_t new_big_map_y = 0;
+
+        #if BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+            uint16_t big_map_first_row = 0;
+            uint16_t big_map_last_row = 0;
+            int8_t big_map_rows_direction = 0;
+        #endif
+
         int8_t handles_index = -1;
         bool blending_enabled: 1;
         bool visible: 1;
         bool update: 1;
         bool big_map: 1;
+        bool big_map_transformed: 1;
         bool commit_big_map: 1;
         bool full_commit_big_map: 1;
 
@@ -68,7 +78,8 @@ namespace
             camera(builder.release_camera()),
             blending_enabled(builder.blending_enabled()),
             visible(builder.visible()),
-            update(true)
+            update(true),
+            big_map_transformed(false)
         {
             for(bool& visible_in_window : visible_in_windows)
             {
@@ -88,7 +99,8 @@ namespace
             camera(builder.release_camera()),
             blending_enabled(builder.blending_enabled()),
             visible(builder.visible()),
-            update(true)
+            update(true),
+            big_map_transformed(false)
         {
             for(bool& visible_in_window : visible_in_windows)
             {
@@ -199,10 +211,12 @@ namespace
             {
                 fixed_size fixed_half_dimensions = half_dimensions;
 
+                // Half dimensions only affect the translation, so pa-pd registers don't need to be updated:
                 if(fixed_half_dimensions != affine_mat_attributes.half_dimensions())
                 {
                     affine_mat_attributes.set_half_dimensions(fixed_half_dimensions);
-                    update_affine_mat_attributes();
+                    update_affine_hw_x();
+                    update_affine_hw_y();
                 }
             }
         }
@@ -293,6 +307,36 @@ namespace
             return point(map_x2, map_y2);
         }
 
+        [[nodiscard]] bool affine_mat_transformed() const
+        {
+            return affine_mat_attributes.pa_register_value() != 256 || affine_mat_attributes.pb_register_value() ||
+                    affine_mat_attributes.pc_register_value() || affine_mat_attributes.pd_register_value() != 256;
+        }
+
+        [[nodiscard]] point affine_big_map_position(bool transformed) const
+        {
+            if(! transformed)
+            {
+                return affine_map_position();
+            }
+
+            // The visible area of a rotated or scaled BG is the quad formed by the screen corners in map space,
+            // so the hardware map is centered in its bounding box:
+            int pa_width = affine_mat_attributes.pa_register_value() * display::width();
+            int pb_height = affine_mat_attributes.pb_register_value() * display::height();
+            int pc_width = affine_mat_attributes.pc_register_value() * display::width();
+            int pd_height = affine_mat_attributes.pd_register_value() * display::height();
+            int dx = affine_mat_attributes.dx_register_value();
+            int dy = affine_mat_attributes.dy_register_value();
+
+            // Registers have 8 fractional bits, and there are 8 pixels per map cell:
+            int min_x = (dx + min(pa_width, 0) + min(pb_height, 0)) >> 11;
+            int max_x = (dx + max(pa_width, 0) + max(pb_height, 0)) >> 11;
+            int min_y = (dy + min(pc_width, 0) + min(pd_height, 0)) >> 11;
+            int max_y = (dy + max(pc_width, 0) + max(pd_height, 0)) >> 11;
+            return point(((min_x + max_x + 1) >> 1) - 16, ((min_y + max_y + 1) >> 1) - 16);
+        }
+
         void update_affine_hw_x()
         {
             int dx = affine_mat_attributes.dx_register_value();
@@ -301,8 +345,8 @@ namespace
 
             if(big_map)
             {
-                BN_ASSERT(affine_map_position().x() >= 0 &&
-                          affine_map_position().x() <= (half_dimensions.width() / 4) - (display::width() / 8),
+                BN_ASSERT(affine_mat_transformed() || (affine_map_position().x() >= 0 &&
+                          affine_map_position().x() <= (half_dimensions.width() / 4) - (display::width() / 8)),
                           "Affine BGs with big maps\ndon't allow horizontal wrapping: ",
                           affine_map_position().x(), " - ", (half_dimensions.width() / 4) - (display::width() / 8));
 
@@ -318,8 +362,8 @@ namespace
 
             if(big_map)
             {
-                BN_ASSERT(affine_map_position().y() >= 0 &&
-                          affine_map_position().y() <= (half_dimensions.height() / 4) - (display::height() / 8),
+                BN_ASSERT(affine_mat_transformed() || (affine_map_position().y() >= 0 &&
+                          affine_map_position().y() <= (half_dimensions.height() / 4) - (display::height() / 8)),
                           "Affine BGs with big maps\ndon't allow vertical wrapping: ",
                           affine_map_position().y(), " - ", (half_dimensions.height() / 4) - (display::height() / 8));
 
@@ -351,6 +395,42 @@ namespace
     };
 
 
+    class affine_mat_key
+    {
+
+    public:
+        explicit affine_mat_key(const affine_mat_attributes& mat_attributes) :
+            rotation_angle(mat_attributes.rotation_angle()),
+            horizontal_scale(mat_attributes.horizontal_scale()),
+            vertical_scale(mat_attributes.vertical_scale()),
+            horizontal_shear(mat_attributes.horizontal_shear()),
+            vertical_shear(mat_attributes.vertical_shear()),
+            horizontal_flip(mat_attributes.horizontal_flip()),
+            vertical_flip(mat_attributes.vertical_flip())
+        {
+        }
+
+        [[nodiscard]] bool matches(const affine_mat_attributes& mat_attributes) const
+        {
+            return rotation_angle == mat_attributes.rotation_angle() &&
+                    horizontal_scale == mat_attributes.horizontal_scale() &&
+                    vertical_scale == mat_attributes.vertical_scale() &&
+                    horizontal_shear == mat_attributes.horizontal_shear() &&
+                    vertical_shear == mat_attributes.vertical_shear() &&
+                    horizontal_flip == mat_attributes.horizontal_flip() &&
+                    vertical_flip == mat_attributes.vertical_flip();
+        }
+
+        fixed rotation_angle;
+        fixed horizontal_scale;
+        fixed vertical_scale;
+        fixed horizontal_shear;
+        fixed vertical_shear;
+        bool horizontal_flip;
+        bool vertical_flip;
+    };
+
+
     class static_data
     {
 
@@ -358,6 +438,7 @@ namespace
         pool<item_type, BN_CFG_BGS_MAX_ITEMS> items_pool;
         vector<item_type*, BN_CFG_BGS_MAX_ITEMS> items_vector;
         hw::bgs::handle handles[hw::bgs::count()];
+        uint8_t dirty_registers[hw::bgs::count()] = {};
         bool rebuild_handles = false;
         bool commit = false;
     };
@@ -365,6 +446,87 @@ namespace
     BN_DATA_EWRAM static_data data;
 
 
+    constexpr int cnt_register = 1;
+    constexpr int hofs_register = 2;
+    constexpr int vofs_register = 4;
+    constexpr int affine_registers = 8;
+    constexpr int all_registers = cnt_register | hofs_register | vofs_register | affine_registers;
+    constexpr int first_affine_id = hw::bgs::count() - hw::bgs::affine_count();
+
+
+    void _set_all_registers_dirty()
+    {
+        for(uint8_t& dirty_registers : data.dirty_registers)
+        {
+            dirty_registers = all_registers;
+        }
+
+        data.commit = true;
+    }
+
+    template<typename Type>
+    void _commit_register(Type value, Type* register_ptr)
+    {
+        // Registers written by H-Blank effects are skipped, since they are written again before the first line:
+        if(! hblank_effects_manager::output_register_written(register_ptr))
+        {
+            hw::bgs::commit_register(value, register_ptr);
+        }
+    }
+
+    void _commit_registers(int id, int dirty_registers)
+    {
+        const hw::bgs::handle& handle = data.handles[id];
+
+        if(dirty_registers & cnt_register)
+        {
+            _commit_register(handle.cnt, hw::bgs::attributes_register(id));
+        }
+
+        if(dirty_registers & hofs_register)
+        {
+            _commit_register(handle.hofs, hw::bgs::regular_horizontal_position_register(id));
+        }
+
+        if(dirty_registers & vofs_register)
+        {
+            _commit_register(handle.vofs, hw::bgs::regular_vertical_position_register(id));
+        }
+
+        if(dirty_registers & affine_registers && id >= first_affine_id)
+        {
+            const hw::bgs::affine_attributes& affine = handle.affine;
+            hw::bgs::affine_attributes* affine_register = hw::bgs::affine_mat_register(id);
+            _commit_register(affine.pa, &affine_register->pa);
+            _commit_register(affine.pb, &affine_register->pb);
+            _commit_register(affine.pc, &affine_register->pc);
+            _commit_register(affine.pd, &affine_register->pd);
+            _commit_register(affine.dx, &affine_register->dx);
+            _commit_register(affine.dy, &affine_register->dy);
+        }
+    }
+
+
+    [[nodiscard]] bool _set_shared_mat_attributes(item_type& item, const affine_mat_key& mat_key)
+    {
+        // Affine BGs with the same attributes share the registers, so trigonometric and reciprocal lookups are avoided:
+        for(const item_type* other_item : data.items_vector)
+        {
+            if(other_item != &item && other_item->affine_map)
+            {
+                const affine_mat_attributes& other_mat_attributes = other_item->affine_mat_attributes.mat_attributes();
+
+                if(mat_key.matches(other_mat_attributes))
+                {
+                    item.affine_mat_attributes.set_mat_attributes(other_mat_attributes);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
     [[nodiscard]] bool _check_unique_regular_big_map(item_type& item)
     {
         if(item.big_map)
@@ -425,8 +587,41 @@ namespace
     {
         if(! data.rebuild_handles && item.visible)
         {
-            data.handles[item.handles_index] = item.handle;
-            data.commit = true;
+            // Only the registers that have changed are committed:
+            int handles_index = item.handles_index;
+            hw::bgs::handle& handle = data.handles[handles_index];
+            const hw::bgs::handle& new_handle = item.handle;
+            const hw::bgs::affine_attributes& affine = handle.affine;
+            const hw::bgs::affine_attributes& new_affine = new_handle.affine;
+            int dirty_registers = data.dirty_registers[handles_index];
+
+            if(handle.cnt != new_handle.cnt)
+            {
+                dirty_registers |= cnt_register;
+            }
+
+            if(handle.hofs != new_handle.hofs)
+            {
+                dirty_registers |= hofs_register;
+            }
+
+            if(handle.vofs != new_handle.vofs)
+            {
+                dirty_registers |= vofs_register;
+            }
+
+            if(affine.pa != new_affine.pa || affine.pb != new_affine.pb || affine.pc != new_affine.pc ||
+                    affine.pd != new_affine.pd || affine.dx != new_affine.dx || affine.dy != new_affine.dy)
+            {
+                dirty_registers |= affine_registers;
+            }
+
+            if(dirty_registers)
+            {
+                handle = new_handle;
+                data.dirty_registers[handles_index] = uint8_t(dirty_registers);
+                data.commit = true;
+            }
         }
     }
 
@@ -436,7 +631,7 @@ namespace
         {
             int affine_bgs_count = 0;
             data.rebuild_handles = false;
-            data.commit = true;
+            _set_all_registers_dirty();
 
             for(item_type* item : data.items_vector)
             {
@@ -492,9 +687,11 @@ namespace
                         --regular_id;
                     }
 
+                    // BGs are not shown until their map and tiles have been uploaded to VRAM:
+                    int map_handle = item->affine_map ? item->affine_map->handle() : item->regular_map->handle();
                     item->handles_index = int8_t(id);
                     data.handles[id] = item->handle;
-                    display_manager::set_bg_enabled(id, true);
+                    display_manager::set_bg_enabled(id, bg_blocks_manager::resident(map_handle));
                     display_manager::set_blending_bg_enabled(id, item->blending_enabled);
                 }
                 else
@@ -505,6 +702,65 @@ namespace
         }
     }
 
+    #if BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+        void _update_regular_big_map_rows(item_type& item, int map_handle, int map_x, int first_row, int last_row)
+        {
+            int item_first_row = item.big_map_first_row;
+            int item_last_row = item.big_map_last_row;
+
+            while(item_last_row < last_row)
+            {
+                ++item_last_row;
+                bg_blocks_manager::update_regular_map_row(map_handle, map_x, item_last_row);
+            }
+
+            item_first_row = max(item_first_row, item_last_row - 31);
+
+            while(item_first_row > first_row)
+            {
+                --item_first_row;
+                bg_blocks_manager::update_regular_map_row(map_handle, map_x, item_first_row);
+            }
+
+            item_last_row = min(item_last_row, item_first_row + 31);
+            item.big_map_first_row = uint16_t(item_first_row);
+            item.big_map_last_row = uint16_t(item_last_row);
+        }
+
+        void _look_ahead_regular_big_map_rows(item_type& item, int map_handle, int old_map_y)
+        {
+            int new_map_x = item.new_big_map_x;
+            int new_map_y = item.new_big_map_y;
+
+            if(new_map_y > old_map_y)
+            {
+                item.big_map_rows_direction = 1;
+            }
+            else if(new_map_y < old_map_y)
+            {
+                item.big_map_rows_direction = -1;
+            }
+
+            // Rows copied before V-Blank must not be visible in the current frame,
+            // and they must not overwrite the rows of the next one:
+            int first_row = new_map_y;
+            int last_row = new_map_y + 21;
+
+            if(item.big_map_rows_direction > 0)
+            {
+                last_row += BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS;
+            }
+            else if(item.big_map_rows_direction < 0)
+            {
+                first_row -= BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS;
+            }
+
+            first_row = max(max(first_row, max(old_map_y, new_map_y) - 10), 0);
+            last_row = min(min(last_row, min(old_map_y, new_map_y) + 31), (item.half_dimensions.height() / 4) - 1);
+            _update_regular_big_map_rows(item, map_handle, new_map_x, first_row, last_row);
+        }
+    #endif
+
     void _update_big_maps()
     {
         for(item_type* item : data.items_vector)
@@ -516,6 +772,8 @@ namespace
                 int old_map_y = item->old_big_map_y;
                 int new_map_x;
                 int new_map_y;
+                int map_rows = 22;
+                bool transformed_changed = false;
 
                 if(item_regular_map)
                 {
@@ -524,7 +782,11 @@ namespace
                 }
                 else
                 {
-                    point affine_map_position = item->affine_map_position();
+                    bool transformed = item->affine_mat_transformed();
+                    transformed_changed = transformed != item->big_map_transformed;
+                    item->big_map_transformed = transformed;
+
+                    point affine_map_position = item->affine_big_map_position(transformed);
                     new_map_x = affine_map_position.x();
                     new_map_y = affine_map_position.y();
 
@@ -532,13 +794,22 @@ namespace
                     {
                         --new_map_x;
                     }
+
+                    if(transformed)
+                    {
+                        // Rotated or scaled views can show all rows of the hardware map:
+                        map_rows = 32;
+                        new_map_x = max(new_map_x, 0);
+                        new_map_y = max(new_map_y, 0);
+                    }
                 }
 
                 new_map_x = min(new_map_x, (item->half_dimensions.width() / 4) - 32);
-                new_map_y = min(new_map_y, (item->half_dimensions.height() / 4) - 22);
+                new_map_y = min(new_map_y, (item->half_dimensions.height() / 4) - map_rows);
 
                 int map_handle = item_regular_map ? item_regular_map->handle() : item->affine_map->handle();
-                bool full_commit_big_map = item->full_commit_big_map || bg_blocks_manager::must_commit(map_handle);
+                bool full_commit_big_map = item->full_commit_big_map || transformed_changed ||
+                        bg_blocks_manager::must_commit(map_handle);
                 bool commit_big_map = full_commit_big_map;
 
                 if(! commit_big_map && item->commit_big_map && item->visible)
@@ -553,6 +824,16 @@ namespace
                     item->commit_big_map = true;
                     item->full_commit_big_map = full_commit_big_map || bn::abs(new_map_x - old_map_x) > 8 ||
                             bn::abs(new_map_y - old_map_y) > 8;
+
+                    // Chunked maps are decompressed here to avoid doing it in V-Blank:
+                    bg_blocks_manager::load_big_map_chunks(map_handle, new_map_x, new_map_y);
+
+                    #if BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+                        if(item_regular_map && ! item->full_commit_big_map)
+                        {
+                            _look_ahead_regular_big_map_rows(*item, map_handle, old_map_y);
+                        }
+                    #endif
                 }
             }
         }
@@ -918,7 +1199,13 @@ void set_rotation_angle(id_type id, fixed rotation_angle)
     if(rotation_angle != affine_mat_attributes.rotation_angle())
     {
         affine_mat_registers old_registers(affine_mat_attributes);
-        affine_mat_attributes.set_rotation_angle(rotation_angle);
+        affine_mat_key mat_key(affine_mat_attributes.mat_attributes());
+        mat_key.rotation_angle = rotation_angle;
+
+        if(! _set_shared_mat_attributes(*item, mat_key))
+        {
+            affine_mat_attributes.set_rotation_angle(rotation_angle);
+        }
 
         if(affine_mat_registers(affine_mat_attributes) != old_registers)
         {
@@ -943,7 +1230,13 @@ void set_horizontal_scale(id_type id, fixed horizontal_scale)
     {
         int pa = affine_mat_attributes.pa_register_value();
         int pb = affine_mat_attributes.pb_register_value();
-        affine_mat_attributes.set_horizontal_scale(horizontal_scale);
+        affine_mat_key mat_key(affine_mat_attributes.mat_attributes());
+        mat_key.horizontal_scale = horizontal_scale;
+
+        if(! _set_shared_mat_attributes(*item, mat_key))
+        {
+            affine_mat_attributes.set_horizontal_scale(horizontal_scale);
+        }
 
         if(affine_mat_attributes.pa_register_value() != pa || affine_mat_attributes.pb_register_value() != pb)
         {
@@ -968,7 +1261,13 @@ void set_vertical_scale(id_type id, fixed vertical_scale)
     {
         int pc = affine_mat_attributes.pc_register_value();
         int pd = affine_mat_attributes.pd_register_value();
-        affine_mat_attributes.set_vertical_scale(vertical_scale);
+        affine_mat_key mat_key(affine_mat_attributes.mat_attributes());
+        mat_key.vertical_scale = vertical_scale;
+
+        if(! _set_shared_mat_attributes(*item, mat_key))
+        {
+            affine_mat_attributes.set_vertical_scale(vertical_scale);
+        }
 
         if(affine_mat_attributes.pc_register_value() != pc || affine_mat_attributes.pd_register_value() != pd)
         {
@@ -986,7 +1285,14 @@ void set_scale(id_type id, fixed scale)
     if(scale != affine_mat_attributes.horizontal_scale() || scale != affine_mat_attributes.vertical_scale())
     {
         affine_mat_registers old_registers(affine_mat_attributes);
-        affine_mat_attributes.set_scale(scale);
+        affine_mat_key mat_key(affine_mat_attributes.mat_attributes());
+        mat_key.horizontal_scale = scale;
+        mat_key.vertical_scale = scale;
+
+        if(! _set_shared_mat_attributes(*item, mat_key))
+        {
+            affine_mat_attributes.set_scale(scale);
+        }
 
         if(affine_mat_registers(affine_mat_attributes) != old_registers)
         {
@@ -1005,7 +1311,14 @@ void set_scale(id_type id, fixed horizontal_scale, fixed vertical_scale)
             vertical_scale != affine_mat_attributes.vertical_scale())
     {
         affine_mat_registers old_registers(affine_mat_attributes);
-        affine_mat_attributes.set_scale(horizontal_scale, vertical_scale);
+        affine_mat_key mat_key(affine_mat_attributes.mat_attributes());
+        mat_key.horizontal_scale = horizontal_scale;
+        mat_key.vertical_scale = vertical_scale;
+
+        if(! _set_shared_mat_attributes(*item, mat_key))
+        {
+            affine_mat_attributes.set_scale(horizontal_scale, vertical_scale);
+        }
 
         if(affine_mat_registers(affine_mat_attributes) != old_registers)
         {
@@ -1492,11 +1805,11 @@ void remove_camera(id_type id)
     }
 }
 
-void update_cameras()
+void update_camera(int camera_id)
 {
     for(item_type* item : data.items_vector)
     {
-        if(item->camera)
+        if(item->camera && item->camera->id() == camera_id)
         {
             if(item->regular_map)
             {
@@ -1556,7 +1869,7 @@ void update_regular_map_palette_bpp(int map_id, bpp_mode bpp)
 
 void reload()
 {
-    data.commit = true;
+    _set_all_registers_dirty();
 }
 
 void fill_hblank_effect_regular_positions(int base_position, const fixed* positions_ptr, uint16_t* dest_ptr)
@@ -1655,16 +1968,34 @@ void fill_hblank_effect_affine_attributes(id_type id, const affine_bg_attributes
 
 void update()
 {
+    if(bg_blocks_manager::batch_updated())
+    {
+        data.rebuild_handles = true;
+    }
+
     _rebuild_handles();
     _update_big_maps();
 }
 
+bool must_commit()
+{
+    return data.commit;
+}
+
 void commit()
 {
     if(data.commit)
     {
-        hw::bgs::commit(data.handles);
         data.commit = false;
+
+        for(int id = 0; id < hw::bgs::count(); ++id)
+        {
+            if(int dirty_registers = data.dirty_registers[id])
+            {
+                data.dirty_registers[id] = 0;
+                _commit_registers(id, dirty_registers);
+            }
+        }
     }
 }
 
@@ -1691,16 +2022,26 @@ void commit_big_maps()
                 if(item_regular_map)
                 {
                     bg_blocks_manager::set_regular_map_position(map_handle, new_map_x, new_map_y);
+
+                    #if BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+                        item->big_map_first_row = uint16_t(new_map_y);
+                        item->big_map_last_row = uint16_t(new_map_y + 21);
+                    #endif
                 }
                 else
                 {
-                    bg_blocks_manager::set_affine_map_position(map_handle, new_map_x, new_map_y);
+                    int map_rows = item->big_map_transformed ? 32 : 22;
+                    bg_blocks_manager::set_affine_map_position(map_handle, new_map_x, new_map_y, map_rows);
                 }
             }
             else
             {
                 if(item_regular_map)
                 {
+                    #if BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+                        bool columns_updated = new_map_x != old_map_x;
+                    #endif
+
                     while(new_map_x < old_map_x)
                     {
                         --old_map_x;
@@ -1713,20 +2054,34 @@ void commit_big_maps()
                         bg_blocks_manager::update_regular_map_col(map_handle, old_map_x + 31, new_map_y);
                     }
 
-                    while(new_map_y < old_map_y)
-                    {
-                        --old_map_y;
-                        bg_blocks_manager::update_regular_map_row(map_handle, new_map_x, old_map_y);
-                    }
-
-                    while(new_map_y > old_map_y)
-                    {
-                        ++old_map_y;
-                        bg_blocks_manager::update_regular_map_row(map_handle, new_map_x, old_map_y + 21);
-                    }
+                    #if BN_CFG_BGS_BIG_MAPS_LOOK_AHEAD_ROWS
+                        // Columns are copied from new_map_y, so they overwrite the rows outside of
+                        // [new_map_y..new_map_y + 31], and rows should have been copied before V-Blank:
+                        if(columns_updated)
+                        {
+                            item->big_map_first_row = uint16_t(max(int(item->big_map_first_row), new_map_y));
+                            item->big_map_last_row = uint16_t(min(int(item->big_map_last_row), new_map_y + 31));
+                        }
+
+                        _update_regular_big_map_rows(*item, map_handle, new_map_x, new_map_y, new_map_y + 21);
+                    #else
+                        while(new_map_y < old_map_y)
+                        {
+                            --old_map_y;
+                            bg_blocks_manager::update_regular_map_row(map_handle, new_map_x, old_map_y);
+                        }
+
+                        while(new_map_y > old_map_y)
+                        {
+                            ++old_map_y;
+                            bg_blocks_manager::update_regular_map_row(map_handle, new_map_x, old_map_y + 21);
+                        }
+                    #endif
                 }
                 else
                 {
+                    int last_map_row = item->big_map_transformed ? 31 : 21;
+
                     while(new_map_x < old_map_x)
                     {
                         --old_map_x;
@@ -1748,7 +2103,7 @@ void commit_big_maps()
                     while(new_map_y > old_map_y)
                     {
                         ++old_map_y;
-                        bg_blocks_manager::update_affine_map_row(map_handle, new_map_x, old_map_y + 21);
+                        bg_blocks_manager::update_affine_map_row(map_handle, new_map_x, old_map_y + last_map_row);
                     }
                 }
             }
@@ -1760,6 +2115,12 @@ void stop()
 {
     data.rebuild_handles = false;
     data.commit = false;
+
+    for(uint8_t& dirty_registers : data.dirty_registers)
+    {
+        dirty_registers = 0;
+    }
+
     hw::bgs::stop();
 }
 
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_bitmap_bg.h"
+
+#include "bn_bitmap_bg_manager.h"
+
+namespace bn::bitmap_bg
+{
+
+bool active()
+{
+    return bitmap_bg_manager::active();
+}
+
+void start()
+{
+    bitmap_bg_manager::start();
+}
+
+void stop()
+{
+    bitmap_bg_manager::stop();
+}
+
+int dirty_pixels_count()
+{
+    return bitmap_bg_manager::dirty_pixels_count();
+}
+
+void fill(int color_index)
+{
+    bitmap_bg_manager::fill(color_index);
+}
+
+void fill_rect(const point& top_left, const size& dimensions, int color_index)
+{
+    bitmap_bg_manager::fill_rect(top_left, dimensions, color_index);
+}
+
+void copy_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions, const point& top_left)
+{
+    bitmap_bg_manager::copy_rect(pixels_ref, pixels_dimensions, top_left);
+}
+
+void copy_masked_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions,
+                      const point& top_left)
+{
+    bitmap_bg_manager::copy_masked_rect(pixels_ref, pixels_dimensions, top_left);
+}
+
+void draw_line(const point& a, const point& b, int color_index)
+{
+    bitmap_bg_manager::draw_line(a, b, color_index);
+}
+
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_bitmap_bg_manager.h"
+
+#include "bn_size.h"
+#include "bn_span.h"
+#include "bn_point.h"
+#include "bn_config_bgs.h"
+#include "bn_display_manager.h"
+#include "bn_bg_blocks_manager.h"
+#include "../hw/include/bn_hw_bitmap_bg.h"
+
+#include "bn_bitmap_bg.cpp.h"
+
+namespace bn::bitmap_bg_manager
+{
+
+namespace
+{
+    static_assert(bitmap_bg::width() == hw::bitmap_bg::width());
+    static_assert(bitmap_bg::height() == hw::bitmap_bg::height());
+
+
+    class dirty_rect
+    {
+
+    public:
+        int first_x = hw::bitmap_bg::width();
+        int first_y = hw::bitmap_bg::height();
+        int last_x = 0;
+        int last_y = 0;
+
+        [[nodiscard]] bool empty() const
+        {
+            return last_x <= first_x;
+        }
+
+        [[nodiscard]] int pixels_count() const
+        {
+            return empty() ? 0 : (last_x - first_x) * (last_y - first_y);
+        }
+
+        void add(int x, int y, int width, int height)
+        {
+            first_x = min(first_x, x);
+            first_y = min(first_y, y);
+            last_x = max(last_x, x + width);
+            last_y = max(last_y, y + height);
+        }
+
+        void clear()
+        {
+            *this = dirty_rect();
+        }
+    };
+
+
+    class static_data
+    {
+
+    public:
+        dirty_rect dirty;
+        dirty_rect sync;
+        int back_page = 1;
+        bool active = false;
+    };
+
+    BN_DATA_EWRAM static_data data;
+
+
+    [[nodiscard]] uint16_t* _back_page_ptr()
+    {
+        BN_ASSERT(data.active, "Bitmap BG is not active");
+
+        uint16_t* result = hw::bitmap_bg::page(data.back_page);
+        dirty_rect& sync = data.sync;
+
+        // The pixels drawn in the last frame are copied to the back page before drawing new ones:
+        if(! sync.empty())
+        {
+            hw::bitmap_bg::copy_page_rect(hw::bitmap_bg::page(1 - data.back_page), sync.first_x, sync.first_y,
+                                          sync.last_x - sync.first_x, sync.last_y - sync.first_y, result);
+            sync.clear();
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] bool _clip(const point& top_left, const size& dimensions, int& x, int& y, int& width, int& height,
+                             int& source_x, int& source_y)
+    {
+        x = top_left.x();
+        y = top_left.y();
+        width = dimensions.width();
+        height = dimensions.height();
+        source_x = 0;
+        source_y = 0;
+
+        if(x < 0)
+        {
+            source_x = -x;
+            width += x;
+            x = 0;
+        }
+
+        if(y < 0)
+        {
+            source_y = -y;
+            height += y;
+            y = 0;
+        }
+
+        width = min(width, hw::bitmap_bg::width() - x);
+        height = min(height, hw::bitmap_bg::height() - y);
+        return width > 0 && height > 0;
+    }
+
+    void _copy_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions, const point& top_left,
+                    bool masked)
+    {
+        int source_pitch = pixels_dimensions.width();
+        BN_ASSERT(source_pitch >= 0 && pixels_dimensions.height() >= 0, "Invalid pixels dimensions: ",
+                  source_pitch, " - ", pixels_dimensions.height());
+        BN_ASSERT(pixels_ref.size() >= source_pitch * pixels_dimensions.height(), "Invalid pixels count: ",
+                  pixels_ref.size(), " - ", source_pitch * pixels_dimensions.height());
+
+        int x, y, width, height, source_x, source_y;
+
+        if(_clip(top_left, pixels_dimensions, x, y, width, height, source_x, source_y))
+        {
+            uint16_t* page_ptr = _back_page_ptr();
+            const uint8_t* source_ptr = pixels_ref.data() + (source_y * source_pitch) + source_x;
+
+            if(masked)
+            {
+                hw::bitmap_bg::copy_masked_rect(source_ptr, source_pitch, x, y, width, height, page_ptr);
+            }
+            else
+            {
+                hw::bitmap_bg::copy_rect(source_ptr, source_pitch, x, y, width, height, page_ptr);
+            }
+
+            data.dirty.add(x, y, width, height);
+        }
+    }
+}
+
+bool active()
+{
+    return data.active;
+}
+
+void start()
+{
+    #if BN_CFG_BGS_BITMAP_ENABLED
+        BN_ASSERT(! data.active, "Bitmap BG is already active");
+        BN_ASSERT(! bg_blocks_manager::used_tile_blocks_count() && ! bg_blocks_manager::used_map_blocks_count(),
+                  "There are BG tiles or maps in VRAM");
+
+        for(int page = 0; page < 2; ++page)
+        {
+            hw::bitmap_bg::fill_rect(0, 0, hw::bitmap_bg::width(), hw::bitmap_bg::height(), 0,
+                                     hw::bitmap_bg::page(page));
+        }
+
+        data.dirty.clear();
+        data.sync.clear();
+        data.back_page = 1;
+        data.active = true;
+        display_manager::set_bitmap_page(0);
+    #else
+        BN_ERROR("Bitmap BG is not enabled");
+    #endif
+}
+
+void stop()
+{
+    if(data.active)
+    {
+        data.active = false;
+        display_manager::set_bitmap_page(-1);
+    }
+}
+
+int dirty_pixels_count()
+{
+    return data.dirty.pixels_count();
+}
+
+void fill(int color_index)
+{
+    // The pixels drawn in the last frame are overwritten, so they don't need to be copied:
+    data.sync.clear();
+
+    hw::bitmap_bg::fill_rect(0, 0, hw::bitmap_bg::width(), hw::bitmap_bg::height(), color_index,
+                             _back_page_ptr());
+    data.dirty.add(0, 0, hw::bitmap_bg::width(), hw::bitmap_bg::height());
+}
+
+void fill_rect(const point& top_left, const size& dimensions, int color_index)
+{
+    int x, y, width, height, source_x, source_y;
+
+    if(_clip(top_left, dimensions, x, y, width, height, source_x, source_y))
+    {
+        hw::bitmap_bg::fill_rect(x, y, width, height, color_index, _back_page_ptr());
+        data.dirty.add(x, y, width, height);
+    }
+}
+
+void copy_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions, const point& top_left)
+{
+    _copy_rect(pixels_ref, pixels_dimensions, top_left, false);
+}
+
+void copy_masked_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions,
+                      const point& top_left)
+{
+    _copy_rect(pixels_ref, pixels_dimensions, top_left, true);
+}
+
+void draw_line(const point& a, const point& b, int color_index)
+{
+    int ax = a.x();
+    int ay = a.y();
+    int bx = b.x();
+    int by = b.y();
+    BN_ASSERT(ax >= 0 && ax < hw::bitmap_bg::width() && ay >= 0 && ay < hw::bitmap_bg::height(),
+              "Invalid first point: ", ax, " - ", ay);
+    BN_ASSERT(bx >= 0 && bx < hw::bitmap_bg::width() && by >= 0 && by < hw::bitmap_bg::height(),
+              "Invalid second point: ", bx, " - ", by);
+
+    hw::bitmap_bg::draw_line(ax, ay, bx, by, color_index, _back_page_ptr());
+
+    int first_x = min(ax, bx);
+    int first_y = min(ay, by);
+    data.dirty.add(first_x, first_y, max(ax, bx) - first_x + 1, max(ay, by) - first_y + 1);
+}
+
+void update()
+{
+    if(data.active)
+    {
+        dirty_rect& dirty = data.dirty;
+
+        if(! dirty.empty())
+        {
+            // The back page is shown in the next V-Blank, and the new back page lacks the pixels drawn on it:
+            display_manager::set_bitmap_page(data.back_page);
+            data.back_page = 1 - data.back_page;
+            data.sync = dirty;
+            dirty.clear();
+        }
+    }
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_BITMAP_BG_MANAGER_H
+#define BN_BITMAP_BG_MANAGER_H
+
+#include "bn_span_fwd.h"
+
+namespace bn
+{
+    class size;
+    class point;
+}
+
+namespace bn::bitmap_bg_manager
+{
+    [[nodiscard]] bool active();
+
+    void start();
+
+    void stop();
+
+    [[nodiscard]] int dirty_pixels_count();
+
+    void fill(int color_index);
+
+    void fill_rect(const point& top_left, const size& dimensions, int color_index);
+
+    void copy_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions, const point& top_left);
+
+    void copy_masked_rect(const span<const uint8_t>& pixels_ref, const size& pixels_dimensions,
+                          const point& top_left);
+
+    void draw_line(const point& a, const point& b, int color_index);
+
+    void update();
+}
+
+#endif
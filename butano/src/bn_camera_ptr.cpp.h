@@ -107,6 +107,31 @@ void camera_ptr::set_position(const fixed_point& position)
     cameras_manager::set_position(_id, position);
 }
 
+const fixed_point& camera_ptr::velocity() const
+{
+    return cameras_manager::velocity(_id);
+}
+
+void camera_ptr::set_velocity(const fixed_point& velocity)
+{
+    cameras_manager::set_velocity(_id, velocity);
+}
+
+const fixed_point& camera_ptr::acceleration() const
+{
+    return cameras_manager::acceleration(_id);
+}
+
+void camera_ptr::set_acceleration(const fixed_point& acceleration)
+{
+    cameras_manager::set_acceleration(_id, acceleration);
+}
+
+fixed_point camera_ptr::predicted_position(int frames) const
+{
+    return cameras_manager::predicted_position(_id, frames);
+}
+
 void camera_ptr::_destroy()
 {
     cameras_manager::decrease_usages(_id);
@@ -29,7 +29,10 @@ namespace
 
     public:
         fixed_point position;
+        fixed_point velocity;
+        fixed_point acceleration;
         unsigned usages = 0;
+        bool updated = false;
     };
 
 
@@ -39,10 +42,20 @@ namespace
     public:
         item_type items[max_items];
         vector<int8_t, max_items> free_item_indexes;
-        bool update = false;
+        vector<int8_t, max_items> updated_item_indexes;
     };
 
     BN_DATA_EWRAM static_data data;
+
+
+    void _set_updated(int id, item_type& item)
+    {
+        if(! item.updated)
+        {
+            item.updated = true;
+            data.updated_item_indexes.push_back(int8_t(id));
+        }
+    }
 }
 
 void init()
@@ -72,6 +85,8 @@ int create(const fixed_point& position)
 
     item_type& new_item = data.items[item_index];
     new_item.position = position;
+    new_item.velocity = fixed_point();
+    new_item.acceleration = fixed_point();
     new_item.usages = 1;
     return item_index;
 }
@@ -88,6 +103,8 @@ int create_optional(const fixed_point& position)
 
     item_type& new_item = data.items[item_index];
     new_item.position = position;
+    new_item.velocity = fixed_point();
+    new_item.acceleration = fixed_point();
     new_item.usages = 1;
     return item_index;
 }
@@ -122,7 +139,7 @@ void set_x(int id, fixed x)
     if(item.position.x() != x)
     {
         item.position.set_x(x);
-        data.update = true;
+        _set_updated(id, item);
     }
 }
 
@@ -133,7 +150,7 @@ void set_y(int id, fixed y)
     if(item.position.y() != y)
     {
         item.position.set_y(y);
-        data.update = true;
+        _set_updated(id, item);
     }
 }
 
@@ -144,20 +161,56 @@ void set_position(int id, const fixed_point& position)
     if(item.position != position)
     {
         item.position = position;
-        data.update = true;
+        _set_updated(id, item);
     }
 }
 
+const fixed_point& velocity(int id)
+{
+    const item_type& item = data.items[id];
+    return item.velocity;
+}
+
+void set_velocity(int id, const fixed_point& velocity)
+{
+    item_type& item = data.items[id];
+    item.velocity = velocity;
+}
+
+const fixed_point& acceleration(int id)
+{
+    const item_type& item = data.items[id];
+    return item.acceleration;
+}
+
+void set_acceleration(int id, const fixed_point& acceleration)
+{
+    item_type& item = data.items[id];
+    item.acceleration = acceleration;
+}
+
+fixed_point predicted_position(int id, int frames)
+{
+    BN_ASSERT(frames >= 0, "Invalid frames: ", frames);
+
+    // Velocity is increased by acceleration before moving each frame:
+    const item_type& item = data.items[id];
+    int acceleration_frames = (frames * (frames + 1)) / 2;
+    return item.position + (item.velocity * frames) + (item.acceleration * acceleration_frames);
+}
+
 void update()
 {
-    if(data.update)
+    // Only the items attached to the moved cameras are updated:
+    for(int8_t item_index : data.updated_item_indexes)
     {
-        data.update = false;
-
-        display_manager::update_cameras();
-        sprites_manager::update_cameras();
-        bgs_manager::update_cameras();
+        data.items[item_index].updated = false;
+        display_manager::update_camera(item_index);
+        sprites_manager::update_camera(item_index);
+        bgs_manager::update_camera(item_index);
     }
+
+    data.updated_item_indexes.clear();
 }
 
 }
@@ -38,6 +38,16 @@ namespace bn::cameras_manager
 
     void set_position(int id, const fixed_point& position);
 
+    [[nodiscard]] const fixed_point& velocity(int id);
+
+    void set_velocity(int id, const fixed_point& velocity);
+
+    [[nodiscard]] const fixed_point& acceleration(int id);
+
+    void set_acceleration(int id, const fixed_point& acceleration);
+
+    [[nodiscard]] fixed_point predicted_position(int id, int frames);
+
     void update();
 }
 
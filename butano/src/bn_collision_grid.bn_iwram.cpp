@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_collision_grid.h"
+
+namespace bn
+{
+
+namespace
+{
+    template<class Item>
+    [[nodiscard]] bool _intersects(const Item& item, int left, int top, int right, int bottom)
+    {
+        return item.left < right && item.right > left && item.top < bottom && item.bottom > top;
+    }
+
+    template<class Item>
+    [[nodiscard]] bool _intersects(const Item& a, const Item& b)
+    {
+        return _intersects(a, b.left, b.top, b.right, b.bottom);
+    }
+
+    [[nodiscard]] int64_t _side(int64_t dx, int64_t dy, int ax, int ay, int x, int y)
+    {
+        return (dx * (y - ay)) - (dy * (x - ax));
+    }
+}
+
+void icollision_grid::query_rect(const fixed_rect& rect, ivector<int>& ids) const
+{
+    int left = rect.left().data();
+    int top = rect.top().data();
+    int right = left + rect.width().data();
+    int bottom = top + rect.height().data();
+
+    // Items are stored in the cell of their top-left corner, so they can overlap the next column and row:
+    int first_column = max(_column(left) - 1, 0);
+    int last_column = _column(right);
+    int first_row = max(_row(top) - 1, 0);
+    int last_row = _row(bottom);
+    const item_type* items = _items;
+
+    for(int row = first_row; row <= last_row; ++row)
+    {
+        const int16_t* cells_row = _cells + (row * _columns);
+
+        for(int column = first_column; column <= last_column; ++column)
+        {
+            for(int id = cells_row[column]; id >= 0; id = items[id].next)
+            {
+                if(_intersects(items[id], left, top, right, bottom))
+                {
+                    ids.push_back(id);
+                }
+            }
+        }
+    }
+}
+
+void icollision_grid::query_segment(const fixed_point& a, const fixed_point& b, ivector<int>& ids) const
+{
+    int ax = a.x().data();
+    int ay = a.y().data();
+    int bx = b.x().data();
+    int by = b.y().data();
+    int left = min(ax, bx);
+    int top = min(ay, by);
+    int right = max(ax, bx);
+    int bottom = max(ay, by);
+    int64_t dx = bx - ax;
+    int64_t dy = by - ay;
+
+    int first_column = max(_column(left) - 1, 0);
+    int last_column = _column(right);
+    int first_row = max(_row(top) - 1, 0);
+    int last_row = _row(bottom);
+    const item_type* items = _items;
+
+    for(int row = first_row; row <= last_row; ++row)
+    {
+        const int16_t* cells_row = _cells + (row * _columns);
+
+        for(int column = first_column; column <= last_column; ++column)
+        {
+            for(int id = cells_row[column]; id >= 0; id = items[id].next)
+            {
+                const item_type& item = items[id];
+
+                // Segment bounding box test:
+                if(item.left <= right && item.right >= left && item.top <= bottom && item.bottom >= top)
+                {
+                    // The segment misses the item if all its corners are at the same side of the segment line:
+                    int64_t top_left = _side(dx, dy, ax, ay, item.left, item.top);
+                    int64_t top_right = _side(dx, dy, ax, ay, item.right, item.top);
+                    int64_t bottom_left = _side(dx, dy, ax, ay, item.left, item.bottom);
+                    int64_t bottom_right = _side(dx, dy, ax, ay, item.right, item.bottom);
+                    bool all_positive = top_left > 0 && top_right > 0 && bottom_left > 0 && bottom_right > 0;
+                    bool all_negative = top_left < 0 && top_right < 0 && bottom_left < 0 && bottom_right < 0;
+
+                    if(! all_positive && ! all_negative)
+                    {
+                        ids.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void icollision_grid::query_pairs(ivector<pair<int, int>>& pairs) const
+{
+    const item_type* items = _items;
+    const int16_t* cells = _cells;
+    int columns = _columns;
+    int rows = _rows;
+
+    for(int row = 0; row < rows; ++row)
+    {
+        const int16_t* cells_row = cells + (row * columns);
+        const int16_t* next_cells_row = row + 1 < rows ? cells_row + columns : nullptr;
+
+        for(int column = 0; column < columns; ++column)
+        {
+            for(int id = cells_row[column]; id >= 0; id = items[id].next)
+            {
+                const item_type& item = items[id];
+
+                // Only half of the neighbor cells are visited, so each pair is found once:
+                for(int other_id = item.next; other_id >= 0; other_id = items[other_id].next)
+                {
+                    if(_intersects(item, items[other_id]))
+                    {
+                        pairs.push_back(make_pair(id, other_id));
+                    }
+                }
+
+                if(column + 1 < columns)
+                {
+                    for(int other_id = cells_row[column + 1]; other_id >= 0; other_id = items[other_id].next)
+                    {
+                        if(_intersects(item, items[other_id]))
+                        {
+                            pairs.push_back(make_pair(id, other_id));
+                        }
+                    }
+                }
+
+                if(next_cells_row)
+                {
+                    int first_column = max(column - 1, 0);
+                    int last_column = min(column + 1, columns - 1);
+
+                    for(int other_column = first_column; other_column <= last_column; ++other_column)
+                    {
+                        for(int other_id = next_cells_row[other_column]; other_id >= 0;
+                            other_id = items[other_id].next)
+                        {
+                            if(_intersects(item, items[other_id]))
+                            {
+                                pairs.push_back(make_pair(id, other_id));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
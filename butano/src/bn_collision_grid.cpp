@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_collision_grid.h"
+
+namespace bn
+{
+
+fixed_rect icollision_grid::rect(int id) const
+{
+    BN_ASSERT(contains_id(id), "Invalid id: ", id);
+
+    const item_type& item = _items[id];
+    fixed width = fixed::from_data(item.right - item.left);
+    fixed height = fixed::from_data(item.bottom - item.top);
+    return fixed_rect(fixed::from_data(item.left) + (width / 2), fixed::from_data(item.top) + (height / 2),
+                      width, height);
+}
+
+bool icollision_grid::update(int id, const fixed_rect& rect)
+{
+    BN_ASSERT(contains_id(id), "Invalid id: ", id);
+
+    item_type& item = _items[id];
+    _set_rect(rect, item);
+
+    int cell = (_row(item.top) * _columns) + _column(item.left);
+
+    if(cell == item.cell)
+    {
+        return false;
+    }
+
+    _unlink(id);
+    _link(id, cell);
+    return true;
+}
+
+int icollision_grid::_add(const fixed_rect& rect)
+{
+    BN_ASSERT(! full(), "Collision grid is full");
+
+    int id = _first_free;
+    item_type& item = _items[id];
+    _first_free = item.next;
+    _set_rect(rect, item);
+    _link(id, (_row(item.top) * _columns) + _column(item.left));
+    ++_size;
+    return id;
+}
+
+void icollision_grid::_remove(int id)
+{
+    _unlink(id);
+
+    item_type& item = _items[id];
+    item.cell = -1;
+    item.next = int16_t(_first_free);
+    _first_free = id;
+    --_size;
+}
+
+void icollision_grid::_clear()
+{
+    for(int cell = 0, limit = _columns * _rows; cell < limit; ++cell)
+    {
+        _cells[cell] = -1;
+    }
+
+    for(int id = 0; id < _max_size; ++id)
+    {
+        item_type& item = _items[id];
+        item.cell = -1;
+        item.next = int16_t(id + 1 < _max_size ? id + 1 : -1);
+    }
+
+    _size = 0;
+    _first_free = 0;
+}
+
+void icollision_grid::_set_rect(const fixed_rect& rect, item_type& item) const
+{
+    [[maybe_unused]] int max_size = fixed(cell_size()).data();
+    int width = rect.width().data();
+    int height = rect.height().data();
+    BN_ASSERT(width >= 0 && width <= max_size, "Invalid width: ", rect.width(), " - ", cell_size());
+    BN_ASSERT(height >= 0 && height <= max_size, "Invalid height: ", rect.height(), " - ", cell_size());
+
+    item.left = rect.left().data();
+    item.top = rect.top().data();
+    item.right = item.left + width;
+    item.bottom = item.top + height;
+}
+
+void icollision_grid::_link(int id, int cell)
+{
+    item_type& item = _items[id];
+    int next = _cells[cell];
+    item.cell = int16_t(cell);
+    item.next = int16_t(next);
+    item.previous = -1;
+
+    if(next >= 0)
+    {
+        _items[next].previous = int16_t(id);
+    }
+
+    _cells[cell] = int16_t(id);
+}
+
+void icollision_grid::_unlink(int id)
+{
+    item_type& item = _items[id];
+    int next = item.next;
+    int previous = item.previous;
+
+    if(previous >= 0)
+    {
+        _items[previous].next = int16_t(next);
+    }
+    else
+    {
+        _cells[item.cell] = int16_t(next);
+    }
+
+    if(next >= 0)
+    {
+        _items[next].previous = int16_t(previous);
+    }
+}
+
+}
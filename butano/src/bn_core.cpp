@@ -10,9 +10,17 @@
 #include "bn_timer.h"
 #include "bn_string.h"
 #include "bn_keypad.h"
+#include "bn_deque.h"
 #include "bn_timers.h"
 #include "bn_profiler.h"
+#include "bn_raster_marks.h"
 #include "bn_string_view.h"
+#include "bn_vblank_stats.h"
+#include "bn_config_core.h"
+#include "bn_config_memory.h"
+#include "bn_config_sprites.h"
+#include "bn_nodes_manager.h"
+#include "bn_tasks_manager.h"
 #include "bn_bgs_manager.h"
 #include "bn_hdma_manager.h"
 #include "bn_link_manager.h"
@@ -24,7 +32,11 @@
 #include "bn_sprites_manager.h"
 #include "bn_cameras_manager.h"
 #include "bn_palettes_manager.h"
+#include "bn_bitmap_bg_manager.h"
+#include "bn_dmg_sound_manager.h"
+#include "bn_pcm_stream_manager.h"
 #include "bn_bg_blocks_manager.h"
+#include "bn_vram_queue_manager.h"
 #include "bn_sprite_tiles_manager.h"
 #include "bn_hblank_effects_manager.h"
 #include "../hw/include/bn_hw_irq.h"
@@ -34,38 +46,37 @@
 #include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_game_pak.h"
 
-#if BN_CFG_ASSERT_ENABLED
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED
     #include "bn_string_view.h"
 #endif
 
-#if BN_CFG_ASSERT_ENABLED || BN_CFG_PROFILER_ENABLED
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED || BN_CFG_PROFILER_ENABLED
     #include "../hw/include/bn_hw_show.h"
 #endif
 
+#if BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED
+    #include "bn_log.h"
+
+    static_assert(BN_CFG_LOG_ENABLED, "Log is not enabled");
+#endif
+
 #if BN_CFG_PROFILER_ENABLED && BN_CFG_PROFILER_LOG_ENGINE
-    #if BN_CFG_PROFILER_LOG_ENGINE_DETAILED
-        #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-            do \
-            { \
-            } while(false)
+    #define BN_PROFILER_ENGINE_GENERAL_START(id) \
+        BN_PROFILER_START(id)
 
-        #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-            do \
-            { \
-            } while(false)
+    #define BN_PROFILER_ENGINE_GENERAL_STOP() \
+        BN_PROFILER_STOP()
+
+    #define BN_PROFILER_ENGINE_GENERAL_ADD(id, ticks) \
+        _bn::profiler::add(id, _bn::profiler::id_hash(id), ticks)
 
+    #if BN_CFG_PROFILER_LOG_ENGINE_DETAILED
         #define BN_PROFILER_ENGINE_DETAILED_START(id) \
             BN_PROFILER_START(id)
 
         #define BN_PROFILER_ENGINE_DETAILED_STOP() \
             BN_PROFILER_STOP()
     #else
-        #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-            BN_PROFILER_START(id)
-
-        #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-            BN_PROFILER_STOP()
-
         #define BN_PROFILER_ENGINE_DETAILED_START(id) \
             do \
             { \
@@ -87,6 +98,11 @@
         { \
         } while(false)
 
+    #define BN_PROFILER_ENGINE_GENERAL_ADD(id, ticks) \
+        do \
+        { \
+        } while(false)
+
     #define BN_PROFILER_ENGINE_DETAILED_START(id) \
         do \
         { \
@@ -111,51 +127,167 @@ namespace
         int vblank_usage_ticks = 0;
     };
 
+    class idle_task
+    {
+
+    public:
+        idle_task_type task;
+        int max_ticks;
+    };
+
+    #if BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED
+        class replay_benchmark
+        {
+
+        public:
+            void update(const ticks& last_ticks, int update_frames)
+            {
+                if(keypad_manager::replaying())
+                {
+                    int cpu_usage_ticks = last_ticks.cpu_usage_ticks / update_frames;
+                    int vblank_usage_ticks = last_ticks.vblank_usage_ticks / update_frames;
+                    total_cpu_usage_ticks += cpu_usage_ticks;
+                    total_vblank_usage_ticks += vblank_usage_ticks;
+                    max_cpu_usage_ticks = max(max_cpu_usage_ticks, cpu_usage_ticks);
+                    max_vblank_usage_ticks = max(max_vblank_usage_ticks, vblank_usage_ticks);
+
+                    if(last_ticks.cpu_usage_ticks > timers::ticks_per_frame() * update_frames)
+                    {
+                        ++missed_updates;
+                    }
+
+                    ++updates;
+                }
+                else if(updates && ! finished)
+                {
+                    finished = true;
+                    _log();
+                }
+            }
+
+        private:
+            int64_t total_cpu_usage_ticks = 0;
+            int64_t total_vblank_usage_ticks = 0;
+            int max_cpu_usage_ticks = 0;
+            int max_vblank_usage_ticks = 0;
+            int missed_updates = 0;
+            int updates = 0;
+            bool finished = false;
+
+            void _log() const
+            {
+                int ticks_per_frame = timers::ticks_per_frame();
+                int ticks_per_vblank = timers::ticks_per_vblank();
+                fixed avg_cpu_usage = fixed(int(total_cpu_usage_ticks / updates)) / ticks_per_frame;
+                fixed max_cpu_usage = fixed(max_cpu_usage_ticks) / ticks_per_frame;
+                fixed avg_vblank_usage = fixed(int(total_vblank_usage_ticks / updates)) / ticks_per_vblank;
+                fixed max_vblank_usage = fixed(max_vblank_usage_ticks) / ticks_per_vblank;
+
+                BN_LOG("-- REPLAY BENCHMARK ---");
+                BN_LOG("updates: ", updates, " missed: ", missed_updates);
+                BN_LOG("cpu avg: ", avg_cpu_usage, " max: ", max_cpu_usage);
+                BN_LOG("vblank avg: ", avg_vblank_usage, " max: ", max_vblank_usage);
+
+                #if BN_CFG_PROFILER_ENABLED
+                    profiler::log_frames();
+                #endif
+
+                BN_LOG("-- REPLAY BENCHMARK END ---");
+            }
+        };
+    #endif
+
     class static_data
     {
 
     public:
+        deque<idle_task, BN_CFG_CORE_MAX_IDLE_TASKS> idle_tasks;
         timer cpu_usage_timer;
         ticks last_ticks;
+        vblank_stats last_vblank_stats;
+        int64_t fast_forward_ticks = 0;
+        int fast_forward_frames = 0;
         int skip_frames = 0;
+        int max_adaptive_skip_frames = 0;
         int last_update_frames = 1;
+        int init_ticks = 0;
         bool slow_game_pak = false;
         bool restart_cpu_usage_timer = false;
+        bool vblank_commit = false;
+        bool sprites_commit = false;
+        bool fast_forward = false;
+
+        #if BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED
+            replay_benchmark benchmark;
+        #endif
     };
 
     BN_DATA_EWRAM static_data data;
 
     void hp_vblank_function()
     {
+        pcm_stream_manager::vblank();
+
         if(data.restart_cpu_usage_timer)
         {
             data.cpu_usage_timer.restart();
 
+            #if BN_CFG_SPRITES_EARLY_COMMIT_ENABLED
+                // OAM is written before anything else, so it is ready as soon as possible:
+                if(data.sprites_commit)
+                {
+                    BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
+                    sprites_manager::commit();
+                    BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                    data.sprites_commit = false;
+                }
+            #endif
+
+            #if BN_CFG_CORE_NESTED_IRQS_ENABLED
+                // Link IRQs use the serial and the timer 1 IRQs:
+                unsigned ie = hw::irq::enable_nested(hw::irq::mask(hw::irq::id::HBLANK) |
+                                                     hw::irq::mask(hw::irq::id::SERIAL) |
+                                                     hw::irq::mask(hw::irq::id::TIMER1));
+            #endif
+
             hdma_manager::update();
             audio_manager::update();
 
             BN_PROFILER_ENGINE_GENERAL_START("eng_commit");
 
-            BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
-            display_manager::commit();
-            BN_PROFILER_ENGINE_DETAILED_STOP();
+            // Static frames skip the whole commit sequence:
+            if(data.vblank_commit)
+            {
+                BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
+                display_manager::commit();
+                BN_PROFILER_ENGINE_DETAILED_STOP();
 
-            BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
-            sprites_manager::commit();
-            BN_PROFILER_ENGINE_DETAILED_STOP();
+                #if ! BN_CFG_SPRITES_EARLY_COMMIT_ENABLED
+                    BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
+                    sprites_manager::commit();
+                    BN_PROFILER_ENGINE_DETAILED_STOP();
+                #endif
 
-            BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
-            bgs_manager::commit();
-            BN_PROFILER_ENGINE_DETAILED_STOP();
+                BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
+                bgs_manager::commit();
+                BN_PROFILER_ENGINE_DETAILED_STOP();
 
-            BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
-            palettes_manager::commit();
-            BN_PROFILER_ENGINE_DETAILED_STOP();
+                BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
+                palettes_manager::commit();
+                BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                data.vblank_commit = false;
+            }
 
             BN_PROFILER_ENGINE_DETAILED_START("eng_hdma_commit");
             hdma_manager::commit();
             BN_PROFILER_ENGINE_DETAILED_STOP();
 
+            #if BN_CFG_CORE_NESTED_IRQS_ENABLED
+                hw::irq::disable_nested(ie);
+            #endif
+
             data.restart_cpu_usage_timer = false;
         }
         else
@@ -187,7 +319,9 @@ namespace
 
     void stop(bool disable_audio)
     {
+        pcm_stream_manager::force_stop();
         audio_manager::stop();
+        dmg_sound_manager::stop();
 
         if(disable_audio)
         {
@@ -208,12 +342,63 @@ namespace
         disable(disable_audio);
     }
 
+    void run_idle_tasks()
+    {
+        int ticks_per_frame = timers::ticks_per_frame();
+
+        while(! data.idle_tasks.empty())
+        {
+            idle_task task = data.idle_tasks.front();
+
+            if(data.cpu_usage_timer.elapsed_ticks() + task.max_ticks > ticks_per_frame)
+            {
+                break;
+            }
+
+            data.idle_tasks.pop_front();
+            task.task();
+        }
+    }
+
+    void fast_forward_update_impl(ticks& result)
+    {
+        // The frame ends here instead of in the V-Blank handler, so the CPU usage timer is restarted manually:
+        data.fast_forward_ticks += data.cpu_usage_timer.elapsed_ticks();
+        ++data.fast_forward_frames;
+        data.cpu_usage_timer.restart();
+
+        // Registers are not committed, but VRAM commit queues are flushed, since they have a limited capacity:
+        hblank_effects_manager::commit();
+
+        int sprite_tiles_bytes = sprite_tiles_manager::commit();
+        bgs_manager::commit_big_maps();
+
+        int bg_blocks_bytes = bg_blocks_manager::commit();
+        int vram_queue_bytes = vram_queue_manager::commit(sprite_tiles_bytes + bg_blocks_bytes);
+        result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+
+        // Audio commands are executed, but the mixer is not run since the audio commit is skipped:
+        audio_manager::update();
+        gpio_manager::commit();
+        keypad_manager::update();
+
+        data.last_vblank_stats = vblank_stats(0, 0, 0, sprite_tiles_bytes, 0, 0, bg_blocks_bytes, 0, vram_queue_bytes,
+                                              0, 0);
+    }
+
     [[nodiscard]] ticks update_impl()
     {
         ticks result;
 
+        // The audio mixer runs in the V-Blank, so its last cost is reported as an independent entry:
+        BN_PROFILER_ENGINE_GENERAL_ADD("eng_audio_mixer", audio_manager::mixer_ticks());
+
         BN_PROFILER_ENGINE_GENERAL_START("eng_update");
 
+        BN_PROFILER_ENGINE_DETAILED_START("eng_nodes_update");
+        nodes_manager::update();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_cameras_update");
         cameras_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
@@ -238,6 +423,10 @@ namespace
         palettes_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        BN_PROFILER_ENGINE_DETAILED_START("eng_bitmap_bg_update");
+        bitmap_bg_manager::update();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_display_update");
         display_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
@@ -246,37 +435,73 @@ namespace
         hblank_effects_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        BN_PROFILER_ENGINE_DETAILED_START("eng_pcm_stream_update");
+        pcm_stream_manager::update();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+
         BN_PROFILER_ENGINE_GENERAL_STOP();
 
         result.cpu_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+
+        BN_PROFILER_ENGINE_DETAILED_START("eng_idle_tasks");
+        run_idle_tasks();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+
+        if(data.fast_forward)
+        {
+            fast_forward_update_impl(result);
+            return result;
+        }
+
+        data.sprites_commit = sprites_manager::must_commit();
+        data.vblank_commit = display_manager::must_commit() || data.sprites_commit ||
+                bgs_manager::must_commit() || palettes_manager::must_commit();
         data.restart_cpu_usage_timer = true;
 
         hw::core::wait_for_vblank();
 
+        const timer& vblank_timer = data.cpu_usage_timer;
+        int vblank_handler_ticks = vblank_timer.elapsed_ticks();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
         hblank_effects_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        int hblank_effects_ticks = vblank_timer.elapsed_ticks();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_commit");
-        sprite_tiles_manager::commit();
+        int sprite_tiles_bytes = sprite_tiles_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        int sprite_tiles_ticks = vblank_timer.elapsed_ticks();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_big_maps_commit");
         bgs_manager::commit_big_maps();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        int big_maps_ticks = vblank_timer.elapsed_ticks();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_commit");
-        bg_blocks_manager::commit();
+        int bg_blocks_bytes = bg_blocks_manager::commit();
+        BN_PROFILER_ENGINE_DETAILED_STOP();
+
+        int bg_blocks_ticks = vblank_timer.elapsed_ticks();
+
+        BN_PROFILER_ENGINE_DETAILED_START("eng_vram_queue_commit");
+        int vram_queue_bytes = vram_queue_manager::commit(sprite_tiles_bytes + bg_blocks_bytes);
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_cpu_usage");
-        result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+        result.vblank_usage_ticks = vblank_timer.elapsed_ticks();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
         BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commit");
         audio_manager::commit();
+        dmg_sound_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        int audio_ticks = vblank_timer.elapsed_ticks();
+
         BN_PROFILER_ENGINE_DETAILED_START("eng_gpio_commit");
         gpio_manager::commit();
         BN_PROFILER_ENGINE_DETAILED_STOP();
@@ -285,10 +510,68 @@ namespace
         keypad_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
 
+        int gpio_keypad_ticks = vblank_timer.elapsed_ticks();
+
+        // Each step ticks are obtained from the elapsed ticks since the start of the V-Blank:
+        int vram_queue_ticks = result.vblank_usage_ticks;
+        data.last_vblank_stats = vblank_stats(
+                    vblank_handler_ticks, hblank_effects_ticks - vblank_handler_ticks,
+                    sprite_tiles_ticks - hblank_effects_ticks, sprite_tiles_bytes, big_maps_ticks - sprite_tiles_ticks,
+                    bg_blocks_ticks - big_maps_ticks, bg_blocks_bytes, vram_queue_ticks - bg_blocks_ticks,
+                    vram_queue_bytes, audio_ticks - vram_queue_ticks, gpio_keypad_ticks - audio_ticks);
+
         BN_PROFILER_ENGINE_GENERAL_STOP();
 
         return result;
     }
+
+    void init_impl(const string_view& keypad_commands, const span<const uint16_t>& keypad_runs)
+    {
+        // Init timer system first, so the boot time can be measured:
+        hw::timer::init();
+
+        // Init storage systems:
+        data.slow_game_pak = hw::game_pak::init();
+        hw::memory::init();
+        hw::sram::init();
+
+        // Init display:
+        display_manager::init();
+
+        // Init irq system:
+        hw::irq::init();
+
+        // Init H-Blank effects system:
+        hblank_effects_manager::init();
+
+        // Init audio system:
+        audio_manager::init(hp_vblank_function, link_manager::commit);
+
+        // Init high level systems:
+        memory_manager::init();
+        cameras_manager::init();
+        sprite_tiles_manager::init();
+        sprites_manager::init();
+        bg_blocks_manager::init();
+        keypad_manager::init(keypad_commands, keypad_runs);
+
+        // WTF hack (if it isn't present and flto is enabled, sometimes everything crash):
+        string<32> hack_string;
+        ostringstream hack_string_stream(hack_string);
+        hack_string_stream.append(2);
+
+        data.init_ticks = int(hw::timer::ticks());
+        data.cpu_usage_timer.restart();
+
+        // First update:
+        update();
+
+        // Keypad polling fix:
+        keypad_manager::update();
+
+        // Reset profiler:
+        BN_PROFILER_RESET();
+    }
 }
 
 void init()
@@ -298,67 +581,86 @@ void init()
 
 void init(const string_view& keypad_commands)
 {
-    // Init storage systems:
-    data.slow_game_pak = hw::game_pak::init();
-    hw::memory::init();
-    hw::sram::init();
+    init_impl(keypad_commands, span<const uint16_t>());
+}
 
-    // Init display:
-    display_manager::init();
+void init(const span<const uint16_t>& keypad_runs)
+{
+    init_impl(string_view(), keypad_runs);
+}
 
-    // Init irq system:
-    hw::irq::init();
+int skip_frames()
+{
+    return data.skip_frames;
+}
 
-    // Init H-Blank effects system:
-    hblank_effects_manager::init();
+void set_skip_frames(int skip_frames)
+{
+    BN_ASSERT(skip_frames >= 0, "Invalid skip frames: ", skip_frames);
 
-    // Init audio system:
-    audio_manager::init(hp_vblank_function, link_manager::commit);
+    data.skip_frames = skip_frames;
+}
 
-    // Init link system:
-    link_manager::init();
+bool fast_forward_enabled()
+{
+    return data.fast_forward;
+}
 
-    // Init high level systems:
-    memory_manager::init();
-    cameras_manager::init();
-    sprite_tiles_manager::init();
-    sprites_manager::init();
-    bg_blocks_manager::init();
-    keypad_manager::init(keypad_commands);
+void set_fast_forward_enabled(bool enabled)
+{
+    if(enabled != data.fast_forward)
+    {
+        data.fast_forward = enabled;
+        data.fast_forward_ticks = 0;
+        data.fast_forward_frames = 0;
 
-    // WTF hack (if it isn't present and flto is enabled, sometimes everything crash):
-    string<32> hack_string;
-    ostringstream hack_string_stream(hack_string);
-    hack_string_stream.append(2);
+        if(enabled)
+        {
+            data.cpu_usage_timer.restart();
+        }
+    }
+}
 
-    // Init timer system:
-    hw::timer::init();
-    data.cpu_usage_timer.restart();
+int fast_forward_frames()
+{
+    return data.fast_forward_frames;
+}
 
-    // First update:
-    update();
+int fast_forward_frames_per_second()
+{
+    int64_t microseconds = timers::ticks_to_microseconds(data.fast_forward_ticks);
 
-    // Keypad polling fix:
-    keypad_manager::update();
+    if(microseconds <= 0)
+    {
+        return 0;
+    }
 
-    // Reset profiler:
-    BN_PROFILER_RESET();
+    return int((int64_t(data.fast_forward_frames) * 1000000) / microseconds);
 }
 
-int skip_frames()
+int max_adaptive_skip_frames()
 {
-    return data.skip_frames;
+    return data.max_adaptive_skip_frames;
 }
 
-void set_skip_frames(int skip_frames)
+void set_max_adaptive_skip_frames(int max_adaptive_skip_frames)
 {
-    BN_ASSERT(skip_frames >= 0, "Invalid skip frames: ", skip_frames);
+    BN_ASSERT(max_adaptive_skip_frames >= 0, "Invalid max adaptive skip frames: ", max_adaptive_skip_frames);
 
-    data.skip_frames = skip_frames;
+    data.max_adaptive_skip_frames = max_adaptive_skip_frames;
+
+    if(max_adaptive_skip_frames && data.skip_frames > max_adaptive_skip_frames)
+    {
+        data.skip_frames = max_adaptive_skip_frames;
+    }
 }
 
 void update()
 {
+    BN_PROFILER_ENGINE_DETAILED_START("eng_tasks_update");
+    tasks_manager::update();
+    BN_PROFILER_ENGINE_DETAILED_STOP();
+
     int update_frames = data.skip_frames + 1;
     data.last_update_frames = update_frames;
 
@@ -380,6 +682,93 @@ void update()
 
         data.last_ticks = total_ticks;
     }
+
+    #if BN_CFG_PROFILER_ENABLED
+        _bn::profiler::next_frame();
+    #endif
+
+    #if BN_CFG_RASTER_MARKS_ENABLED
+        _bn::raster_marks::next_frame();
+    #endif
+
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        memory_manager::next_frame();
+    #endif
+
+    #if BN_CFG_CORE_REPLAY_BENCHMARK_ENABLED
+        data.benchmark.update(data.last_ticks, update_frames);
+    #endif
+
+    if(int max_adaptive_skip_frames = data.max_adaptive_skip_frames)
+    {
+        // Skip one more frame if the last update missed its deadline,
+        // and one less frame if it would have fit with one less skip frame:
+        int cpu_usage_ticks = data.last_ticks.cpu_usage_ticks;
+        int ticks_per_frame = timers::ticks_per_frame();
+        int skip_frames = data.skip_frames;
+
+        if(cpu_usage_ticks > ticks_per_frame * update_frames)
+        {
+            if(skip_frames < max_adaptive_skip_frames)
+            {
+                data.skip_frames = skip_frames + 1;
+            }
+        }
+        else if(skip_frames && cpu_usage_ticks < (ticks_per_frame * skip_frames * 7) / 8)
+        {
+            data.skip_frames = skip_frames - 1;
+        }
+    }
+}
+
+void post_idle_task(idle_task_type task, int max_ticks)
+{
+    BN_ASSERT(task, "Task is null");
+    BN_ASSERT(max_ticks > 0 && max_ticks < timers::ticks_per_frame(), "Invalid max ticks: ", max_ticks);
+    BN_ASSERT(! data.idle_tasks.full(), "No more idle tasks available");
+
+    data.idle_tasks.push_back(idle_task{ task, max_ticks });
+}
+
+int pending_idle_tasks_count()
+{
+    return data.idle_tasks.size();
+}
+
+void clear_idle_tasks()
+{
+    data.idle_tasks.clear();
+}
+
+bool wait_for_keypad(int max_frames)
+{
+    BN_ASSERT(max_frames >= 1, "Invalid max frames: ", max_frames);
+
+    for(int frames = 1; frames <= max_frames; ++frames)
+    {
+        pcm_stream_manager::update();
+
+        // The V-Blank handler updates the audio, and the other subsystems don't commit anything:
+        data.restart_cpu_usage_timer = true;
+        hw::core::wait_for_vblank();
+
+        hblank_effects_manager::commit();
+        audio_manager::commit();
+        dmg_sound_manager::commit();
+        gpio_manager::commit();
+        keypad_manager::update();
+
+        if(keypad::any_pressed())
+        {
+            data.last_ticks = ticks();
+            data.last_update_frames = frames;
+            return true;
+        }
+    }
+
+    data.last_ticks = ticks();
+    data.last_update_frames = max_frames;
+    return false;
 }
 
 void sleep(keypad::key_type wake_up_key)
@@ -416,6 +805,9 @@ void sleep(const span<const keypad::key_type>& wake_up_keys)
         }
     }
 
+    // Stop DMG sound effects:
+    dmg_sound_manager::stop();
+
     // Sleep gpio:
     gpio_manager::sleep();
 
@@ -468,11 +860,21 @@ fixed current_cpu_usage()
     return fixed(current_cpu_usage_ticks) / timers::ticks_per_frame();
 }
 
+int init_ticks()
+{
+    return data.init_ticks;
+}
+
 fixed last_cpu_usage()
 {
     return fixed(data.last_ticks.cpu_usage_ticks) / (timers::ticks_per_frame() * data.last_update_frames);
 }
 
+const vblank_stats& last_vblank_stats()
+{
+    return data.last_vblank_stats;
+}
+
 fixed last_vblank_usage()
 {
     return fixed(data.last_ticks.vblank_usage_ticks) / (timers::ticks_per_vblank() * data.last_update_frames);
@@ -485,7 +887,7 @@ bool slow_game_pak()
 
 }
 
-#if BN_CFG_ASSERT_ENABLED
+#if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED
     namespace _bn::assert
     {
         void show(const char* condition, const char* file_name, const char* function, int line, const char* message)
@@ -498,7 +900,12 @@ bool slow_game_pak()
                 bn::hw::core::wait_for_vblank();
             }
         }
+    }
+#endif
 
+#if BN_CFG_ASSERT_ENABLED
+    namespace _bn::assert
+    {
         void show(const char* condition, const char* file_name, const char* function, int line,
                   const bn::istring_base& message)
         {
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_crc32.h"
+
+#include "bn_array.h"
+#include "bn_assert.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] constexpr array<uint32_t, 256> _create_table()
+    {
+        array<uint32_t, 256> result;
+
+        for(uint32_t index = 0; index < 256; ++index)
+        {
+            uint32_t value = index;
+
+            for(int bit = 0; bit < 8; ++bit)
+            {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+            }
+
+            result[index] = value;
+        }
+
+        return result;
+    }
+
+    // Not const, so the table is stored in IWRAM instead of ROM:
+    constinit array<uint32_t, 256> table = _create_table();
+}
+
+uint32_t crc32(const void* data, int size, uint32_t crc)
+{
+    BN_ASSERT(size >= 0, "Invalid size: ", size);
+
+    auto data_ptr = static_cast<const uint8_t*>(data);
+    const uint32_t* table_data = table.data();
+    crc = ~crc;
+
+    for(int index = 0; index < size; ++index)
+    {
+        crc = table_data[(crc ^ data_ptr[index]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+}
@@ -12,17 +12,17 @@ namespace bn
 
 void* malloc(int bytes)
 {
-    return memory_manager::ewram_alloc(bytes);
+    return memory_manager::ewram_alloc(bytes, __builtin_return_address(0));
 }
 
 void* calloc(int bytes)
 {
-    return memory_manager::ewram_calloc(bytes);
+    return memory_manager::ewram_calloc(bytes, __builtin_return_address(0));
 }
 
 void* realloc(void* ptr, int new_bytes)
 {
-    return memory_manager::ewram_realloc(ptr, new_bytes);
+    return memory_manager::ewram_realloc(ptr, new_bytes, __builtin_return_address(0));
 }
 
 void free(void* ptr)
@@ -30,6 +30,7 @@ namespace
 
     public:
         int mode = 0;
+        int bitmap_page = -1;
         bool enabled_bgs[hw::bgs::count()] = {};
         fixed sprites_mosaic_horizontal_stretch;
         fixed sprites_mosaic_vertical_stretch;
@@ -52,6 +53,16 @@ namespace
         uint16_t mosaic_cnt;
         uint16_t blending_cnt;
         uint16_t blending_transparency_cnt;
+        unsigned committed_windows_flags[hw::display::windows_count()];
+        point committed_rect_windows_hw_boundaries[hw::display::rect_windows_count() * 2];
+        int committed_display_cnt = -1;
+        int committed_mosaic_cnt = -1;
+        int committed_blending_cnt = -1;
+        int committed_blending_transparency_cnt = -1;
+        int committed_blending_fade = -1;
+        int committed_green_swap = -1;
+        bool committed_windows_flags_valid = false;
+        bool committed_rect_windows_hw_boundaries_valid = false;
         bool inside_windows_enabled[hw::display::inside_windows_count()] = {};
         bool commit = true;
         bool commit_display = true;
@@ -71,6 +82,32 @@ namespace
 
     BN_DATA_EWRAM static_data data;
 
+    // Registers are written only if their value is different from the last committed one (-1 if unknown):
+    [[nodiscard]] bool _update_committed_value(int value, int& committed_value)
+    {
+        if(value == committed_value)
+        {
+            return false;
+        }
+
+        committed_value = value;
+        return true;
+    }
+
+    template<typename Type, int Size>
+    [[nodiscard]] bool _update_committed_values(const Type (&values)[Size], Type (&committed_values)[Size],
+                                                bool& committed_values_valid)
+    {
+        if(committed_values_valid && equal(values, values + Size, committed_values))
+        {
+            return false;
+        }
+
+        copy(values, values + Size, committed_values);
+        committed_values_valid = true;
+        return true;
+    }
+
     [[nodiscard]] pair<int, int> _blending_hw_weights(fixed top_weight, fixed bottom_weight)
     {
         int hw_top_weight = top_weight.data() >> 8;
@@ -133,6 +170,21 @@ void set_mode(int mode)
     }
 }
 
+int bitmap_page()
+{
+    return data.bitmap_page;
+}
+
+void set_bitmap_page(int page)
+{
+    if(data.bitmap_page != page)
+    {
+        data.bitmap_page = page;
+        data.commit_display = true;
+        data.commit = true;
+    }
+}
+
 bool bg_enabled(int bg)
 {
     return data.enabled_bgs[bg];
@@ -241,6 +293,7 @@ void set_bgs_mosaic_stretch(fixed horizontal_stretch, fixed vertical_stretch)
 
 void reload_mosaic()
 {
+    data.committed_mosaic_cnt = -1;
     data.commit_mosaic = true;
     data.commit = true;
 }
@@ -358,6 +411,7 @@ void set_blending_transparency_weights(fixed top_weight, fixed bottom_weight)
 
 void reload_blending_transparency()
 {
+    data.committed_blending_transparency_cnt = -1;
     data.commit_blending_transparency = true;
     data.commit = true;
 }
@@ -449,6 +503,7 @@ void set_blending_fade_alpha(fixed fade_alpha)
 
 void reload_blending_fade()
 {
+    data.committed_blending_fade = -1;
     data.commit_blending_fade = true;
     data.commit = true;
 }
@@ -620,6 +675,7 @@ void remove_rect_window_camera(int window)
 
 void reload_rect_windows_boundaries()
 {
+    data.committed_rect_windows_hw_boundaries_valid = false;
     data.commit_windows_boundaries = true;
     data.commit = true;
 }
@@ -759,6 +815,7 @@ void set_green_swap_enabled(bool enabled)
 
 void reload_green_swap()
 {
+    data.committed_green_swap = -1;
     data.commit_green_swap = true;
     data.commit = true;
 }
@@ -771,11 +828,13 @@ void fill_green_swap_hblank_effect_states(const bool* states_ptr, uint16_t* dest
     }
 }
 
-void update_cameras()
+void update_camera(int camera_id)
 {
     for(int index = 0, limit = hw::display::rect_windows_count(); index < limit; ++index)
     {
-        if(data.rect_windows_camera[index])
+        const optional<camera_ptr>& camera = data.rect_windows_camera[index];
+
+        if(camera && camera->id() == camera_id)
         {
             int boundaries_index = index * 2;
             _update_rect_windows_hw_boundaries(boundaries_index);
@@ -830,7 +889,14 @@ void update()
     {
         if(data.commit_display)
         {
-            hw::display::set_display(data.mode, data.enabled_bgs, data.inside_windows_enabled, data.display_cnt);
+            if(int bitmap_page = data.bitmap_page; bitmap_page >= 0)
+            {
+                hw::display::set_bitmap_display(bitmap_page, data.inside_windows_enabled, data.display_cnt);
+            }
+            else
+            {
+                hw::display::set_display(data.mode, data.enabled_bgs, data.inside_windows_enabled, data.display_cnt);
+            }
         }
 
         if(data.commit_mosaic)
@@ -856,6 +922,11 @@ void update()
     }
 }
 
+bool must_commit()
+{
+    return data.commit;
+}
+
 void commit()
 {
     if(data.commit)
@@ -864,49 +935,85 @@ void commit()
 
         if(data.commit_display)
         {
-            hw::display::commit_display(data.display_cnt);
+            if(_update_committed_value(data.display_cnt, data.committed_display_cnt))
+            {
+                hw::display::commit_display(data.display_cnt);
+            }
+
             data.commit_display = false;
         }
 
         if(data.commit_mosaic)
         {
-            hw::display::commit_mosaic(data.mosaic_cnt);
+            if(_update_committed_value(data.mosaic_cnt, data.committed_mosaic_cnt))
+            {
+                hw::display::commit_mosaic(data.mosaic_cnt);
+            }
+
             data.commit_mosaic = false;
         }
 
         if(data.commit_blending_cnt)
         {
-            hw::display::commit_blending_cnt(data.blending_cnt);
+            if(_update_committed_value(data.blending_cnt, data.committed_blending_cnt))
+            {
+                hw::display::commit_blending_cnt(data.blending_cnt);
+            }
+
             data.commit_blending_cnt = false;
         }
 
         if(data.commit_blending_transparency)
         {
-            hw::display::commit_blending_transparency(data.blending_transparency_cnt);
+            if(_update_committed_value(data.blending_transparency_cnt, data.committed_blending_transparency_cnt))
+            {
+                hw::display::commit_blending_transparency(data.blending_transparency_cnt);
+            }
+
             data.commit_blending_transparency = false;
         }
 
         if(data.commit_blending_fade)
         {
-            hw::display::set_blending_fade(fixed_t<4>(data.blending_fade_alpha).data());
+            int blending_fade = fixed_t<4>(data.blending_fade_alpha).data();
+
+            if(_update_committed_value(blending_fade, data.committed_blending_fade))
+            {
+                hw::display::set_blending_fade(blending_fade);
+            }
+
             data.commit_blending_fade = false;
         }
 
         if(data.commit_windows_flags)
         {
-            hw::display::set_windows_flags(data.windows_flags);
+            if(_update_committed_values(data.windows_flags, data.committed_windows_flags,
+                                        data.committed_windows_flags_valid))
+            {
+                hw::display::set_windows_flags(data.windows_flags);
+            }
+
             data.commit_windows_flags = false;
         }
 
         if(data.commit_windows_boundaries)
         {
-            hw::display::set_windows_boundaries(data.rect_windows_hw_boundaries);
+            if(_update_committed_values(data.rect_windows_hw_boundaries, data.committed_rect_windows_hw_boundaries,
+                                        data.committed_rect_windows_hw_boundaries_valid))
+            {
+                hw::display::set_windows_boundaries(data.rect_windows_hw_boundaries);
+            }
+
             data.commit_windows_boundaries = false;
         }
 
         if(data.commit_green_swap)
         {
-            hw::display::set_green_swap_enabled(data.green_swap_enabled);
+            if(_update_committed_value(data.green_swap_enabled, data.committed_green_swap))
+            {
+                hw::display::set_green_swap_enabled(data.green_swap_enabled);
+            }
+
             data.commit_green_swap = false;
         }
     }
@@ -928,11 +1035,16 @@ void stop()
     data.update_blending_layers = false;
     data.update_windows_visible_bgs = false;
     data.commit = false;
+    data.committed_mosaic_cnt = -1;
+    data.committed_blending_cnt = -1;
     hw::display::stop();
 }
 
 void set_show_mode()
 {
+    data.committed_display_cnt = -1;
+    data.committed_mosaic_cnt = -1;
+    data.committed_blending_cnt = -1;
     hw::display::set_show_mode();
 }
 
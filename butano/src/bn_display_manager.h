@@ -25,6 +25,10 @@ namespace bn::display_manager
 
     void set_mode(int mode);
 
+    [[nodiscard]] int bitmap_page();
+
+    void set_bitmap_page(int page);
+
     [[nodiscard]] bool bg_enabled(int bg);
 
     void set_bg_enabled(int bg, bool enabled);
@@ -163,10 +167,12 @@ namespace bn::display_manager
 
     void fill_green_swap_hblank_effect_states(const bool* states_ptr, uint16_t* dest_ptr);
 
-    void update_cameras();
+    void update_camera(int camera_id);
 
     void update();
 
+    [[nodiscard]] bool must_commit();
+
     void commit();
 
     void sleep();
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_dmg_sound.h"
+
+#include "bn_dmg_sound_manager.h"
+
+namespace bn::dmg_sound
+{
+
+void play(const dmg_sound_item& item)
+{
+    dmg_sound_manager::play(item);
+}
+
+void play(dmg_sound_channel channel, const dmg_sound_step& step)
+{
+    dmg_sound_manager::play(channel, step);
+}
+
+bool playing(dmg_sound_channel channel)
+{
+    return dmg_sound_manager::playing(channel);
+}
+
+void stop(dmg_sound_channel channel)
+{
+    dmg_sound_manager::stop(channel);
+}
+
+void stop_all()
+{
+    dmg_sound_manager::stop_all();
+}
+
+void set_wave_pattern(const span<const uint8_t>& wave_pattern_ref)
+{
+    BN_ASSERT(wave_pattern_ref.size() == 16, "Invalid wave pattern ref size: ", wave_pattern_ref.size());
+
+    dmg_sound_manager::set_wave_pattern(wave_pattern_ref);
+}
+
+fixed volume()
+{
+    return fixed(dmg_sound_manager::volume()) / 7;
+}
+
+void set_volume(fixed volume)
+{
+    BN_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
+
+    dmg_sound_manager::set_volume((volume * 7).round_integer());
+}
+
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_dmg_sound_item.h"
+
+#include "bn_dmg_sound_manager.h"
+
+namespace bn
+{
+
+void dmg_sound_item::play() const
+{
+    dmg_sound_manager::play(*this);
+}
+
+}
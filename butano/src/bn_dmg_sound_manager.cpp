@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_dmg_sound_manager.h"
+
+#include "bn_dmg_sound_item.h"
+#include "../hw/include/bn_hw_dmg_sound.h"
+
+#include "bn_dmg_sound.cpp.h"
+#include "bn_dmg_sound_item.cpp.h"
+
+namespace bn::dmg_sound_manager
+{
+
+namespace
+{
+    constexpr int channels_count = 4;
+
+    class channel_data
+    {
+
+    public:
+        dmg_sound_step step = dmg_sound_step(0, 0, 0, 1);
+        const dmg_sound_step* next_step = nullptr;
+        const dmg_sound_step* last_step = nullptr;
+        int step_frames = 0;
+        bool playing = false;
+        bool commit_step = false;
+        bool commit_stop = false;
+    };
+
+    class static_data
+    {
+
+    public:
+        channel_data channels[channels_count];
+        const uint8_t* wave_pattern = nullptr;
+        int volume = 7;
+        bool commit_wave_pattern = false;
+    };
+
+    BN_DATA_EWRAM static_data data;
+
+
+    [[nodiscard]] channel_data& _channel(dmg_sound_channel channel)
+    {
+        return data.channels[int(channel)];
+    }
+
+    void _stop(channel_data& channel)
+    {
+        if(channel.playing)
+        {
+            channel.next_step = nullptr;
+            channel.playing = false;
+            channel.commit_step = false;
+            channel.commit_stop = true;
+        }
+    }
+
+    void _commit_step(int channel_index, const dmg_sound_step& step)
+    {
+        switch(dmg_sound_channel(channel_index))
+        {
+
+        case dmg_sound_channel::SQUARE_1:
+            hw::dmg_sound::play_square_1(step.sweep(), step.control(), step.frequency());
+            break;
+
+        case dmg_sound_channel::SQUARE_2:
+            hw::dmg_sound::play_square_2(step.control(), step.frequency());
+            break;
+
+        case dmg_sound_channel::WAVE:
+            if(data.commit_wave_pattern)
+            {
+                data.commit_wave_pattern = false;
+                hw::dmg_sound::set_wave_pattern(data.wave_pattern);
+            }
+
+            hw::dmg_sound::play_wave(step.control(), step.frequency());
+            break;
+
+        case dmg_sound_channel::NOISE:
+            hw::dmg_sound::play_noise(step.control(), step.frequency());
+            break;
+
+        default:
+            BN_ERROR("Invalid channel: ", channel_index);
+            break;
+        }
+    }
+
+    void _commit_stop(int channel_index)
+    {
+        switch(dmg_sound_channel(channel_index))
+        {
+
+        case dmg_sound_channel::SQUARE_1:
+            hw::dmg_sound::stop_square_1();
+            break;
+
+        case dmg_sound_channel::SQUARE_2:
+            hw::dmg_sound::stop_square_2();
+            break;
+
+        case dmg_sound_channel::WAVE:
+            hw::dmg_sound::stop_wave();
+            break;
+
+        case dmg_sound_channel::NOISE:
+            hw::dmg_sound::stop_noise();
+            break;
+
+        default:
+            BN_ERROR("Invalid channel: ", channel_index);
+            break;
+        }
+    }
+}
+
+void play(const dmg_sound_item& item)
+{
+    const span<const dmg_sound_step>& steps_ref = item.steps_ref();
+    channel_data& channel = _channel(item.channel());
+    channel.next_step = steps_ref.data();
+    channel.last_step = steps_ref.data() + steps_ref.size();
+    channel.step_frames = 0;
+    channel.playing = true;
+    channel.commit_step = false;
+    channel.commit_stop = false;
+
+    if(item.channel() == dmg_sound_channel::WAVE)
+    {
+        set_wave_pattern(item.wave_pattern_ref());
+    }
+}
+
+void play(dmg_sound_channel channel, const dmg_sound_step& step)
+{
+    channel_data& channel_ref = _channel(channel);
+    channel_ref.step = step;
+    channel_ref.next_step = nullptr;
+    channel_ref.playing = true;
+    channel_ref.commit_step = true;
+    channel_ref.commit_stop = false;
+}
+
+bool playing(dmg_sound_channel channel)
+{
+    return _channel(channel).playing;
+}
+
+void stop(dmg_sound_channel channel)
+{
+    _stop(_channel(channel));
+}
+
+void stop_all()
+{
+    for(channel_data& channel : data.channels)
+    {
+        _stop(channel);
+    }
+}
+
+void set_wave_pattern(const span<const uint8_t>& wave_pattern_ref)
+{
+    data.wave_pattern = wave_pattern_ref.data();
+    data.commit_wave_pattern = true;
+}
+
+int volume()
+{
+    return data.volume;
+}
+
+void set_volume(int volume)
+{
+    data.volume = volume;
+}
+
+void commit()
+{
+    bool enable = false;
+
+    for(const channel_data& channel : data.channels)
+    {
+        enable |= channel.playing | channel.commit_stop;
+    }
+
+    if(! enable)
+    {
+        return;
+    }
+
+    hw::dmg_sound::enable(data.volume);
+
+    for(int index = 0; index < channels_count; ++index)
+    {
+        channel_data& channel = data.channels[index];
+
+        if(channel.commit_stop)
+        {
+            channel.commit_stop = false;
+            _commit_stop(index);
+        }
+
+        if(! channel.playing)
+        {
+            continue;
+        }
+
+        // Sequenced sound effects advance one frame per commit:
+        if(channel.next_step)
+        {
+            if(channel.step_frames == 0)
+            {
+                if(channel.next_step == channel.last_step)
+                {
+                    channel.next_step = nullptr;
+                    channel.playing = false;
+                    _commit_stop(index);
+                    continue;
+                }
+
+                channel.step = *channel.next_step;
+                channel.step_frames = channel.step.frames();
+                channel.commit_step = true;
+                ++channel.next_step;
+            }
+
+            --channel.step_frames;
+        }
+
+        if(channel.commit_step)
+        {
+            channel.commit_step = false;
+            _commit_step(index, channel.step);
+        }
+    }
+}
+
+void stop()
+{
+    stop_all();
+    commit();
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_DMG_SOUND_MANAGER_H
+#define BN_DMG_SOUND_MANAGER_H
+
+#include "bn_span.h"
+#include "bn_dmg_sound_channel.h"
+
+namespace bn
+{
+    class dmg_sound_step;
+    class dmg_sound_item;
+}
+
+namespace bn::dmg_sound_manager
+{
+    void play(const dmg_sound_item& item);
+
+    void play(dmg_sound_channel channel, const dmg_sound_step& step);
+
+    [[nodiscard]] bool playing(dmg_sound_channel channel);
+
+    void stop(dmg_sound_channel channel);
+
+    void stop_all();
+
+    void set_wave_pattern(const span<const uint8_t>& wave_pattern_ref);
+
+    [[nodiscard]] int volume();
+
+    void set_volume(int volume);
+
+    void commit();
+
+    void stop();
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_easing.h"
+
+#include "bn_array.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr array<int16_t, easing_lut_size * easing_types_count> easing_lut_impl = []{
+        array<int16_t, easing_lut_size * easing_types_count> result;
+
+        for(int type = 0; type < easing_types_count; ++type)
+        {
+            for(int index = 0; index < easing_lut_size; ++index)
+            {
+                result[(type * easing_lut_size) + index] = int16_t(
+                            calculate_easing_lut_value(easing_type(type), index));
+            }
+        }
+
+        return result;
+    }();
+}
+
+const array<int16_t, easing_lut_size * easing_types_count>& easing_lut = easing_lut_impl;
+
+fixed ease(easing_type type, fixed progress)
+{
+    constexpr int entry_shift = 4;
+    constexpr int entry_mask = (1 << entry_shift) - 1;
+    static_assert((easing_lut_size - 1) << entry_shift == fixed::scale());
+
+    int progress_data = progress.data();
+    BN_ASSERT(progress_data >= 0 && progress_data <= fixed::scale(), "Invalid progress: ", progress);
+
+    const int16_t* lut = easing_lut_impl.data() + (int(type) * easing_lut_size);
+    int index = progress_data >> entry_shift;
+    int value = lut[index];
+
+    if(int fraction = progress_data & entry_mask)
+    {
+        value += ((lut[index + 1] - value) * fraction) >> entry_shift;
+    }
+
+    return fixed::from_data(value);
+}
+
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_eeprom.h"
+
+#include "bn_memory.h"
+#include "bn_algorithm.h"
+#include "../hw/include/bn_hw_eeprom.h"
+
+namespace _bn::eeprom
+{
+
+bool unsafe_write(const void* source, int size, int offset)
+{
+    #if BN_CFG_EEPROM_SIZE
+        constexpr int block_size = bn::hw::eeprom::block_size();
+        auto source_ptr = static_cast<const uint8_t*>(source);
+        alignas(int) uint8_t block_data[block_size];
+
+        while(size > 0)
+        {
+            int block = offset / block_size;
+            int block_offset = offset % block_size;
+            int block_bytes = bn::min(size, block_size - block_offset);
+
+            // Each block write takes several milliseconds, so only changed blocks are written:
+            bn::hw::eeprom::read_block(block, block_data);
+
+            if(! bn::equal(source_ptr, source_ptr + block_bytes, block_data + block_offset))
+            {
+                bn::memory::copy(*source_ptr, block_bytes, block_data[block_offset]);
+
+                if(! bn::hw::eeprom::write_block(block, block_data))
+                {
+                    return false;
+                }
+            }
+
+            source_ptr += block_bytes;
+            offset += block_bytes;
+            size -= block_bytes;
+        }
+
+        return true;
+    #else
+        BN_ERROR("EEPROM is disabled: ", source, " - ", size, " - ", offset);
+        return false;
+    #endif
+}
+
+void unsafe_read(void* destination, int size, int offset)
+{
+    #if BN_CFG_EEPROM_SIZE
+        constexpr int block_size = bn::hw::eeprom::block_size();
+        auto destination_ptr = static_cast<uint8_t*>(destination);
+        alignas(int) uint8_t block_data[block_size];
+
+        while(size > 0)
+        {
+            int block = offset / block_size;
+            int block_offset = offset % block_size;
+            int block_bytes = bn::min(size, block_size - block_offset);
+            bn::hw::eeprom::read_block(block, block_data);
+            bn::memory::copy(block_data[block_offset], block_bytes, *destination_ptr);
+
+            destination_ptr += block_bytes;
+            offset += block_bytes;
+            size -= block_bytes;
+        }
+    #else
+        BN_ERROR("EEPROM is disabled: ", destination, " - ", size, " - ", offset);
+    #endif
+}
+
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_flash.h"
+
+#include "bn_memory.h"
+#include "bn_algorithm.h"
+#include "../hw/include/bn_hw_flash.h"
+
+namespace _bn::flash
+{
+
+namespace
+{
+    #if BN_CFG_FLASH_SIZE
+        class static_data
+        {
+
+        public:
+            alignas(int) uint8_t sector[bn::hw::flash::sector_size()];
+        };
+
+        BN_DATA_EWRAM static_data data;
+    #endif
+}
+
+bool unsafe_write(const void* source, int size, int offset)
+{
+    #if BN_CFG_FLASH_SIZE
+        constexpr int sector_size = bn::hw::flash::sector_size();
+        auto source_ptr = static_cast<const uint8_t*>(source);
+        uint8_t* sector_data = data.sector;
+
+        while(size > 0)
+        {
+            int sector = offset / sector_size;
+            int sector_offset = offset % sector_size;
+            int sector_bytes = bn::min(size, sector_size - sector_offset);
+
+            // Sectors are erased and programmed only if some of their bytes have been changed:
+            bn::hw::flash::read(sector_data, sector_size, sector * sector_size);
+
+            if(! bn::equal(source_ptr, source_ptr + sector_bytes, sector_data + sector_offset))
+            {
+                bn::memory::copy(*source_ptr, sector_bytes, sector_data[sector_offset]);
+
+                if(! bn::hw::flash::erase_sector(sector) ||
+                        ! bn::hw::flash::write(sector_data, sector_size, sector * sector_size))
+                {
+                    return false;
+                }
+            }
+
+            source_ptr += sector_bytes;
+            offset += sector_bytes;
+            size -= sector_bytes;
+        }
+
+        return true;
+    #else
+        BN_ERROR("Flash is disabled: ", source, " - ", size, " - ", offset);
+        return false;
+    #endif
+}
+
+void unsafe_read(void* destination, int size, int offset)
+{
+    #if BN_CFG_FLASH_SIZE
+        bn::hw::flash::read(destination, size, offset);
+    #else
+        BN_ERROR("Flash is disabled: ", destination, " - ", size, " - ", offset);
+    #endif
+}
+
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_flash_writer.h"
+
+#include "bn_core.h"
+#include "bn_algorithm.h"
+#include "../hw/include/bn_hw_flash.h"
+
+namespace bn
+{
+
+namespace
+{
+    static_assert(BN_CFG_FLASH_WRITER_TASK_BYTES > 0);
+
+    // Programming a byte takes up to ~40 microseconds (~11 timer ticks):
+    constexpr int task_max_ticks = BN_CFG_FLASH_WRITER_TASK_BYTES * 12;
+
+    class static_data
+    {
+
+    public:
+        iflash_writer* first_writer = nullptr;
+        iflash_writer* last_writer = nullptr;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+iflash_writer::iflash_writer(uint8_t* data, int sectors_count, int offset) :
+    _data(data),
+    _sectors_count(sectors_count),
+    _first_sector(offset / flash::sector_size())
+{
+    BN_ASSERT(offset >= 0 && offset % flash::sector_size() == 0, "Invalid offset: ", offset);
+    BN_ASSERT(offset + (sectors_count * flash::sector_size()) <= flash::size(),
+              "Sectors count and offset are too high: ", sectors_count, " - ", offset);
+
+    hw::flash::read(data, sectors_count * flash::sector_size(), offset);
+}
+
+iflash_writer::~iflash_writer()
+{
+    flush();
+}
+
+void iflash_writer::update()
+{
+    constexpr int sector_size = hw::flash::sector_size();
+
+    int sector = _first_sector + _sector_index;
+    uint8_t* sector_data = _data + (_sector_index * sector_size);
+
+    switch(_state)
+    {
+
+    case state_type::IDLE:
+        break;
+
+    case state_type::COMPARE:
+        {
+            alignas(int) uint8_t flash_data[BN_CFG_FLASH_WRITER_TASK_BYTES];
+            int bytes = min(BN_CFG_FLASH_WRITER_TASK_BYTES, sector_size - _byte_index);
+            hw::flash::read(flash_data, bytes, (sector * sector_size) + _byte_index);
+
+            if(equal(flash_data, flash_data + bytes, sector_data + _byte_index))
+            {
+                _byte_index += bytes;
+
+                if(_byte_index == sector_size)
+                {
+                    _next_sector();
+                }
+            }
+            else
+            {
+                hw::flash::start_erase_sector(sector);
+                _state = state_type::ERASE;
+            }
+        }
+        break;
+
+    case state_type::ERASE:
+        if(hw::flash::erase_sector_done(sector))
+        {
+            _byte_index = 0;
+            _state = state_type::PROGRAM;
+        }
+        break;
+
+    case state_type::PROGRAM:
+        {
+            int bytes = min(BN_CFG_FLASH_WRITER_TASK_BYTES, sector_size - _byte_index);
+
+            if(hw::flash::write(sector_data + _byte_index, bytes, (sector * sector_size) + _byte_index))
+            {
+                _byte_index += bytes;
+
+                if(_byte_index == sector_size)
+                {
+                    _next_sector();
+                }
+            }
+            else
+            {
+                // Failed sectors are compared again, so they are erased and programmed again:
+                _byte_index = 0;
+                _state = state_type::COMPARE;
+            }
+        }
+        break;
+
+    default:
+        BN_ERROR("Invalid state: ", int(_state));
+        break;
+    }
+}
+
+void iflash_writer::flush()
+{
+    while(! done())
+    {
+        update();
+    }
+}
+
+void iflash_writer::_write(const void* source, int size)
+{
+    memory::copy(*static_cast<const uint8_t*>(source), size, *_data);
+
+    if(_state == state_type::IDLE)
+    {
+        _sector_index = 0;
+        _byte_index = 0;
+        _state = state_type::COMPARE;
+        _enqueue();
+    }
+    else
+    {
+        // The sector being erased or programmed is finished before starting again:
+        _restart = true;
+    }
+}
+
+void iflash_writer::_next_sector()
+{
+    _byte_index = 0;
+
+    if(_restart)
+    {
+        _restart = false;
+        _sector_index = 0;
+        _state = state_type::COMPARE;
+    }
+    else if(_sector_index + 1 < _sectors_count)
+    {
+        ++_sector_index;
+        _state = state_type::COMPARE;
+    }
+    else
+    {
+        _sector_index = 0;
+        _state = state_type::IDLE;
+        _dequeue();
+    }
+}
+
+void iflash_writer::_enqueue()
+{
+    if(! _queued)
+    {
+        _queued = true;
+        _next_writer = nullptr;
+
+        if(iflash_writer* last_writer = data.last_writer)
+        {
+            last_writer->_next_writer = this;
+        }
+        else
+        {
+            data.first_writer = this;
+            core::post_idle_task(_update_queued, task_max_ticks);
+        }
+
+        data.last_writer = this;
+    }
+}
+
+void iflash_writer::_dequeue()
+{
+    if(_queued)
+    {
+        iflash_writer* previous_writer = nullptr;
+        iflash_writer* writer = data.first_writer;
+
+        while(writer != this)
+        {
+            previous_writer = writer;
+            writer = writer->_next_writer;
+        }
+
+        if(previous_writer)
+        {
+            previous_writer->_next_writer = _next_writer;
+        }
+        else
+        {
+            data.first_writer = _next_writer;
+        }
+
+        if(data.last_writer == this)
+        {
+            data.last_writer = previous_writer;
+        }
+
+        _next_writer = nullptr;
+        _queued = false;
+    }
+}
+
+void iflash_writer::_update_queued()
+{
+    if(iflash_writer* writer = data.first_writer)
+    {
+        writer->update();
+
+        // The task posts itself again until all queued writers are done:
+        if(data.first_writer)
+        {
+            core::post_idle_task(_update_queued, task_max_ticks);
+        }
+    }
+}
+
+}
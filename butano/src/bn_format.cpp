@@ -8,41 +8,18 @@
 namespace _bn
 {
 
-void format(bn::ostringstream& stream, const char* format_begin, const char* format_end)
+void format_escaped(bn::ostringstream& stream, const char* format_begin, const char* format_end)
 {
     while(format_begin != format_end)
     {
         char character = *format_begin;
         ++format_begin;
+        stream.append(character);
 
-        if(character == '{') [[unlikely]]
+        if(character == '{' || character == '}')
         {
-            BN_ASSERT(format_begin != format_end, "Format contains a single '{' character");
-
-            char next_character = *format_begin;
-            ++format_begin;
-
-            if(next_character == '{') [[unlikely]]
-            {
-                stream.append(next_character);
-            }
-            else
-            {
-                BN_ASSERT(next_character == '}', "Format contains a single '{' character");
-                BN_ERROR("Not enough arguments");
-            }
-        }
-        else if(character == '}') [[unlikely]]
-        {
-            BN_ASSERT(format_begin != format_end, "Format contains a single '}' character");
-            BN_ASSERT(*format_begin == '}', "Format contains a single '}' character");
-
+            // Escape sequences have been validated when parsing the format string:
             ++format_begin;
-            stream.append('}');
-        }
-        else
-        {
-            stream.append(character);
         }
     }
 }
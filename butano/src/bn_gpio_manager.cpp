@@ -5,8 +5,12 @@
 
 #include "bn_gpio_manager.h"
 
+#include "bn_algorithm.h"
+#include "../hw/include/bn_hw_rtc.h"
 #include "../hw/include/bn_hw_gpio.h"
+#include "../hw/include/bn_hw_timer.h"
 
+#include "bn_rtc.cpp.h"
 #include "bn_rumble.cpp.h"
 
 namespace bn::gpio_manager
@@ -14,17 +18,107 @@ namespace bn::gpio_manager
 
 namespace
 {
+    // One second is 2^18 timer ticks:
+    constexpr int rtc_seconds_shift = 18;
+
+    constexpr int rtc_bytes_per_commit = 2;
+
     class static_data
     {
 
     public:
+        optional<rtc_time> rtc_last_time;
+        unsigned rtc_ticks = 0;
+        uint8_t rtc_bytes[hw::rtc::time_bytes()] = {};
+        int8_t rtc_read_bytes = -1;
         bool first_commit = true;
         bool rumble_enabled = false;
         bool commit_rumble = false;
+        bool rtc_probed = false;
+        bool rtc_active = false;
+        bool rtc_enabled = false;
     };
 
     BN_DATA_EWRAM static_data data;
 
+    [[nodiscard]] int _bcd_to_int(int bcd)
+    {
+        return ((bcd >> 4) * 10) + (bcd & 0xF);
+    }
+
+    void _rtc_read_finished()
+    {
+        hw::rtc::stop();
+        data.rtc_read_bytes = -1;
+        data.rtc_ticks = hw::timer::ticks();
+
+        const uint8_t* bytes = data.rtc_bytes;
+        int year = _bcd_to_int(bytes[0]) + 2000;
+        int month = _bcd_to_int(bytes[1] & 0x1F);
+        int month_day = _bcd_to_int(bytes[2] & 0x3F);
+        int week_day = bytes[3] & 0x7;
+        int hour = _bcd_to_int(bytes[4] & 0x3F);
+        int minute = _bcd_to_int(bytes[5] & 0x7F);
+        int second = _bcd_to_int(bytes[6] & 0x7F);
+
+        // Invalid dates and times (for example, if the real-time clock has been removed) are ignored:
+        if(year <= 2099 && month >= 1 && month <= 12 && month_day >= 1 &&
+                month_day <= rtc_time::days_in_month(year, month) && week_day <= 6 && hour <= 23 &&
+                minute <= 59 && second <= 59)
+        {
+            data.rtc_last_time = rtc_time(year, month, month_day, week_day, hour, minute, second);
+        }
+    }
+
+    void _read_rtc()
+    {
+        if(data.rtc_read_bytes >= 0)
+        {
+            hw::rtc::stop();
+        }
+
+        hw::rtc::start_time_read();
+
+        for(uint8_t& byte : data.rtc_bytes)
+        {
+            byte = uint8_t(hw::rtc::read_byte());
+        }
+
+        _rtc_read_finished();
+    }
+
+    void _update_rtc()
+    {
+        int read_bytes = data.rtc_read_bytes;
+
+        if(read_bytes < 0)
+        {
+            if(int(hw::timer::ticks() - data.rtc_ticks) >= 1 << rtc_seconds_shift)
+            {
+                hw::rtc::start_time_read();
+                data.rtc_read_bytes = 0;
+            }
+        }
+        else
+        {
+            int last_read_bytes = min(read_bytes + rtc_bytes_per_commit, hw::rtc::time_bytes());
+
+            for(; read_bytes < last_read_bytes; ++read_bytes)
+            {
+                data.rtc_bytes[read_bytes] = uint8_t(hw::rtc::read_byte());
+            }
+
+            if(read_bytes == hw::rtc::time_bytes())
+            {
+                _rtc_read_finished();
+            }
+            else
+            {
+                data.rtc_read_bytes = int8_t(read_bytes);
+            }
+        }
+    }
+
     void _check_first_commit()
     {
         if(data.first_commit)
@@ -49,6 +143,41 @@ void set_rumble_enabled(bool enabled)
     }
 }
 
+bool rtc_active()
+{
+    if(! data.rtc_probed)
+    {
+        data.rtc_active = hw::rtc::init();
+        data.rtc_probed = true;
+    }
+
+    return data.rtc_active;
+}
+
+optional<rtc_time> current_rtc_time()
+{
+    if(! rtc_active())
+    {
+        return nullopt;
+    }
+
+    if(! data.rtc_enabled)
+    {
+        data.rtc_enabled = true;
+        _read_rtc();
+    }
+
+    optional<rtc_time> result = data.rtc_last_time;
+
+    if(const rtc_time* time = result.get())
+    {
+        int elapsed_seconds = int(hw::timer::ticks() - data.rtc_ticks) >> rtc_seconds_shift;
+        result = time->advanced(elapsed_seconds);
+    }
+
+    return result;
+}
+
 void commit()
 {
     if(data.commit_rumble)
@@ -57,6 +186,11 @@ void commit()
         hw::gpio::set_rumble_enabled(data.rumble_enabled);
         data.commit_rumble = false;
     }
+
+    if(data.rtc_enabled)
+    {
+        _update_rtc();
+    }
 }
 
 void sleep()
@@ -71,6 +205,12 @@ void sleep()
 
 void wake_up()
 {
+    // Timers are stopped while the GBA is asleep, so the date and time must be read again:
+    if(data.rtc_enabled)
+    {
+        _read_rtc();
+    }
+
     commit();
 }
 
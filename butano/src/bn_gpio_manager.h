@@ -6,7 +6,8 @@
 #ifndef BN_GPIO_MANAGER_H
 #define BN_GPIO_MANAGER_H
 
-#include "bn_common.h"
+#include "bn_optional.h"
+#include "bn_rtc_time.h"
 
 namespace bn::gpio_manager
 {
@@ -14,6 +15,10 @@ namespace bn::gpio_manager
 
     void set_rumble_enabled(bool enabled);
 
+    [[nodiscard]] bool rtc_active();
+
+    [[nodiscard]] optional<rtc_time> current_rtc_time();
+
     void commit();
 
     void sleep();
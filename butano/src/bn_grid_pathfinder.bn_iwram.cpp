@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_grid_pathfinder.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int orthogonal_cost = 10;
+    constexpr int diagonal_cost = 14;
+
+    [[nodiscard]] int _sign(int value)
+    {
+        return (value > 0) - (value < 0);
+    }
+
+    [[nodiscard]] int _octile_distance(int dx, int dy)
+    {
+        dx = abs(dx);
+        dy = abs(dy);
+        return (orthogonal_cost * max(dx, dy)) + ((diagonal_cost - orthogonal_cost) * min(dx, dy));
+    }
+
+    template<class Cell>
+    [[nodiscard]] bool _less(const Cell& a, const Cell& b)
+    {
+        // Ties are broken in favor of the deepest cells, so less cells are expanded:
+        return a.f < b.f || (a.f == b.f && a.g > b.g);
+    }
+}
+
+igrid_pathfinder::status_type igrid_pathfinder::update(int max_expanded_cells)
+{
+    BN_ASSERT(max_expanded_cells > 0, "Invalid max expanded cells: ", max_expanded_cells);
+
+    if(_status != status_type::SEARCHING)
+    {
+        return _status;
+    }
+
+    bool jump_points = _algorithm == algorithm_type::JUMP_POINT_SEARCH;
+
+    for(; max_expanded_cells; --max_expanded_cells)
+    {
+        if(! _heap_size)
+        {
+            _status = _flow_field ? status_type::FOUND : status_type::NOT_FOUND;
+            break;
+        }
+
+        int cell = _pop();
+
+        if(cell == _goal && ! _flow_field)
+        {
+            _status = status_type::FOUND;
+            break;
+        }
+
+        if(jump_points)
+        {
+            _expand_jump_points(cell);
+        }
+        else
+        {
+            _expand_neighbors(cell);
+        }
+    }
+
+    return _status;
+}
+
+int igrid_pathfinder::_heuristic(int x, int y) const
+{
+    if(_flow_field)
+    {
+        return 0;
+    }
+
+    int dx = x - _goal_x;
+    int dy = y - _goal_y;
+
+    if(_algorithm == algorithm_type::A_STAR_4)
+    {
+        return orthogonal_cost * (abs(dx) + abs(dy));
+    }
+
+    return _octile_distance(dx, dy);
+}
+
+void igrid_pathfinder::_relax(int x, int y, int parent, int g)
+{
+    int cell = (y * _width) + x;
+    cell_type& cell_data = _cells[cell];
+
+    if(! _visited(cell))
+    {
+        _stamps[cell] = _stamp;
+        cell_data.g = g;
+        cell_data.f = g + _heuristic(x, y);
+        cell_data.parent = int16_t(parent);
+        _heap[_heap_size] = int16_t(cell);
+        _sift_up(_heap_size);
+        ++_heap_size;
+    }
+    else if(cell_data.heap_index >= 0 && g < cell_data.g)
+    {
+        cell_data.f -= cell_data.g - g;
+        cell_data.g = g;
+        cell_data.parent = int16_t(parent);
+        _sift_up(cell_data.heap_index);
+    }
+}
+
+int igrid_pathfinder::_pop()
+{
+    int16_t* heap = _heap;
+    int result = heap[0];
+    int heap_size = _heap_size - 1;
+    _heap_size = heap_size;
+    _cells[result].heap_index = -1;
+
+    if(heap_size)
+    {
+        heap[0] = heap[heap_size];
+        _sift_down(0);
+    }
+
+    return result;
+}
+
+void igrid_pathfinder::_sift_up(int heap_index)
+{
+    int16_t* heap = _heap;
+    cell_type* cells = _cells;
+    int cell = heap[heap_index];
+    const cell_type& cell_data = cells[cell];
+
+    while(heap_index)
+    {
+        int parent_index = (heap_index - 1) >> 1;
+        int parent_cell = heap[parent_index];
+
+        if(! _less(cell_data, cells[parent_cell]))
+        {
+            break;
+        }
+
+        heap[heap_index] = int16_t(parent_cell);
+        cells[parent_cell].heap_index = int16_t(heap_index);
+        heap_index = parent_index;
+    }
+
+    heap[heap_index] = int16_t(cell);
+    cells[cell].heap_index = int16_t(heap_index);
+}
+
+void igrid_pathfinder::_sift_down(int heap_index)
+{
+    int16_t* heap = _heap;
+    cell_type* cells = _cells;
+    int heap_size = _heap_size;
+    int cell = heap[heap_index];
+    const cell_type& cell_data = cells[cell];
+
+    while(true)
+    {
+        int child_index = (heap_index * 2) + 1;
+
+        if(child_index >= heap_size)
+        {
+            break;
+        }
+
+        int child_cell = heap[child_index];
+
+        if(child_index + 1 < heap_size)
+        {
+            int right_cell = heap[child_index + 1];
+
+            if(_less(cells[right_cell], cells[child_cell]))
+            {
+                ++child_index;
+                child_cell = right_cell;
+            }
+        }
+
+        if(! _less(cells[child_cell], cell_data))
+        {
+            break;
+        }
+
+        heap[heap_index] = int16_t(child_cell);
+        cells[child_cell].heap_index = int16_t(heap_index);
+        heap_index = child_index;
+    }
+
+    heap[heap_index] = int16_t(cell);
+    cells[cell].heap_index = int16_t(heap_index);
+}
+
+void igrid_pathfinder::_expand_neighbors(int cell)
+{
+    int x;
+    int y;
+    _coordinates(cell, x, y);
+
+    // Flow fields are generated from the goal, so the cost of a move is the cost of the expanded cell:
+    const uint8_t* costs = _costs;
+    int width = _width;
+    int g = _cells[cell].g;
+    int cell_cost = costs[cell];
+    bool flow_field = _flow_field;
+
+    if(_walkable(x - 1, y))
+    {
+        _relax(x - 1, y, cell, g + (orthogonal_cost * (flow_field ? cell_cost : costs[cell - 1])));
+    }
+
+    if(_walkable(x + 1, y))
+    {
+        _relax(x + 1, y, cell, g + (orthogonal_cost * (flow_field ? cell_cost : costs[cell + 1])));
+    }
+
+    if(_walkable(x, y - 1))
+    {
+        _relax(x, y - 1, cell, g + (orthogonal_cost * (flow_field ? cell_cost : costs[cell - width])));
+    }
+
+    if(_walkable(x, y + 1))
+    {
+        _relax(x, y + 1, cell, g + (orthogonal_cost * (flow_field ? cell_cost : costs[cell + width])));
+    }
+
+    if(_algorithm != algorithm_type::A_STAR_4)
+    {
+        for(int dy = -1; dy <= 1; dy += 2)
+        {
+            if(! _walkable(x, y + dy))
+            {
+                continue;
+            }
+
+            for(int dx = -1; dx <= 1; dx += 2)
+            {
+                if(_walkable(x + dx, y) && _walkable(x + dx, y + dy))
+                {
+                    int neighbor_cost = flow_field ? cell_cost : costs[cell + (dy * width) + dx];
+                    _relax(x + dx, y + dy, cell, g + (diagonal_cost * neighbor_cost));
+                }
+            }
+        }
+    }
+}
+
+void igrid_pathfinder::_expand_jump_points(int cell)
+{
+    int x;
+    int y;
+    _coordinates(cell, x, y);
+
+    int g = _cells[cell].g;
+
+    auto jump = [this, cell, x, y, g](int dx, int dy)
+    {
+        int jump_x = x;
+        int jump_y = y;
+
+        if(_jump(dx, dy, jump_x, jump_y))
+        {
+            _relax(jump_x, jump_y, cell, g + _octile_distance(jump_x - x, jump_y - y));
+        }
+    };
+
+    int parent = _cells[cell].parent;
+
+    if(parent < 0)
+    {
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                if(dx || dy)
+                {
+                    jump(dx, dy);
+                }
+            }
+        }
+
+        return;
+    }
+
+    // Only natural and forced neighbors in the direction of the parent move are searched:
+    int parent_x;
+    int parent_y;
+    _coordinates(parent, parent_x, parent_y);
+
+    int dx = _sign(x - parent_x);
+    int dy = _sign(y - parent_y);
+
+    if(dx && dy)
+    {
+        jump(0, dy);
+        jump(dx, 0);
+        jump(dx, dy);
+    }
+    else if(dx)
+    {
+        jump(dx, 0);
+        jump(dx, 1);
+        jump(dx, -1);
+        jump(0, 1);
+        jump(0, -1);
+    }
+    else
+    {
+        jump(0, dy);
+        jump(1, dy);
+        jump(-1, dy);
+        jump(1, 0);
+        jump(-1, 0);
+    }
+}
+
+bool igrid_pathfinder::_jump(int dx, int dy, int& x, int& y) const
+{
+    int jump_x = x;
+    int jump_y = y;
+    bool diagonal = dx && dy;
+
+    while(true)
+    {
+        if(diagonal && (! _walkable(jump_x + dx, jump_y) || ! _walkable(jump_x, jump_y + dy)))
+        {
+            return false;
+        }
+
+        jump_x += dx;
+        jump_y += dy;
+
+        if(! _walkable(jump_x, jump_y))
+        {
+            return false;
+        }
+
+        if(jump_x == _goal_x && jump_y == _goal_y)
+        {
+            break;
+        }
+
+        if(diagonal)
+        {
+            // Diagonal moves stop where a straight move finds a jump point:
+            int straight_x = jump_x;
+            int straight_y = jump_y;
+
+            if(_jump(dx, 0, straight_x, straight_y))
+            {
+                break;
+            }
+
+            straight_x = jump_x;
+            straight_y = jump_y;
+
+            if(_jump(0, dy, straight_x, straight_y))
+            {
+                break;
+            }
+        }
+        else if(dx)
+        {
+            // Since corners can't be cut, neighbors are forced by the obstacles behind them:
+            if((_walkable(jump_x, jump_y - 1) && ! _walkable(jump_x - dx, jump_y - 1)) ||
+                    (_walkable(jump_x, jump_y + 1) && ! _walkable(jump_x - dx, jump_y + 1)))
+            {
+                break;
+            }
+        }
+        else
+        {
+            if((_walkable(jump_x - 1, jump_y) && ! _walkable(jump_x - 1, jump_y - dy)) ||
+                    (_walkable(jump_x + 1, jump_y) && ! _walkable(jump_x + 1, jump_y - dy)))
+            {
+                break;
+            }
+        }
+    }
+
+    x = jump_x;
+    y = jump_y;
+    return true;
+}
+
+}
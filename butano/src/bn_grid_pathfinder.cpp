@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_grid_pathfinder.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] int _sign(int value)
+    {
+        return (value > 0) - (value < 0);
+    }
+}
+
+void igrid_pathfinder::set_cost(int x, int y, int cost)
+{
+    BN_ASSERT(contains(x, y), "Invalid cell: ", x, " - ", y);
+    BN_ASSERT(cost >= 0 && cost <= 255, "Invalid cost: ", cost);
+
+    _costs[(y * _width) + x] = uint8_t(cost);
+}
+
+void igrid_pathfinder::fill_costs(int cost)
+{
+    BN_ASSERT(cost >= 0 && cost <= 255, "Invalid cost: ", cost);
+
+    for(int cell = 0, limit = _width * _height; cell < limit; ++cell)
+    {
+        _costs[cell] = uint8_t(cost);
+    }
+}
+
+void igrid_pathfinder::set_costs(const tile_collision_map& map, unsigned solid_values_mask, int walkable_cost)
+{
+    BN_ASSERT(walkable_cost >= 1 && walkable_cost <= 255, "Invalid walkable cost: ", walkable_cost);
+
+    uint8_t* costs = _costs;
+
+    for(int y = 0; y < _height; ++y)
+    {
+        for(int x = 0; x < _width; ++x)
+        {
+            bool solid = (solid_values_mask >> map.value(x, y)) & 1;
+            *costs = solid ? 0 : uint8_t(walkable_cost);
+            ++costs;
+        }
+    }
+}
+
+void igrid_pathfinder::search_path(const point& start, const point& goal, algorithm_type algorithm)
+{
+    BN_ASSERT(contains(start.x(), start.y()), "Invalid start: ", start.x(), " - ", start.y());
+    BN_ASSERT(contains(goal.x(), goal.y()), "Invalid goal: ", goal.x(), " - ", goal.y());
+
+    _algorithm = algorithm;
+    _flow_field = false;
+    _start(start, goal);
+}
+
+void igrid_pathfinder::search_flow_field(const point& goal, bool diagonal_moves)
+{
+    BN_ASSERT(contains(goal.x(), goal.y()), "Invalid goal: ", goal.x(), " - ", goal.y());
+
+    _algorithm = diagonal_moves ? algorithm_type::A_STAR_8 : algorithm_type::A_STAR_4;
+    _flow_field = true;
+    _start(goal, goal);
+}
+
+int igrid_pathfinder::path_cost() const
+{
+    BN_ASSERT(_status == status_type::FOUND && ! _flow_field, "Path not found");
+
+    return _cells[_goal].g;
+}
+
+void igrid_pathfinder::path(ivector<point>& cells) const
+{
+    int size = path_size();
+    int cells_size = cells.size();
+    BN_ASSERT(cells.max_size() - cells_size >= size, "Not enough space in cells vector: ",
+              cells.max_size() - cells_size, " - ", size);
+
+    // Cells are inserted from the goal to the start:
+    cells.resize(cells_size + size);
+
+    point* cells_data = cells.data() + cells_size + size - 1;
+    int cell = _goal;
+    int x;
+    int y;
+    _coordinates(cell, x, y);
+
+    while(true)
+    {
+        *cells_data = point(x, y);
+        --cells_data;
+
+        int parent = _cells[cell].parent;
+
+        if(parent < 0)
+        {
+            break;
+        }
+
+        // Jump points are not adjacent, but they are always in a straight or diagonal line:
+        int parent_x;
+        int parent_y;
+        _coordinates(parent, parent_x, parent_y);
+
+        int dx = _sign(parent_x - x);
+        int dy = _sign(parent_y - y);
+        x += dx;
+        y += dy;
+
+        while(x != parent_x || y != parent_y)
+        {
+            *cells_data = point(x, y);
+            --cells_data;
+            x += dx;
+            y += dy;
+        }
+
+        cell = parent;
+    }
+}
+
+int igrid_pathfinder::path_size() const
+{
+    BN_ASSERT(_status == status_type::FOUND && ! _flow_field, "Path not found");
+
+    int result = 1;
+    int cell = _goal;
+    int x;
+    int y;
+    _coordinates(cell, x, y);
+
+    for(int parent = _cells[cell].parent; parent >= 0; parent = _cells[parent].parent)
+    {
+        int parent_x;
+        int parent_y;
+        _coordinates(parent, parent_x, parent_y);
+        result += max(abs(parent_x - x), abs(parent_y - y));
+        x = parent_x;
+        y = parent_y;
+    }
+
+    return result;
+}
+
+int igrid_pathfinder::flow_cost(int x, int y) const
+{
+    BN_ASSERT(_status != status_type::IDLE && _flow_field, "Flow field not generated");
+
+    if(! contains(x, y))
+    {
+        return -1;
+    }
+
+    int cell = (y * _width) + x;
+    return _visited(cell) ? _cells[cell].g : -1;
+}
+
+point igrid_pathfinder::flow_direction(int x, int y) const
+{
+    BN_ASSERT(_status != status_type::IDLE && _flow_field, "Flow field not generated");
+
+    if(! contains(x, y))
+    {
+        return point();
+    }
+
+    int cell = (y * _width) + x;
+
+    if(! _visited(cell))
+    {
+        return point();
+    }
+
+    int parent = _cells[cell].parent;
+
+    if(parent < 0)
+    {
+        return point();
+    }
+
+    int parent_x;
+    int parent_y;
+    _coordinates(parent, parent_x, parent_y);
+    return point(parent_x - x, parent_y - y);
+}
+
+igrid_pathfinder::igrid_pathfinder(cell_type* cells, uint8_t* costs, uint16_t* stamps, int16_t* heap,
+                                   int width, int height) :
+    _cells(cells),
+    _costs(costs),
+    _stamps(stamps),
+    _heap(heap),
+    _row_reciprocal((1 << 16) / width),
+    _width(int16_t(width)),
+    _height(int16_t(height))
+{
+}
+
+void igrid_pathfinder::_start(const point& first_cell, const point& goal)
+{
+    ++_stamp;
+
+    // Cells are marked as visited with a search counter, so they don't have to be reset for each search:
+    if(! _stamp)
+    {
+        for(int cell = 0, limit = _width * _height; cell < limit; ++cell)
+        {
+            _stamps[cell] = 0;
+        }
+
+        _stamp = 1;
+    }
+
+    _heap_size = 0;
+    _goal = (goal.y() * _width) + goal.x();
+    _goal_x = int16_t(goal.x());
+    _goal_y = int16_t(goal.y());
+
+    if(_walkable(first_cell.x(), first_cell.y()) && _walkable(goal.x(), goal.y()))
+    {
+        _status = status_type::SEARCHING;
+        _relax(first_cell.x(), first_cell.y(), -1, 0);
+    }
+    else
+    {
+        _status = _flow_field ? status_type::FOUND : status_type::NOT_FOUND;
+    }
+}
+
+}
@@ -6,6 +6,7 @@
 #include "bn_hblank_effects_manager.h"
 
 #include "bn_vector.h"
+#include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_hblank_effects.h"
 
 #include "bn_bg_palette_color_hbe_handler.h"
@@ -87,6 +88,10 @@ namespace
     using last_value_type = any<4 * sizeof(int)>;
     using hw_entries = hw::hblank_effects::entries;
 
+    constexpr int max_composites = min(BN_CFG_HBES_MAX_COMPOSITES, max_uint32_output_values);
+
+    static_assert(max_composites >= 0);
+
     [[nodiscard]] bool _is_uint32(handler_type handler)
     {
         switch(handler)
@@ -221,6 +226,29 @@ namespace
         }
     }
 
+    [[nodiscard]] bool _direct_values(handler_type handler, const void* values_ptr)
+    {
+        // Register values are copied as they are, so immutable ROM tables can be read directly:
+        switch(handler)
+        {
+
+        case handler_type::AFFINE_BG_PA_REGISTER_VALUES:
+        case handler_type::AFFINE_BG_PB_REGISTER_VALUES:
+        case handler_type::AFFINE_BG_PC_REGISTER_VALUES:
+        case handler_type::AFFINE_BG_PD_REGISTER_VALUES:
+        case handler_type::AFFINE_BG_DX_REGISTER_VALUES:
+        case handler_type::AFFINE_BG_DY_REGISTER_VALUES:
+        case handler_type::SPRITE_AFFINE_MAT_PA_REGISTER_VALUES:
+        case handler_type::SPRITE_AFFINE_MAT_PB_REGISTER_VALUES:
+        case handler_type::SPRITE_AFFINE_MAT_PC_REGISTER_VALUES:
+        case handler_type::SPRITE_AFFINE_MAT_PD_REGISTER_VALUES:
+            return hw::memory::in_rom(values_ptr);
+
+        default:
+            return false;
+        }
+    }
+
     class uint16_output_values_type
     {
 
@@ -239,6 +267,14 @@ namespace
         bool a_active = false;
     };
 
+    class composite_output_values_type
+    {
+
+    public:
+        alignas(int) uint32_t values[display::height()];
+    };
+
+
     class item_type
     {
 
@@ -256,6 +292,11 @@ namespace
         bool on_screen: 1 = false;
         bool output_values_written: 1 = false;
 
+        [[nodiscard]] bool direct_values() const
+        {
+            return ! uint16_output_values && ! uint32_output_values;
+        }
+
         void setup_target()
         {
             switch(handler)
@@ -575,7 +616,17 @@ namespace
                 BN_ASSERT(entries.uint32_entries_count < max_uint32_output_values, "Too much 32 bits entries");
 
                 hw::hblank_effects::uint32_entry& uint32_entry = entries.uint32_entries[entries.uint32_entries_count];
-                const uint16_t* src = uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
+                const uint16_t* src;
+
+                if(uint32_output_values)
+                {
+                    src = uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
+                }
+                else
+                {
+                    src = static_cast<const uint16_t*>(values_ptr);
+                }
+
                 uint32_entry.src = reinterpret_cast<const uint32_t*>(src);
                 uint32_entry.dest = reinterpret_cast<uint32_t*>(output_register);
                 ++entries.uint32_entries_count;
@@ -588,10 +639,14 @@ namespace
                 {
                     uint16_entry.src = uint16_output_values->a_active ? uint16_output_values->a : uint16_output_values->b;
                 }
-                else
+                else if(uint32_output_values)
                 {
                     uint16_entry.src = uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
                 }
+                else
+                {
+                    uint16_entry.src = static_cast<const uint16_t*>(values_ptr);
+                }
 
                 uint16_entry.dest = output_register;
                 ++entries.uint16_entries_count;
@@ -983,6 +1038,42 @@ namespace
             return output_values_ptr;
         }
 
+        [[nodiscard]] __attribute__((noinline)) bool _output_values_changed() const
+        {
+            const uint16_t* a;
+            const uint16_t* b;
+            int words_count;
+
+            if(uint16_output_values)
+            {
+                a = uint16_output_values->a;
+                b = uint16_output_values->b;
+                words_count = display::height() / 2;
+            }
+            else
+            {
+                a = uint32_output_values->a;
+                b = uint32_output_values->b;
+                words_count = display::height();
+            }
+
+            auto a_words = reinterpret_cast<const unsigned*>(a);
+            auto b_words = reinterpret_cast<const unsigned*>(b);
+            return ! equal(a_words, a_words + words_count, b_words);
+        }
+
+        void _restore_output_values()
+        {
+            if(uint16_output_values)
+            {
+                uint16_output_values->a_active = ! uint16_output_values->a_active;
+            }
+            else
+            {
+                uint32_output_values->a_active = ! uint32_output_values->a_active;
+            }
+        }
+
         template<class Handler>
         [[nodiscard]] bool _check_update_impl(bool updated)
         {
@@ -994,16 +1085,29 @@ namespace
             {
                 updated |= Handler::target_updated(target_id, target_last_value);
 
-                if(! output_values_written)
+                if(direct_values())
+                {
+                    updated |= ! output_values_written;
+                    output_values_written = true;
+                }
+                else if(! output_values_written)
                 {
+                    uint16_t* output_values_ptr = _output_values_ptr();
+                    Handler::write_output_values(target_id, target_last_value, values_ptr, output_values_ptr);
                     updated = true;
                     output_values_written = true;
                 }
-
-                if(updated)
+                else if(updated)
                 {
                     uint16_t* output_values_ptr = _output_values_ptr();
                     Handler::write_output_values(target_id, target_last_value, values_ptr, output_values_ptr);
+
+                    // Keep the previous buffer if the new values are the same (ping-pong animations, etc):
+                    if(! _output_values_changed())
+                    {
+                        _restore_output_values();
+                        updated = false;
+                    }
                 }
 
                 uint16_t* old_output_register = output_register;
@@ -1026,6 +1130,12 @@ namespace
         vector<int8_t, max_items> free_item_indexes;
         vector<int8_t, max_uint16_output_values> free_uint16_output_values_indexes;
         vector<int8_t, max_uint32_output_values> free_uint32_output_values_indexes;
+
+        #if BN_CFG_HBES_MAX_COMPOSITES > 0
+            composite_output_values_type composite_output_values_a[max_composites];
+            composite_output_values_type composite_output_values_b[max_composites];
+        #endif
+
         int8_t first_visible_item_index = max_items - 1;
         int8_t last_visible_item_index = 0;
         bool visible_entries = false;
@@ -1043,7 +1153,11 @@ namespace
         hw_entries entries_b;
     };
 
-    BN_DATA_EWRAM static_external_data external_data;
+    #if BN_CFG_HBES_DATA_IWRAM
+        static_external_data external_data;
+    #else
+        BN_DATA_EWRAM static_external_data external_data;
+    #endif
     static_internal_data internal_data;
 
     void _update_visible_item_index(int item_index)
@@ -1058,6 +1172,70 @@ namespace
         }
     }
 
+    #if BN_CFG_HBES_MAX_COMPOSITES > 0
+        void _erase_uint16_entry(int entry_index, hw_entries& entries)
+        {
+            int last_entry_index = entries.uint16_entries_count - 1;
+
+            for(int index = entry_index; index < last_entry_index; ++index)
+            {
+                entries.uint16_entries[index] = entries.uint16_entries[index + 1];
+            }
+
+            entries.uint16_entries_count = last_entry_index;
+        }
+
+        void _composite_entries(composite_output_values_type* composite_output_values, hw_entries& entries)
+        {
+            int composites_count = 0;
+            int entry_index = 0;
+
+            while(entry_index < entries.uint16_entries_count && composites_count < max_composites &&
+                  entries.uint32_entries_count < max_uint32_output_values)
+            {
+                hw::hblank_effects::uint16_entry low_entry = entries.uint16_entries[entry_index];
+                int high_entry_index = -1;
+
+                if(reinterpret_cast<uintptr_t>(low_entry.dest) % 4 == 0)
+                {
+                    for(int index = 0, limit = entries.uint16_entries_count; index < limit; ++index)
+                    {
+                        if(entries.uint16_entries[index].dest == low_entry.dest + 1)
+                        {
+                            high_entry_index = index;
+                            break;
+                        }
+                    }
+                }
+
+                if(high_entry_index < 0)
+                {
+                    ++entry_index;
+                    continue;
+                }
+
+                // Interleave both streams so the H-Blank interrupt writes both registers at once:
+                const uint16_t* low_src = low_entry.src;
+                const uint16_t* high_src = entries.uint16_entries[high_entry_index].src;
+                uint32_t* values = composite_output_values[composites_count].values;
+
+                for(int index = 0; index < display::height(); ++index)
+                {
+                    values[index] = low_src[index] | (uint32_t(high_src[index]) << 16);
+                }
+
+                hw::hblank_effects::uint32_entry& uint32_entry = entries.uint32_entries[entries.uint32_entries_count];
+                uint32_entry.src = values;
+                uint32_entry.dest = reinterpret_cast<volatile uint32_t*>(low_entry.dest);
+                ++entries.uint32_entries_count;
+                ++composites_count;
+
+                _erase_uint16_entry(max(entry_index, high_entry_index), entries);
+                _erase_uint16_entry(min(entry_index, high_entry_index), entries);
+            }
+        }
+    #endif
+
     void _update_hidden_item_index(int item_index)
     {
         static_external_data& data = external_data;
@@ -1070,31 +1248,20 @@ namespace
         }
     }
 
-    [[nodiscard]] int _create(const void* values_ptr, intptr_t target_id, handler_type handler, bool optional)
+    [[nodiscard]] bool _allocate_output_values(handler_type handler, bool optional, item_type& item)
     {
-        BN_ASSERT(aligned<alignof(int)>(values_ptr), "Values are not aligned");
-
-        if(external_data.free_item_indexes.empty())
-        {
-            BN_ASSERT(optional, "No more available H-Blank effects");
-            return -1;
-        }
-
-        uint16_output_values_type* uint16_output_values = nullptr;
-        uint32_output_values_type* uint32_output_values = nullptr;
-
         if(_is_uint32(handler))
         {
             if(! external_data.free_uint32_output_values_indexes.empty())
             {
                 int output_values_index = external_data.free_uint32_output_values_indexes.back();
                 external_data.free_uint32_output_values_indexes.pop_back();
-                uint32_output_values = &external_data.uint32_output_values_array[output_values_index];
+                item.uint32_output_values = &external_data.uint32_output_values_array[output_values_index];
             }
             else
             {
                 BN_ASSERT(optional, "No more available 32 bits H-Blank effects");
-                return -1;
+                return false;
             }
         }
         else
@@ -1103,31 +1270,66 @@ namespace
             {
                 int output_values_index = external_data.free_uint16_output_values_indexes.back();
                 external_data.free_uint16_output_values_indexes.pop_back();
-                uint16_output_values = &external_data.uint16_output_values_array[output_values_index];
+                item.uint16_output_values = &external_data.uint16_output_values_array[output_values_index];
             }
             else if(! external_data.free_uint32_output_values_indexes.empty())
             {
                 int output_values_index = external_data.free_uint32_output_values_indexes.back();
                 external_data.free_uint32_output_values_indexes.pop_back();
-                uint32_output_values = &external_data.uint32_output_values_array[output_values_index];
+                item.uint32_output_values = &external_data.uint32_output_values_array[output_values_index];
             }
             else
             {
                 BN_ASSERT(optional, "No more available 32 bits H-Blank effects");
-                return -1;
+                return false;
             }
         }
 
+        return true;
+    }
+
+    void _free_output_values(item_type& item)
+    {
+        if(item.uint16_output_values)
+        {
+            int output_values_index = item.uint16_output_values - external_data.uint16_output_values_array;
+            external_data.free_uint16_output_values_indexes.push_back(int8_t(output_values_index));
+            item.uint16_output_values = nullptr;
+        }
+        else if(item.uint32_output_values)
+        {
+            int output_values_index = item.uint32_output_values - external_data.uint32_output_values_array;
+            external_data.free_uint32_output_values_indexes.push_back(int8_t(output_values_index));
+            item.uint32_output_values = nullptr;
+        }
+    }
+
+    [[nodiscard]] int _create(const void* values_ptr, intptr_t target_id, handler_type handler, bool optional)
+    {
+        BN_ASSERT(aligned<alignof(int)>(values_ptr), "Values are not aligned");
+
+        if(external_data.free_item_indexes.empty())
+        {
+            BN_ASSERT(optional, "No more available H-Blank effects");
+            return -1;
+        }
+
         int item_index = external_data.free_item_indexes.back();
+        item_type& new_item = external_data.items[item_index];
+        new_item.uint16_output_values = nullptr;
+        new_item.uint32_output_values = nullptr;
+
+        if(! _direct_values(handler, values_ptr) && ! _allocate_output_values(handler, optional, new_item))
+        {
+            return -1;
+        }
+
         external_data.free_item_indexes.pop_back();
 
-        item_type& new_item = external_data.items[item_index];
         new_item.values_ptr = values_ptr;
         new_item.target_id = target_id;
         new_item.usages = 1;
         new_item.output_register = nullptr;
-        new_item.uint16_output_values = uint16_output_values;
-        new_item.uint32_output_values = uint32_output_values;
         new_item.handler = handler;
         new_item.visible = true;
         new_item.update = true;
@@ -1224,17 +1426,7 @@ void decrease_usages(int id)
             external_data.update = true;
         }
 
-        if(item.uint16_output_values)
-        {
-            int output_values_index = item.uint16_output_values - external_data.uint16_output_values_array;
-            external_data.free_uint16_output_values_indexes.push_back(int8_t(output_values_index));
-        }
-        else
-        {
-            int output_values_index = item.uint32_output_values - external_data.uint32_output_values_array;
-            external_data.free_uint32_output_values_indexes.push_back(int8_t(output_values_index));
-        }
-
+        _free_output_values(item);
         external_data.free_item_indexes.push_back(int8_t(id));
         item.target_last_value.reset();
         item.update = false;
@@ -1253,6 +1445,22 @@ void set_values_ref(int id, const void* values_ptr, [[maybe_unused]] int values_
     BN_ASSERT(aligned<alignof(int)>(values_ptr), "Values are not aligned");
 
     item_type& item = external_data.items[id];
+    bool direct_values = _direct_values(item.handler, values_ptr);
+
+    if(direct_values != item.direct_values())
+    {
+        if(direct_values)
+        {
+            _free_output_values(item);
+        }
+        else
+        {
+            [[maybe_unused]] bool allocated = _allocate_output_values(item.handler, false, item);
+        }
+
+        item.output_values_written = false;
+    }
+
     item.values_ptr = values_ptr;
     item.update = true;
 
@@ -1364,6 +1572,11 @@ void update()
         entries->uint16_entries_count = 0;
         entries->uint32_entries_count = 0;
 
+        #if BN_CFG_HBES_MAX_COMPOSITES > 0
+            composite_output_values_type* composite_output_values = external_data.entries_a_active ?
+                        external_data.composite_output_values_a : external_data.composite_output_values_b;
+        #endif
+
         for(int item_index = first_visible_item_index; item_index <= last_visible_item_index; ++item_index)
         {
             const item_type& item = external_data.items[item_index];
@@ -1375,11 +1588,50 @@ void update()
             }
         }
 
+        #if BN_CFG_HBES_MAX_COMPOSITES > 0
+            if(entries->uint16_entries_count > 1)
+            {
+                _composite_entries(composite_output_values, *entries);
+            }
+        #endif
+
         external_data.visible_entries = visible_entries;
         external_data.commit = true;
     }
 }
 
+bool output_register_written(const void* register_ptr)
+{
+    // Entries of the last update are checked, since they are committed before the first screen line:
+    if(! external_data.visible_entries)
+    {
+        return false;
+    }
+
+    const hw_entries& entries = external_data.entries_a_active ? internal_data.entries_a : internal_data.entries_b;
+    auto register_address = reinterpret_cast<uintptr_t>(register_ptr);
+
+    for(int index = 0, limit = entries.uint16_entries_count; index < limit; ++index)
+    {
+        if(reinterpret_cast<uintptr_t>(entries.uint16_entries[index].dest) == register_address)
+        {
+            return true;
+        }
+    }
+
+    for(int index = 0, limit = entries.uint32_entries_count; index < limit; ++index)
+    {
+        auto dest_address = reinterpret_cast<uintptr_t>(entries.uint32_entries[index].dest);
+
+        if(register_address >= dest_address && register_address < dest_address + 4)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void commit()
 {
     if(external_data.commit)
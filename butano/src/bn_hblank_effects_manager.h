@@ -86,6 +86,8 @@ namespace bn::hblank_effects_manager
 
     void update();
 
+    [[nodiscard]] bool output_register_written(const void* register_ptr);
+
     void commit();
 }
 
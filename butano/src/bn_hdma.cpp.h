@@ -1,48 +1,115 @@
-/*
- * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
- * zlib License, see LICENSE file.
- */
-
-#include "bn_hdma.h"
-
-#include "bn_assert.h"
-#include "bn_hdma_manager.h"
-
-namespace bn::hdma
-{
-
-bool running()
-{
-    return hdma_manager::low_priority_running();
-}
-
-void start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
-{
-    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
-
-    hdma_manager::low_priority_start(source_ref, elements, destination_ref);
-}
-
-void stop()
-{
-    hdma_manager::low_priority_stop();
-}
-
-bool high_priority_running()
-{
-    return hdma_manager::high_priority_running();
-}
-
-void high_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
-{
-    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
-
-    hdma_manager::high_priority_start(source_ref, elements, destination_ref);
-}
-
-void high_priority_stop()
-{
-    hdma_manager::high_priority_stop();
-}
-
-}
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_hdma.h"
+
+#include "bn_assert.h"
+#include "bn_hdma_manager.h"
+#include "bn_config_sprites.h"
+
+namespace bn::hdma
+{
+
+bool running()
+{
+    return hdma_manager::low_priority_running();
+}
+
+void start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    hdma_manager::low_priority_start(source_ref, elements, destination_ref);
+}
+
+void stop()
+{
+    hdma_manager::low_priority_stop();
+}
+
+void publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    hdma_manager::low_priority_publish(source_ref, elements, destination_ref);
+}
+
+const uint16_t* displayed_source()
+{
+    return hdma_manager::low_priority_displayed_source();
+}
+
+bool medium_priority_running()
+{
+    BN_ASSERT(! BN_CFG_SPRITES_MULTIPLEXER_ENABLED,
+              "Medium priority HDMA is not available when sprites multiplexer is enabled");
+
+    return hdma_manager::medium_priority_running();
+}
+
+void medium_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(! BN_CFG_SPRITES_MULTIPLEXER_ENABLED,
+              "Medium priority HDMA is not available when sprites multiplexer is enabled");
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    hdma_manager::medium_priority_start(source_ref, elements, destination_ref);
+}
+
+void medium_priority_stop()
+{
+    BN_ASSERT(! BN_CFG_SPRITES_MULTIPLEXER_ENABLED,
+              "Medium priority HDMA is not available when sprites multiplexer is enabled");
+
+    hdma_manager::medium_priority_stop();
+}
+
+void medium_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(! BN_CFG_SPRITES_MULTIPLEXER_ENABLED,
+              "Medium priority HDMA is not available when sprites multiplexer is enabled");
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    hdma_manager::medium_priority_publish(source_ref, elements, destination_ref);
+}
+
+const uint16_t* medium_priority_displayed_source()
+{
+    BN_ASSERT(! BN_CFG_SPRITES_MULTIPLEXER_ENABLED,
+              "Medium priority HDMA is not available when sprites multiplexer is enabled");
+
+    return hdma_manager::medium_priority_displayed_source();
+}
+
+bool high_priority_running()
+{
+    return hdma_manager::high_priority_running();
+}
+
+void high_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    hdma_manager::high_priority_start(source_ref, elements, destination_ref);
+}
+
+void high_priority_stop()
+{
+    hdma_manager::high_priority_stop();
+}
+
+void high_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(elements > 0, "Invalid elements: ", elements);
+
+    hdma_manager::high_priority_publish(source_ref, elements, destination_ref);
+}
+
+const uint16_t* high_priority_displayed_source()
+{
+    return hdma_manager::high_priority_displayed_source();
+}
+
+}
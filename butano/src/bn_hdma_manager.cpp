@@ -5,7 +5,9 @@
 
 #include "bn_hdma_manager.h"
 
+#include "bn_assert.h"
 #include "bn_display.h"
+#include "bn_config_pcm_stream.h"
 #include "../hw/include/bn_hw_hdma.h"
 #include "../hw/include/bn_hw_memory.h"
 
@@ -36,7 +38,28 @@ namespace
 
         [[nodiscard]] bool running() const
         {
-            return _next_state().elements;
+            return _ready ? _ready_state.elements : _next_state().elements;
+        }
+
+        [[nodiscard]] const uint16_t* displayed_source() const
+        {
+            const state& current_state = _current_state();
+            return current_state.elements ? current_state.source_ptr : nullptr;
+        }
+
+        [[nodiscard]] bool overlaps(const uint16_t& destination_ref, int elements) const
+        {
+            const state& next_state = _next_state();
+
+            if(! next_state.elements)
+            {
+                return false;
+            }
+
+            const uint16_t* destination_ptr = &destination_ref;
+            const uint16_t* next_destination_ptr = next_state.destination_ptr;
+            return destination_ptr < next_destination_ptr + next_state.elements &&
+                    next_destination_ptr < destination_ptr + elements;
         }
 
         void disable()
@@ -60,11 +83,26 @@ namespace
             _updated = true;
         }
 
+        void publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+        {
+            // The ready flag is cleared while the ready state is written, so commit never reads a partial state:
+            _ready = false;
+            BN_BARRIER;
+
+            _ready_state.source_ptr = &source_ref;
+            _ready_state.destination_ptr = &destination_ref;
+            _ready_state.elements = elements;
+            BN_BARRIER;
+
+            _ready = true;
+        }
+
         void force_stop()
         {
             _states[0].elements = 0;
             _states[1].elements = 0;
             _updated = false;
+            _ready = false;
             disable();
         }
 
@@ -89,6 +127,15 @@ namespace
 
         void commit()
         {
+            // Published states are taken at the next V-Blank, even if update has not been called:
+            if(_ready)
+            {
+                _states[0] = _ready_state;
+                _states[1] = _ready_state;
+                _updated = false;
+                _ready = false;
+            }
+
             const state& current_state = _current_state();
 
             if(int elements = current_state.elements)
@@ -107,9 +154,11 @@ namespace
 
     private:
         state _states[2];
+        state _ready_state;
         int8_t _channel = 0;
         int8_t _current_state_index = 0;
         bool _updated = false;
+        volatile bool _ready = false;
 
         [[nodiscard]] const state& _current_state() const
         {
@@ -132,15 +181,65 @@ namespace
         }
     };
 
+    enum class priority
+    {
+        LOW,
+        HIGH,
+        MEDIUM
+    };
+
+    // Medium priority channel is the last one, so it can be skipped if it's reserved for PCM streams:
+    constexpr int entries_count = BN_CFG_PCM_STREAM_ENABLED ? 2 : 3;
+
+
     class static_data
     {
 
     public:
-        entry low_priority_entry = entry(hw::hdma::low_priority_channel());
-        entry high_priority_entry = entry(hw::hdma::high_priority_channel());
+        entry entries[3] = {
+            entry(hw::hdma::low_priority_channel()),
+            entry(hw::hdma::high_priority_channel()),
+            entry(hw::hdma::medium_priority_channel())
+        };
     };
 
     BN_DATA_EWRAM static_data data;
+
+    void _start(priority entry_priority, const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+    {
+        int entry_index = int(entry_priority);
+
+        #if BN_CFG_ASSERT_FULL_ENABLED
+            for(int index = 0; index < entries_count; ++index)
+            {
+                if(index != entry_index)
+                {
+                    BN_FULL_ASSERT(! data.entries[index].overlaps(destination_ref, elements),
+                                   "HDMA destination conflict: ", entry_index, " - ", index);
+                }
+            }
+        #endif
+
+        data.entries[entry_index].start(source_ref, elements, destination_ref);
+    }
+
+    void _publish(priority entry_priority, const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+    {
+        int entry_index = int(entry_priority);
+
+        #if BN_CFG_ASSERT_FULL_ENABLED
+            for(int index = 0; index < entries_count; ++index)
+            {
+                if(index != entry_index)
+                {
+                    BN_FULL_ASSERT(! data.entries[index].overlaps(destination_ref, elements),
+                                   "HDMA destination conflict: ", entry_index, " - ", index);
+                }
+            }
+        #endif
+
+        data.entries[entry_index].publish(source_ref, elements, destination_ref);
+    }
 }
 
 void enable()
@@ -150,56 +249,119 @@ void enable()
 
 void disable()
 {
-    data.low_priority_entry.disable();
-    data.high_priority_entry.disable();
+    for(int index = 0; index < entries_count; ++index)
+    {
+        data.entries[index].disable();
+    }
 }
 
 void force_stop()
 {
-    data.low_priority_entry.force_stop();
-    data.high_priority_entry.force_stop();
+    for(int index = 0; index < entries_count; ++index)
+    {
+        data.entries[index].force_stop();
+    }
 }
 
 bool low_priority_running()
 {
-    return data.low_priority_entry.running();
+    return data.entries[int(priority::LOW)].running();
 }
 
 void low_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
 {
-    data.low_priority_entry.start(source_ref, elements, destination_ref);
+    _start(priority::LOW, source_ref, elements, destination_ref);
 }
 
 void low_priority_stop()
 {
-    data.low_priority_entry.stop();
+    data.entries[int(priority::LOW)].stop();
+}
+
+void low_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    _publish(priority::LOW, source_ref, elements, destination_ref);
+}
+
+const uint16_t* low_priority_displayed_source()
+{
+    return data.entries[int(priority::LOW)].displayed_source();
+}
+
+bool medium_priority_running()
+{
+    BN_ASSERT(! BN_CFG_PCM_STREAM_ENABLED, "Medium priority HDMA is not available when PCM streams are enabled");
+
+    return data.entries[int(priority::MEDIUM)].running();
+}
+
+void medium_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(! BN_CFG_PCM_STREAM_ENABLED, "Medium priority HDMA is not available when PCM streams are enabled");
+
+    _start(priority::MEDIUM, source_ref, elements, destination_ref);
+}
+
+void medium_priority_stop()
+{
+    BN_ASSERT(! BN_CFG_PCM_STREAM_ENABLED, "Medium priority HDMA is not available when PCM streams are enabled");
+
+    data.entries[int(priority::MEDIUM)].stop();
+}
+
+void medium_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    BN_ASSERT(! BN_CFG_PCM_STREAM_ENABLED, "Medium priority HDMA is not available when PCM streams are enabled");
+
+    _publish(priority::MEDIUM, source_ref, elements, destination_ref);
+}
+
+const uint16_t* medium_priority_displayed_source()
+{
+    BN_ASSERT(! BN_CFG_PCM_STREAM_ENABLED, "Medium priority HDMA is not available when PCM streams are enabled");
+
+    return data.entries[int(priority::MEDIUM)].displayed_source();
 }
 
 bool high_priority_running()
 {
-    return data.high_priority_entry.running();
+    return data.entries[int(priority::HIGH)].running();
 }
 
 void high_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
 {
-    data.high_priority_entry.start(source_ref, elements, destination_ref);
+    _start(priority::HIGH, source_ref, elements, destination_ref);
 }
 
 void high_priority_stop()
 {
-    data.high_priority_entry.stop();
+    data.entries[int(priority::HIGH)].stop();
+}
+
+void high_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    _publish(priority::HIGH, source_ref, elements, destination_ref);
+}
+
+const uint16_t* high_priority_displayed_source()
+{
+    return data.entries[int(priority::HIGH)].displayed_source();
 }
 
 void update()
 {
-    data.low_priority_entry.update();
-    data.high_priority_entry.update();
+    for(int index = 0; index < entries_count; ++index)
+    {
+        data.entries[index].update();
+    }
 }
 
 void commit()
 {
-    data.low_priority_entry.commit();
-    data.high_priority_entry.commit();
+    for(int index = 0; index < entries_count; ++index)
+    {
+        data.entries[index].commit();
+    }
 }
 
 }
@@ -22,12 +22,30 @@ namespace bn::hdma_manager
 
     void low_priority_stop();
 
+    void low_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    [[nodiscard]] const uint16_t* low_priority_displayed_source();
+
+    [[nodiscard]] bool medium_priority_running();
+
+    void medium_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    void medium_priority_stop();
+
+    void medium_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    [[nodiscard]] const uint16_t* medium_priority_displayed_source();
+
     [[nodiscard]] bool high_priority_running();
 
     void high_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
 
     void high_priority_stop();
 
+    void high_priority_publish(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    [[nodiscard]] const uint16_t* high_priority_displayed_source();
+
     void update();
 
     void commit();
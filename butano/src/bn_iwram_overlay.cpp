@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_iwram_overlay.h"
+
+#include "bn_assert.h"
+#include "../hw/include/bn_hw_memory.h"
+
+namespace bn::iwram_overlay
+{
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        optional<int> loaded_id;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+int count()
+{
+    return hw::memory::iwram_overlays_count();
+}
+
+int size(int id)
+{
+    BN_ASSERT(id >= 0 && id < hw::memory::iwram_overlays_count(), "Invalid id: ", id);
+
+    return hw::memory::iwram_overlay_size(id);
+}
+
+optional<int> loaded_id()
+{
+    return data.loaded_id;
+}
+
+void load(int id)
+{
+    if(data.loaded_id != id)
+    {
+        reload(id);
+    }
+}
+
+void reload(int id)
+{
+    BN_ASSERT(id >= 0 && id < hw::memory::iwram_overlays_count(), "Invalid id: ", id);
+
+    hw::memory::load_iwram_overlay(id);
+    data.loaded_id = id;
+}
+
+}
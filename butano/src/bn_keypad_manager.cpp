@@ -5,6 +5,7 @@
 
 #include "bn_keypad_manager.h"
 
+#include "bn_span.h"
 #include "bn_string_view.h"
 #include "bn_config_keypad.h"
 #include "../hw/include/bn_hw_keypad.h"
@@ -23,7 +24,72 @@ namespace bn::keypad_manager
 
 namespace
 {
-    #if BN_CFG_KEYPAD_LOG_ENABLED
+    constexpr int run_keys_bits = 10;
+    constexpr unsigned run_keys_mask = (1 << run_keys_bits) - 1;
+    constexpr int max_run_frames = 1 << (16 - run_keys_bits);
+
+    #if BN_CFG_KEYPAD_LOG_ENABLED && BN_CFG_KEYPAD_LOG_BINARY
+        class keypad_logger
+        {
+
+        public:
+            keypad_logger()
+            {
+                BN_LOG("-- KEYPAD BINARY LOGGER INIT ---");
+            }
+
+            void log(unsigned keys)
+            {
+                if(_run_frames && (keys != _run_keys || _run_frames == max_run_frames))
+                {
+                    _append_run();
+                }
+
+                _run_keys = keys;
+                ++_run_frames;
+            }
+
+            void flush()
+            {
+                if(_run_frames)
+                {
+                    _append_run();
+                }
+
+                if(! _buffer.empty())
+                {
+                    BN_LOG(_buffer);
+                    _buffer.clear();
+                }
+            }
+
+        private:
+            string<BN_CFG_LOG_MAX_SIZE - 8> _buffer;
+            unsigned _run_keys = 0;
+            int _run_frames = 0;
+
+            void _append_run()
+            {
+                constexpr char digits[] = "0123456789abcdef";
+                unsigned run = ((unsigned(_run_frames) - 1) << run_keys_bits) | _run_keys;
+                _buffer.append("0x");
+
+                for(int shift = 12; shift >= 0; shift -= 4)
+                {
+                    _buffer.append(digits[(run >> shift) & 0xF]);
+                }
+
+                _buffer.append(',');
+                _run_frames = 0;
+
+                if(_buffer.available() < 7)
+                {
+                    BN_LOG(_buffer);
+                    _buffer.clear();
+                }
+            }
+        };
+    #elif BN_CFG_KEYPAD_LOG_ENABLED
         class keypad_logger
         {
 
@@ -65,9 +131,11 @@ namespace
 
     public:
         string_view commands;
+        span<const uint16_t> runs;
         unsigned held_keys = 0;
         unsigned pressed_keys = 0;
         unsigned released_keys = 0;
+        int run_frames = 0;
         bool read_commands = false;
 
         #if BN_CFG_KEYPAD_LOG_ENABLED
@@ -78,12 +146,14 @@ namespace
     BN_DATA_EWRAM static_data data;
 }
 
-void init(const string_view& commands)
+void init(const string_view& commands, const span<const uint16_t>& runs)
 {
     BN_ASSERT(commands.size() % 2 == 0, "Invalid commands size: ", commands.size());
+    BN_ASSERT(commands.empty() || runs.empty(), "Keypad commands and runs can't be replayed at the same time");
 
     data.commands = commands;
-    data.read_commands = ! commands.empty();
+    data.runs = runs;
+    data.read_commands = ! commands.empty() || ! runs.empty();
 }
 
 bool held(key_type key)
@@ -116,6 +186,11 @@ bool any_released()
     return data.released_keys;
 }
 
+bool replaying()
+{
+    return data.read_commands;
+}
+
 void update()
 {
     unsigned previous_keys = data.held_keys;
@@ -123,7 +198,19 @@ void update()
 
     if(data.read_commands) [[unlikely]]
     {
-        if(data.commands.empty()) [[unlikely]]
+        if(! data.runs.empty())
+        {
+            unsigned run = data.runs[0];
+            current_keys = run & run_keys_mask;
+            ++data.run_frames;
+
+            if(data.run_frames > int(run >> run_keys_bits))
+            {
+                data.run_frames = 0;
+                data.runs = data.runs.subspan(1);
+            }
+        }
+        else if(data.commands.empty()) [[unlikely]]
         {
             current_keys = hw::keypad::get();
             data.read_commands = false;
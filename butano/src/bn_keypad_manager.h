@@ -18,7 +18,7 @@ namespace bn::keypad_manager
 {
     using key_type = keypad::key_type;
 
-    void init(const string_view& commands);
+    void init(const string_view& commands, const span<const uint16_t>& runs);
 
     [[nodiscard]] bool held(key_type key);
 
@@ -32,6 +32,8 @@ namespace bn::keypad_manager
 
     [[nodiscard]] bool any_released();
 
+    [[nodiscard]] bool replaying();
+
     void update();
 
     void set_interrupt(const span<const key_type>& keys);
@@ -1,32 +1,62 @@
-/*
- * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
- * zlib License, see LICENSE file.
- */
-
-#include "bn_link.h"
-
-#include "bn_optional.h"
-#include "bn_link_state.h"
-#include "bn_link_manager.h"
-
-namespace bn::link
-{
-
-void send(int data_to_send)
-{
-    BN_ASSERT(data_to_send >= 0 && data_to_send <= 65533, "Invalid data to send: ", data_to_send);
-
-    link_manager::send(data_to_send);
-}
-
-optional<link_state> receive()
-{
-    return link_manager::receive();
-}
-
-void deactivate()
-{
-    link_manager::deactivate();
-}
-
-}
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link.h"
+
+#include "bn_optional.h"
+#include "bn_link_stats.h"
+#include "bn_link_state.h"
+#include "bn_link_packet.h"
+#include "bn_link_manager.h"
+
+namespace bn::link
+{
+
+void send(int data_to_send)
+{
+    BN_ASSERT(data_to_send >= 0 && data_to_send <= 65533, "Invalid data to send: ", data_to_send);
+
+    link_manager::send(data_to_send);
+}
+
+optional<link_state> receive()
+{
+    return link_manager::receive();
+}
+
+bool send(const span<const uint16_t>& packet)
+{
+    BN_ASSERT(! packet.empty() && packet.size() <= BN_CFG_LINK_MAX_PACKET_SIZE,
+              "Invalid packet size: ", packet.size(), " - ", BN_CFG_LINK_MAX_PACKET_SIZE);
+
+    for(uint16_t word : packet)
+    {
+        BN_ASSERT(word <= 65532, "Invalid packet word: ", word);
+    }
+
+    return link_manager::send(packet);
+}
+
+optional<link_packet> receive_packet()
+{
+    return link_manager::receive_packet();
+}
+
+void deactivate()
+{
+    link_manager::deactivate();
+}
+
+link_stats stats()
+{
+    return link_manager::stats();
+}
+
+void reset_stats()
+{
+    link_manager::reset_stats();
+}
+
+}
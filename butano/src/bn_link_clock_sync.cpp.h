@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_clock_sync.h"
+
+#include "bn_link.h"
+#include "bn_timers.h"
+#include "bn_algorithm.h"
+#include "bn_link_packet.h"
+#include "bn_link_manager.h"
+
+namespace bn
+{
+
+namespace
+{
+    // Packet types 0 and 1 are used by bn::link_lockstep:
+    constexpr int clock_sync_packet_type_shift = 14;
+    constexpr int clock_sync_packet_type = 2;
+    constexpr int clock_sync_pong_flag = 1 << 13;
+    constexpr int clock_sync_target_shift = 8;
+    constexpr int clock_sync_seq_mask = (1 << clock_sync_target_shift) - 1;
+    constexpr int clock_sync_ticks_mask = (1 << 30) - 1;
+
+    [[nodiscard]] constexpr int clock_sync_ticks_diff(int a, int b)
+    {
+        // Sign extension of the 30-bit difference:
+        int result = (a - b) & clock_sync_ticks_mask;
+        return result > clock_sync_ticks_mask / 2 ? result - clock_sync_ticks_mask - 1 : result;
+    }
+}
+
+link_clock_sync::link_clock_sync() = default;
+
+int link_clock_sync::local_ticks() const
+{
+    return _timer.elapsed_ticks() & clock_sync_ticks_mask;
+}
+
+bool link_clock_sync::send_ping()
+{
+    int seq = _ping_seq;
+    uint16_t packet[1] = {
+        uint16_t((clock_sync_packet_type << clock_sync_packet_type_shift) | seq)
+    };
+
+    ping& ping_entry = _pings[seq & 15];
+    ping_entry.ticks = local_ticks();
+    ping_entry.seq = seq;
+
+    if(! link::send(span<const uint16_t>(packet, 1)))
+    {
+        ping_entry.seq = -1;
+        return false;
+    }
+
+    _ping_seq = (seq + 1) & clock_sync_seq_mask;
+    return true;
+}
+
+void link_clock_sync::update()
+{
+    while(optional<link_packet> packet = link_manager::receive_packet())
+    {
+        read_packet(*packet);
+    }
+}
+
+bool link_clock_sync::read_packet(const link_packet& packet)
+{
+    span<const uint16_t> words = packet.words();
+    int header = words[0];
+
+    if(header >> clock_sync_packet_type_shift != clock_sync_packet_type)
+    {
+        return false;
+    }
+
+    int seq = header & clock_sync_seq_mask;
+
+    if(! (header & clock_sync_pong_flag))
+    {
+        // Pings are answered with the local time as soon as possible, so queuing delays are kept low:
+        int ticks = local_ticks();
+        uint16_t pong[3] = {
+            uint16_t((clock_sync_packet_type << clock_sync_packet_type_shift) | clock_sync_pong_flag |
+                     (packet.player_id() << clock_sync_target_shift) | seq),
+            uint16_t(ticks & 0x7FFF),
+            uint16_t(ticks >> 15)
+        };
+
+        link::send(span<const uint16_t>(pong, 3));
+        return true;
+    }
+
+    int target_player_id = (header >> clock_sync_target_shift) & 3;
+
+    if(words.size() < 3 || target_player_id != link_manager::current_player_id())
+    {
+        return true;
+    }
+
+    ping& ping_entry = _pings[seq & 15];
+
+    if(ping_entry.seq != seq)
+    {
+        return true;
+    }
+
+    int receive_ticks = local_ticks();
+    int remote_ticks = words[1] | (words[2] << 15);
+    int rtt = clock_sync_ticks_diff(receive_ticks, ping_entry.ticks);
+    ping_entry.seq = -1;
+
+    if(rtt >= 0)
+    {
+        // The remote time is assumed to be taken at the half of the round trip:
+        int offset = clock_sync_ticks_diff(remote_ticks, ping_entry.ticks + (rtt / 2));
+        _add_sample(packet.player_id(), rtt, offset);
+    }
+
+    return true;
+}
+
+int link_clock_sync::samples_count(int player_id) const
+{
+    BN_ASSERT(player_id >= 0 && player_id <= 3, "Invalid player id: ", player_id);
+
+    return _players[player_id].count;
+}
+
+optional<int> link_clock_sync::rtt_ticks(int player_id) const
+{
+    BN_ASSERT(player_id >= 0 && player_id <= 3, "Invalid player id: ", player_id);
+
+    const player_samples& player = _players[player_id];
+    optional<int> result;
+
+    if(player.count)
+    {
+        result = player.samples[player.best].rtt;
+    }
+
+    return result;
+}
+
+optional<int> link_clock_sync::offset_ticks(int player_id) const
+{
+    BN_ASSERT(player_id >= 0 && player_id <= 3, "Invalid player id: ", player_id);
+
+    const player_samples& player = _players[player_id];
+    optional<int> result;
+
+    if(player.count)
+    {
+        result = player.samples[player.best].offset;
+    }
+
+    return result;
+}
+
+optional<int> link_clock_sync::remote_ticks(int player_id) const
+{
+    optional<int> result = offset_ticks(player_id);
+
+    if(result)
+    {
+        result = (local_ticks() + *result) & clock_sync_ticks_mask;
+    }
+
+    return result;
+}
+
+optional<int> link_clock_sync::latency_frames() const
+{
+    optional<int> result;
+    int max_rtt = -1;
+
+    for(const player_samples& player : _players)
+    {
+        if(player.count)
+        {
+            max_rtt = max(max_rtt, player.samples[player.best].rtt);
+        }
+    }
+
+    if(max_rtt >= 0)
+    {
+        int ticks_per_frame = timers::ticks_per_frame();
+        result = ((max_rtt / 2) + ticks_per_frame - 1) / ticks_per_frame;
+    }
+
+    return result;
+}
+
+void link_clock_sync::reset()
+{
+    for(player_samples& player : _players)
+    {
+        player = player_samples();
+    }
+
+    for(ping& ping_entry : _pings)
+    {
+        ping_entry = ping();
+    }
+}
+
+void link_clock_sync::_add_sample(int player_id, int rtt, int offset)
+{
+    player_samples& player = _players[player_id];
+    int samples_size = int(sizeof(player.samples) / sizeof(sample));
+    player.samples[player.next] = sample{ rtt, offset };
+    player.next = int8_t((player.next + 1) % samples_size);
+
+    if(player.count < samples_size)
+    {
+        ++player.count;
+    }
+
+    // The sample with the lowest round trip time is the less affected by queuing delays:
+    int best = 0;
+
+    for(int index = 1; index < player.count; ++index)
+    {
+        if(player.samples[index].rtt < player.samples[best].rtt)
+        {
+            best = index;
+        }
+    }
+
+    player.best = int8_t(best);
+}
+
+}
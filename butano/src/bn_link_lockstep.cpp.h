@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_lockstep.h"
+
+#include "bn_link.h"
+#include "bn_link_packet.h"
+#include "bn_link_manager.h"
+
+namespace bn
+{
+
+namespace
+{
+    // The first word of each packet stores its type in the upper bits:
+    constexpr int lockstep_packet_type_shift = 14;
+    constexpr int lockstep_packet_payload_mask = (1 << lockstep_packet_type_shift) - 1;
+    constexpr int lockstep_input_packet_type = 0;
+    constexpr int lockstep_snapshot_packet_type = 1;
+}
+
+link_lockstep::link_lockstep(int players_count, int input_delay) :
+    _players_count(players_count),
+    _input_delay(input_delay)
+{
+    BN_ASSERT(players_count >= 2 && players_count <= 4, "Invalid players count: ", players_count);
+    BN_ASSERT(input_delay >= 0 && input_delay < BN_CFG_LINK_LOCKSTEP_MAX_FRAMES / 2,
+              "Invalid input delay: ", input_delay, " - ", BN_CFG_LINK_LOCKSTEP_MAX_FRAMES);
+
+    reset();
+}
+
+void link_lockstep::update(int local_input)
+{
+    BN_ASSERT(local_input >= 0 && local_input <= 65532, "Invalid local input: ", local_input);
+
+    while(optional<link_packet> packet = link_manager::receive_packet())
+    {
+        _read_packet(*packet);
+    }
+
+    int current_player_id = link_manager::current_player_id();
+
+    if(current_player_id < 0 || current_player_id >= _players_count)
+    {
+        return;
+    }
+
+    if(_local_frame <= _frame + _input_delay)
+    {
+        _store_input(_local_frame, current_player_id, local_input);
+        ++_local_frame;
+    }
+
+    // The last recorded input is sent each frame, so the game can continue even if a packet is lost:
+    int sent_frame = _local_frame - 1;
+    const history_entry& entry = _history[sent_frame & (BN_CFG_LINK_LOCKSTEP_MAX_FRAMES - 1)];
+    uint16_t packet[3] = {
+        uint16_t((lockstep_input_packet_type << lockstep_packet_type_shift) |
+                 (sent_frame & lockstep_packet_payload_mask)),
+        entry.inputs[current_player_id]
+    };
+    int packet_size = 2;
+
+    if(optional<int> previous_input = history_input(sent_frame - 1, current_player_id))
+    {
+        packet[2] = uint16_t(*previous_input);
+        packet_size = 3;
+    }
+
+    link::send(span<const uint16_t>(packet, packet_size));
+}
+
+bool link_lockstep::advance()
+{
+    const history_entry& entry = _history[_frame & (BN_CFG_LINK_LOCKSTEP_MAX_FRAMES - 1)];
+    unsigned all_players = (1U << _players_count) - 1;
+
+    if(entry.frame != _frame || (entry.received_players & all_players) != all_players)
+    {
+        ++_stalled_frames;
+        return false;
+    }
+
+    ++_frame;
+    return true;
+}
+
+int link_lockstep::input(int player_id) const
+{
+    BN_ASSERT(_frame, "No frames have been advanced");
+
+    optional<int> result = history_input(_frame - 1, player_id);
+    BN_ASSERT(result, "Input not found: ", _frame - 1, " - ", player_id);
+
+    return *result;
+}
+
+optional<int> link_lockstep::history_input(int frame, int player_id) const
+{
+    BN_ASSERT(player_id >= 0 && player_id < _players_count, "Invalid player id: ", player_id, " - ", _players_count);
+
+    optional<int> result;
+
+    if(frame >= 0)
+    {
+        const history_entry& entry = _history[frame & (BN_CFG_LINK_LOCKSTEP_MAX_FRAMES - 1)];
+
+        if(entry.frame == frame && (entry.received_players & (1U << player_id)))
+        {
+            result = entry.inputs[player_id];
+        }
+    }
+
+    return result;
+}
+
+int link_lockstep::latency() const
+{
+    int current_player_id = link_manager::current_player_id();
+    int oldest_remote_frame = _local_frame - 1;
+
+    for(int player_id = 0; player_id < _players_count; ++player_id)
+    {
+        if(player_id != current_player_id)
+        {
+            oldest_remote_frame = min(oldest_remote_frame, _last_remote_frames[player_id]);
+        }
+    }
+
+    return _local_frame - 1 - oldest_remote_frame;
+}
+
+int link_lockstep::send_snapshot(const span<const uint16_t>& snapshot, span<uint16_t> sent_snapshot)
+{
+    int snapshot_size = snapshot.size();
+    BN_ASSERT(snapshot_size <= lockstep_packet_payload_mask + 1, "Snapshot is too big: ", snapshot_size);
+    BN_ASSERT(snapshot_size == sent_snapshot.size(),
+              "Snapshot sizes don't match: ", snapshot_size, " - ", sent_snapshot.size());
+
+    constexpr int max_words = BN_CFG_LINK_MAX_PACKET_SIZE - 1;
+    uint16_t packet[BN_CFG_LINK_MAX_PACKET_SIZE];
+    int index = 0;
+    int result = 0;
+
+    while(index < snapshot_size)
+    {
+        if(snapshot[index] == sent_snapshot[index])
+        {
+            ++index;
+            continue;
+        }
+
+        // Consecutive different words are sent in the same packet:
+        int words_count = 0;
+        packet[0] = uint16_t((lockstep_snapshot_packet_type << lockstep_packet_type_shift) | index);
+
+        while(words_count < max_words && index + words_count < snapshot_size &&
+              snapshot[index + words_count] != sent_snapshot[index + words_count])
+        {
+            packet[words_count + 1] = snapshot[index + words_count];
+            ++words_count;
+        }
+
+        if(! link::send(span<const uint16_t>(packet, words_count + 1)))
+        {
+            break;
+        }
+
+        for(int word_index = 0; word_index < words_count; ++word_index)
+        {
+            sent_snapshot[index + word_index] = snapshot[index + word_index];
+        }
+
+        index += words_count;
+        ++result;
+    }
+
+    return result;
+}
+
+void link_lockstep::reset()
+{
+    for(history_entry& entry : _history)
+    {
+        entry = history_entry();
+    }
+
+    for(int& last_remote_frame : _last_remote_frames)
+    {
+        last_remote_frame = -1;
+    }
+
+    _frame = 0;
+    _local_frame = 0;
+    _lost_packets = 0;
+    _stalled_frames = 0;
+}
+
+void link_lockstep::_store_input(int frame, int player_id, int input)
+{
+    if(frame >= _frame && frame < _frame + BN_CFG_LINK_LOCKSTEP_MAX_FRAMES)
+    {
+        history_entry& entry = _history[frame & (BN_CFG_LINK_LOCKSTEP_MAX_FRAMES - 1)];
+
+        if(entry.frame != frame)
+        {
+            entry.frame = frame;
+            entry.received_players = 0;
+        }
+
+        entry.inputs[player_id] = uint16_t(input);
+        entry.received_players |= uint8_t(1 << player_id);
+    }
+}
+
+void link_lockstep::_read_packet(const link_packet& packet)
+{
+    span<const uint16_t> words = packet.words();
+    int player_id = packet.player_id();
+    int packet_type = words[0] >> lockstep_packet_type_shift;
+    int payload = words[0] & lockstep_packet_payload_mask;
+
+    if(packet_type == lockstep_input_packet_type)
+    {
+        if(words.size() < 2 || player_id >= _players_count)
+        {
+            return;
+        }
+
+        // Only the lower bits of the frame number are sent, so the nearest frame to the local one is taken:
+        int frame_diff = (payload - _local_frame) & lockstep_packet_payload_mask;
+
+        if(frame_diff > lockstep_packet_payload_mask / 2)
+        {
+            frame_diff -= lockstep_packet_payload_mask + 1;
+        }
+
+        int frame = _local_frame + frame_diff;
+        int& last_remote_frame = _last_remote_frames[player_id];
+
+        if(frame > last_remote_frame)
+        {
+            if(last_remote_frame >= 0)
+            {
+                _lost_packets += max(frame - last_remote_frame - 1, 0);
+            }
+
+            last_remote_frame = frame;
+        }
+
+        _store_input(frame, player_id, words[1]);
+
+        if(words.size() > 2)
+        {
+            _store_input(frame - 1, player_id, words[2]);
+        }
+    }
+    else if(packet_type == lockstep_snapshot_packet_type)
+    {
+        int remote_snapshot_size = _remote_snapshot.size();
+
+        for(int word_index = 1, words_count = words.size(); word_index < words_count; ++word_index)
+        {
+            int snapshot_index = payload + word_index - 1;
+
+            if(snapshot_index < remote_snapshot_size)
+            {
+                _remote_snapshot[snapshot_index] = words[word_index];
+            }
+        }
+    }
+}
+
+}
@@ -6,40 +6,106 @@
 #include "bn_link_manager.h"
 
 #include "../hw/include/bn_hw_link.h"
+#include "../hw/include/bn_hw_link_multiboot.h"
 
 #include "bn_link.cpp.h"
+#include "bn_link_lockstep.cpp.h"
+#include "bn_link_clock_sync.cpp.h"
+#include "bn_link_multiboot.cpp.h"
 
 namespace bn::link_manager
 {
 
 namespace
 {
+    constexpr int max_players = 4;
+    constexpr int checksum_modulo = 65533;
+
+    class packet_reader
+    {
+
+    public:
+        uint16_t words[BN_CFG_LINK_MAX_PACKET_SIZE];
+        unsigned checksum = 0;
+        int expected_size = -1;
+        int size = 0;
+    };
+
     class static_data
     {
 
     public:
         hw::link::connection connection;
+        packet_reader packet_readers[max_players];
+        int next_packet_player_id = 0;
+        bool initialized = false;
         bool activated = false;
     };
 
     BN_DATA_EWRAM static_data data;
 
 
+    [[nodiscard]] bool _read_packet_message(int message, packet_reader& reader)
+    {
+        // A packet is sent as a start message, its size, its words and a checksum:
+        if(message == hw::link::packet_start())
+        {
+            reader.expected_size = 0;
+            return false;
+        }
+
+        if(reader.expected_size < 0)
+        {
+            return false;
+        }
+
+        if(reader.expected_size == 0)
+        {
+            if(message > BN_CFG_LINK_MAX_PACKET_SIZE)
+            {
+                reader.expected_size = -1;
+            }
+            else
+            {
+                reader.checksum = 0;
+                reader.expected_size = message;
+                reader.size = 0;
+            }
+
+            return false;
+        }
+
+        if(reader.size < reader.expected_size)
+        {
+            int word = message - 1;
+            reader.words[reader.size] = uint16_t(word);
+            reader.checksum += unsigned(word);
+            ++reader.size;
+            return false;
+        }
+
+        reader.expected_size = -1;
+        return message == int(reader.checksum % checksum_modulo) + 1;
+    }
+
+
     void _check_activated()
     {
         if(! data.activated)
         {
+            // Link connection is initialized when it is used for the first time, to reduce boot time:
+            if(! data.initialized)
+            {
+                hw::link::init(data.connection);
+                data.initialized = true;
+            }
+
             hw::link::enable();
             data.activated = true;
         }
     }
 }
 
-void init()
-{
-    hw::link::init(data.connection);
-}
-
 void send(int data_to_send)
 {
     _check_activated();
@@ -53,8 +119,6 @@ optional<link_state> receive()
     vector<link_player, 3> other_players;
     _check_activated();
 
-    hw::link::block();
-
     if(hw::link::state* link_state = hw::link::current_state())
     {
         current_player_id = int(link_state->currentPlayerId);
@@ -75,8 +139,6 @@ optional<link_state> receive()
         }
     }
 
-    hw::link::unblock();
-
     optional<link_state> result;
 
     if(! other_players.empty())
@@ -87,6 +149,90 @@ optional<link_state> receive()
     return result;
 }
 
+bool send(const span<const uint16_t>& packet)
+{
+    uint16_t messages[BN_CFG_LINK_MAX_PACKET_SIZE + 3];
+    int packet_size = packet.size();
+    unsigned checksum = 0;
+    messages[0] = uint16_t(hw::link::packet_start());
+    messages[1] = uint16_t(packet_size);
+
+    for(int index = 0; index < packet_size; ++index)
+    {
+        unsigned word = packet[index];
+        messages[index + 2] = uint16_t(word + 1);
+        checksum += word;
+    }
+
+    messages[packet_size + 2] = uint16_t((checksum % checksum_modulo) + 1);
+    _check_activated();
+
+    return hw::link::send(messages, packet_size + 3);
+}
+
+optional<link_packet> receive_packet()
+{
+    optional<link_packet> result;
+    _check_activated();
+
+    if(hw::link::state* link_state = hw::link::current_state())
+    {
+        int current_player_id = int(link_state->currentPlayerId);
+        int players_count = link_state->playerCount;
+        int first_player_id = data.next_packet_player_id;
+
+        // Players are polled in turns, so a player sending many packets can't starve the others:
+        for(int player_index = 0; player_index < max_players; ++player_index)
+        {
+            int player_id = (first_player_id + player_index) % max_players;
+
+            if(player_id != current_player_id && player_id < players_count)
+            {
+                packet_reader& reader = data.packet_readers[player_id];
+
+                while(true)
+                {
+                    int message = link_state->readMessage(u8(player_id));
+
+                    if(message == LINK_NO_DATA || message == LINK_DISCONNECTED)
+                    {
+                        break;
+                    }
+
+                    if(_read_packet_message(message, reader))
+                    {
+                        result.emplace(player_id, span<const uint16_t>(reader.words, reader.size));
+                        data.next_packet_player_id = (player_id + 1) % max_players;
+                        return result;
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+int current_player_id()
+{
+    _check_activated();
+
+    if(hw::link::state* link_state = hw::link::current_state())
+    {
+        return int(link_state->currentPlayerId);
+    }
+
+    return -1;
+}
+
+link_multiboot_result send_multiboot(const span<const uint8_t>& image, int timeout_frames)
+{
+    // Multiboot transfers use the serial port in normal mode, so the link communication must be deactivated:
+    deactivate();
+
+    return hw::link_multiboot::send(image.data(), image.size(), timeout_frames);
+}
+
 void deactivate()
 {
     if(data.activated)
@@ -96,6 +242,33 @@ void deactivate()
     }
 }
 
+link_stats stats()
+{
+    if(! data.initialized)
+    {
+        return link_stats(0, 0, 0, 0, 0);
+    }
+
+    // Counters are words updated by the link interrupt handlers, so each one can be read at any time:
+    const hw::link::state& link_state = hw::link::connection_state();
+    return link_stats(int(link_state._sentWords), int(link_state._receivedWords),
+                      int(link_state._droppedSentWords), int(link_state._droppedReceivedWords),
+                      int(link_state._resets));
+}
+
+void reset_stats()
+{
+    if(data.initialized)
+    {
+        hw::link::state& link_state = hw::link::connection_state();
+        link_state._sentWords = 0;
+        link_state._receivedWords = 0;
+        link_state._droppedSentWords = 0;
+        link_state._droppedReceivedWords = 0;
+        link_state._resets = 0;
+    }
+}
+
 void enable()
 {
     if(data.activated)
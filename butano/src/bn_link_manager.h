@@ -6,23 +6,37 @@
 #ifndef BN_LINK_MANAGER_H
 #define BN_LINK_MANAGER_H
 
+#include "bn_span_fwd.h"
 #include "bn_optional_fwd.h"
 
 namespace bn
 {
+    class link_stats;
     class link_state;
+    class link_packet;
+    enum class link_multiboot_result : uint8_t;
 }
 
 namespace bn::link_manager
 {
-    void init();
-
     void send(int data_to_send);
 
     [[nodiscard]] optional<link_state> receive();
 
+    [[nodiscard]] bool send(const span<const uint16_t>& packet);
+
+    [[nodiscard]] optional<link_packet> receive_packet();
+
+    [[nodiscard]] int current_player_id();
+
+    [[nodiscard]] link_multiboot_result send_multiboot(const span<const uint8_t>& image, int timeout_frames);
+
     void deactivate();
 
+    [[nodiscard]] link_stats stats();
+
+    void reset_stats();
+
     void enable();
 
     void disable();
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_link_multiboot.h"
+
+#include "bn_span.h"
+#include "bn_alignment.h"
+#include "bn_link_manager.h"
+
+namespace bn::link_multiboot
+{
+
+link_multiboot_result send(const span<const uint8_t>& image, int timeout_frames)
+{
+    BN_ASSERT(image.size() >= min_image_size() && image.size() <= max_image_size() && image.size() % 16 == 0,
+              "Invalid image size: ", image.size());
+    BN_ASSERT(aligned<2>(image.data()), "Image is not aligned");
+    BN_ASSERT(timeout_frames > 0, "Invalid timeout frames: ", timeout_frames);
+
+    return link_manager::send_multiboot(image, timeout_frames);
+}
+
+}
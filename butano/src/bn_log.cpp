@@ -4,6 +4,7 @@
  */
 
 #include "bn_log.h"
+#include "bn_log_deferred.h"
 
 #if BN_CFG_LOG_ENABLED
     #include "../hw/include/bn_hw_log.h"
@@ -11,10 +12,82 @@
     namespace bn
     {
         static_assert(BN_CFG_LOG_MAX_SIZE >= 16);
+        static_assert(BN_CFG_LOG_DEFERRED_BUFFER_SIZE >= 16);
+        static_assert(BN_CFG_LOG_LEVEL >= BN_LOG_LEVEL_NONE && BN_CFG_LOG_LEVEL <= BN_LOG_LEVEL_DEBUG);
 
         void log(const istring_base& message)
         {
             hw::log(message);
         }
     }
+
+    namespace _bn::log_level
+    {
+        unsigned subsystems_mask = 0xFFFFFFFF;
+    }
+
+    namespace _bn::log_deferred
+    {
+        namespace
+        {
+            class static_data
+            {
+
+            public:
+                unsigned buffer[BN_CFG_LOG_DEFERRED_BUFFER_SIZE / sizeof(unsigned)];
+                int buffer_size = 0;
+                int discarded_lines = 0;
+            };
+
+            BN_DATA_EWRAM static_data data;
+        }
+
+        unsigned* alloc(int words)
+        {
+            int buffer_size = data.buffer_size;
+            int new_buffer_size = buffer_size + words;
+
+            if(new_buffer_size > int(sizeof(data.buffer) / sizeof(unsigned))) [[unlikely]]
+            {
+                ++data.discarded_lines;
+                return nullptr;
+            }
+
+            data.buffer_size = new_buffer_size;
+            return data.buffer + buffer_size;
+        }
+
+        void flush()
+        {
+            const unsigned* buffer_data = data.buffer;
+            const unsigned* buffer_end = buffer_data + data.buffer_size;
+
+            while(buffer_data < buffer_end)
+            {
+                const unsigned* line_end = buffer_data + *buffer_data;
+                ++buffer_data;
+
+                char line_string[BN_CFG_LOG_MAX_SIZE];
+                bn::istring_base line_istring(line_string);
+                bn::ostringstream line_stream(line_istring);
+
+                while(buffer_data < line_end)
+                {
+                    formatter arg_formatter;
+                    __builtin_memcpy(&arg_formatter, buffer_data, sizeof(formatter));
+                    buffer_data = arg_formatter(buffer_data + formatter_words, line_stream);
+                }
+
+                bn::hw::log(line_istring);
+            }
+
+            if(int discarded_lines = data.discarded_lines)
+            {
+                BN_LOG("Deferred log lines discarded: ", discarded_lines);
+            }
+
+            data.buffer_size = 0;
+            data.discarded_lines = 0;
+        }
+    }
 #endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_math.h"
+
+#include "bn_span.h"
+#include "bn_fixed_point.h"
+#include "bn_affine_mat_attributes.h"
+
+namespace bn
+{
+
+void transform_points(span<fixed_point> points, const affine_mat_attributes& affine_mat_attributes)
+{
+    int pa = affine_mat_attributes.pa_register_value();
+    int pb = affine_mat_attributes.pb_register_value();
+    int pc = affine_mat_attributes.pc_register_value();
+    int pd = affine_mat_attributes.pd_register_value();
+
+    for(fixed_point& point : points)
+    {
+        int64_t x = point.x().data();
+        int64_t y = point.y().data();
+        int new_x = int(((x * pa) + (y * pb)) >> 8);
+        int new_y = int(((x * pc) + (y * pd)) >> 8);
+        point = fixed_point(fixed::from_data(new_x), fixed::from_data(new_y));
+    }
+}
+
+void add_scaled(span<fixed_point> points, span<const fixed_point> deltas, fixed scale)
+{
+    BN_ASSERT(points.size() == deltas.size(), "Invalid deltas size: ", deltas.size(), " - ", points.size());
+
+    int scale_data = scale.data();
+    const fixed_point* deltas_data = deltas.data();
+
+    for(fixed_point& point : points)
+    {
+        const fixed_point& delta = *deltas_data;
+        int x = point.x().data() + int((int64_t(delta.x().data()) * scale_data) >> fixed::precision());
+        int y = point.y().data() + int((int64_t(delta.y().data()) * scale_data) >> fixed::precision());
+        point = fixed_point(fixed::from_data(x), fixed::from_data(y));
+        ++deltas_data;
+    }
+}
+
+void lerp(span<fixed_point> points, span<const fixed_point> targets, fixed weight)
+{
+    BN_ASSERT(points.size() == targets.size(), "Invalid targets size: ", targets.size(), " - ", points.size());
+
+    int weight_data = weight.data();
+    const fixed_point* targets_data = targets.data();
+
+    for(fixed_point& point : points)
+    {
+        const fixed_point& target = *targets_data;
+        int x = point.x().data();
+        int y = point.y().data();
+        x += int((int64_t(target.x().data() - x) * weight_data) >> fixed::precision());
+        y += int((int64_t(target.y().data() - y) * weight_data) >> fixed::precision());
+        point = fixed_point(fixed::from_data(x), fixed::from_data(y));
+        ++targets_data;
+    }
+}
+
+fixed dot(span<const fixed> a, span<const fixed> b)
+{
+    BN_ASSERT(a.size() == b.size(), "Invalid b size: ", b.size(), " - ", a.size());
+
+    int64_t result = 0;
+    const fixed* b_data = b.data();
+
+    for(fixed a_value : a)
+    {
+        result += int64_t(a_value.data()) * b_data->data();
+        ++b_data;
+    }
+
+    return fixed::from_data(int(result >> fixed::precision()));
+}
+
+}
@@ -5,6 +5,7 @@
 
 #include "bn_memory.h"
 
+#include "bn_log.h"
 #include "bn_compression_type.h"
 #include "bn_memory_manager.h"
 #include "../hw/include/bn_hw_memory.h"
@@ -12,7 +13,7 @@
 
 void* operator new(unsigned bytes)
 {
-    void* ptr = bn::memory_manager::ewram_alloc(bytes);
+    void* ptr = bn::memory_manager::ewram_alloc(bytes, __builtin_return_address(0));
     BN_ASSERT(ptr, "Allocation failed. Size in bytes: ", bytes);
 
     return ptr;
@@ -30,7 +31,7 @@ void operator delete(void* ptr, [[maybe_unused]] unsigned bytes) noexcept
 
 void* operator new[](unsigned bytes)
 {
-    void* ptr = bn::memory_manager::ewram_alloc(bytes);
+    void* ptr = bn::memory_manager::ewram_alloc(bytes, __builtin_return_address(0));
     BN_ASSERT(ptr, "Allocation failed. Size in bytes: ", bytes);
 
     return ptr;
@@ -87,17 +88,17 @@ namespace bn::memory
 
 void* ewram_alloc(int bytes)
 {
-    return memory_manager::ewram_alloc(bytes);
+    return memory_manager::ewram_alloc(bytes, __builtin_return_address(0));
 }
 
 void* ewram_calloc(int bytes)
 {
-    return memory_manager::ewram_calloc(bytes);
+    return memory_manager::ewram_calloc(bytes, __builtin_return_address(0));
 }
 
 void* ewram_realloc(void* ptr, int new_bytes)
 {
-    return memory_manager::ewram_realloc(ptr, new_bytes);
+    return memory_manager::ewram_realloc(ptr, new_bytes, __builtin_return_address(0));
 }
 
 void ewram_free(void* ptr)
@@ -125,16 +126,78 @@ int available_items_ewram()
     return memory_manager::available_items_ewram();
 }
 
+int largest_available_alloc_ewram()
+{
+    return memory_manager::largest_available_alloc_ewram();
+}
+
+const char* ewram_alloc_tag()
+{
+    return memory_manager::ewram_alloc_tag();
+}
+
+void set_ewram_alloc_tag(const char* tag)
+{
+    memory_manager::set_ewram_alloc_tag(tag);
+}
+
+int max_used_alloc_ewram()
+{
+    return memory_manager::max_used_alloc_ewram();
+}
+
+int last_frame_allocs_ewram()
+{
+    return memory_manager::last_frame_allocs_ewram();
+}
+
+int max_frame_allocs_ewram()
+{
+    return memory_manager::max_frame_allocs_ewram();
+}
+
+void log_ewram_usage()
+{
+    memory_manager::log_ewram_usage();
+}
+
 int used_stack_iwram()
 {
     return hw::memory::used_stack_iwram(hw::memory::stack_address());
 }
 
+int max_used_stack_iwram()
+{
+    return hw::memory::max_used_stack_iwram(hw::memory::stack_address());
+}
+
 int used_static_iwram()
 {
     return hw::memory::used_static_iwram();
 }
 
+int used_overlays_iwram()
+{
+    return hw::memory::used_overlays_iwram();
+}
+
+int unused_iwram()
+{
+    return hw::memory::unused_iwram(hw::memory::stack_address());
+}
+
+void log_iwram_usage()
+{
+    #if BN_CFG_LOG_ENABLED
+        int stack_address = hw::memory::stack_address();
+        BN_LOG("IWRAM static: ", hw::memory::used_static_iwram(), "B");
+        BN_LOG("IWRAM overlays: ", hw::memory::used_overlays_iwram(), "B");
+        BN_LOG("IWRAM stack: ", hw::memory::used_stack_iwram(stack_address), "B");
+        BN_LOG("IWRAM stack peak: ", hw::memory::max_used_stack_iwram(stack_address), "B");
+        BN_LOG("IWRAM unused: ", hw::memory::unused_iwram(stack_address), "B");
+    #endif
+}
+
 int used_static_ewram()
 {
     return hw::memory::used_static_ewram();
@@ -200,6 +263,25 @@ void decompress(compression_type compression, const void* source_ptr, int bytes,
         }
         break;
 
+    case compression_type::LZ4:
+        hw::decompress::lz4(source_ptr, destination_ptr);
+        break;
+
+    case compression_type::HUFFMAN:
+        hw::decompress::huffman(source_ptr, destination_ptr);
+        break;
+
+    case compression_type::LZ77_HUFFMAN:
+        if(hw::memory::in_vram(destination_ptr))
+        {
+            hw::decompress::lz77_huffman_vram(source_ptr, destination_ptr);
+        }
+        else
+        {
+            hw::decompress::lz77_huffman_wram(source_ptr, destination_ptr);
+        }
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(compression));
         break;
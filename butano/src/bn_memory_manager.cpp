@@ -5,6 +5,7 @@
 
 #include "bn_memory_manager.h"
 
+#include "bn_log.h"
 #include "bn_list.h"
 #include "bn_vector.h"
 #include "bn_config_memory.h"
@@ -42,12 +43,77 @@ namespace
     static_assert(alignof(items_iterator) == alignof(int));
 
 
+    #if BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+        constexpr int slab_classes_count = 4;
+        constexpr int slab_max_block_bytes = 16 << (slab_classes_count - 1);
+        constexpr int slab_page_size = BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE;
+
+
+        class slab_block
+        {
+
+        public:
+            slab_block* next;
+        };
+
+
+        class slab_page
+        {
+
+        public:
+            slab_page* prev;
+            slab_page* next;
+            slab_block* free_blocks;
+            int16_t used_blocks;
+            int16_t class_index;
+        };
+
+        static_assert(sizeof(uintptr_t) == sizeof(items_iterator));
+        static_assert(slab_page_size % int(sizeof(int)) == 0);
+        static_assert(slab_page_size >= int(sizeof(slab_page) + sizeof(uintptr_t)) + slab_max_block_bytes,
+                      "Slab page size is too small");
+    #endif
+
+
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        static_assert(BN_CFG_MEMORY_EWRAM_TRACKING_MAX_BLOCKS > 0);
+
+
+        class tracked_block
+        {
+
+        public:
+            const void* ptr;
+            const void* caller;
+            const char* tag;
+            int bytes;
+        };
+    #endif
+
+
     class static_data
     {
 
     public:
         items_list items;
         vector<items_iterator, max_items> free_items;
+
+        #if BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+            slab_page* slab_pages[slab_classes_count] = {};
+        #endif
+
+        #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+            vector<tracked_block, BN_CFG_MEMORY_EWRAM_TRACKING_MAX_BLOCKS> tracked_blocks;
+            const char* tag = nullptr;
+            int untracked_blocks_count = 0;
+            int max_used_bytes_count = 0;
+            int max_used_items_count = 0;
+            int frame_allocs_count = 0;
+            int last_frame_allocs_count = 0;
+            int max_frame_allocs_count = 0;
+            int total_allocs_count = 0;
+        #endif
+
         int total_bytes_count = 0;
         int free_bytes_count = 0;
     };
@@ -101,118 +167,55 @@ namespace
 
         data.free_items.erase(free_items_it);
     }
-}
 
-void init()
-{
-    char* start = hw::memory::ewram_heap_start();
-    char* end = hw::memory::ewram_heap_end();
-    data.total_bytes_count = end - start;
-
-    item_type new_item;
-    new_item.data = start;
-    new_item.size = data.total_bytes_count;
-    data.items.push_front(new_item);
-    data.free_items.push_back(data.items.begin());
-    data.free_bytes_count = data.total_bytes_count;
-}
-
-void* ewram_alloc(int bytes)
-{
-    BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
-
-    bytes = _aligned_bytes(bytes) + int(sizeof(items_iterator));
-
-    if(bytes > data.free_bytes_count)
+    [[nodiscard]] void* _items_alloc(int bytes)
     {
-        return nullptr;
-    }
+        bytes = _aligned_bytes(bytes) + int(sizeof(items_iterator));
 
-    auto free_items_end = data.free_items.end();
-    auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, bytes, lower_bound_comparator);
-
-    if(free_items_it == free_items_end)
-    {
-        return nullptr;
-    }
-
-    items_iterator items_it = *free_items_it;
-    item_type& item = *items_it;
-
-    if(int new_item_size = item.size - bytes)
-    {
-        if(data.items.full())
+        if(bytes > data.free_bytes_count)
         {
             return nullptr;
         }
 
-        item_type new_item;
-        new_item.data = item.data;
-        new_item.size = new_item_size;
-
-        items_iterator new_items_it = data.items.insert(items_it, new_item);
-        _insert_free_item(new_items_it, free_items_it);
-        ++free_items_it;
-        item.data += new_item_size;
-        item.size = bytes;
-    }
-
-    item.used = true;
-    data.free_items.erase(free_items_it);
+        auto free_items_end = data.free_items.end();
+        auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, bytes, lower_bound_comparator);
 
-    items_iterator* items_it_ptr = reinterpret_cast<items_iterator*>(item.data);
-    *items_it_ptr = items_it;
-    data.free_bytes_count -= bytes;
-    return items_it_ptr + 1;
-}
+        if(free_items_it == free_items_end)
+        {
+            return nullptr;
+        }
 
-void* ewram_calloc(int bytes)
-{
-    void* result = ewram_alloc(bytes);
+        items_iterator items_it = *free_items_it;
+        item_type& item = *items_it;
 
-    if(result)
-    {
-        auto int_result = reinterpret_cast<int*>(result);
-        memory::clear(_aligned_bytes(bytes) / int(sizeof(int)), *int_result);
-    }
+        if(int new_item_size = item.size - bytes)
+        {
+            if(data.items.full())
+            {
+                return nullptr;
+            }
 
-    return result;
-}
+            item_type new_item;
+            new_item.data = item.data;
+            new_item.size = new_item_size;
 
-void* ewram_realloc(void* ptr, int new_bytes)
-{
-    if(! ptr)
-    {
-        return ewram_alloc(new_bytes);
-    }
+            items_iterator new_items_it = data.items.insert(items_it, new_item);
+            _insert_free_item(new_items_it, free_items_it);
+            ++free_items_it;
+            item.data += new_item_size;
+            item.size = bytes;
+        }
 
-    items_iterator* items_it_ptr = reinterpret_cast<items_iterator*>(ptr) - 1;
-    items_iterator items_it = *items_it_ptr;
-    item_type& item = *items_it;
-    int old_bytes = item.size - int(sizeof(items_iterator));
+        item.used = true;
+        data.free_items.erase(free_items_it);
 
-    if(new_bytes <= old_bytes)
-    {
-        return ptr;
+        items_iterator* items_it_ptr = reinterpret_cast<items_iterator*>(item.data);
+        *items_it_ptr = items_it;
+        data.free_bytes_count -= bytes;
+        return items_it_ptr + 1;
     }
 
-    void* new_ptr = ewram_alloc(new_bytes);
-
-    if(! new_ptr)
-    {
-        return nullptr;
-    }
-
-    auto old_ptr_data = reinterpret_cast<const int*>(ptr);
-    auto new_ptr_data = reinterpret_cast<int*>(new_ptr);
-    memory::copy(*old_ptr_data, old_bytes / 4, *new_ptr_data);
-    ewram_free(ptr);
-    return new_ptr;
-}
-
-void ewram_free(void* ptr)
-{
-    if(ptr)
+    void _items_free(void* ptr)
     {
         items_iterator* items_it_ptr = reinterpret_cast<items_iterator*>(ptr) - 1;
         items_iterator items_it = *items_it_ptr;
@@ -254,6 +257,408 @@ void ewram_free(void* ptr)
 
         _insert_free_item(items_it);
     }
+
+    #if BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+        // Slab blocks are preceded by the address of their page with the lowest bit set,
+        // while general blocks are preceded by an aligned items iterator:
+        [[nodiscard]] slab_page* _slab_page(void* ptr)
+        {
+            uintptr_t header = *(reinterpret_cast<uintptr_t*>(ptr) - 1);
+            return header & 1 ? reinterpret_cast<slab_page*>(header - 1) : nullptr;
+        }
+
+        [[nodiscard]] constexpr int _slab_class_index(int bytes)
+        {
+            int result = 0;
+
+            while((16 << result) < bytes)
+            {
+                ++result;
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr int _slab_block_bytes(int class_index)
+        {
+            return 16 << class_index;
+        }
+
+        void _slab_link_page(slab_page* page)
+        {
+            slab_page*& first_page = data.slab_pages[page->class_index];
+            page->prev = nullptr;
+            page->next = first_page;
+
+            if(first_page)
+            {
+                first_page->prev = page;
+            }
+
+            first_page = page;
+        }
+
+        void _slab_unlink_page(slab_page* page)
+        {
+            if(page->prev)
+            {
+                page->prev->next = page->next;
+            }
+            else
+            {
+                data.slab_pages[page->class_index] = page->next;
+            }
+
+            if(page->next)
+            {
+                page->next->prev = page->prev;
+            }
+        }
+
+        [[nodiscard]] slab_page* _slab_alloc_page(int class_index)
+        {
+            auto page = static_cast<slab_page*>(_items_alloc(slab_page_size));
+
+            if(! page)
+            {
+                return nullptr;
+            }
+
+            int block_stride = _slab_block_bytes(class_index) + int(sizeof(uintptr_t));
+            int blocks_count = (slab_page_size - int(sizeof(slab_page))) / block_stride;
+            char* blocks_data = reinterpret_cast<char*>(page + 1);
+            slab_block* free_blocks = nullptr;
+
+            for(int index = blocks_count - 1; index >= 0; --index)
+            {
+                auto header = reinterpret_cast<uintptr_t*>(blocks_data + (index * block_stride));
+                *header = reinterpret_cast<uintptr_t>(page) | 1;
+
+                auto block = reinterpret_cast<slab_block*>(header + 1);
+                block->next = free_blocks;
+                free_blocks = block;
+            }
+
+            page->free_blocks = free_blocks;
+            page->used_blocks = 0;
+            page->class_index = int16_t(class_index);
+            _slab_link_page(page);
+            return page;
+        }
+
+        [[nodiscard]] void* _slab_alloc(int bytes)
+        {
+            int class_index = _slab_class_index(bytes);
+            slab_page* page = data.slab_pages[class_index];
+
+            if(! page)
+            {
+                page = _slab_alloc_page(class_index);
+
+                if(! page)
+                {
+                    return nullptr;
+                }
+            }
+
+            slab_block* block = page->free_blocks;
+            page->free_blocks = block->next;
+            ++page->used_blocks;
+
+            if(! page->free_blocks)
+            {
+                _slab_unlink_page(page);
+            }
+
+            return block;
+        }
+
+        void _slab_free(void* ptr, slab_page* page)
+        {
+            auto block = static_cast<slab_block*>(ptr);
+            bool page_was_full = ! page->free_blocks;
+            block->next = page->free_blocks;
+            page->free_blocks = block;
+            --page->used_blocks;
+
+            if(page_was_full)
+            {
+                _slab_link_page(page);
+            }
+
+            // Empty pages are returned to the heap, except the last one of each size class,
+            // so allocating and freeing a single block doesn't rebuild a page each time:
+            if(! page->used_blocks && (page->prev || page->next))
+            {
+                _slab_unlink_page(page);
+                _items_free(page);
+            }
+        }
+    #endif
+
+    [[nodiscard]] void* _alloc(int bytes)
+    {
+        BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+
+        #if BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+            if(bytes <= slab_max_block_bytes)
+            {
+                if(void* result = _slab_alloc(bytes))
+                {
+                    return result;
+                }
+            }
+        #endif
+
+        return _items_alloc(bytes);
+    }
+
+    void _free(void* ptr)
+    {
+        if(ptr)
+        {
+            #if BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+                if(slab_page* page = _slab_page(ptr))
+                {
+                    _slab_free(ptr, page);
+                    return;
+                }
+            #endif
+
+            _items_free(ptr);
+        }
+    }
+
+    [[nodiscard]] void* _realloc(void* ptr, int new_bytes)
+    {
+        if(! ptr)
+        {
+            return _alloc(new_bytes);
+        }
+
+        #if BN_CFG_MEMORY_EWRAM_SLAB_PAGE_SIZE
+            if(slab_page* page = _slab_page(ptr))
+            {
+                int block_bytes = _slab_block_bytes(page->class_index);
+
+                if(new_bytes <= block_bytes)
+                {
+                    return ptr;
+                }
+
+                void* new_ptr = _alloc(new_bytes);
+
+                if(! new_ptr)
+                {
+                    return nullptr;
+                }
+
+                auto old_ptr_data = reinterpret_cast<const int*>(ptr);
+                auto new_ptr_data = reinterpret_cast<int*>(new_ptr);
+                memory::copy(*old_ptr_data, block_bytes / 4, *new_ptr_data);
+                _slab_free(ptr, page);
+                return new_ptr;
+            }
+        #endif
+
+        items_iterator* items_it_ptr = reinterpret_cast<items_iterator*>(ptr) - 1;
+        items_iterator items_it = *items_it_ptr;
+        item_type& item = *items_it;
+        int old_bytes = item.size - int(sizeof(items_iterator));
+        int new_size = _aligned_bytes(new_bytes) + int(sizeof(items_iterator));
+        items_iterator next_items_it = items_it;
+        ++next_items_it;
+
+        item_type* next_free_item = nullptr;
+
+        if(next_items_it != data.items.end())
+        {
+            item_type& next_item = *next_items_it;
+
+            if(! next_item.used && item.data + item.size == next_item.data)
+            {
+                next_free_item = &next_item;
+            }
+        }
+
+        if(new_size <= item.size)
+        {
+            // Shrink in place, returning the tail to the free items:
+            if(int tail_size = item.size - new_size)
+            {
+                if(next_free_item)
+                {
+                    _erase_free_item(next_items_it);
+                    next_free_item->data -= tail_size;
+                    next_free_item->size += tail_size;
+                    _insert_free_item(next_items_it);
+                }
+                else if(! data.items.full())
+                {
+                    item_type new_item;
+                    new_item.data = item.data + new_size;
+                    new_item.size = tail_size;
+                    _insert_free_item(data.items.insert(next_items_it, new_item));
+                }
+                else
+                {
+                    return ptr;
+                }
+
+                item.size = new_size;
+                data.free_bytes_count += tail_size;
+            }
+
+            return ptr;
+        }
+
+        if(next_free_item)
+        {
+            // Grow in place if the next item is free and big enough:
+            if(int extra_size = new_size - item.size; extra_size <= next_free_item->size)
+            {
+                _erase_free_item(next_items_it);
+
+                if(extra_size == next_free_item->size)
+                {
+                    data.items.erase(next_items_it);
+                }
+                else
+                {
+                    next_free_item->data += extra_size;
+                    next_free_item->size -= extra_size;
+                    _insert_free_item(next_items_it);
+                }
+
+                item.size = new_size;
+                data.free_bytes_count -= extra_size;
+                return ptr;
+            }
+        }
+
+        void* new_ptr = _alloc(new_bytes);
+
+        if(! new_ptr)
+        {
+            return nullptr;
+        }
+
+        auto old_ptr_data = reinterpret_cast<const int*>(ptr);
+        auto new_ptr_data = reinterpret_cast<int*>(new_ptr);
+        memory::copy(*old_ptr_data, old_bytes / 4, *new_ptr_data);
+        _free(ptr);
+        return new_ptr;
+    }
+
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        void _track_alloc(const void* ptr, int bytes, const void* caller)
+        {
+            ++data.frame_allocs_count;
+            ++data.total_allocs_count;
+            data.max_used_bytes_count = max(data.max_used_bytes_count,
+                                            data.total_bytes_count - data.free_bytes_count);
+            data.max_used_items_count = max(data.max_used_items_count, data.items.size());
+
+            if(data.tracked_blocks.full())
+            {
+                ++data.untracked_blocks_count;
+            }
+            else
+            {
+                data.tracked_blocks.push_back(tracked_block{ ptr, caller, data.tag, bytes });
+            }
+        }
+
+        void _track_free(const void* ptr)
+        {
+            for(tracked_block& block : data.tracked_blocks)
+            {
+                if(block.ptr == ptr)
+                {
+                    block = data.tracked_blocks.back();
+                    data.tracked_blocks.pop_back();
+                    return;
+                }
+            }
+
+            if(data.untracked_blocks_count)
+            {
+                --data.untracked_blocks_count;
+            }
+        }
+    #endif
+}
+
+void init()
+{
+    char* start = hw::memory::ewram_heap_start();
+    char* end = hw::memory::ewram_heap_end();
+    data.total_bytes_count = end - start;
+
+    item_type new_item;
+    new_item.data = start;
+    new_item.size = data.total_bytes_count;
+    data.items.push_front(new_item);
+    data.free_items.push_back(data.items.begin());
+    data.free_bytes_count = data.total_bytes_count;
+}
+
+void* ewram_alloc(int bytes, [[maybe_unused]] const void* caller)
+{
+    void* result = _alloc(bytes);
+
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        if(result)
+        {
+            _track_alloc(result, bytes, caller);
+        }
+    #endif
+
+    return result;
+}
+
+void* ewram_calloc(int bytes, const void* caller)
+{
+    void* result = ewram_alloc(bytes, caller);
+
+    if(result)
+    {
+        auto int_result = reinterpret_cast<int*>(result);
+        memory::clear(_aligned_bytes(bytes) / int(sizeof(int)), *int_result);
+    }
+
+    return result;
+}
+
+void* ewram_realloc(void* ptr, int new_bytes, [[maybe_unused]] const void* caller)
+{
+    void* result = _realloc(ptr, new_bytes);
+
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        if(result)
+        {
+            if(ptr)
+            {
+                _track_free(ptr);
+            }
+
+            _track_alloc(result, new_bytes, caller);
+        }
+    #endif
+
+    return result;
+}
+
+void ewram_free(void* ptr)
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        if(ptr)
+        {
+            _track_free(ptr);
+        }
+    #endif
+
+    _free(ptr);
 }
 
 int used_alloc_ewram()
@@ -276,4 +681,100 @@ int available_items_ewram()
     return data.items.available();
 }
 
+int largest_available_alloc_ewram()
+{
+    // Free items are sorted by size:
+    if(data.free_items.empty())
+    {
+        return 0;
+    }
+
+    return data.free_items.back()->size - int(sizeof(items_iterator));
+}
+
+const char* ewram_alloc_tag()
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        return data.tag;
+    #else
+        return nullptr;
+    #endif
+}
+
+void set_ewram_alloc_tag([[maybe_unused]] const char* tag)
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        data.tag = tag;
+    #endif
+}
+
+int max_used_alloc_ewram()
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        return data.max_used_bytes_count;
+    #else
+        return 0;
+    #endif
+}
+
+int last_frame_allocs_ewram()
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        return data.last_frame_allocs_count;
+    #else
+        return 0;
+    #endif
+}
+
+int max_frame_allocs_ewram()
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        return data.max_frame_allocs_count;
+    #else
+        return 0;
+    #endif
+}
+
+void log_ewram_usage()
+{
+    #if BN_CFG_LOG_ENABLED
+        BN_LOG("EWRAM alloc used: ", used_alloc_ewram(), "B available: ", available_alloc_ewram(),
+               "B largest free block: ", largest_available_alloc_ewram(), "B");
+        BN_LOG("EWRAM alloc items used: ", used_items_ewram(), " available: ", available_items_ewram());
+
+        #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+            BN_LOG("EWRAM alloc peak: ", data.max_used_bytes_count, "B items peak: ", data.max_used_items_count);
+            BN_LOG("EWRAM allocs last frame: ", data.last_frame_allocs_count,
+                   " max frame: ", data.max_frame_allocs_count, " total: ", data.total_allocs_count);
+
+            for(const tracked_block& block : data.tracked_blocks)
+            {
+                if(block.tag)
+                {
+                    BN_LOG("EWRAM block ", block.ptr, ": ", block.bytes, "B tag: ", block.tag);
+                }
+                else
+                {
+                    BN_LOG("EWRAM block ", block.ptr, ": ", block.bytes, "B caller: ", block.caller);
+                }
+            }
+
+            if(int untracked_blocks_count = data.untracked_blocks_count)
+            {
+                BN_LOG("EWRAM untracked blocks: ", untracked_blocks_count);
+            }
+        #endif
+    #endif
+}
+
+void next_frame()
+{
+    #if BN_CFG_MEMORY_EWRAM_TRACKING_ENABLED
+        int frame_allocs_count = data.frame_allocs_count;
+        data.last_frame_allocs_count = frame_allocs_count;
+        data.max_frame_allocs_count = max(data.max_frame_allocs_count, frame_allocs_count);
+        data.frame_allocs_count = 0;
+    #endif
+}
+
 }
@@ -12,11 +12,11 @@ namespace bn::memory_manager
 {
     void init();
 
-    [[nodiscard]] void* ewram_alloc(int bytes);
+    [[nodiscard]] void* ewram_alloc(int bytes, const void* caller);
 
-    [[nodiscard]] void* ewram_calloc(int bytes);
+    [[nodiscard]] void* ewram_calloc(int bytes, const void* caller);
 
-    [[nodiscard]] void* ewram_realloc(void* ptr, int new_bytes);
+    [[nodiscard]] void* ewram_realloc(void* ptr, int new_bytes, const void* caller);
 
     void ewram_free(void* ptr);
 
@@ -27,6 +27,22 @@ namespace bn::memory_manager
     [[nodiscard]] int used_items_ewram();
 
     [[nodiscard]] int available_items_ewram();
+
+    [[nodiscard]] int largest_available_alloc_ewram();
+
+    [[nodiscard]] const char* ewram_alloc_tag();
+
+    void set_ewram_alloc_tag(const char* tag);
+
+    [[nodiscard]] int max_used_alloc_ewram();
+
+    [[nodiscard]] int last_frame_allocs_ewram();
+
+    [[nodiscard]] int max_frame_allocs_ewram();
+
+    void log_ewram_usage();
+
+    void next_frame();
 }
 
 #endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_meta_sprite.h"
+
+#include "bn_camera_ptr.h"
+
+namespace bn
+{
+
+void imeta_sprite::set_x(fixed x)
+{
+    _position.set_x(x);
+    _update_positions();
+}
+
+void imeta_sprite::set_y(fixed y)
+{
+    _position.set_y(y);
+    _update_positions();
+}
+
+void imeta_sprite::set_position(fixed x, fixed y)
+{
+    _position = fixed_point(x, y);
+    _update_positions();
+}
+
+void imeta_sprite::set_position(const fixed_point& position)
+{
+    _position = position;
+    _update_positions();
+}
+
+void imeta_sprite::set_horizontal_flip(bool horizontal_flip)
+{
+    if(horizontal_flip != _horizontal_flip)
+    {
+        _horizontal_flip = horizontal_flip;
+
+        for(sprite_ptr& sprite : _sprites)
+        {
+            sprite.set_horizontal_flip(horizontal_flip);
+        }
+
+        _update_positions();
+    }
+}
+
+void imeta_sprite::set_vertical_flip(bool vertical_flip)
+{
+    if(vertical_flip != _vertical_flip)
+    {
+        _vertical_flip = vertical_flip;
+
+        for(sprite_ptr& sprite : _sprites)
+        {
+            sprite.set_vertical_flip(vertical_flip);
+        }
+
+        _update_positions();
+    }
+}
+
+void imeta_sprite::set_bg_priority(int bg_priority)
+{
+    for(sprite_ptr& sprite : _sprites)
+    {
+        sprite.set_bg_priority(bg_priority);
+    }
+}
+
+void imeta_sprite::set_z_order(int z_order)
+{
+    for(sprite_ptr& sprite : _sprites)
+    {
+        sprite.set_z_order(z_order);
+    }
+}
+
+void imeta_sprite::set_visible(bool visible)
+{
+    for(sprite_ptr& sprite : _sprites)
+    {
+        sprite.set_visible(visible);
+    }
+}
+
+void imeta_sprite::set_camera(const optional<camera_ptr>& camera)
+{
+    for(sprite_ptr& sprite : _sprites)
+    {
+        sprite.set_camera(camera);
+    }
+}
+
+void imeta_sprite::remove_camera()
+{
+    for(sprite_ptr& sprite : _sprites)
+    {
+        sprite.remove_camera();
+    }
+}
+
+void imeta_sprite::_create_sprites()
+{
+    const span<const meta_sprite_piece>& pieces_ref = _item.pieces_ref();
+    BN_ASSERT(pieces_ref.size() <= _sprites.max_size(),
+              "Not enough space for all pieces: ", pieces_ref.size(), " - ", _sprites.max_size());
+
+    // Pieces are created in order with the same position, so they keep the same drawing order between them:
+    for(int index = 0, limit = pieces_ref.size(); index < limit; ++index)
+    {
+        const meta_sprite_piece& piece = pieces_ref[index];
+        fixed_point piece_position(_position.x() + piece.x(), _position.y() + piece.y());
+        _sprites.push_back(_item.piece_sprite_item(index).create_sprite(piece_position));
+    }
+}
+
+void imeta_sprite::_update_positions()
+{
+    const meta_sprite_piece* pieces_data = _item.pieces_ref().data();
+    fixed x = _position.x();
+    fixed y = _position.y();
+    int x_sign = _horizontal_flip ? -1 : 1;
+    int y_sign = _vertical_flip ? -1 : 1;
+
+    for(int index = 0, limit = _sprites.size(); index < limit; ++index)
+    {
+        const meta_sprite_piece& piece = pieces_data[index];
+        _sprites[index].set_position(x + (piece.x() * x_sign), y + (piece.y() * y_sign));
+    }
+}
+
+}
@@ -74,6 +74,11 @@ fixed volume()
     return audio_manager::music_volume();
 }
 
+span<const uint8_t> events()
+{
+    return audio_manager::music_events();
+}
+
 void set_volume(fixed volume)
 {
     BN_ASSERT(volume >= 0 && volume <= 1, "Volume range is [0..1]: ", volume);
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_node.h"
+
+namespace bn
+{
+
+node::node(const fixed_point& position) :
+    _position(position),
+    _world_position(position)
+{
+}
+
+node::~node()
+{
+    if(_dirty)
+    {
+        node** dirty_node_ptr = &nodes_manager::data.dirty_nodes;
+
+        while(node* dirty_node = *dirty_node_ptr)
+        {
+            if(dirty_node == this)
+            {
+                *dirty_node_ptr = _next_dirty;
+                break;
+            }
+
+            dirty_node_ptr = &dirty_node->_next_dirty;
+        }
+    }
+
+    _unlink_from_parent();
+
+    node* child = _first_child;
+
+    while(child)
+    {
+        node* next_child = child->_next_sibling;
+        child->_parent = nullptr;
+        child->_next_sibling = nullptr;
+        child->_set_dirty();
+        child = next_child;
+    }
+}
+
+void node::set_x(fixed x)
+{
+    _position.set_x(x);
+    _set_dirty();
+}
+
+void node::set_y(fixed y)
+{
+    _position.set_y(y);
+    _set_dirty();
+}
+
+void node::set_position(fixed x, fixed y)
+{
+    _position = fixed_point(x, y);
+    _set_dirty();
+}
+
+void node::set_position(const fixed_point& position)
+{
+    _position = position;
+    _set_dirty();
+}
+
+void node::set_parent(node& parent)
+{
+    for(const node* ancestor = &parent; ancestor; ancestor = ancestor->_parent)
+    {
+        BN_ASSERT(ancestor != this, "Parent is the node itself or one of its descendants");
+    }
+
+    if(_parent != &parent)
+    {
+        _unlink_from_parent();
+        _parent = &parent;
+        _next_sibling = parent._first_child;
+        parent._first_child = this;
+        _set_dirty();
+    }
+}
+
+void node::remove_parent()
+{
+    if(_parent)
+    {
+        _unlink_from_parent();
+        _set_dirty();
+    }
+}
+
+void node::set_sprite(sprite_ptr sprite)
+{
+    _sprite = move(sprite);
+    _set_dirty();
+}
+
+void node::remove_sprite()
+{
+    _sprite.reset();
+}
+
+void node::set_regular_bg(regular_bg_ptr regular_bg)
+{
+    _regular_bg = move(regular_bg);
+    _set_dirty();
+}
+
+void node::remove_regular_bg()
+{
+    _regular_bg.reset();
+}
+
+void node::_set_dirty()
+{
+    if(! _dirty)
+    {
+        _dirty = true;
+        _next_dirty = nodes_manager::data.dirty_nodes;
+        nodes_manager::data.dirty_nodes = this;
+    }
+}
+
+void node::_unlink_from_parent()
+{
+    if(_parent)
+    {
+        node** child_ptr = &_parent->_first_child;
+
+        while(*child_ptr != this)
+        {
+            child_ptr = &(*child_ptr)->_next_sibling;
+        }
+
+        *child_ptr = _next_sibling;
+        _parent = nullptr;
+        _next_sibling = nullptr;
+    }
+}
+
+bool node::_dirty_ancestor() const
+{
+    for(const node* ancestor = _parent; ancestor; ancestor = ancestor->_parent)
+    {
+        if(ancestor->_dirty)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void node::_propagate()
+{
+    _world_position = _parent ? _parent->_world_position + _position : _position;
+    _dirty = false;
+
+    if(sprite_ptr* sprite = _sprite.get())
+    {
+        sprite->set_position(_world_position);
+    }
+
+    if(regular_bg_ptr* regular_bg = _regular_bg.get())
+    {
+        regular_bg->set_position(_world_position);
+    }
+
+    for(node* child = _first_child; child; child = child->_next_sibling)
+    {
+        child->_propagate();
+    }
+}
+
+}
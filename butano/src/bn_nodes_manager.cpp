@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_nodes_manager.h"
+
+namespace bn::nodes_manager
+{
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        node* dirty_nodes = nullptr;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+}
+
+#include "bn_node.cpp.h"
+
+namespace bn::nodes_manager
+{
+
+void update()
+{
+    node* dirty_node = data.dirty_nodes;
+    data.dirty_nodes = nullptr;
+
+    while(dirty_node)
+    {
+        node* next_dirty_node = dirty_node->_next_dirty;
+        dirty_node->_next_dirty = nullptr;
+
+        // Nodes with a dirty ancestor are propagated with it:
+        if(dirty_node->_dirty && ! dirty_node->_dirty_ancestor())
+        {
+            dirty_node->_propagate();
+        }
+
+        dirty_node = next_dirty_node;
+    }
+}
+
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_NODES_MANAGER_H
+#define BN_NODES_MANAGER_H
+
+#include "bn_node.h"
+
+namespace bn::nodes_manager
+{
+    void update();
+}
+
+#endif
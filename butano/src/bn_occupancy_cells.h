@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_OCCUPANCY_CELLS_H
+#define BN_OCCUPANCY_CELLS_H
+
+#include "bn_span.h"
+#include "bn_algorithm.h"
+
+namespace bn
+{
+
+// Types with higher values have more priority when several units are shown in the same cell:
+enum class occupancy_cell_type : uint8_t
+{
+    FREE,
+    TO_REMOVE,
+    SPRITE_TILES,
+    BG_TILES,
+    BG_MAP,
+    SPRITE_HANDLE,
+    SPRITE_AFFINE_MAT,
+    SPRITE_PALETTE,
+    BG_PALETTE
+};
+
+inline void set_occupancy_cells(int first_unit, int units_count, int total_units, occupancy_cell_type type,
+                                span<occupancy_cell_type> cells)
+{
+    int cells_count = cells.size();
+    int first_cell = (first_unit * cells_count) / total_units;
+    int last_cell = min((((first_unit + units_count) * cells_count) + total_units - 1) / total_units, cells_count);
+    occupancy_cell_type* cells_data = cells.data();
+
+    for(int index = first_cell; index < last_cell; ++index)
+    {
+        occupancy_cell_type& cell = cells_data[index];
+        cell = max(cell, type);
+    }
+}
+
+}
+
+#endif
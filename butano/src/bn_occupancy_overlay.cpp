@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_occupancy_overlay.h"
+
+#include "bn_tile.h"
+#include "bn_keypad.h"
+#include "bn_sprites.h"
+#include "bn_display.h"
+#include "bn_bpp_mode.h"
+#include "bn_palettes_bank.h"
+#include "bn_sprites_manager.h"
+#include "bn_occupancy_cells.h"
+#include "bn_palettes_manager.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_bg_blocks_manager.h"
+#include "bn_sprite_palette_item.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_tiles_manager.h"
+#include "bn_sprite_affine_mats_manager.h"
+#include "../hw/include/bn_hw_sprites_constants.h"
+#include "../hw/include/bn_hw_sprite_tiles_constants.h"
+#include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
+
+namespace bn
+{
+
+namespace
+{
+    class section
+    {
+
+    public:
+        int first_cell;
+        int cells_count;
+        int x;
+        int y;
+        int columns;
+        int cell_width;
+        int cell_height;
+
+        [[nodiscard]] constexpr int width() const
+        {
+            return columns * cell_width;
+        }
+
+        [[nodiscard]] constexpr int height() const
+        {
+            return ((cells_count + columns - 1) / columns) * cell_height;
+        }
+    };
+
+    constexpr int sprite_tiles_cells_count = 1024;
+    constexpr int bg_blocks_cells_count = 32;
+    constexpr int sprite_handles_cells_count = 128;
+    constexpr int sprite_affine_mats_cells_count = 32;
+    constexpr int palettes_cells_count = 16;
+
+    constexpr section sections[] = {
+        { 0, sprite_tiles_cells_count, 0, 0, 128, 1, 2 },
+        { 1024, bg_blocks_cells_count, 0, 18, 32, 4, 8 },
+        { 1056, sprite_handles_cells_count, 0, 28, 128, 1, 6 },
+        { 1184, sprite_affine_mats_cells_count, 0, 36, 32, 4, 6 },
+        { 1216, palettes_cells_count, 0, 44, 16, 4, 8 },
+        { 1232, palettes_cells_count, 64, 44, 16, 4, 8 },
+    };
+
+    constexpr int sprite_dimension = 64;
+    constexpr int map_width = sprite_dimension * 2;
+    constexpr int map_height = 52;
+    constexpr int max_age = 15;
+    constexpr int recent_age = 2;
+    constexpr int unknown_cell = 0xFF;
+
+    constexpr int background_color_index = 1;
+    constexpr int first_cell_color_index = 2;
+    constexpr int recent_color_index = 11;
+
+    constexpr color palette_colors[] = {
+        color(0, 0, 0), color(2, 2, 4), color(8, 8, 8), color(31, 4, 4),
+        color(4, 28, 4), color(6, 10, 31), color(4, 28, 28), color(30, 28, 4),
+        color(31, 16, 2), color(28, 6, 28), color(18, 8, 31), color(31, 31, 31),
+        color(0, 0, 0), color(0, 0, 0), color(0, 0, 0), color(0, 0, 0)
+    };
+
+    static_assert(sprite_tiles_cells_count == hw::sprite_tiles::tiles_count());
+    static_assert(sprite_handles_cells_count == hw::sprites::count());
+    static_assert(sprite_affine_mats_cells_count == hw::sprite_affine_mats::count());
+    static_assert(palettes_cells_count == hw::palettes::count());
+}
+
+occupancy_overlay::occupancy_overlay(int refresh_frames) :
+    _refresh_frames(refresh_frames)
+{
+    BN_ASSERT(refresh_frames > 0, "Invalid refresh frames: ", refresh_frames);
+
+    static_assert(_cells_count == sections[5].first_cell + palettes_cells_count);
+}
+
+void occupancy_overlay::set_visible(bool visible)
+{
+    if(visible != _visible)
+    {
+        _visible = visible;
+        _counter = 0;
+        _sprites.clear();
+        _tiles.clear();
+
+        if(visible)
+        {
+            sprite_palette_ptr palette = sprite_palette_ptr::create(
+                        sprite_palette_item(palette_colors, bpp_mode::BPP_4));
+            sprite_shape_size shape_size(sprite_shape::SQUARE, sprite_size::HUGE);
+            int x = sprite_dimension / 2 + 4 - (display::width() / 2);
+            int y = (display::height() / 2) - map_height - 4 + (sprite_dimension / 2);
+
+            for(int index = 0; index < 2; ++index)
+            {
+                _tiles.push_back(sprite_tiles_ptr::allocate(shape_size.tiles_count(bpp_mode::BPP_4), bpp_mode::BPP_4));
+
+                sprite_ptr sprite = sprite_ptr::create(x + (index * sprite_dimension), y, shape_size, _tiles.back(),
+                                                       palette);
+                sprite.set_bg_priority(0);
+                sprite.set_z_order(sprites::min_z_order());
+                _sprites.push_back(move(sprite));
+            }
+
+            for(uint8_t& cell : _cells)
+            {
+                cell = unknown_cell;
+            }
+
+            _refresh();
+        }
+    }
+}
+
+void occupancy_overlay::update()
+{
+    if(keypad::pressed(keypad::key_type::START) && keypad::held(keypad::key_type::L) &&
+            keypad::held(keypad::key_type::R))
+    {
+        set_visible(! _visible);
+    }
+
+    if(_visible)
+    {
+        ++_counter;
+
+        if(_counter >= _refresh_frames)
+        {
+            _counter = 0;
+            _refresh();
+        }
+    }
+}
+
+void occupancy_overlay::_refresh()
+{
+    occupancy_cell_type cells[_cells_count];
+
+    for(occupancy_cell_type& cell : cells)
+    {
+        cell = occupancy_cell_type::FREE;
+    }
+
+    sprite_tiles_manager::fill_occupancy_cells(span<occupancy_cell_type>(cells + sections[0].first_cell,
+                                                                         sprite_tiles_cells_count));
+    bg_blocks_manager::fill_occupancy_cells(span<occupancy_cell_type>(cells + sections[1].first_cell,
+                                                                      bg_blocks_cells_count));
+    sprites_manager::fill_handles_occupancy_cells(span<occupancy_cell_type>(cells + sections[2].first_cell,
+                                                                            sprite_handles_cells_count));
+    sprite_affine_mats_manager::fill_occupancy_cells(span<occupancy_cell_type>(cells + sections[3].first_cell,
+                                                                               sprite_affine_mats_cells_count));
+    palettes_manager::sprite_palettes_bank().fill_occupancy_cells(
+                occupancy_cell_type::SPRITE_PALETTE,
+                span<occupancy_cell_type>(cells + sections[4].first_cell, palettes_cells_count));
+    palettes_manager::bg_palettes_bank().fill_occupancy_cells(
+                occupancy_cell_type::BG_PALETTE,
+                span<occupancy_cell_type>(cells + sections[5].first_cell, palettes_cells_count));
+
+    // Lower bits store the type of each cell, and upper bits the number of refreshes since it was changed:
+    for(int index = 0; index < _cells_count; ++index)
+    {
+        int old_cell = _cells[index];
+        int type = int(cells[index]);
+        int age;
+
+        if(old_cell == unknown_cell)
+        {
+            age = max_age;
+        }
+        else if((old_cell & 0xF) != type)
+        {
+            age = 0;
+        }
+        else
+        {
+            age = min((old_cell >> 4) + 1, max_age);
+        }
+
+        _cells[index] = uint8_t(type | (age << 4));
+    }
+
+    // Pixels are written a tile row at a time, since VRAM doesn't allow byte writes:
+    tile* tiles_data[2] = { _tiles[0].vram()->data(), _tiles[1].vram()->data() };
+
+    for(int y = 0; y < sprite_dimension; ++y)
+    {
+        const section* row_sections[2];
+        int row_sections_count = 0;
+
+        if(y < map_height)
+        {
+            for(const section& row_section : sections)
+            {
+                if(y >= row_section.y && y < row_section.y + row_section.height())
+                {
+                    row_sections[row_sections_count] = &row_section;
+                    ++row_sections_count;
+                }
+            }
+        }
+
+        for(int tile_x = 0; tile_x < map_width / 8; ++tile_x)
+        {
+            uint32_t tile_row = 0;
+
+            if(y < map_height)
+            {
+                for(int pixel_x = 7; pixel_x >= 0; --pixel_x)
+                {
+                    int x = (tile_x * 8) + pixel_x;
+                    int color_index = background_color_index;
+
+                    for(int section_index = 0; section_index < row_sections_count; ++section_index)
+                    {
+                        const section& row_section = *row_sections[section_index];
+                        int section_x = x - row_section.x;
+
+                        if(section_x >= 0 && section_x < row_section.width())
+                        {
+                            int column = section_x / row_section.cell_width;
+                            int row = (y - row_section.y) / row_section.cell_height;
+                            int cell_index = (row * row_section.columns) + column;
+                            bool separator = row_section.cell_width >= 4 &&
+                                    section_x % row_section.cell_width == row_section.cell_width - 1;
+
+                            if(cell_index < row_section.cells_count && ! separator)
+                            {
+                                int cell = _cells[row_section.first_cell + cell_index];
+                                color_index = (cell >> 4) < recent_age ?
+                                            recent_color_index : first_cell_color_index + (cell & 0xF);
+                            }
+
+                            break;
+                        }
+                    }
+
+                    tile_row = (tile_row << 4) | unsigned(color_index);
+                }
+            }
+
+            int sprite_index = tile_x / (sprite_dimension / 8);
+            int tile_index = ((y / 8) * (sprite_dimension / 8)) + (tile_x % (sprite_dimension / 8));
+            tiles_data[sprite_index][tile_index].data[y % 8] = tile_row;
+        }
+    }
+}
+
+}
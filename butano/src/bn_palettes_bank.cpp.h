@@ -12,6 +12,7 @@
 #include "bn_bpp_mode.h"
 #include "bn_algorithm.h"
 #include "bn_compression_type.h"
+#include "bn_occupancy_cells.h"
 #include "../hw/include/bn_hw_decompress.h"
 
 #if BN_CFG_LOG_ENABLED
@@ -82,6 +83,21 @@ int palettes_bank::used_colors_count() const
     }
 #endif
 
+void palettes_bank::fill_occupancy_cells(occupancy_cell_type used_type, span<occupancy_cell_type> cells) const
+{
+    int palettes_count = hw::palettes::count();
+
+    for(int index = 0; index < palettes_count; ++index)
+    {
+        const palette& pal = _palettes[index];
+
+        if(pal.usages)
+        {
+            set_occupancy_cells(index, pal.slots_count, palettes_count, used_type, cells);
+        }
+    }
+}
+
 int palettes_bank::find_bpp_4(const span<const color>& colors, uint16_t hash)
 {
     auto bpp_4_indexes_map_it = _bpp_4_indexes_map.find(hash);
@@ -235,6 +251,21 @@ int palettes_bank::create_bpp_8(const span<const color>& colors, compression_typ
                 dest_colors_span = span<const color>(dest_colors_array, colors_count);
                 break;
 
+            case compression_type::LZ4:
+                hw::decompress::lz4(colors.data(), dest_colors_array);
+                dest_colors_span = span<const color>(dest_colors_array, colors_count);
+                break;
+
+            case compression_type::HUFFMAN:
+                hw::decompress::huffman(colors.data(), dest_colors_array);
+                dest_colors_span = span<const color>(dest_colors_array, colors_count);
+                break;
+
+            case compression_type::LZ77_HUFFMAN:
+                hw::decompress::lz77_huffman_wram(colors.data(), dest_colors_array);
+                dest_colors_span = span<const color>(dest_colors_array, colors_count);
+                break;
+
             default:
                 BN_ERROR("Unknown compression type: ", int(compression));
                 break;
@@ -285,6 +316,7 @@ void palettes_bank::decrease_usages(int id)
             _bpp_4_indexes_map.erase(pal.hash);
         }
 
+        remove_cycles(id);
         pal = palette();
     }
 }
@@ -426,20 +458,60 @@ void palettes_bank::set_rotate_count(int id, int count)
     }
 }
 
-void palettes_bank::reload(int id)
+int palettes_bank::cycles_count(int id) const
 {
-    if(_first_index_to_commit != numeric_limits<int>::max())
+    int result = 0;
+
+    for(const cycle_type& cycle : _cycles)
     {
-        _first_index_to_commit = min(_first_index_to_commit, id);
-        _last_index_to_commit = max(_last_index_to_commit, id);
+        if(cycle.palette_id == id)
+        {
+            ++result;
+        }
     }
-    else
+
+    return result;
+}
+
+void palettes_bank::add_cycle(int id, const palette_cycle& cycle)
+{
+    BN_ASSERT(cycle.start_index() + cycle.length() <= colors_count(id),
+              "Invalid cycle: ", cycle.start_index(), " - ", cycle.length(), " - ", colors_count(id));
+    BN_ASSERT(! _cycles.full(), "No more palette cycles available");
+
+    _cycles.push_back(cycle_type{ cycle, uint16_t(cycle.period()), 0, int8_t(id) });
+}
+
+void palettes_bank::remove_cycles(int id)
+{
+    bool removed = false;
+
+    for(auto it = _cycles.begin(); it != _cycles.end(); )
     {
-        _first_index_to_commit = id;
-        _last_index_to_commit = id;
+        if(it->palette_id == id)
+        {
+            it = _cycles.erase(it);
+            removed = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if(removed)
+    {
+        // The rotated colors are restored:
+        _palettes[id].update = true;
+        _update = true;
     }
 }
 
+void palettes_bank::reload(int id)
+{
+    _banks_to_commit |= _palette_banks(id);
+}
+
 void palettes_bank::set_transparent_color(const optional<color>& transparent_color)
 {
     bool update = _transparent_color != transparent_color;
@@ -651,8 +723,9 @@ void palettes_bank::set_fade(color color, fixed intensity)
 
 void palettes_bank::update()
 {
-    int first_index = numeric_limits<int>::max();
-    int last_index = 0;
+    // Each bit indicates if a palette bank (16 colors) must be committed:
+    unsigned banks = 0;
+    unsigned updated_banks = 0;
 
     if(_update)
     {
@@ -669,8 +742,7 @@ void palettes_bank::update()
                 if(pal.usages)
                 {
                     _update_palette(index);
-                    first_index = min(first_index, index);
-                    last_index = index;
+                    banks |= _palette_banks(index);
                 }
 
                 index += pal.slots_count;
@@ -685,45 +757,46 @@ void palettes_bank::update()
                 if(pal.update)
                 {
                     _update_palette(index);
-                    first_index = min(first_index, index);
-                    last_index = index;
+                    banks |= _palette_banks(index);
                 }
 
                 index += pal.slots_count;
             }
         }
 
+        updated_banks = banks;
+
         if(const color* transparent_color = _transparent_color.get())
         {
             _final_colors[0] = *transparent_color;
-            first_index = 0;
+            banks |= 1;
         }
 
-        if(_global_effects_enabled && first_index != numeric_limits<int>::max())
+        if(_global_effects_enabled && banks)
         {
-            color* all_colors_ptr = _final_colors + (first_index * hw::palettes::colors_per_palette());
-            int all_colors_count = (last_index - first_index + _palettes[last_index].slots_count) *
-                    hw::palettes::colors_per_palette();
-            _apply_global_effects(all_colors_count, all_colors_ptr);
+            // Contiguous banks are processed at once:
+            for_each_commit_run(banks, [this](int colors_offset, int colors_count)
+            {
+                _apply_global_effects(colors_count, _final_colors + colors_offset);
+            });
         }
     }
 
-    _first_index_to_commit = first_index;
-    _last_index_to_commit = last_index;
+    if(! _cycles.empty())
+    {
+        banks |= _update_cycles(updated_banks);
+    }
+
+    _banks_to_commit = banks;
 }
 
 optional<palettes_bank::commit_data> palettes_bank::retrieve_commit_data() const
 {
     optional<commit_data> result;
 
-    if(_first_index_to_commit != numeric_limits<int>::max())
+    if(unsigned banks = _banks_to_commit)
     {
-        int first_index = _first_index_to_commit;
-        int last_index = _last_index_to_commit;
-        int colors_offset = first_index * hw::palettes::colors_per_palette();
-        int colors_count = (last_index - first_index + _palettes[last_index].slots_count) *
-                hw::palettes::colors_per_palette();
-        result = { _final_colors, colors_offset, colors_count };
+        result = { _final_colors, banks };
     }
 
     return result;
@@ -731,8 +804,7 @@ optional<palettes_bank::commit_data> palettes_bank::retrieve_commit_data() const
 
 void palettes_bank::reset_commit_data()
 {
-    _first_index_to_commit = numeric_limits<int>::max();
-    _last_index_to_commit = 0;
+    _banks_to_commit = 0;
 }
 
 void palettes_bank::fill_hblank_effect_colors(int id, const color* source_colors_ptr, uint16_t* dest_ptr) const
@@ -850,6 +922,55 @@ void palettes_bank::_update_palette(int id)
     }
 }
 
+unsigned palettes_bank::_update_cycles(unsigned updated_banks)
+{
+    int colors_per_palette = hw::palettes::colors_per_palette();
+    unsigned result = 0;
+
+    for(cycle_type& cycle : _cycles)
+    {
+        const palette_cycle& palette_cycle = cycle.cycle;
+        int length = palette_cycle.length();
+        int rotate_count = 0;
+
+        if(cycle.counter > 1)
+        {
+            --cycle.counter;
+        }
+        else
+        {
+            cycle.counter = uint16_t(palette_cycle.period());
+            cycle.offset = uint8_t(cycle.offset + 1 == length ? 0 : cycle.offset + 1);
+            rotate_count = 1;
+        }
+
+        // Recomputed palettes are rotated by the whole offset, the other ones only by the new step:
+        int id = cycle.palette_id;
+
+        if(updated_banks & (1u << id))
+        {
+            rotate_count = cycle.offset;
+        }
+
+        if(rotate_count)
+        {
+            int first_color = (id * colors_per_palette) + palette_cycle.start_index();
+            color* colors_ptr = _final_colors + first_color;
+            uint16_t temp_buffer[hw::palettes::colors()];
+            hw::memory::copy_half_words(colors_ptr, length, temp_buffer);
+
+            auto color_temp_buffer_ptr = reinterpret_cast<const color*>(temp_buffer);
+            hw::palettes::rotate(color_temp_buffer_ptr, rotate_count, length, colors_ptr);
+
+            int first_bank = first_color / colors_per_palette;
+            int last_bank = (first_color + length - 1) / colors_per_palette;
+            result |= ((1u << (last_bank - first_bank + 1)) - 1) << first_bank;
+        }
+    }
+
+    return result;
+}
+
 void palettes_bank::_apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const
 {
     if(int brightness = fixed_t<5>(_brightness).data())
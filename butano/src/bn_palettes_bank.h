@@ -9,9 +9,12 @@
 #include "bn_span.h"
 #include "bn_fixed.h"
 #include "bn_color.h"
+#include "bn_vector.h"
 #include "bn_optional.h"
 #include "bn_config_log.h"
+#include "bn_palette_cycle.h"
 #include "bn_unordered_map.h"
+#include "bn_config_palettes.h"
 #include "../hw/include/bn_hw_palettes.h"
 
 namespace bn
@@ -19,6 +22,7 @@ namespace bn
 
 enum class bpp_mode : uint8_t;
 enum class compression_type : uint8_t;
+enum class occupancy_cell_type : uint8_t;
 
 class palettes_bank
 {
@@ -29,10 +33,38 @@ public:
 
     public:
         const color* colors_ptr;
-        int offset;
-        int count;
+        unsigned banks;
     };
 
+    template<typename Function>
+    static void for_each_commit_run(unsigned banks, const Function& function)
+    {
+        int colors_per_palette = hw::palettes::colors_per_palette();
+        int index = 0;
+
+        while(banks)
+        {
+            if(banks & 1)
+            {
+                int first_index = index;
+
+                do
+                {
+                    banks >>= 1;
+                    ++index;
+                }
+                while(banks & 1);
+
+                function(first_index * colors_per_palette, (index - first_index) * colors_per_palette);
+            }
+            else
+            {
+                banks >>= 1;
+                ++index;
+            }
+        }
+    }
+
     [[nodiscard]] static uint16_t colors_hash(const span<const color>& colors);
 
     [[nodiscard]] int used_colors_count() const;
@@ -46,6 +78,8 @@ public:
         void log_status() const;
     #endif
 
+    void fill_occupancy_cells(occupancy_cell_type used_type, span<occupancy_cell_type> cells) const;
+
     [[nodiscard]] int find_bpp_4(const span<const color>& colors, uint16_t hash);
 
     [[nodiscard]] int find_bpp_8(const span<const color>& colors);
@@ -113,6 +147,12 @@ public:
 
     void set_rotate_count(int id, int count);
 
+    [[nodiscard]] int cycles_count(int id) const;
+
+    void add_cycle(int id, const palette_cycle& cycle);
+
+    void remove_cycles(int id);
+
     void reload(int id);
 
     [[nodiscard]] const optional<color>& transparent_color() const
@@ -182,6 +222,11 @@ public:
 
     void update();
 
+    [[nodiscard]] bool must_commit() const
+    {
+        return _banks_to_commit;
+    }
+
     [[nodiscard]] optional<commit_data> retrieve_commit_data() const;
 
     void reset_commit_data();
@@ -216,6 +261,16 @@ private:
         void apply_effects(int dest_colors_count, color* dest_colors_ptr) const;
     };
 
+    class cycle_type
+    {
+
+    public:
+        palette_cycle cycle;
+        uint16_t counter;
+        uint8_t offset;
+        int8_t palette_id;
+    };
+
     class identity_hasher
     {
 
@@ -237,8 +292,8 @@ private:
     fixed _hue_shift_intensity;
     fixed _fade_intensity;
     unordered_map<uint16_t, int16_t, hw::palettes::count() * 2, identity_hasher> _bpp_4_indexes_map;
-    int _first_index_to_commit = numeric_limits<int>::max();
-    int _last_index_to_commit = 0;
+    vector<cycle_type, BN_CFG_PALETTES_MAX_CYCLES> _cycles;
+    unsigned _banks_to_commit = 0;
     color _fade_color;
     bool _inverted = false;
     bool _update = false;
@@ -258,6 +313,13 @@ private:
     void _update_palette(int id);
 
     void _apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const;
+
+    [[nodiscard]] unsigned _update_cycles(unsigned updated_banks);
+
+    [[nodiscard]] unsigned _palette_banks(int id) const
+    {
+        return ((1u << _palettes[id].slots_count) - 1) << id;
+    }
 };
 
 }
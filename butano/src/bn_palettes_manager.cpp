@@ -26,7 +26,11 @@ namespace
         palettes_bank bg_palettes_bank;
     };
 
-    BN_DATA_EWRAM static_data data;
+    #if BN_CFG_PALETTES_DATA_IWRAM
+        static_data data;
+    #else
+        BN_DATA_EWRAM static_data data;
+    #endif
 }
 
 palettes_bank& sprite_palettes_bank()
@@ -45,13 +49,23 @@ void update()
     data.bg_palettes_bank.update();
 }
 
+bool must_commit()
+{
+    return data.sprite_palettes_bank.must_commit() || data.bg_palettes_bank.must_commit();
+}
+
 void commit()
 {
     optional<palettes_bank::commit_data> commit_data = data.sprite_palettes_bank.retrieve_commit_data();
 
     if(palettes_bank::commit_data* commit_data_ptr = commit_data.get())
     {
-        hw::palettes::commit_sprites(commit_data_ptr->colors_ptr, commit_data_ptr->offset, commit_data_ptr->count);
+        // Only modified banks are committed:
+        const color* colors_ptr = commit_data_ptr->colors_ptr;
+        palettes_bank::for_each_commit_run(commit_data_ptr->banks, [colors_ptr](int colors_offset, int colors_count)
+        {
+            hw::palettes::commit_sprites(colors_ptr, colors_offset, colors_count);
+        });
         data.sprite_palettes_bank.reset_commit_data();
     }
 
@@ -59,7 +73,11 @@ void commit()
 
     if(palettes_bank::commit_data* commit_data_ptr = commit_data.get())
     {
-        hw::palettes::commit_bgs(commit_data_ptr->colors_ptr, commit_data_ptr->offset, commit_data_ptr->count);
+        const color* colors_ptr = commit_data_ptr->colors_ptr;
+        palettes_bank::for_each_commit_run(commit_data_ptr->banks, [colors_ptr](int colors_offset, int colors_count)
+        {
+            hw::palettes::commit_bgs(colors_ptr, colors_offset, colors_count);
+        });
         data.bg_palettes_bank.reset_commit_data();
     }
 }
@@ -21,6 +21,8 @@ namespace palettes_manager
 
     void update();
 
+    [[nodiscard]] bool must_commit();
+
     void commit();
 
     void stop();
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_particle_system.h"
+
+#include "bn_display.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+int particle_system::_update_particles()
+{
+    int acceleration_x = _acceleration.x().data();
+    int acceleration_y = _acceleration.y().data();
+    int size = _size;
+    int new_size = 0;
+
+    // Expired particles are removed keeping the creation order of the remaining ones:
+    for(int index = 0; index < size; ++index)
+    {
+        if(int frames = _frames[index])
+        {
+            int velocity_x = _velocity_xs[index];
+            int velocity_y = _velocity_ys[index];
+            _xs[new_size] = _xs[index] + velocity_x;
+            _ys[new_size] = _ys[index] + velocity_y;
+            _velocity_xs[new_size] = velocity_x + acceleration_x;
+            _velocity_ys[new_size] = velocity_y + acceleration_y;
+            _frames[new_size] = uint16_t(frames - 1);
+            ++new_size;
+        }
+    }
+
+    return new_size;
+}
+
+void particle_system::_write_handles(int hw_x, int hw_y, int attr0, int attr1, int attr2, void* handles) const
+{
+    auto handles_ptr = static_cast<hw::sprites::handle_type*>(handles);
+    int width = _shape_size.width();
+    int height = _shape_size.height();
+
+    for(int index = 0, limit = _size; index < limit; ++index)
+    {
+        hw::sprites::handle_type& handle = handles_ptr[index];
+        int x = hw_x + (_xs[index] >> fixed::precision());
+        int y = hw_y + (_ys[index] >> fixed::precision());
+
+        if(x > -width && x < display::width() && y > -height && y < display::height())
+        {
+            handle.attr0 = uint16_t(attr0 | (y & 255));
+            handle.attr1 = uint16_t(attr1 | (x & 511));
+            handle.attr2 = uint16_t(attr2);
+        }
+        else
+        {
+            hw::sprites::hide_and_destroy(handle);
+        }
+    }
+}
+
+}
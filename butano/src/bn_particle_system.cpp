@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_particle_system.h"
+
+#include "bn_display.h"
+#include "bn_sprites_manager.h"
+#include "bn_display_manager.h"
+#include "../hw/include/bn_hw_sprites.h"
+
+namespace bn
+{
+
+particle_system::particle_system(const sprite_shape_size& shape_size, sprite_tiles_ptr tiles,
+                                 sprite_palette_ptr palette, int first_handle_index, int max_particles) :
+    _shape_size(shape_size),
+    _tiles(move(tiles)),
+    _palette(move(palette)),
+    _first_handle_index(first_handle_index),
+    _max_size(max_particles)
+{
+    BN_ASSERT(_tiles.tiles_count() == shape_size.tiles_count(_palette.bpp()),
+              "Invalid tiles or palette: ", _tiles.tiles_count(), " - ", shape_size.tiles_count(_palette.bpp()));
+    BN_ASSERT(first_handle_index >= 0, "Invalid first handle index: ", first_handle_index);
+    BN_ASSERT(max_particles > 0 && first_handle_index + max_particles <= sprites::reserved_handles_count(),
+              "Invalid max particles: ", max_particles, " - ", first_handle_index, " - ",
+              sprites::reserved_handles_count());
+}
+
+particle_system::~particle_system()
+{
+    if(int last_committed_size = _last_committed_size)
+    {
+        auto handles = static_cast<hw::sprites::handle_type*>(sprites_manager::reserved_handles());
+        handles += _first_handle_index;
+
+        for(int index = 0; index < last_committed_size; ++index)
+        {
+            hw::sprites::hide_and_destroy(handles[index]);
+        }
+
+        sprites_manager::commit_reserved_handles(_first_handle_index, last_committed_size);
+    }
+}
+
+void particle_system::set_bg_priority(int bg_priority)
+{
+    BN_ASSERT(bg_priority >= sprites::min_bg_priority() && bg_priority <= sprites::max_bg_priority(),
+              "Invalid BG priority: ", bg_priority);
+
+    _bg_priority = int8_t(bg_priority);
+}
+
+bool particle_system::add(const fixed_point& position, const fixed_point& velocity, int frames)
+{
+    BN_ASSERT(frames > 0 && frames <= 65535, "Invalid frames: ", frames);
+
+    int size = _size;
+
+    if(size == _max_size)
+    {
+        return false;
+    }
+
+    _xs[size] = position.x().data();
+    _ys[size] = position.y().data();
+    _velocity_xs[size] = velocity.x().data();
+    _velocity_ys[size] = velocity.y().data();
+    _frames[size] = uint16_t(frames);
+    _size = size + 1;
+    return true;
+}
+
+void particle_system::update()
+{
+    BN_ASSERT(_first_handle_index + _max_size <= sprites::reserved_handles_count(),
+              "Particles handles are not reserved anymore: ", _first_handle_index, " - ", _max_size, " - ",
+              sprites::reserved_handles_count());
+
+    _size = _update_particles();
+
+    int size = _visible ? _size : 0;
+    int last_committed_size = _last_committed_size;
+
+    if(size || last_committed_size)
+    {
+        auto handles = static_cast<hw::sprites::handle_type*>(sprites_manager::reserved_handles());
+        handles += _first_handle_index;
+
+        if(size)
+        {
+            int hw_x = (display::width() / 2) - (_shape_size.width() / 2);
+            int hw_y = (display::height() / 2) - (_shape_size.height() / 2);
+
+            if(const camera_ptr* camera = _camera.get())
+            {
+                const fixed_point& camera_position = camera->position();
+                hw_x -= camera_position.x().right_shift_integer();
+                hw_y -= camera_position.y().right_shift_integer();
+            }
+
+            int attr0 = hw::sprites::first_attributes(0, _shape_size.shape(), _palette.bpp(), 0, false,
+                                                      _blending_enabled, false,
+                                                      display_manager::blending_fade_enabled());
+            int attr1 = hw::sprites::second_attributes(0, _shape_size.size(), false, false);
+            int attr2 = hw::sprites::third_attributes(_tiles.id(), _palette.id(), _bg_priority);
+            _write_handles(hw_x, hw_y, attr0, attr1, attr2, handles);
+        }
+
+        for(int index = size; index < last_committed_size; ++index)
+        {
+            hw::sprites::hide_and_destroy(handles[index]);
+        }
+
+        sprites_manager::commit_reserved_handles(_first_handle_index, max(size, last_committed_size));
+        _last_committed_size = size;
+    }
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_pcm_stream.h"
+
+#include "bn_pcm_stream_manager.h"
+
+namespace bn::pcm_stream
+{
+
+bool playing()
+{
+    return pcm_stream_manager::playing();
+}
+
+void play(const pcm_stream_item& item)
+{
+    pcm_stream_manager::play(item, true);
+}
+
+void play(const pcm_stream_item& item, bool loop)
+{
+    pcm_stream_manager::play(item, loop);
+}
+
+void stop()
+{
+    pcm_stream_manager::stop();
+}
+
+bool paused()
+{
+    return pcm_stream_manager::paused();
+}
+
+void pause()
+{
+    pcm_stream_manager::pause();
+}
+
+void resume()
+{
+    pcm_stream_manager::resume();
+}
+
+int position()
+{
+    return pcm_stream_manager::position();
+}
+
+int decode_ticks()
+{
+    return pcm_stream_manager::decode_ticks();
+}
+
+int underruns()
+{
+    return pcm_stream_manager::underruns();
+}
+
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_pcm_stream_item.h"
+
+#include "bn_pcm_stream.h"
+
+namespace bn
+{
+
+void pcm_stream_item::play() const
+{
+    pcm_stream::play(*this);
+}
+
+void pcm_stream_item::play(bool loop) const
+{
+    pcm_stream::play(*this, loop);
+}
+
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_pcm_stream_manager.h"
+
+namespace bn::pcm_stream_manager
+{
+
+namespace
+{
+    constexpr int16_t step_table[] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+        107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724,
+        796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026,
+        4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500,
+        20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    constexpr int8_t index_table[] = {
+        -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    constexpr int max_step_index = int(sizeof(step_table) / sizeof(step_table[0])) - 1;
+
+    [[nodiscard]] inline int8_t _decode_nibble(unsigned nibble, int& predictor, int& step_index)
+    {
+        int step = step_table[step_index];
+        int difference = step >> 3;
+
+        if(nibble & 4)
+        {
+            difference += step;
+        }
+
+        if(nibble & 2)
+        {
+            difference += step >> 1;
+        }
+
+        if(nibble & 1)
+        {
+            difference += step >> 2;
+        }
+
+        if(nibble & 8)
+        {
+            predictor -= difference;
+
+            if(predictor < -32768)
+            {
+                predictor = -32768;
+            }
+        }
+        else
+        {
+            predictor += difference;
+
+            if(predictor > 32767)
+            {
+                predictor = 32767;
+            }
+        }
+
+        step_index += index_table[nibble & 7];
+
+        if(step_index < 0)
+        {
+            step_index = 0;
+        }
+        else if(step_index > max_step_index)
+        {
+            step_index = max_step_index;
+        }
+
+        return int8_t(predictor >> 8);
+    }
+}
+
+void _decode_impl(const uint8_t* data, int samples, decoder_state& state, int8_t* output)
+{
+    int sample_index = state.sample_index;
+    int predictor = state.predictor;
+    int step_index = state.step_index;
+    const uint8_t* data_ptr = data + (sample_index >> 1);
+    state.sample_index = sample_index + samples;
+
+    // Odd sample indexes are stored in the high nibble:
+    if(samples && (sample_index & 1))
+    {
+        *output++ = _decode_nibble(unsigned(*data_ptr++) >> 4, predictor, step_index);
+        --samples;
+    }
+
+    while(samples >= 2)
+    {
+        unsigned data_byte = *data_ptr++;
+        *output++ = _decode_nibble(data_byte & 0xF, predictor, step_index);
+        *output++ = _decode_nibble(data_byte >> 4, predictor, step_index);
+        samples -= 2;
+    }
+
+    if(samples)
+    {
+        *output = _decode_nibble(unsigned(*data_ptr) & 0xF, predictor, step_index);
+    }
+
+    state.predictor = predictor;
+    state.step_index = step_index;
+}
+
+}
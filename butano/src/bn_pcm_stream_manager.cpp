@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_pcm_stream_manager.h"
+
+#include "bn_config_pcm_stream.h"
+
+#include "bn_pcm_stream.cpp.h"
+#include "bn_pcm_stream_item.cpp.h"
+
+#if BN_CFG_PCM_STREAM_ENABLED
+    #include "bn_memory.h"
+    #include "bn_algorithm.h"
+    #include "bn_config_audio.h"
+    #include "bn_pcm_stream_item.h"
+    #include "../hw/include/bn_hw_audio.h"
+    #include "../hw/include/bn_hw_timer.h"
+    #include "../hw/include/bn_hw_pcm_stream.h"
+#endif
+
+namespace bn::pcm_stream_manager
+{
+
+#if BN_CFG_PCM_STREAM_ENABLED
+    namespace
+    {
+        static_assert(BN_CFG_PCM_STREAM_BUFFER_FRAMES >= 2, "Invalid buffer frames");
+        static_assert(BN_CFG_PCM_STREAM_MAX_DECODE_FRAMES > 0, "Invalid max decode frames");
+
+        constexpr int buffer_frames = BN_CFG_PCM_STREAM_BUFFER_FRAMES;
+        constexpr int max_samples_per_frame = hw::pcm_stream::samples_per_frame(BN_CFG_AUDIO_MAX_MIXING_RATE);
+
+
+        enum class status_type : uint8_t
+        {
+            STOPPED,
+            STARTING,
+            PLAYING,
+            PAUSED
+        };
+
+
+        class static_data
+        {
+
+        public:
+            alignas(int) int8_t buffer[buffer_frames * max_samples_per_frame];
+            decoder_state frame_states[buffer_frames];
+            decoder_state decoder;
+            const uint8_t* samples_data = nullptr;
+            int samples_count = 0;
+            int samples_per_frame = 0;
+            int mixing_rate = 0;
+            int decoded_frames = 0;
+            int end_frame = -1;
+            volatile int played_frames = 0;
+            int decode_ticks = 0;
+            int underruns = 0;
+            volatile status_type status = status_type::STOPPED;
+            bool loop = false;
+        };
+
+        BN_DATA_EWRAM static_data data;
+
+
+        void _decode_frame()
+        {
+            int decoded_frames = data.decoded_frames;
+            int frame_index = decoded_frames % buffer_frames;
+            int samples_per_frame = data.samples_per_frame;
+            int8_t* output = data.buffer + (frame_index * samples_per_frame);
+            int remaining_samples = samples_per_frame;
+            data.frame_states[frame_index] = data.decoder;
+
+            while(remaining_samples)
+            {
+                int available_samples = data.samples_count - data.decoder.sample_index;
+
+                if(available_samples <= 0)
+                {
+                    if(data.loop)
+                    {
+                        data.decoder = decoder_state();
+                        continue;
+                    }
+
+                    // Silence is played until the stream is stopped:
+                    memory::set_bytes(0, remaining_samples, output);
+
+                    if(data.end_frame < 0)
+                    {
+                        data.end_frame = remaining_samples == samples_per_frame ? decoded_frames : decoded_frames + 1;
+                    }
+
+                    break;
+                }
+
+                int samples = min(available_samples, remaining_samples);
+                _decode_impl(data.samples_data, samples, data.decoder, output);
+                output += samples;
+                remaining_samples -= samples;
+            }
+
+            data.decoded_frames = decoded_frames + 1;
+        }
+
+        void _start()
+        {
+            data.samples_per_frame = hw::pcm_stream::samples_per_frame(data.mixing_rate);
+            data.decoded_frames = 0;
+            data.end_frame = -1;
+            data.played_frames = 0;
+
+            for(int index = 0; index < buffer_frames; ++index)
+            {
+                _decode_frame();
+            }
+
+            // Playback is started in the next V-Blank, so it is synced with the display:
+            data.status = status_type::STARTING;
+        }
+    }
+
+    bool playing()
+    {
+        return data.status != status_type::STOPPED;
+    }
+
+    void play(const pcm_stream_item& item, bool loop)
+    {
+        int mixing_rate = item.mixing_rate();
+        BN_ASSERT(mixing_rate <= BN_CFG_AUDIO_MAX_MIXING_RATE,
+                  "Invalid mixing rate: ", mixing_rate, " - ", BN_CFG_AUDIO_MAX_MIXING_RATE);
+
+        force_stop();
+
+        data.decoder = decoder_state();
+        data.samples_data = item.data_ref().data();
+        data.samples_count = item.samples_count();
+        data.mixing_rate = mixing_rate;
+        data.underruns = 0;
+        data.loop = loop;
+        _start();
+    }
+
+    void stop()
+    {
+        BN_ASSERT(playing(), "There's no PCM stream playing");
+
+        force_stop();
+    }
+
+    void force_stop()
+    {
+        if(data.status != status_type::STOPPED)
+        {
+            data.status = status_type::STOPPED;
+            hw::pcm_stream::stop();
+            data.decode_ticks = 0;
+        }
+    }
+
+    bool paused()
+    {
+        return data.status == status_type::PAUSED;
+    }
+
+    void pause()
+    {
+        BN_ASSERT(playing(), "There's no PCM stream playing");
+        BN_ASSERT(! paused(), "PCM stream is already paused");
+
+        if(data.status == status_type::PLAYING)
+        {
+            // Playback is resumed from the start of the frame that was being played:
+            data.decoder = data.frame_states[data.played_frames % buffer_frames];
+        }
+        else
+        {
+            data.decoder = data.frame_states[0];
+        }
+
+        data.status = status_type::PAUSED;
+        hw::pcm_stream::stop();
+        data.decode_ticks = 0;
+    }
+
+    void resume()
+    {
+        BN_ASSERT(paused(), "PCM stream is not paused");
+
+        _start();
+    }
+
+    int position()
+    {
+        BN_ASSERT(playing(), "There's no PCM stream playing");
+
+        switch(data.status)
+        {
+
+        case status_type::PLAYING:
+            return data.frame_states[data.played_frames % buffer_frames].sample_index;
+
+        case status_type::PAUSED:
+            return data.decoder.sample_index;
+
+        default:
+            return data.frame_states[0].sample_index;
+        }
+    }
+
+    int decode_ticks()
+    {
+        return data.decode_ticks;
+    }
+
+    int underruns()
+    {
+        return data.underruns;
+    }
+
+    void update()
+    {
+        if(data.status != status_type::PLAYING)
+        {
+            return;
+        }
+
+        int played_frames = data.played_frames;
+
+        if(data.end_frame >= 0 && played_frames >= data.end_frame)
+        {
+            force_stop();
+            return;
+        }
+
+        if(data.decoded_frames <= played_frames)
+        {
+            // The frame being played has not been decoded in time, so it is skipped:
+            ++data.underruns;
+            data.decoded_frames = played_frames + 1;
+        }
+
+        int decode_frames = min(played_frames + buffer_frames - data.decoded_frames,
+                                BN_CFG_PCM_STREAM_MAX_DECODE_FRAMES);
+        unsigned start_ticks = hw::timer::ticks();
+
+        for(int index = 0; index < decode_frames; ++index)
+        {
+            _decode_frame();
+        }
+
+        data.decode_ticks = int(hw::timer::ticks() - start_ticks);
+    }
+
+    void vblank()
+    {
+        switch(data.status)
+        {
+
+        case status_type::STARTING:
+            // Playback is delayed until the audio mixer uses the stream mixing rate:
+            if(hw::audio::mixing_rate() == data.mixing_rate)
+            {
+                data.played_frames = 0;
+                data.status = status_type::PLAYING;
+                hw::pcm_stream::start(data.buffer);
+            }
+            break;
+
+        case status_type::PLAYING:
+            {
+                int played_frames = data.played_frames + 1;
+                data.played_frames = played_frames;
+
+                if(played_frames % buffer_frames == 0)
+                {
+                    hw::pcm_stream::restart(data.buffer);
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+#else
+    bool playing()
+    {
+        return false;
+    }
+
+    void play(const pcm_stream_item&, bool)
+    {
+        BN_ERROR("PCM streams are not enabled");
+    }
+
+    void stop()
+    {
+        BN_ERROR("PCM streams are not enabled");
+    }
+
+    void force_stop()
+    {
+    }
+
+    bool paused()
+    {
+        return false;
+    }
+
+    void pause()
+    {
+        BN_ERROR("PCM streams are not enabled");
+    }
+
+    void resume()
+    {
+        BN_ERROR("PCM streams are not enabled");
+    }
+
+    int position()
+    {
+        BN_ERROR("PCM streams are not enabled");
+
+        return 0;
+    }
+
+    int decode_ticks()
+    {
+        return 0;
+    }
+
+    int underruns()
+    {
+        return 0;
+    }
+
+    void update()
+    {
+    }
+
+    void vblank()
+    {
+    }
+#endif
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PCM_STREAM_MANAGER_H
+#define BN_PCM_STREAM_MANAGER_H
+
+#include "bn_common.h"
+
+namespace bn
+{
+    class pcm_stream_item;
+}
+
+namespace bn::pcm_stream_manager
+{
+    class decoder_state
+    {
+
+    public:
+        int sample_index = 0;
+        int predictor = 0;
+        int step_index = 0;
+    };
+
+    [[nodiscard]] bool playing();
+
+    void play(const pcm_stream_item& item, bool loop);
+
+    void stop();
+
+    void force_stop();
+
+    [[nodiscard]] bool paused();
+
+    void pause();
+
+    void resume();
+
+    [[nodiscard]] int position();
+
+    [[nodiscard]] int decode_ticks();
+
+    [[nodiscard]] int underruns();
+
+    void update();
+
+    void vblank();
+
+    BN_CODE_IWRAM void _decode_impl(const uint8_t* data, int samples, decoder_state& state, int8_t* output);
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_polygon_rasterizer.h"
+
+#include "bn_utility.h"
+
+namespace bn
+{
+
+void polygon_rasterizer::_add_edge(int x0, int y0, int x1, int y1)
+{
+    // Horizontal edges are covered by their adjacent ones:
+    if(y0 == y1)
+    {
+        return;
+    }
+
+    if(y0 > y1)
+    {
+        swap(x0, x1);
+        swap(y0, y1);
+    }
+
+    // Lines y0 <= y < y1 are sampled, so shared vertices aren't rasterized twice:
+    constexpr int shift = fixed::precision();
+    constexpr int one = 1 << shift;
+    int first_y = (y0 + one - 1) >> shift;
+    int last_y = ((y1 + one - 1) >> shift) - 1;
+    int slope = int((int64_t(x1 - x0) << shift) / (y1 - y0));
+
+    if(first_y < 0)
+    {
+        first_y = 0;
+    }
+
+    if(last_y >= display::height())
+    {
+        last_y = display::height() - 1;
+    }
+
+    if(first_y > last_y)
+    {
+        return;
+    }
+
+    if(first_y < _minimum_y)
+    {
+        _minimum_y = first_y;
+    }
+
+    if(last_y > _maximum_y)
+    {
+        _maximum_y = last_y;
+    }
+
+    int x = x0 + int((int64_t(slope) * ((first_y << shift) - y0)) >> shift) + (one / 2);
+    int16_t* lefts = _lefts;
+    int16_t* rights = _rights;
+
+    for(int y = first_y; y <= last_y; ++y)
+    {
+        int pixel_x = x >> shift;
+        x += slope;
+
+        if(pixel_x < 0)
+        {
+            pixel_x = 0;
+        }
+        else if(pixel_x > display::width())
+        {
+            pixel_x = display::width();
+        }
+
+        if(pixel_x < lefts[y])
+        {
+            lefts[y] = int16_t(pixel_x);
+        }
+
+        if(pixel_x > rights[y])
+        {
+            rights[y] = int16_t(pixel_x);
+        }
+    }
+}
+
+}
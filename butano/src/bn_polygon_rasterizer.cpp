@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_polygon_rasterizer.h"
+
+#include "bn_span.h"
+#include "bn_memory.h"
+
+namespace bn
+{
+
+void polygon_rasterizer::clear()
+{
+    memory::set_half_words(display::width(), display::height(), _lefts);
+    memory::set_half_words(0, display::height(), _rights);
+    _minimum_y = display::height();
+    _maximum_y = -1;
+}
+
+void polygon_rasterizer::add_polygon(const span<const fixed_point>& vertices)
+{
+    int vertices_count = vertices.size();
+    BN_ASSERT(vertices_count >= 3, "Invalid vertices count: ", vertices_count);
+
+    // Screen coordinates with the origin at the top left corner:
+    constexpr int x_offset = fixed(display::width() / 2).data();
+    constexpr int y_offset = fixed(display::height() / 2).data();
+
+    const fixed_point& last_vertex = vertices[vertices_count - 1];
+    int x0 = last_vertex.x().data() + x_offset;
+    int y0 = last_vertex.y().data() + y_offset;
+
+    for(const fixed_point& vertex : vertices)
+    {
+        int x1 = vertex.x().data() + x_offset;
+        int y1 = vertex.y().data() + y_offset;
+        _add_edge(x0, y0, x1, y1);
+        x0 = x1;
+        y0 = y1;
+    }
+}
+
+}
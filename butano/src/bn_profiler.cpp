@@ -6,7 +6,9 @@
 #include "bn_profiler.h"
 
 #if BN_CFG_PROFILER_ENABLED
+    #include "bn_log.h"
     #include "bn_timer.h"
+    #include "bn_memory.h"
     #include "bn_optional.h"
     #include "bn_unordered_map.h"
 
@@ -16,15 +18,40 @@
         {
             static_assert(BN_CFG_PROFILER_MAX_ENTRIES > 0);
             static_assert(bn::power_of_two(BN_CFG_PROFILER_MAX_ENTRIES));
+            static_assert(BN_CFG_PROFILER_MAX_DEPTH > 0);
+            static_assert(BN_CFG_PROFILER_FRAMES_HISTORY >= 0);
+            static_assert(BN_CFG_PROFILER_FRAMES_HISTORY_MAX_ENTRIES > 0);
+
+            constexpr int frames_history = BN_CFG_PROFILER_FRAMES_HISTORY;
+            constexpr int history_max_entries = BN_CFG_PROFILER_FRAMES_HISTORY_MAX_ENTRIES;
+
+            // One more frame is stored for the current one:
+            constexpr int history_slots = frames_history + 1;
+
+            class active_entry
+            {
+
+            public:
+                bn::optional<bn::timer> timer;
+                const char* id;
+                unsigned id_hash;
+            };
 
             class static_data
             {
 
             public:
                 ticks_map ticks_per_entry;
-                bn::optional<bn::timer> current_timer;
-                const char* current_id = nullptr;
-                unsigned current_id_hash;
+                active_entry active_entries[BN_CFG_PROFILER_MAX_DEPTH];
+                int active_entries_count = 0;
+
+                #if BN_CFG_PROFILER_FRAMES_HISTORY
+                    int history_ticks[history_slots][history_max_entries];
+                    const char* history_ids[history_max_entries];
+                    int history_ids_count = 0;
+                    int history_frame_index = 0;
+                    int history_frames_count = 0;
+                #endif
             };
 
             BN_DATA_EWRAM static_data data;
@@ -33,37 +60,152 @@
         void start(const char* id, unsigned id_hash)
         {
             BN_ASSERT(id, "Id is null");
-            BN_ASSERT(! data.current_id, "There's already an active id: ", data.current_id);
+            BN_ASSERT(data.active_entries_count < BN_CFG_PROFILER_MAX_DEPTH, "Too many nested ids: ",
+                      data.active_entries[data.active_entries_count - 1].id);
 
-            data.current_id = id;
-            data.current_id_hash = id_hash;
-            data.current_timer = bn::timer();
+            active_entry& entry = data.active_entries[data.active_entries_count];
+            entry.id = id;
+            entry.id_hash = id_hash;
+            ++data.active_entries_count;
+            entry.timer = bn::timer();
         }
 
         void stop()
         {
-            BN_ASSERT(data.current_id, "There's no active id");
+            BN_ASSERT(data.active_entries_count, "There's no active id");
+
+            --data.active_entries_count;
+
+            const active_entry& entry = data.active_entries[data.active_entries_count];
+            add(entry.id, entry.id_hash, entry.timer->elapsed_ticks());
+        }
+
+        void add(const char* id, unsigned id_hash, int timer_ticks)
+        {
+            BN_ASSERT(id, "Id is null");
 
-            int timer_ticks = data.current_timer->elapsed_ticks();
             auto timer_ticks_64 = int64_t(timer_ticks);
-            ticks& ticks = data.ticks_per_entry(data.current_id_hash, data.current_id);
+            ticks& ticks = data.ticks_per_entry(id_hash, id);
+
+            if(ticks.count)
+            {
+                ticks.min = bn::min(ticks.min, timer_ticks);
+                ticks.max = bn::max(ticks.max, timer_ticks);
+            }
+            else
+            {
+                ticks.parent_id = data.active_entries_count ?
+                            data.active_entries[data.active_entries_count - 1].id : nullptr;
+                ticks.min = timer_ticks;
+                ticks.max = timer_ticks;
+            }
+
             ticks.total += timer_ticks_64;
-            ticks.max = bn::max(ticks.max, timer_ticks);
-            data.current_id = nullptr;
+            ++ticks.count;
+
+            #if BN_CFG_PROFILER_FRAMES_HISTORY
+                if(ticks.history_index < 0 && data.history_ids_count < history_max_entries)
+                {
+                    ticks.history_index = data.history_ids_count;
+                    data.history_ids[data.history_ids_count] = id;
+                    ++data.history_ids_count;
+                }
+
+                if(ticks.history_index >= 0)
+                {
+                    data.history_ticks[data.history_frame_index][ticks.history_index] += timer_ticks;
+                }
+            #endif
         }
 
         const ticks_map& ticks_per_entry()
         {
-            BN_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_ASSERT(! data.active_entries_count, "There's an active id: ",
+                      data.active_entries[data.active_entries_count - 1].id);
 
             return data.ticks_per_entry;
         }
 
         void reset()
         {
-            BN_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_ASSERT(! data.active_entries_count, "There's an active id: ",
+                      data.active_entries[data.active_entries_count - 1].id);
 
             data.ticks_per_entry.clear();
+
+            #if BN_CFG_PROFILER_FRAMES_HISTORY
+                data.history_ids_count = 0;
+                data.history_frame_index = 0;
+                data.history_frames_count = 0;
+                bn::memory::clear(history_max_entries, data.history_ticks[0][0]);
+            #endif
+        }
+
+        void next_frame()
+        {
+            #if BN_CFG_PROFILER_FRAMES_HISTORY
+                int frame_index = data.history_frame_index + 1;
+
+                if(frame_index == history_slots)
+                {
+                    frame_index = 0;
+                }
+
+                data.history_frame_index = frame_index;
+                data.history_frames_count = bn::min(data.history_frames_count + 1, frames_history);
+                bn::memory::clear(history_max_entries, data.history_ticks[frame_index][0]);
+            #endif
+        }
+    }
+
+    namespace bn::profiler
+    {
+        void log_frames()
+        {
+            #if BN_CFG_LOG_ENABLED && BN_CFG_PROFILER_FRAMES_HISTORY
+                using namespace _bn::profiler;
+
+                int ids_count = data.history_ids_count;
+
+                for(int index = 0; index < ids_count; ++index)
+                {
+                    BN_LOG("id,", index, ',', data.history_ids[index]);
+                }
+
+                // The current frame is not logged, since it has not been finished yet:
+                int frames_count = data.history_frames_count;
+                int frame_index = data.history_frame_index - frames_count;
+
+                if(frame_index < 0)
+                {
+                    frame_index += history_slots;
+                }
+
+                char line_buffer[BN_CFG_LOG_MAX_SIZE];
+                istring_base line(line_buffer);
+                ostringstream line_stream(line);
+
+                for(int frame = 0; frame < frames_count; ++frame)
+                {
+                    const int* frame_ticks = data.history_ticks[frame_index];
+                    line.clear();
+                    line_stream << 'f';
+
+                    for(int index = 0; index < ids_count; ++index)
+                    {
+                        line_stream << ',' << frame_ticks[index];
+                    }
+
+                    log(line);
+
+                    ++frame_index;
+
+                    if(frame_index == history_slots)
+                    {
+                        frame_index = 0;
+                    }
+                }
+            #endif
         }
     }
 #endif
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_profiler_overlay.h"
+
+#include "bn_assert.h"
+#include "bn_keypad.h"
+#include "bn_profiler.h"
+
+#if BN_CFG_PROFILER_ENABLED
+    #include "bn_string.h"
+    #include "bn_timers.h"
+    #include "bn_display.h"
+    #include "bn_unordered_map.h"
+    #include "bn_sprite_text_generator.h"
+#endif
+
+namespace bn
+{
+
+#if BN_CFG_PROFILER_ENABLED
+    namespace
+    {
+        constexpr int max_id_size = 12;
+        constexpr int column_width = 36;
+
+        class entry
+        {
+
+        public:
+            const char* id;
+            const char* parent_id;
+            int64_t avg_ticks;
+            int min_ticks;
+            int max_ticks;
+            int depth = 0;
+            bool visited = false;
+        };
+
+        using entries_vector = vector<entry, BN_CFG_PROFILER_MAX_ENTRIES * 2>;
+
+        void _sort_children(const char* parent_id, int depth, entries_vector& entries, entries_vector& output)
+        {
+            // Children with higher max ticks are shown first:
+            while(true)
+            {
+                entry* next_child = nullptr;
+
+                for(entry& child : entries)
+                {
+                    if(! child.visited && child.parent_id == parent_id &&
+                            (! next_child || child.max_ticks > next_child->max_ticks))
+                    {
+                        next_child = &child;
+                    }
+                }
+
+                if(! next_child)
+                {
+                    break;
+                }
+
+                next_child->visited = true;
+                next_child->depth = depth;
+                output.push_back(*next_child);
+
+                if(depth + 1 < BN_CFG_PROFILER_MAX_DEPTH)
+                {
+                    _sort_children(next_child->id, depth + 1, entries, output);
+                }
+            }
+        }
+
+        void _append_percent(int ticks, ostringstream& output)
+        {
+            int per_mille = int((int64_t(ticks) * 1000) / timers::ticks_per_frame());
+            output << per_mille / 10 << '.' << per_mille % 10;
+        }
+    }
+#endif
+
+profiler_overlay::profiler_overlay(sprite_text_generator& text_generator, int refresh_frames) :
+    _text_generator(&text_generator),
+    _refresh_frames(refresh_frames)
+{
+    BN_ASSERT(refresh_frames > 0, "Invalid refresh frames: ", refresh_frames);
+}
+
+void profiler_overlay::set_visible(bool visible)
+{
+    if(visible != _visible)
+    {
+        _visible = visible;
+        _counter = 0;
+        _sprites.clear();
+        BN_PROFILER_RESET();
+    }
+}
+
+void profiler_overlay::update()
+{
+    #if BN_CFG_PROFILER_ENABLED
+        if(keypad::pressed(keypad::key_type::SELECT) && keypad::held(keypad::key_type::L) &&
+                keypad::held(keypad::key_type::R))
+        {
+            set_visible(! _visible);
+        }
+
+        if(_visible)
+        {
+            ++_counter;
+
+            if(_counter >= _refresh_frames)
+            {
+                _counter = 0;
+                _refresh();
+                BN_PROFILER_RESET();
+            }
+        }
+    #endif
+}
+
+void profiler_overlay::_refresh()
+{
+    #if BN_CFG_PROFILER_ENABLED
+        entries_vector entries;
+
+        for(const auto& ticks_per_entry_pair : _bn::profiler::ticks_per_entry())
+        {
+            const _bn::profiler::ticks& ticks = ticks_per_entry_pair.second;
+            entries.push_back(entry{ ticks_per_entry_pair.first, ticks.parent_id, ticks.total / ticks.count,
+                                     ticks.min, ticks.max });
+        }
+
+        entries_vector sorted_entries;
+        _sort_children(nullptr, 0, entries, sorted_entries);
+
+        // Entries whose parent has not been recorded are shown at the end:
+        for(const entry& entry : entries)
+        {
+            if(! entry.visited)
+            {
+                sorted_entries.push_back(entry);
+            }
+        }
+
+        sprite_text_generator& text_generator = *_text_generator;
+        sprite_text_generator::alignment_type old_alignment = text_generator.alignment();
+        int line_height = text_generator.font().item().shape_size().height();
+        int x = 4 - (display::width() / 2);
+        int y = (line_height / 2) - (display::height() / 2);
+        int max_y = display::height() / 2;
+        int max_x = (display::width() / 2) - 4;
+        string<32> text;
+        ostringstream text_stream(text);
+        _sprites.clear();
+
+        for(int index = -1, limit = sorted_entries.size(); index < limit && y < max_y; ++index)
+        {
+            text.clear();
+            text_generator.set_left_alignment();
+
+            if(index < 0)
+            {
+                text_stream << "% FRAME";
+            }
+            else
+            {
+                const entry& entry = sorted_entries[index];
+                text.append(entry.depth, ' ');
+                text_stream << string_view(entry.id).substr(0, max_id_size);
+            }
+
+            bool generated = text_generator.generate_optional(x, y, text, _sprites);
+            text_generator.set_right_alignment();
+
+            for(int column = 0; column < 3 && generated; ++column)
+            {
+                text.clear();
+
+                if(index < 0)
+                {
+                    const char* headers[] = { "MIN", "AVG", "MAX" };
+                    text_stream << headers[column];
+                }
+                else
+                {
+                    const entry& entry = sorted_entries[index];
+                    int ticks[] = { entry.min_ticks, int(entry.avg_ticks), entry.max_ticks };
+                    _append_percent(ticks[column], text_stream);
+                }
+
+                generated = text_generator.generate_optional(max_x - ((2 - column) * column_width), y, text,
+                                                             _sprites);
+            }
+
+            if(! generated)
+            {
+                break;
+            }
+
+            y += line_height;
+        }
+
+        text_generator.set_alignment(old_alignment);
+    #endif
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_random.h"
+
+#include "bn_span.h"
+
+namespace bn
+{
+
+void random::fill(const span<unsigned>& values)
+{
+    // The seed is kept in registers during the whole loop:
+    unsigned x = _x;
+    unsigned y = _y;
+    unsigned z = _z;
+
+    unsigned* values_data = values.data();
+
+    for(int index = 0, limit = values.size(); index < limit; ++index)
+    {
+        x ^= x << 16;
+        x ^= x >> 5;
+        x ^= x << 1;
+
+        unsigned t = x;
+        x = y;
+        y = z;
+        z = t ^ x ^ y;
+        values_data[index] = z;
+    }
+
+    _x = x;
+    _y = y;
+    _z = z;
+}
+
+}
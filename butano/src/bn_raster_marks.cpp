@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_raster_marks.h"
+
+#if BN_CFG_RASTER_MARKS_ENABLED
+    #include "bn_span.h"
+    #include "bn_vector.h"
+    #include "bn_memory.h"
+    #include "bn_utility.h"
+    #include "../hw/include/bn_hw_timer.h"
+    #include "../hw/include/bn_hw_display.h"
+    #include "../hw/include/bn_hw_palettes.h"
+
+    namespace _bn::raster_marks
+    {
+        namespace
+        {
+            static_assert(BN_CFG_RASTER_MARKS_MAX_ITEMS > 0);
+
+            using marks_vector = bn::vector<bn::raster_mark, BN_CFG_RASTER_MARKS_MAX_ITEMS>;
+
+            class static_data
+            {
+
+            public:
+                marks_vector marks_a;
+                marks_vector marks_b;
+                marks_vector* current_marks = &marks_a;
+                marks_vector* last_marks = &marks_b;
+                unsigned frame_start_ticks = 0;
+                uint16_t backdrop_value = 0;
+                uint16_t last_mark_backdrop_value = 0;
+                bool backdrop_enabled = false;
+                bool backdrop_written = false;
+            };
+
+            BN_DATA_EWRAM static_data data;
+        }
+
+        void mark(bn::color color)
+        {
+            marks_vector& current_marks = *data.current_marks;
+
+            if(! current_marks.full())
+            {
+                int ticks = int(bn::hw::timer::ticks() - data.frame_start_ticks);
+                current_marks.push_back(bn::raster_mark(color, bn::hw::display::current_line(), ticks));
+            }
+
+            if(data.backdrop_enabled)
+            {
+                uint16_t* backdrop_register = bn::hw::palettes::bg_transparent_color_register();
+
+                if(! data.backdrop_written)
+                {
+                    data.backdrop_value = *backdrop_register;
+                    data.backdrop_written = true;
+                }
+
+                auto mark_backdrop_value = uint16_t(color.data());
+                data.last_mark_backdrop_value = mark_backdrop_value;
+                *backdrop_register = mark_backdrop_value;
+            }
+        }
+
+        void next_frame()
+        {
+            if(data.backdrop_written)
+            {
+                uint16_t* backdrop_register = bn::hw::palettes::bg_transparent_color_register();
+
+                // If the backdrop color has been committed after the last mark, it must not be restored:
+                if(*backdrop_register == data.last_mark_backdrop_value)
+                {
+                    *backdrop_register = data.backdrop_value;
+                }
+
+                data.backdrop_written = false;
+            }
+
+            bn::swap(data.current_marks, data.last_marks);
+            data.current_marks->clear();
+            data.frame_start_ticks = bn::hw::timer::ticks();
+        }
+    }
+
+    namespace bn::raster_marks
+    {
+        span<const raster_mark> last_frame_marks()
+        {
+            const ivector<raster_mark>& last_marks = *_bn::raster_marks::data.last_marks;
+            return span<const raster_mark>(last_marks.data(), last_marks.size());
+        }
+
+        bool backdrop_enabled()
+        {
+            return _bn::raster_marks::data.backdrop_enabled;
+        }
+
+        void set_backdrop_enabled(bool backdrop_enabled)
+        {
+            _bn::raster_marks::data.backdrop_enabled = backdrop_enabled;
+        }
+    }
+#endif
@@ -1,7 +1,5 @@
 #include "bn_reciprocal_lut.h"
 
-#include "bn_array.h"
-
 namespace bn
 {
 
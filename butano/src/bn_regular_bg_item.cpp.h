@@ -8,6 +8,7 @@
 #include "bn_fixed.h"
 #include "bn_optional.h"
 #include "bn_regular_bg_ptr.h"
+#include "bn_bg_blocks_manager.h"
 #include "bn_regular_bg_map_ptr.h"
 
 namespace bn
@@ -69,4 +70,42 @@ optional<regular_bg_map_ptr> regular_bg_item::create_new_map_optional() const
     return regular_bg_map_ptr::create_new_optional(*this);
 }
 
+regular_bg_map_ptr regular_bg_item::prefetch(int max_bytes_per_frame) const
+{
+    bool batch_started = bg_blocks_manager::batch_started();
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::begin_batch();
+    }
+
+    regular_bg_map_ptr result = regular_bg_map_ptr::create(*this);
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::end_batch(max_bytes_per_frame);
+    }
+
+    return result;
+}
+
+optional<regular_bg_map_ptr> regular_bg_item::prefetch_optional(int max_bytes_per_frame) const
+{
+    bool batch_started = bg_blocks_manager::batch_started();
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::begin_batch();
+    }
+
+    optional<regular_bg_map_ptr> result = regular_bg_map_ptr::create_optional(*this);
+
+    if(! batch_started)
+    {
+        bg_blocks_manager::end_batch(max_bytes_per_frame);
+    }
+
+    return result;
+}
+
 }
@@ -5,6 +5,7 @@
 
 #include "bn_regular_bg_map_ptr.h"
 
+#include "bn_point.h"
 #include "bn_optional.h"
 #include "bn_bg_palette_ptr.h"
 #include "bn_regular_bg_item.h"
@@ -244,6 +245,69 @@ void regular_bg_map_ptr::reload_cells_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+void regular_bg_map_ptr::reload_cells_ref(int first_row, int rows_count)
+{
+    bg_blocks_manager::reload_rows(_handle, first_row, rows_count);
+}
+
+void regular_bg_map_ptr::reload_cells_ref(int first_column, int first_row, int columns_count, int rows_count)
+{
+    bg_blocks_manager::reload_rect(_handle, first_column, first_row, columns_count, rows_count);
+}
+
+void regular_bg_map_ptr::set_cell(int map_x, int map_y, regular_bg_map_cell cell)
+{
+    bg_blocks_manager::set_regular_map_cell(_handle, map_x, map_y, cell);
+}
+
+void regular_bg_map_ptr::set_cell(const point& map_position, regular_bg_map_cell cell)
+{
+    bg_blocks_manager::set_regular_map_cell(_handle, map_position.x(), map_position.y(), cell);
+}
+
+void regular_bg_map_ptr::fill_rect(int first_column, int first_row, int columns_count, int rows_count,
+                                   regular_bg_map_cell cell)
+{
+    bg_blocks_manager::fill_regular_map_rect(_handle, first_column, first_row, columns_count, rows_count, cell);
+}
+
+void regular_bg_map_ptr::copy_rect(const regular_bg_map_item& source_map_item, int source_column, int source_row,
+                                   int columns_count, int rows_count, int destination_column, int destination_row)
+{
+    bg_blocks_manager::copy_regular_map_rect(_handle, source_map_item, source_column, source_row, columns_count,
+                                             rows_count, destination_column, destination_row, 0, 0);
+}
+
+void regular_bg_map_ptr::copy_rect(const regular_bg_map_ptr& source_map, int source_column, int source_row,
+                                   int columns_count, int rows_count, int destination_column, int destination_row)
+{
+    blit_with_offset(source_map, source_column, source_row, columns_count, rows_count, destination_column,
+                     destination_row, 0, 0);
+}
+
+void regular_bg_map_ptr::blit_with_offset(const regular_bg_map_item& source_map_item, int source_column,
+                                          int source_row, int columns_count, int rows_count, int destination_column,
+                                          int destination_row, int tiles_offset, int palette_banks_offset)
+{
+    bg_blocks_manager::copy_regular_map_rect(_handle, source_map_item, source_column, source_row, columns_count,
+                                             rows_count, destination_column, destination_row, tiles_offset,
+                                             palette_banks_offset);
+}
+
+void regular_bg_map_ptr::blit_with_offset(const regular_bg_map_ptr& source_map, int source_column, int source_row,
+                                          int columns_count, int rows_count, int destination_column,
+                                          int destination_row, int tiles_offset, int palette_banks_offset)
+{
+    optional<span<const regular_bg_map_cell>> source_cells_ref = source_map.cells_ref();
+    BN_ASSERT(source_cells_ref, "Source map has no referenced cells");
+
+    regular_bg_map_item source_map_item(*source_cells_ref->data(), source_map.dimensions(),
+                                        source_map.compression());
+    bg_blocks_manager::copy_regular_map_rect(_handle, source_map_item, source_column, source_row, columns_count,
+                                             rows_count, destination_column, destination_row, tiles_offset,
+                                             palette_banks_offset);
+}
+
 const regular_bg_tiles_ptr& regular_bg_map_ptr::tiles() const
 {
     return bg_blocks_manager::regular_map_tiles(_handle);
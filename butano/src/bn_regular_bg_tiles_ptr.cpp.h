@@ -136,6 +136,11 @@ void regular_bg_tiles_ptr::reload_tiles_ref()
     bg_blocks_manager::reload(_handle);
 }
 
+void regular_bg_tiles_ptr::set_tiles_frame(int first_tile, const span<const tile>& tiles_ref)
+{
+    bg_blocks_manager::set_tiles_frame(_handle, first_tile, tiles_ref);
+}
+
 optional<span<tile>> regular_bg_tiles_ptr::vram()
 {
     return bg_blocks_manager::tiles_vram(_handle);
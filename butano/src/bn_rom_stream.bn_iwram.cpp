@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_rom_stream.h"
+
+#include "bn_algorithm.h"
+#include "bn_alignment.h"
+#include "../hw/include/bn_hw_memory.h"
+
+namespace bn
+{
+
+void rom_stream::_refill()
+{
+    int bytes = min(remaining_bytes(), buffer_size());
+    const uint8_t* source = _data + _position;
+    int index = 0;
+
+    if(aligned<4>(source))
+    {
+        // Bursts of sequential word reads:
+        index = (bytes / 4) * 4;
+        hw::memory::copy_words(source, index / 4, _buffer);
+    }
+
+    for(; index < bytes; ++index)
+    {
+        _buffer[index] = source[index];
+    }
+
+    _buffer_position = _position;
+    _buffer_bytes = bytes;
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_rom_stream.h"
+
+#include "bn_memory.h"
+#include "bn_algorithm.h"
+
+namespace bn
+{
+
+void rom_stream::read(int bytes, void* destination)
+{
+    BN_ASSERT(bytes >= 0 && bytes <= remaining_bytes(), "Invalid bytes: ", bytes, " - ", remaining_bytes());
+    BN_ASSERT(destination || ! bytes, "Destination is null");
+
+    auto destination_bytes = static_cast<uint8_t*>(destination);
+    int buffer_index = _position - _buffer_position;
+
+    if(buffer_index >= 0 && buffer_index < _buffer_bytes)
+    {
+        int buffered_bytes = min(bytes, _buffer_bytes - buffer_index);
+        memory::copy(_buffer[buffer_index], buffered_bytes, *destination_bytes);
+        destination_bytes += buffered_bytes;
+        bytes -= buffered_bytes;
+        _position += buffered_bytes;
+    }
+
+    if(bytes)
+    {
+        if(bytes < buffer_size())
+        {
+            _refill();
+            memory::copy(_buffer[0], bytes, *destination_bytes);
+        }
+        else
+        {
+            memory::copy(_data[_position], bytes, *destination_bytes);
+        }
+
+        _position += bytes;
+    }
+}
+
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_rtc.h"
+
+#include "bn_gpio_manager.h"
+
+namespace bn::rtc
+{
+
+bool active()
+{
+    return gpio_manager::rtc_active();
+}
+
+optional<rtc_time> time()
+{
+    return gpio_manager::current_rtc_time();
+}
+
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_save_store.h"
+
+#include "bn_crc32.h"
+#include "bn_optional.h"
+#include "../hw/include/bn_hw_sram.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr uint32_t magic = 0x53534E42; // "BNSS"
+
+    class header
+    {
+
+    public:
+        uint32_t magic;
+        uint32_t sequence;
+        uint32_t size;
+        uint32_t crc;
+    };
+
+    static_assert(sizeof(header) == 16);
+}
+
+isave_store::isave_store(int record_size, int offset) :
+    _record_size(record_size),
+    _offset(offset)
+{
+    BN_ASSERT(record_size > 0, "Invalid record size: ", record_size);
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(offset + sram_size(record_size) <= sram::size(),
+              "Record size and offset are too high: ", record_size, " - ", offset);
+
+    for(int slot = 0; slot < 2; ++slot)
+    {
+        unsigned sequence;
+        unsigned crc;
+
+        // Sequence numbers can wrap around, so they are compared with a signed difference:
+        if(_read_header(slot, sequence, crc) && (_active_slot < 0 || int(sequence - _sequence) > 0))
+        {
+            _sequence = sequence;
+            _active_slot = slot;
+        }
+    }
+}
+
+optional<int> isave_store::active_slot() const
+{
+    optional<int> result;
+
+    if(_active_slot >= 0)
+    {
+        result = _active_slot;
+    }
+
+    return result;
+}
+
+void isave_store::clear()
+{
+    header empty_header = {};
+
+    for(int slot = 0; slot < 2; ++slot)
+    {
+        hw::sram::write(&empty_header, int(sizeof(header)), _slot_offset(slot));
+    }
+
+    _sequence = 0;
+    _active_slot = -1;
+}
+
+bool isave_store::_load(void* destination)
+{
+    if(_active_slot < 0)
+    {
+        return false;
+    }
+
+    if(_load_slot(_active_slot, destination))
+    {
+        return true;
+    }
+
+    // The active slot is corrupted, so the other one is recovered if it is valid:
+    int other_slot = 1 - _active_slot;
+    unsigned other_sequence;
+    unsigned other_crc;
+
+    if(_read_header(other_slot, other_sequence, other_crc) && _load_slot(other_slot, destination))
+    {
+        _sequence = other_sequence;
+        _active_slot = other_slot;
+        return true;
+    }
+
+    return false;
+}
+
+void isave_store::_save(const void* source)
+{
+    int slot = _active_slot < 0 ? 0 : 1 - _active_slot;
+    int slot_offset = _slot_offset(slot);
+    unsigned sequence = _sequence + 1;
+    header new_header = { magic, sequence, uint32_t(_record_size), crc32(source, _record_size) };
+
+    // The header is written after the record, so the slot is valid only if the record has been fully written:
+    hw::sram::write(source, _record_size, slot_offset + _header_size);
+    hw::sram::write(&new_header, int(sizeof(header)), slot_offset);
+
+    _sequence = sequence;
+    _active_slot = slot;
+}
+
+bool isave_store::_read_header(int slot, unsigned& sequence, unsigned& crc) const
+{
+    header slot_header;
+    hw::sram::read(&slot_header, int(sizeof(header)), _slot_offset(slot));
+
+    if(slot_header.magic != magic || slot_header.size != uint32_t(_record_size))
+    {
+        return false;
+    }
+
+    sequence = slot_header.sequence;
+    crc = slot_header.crc;
+    return true;
+}
+
+bool isave_store::_load_slot(int slot, void* destination) const
+{
+    unsigned sequence;
+    unsigned crc;
+
+    if(! _read_header(slot, sequence, crc))
+    {
+        return false;
+    }
+
+    hw::sram::read(destination, _record_size, _slot_offset(slot) + _header_size);
+    return crc32(destination, _record_size) == crc;
+}
+
+}
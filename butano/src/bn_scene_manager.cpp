@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_scene_manager.h"
+
+#include "bn_sprite_tiles_item.h"
+
+namespace bn
+{
+
+namespace
+{
+    template<typename ResourcesVector, typename Item, typename CreateFunction>
+    void _load_items(const span<const Item>& items, const CreateFunction& create_function, ResourcesVector& resources)
+    {
+        constexpr int max_items = BN_CFG_SCENE_MANAGER_MAX_ITEMS;
+
+        int items_count = items.size();
+        BN_ASSERT(items_count <= max_items, "Too many items: ", items_count, " - ", max_items);
+
+        ResourcesVector next_resources;
+        bool kept_items[max_items] = {};
+        bool kept_resources[max_items] = {};
+
+        // Shared resources are moved to the next scene ones:
+        for(int item_index = 0; item_index < items_count; ++item_index)
+        {
+            const Item& item = items[item_index];
+
+            for(int resources_index = 0, limit = resources.size(); resources_index < limit; ++resources_index)
+            {
+                if(! kept_resources[resources_index] && resources[resources_index].item == item)
+                {
+                    next_resources.push_back(move(resources[resources_index]));
+                    kept_items[item_index] = true;
+                    kept_resources[resources_index] = true;
+                    break;
+                }
+            }
+        }
+
+        // Resources used only by the current scene are released before creating the next scene ones:
+        resources.clear();
+
+        for(int item_index = 0; item_index < items_count; ++item_index)
+        {
+            if(! kept_items[item_index])
+            {
+                next_resources.push_back(create_function(items[item_index]));
+            }
+        }
+
+        resources.swap(next_resources);
+    }
+}
+
+void scene_manager::load(const scene_resources& resources, int max_bg_bytes_per_frame)
+{
+    BN_ASSERT(max_bg_bytes_per_frame > 0, "Invalid max BG bytes per frame: ", max_bg_bytes_per_frame);
+    BN_ASSERT(resources.fits(), "Scene resources don't fit: ",
+              resources.sprite_tiles_count(), " - ", resources.bg_blocks_count(), " - ",
+              resources.sprite_palettes_count(), " - ", resources.bg_palettes_count());
+
+    _load_items(resources.sprite_items(), [](const sprite_item& item)
+    {
+        return sprite_item_resources{ item, item.tiles_item().create_tiles(), item.palette_item().create_palette() };
+    }, _sprite_items);
+
+    _load_items(resources.regular_bg_items(), [max_bg_bytes_per_frame](const regular_bg_item& item)
+    {
+        return regular_bg_item_resources{ item, item.prefetch(max_bg_bytes_per_frame) };
+    }, _regular_bg_items);
+
+    _load_items(resources.sprite_palette_items(), [](const sprite_palette_item& item)
+    {
+        return sprite_palette_item_resources{ item, item.create_palette() };
+    }, _sprite_palette_items);
+
+    _load_items(resources.bg_palette_items(), [](const bg_palette_item& item)
+    {
+        return bg_palette_item_resources{ item, item.create_palette() };
+    }, _bg_palette_items);
+}
+
+void scene_manager::clear()
+{
+    _sprite_items.clear();
+    _regular_bg_items.clear();
+    _sprite_palette_items.clear();
+    _bg_palette_items.clear();
+}
+
+}
@@ -10,12 +10,19 @@
 #include "bn_config_sprites.h"
 #include "bn_sprites_manager_item.h"
 
+#if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+    #include "bn_bit.h"
+    #include "bn_sprites.h"
+#endif
+
 namespace bn::sorted_sprites
 {
     class layer : public intrusive_list_node_type
     {
 
     public:
+        layer() = default;
+
         explicit layer(sort_key sort_key) :
             _sort_key(sort_key)
         {
@@ -26,6 +33,11 @@ namespace bn::sorted_sprites
             return _sort_key;
         }
 
+        void set_layer_sort_key(sort_key sort_key)
+        {
+            _sort_key = sort_key;
+        }
+
         [[nodiscard]] const intrusive_list<sprites_manager_item>& items() const
         {
             return _items;
@@ -49,6 +61,26 @@ namespace bn::sorted_sprites
     {
 
     public:
+        #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+            static constexpr int min_z_order = BN_CFG_SPRITES_BUCKET_SORT_MIN_Z_ORDER;
+            static constexpr int z_orders = BN_CFG_SPRITES_BUCKET_SORT_Z_ORDERS;
+            static constexpr int buckets_count = (sprites::max_bg_priority() + 1) * z_orders;
+            static constexpr int masks_count = (buckets_count + 31) / 32;
+
+            static_assert(z_orders > 0);
+            static_assert(buckets_count <= numeric_limits<int16_t>::max());
+            static_assert(min_z_order >= sprites::min_z_order());
+            static_assert(min_z_order + z_orders - 1 <= sprites::max_z_order());
+
+            sorter()
+            {
+                for(int index = 0; index < buckets_count; ++index)
+                {
+                    _layers[index].set_layer_sort_key(sort_key(index / z_orders, (index % z_orders) + min_z_order));
+                }
+            }
+        #endif
+
         [[nodiscard]] layers_type& layers()
         {
             return _layer_ptrs;
@@ -56,36 +88,109 @@ namespace bn::sorted_sprites
 
         void insert(sprites_manager_item& item)
         {
-            layers_type& layer_ptrs = _layer_ptrs;
-            sort_key item_sort_key = item.sprite_sort_key;
-            layers_type::iterator layers_end = layer_ptrs.end();
-            layers_type::iterator layers_it = lower_bound(layer_ptrs.begin(), layers_end, item_sort_key,
-                    [](const layer& layer, sort_key sort_key) {
-                        return layer.layer_sort_key() < sort_key;
-                    });
-
-            if(layers_it == layers_end)
-            {
-                BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
-
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_end, pool_layer);
-            }
-            else if(item_sort_key != layers_it->layer_sort_key())
-            {
-                BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
-
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_it, pool_layer);
-            }
+            insert(item, find_layer(item.sprite_sort_key));
+        }
 
-            layer& layer_ref = *layers_it;
+        void insert(sprites_manager_item& item, layer& layer_ref)
+        {
             layer_ref.items().push_front(item);
 
-            int diff = &layer_ref - reinterpret_cast<layer*>(&layer_ptrs);
+            int diff = &layer_ref - _layers_base();
             item.sort_layer_ptr_diff = int16_t(diff);
         }
 
+        [[nodiscard]] layer& find_layer(sort_key item_sort_key)
+        {
+            #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+                int z_order_index = item_sort_key.z_order() - min_z_order;
+                BN_ASSERT(z_order_index >= 0 && z_order_index < z_orders,
+                          "Z order out of sprite sort buckets range: ", item_sort_key.z_order());
+
+                int index = (item_sort_key.priority() * z_orders) + z_order_index;
+                layer& result = _layers[index];
+                unsigned& mask = _masks[index / 32];
+                unsigned bit = 1u << (index % 32);
+
+                if(! (mask & bit))
+                {
+                    mask |= bit;
+
+                    if(int next_index = _next_used_bucket(index + 1); next_index == -1)
+                    {
+                        _layer_ptrs.push_back(result);
+                    }
+                    else
+                    {
+                        _layer_ptrs.insert(_layers[next_index], result);
+                    }
+                }
+
+                return result;
+            #else
+                layers_type& layer_ptrs = _layer_ptrs;
+                layers_type::iterator layers_end = layer_ptrs.end();
+                layers_type::iterator layers_it = lower_bound(layer_ptrs.begin(), layers_end, item_sort_key,
+                        [](const layer& layer, sort_key sort_key) {
+                            return layer.layer_sort_key() < sort_key;
+                        });
+
+                if(layers_it == layers_end)
+                {
+                    BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+                    layer& pool_layer = _layer_pool.create(item_sort_key);
+                    layers_it = layer_ptrs.insert(layers_end, pool_layer);
+                }
+                else if(item_sort_key != layers_it->layer_sort_key())
+                {
+                    BN_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+                    layer& pool_layer = _layer_pool.create(item_sort_key);
+                    layers_it = layer_ptrs.insert(layers_it, pool_layer);
+                }
+
+                return *layers_it;
+            #endif
+        }
+
+        [[nodiscard]] layer* find_existing_layer(sort_key item_sort_key)
+        {
+            #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+                int z_order_index = item_sort_key.z_order() - min_z_order;
+
+                if(z_order_index < 0 || z_order_index >= z_orders)
+                {
+                    return nullptr;
+                }
+
+                int index = (item_sort_key.priority() * z_orders) + z_order_index;
+
+                if(! (_masks[index / 32] & (1u << (index % 32))))
+                {
+                    return nullptr;
+                }
+
+                return &_layers[index];
+            #else
+                for(layer& layer : _layer_ptrs)
+                {
+                    sort_key layer_sort_key = layer.layer_sort_key();
+
+                    if(layer_sort_key == item_sort_key)
+                    {
+                        return &layer;
+                    }
+
+                    if(item_sort_key < layer_sort_key)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                return nullptr;
+            #endif
+        }
+
         void erase(sprites_manager_item& item)
         {
             layer* layer = _layer_ptr(item.sort_layer_ptr_diff);
@@ -95,7 +200,13 @@ namespace bn::sorted_sprites
             if(layer_items.empty())
             {
                 _layer_ptrs.erase(*layer);
-                _layer_pool.destroy(*layer);
+
+                #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+                    int index = item.sort_layer_ptr_diff;
+                    _masks[index / 32] &= ~(1u << (index % 32));
+                #else
+                    _layer_pool.destroy(*layer);
+                #endif
             }
         }
 
@@ -130,13 +241,55 @@ namespace bn::sorted_sprites
         }
 
     private:
-        pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
+        #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+            layer _layers[buckets_count];
+            unsigned _masks[masks_count] = {};
+        #else
+            pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
+        #endif
+
         layers_type _layer_ptrs;
 
+        [[nodiscard]] layer* _layers_base()
+        {
+            #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+                return _layers;
+            #else
+                return reinterpret_cast<layer*>(&_layer_ptrs);
+            #endif
+        }
+
         [[nodiscard]] layer* _layer_ptr(int diff)
         {
-            return reinterpret_cast<layer*>(&_layer_ptrs) + diff;
+            return _layers_base() + diff;
         }
+
+        #if BN_CFG_SPRITES_BUCKET_SORT_ENABLED
+            [[nodiscard]] int _next_used_bucket(int index) const
+            {
+                if(index == buckets_count)
+                {
+                    return -1;
+                }
+
+                int mask_index = index / 32;
+                unsigned mask = _masks[mask_index] & (0xFFFFFFFFu << (index % 32));
+
+                while(! mask)
+                {
+                    ++mask_index;
+
+                    if(mask_index == masks_count)
+                    {
+                        return -1;
+                    }
+
+                    mask = _masks[mask_index];
+                }
+
+                return (mask_index * 32) + countr_zero(mask);
+            }
+        #endif
     };
 }
 
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_split_screen.h"
+
+#include "bn_span.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] point _calculate_view(const fixed_point& position, const optional<camera_ptr>& camera)
+    {
+        int x = position.x().right_shift_integer();
+        int y = position.y().right_shift_integer();
+
+        if(const camera_ptr* camera_ptr = camera.get())
+        {
+            const fixed_point& camera_position = camera_ptr->position();
+            x -= camera_position.x().right_shift_integer();
+            y -= camera_position.y().right_shift_integer();
+        }
+
+        return point(x, y);
+    }
+}
+
+void isplit_screen::add_region(int top_line, const fixed_point& position)
+{
+    BN_ASSERT(top_line > 0 && top_line < display::height(), "Invalid top line: ", top_line);
+    BN_ASSERT(_regions.empty() || top_line > _regions.back().top_line,
+              "Top line is not greater than the last region one: ", top_line, " - ", _regions.back().top_line);
+    BN_ASSERT(! _regions.full(), "No more regions available");
+
+    _regions.push_back(region_type{ position, nullopt, nullopt, point(), top_line });
+    _update_positions = true;
+}
+
+void isplit_screen::set_region_attributes(int index, const regular_bg_attributes& attributes)
+{
+    _region(index).attributes = attributes;
+    _update_attributes = true;
+}
+
+void isplit_screen::remove_region_attributes(int index)
+{
+    optional<regular_bg_attributes>& region_attributes = _region(index).attributes;
+
+    if(region_attributes)
+    {
+        region_attributes.reset();
+        _update_attributes = true;
+    }
+}
+
+void isplit_screen::update()
+{
+    point view = _calculate_view(_bg.position(), _bg.camera());
+    bool update_positions = _update_positions || view != _view;
+
+    for(region_type& region : _regions)
+    {
+        point region_view = _calculate_view(region.position, region.camera);
+
+        if(region_view != region.view)
+        {
+            region.view = region_view;
+            update_positions = true;
+        }
+    }
+
+    if(update_positions)
+    {
+        _view = view;
+        _update_positions = false;
+        _commit_positions();
+    }
+
+    if(_update_attributes)
+    {
+        _update_attributes = false;
+        _commit_attributes();
+    }
+}
+
+isplit_screen::isplit_screen(const regular_bg_ptr& bg, ivector<region_type>& regions) :
+    _bg(bg),
+    _regions(regions),
+    _horizontal_deltas(),
+    _vertical_deltas(),
+    _horizontal_hbe(regular_bg_position_hbe_ptr::create_horizontal(bg, _horizontal_deltas)),
+    _vertical_hbe(regular_bg_position_hbe_ptr::create_vertical(bg, _vertical_deltas))
+{
+}
+
+const isplit_screen::region_type& isplit_screen::_region(int index) const
+{
+    BN_ASSERT(index >= 0 && index < _regions.size(), "Invalid index: ", index, " - ", _regions.size());
+
+    return _regions[index];
+}
+
+isplit_screen::region_type& isplit_screen::_region(int index)
+{
+    BN_ASSERT(index >= 0 && index < _regions.size(), "Invalid index: ", index, " - ", _regions.size());
+
+    return _regions[index];
+}
+
+void isplit_screen::_commit_positions()
+{
+    fixed* horizontal_deltas = _horizontal_deltas.data();
+    fixed* vertical_deltas = _vertical_deltas.data();
+    int line = _regions.empty() ? display::height() : _regions.front().top_line;
+
+    // Lines above the first region show the regular background as usual:
+    for(int index = 0; index < line; ++index)
+    {
+        horizontal_deltas[index] = 0;
+        vertical_deltas[index] = 0;
+    }
+
+    for(int region_index = 0, regions_count = _regions.size(); region_index < regions_count; ++region_index)
+    {
+        const region_type& region = _regions[region_index];
+        int last_line = region_index + 1 < regions_count ? _regions[region_index + 1].top_line : display::height();
+
+        // The hardware position of the regular background is decreased when its view increases:
+        fixed horizontal_delta = _view.x() - region.view.x();
+        fixed vertical_delta = _view.y() - region.view.y();
+
+        for(; line < last_line; ++line)
+        {
+            horizontal_deltas[line] = horizontal_delta;
+            vertical_deltas[line] = vertical_delta;
+        }
+    }
+
+    _horizontal_hbe.reload_deltas_ref();
+    _vertical_hbe.reload_deltas_ref();
+}
+
+void isplit_screen::_commit_attributes()
+{
+    bool attributes_found = false;
+
+    for(const region_type& region : _regions)
+    {
+        if(region.attributes)
+        {
+            attributes_found = true;
+            break;
+        }
+    }
+
+    if(! attributes_found)
+    {
+        _attributes_hbe.reset();
+        _attributes.clear();
+        return;
+    }
+
+    regular_bg_attributes bg_attributes = _bg.attributes();
+    int line = _regions.front().top_line;
+    _attributes.clear();
+
+    for(int index = 0; index < line; ++index)
+    {
+        _attributes.push_back(bg_attributes);
+    }
+
+    for(int region_index = 0, regions_count = _regions.size(); region_index < regions_count; ++region_index)
+    {
+        const region_type& region = _regions[region_index];
+        int last_line = region_index + 1 < regions_count ? _regions[region_index + 1].top_line : display::height();
+        const regular_bg_attributes& attributes = region.attributes ? *region.attributes : bg_attributes;
+
+        for(; line < last_line; ++line)
+        {
+            _attributes.push_back(attributes);
+        }
+    }
+
+    if(regular_bg_attributes_hbe_ptr* attributes_hbe = _attributes_hbe.get())
+    {
+        attributes_hbe->reload_attributes_ref();
+    }
+    else
+    {
+        span<const regular_bg_attributes> attributes_ref(_attributes.data(), _attributes.size());
+        _attributes_hbe = regular_bg_attributes_hbe_ptr::create(_bg, attributes_ref);
+    }
+}
+
+}
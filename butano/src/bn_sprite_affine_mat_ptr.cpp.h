@@ -48,6 +48,11 @@ optional<sprite_affine_mat_ptr> sprite_affine_mat_ptr::create_optional(const aff
     return result;
 }
 
+sprite_affine_mat_ptr sprite_affine_mat_ptr::create_shared(const affine_mat_attributes& attributes)
+{
+    return sprite_affine_mat_ptr(sprite_affine_mats_manager::create_shared(attributes));
+}
+
 sprite_affine_mat_ptr::sprite_affine_mat_ptr(const sprite_affine_mat_ptr& other) :
     sprite_affine_mat_ptr(other._id)
 {
@@ -180,6 +185,11 @@ bool sprite_affine_mat_ptr::flipped_identity() const
     return sprite_affine_mats_manager::flipped_identity(_id);
 }
 
+bool sprite_affine_mat_ptr::shared() const
+{
+    return sprite_affine_mats_manager::shared(_id);
+}
+
 void sprite_affine_mat_ptr::_destroy()
 {
     sprite_affine_mats_manager::decrease_usages(_id);
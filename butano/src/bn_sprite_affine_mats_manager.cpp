@@ -6,6 +6,8 @@
 #include "bn_sprite_affine_mats_manager.h"
 
 #include "bn_vector.h"
+#include "bn_config_sprites.h"
+#include "bn_occupancy_cells.h"
 #include "bn_sprites_manager_item.h"
 #include "../hw/include/bn_hw_sprite_affine_mats.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
@@ -21,8 +23,88 @@ namespace
     constexpr int max_items = hw::sprite_affine_mats::count();
     constexpr int affine_mat_id_multiplier = hw::sprites::count() / hw::sprite_affine_mats::count();
 
+    #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+        // Affine mats stored in the handles rewritten by the sprites multiplexer can't be used:
+        constexpr int max_usable_items =
+                (hw::sprites::count() - BN_CFG_SPRITES_MULTIPLEXER_HANDLES) / affine_mat_id_multiplier;
+    #else
+        constexpr int max_usable_items = max_items;
+    #endif
+
     static_assert(max_items <= numeric_limits<int8_t>::max());
 
+    // If double size was enabled, it is kept until the matrix is a bit inside of the regular size bounds,
+    // so matrices near the threshold don't toggle double size back and forth:
+    constexpr int double_size_hysteresis = 1;
+
+    [[nodiscard]] bool _double_size(const affine_mat_attributes& attributes, bool old_double_size)
+    {
+        if(attributes.flipped_identity())
+        {
+            return false;
+        }
+
+        int pa = attributes.pa_register_value();
+        int pb = attributes.pb_register_value();
+        int pc = attributes.pc_register_value();
+        int pd = attributes.pd_register_value();
+        constexpr int half_width = 32;
+        constexpr int half_height = 32;
+        int half_width_limit = half_width;
+        int half_height_limit = half_height;
+        int min_scale = 256;
+
+        if(old_double_size)
+        {
+            half_width_limit -= double_size_hysteresis;
+            half_height_limit -= double_size_hysteresis;
+            min_scale = (256 * half_width) / half_width_limit;
+        }
+
+        if(pb == 0 && pc == 0)
+        {
+            return bn::abs(pa) < min_scale || bn::abs(pd) < min_scale;
+        }
+
+        if(pa == 0 && pd == 0)
+        {
+            return bn::abs(pb) < min_scale || bn::abs(pc) < min_scale;
+        }
+
+        int divisor = (pa * pd) - (pb * pc);
+
+        if(! divisor)
+        {
+            return true;
+        }
+
+        int ix1 = ((-256 * half_height * pb) - (256 * half_width * pd) + (256 * pb)) / divisor;
+
+        if(ix1 < -half_width_limit || ix1 >= half_width_limit)
+        {
+            return true;
+        }
+
+        int iy1 = (256 * ((half_height * pa) + (half_width * pc) - pa)) / divisor;
+
+        if(iy1 < -half_height_limit || iy1 >= half_height_limit)
+        {
+            return true;
+        }
+
+        int ix2 = ((-256 * half_height * pb) + (256 * half_width * pd) + (256 * pb) - (256 * pd)) / divisor;
+
+        if(ix2 < -half_width_limit || ix2 >= half_width_limit)
+        {
+            return true;
+        }
+
+        int iy2 = (256 * ((half_height * pa) - (half_width * pc) - pa + pc)) / divisor;
+
+        return iy2 < -half_height_limit || iy2 >= half_height_limit;
+    }
+
+
     class item_type
     {
 
@@ -32,6 +114,8 @@ namespace
         unsigned usages;
         bool flipped_identity;
         bool remove_if_not_needed;
+        bool shared;
+        bool double_size;
 
         void init()
         {
@@ -39,6 +123,8 @@ namespace
             usages = 1;
             flipped_identity = true;
             remove_if_not_needed = false;
+            shared = false;
+            double_size = false;
         }
 
         void init(const affine_mat_attributes& new_attributes)
@@ -47,6 +133,8 @@ namespace
             usages = 1;
             flipped_identity = attributes.flipped_identity();
             remove_if_not_needed = false;
+            shared = false;
+            double_size = _double_size(attributes, false);
         }
     };
 
@@ -128,9 +216,12 @@ namespace
         hw::sprite_affine_mats::setup(item.attributes, data.handles_ptr[index]);
         _update_indexes_to_commit(index);
 
-        if(! item.attached_nodes.empty())
+        // Double size is decided once per matrix update, and attached sprites are notified only if it changes:
+        bool double_size = _double_size(item.attributes, item.double_size);
+
+        if(double_size != item.double_size)
         {
-            bool double_size = sprite_double_size(index);
+            item.double_size = double_size;
 
             for(sprite_affine_mat_attach_node_type& attached_node : item.attached_nodes)
             {
@@ -170,13 +261,28 @@ namespace
 
         return -1;
     }
+
+    [[nodiscard]] int _find_shared_item_index(const affine_mat_attributes& attributes)
+    {
+        for(int index = 0; index < max_items; ++index)
+        {
+            const item_type& item = data.items[index];
+
+            if(item.usages && item.shared && item.attributes == attributes)
+            {
+                return index;
+            }
+        }
+
+        return -1;
+    }
 }
 
 void init(void* handles)
 {
     data.handles_ptr = static_cast<hw::sprite_affine_mats::handle*>(handles);
 
-    for(int index = max_items - 1; index >= 0; --index)
+    for(int index = max_usable_items - 1; index >= 0; --index)
     {
         data.free_item_indexes.push_back(int8_t(index));
     }
@@ -184,7 +290,7 @@ void init(void* handles)
 
 int used_count()
 {
-    return data.free_item_indexes.available();
+    return max_usable_items - data.free_item_indexes.size();
 }
 
 int available_count()
@@ -192,6 +298,26 @@ int available_count()
     return data.free_item_indexes.size();
 }
 
+void fill_occupancy_cells(span<occupancy_cell_type> cells)
+{
+    bool free_items[max_items] = {};
+
+    for(int free_item_index : data.free_item_indexes)
+    {
+        free_items[free_item_index] = true;
+    }
+
+    for(int index = 0; index < max_usable_items; ++index)
+    {
+        if(! free_items[index])
+        {
+            occupancy_cell_type type = data.items[index].remove_if_not_needed ?
+                        occupancy_cell_type::TO_REMOVE : occupancy_cell_type::SPRITE_AFFINE_MAT;
+            set_occupancy_cells(index, 1, max_items, type, cells);
+        }
+    }
+}
+
 int create()
 {
     int id = create_optional();
@@ -238,6 +364,36 @@ int create_optional(const affine_mat_attributes& attributes)
     return item_index;
 }
 
+int create_shared(const affine_mat_attributes& attributes)
+{
+    int item_index = _find_shared_item_index(attributes);
+
+    if(item_index == -1)
+    {
+        item_index = create(attributes);
+        data.items[item_index].shared = true;
+    }
+    else
+    {
+        increase_usages(item_index);
+    }
+
+    return item_index;
+}
+
+bool update_shared(int id, const affine_mat_attributes& attributes)
+{
+    const item_type& item = data.items[id];
+
+    if(item.usages > 1 || _find_shared_item_index(attributes) != -1)
+    {
+        return false;
+    }
+
+    set_attributes(id, attributes);
+    return true;
+}
+
 void increase_usages(int id)
 {
     item_type& item = data.items[id];
@@ -514,64 +670,16 @@ bool flipped_identity(int id)
     return item.flipped_identity;
 }
 
-bool sprite_double_size(int id)
+bool shared(int id)
 {
     const item_type& item = data.items[id];
+    return item.shared;
+}
 
-    if(item.flipped_identity)
-    {
-        return false;
-    }
-
-    const affine_mat_attributes& item_attributes = item.attributes;
-    int pa = item_attributes.pa_register_value();
-    int pb = item_attributes.pb_register_value();
-    int pc = item_attributes.pc_register_value();
-    int pd = item_attributes.pd_register_value();
-
-    if(pb == 0 && pc == 0)
-    {
-        return bn::abs(pa) < 256 || bn::abs(pd) < 256;
-    }
-
-    if(pa == 0 && pd == 0)
-    {
-        return bn::abs(pb) < 256 || bn::abs(pc) < 256;
-    }
-
-    int divisor = (pa * pd) - (pb * pc);
-
-    if(! divisor)
-    {
-        return true;
-    }
-
-    constexpr int half_width = 32;
-    constexpr int half_height = 32;
-    int ix1 = ((-256 * half_height * pb) - (256 * half_width * pd) + (256 * pb)) / divisor;
-
-    if(ix1 < -half_width || ix1 >= half_width)
-    {
-        return true;
-    }
-
-    int iy1 = (256 * ((half_height * pa) + (half_width * pc) - pa)) / divisor;
-
-    if(iy1 < -half_height || iy1 >= half_height)
-    {
-        return true;
-    }
-
-    int ix2 = ((-256 * half_height * pb) + (256 * half_width * pd) + (256 * pb) - (256 * pd)) / divisor;
-
-    if(ix2 < -half_width || ix2 >= half_width)
-    {
-        return true;
-    }
-
-    int iy2 = (256 * ((half_height * pa) - (half_width * pc) - pa + pc)) / divisor;
-
-    return iy2 < -half_height || iy2 >= half_height;
+bool sprite_double_size(int id)
+{
+    const item_type& item = data.items[id];
+    return item.double_size;
 }
 
 void reserve_sprite_handles([[maybe_unused]] int sprite_handles_count)
@@ -645,6 +753,11 @@ void update()
     }
 }
 
+bool must_commit()
+{
+    return data.first_index_to_commit < max_items;
+}
+
 optional<commit_data> retrieve_commit_data()
 {
     optional<commit_data> result;
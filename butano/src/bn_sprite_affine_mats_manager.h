@@ -6,6 +6,7 @@
 #ifndef BN_SPRITES_AFFINE_MATS_MANAGER_H
 #define BN_SPRITES_AFFINE_MATS_MANAGER_H
 
+#include "bn_span_fwd.h"
 #include "bn_fixed_fwd.h"
 #include "bn_optional_fwd.h"
 #include "bn_intrusive_list.h"
@@ -13,6 +14,7 @@
 namespace bn
 {
     class affine_mat_attributes;
+    enum class occupancy_cell_type : uint8_t;
 
     using sprite_affine_mat_attach_node_type = intrusive_list_node_type;
 }
@@ -34,6 +36,8 @@ namespace bn::sprite_affine_mats_manager
 
     [[nodiscard]] int available_count();
 
+    void fill_occupancy_cells(span<occupancy_cell_type> cells);
+
     [[nodiscard]] int create();
 
     [[nodiscard]] int create(const affine_mat_attributes& attributes);
@@ -42,6 +46,10 @@ namespace bn::sprite_affine_mats_manager
 
     [[nodiscard]] int create_optional(const affine_mat_attributes& attributes);
 
+    [[nodiscard]] int create_shared(const affine_mat_attributes& attributes);
+
+    [[nodiscard]] bool update_shared(int id, const affine_mat_attributes& attributes);
+
     void increase_usages(int id);
 
     void decrease_usages(int id);
@@ -94,6 +102,8 @@ namespace bn::sprite_affine_mats_manager
 
     [[nodiscard]] bool flipped_identity(int id);
 
+    [[nodiscard]] bool shared(int id);
+
     [[nodiscard]] bool sprite_double_size(int id);
 
     void reserve_sprite_handles(int sprite_handles_count);
@@ -102,6 +112,8 @@ namespace bn::sprite_affine_mats_manager
 
     void update();
 
+    [[nodiscard]] bool must_commit();
+
     [[nodiscard]] optional<commit_data> retrieve_commit_data();
 }
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_CAMERA_CELLS_H
+#define BN_SPRITE_CAMERA_CELLS_H
+
+#include "bn_bit.h"
+#include "bn_power_of_two.h"
+#include "bn_config_cameras.h"
+#include "bn_config_sprites.h"
+#include "bn_cameras_manager.h"
+#include "bn_sprites_manager_item.h"
+
+namespace bn::sprite_camera_cells
+{
+    constexpr int cell_size = BN_CFG_SPRITES_CAMERA_CELL_SIZE;
+    constexpr int grid_size = BN_CFG_SPRITES_CAMERA_GRID_SIZE;
+    constexpr int cell_shift = countr_zero(unsigned(cell_size));
+    constexpr int max_cameras = BN_CFG_CAMERA_MAX_ITEMS;
+
+    static_assert(power_of_two(cell_size));
+    static_assert(power_of_two(grid_size));
+
+
+    class grid
+    {
+
+    public:
+        [[nodiscard]] static int cell_index(const fixed_point& position)
+        {
+            int column = (position.x().right_shift_integer() >> cell_shift) & (grid_size - 1);
+            int row = (position.y().right_shift_integer() >> cell_shift) & (grid_size - 1);
+            return (row * grid_size) + column;
+        }
+
+        void insert(sprites_manager_item& item)
+        {
+            int camera_id = item.camera->id();
+            _cells[cell_index(item.position)].push_back(item.camera_cell_node);
+
+            camera_type& camera = _cameras[camera_id];
+            ++camera.items_count;
+
+            if(! camera.valid)
+            {
+                const fixed_point& camera_position = item.camera->position();
+                camera.set_position(camera_position.x().right_shift_integer(),
+                                    camera_position.y().right_shift_integer());
+            }
+        }
+
+        void erase(sprites_manager_item& item)
+        {
+            int camera_id = item.camera->id();
+            _cells[cell_index(item.position)].erase(item.camera_cell_node);
+
+            camera_type& camera = _cameras[camera_id];
+            --camera.items_count;
+
+            if(! camera.items_count)
+            {
+                camera.valid = false;
+            }
+        }
+
+        void move(sprites_manager_item& item, const fixed_point& old_position)
+        {
+            int old_cell_index = cell_index(old_position);
+            int new_cell_index = cell_index(item.position);
+
+            if(old_cell_index != new_cell_index)
+            {
+                _cells[old_cell_index].erase(item.camera_cell_node);
+                _cells[new_cell_index].push_back(item.camera_cell_node);
+            }
+        }
+
+        template<typename Function>
+        void update_camera(int camera_id, const Function& function)
+        {
+            camera_type& camera = _cameras[camera_id];
+
+            if(camera.items_count)
+            {
+                const fixed_point& camera_position = cameras_manager::position(camera_id);
+                int camera_x = camera_position.x().right_shift_integer();
+                int camera_y = camera_position.y().right_shift_integer();
+
+                if(! camera.valid || camera.x != camera_x || camera.y != camera_y)
+                {
+                    _update_camera(camera_id, camera_x, camera_y, camera, function);
+                }
+            }
+        }
+
+    private:
+        class camera_type
+        {
+
+        public:
+            int x = 0;
+            int y = 0;
+            int first_column = 0;
+            int first_row = 0;
+            int last_column = -1;
+            int last_row = -1;
+            unsigned items_count = 0;
+            bool valid = false;
+
+            void set_position(int camera_x, int camera_y)
+            {
+                // Cells are indexed by sprite center, and the biggest sprite (64x64 with double size)
+                // extends 64 pixels from it:
+                constexpr int margin = 64;
+
+                x = camera_x;
+                y = camera_y;
+                first_column = (camera_x - (display::width() / 2) - margin) >> cell_shift;
+                first_row = (camera_y - (display::height() / 2) - margin) >> cell_shift;
+                last_column = min((camera_x + (display::width() / 2) + margin) >> cell_shift,
+                                  first_column + grid_size - 1);
+                last_row = min((camera_y + (display::height() / 2) + margin) >> cell_shift,
+                               first_row + grid_size - 1);
+                valid = true;
+            }
+        };
+
+        intrusive_list<sprite_camera_cell_node_type> _cells[grid_size * grid_size];
+        camera_type _cameras[max_cameras];
+
+        template<typename Function>
+        void _update_camera(int camera_id, int camera_x, int camera_y, camera_type& camera, const Function& function)
+        {
+            camera_type old_camera = camera;
+            camera.set_position(camera_x, camera_y);
+
+            for(int row = camera.first_row; row <= camera.last_row; ++row)
+            {
+                for(int column = camera.first_column; column <= camera.last_column; ++column)
+                {
+                    _update_cell(camera_id, column, row, function);
+                }
+            }
+
+            // Hide sprites of the cells which are not near the screen anymore:
+            if(old_camera.valid)
+            {
+                for(int row = old_camera.first_row; row <= old_camera.last_row; ++row)
+                {
+                    bool row_updated = row >= camera.first_row && row <= camera.last_row;
+
+                    for(int column = old_camera.first_column; column <= old_camera.last_column; ++column)
+                    {
+                        if(! row_updated || column < camera.first_column || column > camera.last_column)
+                        {
+                            _update_cell(camera_id, column, row, function);
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename Function>
+        void _update_cell(int camera_id, int column, int row, const Function& function)
+        {
+            int index = ((row & (grid_size - 1)) * grid_size) + (column & (grid_size - 1));
+
+            for(sprite_camera_cell_node_type& node : _cells[index])
+            {
+                sprites_manager_item& item = sprites_manager_item::camera_cell_node_item(node);
+
+                if(item.camera->id() == camera_id)
+                {
+                    function(item);
+                }
+            }
+        }
+    };
+}
+
+#endif
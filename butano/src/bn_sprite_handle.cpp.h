@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_handle.h"
+
+#include "bn_fixed_point.h"
+#include "bn_sprites_manager.h"
+
+namespace bn
+{
+
+fixed sprite_handle::x() const
+{
+    return position().x();
+}
+
+void sprite_handle::set_x(fixed x)
+{
+    sprites_manager::set_x(_handle, x);
+}
+
+fixed sprite_handle::y() const
+{
+    return position().y();
+}
+
+void sprite_handle::set_y(fixed y)
+{
+    sprites_manager::set_y(_handle, y);
+}
+
+const fixed_point& sprite_handle::position() const
+{
+    return sprites_manager::position(_handle);
+}
+
+void sprite_handle::set_position(fixed x, fixed y)
+{
+    sprites_manager::set_position(_handle, fixed_point(x, y));
+}
+
+void sprite_handle::set_position(const fixed_point& position)
+{
+    sprites_manager::set_position(_handle, position);
+}
+
+int sprite_handle::tiles_offset() const
+{
+    return sprites_manager::tiles_offset(_handle);
+}
+
+void sprite_handle::set_tiles_offset(int tiles_offset)
+{
+    sprites_manager::set_tiles_offset(_handle, tiles_offset);
+}
+
+int sprite_handle::z_order() const
+{
+    return sprites_manager::z_order(_handle);
+}
+
+void sprite_handle::set_z_order(int z_order)
+{
+    sprites_manager::set_z_order(_handle, z_order);
+}
+
+bool sprite_handle::horizontal_flip() const
+{
+    return sprites_manager::horizontal_flip(_handle);
+}
+
+void sprite_handle::set_horizontal_flip(bool horizontal_flip)
+{
+    sprites_manager::set_horizontal_flip(_handle, horizontal_flip);
+}
+
+bool sprite_handle::vertical_flip() const
+{
+    return sprites_manager::vertical_flip(_handle);
+}
+
+void sprite_handle::set_vertical_flip(bool vertical_flip)
+{
+    sprites_manager::set_vertical_flip(_handle, vertical_flip);
+}
+
+bool sprite_handle::visible() const
+{
+    return sprites_manager::visible(_handle);
+}
+
+void sprite_handle::set_visible(bool visible)
+{
+    sprites_manager::set_visible(_handle, visible);
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_MULTIPLEXER_H
+#define BN_SPRITE_MULTIPLEXER_H
+
+#include "bn_memory.h"
+#include "bn_display.h"
+#include "bn_algorithm.h"
+#include "bn_config_sprites.h"
+#include "bn_config_pcm_stream.h"
+#include "../hw/include/bn_hw_sprites.h"
+#include "../hw/include/bn_hw_sprites_constants.h"
+
+namespace bn::sprite_multiplexer
+{
+    constexpr int bands_count = BN_CFG_SPRITES_MULTIPLEXER_BANDS;
+    constexpr int band_handles_count = BN_CFG_SPRITES_MULTIPLEXER_HANDLES;
+    constexpr int band_height = (display::height() + bands_count - 1) / bands_count;
+    constexpr int first_handle_index = hw::sprites::count() - band_handles_count;
+    constexpr int row_elements = band_handles_count * int(sizeof(hw::sprites::handle_type) / sizeof(uint16_t));
+
+    // Handles index of the sprites shown by the multiplexer:
+    constexpr int handles_index = -2;
+
+    static_assert(bands_count > 0 && band_height * (bands_count - 1) < display::height(), "Empty bands");
+    static_assert(band_handles_count > 0 && band_handles_count < hw::sprites::count());
+    static_assert(band_handles_count % 4 == 0, "Multiplexed handles must not split affine mats");
+    static_assert(! BN_CFG_PCM_STREAM_ENABLED, "Sprites multiplexer and PCM streams use the same DMA channel");
+
+
+    class bands
+    {
+
+    public:
+        [[nodiscard]] bool empty() const
+        {
+            return ! _multiplexed;
+        }
+
+        [[nodiscard]] int sprites_count(int band) const
+        {
+            return _counts[band];
+        }
+
+        [[nodiscard]] int dropped_sprites_count(int band) const
+        {
+            return _dropped_counts[band];
+        }
+
+        void clear()
+        {
+            memory::clear(bands_count, _counts[0]);
+            memory::clear(bands_count, _dropped_counts[0]);
+            _multiplexed = false;
+        }
+
+        bool add(const hw::sprites::handle_type& handle, int y, int height)
+        {
+            int first_band = max(y, 0) / band_height;
+            int last_band = (min(y + height, display::height()) - 1) / band_height;
+            bool fits = true;
+
+            for(int band = first_band; band <= last_band; ++band)
+            {
+                if(_counts[band] == band_handles_count)
+                {
+                    fits = false;
+                    break;
+                }
+            }
+
+            // A sprite is shown in all of its bands or in none of them:
+            for(int band = first_band; band <= last_band; ++band)
+            {
+                if(fits)
+                {
+                    hw::sprites::copy_handle(handle, _handles[band][_counts[band]]);
+                    ++_counts[band];
+                }
+                else
+                {
+                    ++_dropped_counts[band];
+                }
+            }
+
+            if(fits)
+            {
+                _multiplexed = true;
+            }
+
+            return fits;
+        }
+
+        [[nodiscard]] const uint16_t& build_rows()
+        {
+            // The rows being read by HDMA are not modified:
+            _rows_index = (_rows_index + 1) % 2;
+
+            hw::sprites::handle_type* rows = _rows[_rows_index];
+            int line = 0;
+
+            for(int band = 0; band < bands_count; ++band)
+            {
+                int band_count = _counts[band];
+                int last_line = min(line + band_height, display::height());
+                hw::sprites::handle_type* first_row = rows + (line * band_handles_count);
+
+                if(band_count)
+                {
+                    memory::copy(_handles[band][0], band_count, *first_row);
+                }
+
+                for(int index = band_count; index < band_handles_count; ++index)
+                {
+                    hw::sprites::hide_and_destroy(first_row[index].attr0);
+                }
+
+                for(++line; line < last_line; ++line)
+                {
+                    memory::copy(*first_row, band_handles_count, rows[line * band_handles_count]);
+                }
+            }
+
+            // As HDMA writes the next line in each H-Blank, the first row is also placed after the last one
+            // and HDMA starts reading from the second row:
+            memory::copy(rows[0], band_handles_count, rows[display::height() * band_handles_count]);
+            return rows[band_handles_count].attr0;
+        }
+
+    private:
+        alignas(int) hw::sprites::handle_type _handles[bands_count][band_handles_count];
+        alignas(int) hw::sprites::handle_type _rows[2][(display::height() + 1) * band_handles_count];
+        int16_t _counts[bands_count] = {};
+        int16_t _dropped_counts[bands_count] = {};
+        int _rows_index = 0;
+        bool _multiplexed = false;
+    };
+}
+
+#endif
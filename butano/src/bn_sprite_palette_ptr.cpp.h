@@ -294,6 +294,21 @@ void sprite_palette_ptr::set_rotate_count(int count)
     palettes_manager::sprite_palettes_bank().set_rotate_count(_id, count);
 }
 
+int sprite_palette_ptr::cycles_count() const
+{
+    return palettes_manager::sprite_palettes_bank().cycles_count(_id);
+}
+
+void sprite_palette_ptr::add_cycle(const palette_cycle& cycle)
+{
+    palettes_manager::sprite_palettes_bank().add_cycle(_id, cycle);
+}
+
+void sprite_palette_ptr::remove_cycles()
+{
+    palettes_manager::sprite_palettes_bank().remove_cycles(_id);
+}
+
 void sprite_palette_ptr::_destroy()
 {
     palettes_manager::sprite_palettes_bank().decrease_usages(_id);
@@ -6,6 +6,9 @@
 #include "bn_sprite_ptr.h"
 
 #include "bn_size.h"
+#include "bn_span.h"
+#include "bn_vector.h"
+#include "bn_config_sprites.h"
 #include "bn_sprite_builder.h"
 #include "bn_sprites_manager.h"
 #include "bn_affine_mat_attributes.h"
@@ -17,6 +20,18 @@
 namespace bn
 {
 
+namespace
+{
+    [[nodiscard]] sprite_affine_mat_ptr _create_affine_mat(const affine_mat_attributes& attributes)
+    {
+        #if BN_CFG_SPRITES_AFFINE_MATS_INTERNING_ENABLED
+            return sprite_affine_mat_ptr::create_shared(attributes);
+        #else
+            return sprite_affine_mat_ptr::create(attributes);
+        #endif
+    }
+}
+
 sprite_ptr sprite_ptr::create(fixed x, fixed y, const sprite_item& item)
 {
     return sprite_ptr(sprites_manager::create(fixed_point(x, y), item.shape_size(),
@@ -184,6 +199,28 @@ optional<sprite_ptr> sprite_ptr::create_optional(sprite_builder&& builder)
     return result;
 }
 
+void sprite_ptr::create_batch(const sprite_builder& builder, const span<const fixed_point>& positions,
+                              ivector<sprite_ptr>& output_sprites)
+{
+    constexpr int max_chunk_size = 32;
+
+    int count = positions.size();
+    BN_ASSERT(count <= output_sprites.available(), "output_sprites vector is full,\ncan't hold more sprites");
+
+    handle_type handles[max_chunk_size];
+
+    for(int index = 0; index < count; index += max_chunk_size)
+    {
+        int chunk_size = min(count - index, max_chunk_size);
+        sprites_manager::create(builder, positions.subspan(index, chunk_size), handles);
+
+        for(int chunk_index = 0; chunk_index < chunk_size; ++chunk_index)
+        {
+            output_sprites.push_back(sprite_ptr(handles[chunk_index]));
+        }
+    }
+}
+
 sprite_ptr::sprite_ptr(const sprite_ptr& other) :
     sprite_ptr(other._handle)
 {
@@ -302,6 +339,21 @@ void sprite_ptr::set_tiles(const sprite_tiles_item& tiles_item, const sprite_sha
     }
 }
 
+void sprite_ptr::set_tiles(const sprite_tiles_ptr& sheet_tiles, int tiles_offset)
+{
+    sprites_manager::set_tiles(_handle, sheet_tiles, tiles_offset);
+}
+
+int sprite_ptr::tiles_offset() const
+{
+    return sprites_manager::tiles_offset(_handle);
+}
+
+void sprite_ptr::set_tiles_offset(int tiles_offset)
+{
+    sprites_manager::set_tiles_offset(_handle, tiles_offset);
+}
+
 const sprite_palette_ptr& sprite_ptr::palette() const
 {
     return sprites_manager::palette(_handle);
@@ -467,7 +519,16 @@ void sprite_ptr::set_rotation_angle(fixed rotation_angle)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_rotation_angle(rotation_angle);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_rotation_angle(rotation_angle);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_rotation_angle(rotation_angle);
+        }
     }
     else if(rotation_angle != 0)
     {
@@ -476,7 +537,7 @@ void sprite_ptr::set_rotation_angle(fixed rotation_angle)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -498,7 +559,16 @@ void sprite_ptr::set_horizontal_scale(fixed horizontal_scale)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_horizontal_scale(horizontal_scale);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_horizontal_scale(horizontal_scale);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_horizontal_scale(horizontal_scale);
+        }
     }
     else if(horizontal_scale != 1)
     {
@@ -507,7 +577,7 @@ void sprite_ptr::set_horizontal_scale(fixed horizontal_scale)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -529,7 +599,16 @@ void sprite_ptr::set_vertical_scale(fixed vertical_scale)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_vertical_scale(vertical_scale);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_vertical_scale(vertical_scale);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_vertical_scale(vertical_scale);
+        }
     }
     else if(vertical_scale != 1)
     {
@@ -538,7 +617,7 @@ void sprite_ptr::set_vertical_scale(fixed vertical_scale)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -548,7 +627,16 @@ void sprite_ptr::set_scale(fixed scale)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_scale(scale);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_scale(scale);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_scale(scale);
+        }
     }
     else if(scale != 1)
     {
@@ -557,7 +645,7 @@ void sprite_ptr::set_scale(fixed scale)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -567,7 +655,16 @@ void sprite_ptr::set_scale(fixed horizontal_scale, fixed vertical_scale)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_scale(horizontal_scale, vertical_scale);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_scale(horizontal_scale, vertical_scale);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_scale(horizontal_scale, vertical_scale);
+        }
     }
     else if(horizontal_scale != 1 || vertical_scale != 1)
     {
@@ -576,7 +673,7 @@ void sprite_ptr::set_scale(fixed horizontal_scale, fixed vertical_scale)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -598,7 +695,16 @@ void sprite_ptr::set_horizontal_shear(fixed horizontal_shear)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_horizontal_shear(horizontal_shear);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_horizontal_shear(horizontal_shear);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_horizontal_shear(horizontal_shear);
+        }
     }
     else if(horizontal_shear != 0)
     {
@@ -607,7 +713,7 @@ void sprite_ptr::set_horizontal_shear(fixed horizontal_shear)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -629,7 +735,16 @@ void sprite_ptr::set_vertical_shear(fixed vertical_shear)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_vertical_shear(vertical_shear);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_vertical_shear(vertical_shear);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_vertical_shear(vertical_shear);
+        }
     }
     else if(vertical_shear != 0)
     {
@@ -638,7 +753,7 @@ void sprite_ptr::set_vertical_shear(fixed vertical_shear)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -648,7 +763,16 @@ void sprite_ptr::set_shear(fixed shear)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_shear(shear);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_shear(shear);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_shear(shear);
+        }
     }
     else if(shear != 0)
     {
@@ -657,7 +781,7 @@ void sprite_ptr::set_shear(fixed shear)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -667,7 +791,16 @@ void sprite_ptr::set_shear(fixed horizontal_shear, fixed vertical_shear)
 
     if(sprite_affine_mat_ptr* affine_mat_ptr = affine_mat.get())
     {
-        affine_mat_ptr->set_shear(horizontal_shear, vertical_shear);
+        if(affine_mat_ptr->shared())
+        {
+            affine_mat_attributes mat_attributes = affine_mat_ptr->attributes();
+            mat_attributes.set_shear(horizontal_shear, vertical_shear);
+            sprites_manager::set_shared_affine_mat_attributes(_handle, mat_attributes);
+        }
+        else
+        {
+            affine_mat_ptr->set_shear(horizontal_shear, vertical_shear);
+        }
     }
     else if(horizontal_shear != 0 || vertical_shear != 0)
     {
@@ -676,7 +809,7 @@ void sprite_ptr::set_shear(fixed horizontal_shear, fixed vertical_shear)
         mat_attributes.set_horizontal_flip(horizontal_flip());
         mat_attributes.set_vertical_flip(vertical_flip());
         set_remove_affine_mat_when_not_needed(true);
-        sprites_manager::set_affine_mat(_handle, sprite_affine_mat_ptr::create(mat_attributes));
+        sprites_manager::set_affine_mat(_handle, _create_affine_mat(mat_attributes));
     }
 }
 
@@ -730,6 +863,30 @@ void sprite_ptr::set_vertical_flip(bool vertical_flip)
     sprites_manager::set_vertical_flip(_handle, vertical_flip);
 }
 
+void sprite_ptr::set_quarter_rotation(const sprite_tiles_item& tiles_item, int graphics_index, int quarter_rotation)
+{
+    int tiles_item_graphics_count = tiles_item.graphics_count();
+    int graphics_count = tiles_item_graphics_count / 2;
+    BN_ASSERT(tiles_item_graphics_count % 2 == 0, "Invalid tiles item graphics count: ", tiles_item_graphics_count);
+    BN_ASSERT(graphics_index >= 0 && graphics_index < graphics_count,
+              "Invalid graphics index: ", graphics_index, " - ", graphics_count);
+    BN_ASSERT(quarter_rotation >= 0 && quarter_rotation < 4, "Invalid quarter rotation: ", quarter_rotation);
+    BN_ASSERT(shape_size().shape() == sprite_shape::SQUARE, "Sprite is not square");
+    BN_ASSERT(! affine_mat(), "Sprite has an affine mat attached");
+
+    // 180 degrees rotations are horizontal and vertical flips of the stored tile sets:
+    bool flip = quarter_rotation >= 2;
+
+    if(quarter_rotation % 2)
+    {
+        graphics_index += graphics_count;
+    }
+
+    set_tiles(tiles_item, graphics_index);
+    sprites_manager::set_horizontal_flip(_handle, flip);
+    sprites_manager::set_vertical_flip(_handle, flip);
+}
+
 bool sprite_ptr::mosaic_enabled() const
 {
     return sprites_manager::mosaic_enabled(_handle);
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_reuse_hbes.h"
+
+#include "bn_span.h"
+
+namespace bn
+{
+
+namespace
+{
+    template<typename Slot, typename Attributes, typename Hbe>
+    void _commit_attributes(const sprite_ptr& sprite, const ivector<Slot>& slots,
+                            optional<Attributes> Slot::* slot_attributes, const Attributes& sprite_attributes,
+                            ivector<Attributes>& attributes, optional<Hbe>& hbe)
+    {
+        bool attributes_found = false;
+
+        for(const Slot& slot : slots)
+        {
+            if(slot.*slot_attributes)
+            {
+                attributes_found = true;
+                break;
+            }
+        }
+
+        if(! attributes_found)
+        {
+            hbe.reset();
+            attributes.clear();
+            return;
+        }
+
+        bool changed = attributes.empty();
+
+        if(changed)
+        {
+            attributes.assign(display::height(), sprite_attributes);
+        }
+
+        int line = 0;
+
+        // Consecutive lines with the same attributes are merged in runs, so each run is resolved only once:
+        while(line < display::height())
+        {
+            const Attributes* run_attributes = &sprite_attributes;
+            int last_line = display::height();
+
+            for(const Slot& slot : slots)
+            {
+                if(const Attributes* attributes_ptr = (slot.*slot_attributes).get())
+                {
+                    if(line >= slot.top_line && line < slot.bottom_line)
+                    {
+                        run_attributes = attributes_ptr;
+                        last_line = min(last_line, int(slot.bottom_line));
+                    }
+                    else if(slot.top_line > line)
+                    {
+                        last_line = min(last_line, int(slot.top_line));
+                    }
+                }
+            }
+
+            for(; line < last_line; ++line)
+            {
+                Attributes& line_attributes = attributes[line];
+
+                if(line_attributes != *run_attributes)
+                {
+                    line_attributes = *run_attributes;
+                    changed = true;
+                }
+            }
+        }
+
+        if(Hbe* hbe_ptr = hbe.get())
+        {
+            if(changed)
+            {
+                hbe_ptr->reload_attributes_ref();
+            }
+        }
+        else
+        {
+            span<const Attributes> attributes_ref(attributes.data(), attributes.size());
+            hbe = Hbe::create(sprite, attributes_ref);
+        }
+    }
+}
+
+int isprite_reuse_hbes::add_slot(int top_line, int bottom_line)
+{
+    BN_ASSERT(top_line >= 0 && top_line < display::height(), "Invalid top line: ", top_line);
+    BN_ASSERT(bottom_line > top_line && bottom_line <= display::height(),
+              "Invalid bottom line: ", bottom_line, " - ", top_line);
+    BN_ASSERT(! _slots.full(), "No more slots available");
+
+    int result = _slots.size();
+    _slots.push_back(slot_type{ nullopt, nullopt, nullopt, int16_t(top_line), int16_t(bottom_line) });
+    return result;
+}
+
+void isprite_reuse_hbes::clear_slots()
+{
+    if(! _slots.empty())
+    {
+        _slots.clear();
+        _update_first_attributes = true;
+        _update_second_attributes = true;
+        _update_third_attributes = true;
+    }
+}
+
+void isprite_reuse_hbes::set_slot_lines(int index, int top_line, int bottom_line)
+{
+    BN_ASSERT(top_line >= 0 && top_line < display::height(), "Invalid top line: ", top_line);
+    BN_ASSERT(bottom_line > top_line && bottom_line <= display::height(),
+              "Invalid bottom line: ", bottom_line, " - ", top_line);
+
+    slot_type& slot = _slot(index);
+
+    if(slot.top_line != top_line || slot.bottom_line != bottom_line)
+    {
+        slot.top_line = int16_t(top_line);
+        slot.bottom_line = int16_t(bottom_line);
+        _update_slot(slot);
+    }
+}
+
+void isprite_reuse_hbes::set_slot_first_attributes(int index, const sprite_first_attributes& first_attributes)
+{
+    _slot(index).first_attributes = first_attributes;
+    _update_first_attributes = true;
+}
+
+void isprite_reuse_hbes::remove_slot_first_attributes(int index)
+{
+    optional<sprite_first_attributes>& slot_first_attributes = _slot(index).first_attributes;
+
+    if(slot_first_attributes)
+    {
+        slot_first_attributes.reset();
+        _update_first_attributes = true;
+    }
+}
+
+void isprite_reuse_hbes::set_slot_second_attributes(int index,
+                                                    const sprite_regular_second_attributes& second_attributes)
+{
+    _slot(index).second_attributes = second_attributes;
+    _update_second_attributes = true;
+}
+
+void isprite_reuse_hbes::remove_slot_second_attributes(int index)
+{
+    optional<sprite_regular_second_attributes>& slot_second_attributes = _slot(index).second_attributes;
+
+    if(slot_second_attributes)
+    {
+        slot_second_attributes.reset();
+        _update_second_attributes = true;
+    }
+}
+
+void isprite_reuse_hbes::set_slot_third_attributes(int index, const sprite_third_attributes& third_attributes)
+{
+    _slot(index).third_attributes = third_attributes;
+    _update_third_attributes = true;
+}
+
+void isprite_reuse_hbes::remove_slot_third_attributes(int index)
+{
+    optional<sprite_third_attributes>& slot_third_attributes = _slot(index).third_attributes;
+
+    if(slot_third_attributes)
+    {
+        slot_third_attributes.reset();
+        _update_third_attributes = true;
+    }
+}
+
+void isprite_reuse_hbes::update()
+{
+    if(_update_first_attributes)
+    {
+        _update_first_attributes = false;
+        _commit_attributes(_sprite, _slots, &slot_type::first_attributes, _sprite.first_attributes(),
+                           _first_attributes, _first_attributes_hbe);
+    }
+
+    if(_update_second_attributes)
+    {
+        _update_second_attributes = false;
+        _commit_attributes(_sprite, _slots, &slot_type::second_attributes, _sprite.regular_second_attributes(),
+                           _second_attributes, _second_attributes_hbe);
+    }
+
+    if(_update_third_attributes)
+    {
+        _update_third_attributes = false;
+        _commit_attributes(_sprite, _slots, &slot_type::third_attributes, _sprite.third_attributes(),
+                           _third_attributes, _third_attributes_hbe);
+    }
+}
+
+isprite_reuse_hbes::isprite_reuse_hbes(const sprite_ptr& sprite, ivector<slot_type>& slots) :
+    _sprite(sprite),
+    _slots(slots)
+{
+}
+
+const isprite_reuse_hbes::slot_type& isprite_reuse_hbes::_slot(int index) const
+{
+    BN_ASSERT(index >= 0 && index < _slots.size(), "Invalid index: ", index, " - ", _slots.size());
+
+    return _slots[index];
+}
+
+isprite_reuse_hbes::slot_type& isprite_reuse_hbes::_slot(int index)
+{
+    BN_ASSERT(index >= 0 && index < _slots.size(), "Invalid index: ", index, " - ", _slots.size());
+
+    return _slots[index];
+}
+
+void isprite_reuse_hbes::_update_slot(const slot_type& slot)
+{
+    _update_first_attributes |= bool(slot.first_attributes);
+    _update_second_attributes |= bool(slot.second_attributes);
+    _update_third_attributes |= bool(slot.third_attributes);
+}
+
+}
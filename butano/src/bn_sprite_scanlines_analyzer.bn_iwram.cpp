@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_config_sprites.h"
+
+#if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+
+#include "bn_memory.h"
+#include "bn_utility.h"
+#include "bn_algorithm.h"
+#include "bn_sprite_scanlines_analyzer.h"
+
+namespace bn::sprite_scanlines
+{
+
+namespace
+{
+    [[nodiscard]] int _scanline_cycles(const hw::sprites::handle_type& handle, int& first_line, int& last_line)
+    {
+        int attr0 = handle.attr0;
+        int mode = (attr0 & ATTR0_MODE_MASK) >> ATTR0_MODE_SHIFT;
+
+        // Hidden handles and handles with invalid shape are not rendered:
+        if(mode == 2 || attr0 >> ATTR0_SHAPE_SHIFT == 3)
+        {
+            return 0;
+        }
+
+        pair<int, int> dimensions = hw::sprites::dimensions(handle, mode == 3);
+        int y = attr0 & 255;
+
+        if(y >= display::height())
+        {
+            y -= 256;
+        }
+
+        first_line = max(y, 0);
+        last_line = min(y + dimensions.second, display::height()) - 1;
+
+        if(first_line > last_line)
+        {
+            return 0;
+        }
+
+        return mode ? 10 + (dimensions.first * 2) : dimensions.first;
+    }
+}
+
+void analyzer::analyze(const hw::sprites::handle_type* handles, int first_flickable_index, int handles_count,
+                       bool flicker)
+{
+    constexpr int max_cycles = sprites::max_scanline_cycles();
+
+    int* cycles = _cycles;
+    int dropped_sprites_count = 0;
+    memory::clear(display::height(), cycles[0]);
+
+    // Handles are drawn in order, so the ones that exceed the budget of a scanline are dropped:
+    for(int index = 0; index < handles_count; ++index)
+    {
+        int first_line;
+        int last_line;
+
+        if(int handle_cycles = _scanline_cycles(handles[index], first_line, last_line))
+        {
+            bool dropped = false;
+
+            for(int line = first_line; line <= last_line; ++line)
+            {
+                int line_cycles = cycles[line] + handle_cycles;
+                cycles[line] = line_cycles;
+
+                if(line_cycles > max_cycles)
+                {
+                    dropped = true;
+                }
+            }
+
+            if(dropped)
+            {
+                ++dropped_sprites_count;
+            }
+        }
+    }
+
+    int worst_scanline = 0;
+    int worst_scanline_cycles = cycles[0];
+    int overloaded_scanlines_count = 0;
+
+    for(int line = 0; line < display::height(); ++line)
+    {
+        int line_cycles = cycles[line];
+
+        if(line_cycles > worst_scanline_cycles)
+        {
+            worst_scanline = line;
+            worst_scanline_cycles = line_cycles;
+        }
+
+        if(line_cycles > max_cycles)
+        {
+            ++overloaded_scanlines_count;
+        }
+    }
+
+    _worst_scanline = worst_scanline;
+    _worst_scanline_cycles = worst_scanline_cycles;
+    _overloaded_scanlines_count = overloaded_scanlines_count;
+    _dropped_sprites_count = dropped_sprites_count;
+    memory::clear(hw::sprites::count() / 32, _hidden_handles[0]);
+
+    if(flicker && overloaded_scanlines_count)
+    {
+        // The lowest priority handles get the cycles first, and the higher priority ones that don't fit
+        // are hidden:
+        int* flicker_cycles = _flicker_cycles;
+        memory::clear(display::height(), flicker_cycles[0]);
+
+        for(int index = handles_count - 1; index >= 0; --index)
+        {
+            int first_line;
+            int last_line;
+
+            if(int handle_cycles = _scanline_cycles(handles[index], first_line, last_line))
+            {
+                bool fits = true;
+
+                if(index >= first_flickable_index)
+                {
+                    for(int line = first_line; line <= last_line; ++line)
+                    {
+                        if(flicker_cycles[line] + handle_cycles > max_cycles)
+                        {
+                            fits = false;
+                            break;
+                        }
+                    }
+                }
+
+                if(fits)
+                {
+                    for(int line = first_line; line <= last_line; ++line)
+                    {
+                        flicker_cycles[line] += handle_cycles;
+                    }
+                }
+                else
+                {
+                    _hidden_handles[index / 32] |= 1u << (index % 32);
+                }
+            }
+        }
+    }
+}
+
+}
+
+#endif
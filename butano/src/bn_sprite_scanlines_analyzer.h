@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_SCANLINES_ANALYZER_H
+#define BN_SPRITE_SCANLINES_ANALYZER_H
+
+#include "bn_display.h"
+#include "bn_sprites.h"
+#include "../hw/include/bn_hw_sprites.h"
+#include "../hw/include/bn_hw_sprites_constants.h"
+
+namespace bn::sprite_scanlines
+{
+    class analyzer
+    {
+
+    public:
+        [[nodiscard]] int worst_scanline() const
+        {
+            return _worst_scanline;
+        }
+
+        [[nodiscard]] int worst_scanline_cycles() const
+        {
+            return _worst_scanline_cycles;
+        }
+
+        [[nodiscard]] int overloaded_scanlines_count() const
+        {
+            return _overloaded_scanlines_count;
+        }
+
+        [[nodiscard]] int dropped_sprites_count() const
+        {
+            return _dropped_sprites_count;
+        }
+
+        [[nodiscard]] bool hidden(int handles_index) const
+        {
+            return _hidden_handles[handles_index / 32] & (1u << (handles_index % 32));
+        }
+
+        [[nodiscard]] const unsigned* hidden_handles() const
+        {
+            return _hidden_handles;
+        }
+
+        BN_CODE_IWRAM void analyze(const hw::sprites::handle_type* handles, int first_flickable_index,
+                                   int handles_count, bool flicker);
+
+    private:
+        int _cycles[display::height()];
+        int _flicker_cycles[display::height()];
+        unsigned _hidden_handles[hw::sprites::count() / 32] = {};
+        int _worst_scanline = 0;
+        int _worst_scanline_cycles = 0;
+        int _overloaded_scanlines_count = 0;
+        int _dropped_sprites_count = 0;
+    };
+}
+
+#endif
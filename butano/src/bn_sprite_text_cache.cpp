@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_text_cache.h"
+
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_builder.h"
+#include "bn_sprite_text_generator.h"
+
+namespace bn
+{
+
+namespace
+{
+    static_assert(BN_CFG_SPRITE_TEXT_CACHE_MAX_ITEMS > 0);
+    static_assert(BN_CFG_SPRITE_TEXT_CACHE_MAX_TEXT_SIZE > 0);
+}
+
+const sprite_text_cache::item_type* sprite_text_cache::_find(
+        const sprite_text_generator& generator, const string_view& text, unsigned text_hash,
+        bool one_sprite_per_character) const
+{
+    auto alignment = uint8_t(generator.alignment());
+
+    for(const item_type& item : _items)
+    {
+        if(item.text_hash == text_hash && item.alignment == alignment &&
+                item.one_sprite_per_character == one_sprite_per_character && string_view(item.text) == text &&
+                item.font_item == generator.font().item() && item.palette_item == generator.palette_item())
+        {
+            return &item;
+        }
+    }
+
+    return nullptr;
+}
+
+bool sprite_text_cache::_generate(const sprite_text_generator& generator, const item_type& item,
+                                  const fixed_point& position, bool allow_failure,
+                                  ivector<sprite_ptr>& output_sprites) const
+{
+    optional<sprite_palette_ptr> palette;
+
+    if(allow_failure)
+    {
+        palette = generator.palette_item().create_palette_optional();
+
+        if(! palette)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        palette = generator.palette_item().create_palette();
+    }
+
+    int output_sprites_count = output_sprites.size();
+
+    for(const sprite_entry& entry : item.sprites)
+    {
+        if(allow_failure)
+        {
+            if(output_sprites.full())
+            {
+                output_sprites.shrink(output_sprites_count);
+                return false;
+            }
+        }
+        else
+        {
+            BN_ASSERT(! output_sprites.full(), "output_sprites vector is full,\ncan't hold more sprites");
+        }
+
+        sprite_builder builder(entry.shape_size, entry.tiles, *palette);
+        builder.set_position(position + entry.offset);
+        builder.set_bg_priority(generator.bg_priority());
+        builder.set_z_order(generator.z_order());
+
+        if(allow_failure)
+        {
+            optional<sprite_ptr> sprite = sprite_ptr::create_optional(move(builder));
+            sprite_ptr* sprite_ptr = sprite.get();
+
+            if(! sprite_ptr)
+            {
+                output_sprites.shrink(output_sprites_count);
+                return false;
+            }
+
+            output_sprites.push_back(move(*sprite_ptr));
+        }
+        else
+        {
+            output_sprites.push_back(sprite_ptr::create(move(builder)));
+        }
+    }
+
+    return true;
+}
+
+void sprite_text_cache::_insert(const sprite_text_generator& generator, const string_view& text,
+                                unsigned text_hash, bool one_sprite_per_character, const fixed_point& position,
+                                const span<const sprite_ptr>& generated_sprites)
+{
+    if(generated_sprites.size() > max_text_size())
+    {
+        return;
+    }
+
+    if(_items.full())
+    {
+        _items.erase(_items.begin());
+    }
+
+    _items.push_back(item_type{ generator.font().item(), generator.palette_item(), text, {}, text_hash,
+                                uint8_t(generator.alignment()), one_sprite_per_character });
+
+    item_type& item = _items.back();
+
+    for(const sprite_ptr& sprite : generated_sprites)
+    {
+        item.sprites.push_back(sprite_entry{ sprite.tiles(), sprite.position() - position, sprite.shape_size() });
+    }
+}
+
+}
@@ -8,6 +8,7 @@
 #include "bn_sprites.h"
 #include "bn_sprite_ptr.h"
 #include "bn_sprite_builder.h"
+#include "bn_sprite_text_cache.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 
 namespace bn
@@ -983,6 +984,18 @@ namespace
     }
 
 
+    [[nodiscard]] bool _ascii_word(const char* text_data)
+    {
+        unsigned word = unsigned(uint8_t(text_data[0])) | (unsigned(uint8_t(text_data[1])) << 8) |
+                (unsigned(uint8_t(text_data[2])) << 16) | (unsigned(uint8_t(text_data[3])) << 24);
+
+        // All four bytes must be inside the [!, ~] range:
+        unsigned below_range = (word - 0x21212121) | word;
+        unsigned above_range = word + 0x01010101;
+        return ! ((below_range | above_range) & 0x80808080);
+    }
+
+
     template<class Painter>
     [[nodiscard]] bool _paint(const string_view& text, const iunordered_map<int, int>& utf8_characters_map,
                               Painter& painter)
@@ -993,6 +1006,26 @@ namespace
 
         while(text_index < text_size)
         {
+            // Runs of printable ASCII characters are checked 4 bytes at a time, skipping UTF-8 decoding:
+            while(text_index + 4 <= text_size && _ascii_word(text_data + text_index))
+            {
+                for(int index = 0; index < 4; ++index)
+                {
+                    bool success = painter.paint_character(text_data[text_index] - '!');
+                    ++text_index;
+
+                    if(Painter::can_fail && ! success)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            if(text_index == text_size)
+            {
+                break;
+            }
+
             char character = text_data[text_index];
 
             if(character == ' ')
@@ -1024,6 +1057,16 @@ namespace
         return true;
     }
 
+    [[nodiscard]] string_view _trimmed_line(const char* text_data, int line_start, int line_end)
+    {
+        while(line_end > line_start && text_data[line_end - 1] == ' ')
+        {
+            --line_end;
+        }
+
+        return string_view(text_data + line_start, line_end - line_start);
+    }
+
     template<bool allow_failure>
     bool _generate(const sprite_text_generator& generator, const fixed_point& position, const string_view& text,
                    const iunordered_map<int, int>& utf8_characters_map, int max_character_width, int character_height,
@@ -1232,36 +1275,137 @@ int sprite_text_generator::width(const string_view& text) const
     }
 }
 
+void sprite_text_generator::wrap(const string_view& text, int max_width, ivector<string_view>& output_lines) const
+{
+    BN_ASSERT(max_width > 0, "Invalid max width: ", max_width);
+
+    const span<const int8_t>& character_widths_ref = _font.character_widths_ref();
+    const int8_t* character_widths = character_widths_ref.empty() ? nullptr : character_widths_ref.data();
+    int space_between_characters = _font.space_between_characters();
+    int space_character_width = character_widths ? character_widths[0] : _max_character_width;
+    int space_width = space_character_width + space_between_characters;
+    int tab_width = (space_character_width * 4) + space_between_characters;
+    const char* text_data = text.data();
+    int text_index = 0;
+    int text_size = text.size();
+    int line_start = 0;
+    int line_width = 0;
+    int last_space_index = -1;
+    int width_after_last_space = 0;
+
+    // Each character is measured only once: when a line is broken, the width after the last space is kept:
+    while(text_index < text_size)
+    {
+        char character = text_data[text_index];
+        int character_index = text_index;
+        int character_width;
+
+        if(character == '\n')
+        {
+            BN_ASSERT(! output_lines.full(), "output_lines vector is full,\ncan't hold more lines");
+
+            output_lines.push_back(_trimmed_line(text_data, line_start, text_index));
+            ++text_index;
+            line_start = text_index;
+            line_width = 0;
+            last_space_index = -1;
+            continue;
+        }
+
+        if(character == ' ')
+        {
+            line_width += space_width;
+            last_space_index = text_index;
+            width_after_last_space = line_width;
+            ++text_index;
+            continue;
+        }
+
+        if(character == '\t')
+        {
+            character_width = tab_width;
+            ++text_index;
+        }
+        else if(character >= '!')
+        {
+            int graphics_index = _graphics_index(character, _utf8_characters_map, text_data, text_index);
+            character_width = character_widths ? character_widths[graphics_index + 1] : _max_character_width;
+            character_width += space_between_characters;
+        }
+        else
+        {
+            BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+        }
+
+        if(line_width + character_width > max_width && character_index > line_start)
+        {
+            BN_ASSERT(! output_lines.full(), "output_lines vector is full,\ncan't hold more lines");
+
+            if(last_space_index >= line_start)
+            {
+                output_lines.push_back(_trimmed_line(text_data, line_start, last_space_index));
+                line_start = last_space_index + 1;
+                line_width -= width_after_last_space;
+            }
+            else
+            {
+                output_lines.push_back(_trimmed_line(text_data, line_start, character_index));
+                line_start = character_index;
+                line_width = 0;
+            }
+
+            last_space_index = -1;
+        }
+
+        line_width += character_width;
+    }
+
+    if(line_start < text_size)
+    {
+        BN_ASSERT(! output_lines.full(), "output_lines vector is full,\ncan't hold more lines");
+
+        output_lines.push_back(_trimmed_line(text_data, line_start, text_size));
+    }
+}
+
 void sprite_text_generator::generate(fixed x, fixed y, const string_view& text,
                                      ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
-    _generate<false>(*this, fixed_point(x, y), text, _utf8_characters_map, _max_character_width, _character_height,
-                     one_sprite_per_character, output_sprites);
+    [[maybe_unused]] bool success = _generate_impl(fixed_point(x, y), text, false, output_sprites);
 }
 
 void sprite_text_generator::generate(const fixed_point& position, const string_view& text,
                                      ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
-    _generate<false>(*this, position, text, _utf8_characters_map, _max_character_width, _character_height,
-                     one_sprite_per_character, output_sprites);
+    [[maybe_unused]] bool success = _generate_impl(position, text, false, output_sprites);
 }
 
 bool sprite_text_generator::generate_optional(fixed x, fixed y, const string_view& text,
                                               ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
-    return _generate<true>(*this, fixed_point(x, y), text, _utf8_characters_map, _max_character_width,
-                           _character_height, one_sprite_per_character, output_sprites);
+    return _generate_impl(fixed_point(x, y), text, true, output_sprites);
 }
 
 bool sprite_text_generator::generate_optional(const fixed_point& position, const string_view& text,
                                               ivector<sprite_ptr>& output_sprites) const
 {
-    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
-    return _generate<true>(*this, position, text, _utf8_characters_map, _max_character_width, _character_height,
-                           one_sprite_per_character, output_sprites);
+    return _generate_impl(position, text, true, output_sprites);
+}
+
+void sprite_text_generator::update_digits(fixed x, fixed y, const string_view& old_text, const string_view& text,
+                                          ivector<sprite_ptr>& output_sprites) const
+{
+    update_digits(fixed_point(x, y), old_text, text, output_sprites);
+}
+
+void sprite_text_generator::update_digits(const fixed_point& position, const string_view& old_text,
+                                          const string_view& text, ivector<sprite_ptr>& output_sprites) const
+{
+    if(! _update_digits(old_text, text, output_sprites))
+    {
+        output_sprites.clear();
+        generate(position, text, output_sprites);
+    }
 }
 
 void sprite_text_generator::_init()
@@ -1305,4 +1449,137 @@ void sprite_text_generator::_init()
     }
 }
 
+bool sprite_text_generator::_generate_impl(const fixed_point& position, const string_view& text,
+                                           bool allow_failure, ivector<sprite_ptr>& output_sprites) const
+{
+    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
+    sprite_text_cache* cache = _cache;
+    unsigned text_hash = 0;
+
+    if(cache)
+    {
+        if(text.size() <= sprite_text_cache::max_text_size())
+        {
+            text_hash = hash<string_view>()(text);
+
+            if(const sprite_text_cache::item_type* item =
+                    cache->_find(*this, text, text_hash, one_sprite_per_character))
+            {
+                return cache->_generate(*this, *item, position, allow_failure, output_sprites);
+            }
+        }
+        else
+        {
+            cache = nullptr;
+        }
+    }
+
+    int output_sprites_count = output_sprites.size();
+    bool success;
+
+    if(allow_failure)
+    {
+        success = _generate<true>(*this, position, text, _utf8_characters_map, _max_character_width,
+                                  _character_height, one_sprite_per_character, output_sprites);
+    }
+    else
+    {
+        success = _generate<false>(*this, position, text, _utf8_characters_map, _max_character_width,
+                                   _character_height, one_sprite_per_character, output_sprites);
+    }
+
+    if(cache && success)
+    {
+        span<const sprite_ptr> generated_sprites(output_sprites.data() + output_sprites_count,
+                                                 output_sprites.size() - output_sprites_count);
+        cache->_insert(*this, text, text_hash, one_sprite_per_character, position, generated_sprites);
+    }
+
+    return success;
+}
+
+bool sprite_text_generator::_update_digits(const string_view& old_text, const string_view& text,
+                                           ivector<sprite_ptr>& output_sprites) const
+{
+    if(! _one_sprite_per_character && ! _font_one_sprite_per_character)
+    {
+        return false;
+    }
+
+    int text_size = text.size();
+
+    if(old_text.size() != text_size)
+    {
+        return false;
+    }
+
+    const char* old_text_data = old_text.data();
+    const char* text_data = text.data();
+    const span<const int8_t>& character_widths = _font.character_widths_ref();
+    bool fixed_width = character_widths.empty();
+
+    // Digits are single byte characters, so UTF-8 characters must remain the same:
+    for(int text_index = 0; text_index < text_size; ++text_index)
+    {
+        char old_character = old_text_data[text_index];
+        char character = text_data[text_index];
+
+        if(old_character != character)
+        {
+            if(old_character < '0' || old_character > '9' || character < '0' || character > '9')
+            {
+                return false;
+            }
+
+            if(! fixed_width &&
+                    character_widths[old_character - '!' + 1] != character_widths[character - '!' + 1])
+            {
+                return false;
+            }
+        }
+    }
+
+    // If the sprites count doesn't match, the caller regenerates the text from scratch:
+    const sprite_tiles_item& tiles_item = _font.item().tiles_item();
+    int sprites_count = output_sprites.size();
+    int sprite_index = 0;
+    int text_index = 0;
+
+    while(text_index < text_size)
+    {
+        char character = text_data[text_index];
+
+        if(character == ' ' || character == '\t')
+        {
+            ++text_index;
+        }
+        else if(character >= '!')
+        {
+            bool changed = character != old_text_data[text_index];
+            int graphics_index = _graphics_index(character, _utf8_characters_map, text_data, text_index);
+
+            if(fixed_width || character_widths[graphics_index + 1])
+            {
+                if(sprite_index == sprites_count)
+                {
+                    return false;
+                }
+
+                if(changed)
+                {
+                    output_sprites[sprite_index].set_tiles(tiles_item, graphics_index);
+                }
+
+                ++sprite_index;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return sprite_index == sprites_count;
+}
+
 }
@@ -5,6 +5,7 @@
 
 #include "bn_sprite_tiles.h"
 
+#include "bn_sprites_manager.h"
 #include "bn_sprite_tiles_manager.h"
 
 namespace bn::sprite_tiles
@@ -20,6 +21,16 @@ int available_tiles_count()
     return sprite_tiles_manager::available_tiles_count();
 }
 
+int largest_free_block_tiles_count()
+{
+    return sprite_tiles_manager::largest_free_block_tiles_count();
+}
+
+fixed fragmentation_ratio()
+{
+    return sprite_tiles_manager::fragmentation_ratio();
+}
+
 int used_items_count()
 {
     return sprite_tiles_manager::used_items_count();
@@ -30,6 +41,39 @@ int available_items_count()
     return sprite_tiles_manager::available_items_count();
 }
 
+int cache_hits_count()
+{
+    return sprite_tiles_manager::cache_hits_count();
+}
+
+int cache_misses_count()
+{
+    return sprite_tiles_manager::cache_misses_count();
+}
+
+void reset_cache_counters()
+{
+    sprite_tiles_manager::reset_cache_counters();
+}
+
+int commit_queue_size()
+{
+    return sprite_tiles_manager::commit_queue_size();
+}
+
+int deferred_commits_count()
+{
+    return sprite_tiles_manager::deferred_commits_count();
+}
+
+void defragment(int max_tiles_count)
+{
+    if(sprite_tiles_manager::defragment(max_tiles_count))
+    {
+        sprites_manager::reload_tiles();
+    }
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -5,10 +5,15 @@
 
 #include "bn_sprite_tiles_manager.h"
 
+#include "bn_bit.h"
+#include "bn_fixed.h"
 #include "bn_vector.h"
 #include "bn_string_view.h"
 #include "bn_unordered_map.h"
+#include "bn_occupancy_cells.h"
+#include "bn_config_bgs.h"
 #include "bn_config_sprite_tiles.h"
+#include "../hw/include/bn_hw_bitmap_bg.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles_constants.h"
 
@@ -34,6 +39,15 @@ namespace
                   BN_CFG_SPRITE_TILES_MAX_ITEMS <= hw::sprite_tiles::tiles_count());
     static_assert(power_of_two(BN_CFG_SPRITE_TILES_MAX_ITEMS));
 
+    // The pages of the bitmap BG overlap the first sprite tiles:
+    #if BN_CFG_BGS_BITMAP_ENABLED
+        constexpr int first_usable_tile = hw::bitmap_bg::reserved_sprite_tiles_count();
+    #else
+        constexpr int first_usable_tile = 0;
+    #endif
+
+    constexpr int usable_tiles_count = hw::sprite_tiles::tiles_count() - first_usable_tile;
+
 
     #if BN_CFG_LOG_ENABLED
         constexpr bn::string_view _status_log_message = "\nSprite tiles manager status has been logged.";
@@ -45,6 +59,8 @@ namespace
     constexpr int max_items = BN_CFG_SPRITE_TILES_MAX_ITEMS;
     constexpr int max_list_items = max_items + 2;
 
+    using index_type = uint_least_for<max_list_items>;
+
 
     enum class status_type
     {
@@ -58,8 +74,8 @@ namespace
     {
 
     public:
-        uint16_t prev_index = max_list_items;
-        uint16_t next_index = max_list_items;
+        index_type prev_index = max_list_items;
+        index_type next_index = max_list_items;
     };
 
 
@@ -74,10 +90,15 @@ namespace
 
     private:
         unsigned _status: 2 = unsigned(status_type::FREE);
-        unsigned _compression: 2 = unsigned(compression_type::NONE);
+        unsigned _compression: 3 = unsigned(compression_type::NONE);
 
     public:
         bool commit: 1 = false;
+        bool delta_commit: 1 = false;
+
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+            bool decompressed: 1 = false;
+        #endif
 
         [[nodiscard]] status_type status() const
         {
@@ -169,7 +190,7 @@ namespace
 
             for(int index = 0; index < max_items; ++index)
             {
-                _free_indices[index] = int16_t(max_items - index);
+                _free_indices[index] = index_type(max_items - index);
             }
 
             _items[0].next_index = max_list_items - 1;
@@ -233,14 +254,14 @@ namespace
         iterator erase(int index)
         {
             int next_index = _items[index].next_index;
-            _free_indices.push_back(int16_t(index));
+            _free_indices.push_back(index_type(index));
             _remove_node(index);
             return iterator(next_index, *this);
         }
 
     private:
         item_type _items[max_list_items];
-        vector<int16_t, max_items> _free_indices;
+        vector<index_type, max_items> _free_indices;
 
         void _insert_node(int position_index, int new_index)
         {
@@ -248,10 +269,10 @@ namespace
             node_type& new_node = _items[new_index];
             int prev_index = position_node.prev_index;
             node_type& prev_node = _items[prev_index];
-            prev_node.next_index = new_index;
-            new_node.prev_index = prev_index;
-            new_node.next_index = position_index;
-            position_node.prev_index = new_index;
+            prev_node.next_index = index_type(new_index);
+            new_node.prev_index = index_type(prev_index);
+            new_node.next_index = index_type(position_index);
+            position_node.prev_index = index_type(new_index);
         }
 
         void _remove_node(int position_index)
@@ -261,24 +282,57 @@ namespace
             node_type& prev_node = _items[prev_index];
             int next_index = position_node.next_index;
             node_type& next_node = _items[next_index];
-            prev_node.next_index = next_index;
-            next_node.prev_index = prev_index;
+            prev_node.next_index = index_type(next_index);
+            next_node.prev_index = index_type(prev_index);
         }
     };
 
 
+    class move_type
+    {
+
+    public:
+        uint16_t source_tile;
+        uint16_t destination_tile;
+        uint16_t tiles_count;
+    };
+
+
+    class delta_type
+    {
+
+    public:
+        const uint32_t* delta_ptr;
+        index_type id;
+    };
+
+
     class static_data
     {
 
     public:
         items_list items;
         unordered_map<const tile*, int, max_items * 2> items_map;
-        vector<uint16_t, max_items> free_items;
-        vector<uint16_t, max_items> to_remove_items;
-        vector<uint16_t, max_items> to_commit_items;
+        vector<index_type, max_items> free_items;
+        vector<index_type, max_items> to_remove_items;
+        vector<index_type, max_items> to_commit_items;
+        vector<move_type, max_items> to_move_items;
+        vector<delta_type, max_items> to_delta_items;
+
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+            tile decompression_buffer[BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES];
+        #endif
+
         int free_tiles_count = 0;
         int to_remove_tiles_count = 0;
+        int deferred_commits_count = 0;
+        int cache_hits_count = 0;
+        int cache_misses_count = 0;
         bool delay_commit = false;
+
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            bool items_released = false;
+        #endif
     };
 
     BN_DATA_EWRAM static_data data;
@@ -349,6 +403,7 @@ namespace
 
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
+            BN_LOG("deferred_commits_count: ", data.deferred_commits_count);
             BN_LOG("delay_commit: ", (data.delay_commit ? "true" : "false"));
         }
 
@@ -379,12 +434,12 @@ namespace
         return tiles_count < data.items.item(item_index).tiles_count;
     };
 
-    void _insert_free_item(int id, ivector<uint16_t>::iterator free_items_last)
+    void _insert_free_item(int id, ivector<index_type>::iterator free_items_last)
     {
         const item_type& item = data.items.item(id);
         auto free_items_it = upper_bound(data.free_items.begin(), free_items_last, item.tiles_count,
                                          tiles_count_upper_bound_comparator);
-        data.free_items.insert(free_items_it, id);
+        data.free_items.insert(free_items_it, index_type(id));
     }
 
     void _insert_free_item(int id)
@@ -411,7 +466,7 @@ namespace
         const item_type& item = data.items.item(id);
         auto to_remove_items_it = upper_bound(data.to_remove_items.begin(), data.to_remove_items.end(),
                                               item.tiles_count, tiles_count_upper_bound_comparator);
-        data.to_remove_items.insert(to_remove_items_it, id);
+        data.to_remove_items.insert(to_remove_items_it, index_type(id));
     }
 
     void _erase_to_remove_item(int id)
@@ -432,11 +487,94 @@ namespace
     {
         if(! item.commit)
         {
-            data.to_commit_items.push_back(id);
+            data.to_commit_items.push_back(index_type(id));
             item.commit = true;
         }
     }
 
+    void _erase_to_commit_item(int id)
+    {
+        for(auto it = data.to_commit_items.begin(), end = data.to_commit_items.end(); it != end; ++it)
+        {
+            if(*it == id)
+            {
+                data.to_commit_items.erase(it);
+                return;
+            }
+        }
+    }
+
+    void _erase_to_delta_items(int id)
+    {
+        erase_if(data.to_delta_items, [id](const delta_type& delta_item)
+        {
+            return delta_item.id == id;
+        });
+    }
+
+    [[nodiscard]] const tile* _decompressed_tiles_ptr()
+    {
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+            return data.decompression_buffer;
+        #else
+            return nullptr;
+        #endif
+    }
+
+    void _commit_item(item_type& item, [[maybe_unused]] const tile*& decompressed_tiles_ptr)
+    {
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+            if(item.decompressed)
+            {
+                hw::sprite_tiles::commit(decompressed_tiles_ptr, compression_type::NONE, int(item.start_tile),
+                                         int(item.tiles_count));
+                decompressed_tiles_ptr += item.tiles_count;
+                item.decompressed = false;
+                return;
+            }
+        #endif
+
+        hw::sprite_tiles::commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
+    }
+
+    void _decompress_to_commit_items()
+    {
+        #if BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES
+            // Items are decompressed in the same order they are committed:
+            tile* decompression_buffer = data.decompression_buffer;
+            int available_tiles = BN_CFG_SPRITE_TILES_DECOMPRESSION_BUFFER_TILES;
+
+            for(int item_index : data.to_commit_items)
+            {
+                item_type& item = data.items.item(item_index);
+                item.decompressed = false;
+
+                if(item.commit && item.compression() != compression_type::NONE)
+                {
+                    if(int tiles_count = int(item.tiles_count); tiles_count <= available_tiles)
+                    {
+                        hw::sprite_tiles::decompress(item.data, item.compression(), decompression_buffer);
+                        decompression_buffer += tiles_count;
+                        available_tiles -= tiles_count;
+                        item.decompressed = true;
+                    }
+                }
+            }
+        #endif
+    }
+
+    void _update_cache_counters(int find_result)
+    {
+        if(find_result == -1)
+        {
+            ++data.cache_misses_count;
+        }
+        else
+        {
+            ++data.cache_hits_count;
+        }
+    }
+
     [[nodiscard]] int _find_impl(const tile* tiles_data, [[maybe_unused]] compression_type compression,
                                  [[maybe_unused]] int tiles_count)
     {
@@ -550,6 +688,165 @@ namespace
         return new_free_item_id;
     }
 
+    #if BN_CFG_SPRITE_TILES_ALLOCATION_POLICY == BN_SPRITE_TILES_ALLOCATION_POLICY_BUDDY
+        [[nodiscard]] int _buddy_start_tile(int start_tile, int tiles_count)
+        {
+            int alignment = int(bit_ceil(unsigned(tiles_count)));
+            return (start_tile + alignment - 1) & ~(alignment - 1);
+        }
+    #endif
+
+    [[nodiscard]] ivector<index_type>::iterator _find_free_item(int tiles_count)
+    {
+        auto free_items_end = data.free_items.end();
+        auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, tiles_count,
+                                         tiles_count_lower_bound_comparator);
+
+        #if BN_CFG_SPRITE_TILES_ALLOCATION_POLICY == BN_SPRITE_TILES_ALLOCATION_POLICY_BUDDY
+            while(free_items_it != free_items_end)
+            {
+                const item_type& item = data.items.item(*free_items_it);
+                int start_tile = int(item.start_tile);
+
+                if(_buddy_start_tile(start_tile, tiles_count) + tiles_count <= start_tile + int(item.tiles_count))
+                {
+                    break;
+                }
+
+                ++free_items_it;
+            }
+        #endif
+
+        return free_items_it;
+    }
+
+    [[nodiscard]] int _create_free_item(ivector<index_type>::iterator free_items_it, const tile* tiles_data,
+                                        compression_type compression, int tiles_count, bool delay_commit)
+    {
+        int id = *free_items_it;
+
+        #if BN_CFG_SPRITE_TILES_ALLOCATION_POLICY == BN_SPRITE_TILES_ALLOCATION_POLICY_BUDDY
+            item_type& item = data.items.item(id);
+            int start_tile = int(item.start_tile);
+
+            if(int padding_tiles = _buddy_start_tile(start_tile, tiles_count) - start_tile)
+            {
+                BN_ASSERT(! data.items.full(), "No more items allowed");
+
+                // Keep the tiles before the aligned start tile in a new free item:
+                data.free_items.erase(free_items_it);
+
+                item_type padding_item;
+                padding_item.start_tile = item.start_tile;
+                padding_item.tiles_count = uint16_t(padding_tiles);
+                item.start_tile += padding_tiles;
+                item.tiles_count -= padding_tiles;
+
+                auto padding_item_iterator = data.items.insert(id, padding_item);
+                _insert_free_item(padding_item_iterator.id());
+
+                optional<int> new_free_item_id = _create_item(id, tiles_data, compression, tiles_count, delay_commit);
+
+                if(int* new_free_item_id_ptr = new_free_item_id.get())
+                {
+                    _insert_free_item(*new_free_item_id_ptr);
+                }
+
+                return id;
+            }
+        #endif
+
+        optional<int> new_free_item_id = _create_item(id, tiles_data, compression, tiles_count, delay_commit);
+
+        if(int* new_free_item_id_ptr = new_free_item_id.get())
+        {
+            _insert_free_item(*new_free_item_id_ptr, free_items_it);
+            ++free_items_it;
+        }
+
+        data.free_items.erase(free_items_it);
+        return id;
+    }
+
+    void _remove_items()
+    {
+        if(data.to_remove_tiles_count)
+        {
+            BN_SPRITE_TILES_LOG("sprite_tiles_manager - REMOVE ITEMS");
+
+            auto begin = data.items.begin();
+            auto end = data.items.end();
+
+            for(int to_remove_item_index : data.to_remove_items)
+            {
+                auto iterator = data.items.it(to_remove_item_index);
+                item_type& item = *iterator;
+
+                if(item.data)
+                {
+                    data.items_map.erase(item.data);
+                    item.data = nullptr;
+                }
+
+                item.set_status(status_type::FREE);
+
+                if(item.commit)
+                {
+                    item.commit = false;
+                    _erase_to_commit_item(to_remove_item_index);
+                }
+
+                if(item.delta_commit)
+                {
+                    item.delta_commit = false;
+                    _erase_to_delta_items(to_remove_item_index);
+                }
+
+                data.free_tiles_count += int(item.tiles_count);
+
+                auto next_iterator = iterator;
+                ++next_iterator;
+
+                if(next_iterator != end)
+                {
+                    item_type& next_item = *next_iterator;
+
+                    if(next_item.status() == status_type::FREE)
+                    {
+                        int next_id = next_iterator.id();
+                        item.tiles_count += next_item.tiles_count;
+                        _erase_free_item(next_id);
+                        data.items.erase(next_id);
+                    }
+                }
+
+                if(iterator != begin)
+                {
+                    auto previous_iterator = iterator;
+                    --previous_iterator;
+
+                    item_type& previous_item = *previous_iterator;
+
+                    if(previous_item.status() == status_type::FREE)
+                    {
+                        int previous_id = previous_iterator.id();
+                        item.start_tile = previous_item.start_tile;
+                        item.tiles_count += previous_item.tiles_count;
+                        _erase_free_item(previous_id);
+                        data.items.erase(previous_id);
+                    }
+                }
+
+                _insert_free_item(to_remove_item_index);
+            }
+
+            data.to_remove_items.clear();
+            data.to_remove_tiles_count = 0;
+
+            BN_SPRITE_TILES_LOG_STATUS();
+        }
+    }
+
     [[nodiscard]] int _create_impl(const tile* tiles_data, compression_type compression, int tiles_count)
     {
         int to_remove_tiles_count = data.to_remove_tiles_count;
@@ -585,30 +882,17 @@ namespace
 
         if(tiles_count <= data.free_tiles_count)
         {
-            auto free_items_end = data.free_items.end();
-            auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, tiles_count,
-                                             tiles_count_lower_bound_comparator);
+            auto free_items_it = _find_free_item(tiles_count);
 
-            if(free_items_it != free_items_end)
+            if(free_items_it != data.free_items.end())
             {
-                int id = *free_items_it;
-                optional<int> new_free_item_id = _create_item(
-                            id, tiles_data, compression, tiles_count, data.delay_commit);
-
-                if(int* new_free_item_id_ptr = new_free_item_id.get())
-                {
-                    _insert_free_item(*new_free_item_id_ptr, free_items_it);
-                    ++free_items_it;
-                }
-
-                data.free_items.erase(free_items_it);
-                return id;
+                return _create_free_item(free_items_it, tiles_data, compression, tiles_count, data.delay_commit);
             }
         }
 
         if(to_remove_tiles_count)
         {
-            update();
+            _remove_items();
             data.delay_commit = true;
             return _create_impl(tiles_data, compression, tiles_count);
         }
@@ -625,27 +909,23 @@ namespace
 
         if(tiles_count <= data.free_tiles_count)
         {
-            auto free_items_end = data.free_items.end();
-            auto free_items_it = lower_bound(data.free_items.begin(), free_items_end, tiles_count,
-                                             tiles_count_lower_bound_comparator);
+            auto free_items_it = _find_free_item(tiles_count);
 
-            if(free_items_it != free_items_end)
+            if(free_items_it != data.free_items.end())
             {
-                int id = *free_items_it;
-                optional<int> new_free_item_id = _create_item(
-                            id, nullptr, compression_type::NONE, tiles_count, false);
-
-                if(int* new_free_item_id_ptr = new_free_item_id.get())
-                {
-                    _insert_free_item(*new_free_item_id_ptr, free_items_it);
-                    ++free_items_it;
-                }
-
-                data.free_items.erase(free_items_it);
-                return id;
+                return _create_free_item(free_items_it, nullptr, compression_type::NONE, tiles_count, false);
             }
         }
 
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            // Cached items released before this frame are not displayed anymore, so they can be removed now:
+            if(data.to_remove_tiles_count && ! data.items_released)
+            {
+                _remove_items();
+                return _allocate_impl(tiles_count);
+            }
+        #endif
+
         return -1;
     }
 }
@@ -655,10 +935,11 @@ void init()
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - INIT");
 
     item_type new_item;
-    new_item.tiles_count = hw::sprite_tiles::tiles_count();
+    new_item.start_tile = first_usable_tile;
+    new_item.tiles_count = usable_tiles_count;
     data.items.init();
     data.items.push_front(new_item);
-    data.free_items.push_back(data.items.begin().id());
+    data.free_items.push_back(index_type(data.items.begin().id()));
     data.free_tiles_count = int(new_item.tiles_count);
 
     BN_SPRITE_TILES_LOG_STATUS();
@@ -666,7 +947,7 @@ void init()
 
 int used_tiles_count()
 {
-    return hw::sprite_tiles::tiles_count() - data.free_tiles_count;
+    return usable_tiles_count - data.free_tiles_count;
 }
 
 int available_tiles_count()
@@ -674,16 +955,81 @@ int available_tiles_count()
     return data.free_tiles_count;
 }
 
+int largest_free_block_tiles_count()
+{
+    if(data.free_items.empty())
+    {
+        return 0;
+    }
+
+    return int(data.items.item(data.free_items.back()).tiles_count);
+}
+
+fixed fragmentation_ratio()
+{
+    int free_tiles_count = data.free_tiles_count;
+
+    if(! free_tiles_count)
+    {
+        return 0;
+    }
+
+    return 1 - (fixed(largest_free_block_tiles_count()) / free_tiles_count);
+}
+
 int used_items_count()
 {
     return data.items.size();
 }
 
+void fill_occupancy_cells(span<occupancy_cell_type> cells)
+{
+    int total_tiles = hw::sprite_tiles::tiles_count();
+
+    for(const item_type& item : data.items)
+    {
+        status_type status = item.status();
+
+        if(status != status_type::FREE)
+        {
+            occupancy_cell_type type = status == status_type::USED ?
+                        occupancy_cell_type::SPRITE_TILES : occupancy_cell_type::TO_REMOVE;
+            set_occupancy_cells(int(item.start_tile), int(item.tiles_count), total_tiles, type, cells);
+        }
+    }
+}
+
 int available_items_count()
 {
     return data.items.available();
 }
 
+int cache_hits_count()
+{
+    return data.cache_hits_count;
+}
+
+int cache_misses_count()
+{
+    return data.cache_misses_count;
+}
+
+void reset_cache_counters()
+{
+    data.cache_hits_count = 0;
+    data.cache_misses_count = 0;
+}
+
+int commit_queue_size()
+{
+    return data.to_commit_items.size();
+}
+
+int deferred_commits_count()
+{
+    return data.deferred_commits_count;
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -708,6 +1054,7 @@ int available_items_count()
 
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
+            BN_LOG("deferred_commits_count: ", data.deferred_commits_count);
         #endif
     }
 #endif
@@ -719,7 +1066,9 @@ int find(const span<const tile>& tiles_ref, compression_type compression)
 
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - FIND: ", tiles_data, " - ", tiles_count, " - ", int(compression));
 
-    return _find_impl(tiles_data, compression, tiles_count);
+    int result = _find_impl(tiles_data, compression, tiles_count);
+    _update_cache_counters(result);
+    return result;
 }
 
 int create(const span<const tile>& tiles_ref, compression_type compression)
@@ -730,6 +1079,7 @@ int create(const span<const tile>& tiles_ref, compression_type compression)
     BN_SPRITE_TILES_LOG("sprite_tiles_manager - CREATE: ", tiles_data, " - ", tiles_count, " - ", int(compression));
 
     int result = _find_impl(tiles_data, compression, tiles_count);
+    _update_cache_counters(result);
 
     if(result != -1)
     {
@@ -840,6 +1190,7 @@ int create_optional(const span<const tile>& tiles_ref, compression_type compress
                         int(compression));
 
     int result = _find_impl(tiles_data, compression, tiles_count);
+    _update_cache_counters(result);
 
     if(result != -1)
     {
@@ -937,6 +1288,10 @@ void decrease_usages(int id)
         item.set_status(status_type::TO_REMOVE);
         _insert_to_remove_item(id);
         data.to_remove_tiles_count += int(item.tiles_count);
+
+        #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+            data.items_released = true;
+        #endif
     }
 
     BN_SPRITE_TILES_LOG_STATUS();
@@ -1006,6 +1361,43 @@ void set_tiles_ref(int id, const span<const tile>& tiles_ref, compression_type c
     }
 }
 
+void set_tiles_ref_delta(int id, const span<const tile>& tiles_ref, const tile* previous_tiles_data,
+                         const uint32_t* delta_ptr)
+{
+    item_type& item = data.items.item(id);
+
+    // Tiles not in VRAM yet are uploaded as usual:
+    if(item.data != previous_tiles_data || item.compression() != compression_type::NONE || item.commit ||
+            data.to_delta_items.full())
+    {
+        set_tiles_ref(id, tiles_ref, compression_type::NONE);
+        return;
+    }
+
+    const tile* new_tiles_data = tiles_ref.data();
+
+    BN_SPRITE_TILES_LOG("sprite_tiles_manager - SET_TILES_REF_DELTA: ", item.start_tile, " - ", new_tiles_data,
+                        " - ", tiles_ref.size());
+
+    BN_ASSERT(int(item.tiles_count) == tiles_ref.size(), "Tiles count does not match item tiles count: ",
+              int(item.tiles_count), " - ", tiles_ref.size());
+
+    if(previous_tiles_data != new_tiles_data)
+    {
+        BN_ASSERT(data.items_map.find(new_tiles_data) == data.items_map.end(),
+                  "Multiple copies of the same tiles data not supported");
+
+        data.items_map.erase(previous_tiles_data);
+        data.items_map.insert(new_tiles_data, id);
+
+        item.data = new_tiles_data;
+        item.delta_commit = true;
+        data.to_delta_items.push_back(delta_type{ delta_ptr, index_type(id) });
+
+        BN_SPRITE_TILES_LOG_STATUS();
+    }
+}
+
 void reload_tiles_ref(int id)
 {
     item_type& item = data.items.item(id);
@@ -1032,96 +1424,197 @@ optional<span<tile>> vram(int id)
     return result;
 }
 
-void update()
+bool defragment(int max_tiles_count)
 {
-    if(data.to_remove_tiles_count)
+    BN_ASSERT(max_tiles_count > 0, "Invalid max tiles count: ", max_tiles_count);
+
+    BN_SPRITE_TILES_LOG("sprite_tiles_manager - DEFRAGMENT: ", max_tiles_count);
+
+    bool moved = false;
+    auto end = data.items.end();
+    auto iterator = data.items.begin();
+
+    while(iterator != end && ! data.to_move_items.full())
     {
-        BN_SPRITE_TILES_LOG("sprite_tiles_manager - UPDATE");
+        auto next_iterator = iterator;
+        ++next_iterator;
 
-        auto begin = data.items.begin();
-        auto end = data.items.end();
+        if(next_iterator == end)
+        {
+            break;
+        }
+
+        item_type& item = *iterator;
+        item_type& next_item = *next_iterator;
 
-        for(int to_remove_item_index : data.to_remove_items)
+        if(item.status() != status_type::FREE || next_item.status() == status_type::FREE)
         {
-            auto iterator = data.items.it(to_remove_item_index);
-            item_type& item = *iterator;
+            iterator = next_iterator;
+            continue;
+        }
 
-            if(item.data)
-            {
-                data.items_map.erase(item.data);
-                item.data = nullptr;
-            }
+        int next_item_tiles_count = int(next_item.tiles_count);
 
-            item.set_status(status_type::FREE);
-            item.commit = false;
-            data.free_tiles_count += int(item.tiles_count);
+        if(next_item_tiles_count > max_tiles_count)
+        {
+            break;
+        }
 
-            auto next_iterator = iterator;
-            ++next_iterator;
+        // Move the used or cached item to the start of the free item, and the free item after it:
+        int free_id = iterator.id();
+        int free_start_tile = int(item.start_tile);
+        int free_tiles_count = int(item.tiles_count);
+        _erase_free_item(free_id);
+        data.items.erase(free_id);
 
-            if(next_iterator != end)
-            {
-                item_type& next_item = *next_iterator;
+        data.to_move_items.push_back(move_type{ uint16_t(next_item.start_tile), uint16_t(free_start_tile),
+                                                uint16_t(next_item_tiles_count) });
+        next_item.start_tile = unsigned(free_start_tile);
+        max_tiles_count -= next_item_tiles_count;
+        moved = true;
 
-                if(next_item.status() == status_type::FREE)
-                {
-                    int next_id = next_iterator.id();
-                    item.tiles_count += next_item.tiles_count;
-                    _erase_free_item(next_id);
-                    data.items.erase(next_id);
-                }
-            }
+        item_type new_free_item;
+        new_free_item.start_tile = unsigned(free_start_tile + next_item_tiles_count);
+        new_free_item.tiles_count = unsigned(free_tiles_count);
 
-            if(iterator != begin)
-            {
-                auto previous_iterator = iterator;
-                --previous_iterator;
+        auto following_iterator = next_iterator;
+        ++following_iterator;
 
-                item_type& previous_item = *previous_iterator;
+        if(following_iterator != end)
+        {
+            item_type& following_item = *following_iterator;
 
-                if(previous_item.status() == status_type::FREE)
-                {
-                    int previous_id = previous_iterator.id();
-                    item.start_tile = previous_item.start_tile;
-                    item.tiles_count += previous_item.tiles_count;
-                    _erase_free_item(previous_id);
-                    data.items.erase(previous_id);
-                }
+            if(following_item.status() == status_type::FREE)
+            {
+                int following_id = following_iterator.id();
+                new_free_item.tiles_count += following_item.tiles_count;
+                _erase_free_item(following_id);
+                data.items.erase(following_id);
             }
-
-            _insert_free_item(to_remove_item_index);
         }
 
-        data.to_remove_items.clear();
-        data.to_remove_tiles_count = 0;
+        iterator = data.items.insert(next_item.next_index, new_free_item);
+        _insert_free_item(iterator.id());
+    }
+
+    if(moved)
+    {
+        // Relocated tiles are copied in VBlank, so new tiles must be committed after them:
+        data.delay_commit = true;
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
 
+    return moved;
+}
+
+void update()
+{
+    #if BN_CFG_SPRITE_TILES_CACHE_ENABLED
+        data.items_released = false;
+    #else
+        _remove_items();
+    #endif
+
+    _decompress_to_commit_items();
     data.delay_commit = false;
 }
 
-void commit()
+int commit()
 {
+    int result = 0;
+
+    if(! data.to_move_items.empty())
+    {
+        BN_SPRITE_TILES_LOG("sprite_tiles_manager - MOVE");
+
+        // Tiles are always moved towards the start of VRAM, so forward copies are safe with overlapping blocks:
+        for(const move_type& move_item : data.to_move_items)
+        {
+            hw::sprite_tiles::copy_tiles(hw::sprite_tiles::vram(move_item.source_tile), move_item.tiles_count,
+                                         hw::sprite_tiles::vram(move_item.destination_tile));
+            result += int(move_item.tiles_count) * int(sizeof(tile));
+        }
+
+        data.to_move_items.clear();
+    }
+
+    if(! data.to_delta_items.empty())
+    {
+        BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT DELTAS");
+
+        // Deltas are committed before the whole items, since they were requested before them:
+        for(const delta_type& delta_item : data.to_delta_items)
+        {
+            item_type& item = data.items.item(delta_item.id);
+            tile* vram_tiles_ptr = hw::sprite_tiles::vram(int(item.start_tile));
+            result += hw::sprite_tiles::commit_delta(delta_item.delta_ptr, vram_tiles_ptr);
+            item.delta_commit = false;
+        }
+
+        data.to_delta_items.clear();
+    }
+
     if(! data.to_commit_items.empty())
     {
         BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT");
 
-        for(int item_index : data.to_commit_items)
-        {
-            item_type& item = data.items.item(item_index);
+        #if BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES
+            constexpr int max_bytes = BN_CFG_SPRITE_TILES_MAX_COMMIT_BYTES;
+            static_assert(max_bytes > 0);
+
+            int available_bytes = max_bytes;
+            const tile* decompressed_tiles_ptr = _decompressed_tiles_ptr();
+            auto to_commit_items_begin = data.to_commit_items.begin();
+            auto to_commit_items_end = data.to_commit_items.end();
+            auto to_commit_items_it = to_commit_items_begin;
 
-            if(item.commit)
+            while(to_commit_items_it != to_commit_items_end)
             {
-                hw::sprite_tiles::commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
-                item.commit = false;
+                item_type& item = data.items.item(*to_commit_items_it);
+
+                if(item.commit)
+                {
+                    int bytes = int(item.tiles_count) * int(sizeof(tile));
+
+                    if(bytes > available_bytes && available_bytes != max_bytes)
+                    {
+                        break;
+                    }
+
+                    _commit_item(item, decompressed_tiles_ptr);
+                    item.commit = false;
+                    available_bytes -= bytes;
+                    result += bytes;
+                }
+
+                ++to_commit_items_it;
             }
-        }
 
-        data.to_commit_items.clear();
+            data.to_commit_items.erase(to_commit_items_begin, to_commit_items_it);
+            data.deferred_commits_count = data.to_commit_items.size();
+        #else
+            const tile* decompressed_tiles_ptr = _decompressed_tiles_ptr();
+
+            for(int item_index : data.to_commit_items)
+            {
+                item_type& item = data.items.item(item_index);
+
+                if(item.commit)
+                {
+                    _commit_item(item, decompressed_tiles_ptr);
+                    item.commit = false;
+                    result += int(item.tiles_count) * int(sizeof(tile));
+                }
+            }
+
+            data.to_commit_items.clear();
+        #endif
 
         BN_SPRITE_TILES_LOG_STATUS();
     }
+
+    return result;
 }
 
 }
@@ -7,6 +7,7 @@
 #define BN_SPRITE_TILES_MANAGER_H
 
 #include "bn_span_fwd.h"
+#include "bn_fixed_fwd.h"
 #include "bn_config_log.h"
 #include "bn_optional_fwd.h"
 
@@ -15,6 +16,7 @@ namespace bn
     class tile;
     enum class bpp_mode : uint8_t;
     enum class compression_type : uint8_t;
+    enum class occupancy_cell_type : uint8_t;
 }
 
 namespace bn::sprite_tiles_manager
@@ -25,10 +27,26 @@ namespace bn::sprite_tiles_manager
 
     [[nodiscard]] int available_tiles_count();
 
+    [[nodiscard]] int largest_free_block_tiles_count();
+
+    [[nodiscard]] fixed fragmentation_ratio();
+
     [[nodiscard]] int used_items_count();
 
     [[nodiscard]] int available_items_count();
 
+    [[nodiscard]] int cache_hits_count();
+
+    [[nodiscard]] int cache_misses_count();
+
+    void reset_cache_counters();
+
+    [[nodiscard]] int commit_queue_size();
+
+    [[nodiscard]] int deferred_commits_count();
+
+    void fill_occupancy_cells(span<occupancy_cell_type> cells);
+
     #if BN_CFG_LOG_ENABLED
         void log_status();
     #endif
@@ -61,13 +79,18 @@ namespace bn::sprite_tiles_manager
 
     void set_tiles_ref(int id, const span<const tile>& tiles_ref, compression_type compression);
 
+    void set_tiles_ref_delta(int id, const span<const tile>& tiles_ref, const tile* previous_tiles_data,
+                             const uint32_t* delta_ptr);
+
     void reload_tiles_ref(int id);
 
     [[nodiscard]] optional<span<tile>> vram(int id);
 
+    [[nodiscard]] bool defragment(int max_tiles_count);
+
     void update();
 
-    void commit();
+    [[nodiscard]] int commit();
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include "bn_optional.h"
 #include "bn_sprite_tiles_item.h"
 #include "bn_sprite_tiles_manager.h"
+#include "bn_sprite_tiles_delta_item.h"
 
 namespace bn
 {
@@ -65,6 +66,12 @@ sprite_tiles_ptr sprite_tiles_ptr::create_new(const sprite_tiles_item& tiles_ite
     return sprite_tiles_ptr(handle);
 }
 
+sprite_tiles_ptr sprite_tiles_ptr::create_sheet(const sprite_tiles_item& tiles_item)
+{
+    int handle = sprite_tiles_manager::create(tiles_item.tiles_ref(), tiles_item.compression());
+    return sprite_tiles_ptr(handle);
+}
+
 sprite_tiles_ptr sprite_tiles_ptr::allocate(int tiles_count, bpp_mode bpp)
 {
     return sprite_tiles_ptr(sprite_tiles_manager::allocate(tiles_count, bpp));
@@ -193,6 +200,20 @@ void sprite_tiles_ptr::set_tiles_ref(const sprite_tiles_item& tiles_item, int gr
                                         tiles_item.compression());
 }
 
+void sprite_tiles_ptr::set_tiles_ref(const sprite_tiles_item& tiles_item, int graphics_index,
+                                     const sprite_tiles_delta_item& delta_item)
+{
+    int graphics_count = tiles_item.graphics_count();
+    BN_ASSERT(tiles_item.compression() == compression_type::NONE, "Compressed tiles not supported");
+    BN_ASSERT(delta_item.graphics_count() == graphics_count,
+              "Graphics count does not match: ", delta_item.graphics_count(), " - ", graphics_count);
+
+    int previous_graphics_index = graphics_index ? graphics_index - 1 : graphics_count - 1;
+    sprite_tiles_manager::set_tiles_ref_delta(_handle, tiles_item.graphics_tiles_ref(graphics_index),
+                                              tiles_item.graphics_tiles_ref(previous_graphics_index).data(),
+                                              delta_item.graphics_delta_ptr(graphics_index));
+}
+
 void sprite_tiles_ptr::reload_tiles_ref()
 {
     sprite_tiles_manager::reload_tiles_ref(_handle);
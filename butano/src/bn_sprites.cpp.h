@@ -30,6 +30,56 @@ void set_reserved_handles_count(int reserved_handles_count)
     return sprites_manager::set_reserved_handles_count(reserved_handles_count);
 }
 
+bool y_sort_enabled(int bg_priority, int z_order)
+{
+    return sprites_manager::y_sort_enabled(bg_priority, z_order);
+}
+
+void set_y_sort_enabled(int bg_priority, int z_order, bool enabled)
+{
+    sprites_manager::set_y_sort_enabled(bg_priority, z_order, enabled);
+}
+
+int worst_scanline()
+{
+    return sprites_manager::worst_scanline();
+}
+
+int worst_scanline_cycles()
+{
+    return sprites_manager::worst_scanline_cycles();
+}
+
+int overloaded_scanlines_count()
+{
+    return sprites_manager::overloaded_scanlines_count();
+}
+
+int scanlines_dropped_sprites_count()
+{
+    return sprites_manager::scanlines_dropped_sprites_count();
+}
+
+bool scanlines_flicker_enabled()
+{
+    return sprites_manager::scanlines_flicker_enabled();
+}
+
+void set_scanlines_flicker_enabled(bool enabled)
+{
+    sprites_manager::set_scanlines_flicker_enabled(enabled);
+}
+
+int multiplexed_sprites_count(int band)
+{
+    return sprites_manager::multiplexed_sprites_count(band);
+}
+
+int multiplexer_dropped_sprites_count(int band)
+{
+    return sprites_manager::multiplexer_dropped_sprites_count(band);
+}
+
 void reload()
 {
     sprites_manager::reload_all();
@@ -7,95 +7,124 @@
 
 #include "bn_sorted_sprites.h"
 
+#if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+    #include "bn_sprite_multiplexer.h"
+#endif
+
 namespace bn::sprites_manager
 {
 
-bool _check_items_on_screen_impl(void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
-                                 bool rebuild_handles, int& first_index_to_commit, int& last_index_to_commit)
+namespace
 {
-    auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
-    int first_index = first_index_to_commit;
-    int last_index = last_index_to_commit;
-
-    for(sorted_sprites::layer& layer : layers)
+    [[nodiscard]] bool _check_item_on_screen(sprites_manager_item& item, sprites_manager_hot_item& hot_item,
+                                             hw::sprites::handle_type* handles, bool rebuild_handles,
+                                             unsigned& chunks)
     {
-        for(sprites_manager_item& item : layer.items())
+        int x = hot_item.hw_position.x();
+        bool on_screen = false;
+        hot_item.check_on_screen = false;
+
+        if(x < display::width())
         {
-            if(item.check_on_screen)
-            {
-                int x = item.hw_position.x();
-                bool on_screen = false;
-                item.check_on_screen = false;
+            int y = hot_item.hw_position.y();
 
-                if(x < display::width())
+            if(y < display::height())
+            {
+                if(x + (hot_item.half_width * 2) > 0)
                 {
-                    int y = item.hw_position.y();
-
-                    if(y < display::height())
+                    if(y + (hot_item.half_height * 2) > 0)
                     {
-                        if(x + (item.half_width * 2) > 0)
-                        {
-                            if(y + (item.half_height * 2) > 0)
-                            {
-                                on_screen = true;
-                            }
-                        }
+                        on_screen = true;
                     }
                 }
+            }
+        }
 
-                if(item.on_screen != on_screen)
-                {
-                    item.on_screen = on_screen;
+        if(hot_item.on_screen != on_screen)
+        {
+            hot_item.on_screen = on_screen;
 
-                    if(on_screen)
-                    {
-                        if(item.affine_mat)
-                        {
-                            hw::sprites::show_affine(item.double_size, item.handle);
-                        }
-                        else
-                        {
-                            hw::sprites::show_regular(item.handle);
-                        }
-                    }
-                    else
-                    {
-                        hw::sprites::hide(item.handle);
-                    }
+            if(on_screen)
+            {
+                if(item.affine_mat)
+                {
+                    hw::sprites::show_affine(item.double_size, item.handle);
                 }
-
-                if(! rebuild_handles)
+                else
                 {
-                    int handles_index = item.handles_index;
+                    hw::sprites::show_regular(item.handle);
+                }
+            }
+            else
+            {
+                hw::sprites::hide(item.handle);
+            }
+        }
 
-                    if(handles_index != -1)
-                    {
-                        hw::sprites::copy_handle(item.handle, handles[handles_index]);
+        if(! rebuild_handles)
+        {
+            int handles_index = hot_item.handles_index;
+
+            if(handles_index >= 0)
+            {
+                hw::sprites::copy_handle(item.handle, handles[handles_index]);
+                chunks |= commit_chunk(handles_index);
+            }
+            else
+            {
+                rebuild_handles = true;
+            }
+        }
 
-                        if(handles_index < first_index)
-                        {
-                            first_index = handles_index;
-                        }
+        return rebuild_handles;
+    }
+}
 
-                        if(handles_index > last_index)
-                        {
-                            last_index = handles_index;
-                        }
-                    }
-                    else
-                    {
-                        rebuild_handles = true;
-                    }
-                }
+bool _check_items_on_screen_impl(void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                                 bool rebuild_handles, unsigned& chunks_to_commit)
+{
+    auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+    unsigned chunks = chunks_to_commit;
+
+    for(sorted_sprites::layer& layer : layers)
+    {
+        for(sprites_manager_item& item : layer.items())
+        {
+            sprites_manager_hot_item& hot_item = item.hot();
+
+            if(hot_item.check_on_screen)
+            {
+                rebuild_handles = _check_item_on_screen(item, hot_item, handles, rebuild_handles, chunks);
             }
         }
     }
 
-    first_index_to_commit = first_index;
-    last_index_to_commit = last_index;
+    chunks_to_commit = chunks;
     return rebuild_handles;
 }
 
+#if BN_CFG_SPRITES_SOA
+    bool _check_hot_items_on_screen_impl(void* hw_handles, sprites_manager_hot_item* hot_items, int hot_items_count,
+                                         bool rebuild_handles, unsigned& chunks_to_commit)
+    {
+        auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+        unsigned chunks = chunks_to_commit;
+
+        for(int index = 0; index < hot_items_count; ++index)
+        {
+            sprites_manager_hot_item& hot_item = hot_items[index];
+
+            if(hot_item.check_on_screen)
+            {
+                rebuild_handles = _check_item_on_screen(*hot_item.item, hot_item, handles, rebuild_handles, chunks);
+            }
+        }
+
+        chunks_to_commit = chunks;
+        return rebuild_handles;
+    }
+#endif
+
 int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
@@ -105,9 +134,11 @@ int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusiv
     {
         for(sprites_manager_item& item : layer.items())
         {
-            if(item.on_screen)
+            sprites_manager_hot_item& hot_item = item.hot();
+
+            if(hot_item.on_screen)
             {
-                #if BN_CFG_ASSERT_ENABLED
+                #if BN_CFG_ASSERT_ENABLED || BN_CFG_ASSERT_BASIC_ENABLED
                     if(visible_items_count == hw::sprites::count()) [[unlikely]]
                     {
                         return -1;
@@ -115,12 +146,12 @@ int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusiv
                 #endif
 
                 hw::sprites::copy_handle(item.handle, handles[visible_items_count]);
-                item.handles_index = int8_t(visible_items_count);
+                hot_item.handles_index = int8_t(visible_items_count);
                 ++visible_items_count;
             }
             else
             {
-                item.handles_index = -1;
+                hot_item.handles_index = -1;
             }
         }
     }
@@ -128,28 +159,66 @@ int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusiv
     return visible_items_count;
 }
 
-bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
-{
-    bool check_items_on_screen = false;
-
-    for(sorted_sprites::layer& layer : layers)
+#if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+    int _rebuild_multiplexed_handles_impl(int reserved_handles_count, void* hw_handles,
+                                          intrusive_list<sorted_sprites::layer>& layers,
+                                          sprite_multiplexer::bands& bands)
     {
-        for(sprites_manager_item& item : layer.items())
+        auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
+        int visible_items_count = reserved_handles_count;
+        bands.clear();
+
+        for(sorted_sprites::layer& layer : layers)
         {
-            if(item.camera)
+            for(sprites_manager_item& item : layer.items())
             {
-                item.update_hw_position();
+                sprites_manager_hot_item& hot_item = item.hot();
 
-                if(item.visible)
+                if(hot_item.on_screen)
+                {
+                    // Sprites that don't fit in the regular handles are multiplexed:
+                    if(visible_items_count < sprite_multiplexer::first_handle_index)
+                    {
+                        hw::sprites::copy_handle(item.handle, handles[visible_items_count]);
+                        hot_item.handles_index = int8_t(visible_items_count);
+                        ++visible_items_count;
+                    }
+                    else
+                    {
+                        bands.add(item.handle, hot_item.hw_position.y(), hot_item.half_height * 2);
+                        hot_item.handles_index = int8_t(sprite_multiplexer::handles_index);
+                    }
+                }
+                else
                 {
-                    item.check_on_screen = true;
-                    check_items_on_screen = true;
+                    hot_item.handles_index = -1;
                 }
             }
         }
+
+        return visible_items_count;
+    }
+#endif
+
+#if ! BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+bool _update_camera_impl(intrusive_list<sprite_camera_node_type>& items, int camera_x, int camera_y)
+{
+    bool check_items_on_screen = false;
+
+    for(sprite_camera_node_type& camera_node : items)
+    {
+        sprites_manager_item& item = sprites_manager_item::camera_node_item(camera_node);
+        item.update_hw_position(camera_x, camera_y);
+
+        if(item.visible)
+        {
+            item.hot().check_on_screen = true;
+            check_items_on_screen = true;
+        }
     }
 
     return check_items_on_screen;
 }
+#endif
 
 }
@@ -5,14 +5,33 @@
 
 #include "bn_sprites_manager.h"
 
+#include "bn_bit.h"
+#include "bn_span.h"
 #include "bn_vector.h"
+#include "bn_config_cameras.h"
+#include "bn_cameras_manager.h"
+#include "bn_occupancy_cells.h"
 #include "bn_sprite_first_attributes.h"
 #include "bn_sprite_regular_second_attributes.h"
 #include "bn_sorted_sprites.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
+#if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+    #include "bn_sprite_camera_cells.h"
+#endif
+
+#if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+    #include "bn_hdma_manager.h"
+    #include "bn_sprite_multiplexer.h"
+#endif
+
+#if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+    #include "bn_sprite_scanlines_analyzer.h"
+#endif
+
 #include "bn_sprites.cpp.h"
 #include "bn_sprite_ptr.cpp.h"
+#include "bn_sprite_handle.cpp.h"
 #include "bn_sprite_item.cpp.h"
 #include "bn_sprite_builder.cpp.h"
 #include "bn_sprite_third_attributes.cpp.h"
@@ -24,6 +43,7 @@ namespace bn::sprites_manager
 namespace
 {
     static_assert(BN_CFG_SPRITES_MAX_ITEMS > 0);
+    static_assert(hw::sprites::count() / commit_chunk_handles_count <= 32);
 
     using item_type = sprites_manager_item;
     using sorted_items_type = vector<item_type*, BN_CFG_SPRITES_MAX_ITEMS>;
@@ -35,35 +55,171 @@ namespace
         pool<item_type, BN_CFG_SPRITES_MAX_ITEMS> items_pool;
         hw::sprites::handle_type handles[hw::sprites::count()];
         sorted_sprites::sorter sorter;
+        vector<sort_key, BN_CFG_SPRITES_MAX_Y_SORT_LAYERS> y_sort_keys;
+
+        #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+            sprite_camera_cells::grid camera_cells;
+        #else
+            intrusive_list<sprite_camera_node_type> camera_items[BN_CFG_CAMERA_MAX_ITEMS];
+        #endif
+
+        #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+            sprite_multiplexer::bands multiplexer_bands;
+            bool multiplexer_running = false;
+        #endif
+
+        #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+            sprite_scanlines::analyzer scanlines_analyzer;
+            bool scanlines_flicker_enabled = false;
+            bool scanlines_flicker_frame = false;
+        #endif
+
         int reserved_handles_count = 0;
-        int first_index_to_commit = 0;
-        int last_index_to_commit = hw::sprites::count() - 1;
+        int first_reserved_index_to_commit = hw::sprites::count();
+        int last_reserved_index_to_commit = -1;
+        int min_index_to_commit = 0;
+        unsigned chunks_to_commit = commit_chunks(0, hw::sprites::count() - 1);
         int last_visible_items_count = 0;
         bool check_items_on_screen = false;
         bool rebuild_handles = false;
         bool reload_all_handles = false;
     };
 
-    BN_DATA_EWRAM static_data data;
+    #if BN_CFG_SPRITES_DATA_IWRAM
+        static_data data;
+    #else
+        BN_DATA_EWRAM static_data data;
+    #endif
+
+    #if BN_CFG_SPRITES_SOA
+        class hot_static_data
+        {
+
+        public:
+            sprites_manager_hot_item items[BN_CFG_SPRITES_MAX_ITEMS];
+            int items_count = 0;
+        };
+
+        hot_static_data hot_data;
+    #endif
 
     void _update_indexes_to_commit(const item_type& item)
     {
-        int handles_index = item.handles_index;
+        int handles_index = item.hot().handles_index;
 
-        if(handles_index != -1)
+        if(handles_index >= 0)
         {
             hw::sprites::copy_handle(item.handle, data.handles[handles_index]);
-
-            if(handles_index < data.first_index_to_commit)
+            data.chunks_to_commit |= commit_chunk(handles_index);
+        }
+        #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+            else if(handles_index == sprite_multiplexer::handles_index)
             {
-                data.first_index_to_commit = handles_index;
+                data.rebuild_handles = true;
             }
+        #endif
+    }
+
+    void _check_tiles_offset([[maybe_unused]] const item_type& item,
+                             [[maybe_unused]] const sprite_tiles_ptr& sheet_tiles,
+                             [[maybe_unused]] int tiles_offset)
+    {
+        [[maybe_unused]] bpp_mode bpp = item.palette->bpp();
+        [[maybe_unused]] int tiles_count = hw::sprites::shape_size(item.handle).tiles_count(bpp);
+
+        BN_ASSERT(tiles_offset >= 0, "Invalid tiles offset: ", tiles_offset);
+        BN_ASSERT(tiles_offset + tiles_count <= sheet_tiles.tiles_count(),
+                  "Invalid tiles offset: ", tiles_offset, " - ", tiles_count, " - ", sheet_tiles.tiles_count());
+        BN_ASSERT(bpp == bpp_mode::BPP_4 || tiles_offset % 2 == 0, "Invalid 8BPP tiles offset: ", tiles_offset);
+    }
+
+    #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+        void _update_multiplexer()
+        {
+            sprite_multiplexer::bands& bands = data.multiplexer_bands;
 
-            if(handles_index > data.last_index_to_commit)
+            if(bands.empty())
+            {
+                if(data.multiplexer_running)
+                {
+                    data.multiplexer_running = false;
+                    hdma_manager::medium_priority_stop();
+                }
+            }
+            else
             {
-                data.last_index_to_commit = handles_index;
+                data.multiplexer_running = true;
+                hdma_manager::medium_priority_start(
+                        bands.build_rows(), sprite_multiplexer::row_elements,
+                        hw::sprites::vram()[sprite_multiplexer::first_handle_index].attr0);
             }
         }
+    #endif
+
+    void _insert_camera_node(item_type& item)
+    {
+        if(item.camera)
+        {
+            #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+                data.camera_cells.insert(item);
+            #else
+                data.camera_items[item.camera->id()].push_back(item.camera_node);
+            #endif
+        }
+    }
+
+    void _erase_camera_node(item_type& item)
+    {
+        if(item.camera)
+        {
+            #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+                data.camera_cells.erase(item);
+            #else
+                data.camera_items[item.camera->id()].erase(item.camera_node);
+            #endif
+        }
+    }
+
+    [[nodiscard]] bool _move_camera_cell([[maybe_unused]] item_type& item,
+                                         [[maybe_unused]] const fixed_point& old_position)
+    {
+        #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+            if(item.camera)
+            {
+                // Hardware positions of the sprites far from the screen are not updated when their camera moves:
+                data.camera_cells.move(item, old_position);
+                item.update_hw_position();
+                return true;
+            }
+        #endif
+
+        return false;
+    }
+
+    void _update_camera_cell_hw_position([[maybe_unused]] item_type& item)
+    {
+        #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+            if(item.camera)
+            {
+                item.update_hw_position();
+            }
+        #endif
+    }
+
+    void _destroy_hot_item([[maybe_unused]] item_type& item)
+    {
+        #if BN_CFG_SPRITES_SOA
+            // Keep hot items packed by moving the last one to the released slot:
+            sprites_manager_hot_item& hot_item = item.hot();
+            int last_index = hot_data.items_count - 1;
+            hot_data.items_count = last_index;
+
+            if(sprites_manager_hot_item& last_hot_item = hot_data.items[last_index]; &hot_item != &last_hot_item)
+            {
+                hot_item = last_hot_item;
+                hot_item.item->set_hot(hot_item);
+            }
+        #endif
     }
 
     void _update_item_dimensions(item_type& item)
@@ -72,7 +228,7 @@ namespace
 
         if(item.visible)
         {
-            item.check_on_screen = true;
+            item.hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
     }
@@ -150,8 +306,14 @@ namespace
                 }
             }
 
-            int visible_items_count = _rebuild_handles_impl(reserved_count, handles, data.sorter.layers());
-            BN_ASSERT(visible_items_count != -1, "Too much on screen sprites");
+            #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+                int visible_items_count = _rebuild_multiplexed_handles_impl(
+                            reserved_count, handles, data.sorter.layers(), data.multiplexer_bands);
+                _update_multiplexer();
+            #else
+                int visible_items_count = _rebuild_handles_impl(reserved_count, handles, data.sorter.layers());
+                BN_BASIC_ASSERT(visible_items_count != -1, "Too much on screen sprites");
+            #endif
 
             int last_visible_items_count = data.last_visible_items_count;
             data.rebuild_handles = false;
@@ -164,8 +326,8 @@ namespace
 
             if(reload_all_handles) [[unlikely]]
             {
-                data.first_index_to_commit = 0;
-                data.last_index_to_commit = hw::sprites::count() - 1;
+                data.min_index_to_commit = 0;
+                data.chunks_to_commit = commit_chunks(0, hw::sprites::count() - 1);
             }
             else
             {
@@ -182,31 +344,200 @@ namespace
 
                 if(to_commit_items_count)
                 {
-                    data.first_index_to_commit = reserved_count;
-                    data.last_index_to_commit = reserved_count + to_commit_items_count - 1;
+                    data.chunks_to_commit = commit_chunks(reserved_count, reserved_count + to_commit_items_count - 1);
                 }
                 else
                 {
-                    data.first_index_to_commit = hw::sprites::count();
-                    data.last_index_to_commit = 0;
+                    data.chunks_to_commit = 0;
                 }
             }
         }
     }
 
+    [[nodiscard]] int _y_sort_value(const item_type& item)
+    {
+        const sprites_manager_hot_item& hot_item = item.hot();
+        return hot_item.hw_position.y() + hot_item.half_height;
+    }
+
+    [[nodiscard]] bool _y_sort_layer(sorted_sprites::layer& layer)
+    {
+        // Sprites placed lower on screen go first, so they are drawn on top of the others.
+        // Insertion sort is close to O(n) with the nearly sorted items of consecutive frames:
+        intrusive_list<item_type>& items = layer.items();
+        auto begin = items.begin();
+        auto end = items.end();
+
+        if(begin == end)
+        {
+            return false;
+        }
+
+        auto it = begin;
+        ++it;
+
+        bool sorted = false;
+
+        while(it != end)
+        {
+            auto position_it = it;
+            item_type& item = *it;
+            ++it;
+
+            int y = _y_sort_value(item);
+
+            while(position_it != begin)
+            {
+                auto previous_it = position_it;
+                --previous_it;
+
+                if(_y_sort_value(*previous_it) >= y)
+                {
+                    break;
+                }
+
+                position_it = previous_it;
+            }
+
+            if(&*position_it != &item)
+            {
+                item_type& position_item = *position_it;
+                items.erase(item);
+                items.insert(position_item, item);
+                begin = items.begin();
+                sorted = true;
+            }
+        }
+
+        return sorted;
+    }
+
+    void _update_layer_handles(sorted_sprites::layer& layer)
+    {
+        // On screen sprites of a layer have consecutive handles, so only them are updated:
+        int handles_index = hw::sprites::count();
+
+        for(const item_type& item : layer.items())
+        {
+            const sprites_manager_hot_item& hot_item = item.hot();
+
+            if(hot_item.on_screen)
+            {
+                if(hot_item.handles_index < 0)
+                {
+                    data.rebuild_handles = true;
+                    return;
+                }
+
+                handles_index = min(handles_index, int(hot_item.handles_index));
+            }
+        }
+
+        for(item_type& item : layer.items())
+        {
+            sprites_manager_hot_item& hot_item = item.hot();
+
+            if(hot_item.on_screen)
+            {
+                if(hot_item.handles_index != handles_index)
+                {
+                    hot_item.handles_index = int8_t(handles_index);
+                    _update_indexes_to_commit(item);
+                }
+
+                ++handles_index;
+            }
+        }
+    }
+
+    void _y_sort_layers()
+    {
+        for(sort_key y_sort_key : data.y_sort_keys)
+        {
+            if(sorted_sprites::layer* layer = data.sorter.find_existing_layer(y_sort_key))
+            {
+                if(_y_sort_layer(*layer) && ! data.rebuild_handles)
+                {
+                    _update_layer_handles(*layer);
+                }
+            }
+        }
+    }
+
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        void _analyze_scanlines()
+        {
+            sprite_scanlines::analyzer& analyzer = data.scanlines_analyzer;
+            unsigned old_hidden_handles[hw::sprites::count() / 32];
+            memory::copy(analyzer.hidden_handles()[0], hw::sprites::count() / 32, old_hidden_handles[0]);
+
+            bool flicker = data.scanlines_flicker_enabled && data.scanlines_flicker_frame;
+            data.scanlines_flicker_frame = ! data.scanlines_flicker_frame;
+            analyzer.analyze(data.handles, data.reserved_handles_count, data.last_visible_items_count, flicker);
+
+            // Handles which are not hidden anymore are restored in the next commit:
+            const unsigned* hidden_handles = analyzer.hidden_handles();
+
+            for(int index = 0; index < hw::sprites::count() / 32; ++index)
+            {
+                unsigned shown_handles = old_hidden_handles[index] & ~hidden_handles[index];
+
+                while(shown_handles)
+                {
+                    data.chunks_to_commit |= commit_chunk((index * 32) + countr_zero(shown_handles));
+                    shown_handles &= shown_handles - 1;
+                }
+            }
+        }
+
+        void _commit_hidden_handles()
+        {
+            const unsigned* hidden_handles = data.scanlines_analyzer.hidden_handles();
+            hw::sprites::handle_type* vram = hw::sprites::vram();
+
+            for(int index = 0; index < hw::sprites::count() / 32; ++index)
+            {
+                unsigned handles = hidden_handles[index];
+
+                while(handles)
+                {
+                    hw::sprites::hide_and_destroy(vram[(index * 32) + countr_zero(handles)].attr0);
+                    handles &= handles - 1;
+                }
+            }
+        }
+    #endif
+
     void _check_items_on_screen()
     {
         if(data.check_items_on_screen)
         {
             data.check_items_on_screen = false;
 
-            if(_check_items_on_screen_impl(data.handles, data.sorter.layers(), data.rebuild_handles,
-                                           data.first_index_to_commit, data.last_index_to_commit))
-            {
-                data.rebuild_handles = true;
-            }
+            #if BN_CFG_SPRITES_SOA
+                if(_check_hot_items_on_screen_impl(data.handles, hot_data.items, hot_data.items_count,
+                                                   data.rebuild_handles, data.chunks_to_commit))
+                {
+                    data.rebuild_handles = true;
+                }
+            #else
+                if(_check_items_on_screen_impl(data.handles, data.sorter.layers(), data.rebuild_handles,
+                                               data.chunks_to_commit))
+                {
+                    data.rebuild_handles = true;
+                }
+            #endif
         }
     }
+
+    void _commit_handles(int offset, int count)
+    {
+        #if BN_CFG_SPRITES_EARLY_COMMIT_ENABLED
+            hw::sprites::dma_commit(data.handles[0], offset, count);
+        #else
+            hw::sprites::commit(data.handles[0], offset, count);
+        #endif
+    }
 }
 
 void init()
@@ -219,6 +550,17 @@ void init()
     sprite_affine_mats_manager::init(data.handles);
 }
 
+#if BN_CFG_SPRITES_SOA
+    sprites_manager_hot_item& _create_hot_item(sprites_manager_item& item)
+    {
+        sprites_manager_hot_item& result = hot_data.items[hot_data.items_count];
+        ++hot_data.items_count;
+        result = sprites_manager_hot_item();
+        result.item = &item;
+        return result;
+    }
+#endif
+
 int used_items_count()
 {
     return data.items_pool.size();
@@ -262,6 +604,7 @@ id_type create(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder));
     data.sorter.insert(new_item);
+    _insert_camera_node(new_item);
 
     if(new_item.visible)
     {
@@ -297,6 +640,7 @@ id_type create_optional(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder), move(*tiles_ptr), move(*palette_ptr));
     data.sorter.insert(new_item);
+    _insert_camera_node(new_item);
 
     if(new_item.visible)
     {
@@ -307,6 +651,35 @@ id_type create_optional(sprite_builder&& builder)
     return &new_item;
 }
 
+void create(const sprite_builder& builder, const span<const fixed_point>& positions, id_type* output_ids)
+{
+    int count = positions.size();
+
+    if(count)
+    {
+        BN_ASSERT(count <= data.items_pool.available(), "No more sprite items available: ",
+                  count, " - ", data.items_pool.available());
+
+        sprite_tiles_ptr tiles = builder.tiles();
+        sprite_palette_ptr palette = builder.palette();
+        sorted_sprites::layer& layer = data.sorter.find_layer(sort_key(builder.bg_priority(), builder.z_order()));
+
+        for(int index = 0; index < count; ++index)
+        {
+            item_type& new_item = data.items_pool.create(builder, positions[index], tiles, palette);
+            data.sorter.insert(new_item, layer);
+            _insert_camera_node(new_item);
+            output_ids[index] = &new_item;
+        }
+
+        if(builder.visible())
+        {
+            data.check_items_on_screen = true;
+            data.rebuild_handles = true;
+        }
+    }
+}
+
 void increase_usages(id_type id)
 {
     auto item = static_cast<item_type*>(id);
@@ -321,6 +694,7 @@ void decrease_usages(id_type id)
     if(! item->usages)
     {
         data.sorter.erase(*item);
+        _erase_camera_node(*item);
 
         if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
         {
@@ -333,6 +707,7 @@ void decrease_usages(id_type id)
             _update_indexes_to_commit(*item);
         }
 
+        _destroy_hot_item(*item);
         data.items_pool.destroy(*item);
     }
 }
@@ -340,7 +715,7 @@ void decrease_usages(id_type id)
 optional<int> hw_id(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
-    int handles_index = item->handles_index;
+    int handles_index = item->hot().handles_index;
     optional<int> result;
 
     if(handles_index >= 0)
@@ -372,7 +747,8 @@ sprite_shape_size shape_size(id_type id)
 bn::size dimensions(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
-    return bn::size(item->half_width * 2, item->half_height * 2);
+    const sprites_manager_hot_item& hot_item = item->hot();
+    return bn::size(hot_item.half_width * 2, hot_item.half_height * 2);
 }
 
 const sprite_tiles_ptr& tiles(id_type id)
@@ -394,6 +770,7 @@ void set_tiles(id_type id, const sprite_tiles_ptr& tiles)
 
         hw::sprites::set_tiles(tiles.id(), handle);
         item->tiles = tiles;
+        item->tiles_offset = 0;
         _update_indexes_to_commit(*item);
     }
 }
@@ -411,6 +788,7 @@ void set_tiles(id_type id, sprite_tiles_ptr&& tiles)
 
         hw::sprites::set_tiles(tiles.id(), handle);
         item->tiles = move(tiles);
+        item->tiles_offset = 0;
         _update_indexes_to_commit(*item);
     }
 }
@@ -428,6 +806,7 @@ void set_tiles(id_type id, const sprite_shape_size& shape_size, const sprite_til
         hw::sprites::handle_type& handle = item->handle;
         hw::sprites::set_tiles(tiles.id(), handle);
         item->tiles = tiles;
+        item->tiles_offset = 0;
 
         if(shape_size != hw::sprites::shape_size(handle))
         {
@@ -460,6 +839,7 @@ void set_tiles(id_type id, const sprite_shape_size& shape_size, sprite_tiles_ptr
         hw::sprites::handle_type& handle = item->handle;
         hw::sprites::set_tiles(tiles.id(), handle);
         item->tiles = move(tiles);
+        item->tiles_offset = 0;
 
         if(shape_size != hw::sprites::shape_size(handle))
         {
@@ -473,6 +853,47 @@ void set_tiles(id_type id, const sprite_shape_size& shape_size, sprite_tiles_ptr
     }
 }
 
+void set_tiles(id_type id, const sprite_tiles_ptr& sheet_tiles, int tiles_offset)
+{
+    auto item = static_cast<item_type*>(id);
+    hw::sprites::handle_type& handle = item->handle;
+    _check_tiles_offset(*item, sheet_tiles, tiles_offset);
+
+    if(sheet_tiles != item->tiles)
+    {
+        item->tiles = sheet_tiles;
+    }
+    else if(tiles_offset == item->tiles_offset)
+    {
+        return;
+    }
+
+    hw::sprites::set_tiles(sheet_tiles.id() + tiles_offset, handle);
+    item->tiles_offset = uint16_t(tiles_offset);
+    _update_indexes_to_commit(*item);
+}
+
+int tiles_offset(id_type id)
+{
+    auto item = static_cast<const item_type*>(id);
+    return item->tiles_offset;
+}
+
+void set_tiles_offset(id_type id, int tiles_offset)
+{
+    auto item = static_cast<item_type*>(id);
+
+    if(tiles_offset != item->tiles_offset)
+    {
+        // Only the tile index of the handle is updated, so the tiles reference counting is not modified:
+        const sprite_tiles_ptr& tiles = *item->tiles;
+        _check_tiles_offset(*item, tiles, tiles_offset);
+        hw::sprites::set_tiles(tiles.id() + tiles_offset, item->handle);
+        item->tiles_offset = uint16_t(tiles_offset);
+        _update_indexes_to_commit(*item);
+    }
+}
+
 const sprite_palette_ptr& palette(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
@@ -532,6 +953,7 @@ void set_tiles_and_palette(id_type id, const sprite_shape_size& shape_size, spri
         {
             hw::sprites::set_tiles(tiles.id(), handle);
             item->tiles = move(tiles);
+            item->tiles_offset = 0;
         }
 
         if(different_palette)
@@ -561,8 +983,9 @@ const fixed_point& position(id_type id)
 
 const point& hw_position(id_type id)
 {
-    auto item = static_cast<const item_type*>(id);
-    return item->hw_position;
+    auto item = static_cast<item_type*>(id);
+    _update_camera_cell_hw_position(*item);
+    return item->hot().hw_position;
 }
 
 void set_x(id_type id, fixed x)
@@ -577,13 +1000,17 @@ void set_x(id_type id, fixed x)
 
     if(diff)
     {
-        int hw_x = item->hw_position.x() + diff;
-        item->hw_position.set_x(hw_x);
-        hw::sprites::set_x(hw_x, item->handle);
+        if(! _move_camera_cell(*item, fixed_point(old_x, item->position.y())))
+        {
+            point& hw_position = item->hot().hw_position;
+            int hw_x = hw_position.x() + diff;
+            hw_position.set_x(hw_x);
+            hw::sprites::set_x(hw_x, item->handle);
+        }
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            item->hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
     }
@@ -601,13 +1028,17 @@ void set_y(id_type id, fixed y)
 
     if(diff)
     {
-        int hw_y = item->hw_position.y() + diff;
-        item->hw_position.set_y(hw_y);
-        hw::sprites::set_y(hw_y, item->handle);
+        if(! _move_camera_cell(*item, fixed_point(item->position.x(), old_y)))
+        {
+            point& hw_position = item->hot().hw_position;
+            int hw_y = hw_position.y() + diff;
+            hw_position.set_y(hw_y);
+            hw::sprites::set_y(hw_y, item->handle);
+        }
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            item->hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
     }
@@ -625,16 +1056,20 @@ void set_position(id_type id, const fixed_point& position)
 
     if(diff != point())
     {
-        point new_hw_position = item->hw_position + diff;
-        item->hw_position = new_hw_position;
+        if(! _move_camera_cell(*item, old_position))
+        {
+            point& hw_position = item->hot().hw_position;
+            point new_hw_position = hw_position + diff;
+            hw_position = new_hw_position;
 
-        hw::sprites::handle_type& handle = item->handle;
-        hw::sprites::set_x(new_hw_position.x(), handle);
-        hw::sprites::set_y(new_hw_position.y(), handle);
+            hw::sprites::handle_type& handle = item->handle;
+            hw::sprites::set_x(new_hw_position.x(), handle);
+            hw::sprites::set_y(new_hw_position.y(), handle);
+        }
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            item->hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
     }
@@ -723,7 +1158,16 @@ void set_horizontal_flip(id_type id, bool horizontal_flip)
 
     if(sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
     {
-        item_affine_mat->set_horizontal_flip(horizontal_flip);
+        if(item_affine_mat->shared())
+        {
+            affine_mat_attributes mat_attributes = item_affine_mat->attributes();
+            mat_attributes.set_horizontal_flip(horizontal_flip);
+            set_shared_affine_mat_attributes(id, mat_attributes);
+        }
+        else
+        {
+            item_affine_mat->set_horizontal_flip(horizontal_flip);
+        }
     }
     else
     {
@@ -755,7 +1199,16 @@ void set_vertical_flip(id_type id, bool vertical_flip)
 
     if(sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
     {
-        item_affine_mat->set_vertical_flip(vertical_flip);
+        if(item_affine_mat->shared())
+        {
+            affine_mat_attributes mat_attributes = item_affine_mat->attributes();
+            mat_attributes.set_vertical_flip(vertical_flip);
+            set_shared_affine_mat_attributes(id, mat_attributes);
+        }
+        else
+        {
+            item_affine_mat->set_vertical_flip(vertical_flip);
+        }
     }
     else
     {
@@ -891,14 +1344,16 @@ void set_visible(id_type id, bool visible)
 
         if(visible)
         {
-            item->check_on_screen = true;
+            _update_camera_cell_hw_position(*item);
+            item->hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
         else
         {
             hw::sprites::hide(item->handle);
-            item->on_screen = false;
-            item->check_on_screen = false;
+            sprites_manager_hot_item& hot_item = item->hot();
+            hot_item.on_screen = false;
+            hot_item.check_on_screen = false;
             _update_indexes_to_commit(*item);
         }
     }
@@ -916,12 +1371,14 @@ void set_camera(id_type id, camera_ptr&& camera)
 
     if(camera != item->camera)
     {
+        _erase_camera_node(*item);
         item->camera = move(camera);
+        _insert_camera_node(*item);
         item->update_hw_position();
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            item->hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
     }
@@ -933,12 +1390,13 @@ void remove_camera(id_type id)
 
     if(item->camera)
     {
+        _erase_camera_node(*item);
         item->camera.reset();
         item->update_hw_position();
 
         if(item->visible)
         {
-            item->check_on_screen = true;
+            item->hot().check_on_screen = true;
             data.check_items_on_screen = true;
         }
     }
@@ -970,6 +1428,20 @@ void set_affine_mat(id_type id, sprite_affine_mat_ptr&& affine_mat)
     }
 }
 
+void set_shared_affine_mat_attributes(id_type id, const affine_mat_attributes& attributes)
+{
+    auto item = static_cast<item_type*>(id);
+    const sprite_affine_mat_ptr& item_affine_mat = *item->affine_mat;
+
+    if(attributes != item_affine_mat.attributes())
+    {
+        if(! sprite_affine_mats_manager::update_shared(item_affine_mat.id(), attributes))
+        {
+            _assign_affine_mat(*item, sprite_affine_mat_ptr::create_shared(attributes));
+        }
+    }
+}
+
 void remove_affine_mat(id_type id)
 {
     auto item = static_cast<item_type*>(id);
@@ -1070,8 +1542,13 @@ void set_reserved_handles_count(int reserved_handles_count)
 
     if(reserved_handles_count != old_reserved_handles_count)
     {
-        BN_ASSERT(reserved_handles_count >= 0 && reserved_handles_count < hw::sprites::count(),
-                  "Invalid reserved handles count: ", reserved_handles_count);
+        #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+            BN_ASSERT(reserved_handles_count >= 0 && reserved_handles_count < sprite_multiplexer::first_handle_index,
+                      "Invalid reserved handles count: ", reserved_handles_count);
+        #else
+            BN_ASSERT(reserved_handles_count >= 0 && reserved_handles_count < hw::sprites::count(),
+                      "Invalid reserved handles count: ", reserved_handles_count);
+        #endif
 
         if(reserved_handles_count > old_reserved_handles_count)
         {
@@ -1081,7 +1558,7 @@ void set_reserved_handles_count(int reserved_handles_count)
             {
                 for(item_type& item : layer.items())
                 {
-                    item.handles_index = -1;
+                    item.hot().handles_index = -1;
                 }
             }
         }
@@ -1091,6 +1568,164 @@ void set_reserved_handles_count(int reserved_handles_count)
     }
 }
 
+void* reserved_handles()
+{
+    return data.handles;
+}
+
+bool y_sort_enabled(int bg_priority, int z_order)
+{
+    sort_key y_sort_key(bg_priority, z_order);
+
+    for(sort_key other_y_sort_key : data.y_sort_keys)
+    {
+        if(other_y_sort_key == y_sort_key)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void set_y_sort_enabled(int bg_priority, int z_order, bool enabled)
+{
+    BN_ASSERT(bg_priority >= 0 && bg_priority <= sprites::max_bg_priority(), "Invalid BG priority: ", bg_priority);
+    BN_ASSERT(z_order >= sprites::min_z_order() && z_order <= sprites::max_z_order(), "Invalid z order: ", z_order);
+
+    sort_key y_sort_key(bg_priority, z_order);
+    vector<sort_key, BN_CFG_SPRITES_MAX_Y_SORT_LAYERS>& y_sort_keys = data.y_sort_keys;
+
+    for(auto it = y_sort_keys.begin(), end = y_sort_keys.end(); it != end; ++it)
+    {
+        if(*it == y_sort_key)
+        {
+            if(! enabled)
+            {
+                y_sort_keys.erase(it);
+            }
+
+            return;
+        }
+    }
+
+    if(enabled)
+    {
+        BN_ASSERT(! y_sort_keys.full(), "No more Y sort layers available");
+
+        y_sort_keys.push_back(y_sort_key);
+    }
+}
+
+void commit_reserved_handles(int first_index, int count)
+{
+    BN_ASSERT(first_index >= 0 && count >= 0 && first_index + count <= data.reserved_handles_count,
+              "Invalid reserved handles range: ", first_index, " - ", count, " - ", data.reserved_handles_count);
+
+    if(count)
+    {
+        data.first_reserved_index_to_commit = min(data.first_reserved_index_to_commit, first_index);
+        data.last_reserved_index_to_commit = max(data.last_reserved_index_to_commit, first_index + count - 1);
+    }
+}
+
+void fill_handles_occupancy_cells(span<occupancy_cell_type> cells)
+{
+    // Reserved handles are placed before the handles of the visible sprites:
+    set_occupancy_cells(0, data.last_visible_items_count, hw::sprites::count(), occupancy_cell_type::SPRITE_HANDLE,
+                        cells);
+}
+
+int worst_scanline()
+{
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        return data.scanlines_analyzer.worst_scanline();
+    #else
+        BN_ERROR("Sprites scanlines analysis is not enabled");
+
+        return 0;
+    #endif
+}
+
+int worst_scanline_cycles()
+{
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        return data.scanlines_analyzer.worst_scanline_cycles();
+    #else
+        BN_ERROR("Sprites scanlines analysis is not enabled");
+
+        return 0;
+    #endif
+}
+
+int overloaded_scanlines_count()
+{
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        return data.scanlines_analyzer.overloaded_scanlines_count();
+    #else
+        BN_ERROR("Sprites scanlines analysis is not enabled");
+
+        return 0;
+    #endif
+}
+
+int scanlines_dropped_sprites_count()
+{
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        return data.scanlines_analyzer.dropped_sprites_count();
+    #else
+        BN_ERROR("Sprites scanlines analysis is not enabled");
+
+        return 0;
+    #endif
+}
+
+bool scanlines_flicker_enabled()
+{
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        return data.scanlines_flicker_enabled;
+    #else
+        BN_ERROR("Sprites scanlines analysis is not enabled");
+
+        return false;
+    #endif
+}
+
+void set_scanlines_flicker_enabled([[maybe_unused]] bool enabled)
+{
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        data.scanlines_flicker_enabled = enabled;
+    #else
+        BN_ERROR("Sprites scanlines analysis is not enabled");
+    #endif
+}
+
+int multiplexed_sprites_count([[maybe_unused]] int band)
+{
+    #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+        BN_ASSERT(band >= 0 && band < sprite_multiplexer::bands_count, "Invalid band: ", band);
+
+        return data.multiplexer_bands.sprites_count(band);
+    #else
+        BN_ERROR("Sprites multiplexer is not enabled");
+
+        return 0;
+    #endif
+}
+
+int multiplexer_dropped_sprites_count([[maybe_unused]] int band)
+{
+    #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+        BN_ASSERT(band >= 0 && band < sprite_multiplexer::bands_count, "Invalid band: ", band);
+
+        return data.multiplexer_bands.dropped_sprites_count(band);
+    #else
+        BN_ERROR("Sprites multiplexer is not enabled");
+
+        return 0;
+    #endif
+}
+
 void reload(id_type id)
 {
     auto item = static_cast<item_type*>(id);
@@ -1111,6 +1746,26 @@ void reload_blending()
     }
 }
 
+void reload_tiles()
+{
+    for(sorted_sprites::layer& layer : data.sorter.layers())
+    {
+        for(item_type& item : layer.items())
+        {
+            if(const sprite_tiles_ptr* tiles = item.tiles.get())
+            {
+                int tiles_id = tiles->id() + item.tiles_offset;
+
+                if(tiles_id != hw::sprites::tiles_id(item.handle))
+                {
+                    hw::sprites::set_tiles(tiles_id, item.handle);
+                    _update_indexes_to_commit(item);
+                }
+            }
+        }
+    }
+}
+
 void reload_all()
 {
     data.last_visible_items_count = hw::sprites::count();
@@ -1280,9 +1935,33 @@ void fill_hblank_effect_third_attributes([[maybe_unused]] sprite_shape_size shap
     }
 }
 
-void update_cameras()
+void update_camera(int camera_id)
 {
-    data.check_items_on_screen |= _update_cameras_impl(data.sorter.layers());
+    #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+        bool check_items_on_screen = false;
+
+        data.camera_cells.update_camera(camera_id, [&check_items_on_screen](item_type& item) {
+                    item.update_hw_position();
+
+                    if(item.visible)
+                    {
+                        item.hot().check_on_screen = true;
+                        check_items_on_screen = true;
+                    }
+                });
+
+        data.check_items_on_screen |= check_items_on_screen;
+    #else
+        intrusive_list<sprite_camera_node_type>& camera_items = data.camera_items[camera_id];
+
+        if(! camera_items.empty())
+        {
+            const fixed_point& camera_position = cameras_manager::position(camera_id);
+            data.check_items_on_screen |= _update_camera_impl(
+                        camera_items, camera_position.x().right_shift_integer(),
+                        camera_position.y().right_shift_integer());
+        }
+    #endif
 }
 
 void remove_identity_affine_mat_if_not_needed(id_type id)
@@ -1319,30 +1998,69 @@ void update()
 {
     sprite_affine_mats_manager::update();
     _check_items_on_screen();
+    _y_sort_layers();
     _rebuild_handles();
+
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        _analyze_scanlines();
+    #endif
+}
+
+bool must_commit()
+{
+    return data.first_reserved_index_to_commit <= data.last_reserved_index_to_commit || data.chunks_to_commit ||
+            sprite_affine_mats_manager::must_commit();
 }
 
 void commit()
 {
-    int first_index_to_commit = data.first_index_to_commit;
-    int last_index_to_commit = data.last_index_to_commit;
+    int first_reserved_index_to_commit = data.first_reserved_index_to_commit;
+    int last_reserved_index_to_commit = data.last_reserved_index_to_commit;
+
+    if(first_reserved_index_to_commit <= last_reserved_index_to_commit)
+    {
+        data.first_reserved_index_to_commit = hw::sprites::count();
+        data.last_reserved_index_to_commit = -1;
+        _commit_handles(first_reserved_index_to_commit,
+                        last_reserved_index_to_commit - first_reserved_index_to_commit + 1);
+    }
+
+    unsigned chunks_to_commit = data.chunks_to_commit;
 
     if(auto affine_mats_commit_data = sprite_affine_mats_manager::retrieve_commit_data())
     {
         int multiplier = hw::sprites::count() / hw::sprite_affine_mats::count();
         int first_mat_index_to_commit = affine_mats_commit_data->offset * multiplier;
         int last_mat_index_to_commit = first_mat_index_to_commit + (affine_mats_commit_data->count * multiplier) - 1;
-        first_index_to_commit = min(first_index_to_commit, first_mat_index_to_commit);
-        last_index_to_commit = max(last_index_to_commit, last_mat_index_to_commit);
+        chunks_to_commit |= commit_chunks(first_mat_index_to_commit, last_mat_index_to_commit);
     }
 
-    if(first_index_to_commit < hw::sprites::count())
+    if(chunks_to_commit)
     {
-        int commit_items_count = last_index_to_commit - first_index_to_commit + 1;
-        hw::sprites::commit(data.handles[0], first_index_to_commit, commit_items_count);
-        data.first_index_to_commit = hw::sprites::count();
-        data.last_index_to_commit = 0;
+        int min_index_to_commit = data.min_index_to_commit;
+        data.min_index_to_commit = data.reserved_handles_count;
+        data.chunks_to_commit = 0;
+
+        while(chunks_to_commit)
+        {
+            int first_chunk = countr_zero(chunks_to_commit);
+            int chunks_count = countr_one(chunks_to_commit >> first_chunk);
+            int first_index_to_commit = first_chunk * commit_chunk_handles_count;
+            int last_index_to_commit = ((first_chunk + chunks_count) * commit_chunk_handles_count) - 1;
+            chunks_to_commit &= ~commit_chunks(first_index_to_commit, last_index_to_commit);
+            first_index_to_commit = max(first_index_to_commit, min_index_to_commit);
+
+            if(first_index_to_commit <= last_index_to_commit)
+            {
+                int commit_items_count = last_index_to_commit - first_index_to_commit + 1;
+                _commit_handles(first_index_to_commit, commit_items_count);
+            }
+        }
     }
+
+    #if BN_CFG_SPRITES_SCANLINES_ANALYSIS_ENABLED
+        _commit_hidden_handles();
+    #endif
 }
 
 }
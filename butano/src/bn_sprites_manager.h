@@ -6,8 +6,10 @@
 #ifndef BN_SPRITES_MANAGER_H
 #define BN_SPRITES_MANAGER_H
 
+#include "bn_span_fwd.h"
 #include "bn_fixed_fwd.h"
 #include "bn_optional_fwd.h"
+#include "bn_config_sprites.h"
 #include "bn_intrusive_list_fwd.h"
 
 namespace bn
@@ -21,25 +23,48 @@ class sprite_builder;
 class sprite_tiles_ptr;
 class sprite_shape_size;
 class sprite_palette_ptr;
+class sprites_manager_item;
 class sprite_affine_mat_ptr;
+class affine_mat_attributes;
 class sprite_first_attributes;
 class sprite_third_attributes;
+class sprites_manager_hot_item;
 class sprite_regular_second_attributes;
 class sprite_affine_second_attributes;
 enum class bpp_mode : uint8_t;
 enum class sprite_size : uint8_t;
 enum class sprite_shape : uint8_t;
 enum class sprite_double_size_mode : uint8_t;
+enum class occupancy_cell_type : uint8_t;
 
 namespace sorted_sprites
 {
     class layer;
 }
 
+namespace sprite_multiplexer
+{
+    class bands;
+}
+
 namespace sprites_manager
 {
     using id_type = void*;
 
+    constexpr int commit_chunk_handles_count = 4;
+
+    [[nodiscard]] constexpr unsigned commit_chunk(int handles_index)
+    {
+        return 1u << (handles_index / commit_chunk_handles_count);
+    }
+
+    [[nodiscard]] constexpr unsigned commit_chunks(int first_handles_index, int last_handles_index)
+    {
+        int first_chunk = first_handles_index / commit_chunk_handles_count;
+        int chunks_count = (last_handles_index / commit_chunk_handles_count) - first_chunk + 1;
+        return (0xFFFFFFFFu >> (32 - chunks_count)) << first_chunk;
+    }
+
     void init();
 
     [[nodiscard]] int used_items_count();
@@ -56,6 +81,8 @@ namespace sprites_manager
 
     [[nodiscard]] id_type create_optional(sprite_builder&& builder);
 
+    void create(const sprite_builder& builder, const span<const fixed_point>& positions, id_type* output_ids);
+
     void increase_usages(id_type id);
 
     void decrease_usages(id_type id);
@@ -80,6 +107,12 @@ namespace sprites_manager
 
     void set_tiles(id_type id, const sprite_shape_size& shape_size, sprite_tiles_ptr&& tiles);
 
+    void set_tiles(id_type id, const sprite_tiles_ptr& sheet_tiles, int tiles_offset);
+
+    [[nodiscard]] int tiles_offset(id_type id);
+
+    void set_tiles_offset(id_type id, int tiles_offset);
+
     void remove_tiles(id_type id);
 
     [[nodiscard]] const sprite_palette_ptr& palette(id_type id);
@@ -159,6 +192,8 @@ namespace sprites_manager
 
     void set_affine_mat(id_type id, sprite_affine_mat_ptr&& affine_mat);
 
+    void set_shared_affine_mat_attributes(id_type id, const affine_mat_attributes& attributes);
+
     void remove_affine_mat(id_type id);
 
     [[nodiscard]] bool remove_affine_mat_when_not_needed(id_type id);
@@ -185,10 +220,38 @@ namespace sprites_manager
 
     void set_reserved_handles_count(int reserved_handles_count);
 
+    [[nodiscard]] void* reserved_handles();
+
+    [[nodiscard]] bool y_sort_enabled(int bg_priority, int z_order);
+
+    void set_y_sort_enabled(int bg_priority, int z_order, bool enabled);
+
+    void commit_reserved_handles(int first_index, int count);
+
+    void fill_handles_occupancy_cells(span<occupancy_cell_type> cells);
+
+    [[nodiscard]] int worst_scanline();
+
+    [[nodiscard]] int worst_scanline_cycles();
+
+    [[nodiscard]] int overloaded_scanlines_count();
+
+    [[nodiscard]] int scanlines_dropped_sprites_count();
+
+    [[nodiscard]] bool scanlines_flicker_enabled();
+
+    void set_scanlines_flicker_enabled(bool enabled);
+
+    [[nodiscard]] int multiplexed_sprites_count(int band);
+
+    [[nodiscard]] int multiplexer_dropped_sprites_count(int band);
+
     void reload(id_type id);
 
     void reload_blending();
 
+    void reload_tiles();
+
     void reload_all();
 
     void fill_hblank_effect_horizontal_positions(id_type id, int hw_x, const fixed* positions_ptr, uint16_t* dest_ptr);
@@ -209,7 +272,7 @@ namespace sprites_manager
     void fill_hblank_effect_third_attributes(
             sprite_shape_size shape_size, const sprite_third_attributes* third_attributes_ptr, uint16_t* dest_ptr);
 
-    void update_cameras();
+    void update_camera(int camera_id);
 
     void remove_identity_affine_mat_if_not_needed(id_type id);
 
@@ -217,16 +280,35 @@ namespace sprites_manager
 
     void update();
 
+    [[nodiscard]] bool must_commit();
+
     void commit();
 
     [[nodiscard]] BN_CODE_IWRAM bool _check_items_on_screen_impl(
             void* hw_handles, intrusive_list<sorted_sprites::layer>& layers, bool rebuild_handles,
-            int& first_index_to_commit, int& last_index_to_commit);
+            unsigned& chunks_to_commit);
+
+    #if BN_CFG_SPRITES_SOA
+        [[nodiscard]] sprites_manager_hot_item& _create_hot_item(sprites_manager_item& item);
+
+        [[nodiscard]] BN_CODE_IWRAM bool _check_hot_items_on_screen_impl(
+                void* hw_handles, sprites_manager_hot_item* hot_items, int hot_items_count, bool rebuild_handles,
+                unsigned& chunks_to_commit);
+    #endif
 
     [[nodiscard]] BN_CODE_IWRAM int _rebuild_handles_impl(
             int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers);
 
-    [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers);
+    #if BN_CFG_SPRITES_MULTIPLEXER_ENABLED
+        [[nodiscard]] BN_CODE_IWRAM int _rebuild_multiplexed_handles_impl(
+                int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                sprite_multiplexer::bands& bands);
+    #endif
+
+    #if ! BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+        [[nodiscard]] BN_CODE_IWRAM bool _update_camera_impl(intrusive_list<intrusive_list_node_type>& items,
+                                                             int camera_x, int camera_y);
+    #endif
 }
 
 }
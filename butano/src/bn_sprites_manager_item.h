@@ -13,6 +13,7 @@
 #include "bn_camera_ptr.h"
 #include "bn_fixed_point.h"
 #include "bn_intrusive_list.h"
+#include "bn_config_sprites.h"
 #include "bn_display_manager.h"
 #include "bn_sprites_manager.h"
 #include "bn_sprite_tiles_ptr.h"
@@ -24,8 +25,11 @@
 namespace bn
 {
     class sprite_builder;
+    class sprites_manager_item;
 
     using sprite_affine_mat_attach_node_type = intrusive_list_node_type;
+    using sprite_camera_cell_node_type = intrusive_list_node_type;
+    using sprite_camera_node_type = intrusive_list_node_type;
 }
 
 namespace bn::sorted_sprites
@@ -36,14 +40,37 @@ namespace bn::sorted_sprites
 namespace bn
 {
 
+class sprites_manager_hot_item
+{
+
+public:
+    #if BN_CFG_SPRITES_SOA
+        sprites_manager_item* item;
+    #endif
+
+    point hw_position;
+    int8_t handles_index = -1;
+    int8_t half_width = 0;
+    int8_t half_height = 0;
+    bool on_screen: 1 = false;
+    bool check_on_screen: 1 = false;
+};
+
+
 class sprites_manager_item : public intrusive_list_node_type
 {
 
 public:
     sprite_affine_mat_attach_node_type affine_mat_attach_node;
+
+    #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+        sprite_camera_cell_node_type camera_cell_node;
+    #else
+        sprite_camera_node_type camera_node;
+    #endif
+
     hw::sprites::handle_type handle;
     fixed_point position;
-    point hw_position;
     unsigned usages = 1;
     sort_key sprite_sort_key;
     optional<sprite_tiles_ptr> tiles;
@@ -51,16 +78,12 @@ public:
     optional<sprite_affine_mat_ptr> affine_mat;
     optional<camera_ptr> camera;
     int16_t sort_layer_ptr_diff;
-    int8_t handles_index = -1;
-    int8_t half_width;
-    int8_t half_height;
+    uint16_t tiles_offset = 0;
     unsigned double_size_mode: 2;
     bool double_size: 1;
     bool blending_enabled: 1;
     bool visible: 1;
     bool remove_affine_mat_when_not_needed: 1;
-    bool on_screen: 1;
-    bool check_on_screen: 1;
 
     [[nodiscard]] static sprites_manager_item& affine_mat_attach_node_item(
             sprite_affine_mat_attach_node_type& attach_node)
@@ -72,6 +95,26 @@ public:
         return *item;
     }
 
+    #if BN_CFG_SPRITES_CAMERA_CELLS_ENABLED
+        [[nodiscard]] static sprites_manager_item& camera_cell_node_item(sprite_camera_cell_node_type& cell_node)
+        {
+            auto item_address = reinterpret_cast<intptr_t>(&cell_node);
+            item_address -= sizeof(intrusive_list_node_type) + sizeof(sprite_affine_mat_attach_node_type);
+
+            auto item = reinterpret_cast<sprites_manager_item*>(item_address);
+            return *item;
+        }
+    #else
+        [[nodiscard]] static sprites_manager_item& camera_node_item(sprite_camera_node_type& camera_node)
+        {
+            auto item_address = reinterpret_cast<intptr_t>(&camera_node);
+            item_address -= sizeof(intrusive_list_node_type) + sizeof(sprite_affine_mat_attach_node_type);
+
+            auto item = reinterpret_cast<sprites_manager_item*>(item_address);
+            return *item;
+        }
+    #endif
+
     sprites_manager_item(const fixed_point& _position, const sprite_shape_size& shape_size,
                          sprite_tiles_ptr&& _tiles, sprite_palette_ptr&& _palette) :
         position(_position),
@@ -82,10 +125,10 @@ public:
         double_size(false),
         blending_enabled(false),
         visible(true),
-        remove_affine_mat_when_not_needed(true),
-        on_screen(false),
-        check_on_screen(true)
+        remove_affine_mat_when_not_needed(true)
     {
+        hot().check_on_screen = true;
+
         const sprite_palette_ptr& palette_ref = *palette;
         hw::sprites::setup_regular(shape_size, tiles->id(), palette_ref.id(), palette_ref.bpp(),
                                    display_manager::blending_fade_enabled(), handle);
@@ -103,10 +146,9 @@ public:
         double_size(false),
         blending_enabled(builder.blending_enabled()),
         visible(builder.visible()),
-        remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed()),
-        on_screen(false),
-        check_on_screen(builder.visible())
+        remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed())
     {
+        hot().check_on_screen = builder.visible();
         _builder_init(builder);
     }
 
@@ -121,13 +163,55 @@ public:
         double_size(false),
         blending_enabled(builder.blending_enabled()),
         visible(builder.visible()),
-        remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed()),
-        on_screen(false),
-        check_on_screen(builder.visible())
+        remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed())
+    {
+        hot().check_on_screen = builder.visible();
+        _builder_init(builder);
+    }
+
+    sprites_manager_item(const sprite_builder& builder, const fixed_point& _position,
+                         const sprite_tiles_ptr& _tiles, const sprite_palette_ptr& _palette) :
+        position(_position),
+        sprite_sort_key(builder.bg_priority(), builder.z_order()),
+        tiles(_tiles),
+        palette(_palette),
+        affine_mat(builder.affine_mat()),
+        camera(builder.camera()),
+        double_size_mode(unsigned(builder.double_size_mode())),
+        double_size(false),
+        blending_enabled(builder.blending_enabled()),
+        visible(builder.visible()),
+        remove_affine_mat_when_not_needed(builder.remove_affine_mat_when_not_needed())
     {
+        hot().check_on_screen = builder.visible();
         _builder_init(builder);
     }
 
+    [[nodiscard]] const sprites_manager_hot_item& hot() const
+    {
+        #if BN_CFG_SPRITES_SOA
+            return *_hot;
+        #else
+            return _hot;
+        #endif
+    }
+
+    [[nodiscard]] sprites_manager_hot_item& hot()
+    {
+        #if BN_CFG_SPRITES_SOA
+            return *_hot;
+        #else
+            return _hot;
+        #endif
+    }
+
+    #if BN_CFG_SPRITES_SOA
+        void set_hot(sprites_manager_hot_item& hot)
+        {
+            _hot = &hot;
+        }
+    #endif
+
     [[nodiscard]] bool new_double_size() const
     {
         switch(sprite_double_size_mode(double_size_mode))
@@ -191,8 +275,9 @@ public:
     void update_half_dimensions()
     {
         pair<int, int> dimensions = hw::sprites::dimensions(handle, double_size);
-        half_width = int8_t(dimensions.first / 2);
-        half_height = int8_t(dimensions.second / 2);
+        sprites_manager_hot_item& hot_item = hot();
+        hot_item.half_width = int8_t(dimensions.first / 2);
+        hot_item.half_height = int8_t(dimensions.second / 2);
         update_hw_position();
     }
 
@@ -212,21 +297,35 @@ public:
         update_hw_y(real_y);
     }
 
+    void update_hw_position(int camera_x, int camera_y)
+    {
+        update_hw_x(position.x().right_shift_integer() - camera_x);
+        update_hw_y(position.y().right_shift_integer() - camera_y);
+    }
+
     void update_hw_x(int real_x)
     {
-        int hw_x = real_x + (display::width() / 2) - int(half_width);
-        hw_position.set_x(hw_x);
+        sprites_manager_hot_item& hot_item = hot();
+        int hw_x = real_x + (display::width() / 2) - int(hot_item.half_width);
+        hot_item.hw_position.set_x(hw_x);
         hw::sprites::set_x(hw_x, handle);
     }
 
     void update_hw_y(int real_y)
     {
-        int hw_y = real_y + (display::height() / 2) - int(half_height);
-        hw_position.set_y(hw_y);
+        sprites_manager_hot_item& hot_item = hot();
+        int hw_y = real_y + (display::height() / 2) - int(hot_item.half_height);
+        hot_item.hw_position.set_y(hw_y);
         hw::sprites::set_y(hw_y, handle);
     }
 
 private:
+    #if BN_CFG_SPRITES_SOA
+        sprites_manager_hot_item* _hot = &sprites_manager::_create_hot_item(*this);
+    #else
+        sprites_manager_hot_item _hot;
+    #endif
+
     void _builder_init(const sprite_builder& builder)
     {
         const sprite_palette_ptr& palette_ref = *palette;
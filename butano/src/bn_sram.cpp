@@ -5,11 +5,207 @@
 
 #include "bn_sram.h"
 
+#include "bn_memory.h"
+#include "bn_algorithm.h"
 #include "../hw/include/bn_hw_sram.h"
 
 namespace _bn::sram
 {
 
+namespace
+{
+    // Header compatible with GBA BIOS compressed data (type 4 in the high nibble of the first byte),
+    // followed by LZ4 block sequences (see bn::compression_type::LZ4):
+    constexpr int header_size = 4;
+    constexpr unsigned header_type = 0x40;
+
+    constexpr int min_match_length = 4;
+    constexpr int max_match_distance = 65535;
+
+    // LZ4 block format end conditions:
+    constexpr int last_literals = 5;
+    constexpr int match_find_limit = 12;
+
+    constexpr int hash_table_bits = 11;
+    constexpr int hash_table_size = 1 << hash_table_bits;
+
+    class static_data
+    {
+
+    public:
+        uint16_t hash_table[hash_table_size];
+    };
+
+    BN_DATA_EWRAM static_data data;
+
+
+    // Volatile writes, since SRAM doesn't support 16bit and 32bit writes:
+    class compressed_writer
+    {
+
+    public:
+        compressed_writer(volatile uint8_t* destination, int max_size) :
+            _destination(destination),
+            _max_size(max_size)
+        {
+        }
+
+        [[nodiscard]] int size() const
+        {
+            return _size;
+        }
+
+        [[nodiscard]] bool overflow() const
+        {
+            return _size > _max_size;
+        }
+
+        void write(unsigned byte)
+        {
+            if(_size < _max_size) [[likely]]
+            {
+                _destination[_size] = uint8_t(byte);
+            }
+
+            ++_size;
+        }
+
+        void write(const uint8_t* bytes, int count)
+        {
+            for(int index = 0; index < count; ++index)
+            {
+                write(bytes[index]);
+            }
+        }
+
+        void write_length(int length)
+        {
+            while(length >= 255)
+            {
+                write(255);
+                length -= 255;
+            }
+
+            write(unsigned(length));
+        }
+
+    private:
+        volatile uint8_t* _destination;
+        int _max_size;
+        int _size = header_size;
+    };
+
+
+    [[nodiscard]] unsigned _read_word(const uint8_t* bytes)
+    {
+        return unsigned(bytes[0]) | (unsigned(bytes[1]) << 8) | (unsigned(bytes[2]) << 16) |
+                (unsigned(bytes[3]) << 24);
+    }
+
+    [[nodiscard]] int _hash(unsigned word)
+    {
+        return int((word * 2654435761u) >> (32 - hash_table_bits));
+    }
+
+    void _write_sequence(const uint8_t* literals, int literals_count, int match_length, int match_distance,
+                         compressed_writer& writer)
+    {
+        unsigned token = unsigned(bn::min(literals_count, 15)) << 4;
+
+        if(match_length)
+        {
+            token |= unsigned(bn::min(match_length - min_match_length, 15));
+        }
+
+        writer.write(token);
+
+        if(literals_count >= 15)
+        {
+            writer.write_length(literals_count - 15);
+        }
+
+        writer.write(literals, literals_count);
+
+        if(match_length)
+        {
+            writer.write(unsigned(match_distance) & 0xFF);
+            writer.write(unsigned(match_distance) >> 8);
+
+            if(match_length - min_match_length >= 15)
+            {
+                writer.write_length(match_length - min_match_length - 15);
+            }
+        }
+    }
+
+    [[nodiscard]] int _compress(const void* source, int size, volatile uint8_t* destination, int max_size)
+    {
+        auto source_bytes = static_cast<const uint8_t*>(source);
+        uint16_t* hash_table = data.hash_table;
+        compressed_writer writer(destination, max_size);
+        int literals_index = 0;
+        int index = 0;
+
+        // Previous header is invalidated first, so interrupted writes are not read as valid data:
+        destination[0] = 0;
+
+        // Greedy matching with one candidate per hash, since speed is more important than ratio:
+        bn::memory::clear(hash_table_size, hash_table[0]);
+
+        while(index < size - match_find_limit)
+        {
+            unsigned word = _read_word(source_bytes + index);
+            int hash = _hash(word);
+            int candidate = hash_table[hash];
+            int distance = index - candidate;
+            hash_table[hash] = uint16_t(index);
+
+            if(candidate < index && distance <= max_match_distance && _read_word(source_bytes + candidate) == word)
+            {
+                int match_length = min_match_length;
+                int max_match_length = size - last_literals - index;
+
+                while(match_length < max_match_length &&
+                      source_bytes[index + match_length] == source_bytes[candidate + match_length])
+                {
+                    ++match_length;
+                }
+
+                _write_sequence(source_bytes + literals_index, index - literals_index, match_length, distance,
+                                writer);
+
+                if(writer.overflow())
+                {
+                    return 0;
+                }
+
+                index += match_length;
+                literals_index = index;
+            }
+            else
+            {
+                ++index;
+            }
+        }
+
+        if(literals_index < size)
+        {
+            _write_sequence(source_bytes + literals_index, size - literals_index, 0, 0, writer);
+        }
+
+        if(writer.overflow())
+        {
+            return 0;
+        }
+
+        destination[3] = uint8_t(unsigned(size) >> 16);
+        destination[2] = uint8_t(unsigned(size) >> 8);
+        destination[1] = uint8_t(size);
+        destination[0] = uint8_t(header_type);
+        return writer.size();
+    }
+}
+
 void unsafe_write(const void* source, int size, int offset)
 {
     bn::hw::sram::write(source, size, offset);
@@ -20,4 +216,130 @@ void unsafe_read(void* destination, int size, int offset)
     bn::hw::sram::read(destination, size, offset);
 }
 
+int unsafe_write_compressed(const void* source, int size, int offset)
+{
+    volatile uint8_t* destination = bn::hw::sram::data() + offset;
+    int max_size = bn::sram::size() - offset;
+    BN_ASSERT(max_size >= header_size, "Offset is too high: ", offset);
+
+    int result = _compress(source, size, destination, max_size);
+    BN_ASSERT(result, "Compressed data doesn't fit in SRAM: ", size, " - ", offset);
+
+    return result;
+}
+
+bool unsafe_read_compressed(void* destination, int size, int offset)
+{
+    return decompress(bn::hw::sram::data() + offset, bn::sram::size() - offset, destination, size);
+}
+
+int compress(const void* source, int size, void* destination, int max_size)
+{
+    BN_ASSERT(max_size >= header_size, "Invalid max size: ", max_size);
+
+    return _compress(source, size, static_cast<uint8_t*>(destination), max_size);
+}
+
+bool decompress(const volatile uint8_t* source, int source_size, void* destination, int size)
+{
+    if(source_size < header_size || source[0] != header_type ||
+            int(source[1] | (source[2] << 8) | (source[3] << 16)) != size)
+    {
+        return false;
+    }
+
+    // Corrupted data is detected instead of writing outside the destination buffer:
+    auto destination_bytes = static_cast<uint8_t*>(destination);
+    int source_index = header_size;
+    int destination_index = 0;
+
+    auto read_length = [&](int length, int& result)
+    {
+        if(length == 15)
+        {
+            unsigned extra_length;
+
+            do
+            {
+                if(source_index >= source_size)
+                {
+                    return false;
+                }
+
+                extra_length = source[source_index];
+                ++source_index;
+                length += int(extra_length);
+            }
+            while(extra_length == 255);
+        }
+
+        result = length;
+        return true;
+    };
+
+    while(destination_index < size)
+    {
+        if(source_index >= source_size)
+        {
+            return false;
+        }
+
+        unsigned token = source[source_index];
+        ++source_index;
+
+        int literals;
+
+        if(! read_length(int(token >> 4), literals) || literals > size - destination_index ||
+                literals > source_size - source_index)
+        {
+            return false;
+        }
+
+        for(int index = 0; index < literals; ++index)
+        {
+            destination_bytes[destination_index + index] = source[source_index + index];
+        }
+
+        source_index += literals;
+        destination_index += literals;
+
+        if(destination_index == size)
+        {
+            break;
+        }
+
+        if(source_index + 2 > source_size)
+        {
+            return false;
+        }
+
+        int distance = int(source[source_index] | (source[source_index + 1] << 8));
+        source_index += 2;
+
+        int length;
+
+        if(! read_length(int(token & 15), length) || distance == 0 || distance > destination_index)
+        {
+            return false;
+        }
+
+        length += min_match_length;
+
+        if(length > size - destination_index)
+        {
+            return false;
+        }
+
+        // Matches can overlap the bytes being written, so they are copied one by one:
+        for(int index = 0; index < length; ++index)
+        {
+            destination_bytes[destination_index + index] = destination_bytes[destination_index + index - distance];
+        }
+
+        destination_index += length;
+    }
+
+    return true;
+}
+
 }
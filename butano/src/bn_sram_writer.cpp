@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sram_writer.h"
+
+#include "bn_core.h"
+#include "bn_config_sram.h"
+#include "../hw/include/bn_hw_sram.h"
+
+namespace bn
+{
+
+namespace
+{
+    static_assert(BN_CFG_SRAM_WRITER_TASK_BYTES > 0);
+
+    // Each byte takes a RAM compare and, if it has been changed, an SRAM write:
+    constexpr int task_max_ticks = max((BN_CFG_SRAM_WRITER_TASK_BYTES * 3) / 4, 1);
+
+    class static_data
+    {
+
+    public:
+        isram_writer* first_writer = nullptr;
+        isram_writer* last_writer = nullptr;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+isram_writer::isram_writer(uint8_t* data, uint8_t* shadow, int size, int offset) :
+    _data(data),
+    _shadow(shadow),
+    _size(size),
+    _offset(offset),
+    _next_index(size)
+{
+    BN_ASSERT(offset >= 0, "Invalid offset: ", offset);
+    BN_ASSERT(size + offset <= sram::size(), "Size and offset are too high: ", size, " - ", offset);
+
+    hw::sram::read(shadow, size, offset);
+    memory::copy(*shadow, size, *data);
+}
+
+isram_writer::~isram_writer()
+{
+    flush();
+}
+
+void isram_writer::update(int max_bytes)
+{
+    BN_ASSERT(max_bytes > 0, "Invalid max bytes: ", max_bytes);
+
+    const uint8_t* data = _data;
+    uint8_t* shadow = _shadow;
+    int index = _next_index;
+    int last_index = min(index + max_bytes, _size);
+
+    while(index < last_index)
+    {
+        if(data[index] == shadow[index])
+        {
+            ++index;
+        }
+        else
+        {
+            // Runs of changed bytes are written at once:
+            int run_index = index + 1;
+
+            while(run_index < last_index && data[run_index] != shadow[run_index])
+            {
+                ++run_index;
+            }
+
+            int run_size = run_index - index;
+            hw::sram::write(data + index, run_size, _offset + index);
+            memory::copy(data[index], run_size, shadow[index]);
+            index = run_index;
+        }
+    }
+
+    _next_index = index;
+
+    if(index == _size)
+    {
+        _dequeue();
+    }
+}
+
+void isram_writer::flush()
+{
+    if(! done())
+    {
+        update(_size - _next_index);
+    }
+}
+
+void isram_writer::_write(const void* source)
+{
+    memory::copy(*static_cast<const uint8_t*>(source), _size, *_data);
+    _next_index = 0;
+    _enqueue();
+}
+
+void isram_writer::_write_compressed(const void* source, int size)
+{
+    int compressed_size = _bn::sram::compress(source, size, _data, _size);
+    BN_ASSERT(compressed_size, "Compressed data doesn't fit: ", size, " - ", _size);
+
+    _next_index = 0;
+    _enqueue();
+}
+
+bool isram_writer::_read_compressed(void* destination, int size) const
+{
+    return _bn::sram::decompress(_data, _size, destination, size);
+}
+
+void isram_writer::_enqueue()
+{
+    if(! _queued)
+    {
+        _queued = true;
+        _next_writer = nullptr;
+
+        if(isram_writer* last_writer = data.last_writer)
+        {
+            last_writer->_next_writer = this;
+        }
+        else
+        {
+            data.first_writer = this;
+            core::post_idle_task(_update_queued, task_max_ticks);
+        }
+
+        data.last_writer = this;
+    }
+}
+
+void isram_writer::_dequeue()
+{
+    if(_queued)
+    {
+        isram_writer* previous_writer = nullptr;
+        isram_writer* writer = data.first_writer;
+
+        while(writer != this)
+        {
+            previous_writer = writer;
+            writer = writer->_next_writer;
+        }
+
+        if(previous_writer)
+        {
+            previous_writer->_next_writer = _next_writer;
+        }
+        else
+        {
+            data.first_writer = _next_writer;
+        }
+
+        if(data.last_writer == this)
+        {
+            data.last_writer = previous_writer;
+        }
+
+        _next_writer = nullptr;
+        _queued = false;
+    }
+}
+
+void isram_writer::_update_queued()
+{
+    if(isram_writer* writer = data.first_writer)
+    {
+        writer->update(BN_CFG_SRAM_WRITER_TASK_BYTES);
+
+        // The task posts itself again until all queued writers are done:
+        if(data.first_writer)
+        {
+            core::post_idle_task(_update_queued, task_max_ticks);
+        }
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_task.h"
+
+#include "bn_timer.h"
+#include "bn_tasks_manager.h"
+
+namespace bn
+{
+
+bool task::promise_type::update()
+{
+    auto handle = std::coroutine_handle<promise_type>::from_promise(*this);
+    timer timer;
+
+    while(! handle.done())
+    {
+        handle.resume();
+
+        if(handle.done())
+        {
+            break;
+        }
+
+        if(_wait_next_frame || timer.elapsed_ticks() >= _max_ticks)
+        {
+            return false;
+        }
+    }
+
+    if(_running)
+    {
+        _running = false;
+        tasks_manager::remove(*this);
+    }
+
+    return true;
+}
+
+task::~task()
+{
+    if(_handle)
+    {
+        stop();
+        _handle.destroy();
+    }
+}
+
+void task::run(int max_ticks)
+{
+    BN_ASSERT(_handle, "Task is empty");
+    BN_ASSERT(max_ticks >= 0, "Invalid max ticks: ", max_ticks);
+
+    promise_type& promise = _handle.promise();
+    promise._max_ticks = max_ticks;
+
+    if(! promise._running && ! _handle.done())
+    {
+        promise._running = true;
+        tasks_manager::add(promise);
+    }
+}
+
+void task::stop()
+{
+    BN_ASSERT(_handle, "Task is empty");
+
+    promise_type& promise = _handle.promise();
+
+    if(promise._running)
+    {
+        promise._running = false;
+        tasks_manager::remove(promise);
+    }
+}
+
+bool task::update()
+{
+    BN_ASSERT(_handle, "Task is empty");
+
+    return _handle.promise().update();
+}
+
+}
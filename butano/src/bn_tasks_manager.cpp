@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tasks_manager.h"
+
+#include "bn_timer.h"
+#include "bn_vector.h"
+#include "bn_config_core.h"
+
+#include "bn_task.cpp.h"
+
+namespace bn::tasks_manager
+{
+
+namespace
+{
+    class static_data
+    {
+
+    public:
+        vector<task::promise_type*, BN_CFG_CORE_MAX_TASKS> promises;
+        bool updating = false;
+    };
+
+    BN_DATA_EWRAM static_data data;
+}
+
+void add(task::promise_type& promise)
+{
+    BN_ASSERT(! data.promises.full(), "No more tasks available");
+
+    data.promises.push_back(&promise);
+}
+
+void remove(task::promise_type& promise)
+{
+    for(task::promise_type*& promise_ptr : data.promises)
+    {
+        if(promise_ptr == &promise)
+        {
+            if(data.updating)
+            {
+                // Removed tasks are erased after the update, so indices remain valid:
+                promise_ptr = nullptr;
+            }
+            else
+            {
+                data.promises.erase(&promise_ptr);
+            }
+
+            return;
+        }
+    }
+}
+
+void update()
+{
+    data.updating = true;
+
+    // Tasks can run or stop other tasks, so size can change while iterating:
+    for(int index = 0; index < data.promises.size(); ++index)
+    {
+        if(task::promise_type* promise = data.promises[index])
+        {
+            promise->update();
+        }
+    }
+
+    data.updating = false;
+    erase(data.promises, nullptr);
+}
+
+}
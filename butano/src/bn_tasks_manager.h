@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TASKS_MANAGER_H
+#define BN_TASKS_MANAGER_H
+
+#include "bn_task.h"
+
+namespace bn::tasks_manager
+{
+    void add(task::promise_type& promise);
+
+    void remove(task::promise_type& promise);
+
+    void update();
+}
+
+#endif
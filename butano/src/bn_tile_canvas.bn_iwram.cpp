@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tile_canvas.h"
+
+#include "bn_tile.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[gnu::always_inline]] inline int _tile_index(int columns, int x, int y)
+    {
+        return ((y >> 3) * columns) + (x >> 3);
+    }
+
+    [[gnu::always_inline]] inline void _plot_4bpp(uint8_t* tiles_data, int columns, int x, int y, unsigned color)
+    {
+        uint8_t& pixels = tiles_data[(_tile_index(columns, x, y) * 32) + ((y & 7) * 4) + ((x & 7) >> 1)];
+
+        if(x & 1)
+        {
+            pixels = uint8_t((pixels & 0x0F) | (color << 4));
+        }
+        else
+        {
+            pixels = uint8_t((pixels & 0xF0) | color);
+        }
+    }
+
+    [[gnu::always_inline]] inline unsigned _texel_4bpp(const uint8_t* texture_data, int columns_shift,
+                                                        unsigned u, unsigned v)
+    {
+        unsigned pixels = texture_data[((v >> 3) << (columns_shift + 5)) + ((u >> 3) << 5) + ((v & 7) << 2) +
+                ((u & 7) >> 1)];
+        return (pixels >> ((u & 1) * 4)) & 0x0F;
+    }
+
+    [[gnu::always_inline]] inline unsigned _texel_8bpp(const uint8_t* texture_data, int columns_shift,
+                                                        unsigned u, unsigned v)
+    {
+        return texture_data[((v >> 3) << (columns_shift + 6)) + ((u >> 3) << 6) + ((v & 7) << 3) + (u & 7)];
+    }
+
+    [[gnu::always_inline]] inline void _plot_8bpp(uint8_t* tiles_data, int columns, int x, int y, unsigned color)
+    {
+        tiles_data[(_tile_index(columns, x, y) * 64) + ((y & 7) * 8) + (x & 7)] = uint8_t(color);
+    }
+}
+
+void tile_canvas::_plot(int x, int y, int color_index)
+{
+    auto tiles_data = reinterpret_cast<uint8_t*>(_tiles_ref.data());
+    int columns = _width >> 3;
+
+    if(_bpp == bpp_mode::BPP_4)
+    {
+        _plot_4bpp(tiles_data, columns, x, y, unsigned(color_index) & 0x0F);
+    }
+    else
+    {
+        _plot_8bpp(tiles_data, columns, x, y, unsigned(color_index) & 0xFF);
+    }
+
+    int tile_index = _tile_index(columns, x, y);
+    _first_dirty_tile = min(_first_dirty_tile, tile_index);
+    _last_dirty_tile = max(_last_dirty_tile, tile_index);
+}
+
+void tile_canvas::_draw_hline(int x, int y, int length, int color_index)
+{
+    auto tiles_data = reinterpret_cast<uint8_t*>(_tiles_ref.data());
+    int columns = _width >> 3;
+    int last_x = x + length;
+
+    if(_bpp == bpp_mode::BPP_4)
+    {
+        auto color = unsigned(color_index) & 0x0F;
+
+        for(int ix = x; ix < last_x; ++ix)
+        {
+            _plot_4bpp(tiles_data, columns, ix, y, color);
+        }
+    }
+    else
+    {
+        auto color = unsigned(color_index) & 0xFF;
+
+        for(int ix = x; ix < last_x; ++ix)
+        {
+            _plot_8bpp(tiles_data, columns, ix, y, color);
+        }
+    }
+
+    _first_dirty_tile = min(_first_dirty_tile, _tile_index(columns, x, y));
+    _last_dirty_tile = max(_last_dirty_tile, _tile_index(columns, last_x - 1, y));
+}
+
+void tile_canvas::_blit(const uint8_t* pixels_ptr, int pixels_pitch, int x, int y, int width, int height)
+{
+    auto tiles_data = reinterpret_cast<uint8_t*>(_tiles_ref.data());
+    int columns = _width >> 3;
+    int last_x = x + width;
+    int last_y = y + height;
+
+    // Color index 0 is transparent:
+    if(_bpp == bpp_mode::BPP_4)
+    {
+        for(int iy = y; iy < last_y; ++iy)
+        {
+            for(int ix = x, index = 0; ix < last_x; ++ix, ++index)
+            {
+                if(unsigned color = pixels_ptr[index] & 0x0F)
+                {
+                    _plot_4bpp(tiles_data, columns, ix, iy, color);
+                }
+            }
+
+            pixels_ptr += pixels_pitch;
+        }
+    }
+    else
+    {
+        for(int iy = y; iy < last_y; ++iy)
+        {
+            for(int ix = x, index = 0; ix < last_x; ++ix, ++index)
+            {
+                if(unsigned color = pixels_ptr[index])
+                {
+                    _plot_8bpp(tiles_data, columns, ix, iy, color);
+                }
+            }
+
+            pixels_ptr += pixels_pitch;
+        }
+    }
+
+    _first_dirty_tile = min(_first_dirty_tile, _tile_index(columns, x, y));
+    _last_dirty_tile = max(_last_dirty_tile, _tile_index(columns, last_x - 1, last_y - 1));
+}
+
+void tile_canvas::_draw_textured_hline(int x, int y, int length, const tile_canvas_texture& texture,
+                                       int u, int v, int du, int dv)
+{
+    auto tiles_data = reinterpret_cast<uint8_t*>(_tiles_ref.data());
+    auto texture_data = reinterpret_cast<const uint8_t*>(texture.tiles_ref().data());
+    int columns = _width >> 3;
+    int columns_shift = texture.columns_shift();
+    unsigned u_mask = unsigned(texture.width() - 1);
+    unsigned v_mask = unsigned(texture.height() - 1);
+    int first_tile = _tile_index(columns, x, y);
+    int last_x = x + length;
+
+    // Pixels are drawn in runs which don't cross tile boundaries,
+    // so the destination address is computed once per run instead of once per pixel:
+    if(_bpp == bpp_mode::BPP_4)
+    {
+        // A row of a 4BPP tile is a word, so each run is written with a single word store:
+        auto row_ptr = reinterpret_cast<uint32_t*>(tiles_data + (first_tile * 32) + ((y & 7) * 4));
+        int run_x = x & 7;
+        int pending_pixels = length;
+
+        while(pending_pixels)
+        {
+            int run_length = min(8 - run_x, pending_pixels);
+            int run_last_x = run_x + run_length;
+            unsigned pixels = 0;
+
+            for(int ix = run_x; ix < run_last_x; ++ix)
+            {
+                unsigned texel = _texel_4bpp(texture_data, columns_shift, unsigned(u >> 16) & u_mask,
+                                             unsigned(v >> 16) & v_mask);
+                pixels |= texel << (ix * 4);
+                u += du;
+                v += dv;
+            }
+
+            if(run_length == 8)
+            {
+                *row_ptr = pixels;
+            }
+            else
+            {
+                unsigned mask = (0xFFFFFFFF >> ((8 - run_length) * 4)) << (run_x * 4);
+                *row_ptr = (*row_ptr & ~mask) | pixels;
+            }
+
+            row_ptr += 8;
+            run_x = 0;
+            pending_pixels -= run_length;
+        }
+    }
+    else
+    {
+        uint8_t* row_ptr = tiles_data + (first_tile * 64) + ((y & 7) * 8);
+        int run_x = x & 7;
+        int pending_pixels = length;
+
+        while(pending_pixels)
+        {
+            int run_length = min(8 - run_x, pending_pixels);
+            int run_last_x = run_x + run_length;
+
+            for(int ix = run_x; ix < run_last_x; ++ix)
+            {
+                row_ptr[ix] = uint8_t(_texel_8bpp(texture_data, columns_shift, unsigned(u >> 16) & u_mask,
+                                                  unsigned(v >> 16) & v_mask));
+                u += du;
+                v += dv;
+            }
+
+            row_ptr += 64;
+            run_x = 0;
+            pending_pixels -= run_length;
+        }
+    }
+
+    _first_dirty_tile = min(_first_dirty_tile, first_tile);
+    _last_dirty_tile = max(_last_dirty_tile, _tile_index(columns, last_x - 1, y));
+}
+
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tile_canvas.h"
+
+#include "bn_tile.h"
+#include "bn_point.h"
+#include "bn_limits.h"
+#include "bn_memory.h"
+#include "bn_fixed_point.h"
+
+namespace bn
+{
+
+namespace
+{
+    [[nodiscard]] int _canvas_tiles_count(int width, int height, bpp_mode bpp)
+    {
+        BN_ASSERT(width > 0 && width % 8 == 0, "Invalid width: ", width);
+        BN_ASSERT(height > 0 && height % 8 == 0, "Invalid height: ", height);
+
+        int result = (width / 8) * (height / 8);
+        return bpp == bpp_mode::BPP_4 ? result : result * 2;
+    }
+
+    [[nodiscard]] constexpr int _texture_coord(fixed value)
+    {
+        // Texture coordinates are sampled with 16 bits of precision:
+        return value.data() << (16 - fixed::precision());
+    }
+
+    [[nodiscard]] int _edge_x(const point& a, const point& b, int y)
+    {
+        // Horizontal position of the edge in the given scanline, with 16 bits of precision:
+        int64_t dx = int64_t(b.x() - a.x()) << 16;
+        return (a.x() << 16) + int(dx * (y - a.y()) / (b.y() - a.y()));
+    }
+}
+
+tile_canvas::tile_canvas(const span<tile>& tiles_ref, int width, int height, bpp_mode bpp) :
+    _tiles(regular_bg_tiles_ptr::allocate(_canvas_tiles_count(width, height, bpp), bpp)),
+    _tiles_ref(tiles_ref),
+    _width(int16_t(width)),
+    _height(int16_t(height)),
+    _first_dirty_tile(0),
+    _last_dirty_tile(((width / 8) * (height / 8)) - 1),
+    _bpp(bpp)
+{
+    BN_ASSERT(tiles_ref.size() >= _tiles.tiles_count(), "Invalid tiles count: ",
+              tiles_ref.size(), " - ", _tiles.tiles_count());
+}
+
+void tile_canvas::fill(int color_index)
+{
+    unsigned color;
+
+    if(_bpp == bpp_mode::BPP_4)
+    {
+        color = (unsigned(color_index) & 0x0F) * 0x11111111;
+    }
+    else
+    {
+        color = (unsigned(color_index) & 0xFF) * 0x01010101;
+    }
+
+    int tiles_count = _tiles.tiles_count();
+    memory::set_words(color, tiles_count * int(sizeof(tile) / 4), _tiles_ref.data());
+    _first_dirty_tile = 0;
+    _last_dirty_tile = (columns() * rows()) - 1;
+}
+
+void tile_canvas::draw_hline(int x, int y, int length, int color_index)
+{
+    if(y < 0 || y >= _height)
+    {
+        return;
+    }
+
+    if(x < 0)
+    {
+        length += x;
+        x = 0;
+    }
+
+    length = min(length, _width - x);
+
+    if(length > 0)
+    {
+        _draw_hline(x, y, length, color_index);
+    }
+}
+
+void tile_canvas::blit(const span<const uint8_t>& pixels_ref, int pixels_width, int x, int y)
+{
+    BN_ASSERT(pixels_width > 0, "Invalid pixels width: ", pixels_width);
+    BN_ASSERT(pixels_ref.size() % pixels_width == 0, "Invalid pixels count: ",
+              pixels_ref.size(), " - ", pixels_width);
+
+    const uint8_t* pixels_ptr = pixels_ref.data();
+    int width = pixels_width;
+    int height = pixels_ref.size() / pixels_width;
+
+    if(x < 0)
+    {
+        pixels_ptr -= x;
+        width += x;
+        x = 0;
+    }
+
+    if(y < 0)
+    {
+        pixels_ptr -= y * pixels_width;
+        height += y;
+        y = 0;
+    }
+
+    width = min(width, _width - x);
+    height = min(height, _height - y);
+
+    if(width > 0 && height > 0)
+    {
+        _blit(pixels_ptr, pixels_width, x, y, width, height);
+    }
+}
+
+void tile_canvas::draw_textured_hline(int x, int y, int length, const tile_canvas_texture& texture,
+                                      const fixed_point& uv, const fixed_point& uv_delta)
+{
+    BN_ASSERT(texture.bpp() == _bpp, "Texture BPP mode mismatch: ", int(texture.bpp()), " - ", int(_bpp));
+
+    if(y < 0 || y >= _height)
+    {
+        return;
+    }
+
+    int u = _texture_coord(uv.x());
+    int v = _texture_coord(uv.y());
+    int du = _texture_coord(uv_delta.x());
+    int dv = _texture_coord(uv_delta.y());
+
+    if(x < 0)
+    {
+        u -= du * x;
+        v -= dv * x;
+        length += x;
+        x = 0;
+    }
+
+    length = min(length, _width - x);
+
+    if(length > 0)
+    {
+        _draw_textured_hline(x, y, length, texture, u, v, du, dv);
+    }
+}
+
+void tile_canvas::draw_textured_triangle(const point& p0, const point& p1, const point& p2,
+                                         const tile_canvas_texture& texture,
+                                         const fixed_point& uv0, const fixed_point& uv1, const fixed_point& uv2)
+{
+    BN_ASSERT(texture.bpp() == _bpp, "Texture BPP mode mismatch: ", int(texture.bpp()), " - ", int(_bpp));
+
+    int x10 = p1.x() - p0.x();
+    int y10 = p1.y() - p0.y();
+    int x20 = p2.x() - p0.x();
+    int y20 = p2.y() - p0.y();
+    int area = (x10 * y20) - (x20 * y10);
+
+    if(! area)
+    {
+        return;
+    }
+
+    // Texture coordinates gradients are constant in an affine mapping, so they are computed once per triangle:
+    int64_t u0 = _texture_coord(uv0.x());
+    int64_t v0 = _texture_coord(uv0.y());
+    int64_t u10 = _texture_coord(uv1.x()) - u0;
+    int64_t v10 = _texture_coord(uv1.y()) - v0;
+    int64_t u20 = _texture_coord(uv2.x()) - u0;
+    int64_t v20 = _texture_coord(uv2.y()) - v0;
+    int du_dx = int(((u10 * y20) - (u20 * y10)) / area);
+    int dv_dx = int(((v10 * y20) - (v20 * y10)) / area);
+    int du_dy = int(((u20 * x10) - (u10 * x20)) / area);
+    int dv_dy = int(((v20 * x10) - (v10 * x20)) / area);
+
+    // Vertices are sorted by their vertical position:
+    const point* top = &p0;
+    const point* middle = &p1;
+    const point* bottom = &p2;
+
+    if(middle->y() < top->y())
+    {
+        swap(top, middle);
+    }
+
+    if(bottom->y() < middle->y())
+    {
+        swap(middle, bottom);
+
+        if(middle->y() < top->y())
+        {
+            swap(top, middle);
+        }
+    }
+
+    int first_y = max(top->y(), 0);
+    int last_y = min(bottom->y(), int(_height));
+
+    for(int y = first_y; y < last_y; ++y)
+    {
+        int long_x = _edge_x(*top, *bottom, y);
+        int short_x = y < middle->y() ? _edge_x(*top, *middle, y) : _edge_x(*middle, *bottom, y);
+        int left_x = (min(long_x, short_x) + 0xFFFF) >> 16;
+        int right_x = min((max(long_x, short_x) + 0xFFFF) >> 16, int(_width));
+        int first_x = max(left_x, 0);
+
+        if(first_x < right_x)
+        {
+            int x_offset = first_x - p0.x();
+            int y_offset = y - p0.y();
+            int u = int(u0) + (du_dx * x_offset) + (du_dy * y_offset);
+            int v = int(v0) + (dv_dx * x_offset) + (dv_dy * y_offset);
+            _draw_textured_hline(first_x, y, right_x - first_x, texture, u, v, du_dx, dv_dx);
+        }
+    }
+}
+
+void tile_canvas::update()
+{
+    if(dirty())
+    {
+        // 8BPP tiles take two tile indexes:
+        int tile_size = _bpp == bpp_mode::BPP_4 ? 1 : 2;
+        int first_tile = _first_dirty_tile * tile_size;
+        int tiles_count = (_last_dirty_tile - _first_dirty_tile + 1) * tile_size;
+        _tiles.set_tiles_frame(first_tile, _tiles_ref.subspan(first_tile, tiles_count));
+        _first_dirty_tile = numeric_limits<int>::max();
+        _last_dirty_tile = -1;
+    }
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tile_collision_map.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int cell_shift = fixed::precision() + 3;
+}
+
+int tile_collision_map::_sweep_x(int left, int top, int right, int bottom, int delta,
+                                 unsigned solid_values_mask) const
+{
+    int first_y = top >> cell_shift;
+    int last_y = (bottom - 1) >> cell_shift;
+
+    if(delta > 0)
+    {
+        int last_x = (right + delta - 1) >> cell_shift;
+
+        for(int x = ((right - 1) >> cell_shift) + 1; x <= last_x; ++x)
+        {
+            for(int y = first_y; y <= last_y; ++y)
+            {
+                if(_solid(x, y, solid_values_mask))
+                {
+                    return (x << cell_shift) - right;
+                }
+            }
+        }
+    }
+    else if(delta < 0)
+    {
+        int last_x = (left + delta) >> cell_shift;
+
+        for(int x = (left >> cell_shift) - 1; x >= last_x; --x)
+        {
+            for(int y = first_y; y <= last_y; ++y)
+            {
+                if(_solid(x, y, solid_values_mask))
+                {
+                    return ((x + 1) << cell_shift) - left;
+                }
+            }
+        }
+    }
+
+    return delta;
+}
+
+int tile_collision_map::_sweep_y(int left, int top, int right, int bottom, int delta,
+                                 unsigned solid_values_mask) const
+{
+    int first_x = left >> cell_shift;
+    int last_x = (right - 1) >> cell_shift;
+
+    if(delta > 0)
+    {
+        int last_y = (bottom + delta - 1) >> cell_shift;
+
+        for(int y = ((bottom - 1) >> cell_shift) + 1; y <= last_y; ++y)
+        {
+            for(int x = first_x; x <= last_x; ++x)
+            {
+                if(_solid(x, y, solid_values_mask))
+                {
+                    return (y << cell_shift) - bottom;
+                }
+            }
+        }
+    }
+    else if(delta < 0)
+    {
+        int last_y = (top + delta) >> cell_shift;
+
+        for(int y = (top >> cell_shift) - 1; y >= last_y; --y)
+        {
+            for(int x = first_x; x <= last_x; ++x)
+            {
+                if(_solid(x, y, solid_values_mask))
+                {
+                    return ((y + 1) << cell_shift) - top;
+                }
+            }
+        }
+    }
+
+    return delta;
+}
+
+}
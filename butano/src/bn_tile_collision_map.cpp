@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_tile_collision_map.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int cell_shift = fixed::precision() + 3;
+    constexpr int cell_size = 1 << cell_shift;
+}
+
+tile_collision_map::tile_collision_map(const tile_collision_map_item& item, int outside_value) :
+    _item_ptr(&item),
+    _outside_value(outside_value)
+{
+    BN_ASSERT(outside_value >= 0 && outside_value < (1 << item.bits_per_cell()),
+              "Invalid outside value: ", outside_value, " - ", item.bits_per_cell());
+}
+
+fixed_point tile_collision_map::sweep(const fixed_rect& rect, const fixed_point& delta,
+                                      unsigned solid_values_mask) const
+{
+    int left = rect.left().data();
+    int top = rect.top().data();
+    int right = left + rect.width().data();
+    int bottom = top + rect.height().data();
+    int delta_x = _sweep_x(left, top, right, bottom, delta.x().data(), solid_values_mask);
+    int delta_y = _sweep_y(left + delta_x, top, right + delta_x, bottom, delta.y().data(), solid_values_mask);
+    return fixed_point(fixed::from_data(delta_x), fixed::from_data(delta_y));
+}
+
+optional<tile_collision_map::raycast_hit> tile_collision_map::raycast(
+        const fixed_point& origin, const fixed_point& end, unsigned solid_values_mask) const
+{
+    int origin_x = origin.x().data();
+    int origin_y = origin.y().data();
+    int end_x = end.x().data();
+    int end_y = end.y().data();
+    int x = origin_x >> cell_shift;
+    int y = origin_y >> cell_shift;
+
+    if(_solid(x, y, solid_values_mask))
+    {
+        return raycast_hit(origin, point(x, y), value(x, y));
+    }
+
+    // Cells are visited in the order the segment crosses them (Amanatides & Woo):
+    int step_x = end_x >= origin_x ? 1 : -1;
+    int step_y = end_y >= origin_y ? 1 : -1;
+    int64_t abs_delta_x = step_x > 0 ? end_x - origin_x : origin_x - end_x;
+    int64_t abs_delta_y = step_y > 0 ? end_y - origin_y : origin_y - end_y;
+    int64_t next_x = step_x > 0 ? ((x + 1) << cell_shift) - origin_x : origin_x - (x << cell_shift);
+    int64_t next_y = step_y > 0 ? ((y + 1) << cell_shift) - origin_y : origin_y - (y << cell_shift);
+    int end_cell_x = end_x >> cell_shift;
+    int end_cell_y = end_y >> cell_shift;
+    int steps = (end_cell_x - x) * step_x + (end_cell_y - y) * step_y;
+
+    for(int step = 0; step < steps; ++step)
+    {
+        bool cross_x = abs_delta_y == 0 || (abs_delta_x && next_x * abs_delta_y < next_y * abs_delta_x);
+        int64_t traveled_x;
+        int64_t traveled_y;
+
+        if(cross_x)
+        {
+            traveled_x = next_x;
+            traveled_y = (next_x * abs_delta_y) / abs_delta_x;
+            x += step_x;
+            next_x += cell_size;
+        }
+        else
+        {
+            traveled_x = abs_delta_x ? (next_y * abs_delta_x) / abs_delta_y : 0;
+            traveled_y = next_y;
+            y += step_y;
+            next_y += cell_size;
+        }
+
+        if(_solid(x, y, solid_values_mask))
+        {
+            fixed_point position(fixed::from_data(origin_x + int(traveled_x * step_x)),
+                                 fixed::from_data(origin_y + int(traveled_y * step_y)));
+            return raycast_hit(position, point(x, y), value(x, y));
+        }
+    }
+
+    return nullopt;
+}
+
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_timeline.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int progress_shift = 24;
+    constexpr int progress_one = 1 << progress_shift;
+}
+
+void itimeline::add_track(const span<const timeline_keyframe>& keyframes_ref, setter_type setter, void* target_ptr)
+{
+    BN_ASSERT(! _tracks.full(), "No more timeline tracks available");
+    BN_ASSERT(! keyframes_ref.empty(), "There are no keyframes");
+    BN_ASSERT(setter, "Setter is null");
+
+    for(int index = 1, limit = keyframes_ref.size(); index < limit; ++index)
+    {
+        BN_ASSERT(keyframes_ref[index - 1].frame() < keyframes_ref[index].frame(),
+                  "Keyframes are not sorted: ", index, " - ", keyframes_ref[index].frame());
+    }
+
+    track_type& track = _tracks.emplace_back();
+    track.keyframes_ref = keyframes_ref;
+    track.setter = setter;
+    track.target_ptr = target_ptr;
+    _duration_frames = max(_duration_frames, keyframes_ref.back().frame());
+    _start_track(track);
+}
+
+void itimeline::clear()
+{
+    _tracks.clear();
+    _frame = 0;
+    _duration_frames = 0;
+}
+
+void itimeline::reset()
+{
+    _frame = 0;
+
+    for(track_type& track : _tracks)
+    {
+        _start_track(track);
+    }
+}
+
+void itimeline::update()
+{
+    if(_frame >= _duration_frames)
+    {
+        if(_looping)
+        {
+            reset();
+        }
+
+        return;
+    }
+
+    ++_frame;
+
+    for(track_type& track : _tracks)
+    {
+        _update_track(track);
+    }
+}
+
+void itimeline::_start_track(track_type& track)
+{
+    const span<const timeline_keyframe>& keyframes_ref = track.keyframes_ref;
+    int keyframe_index = 0;
+
+    for(int limit = keyframes_ref.size() - 1; keyframe_index < limit; ++keyframe_index)
+    {
+        if(keyframes_ref[keyframe_index + 1].frame() > _frame)
+        {
+            break;
+        }
+    }
+
+    track.keyframe_index = keyframe_index;
+    _start_segment(track);
+    track.value = _value(track);
+    track.setter(track.target_ptr, track.value);
+}
+
+void itimeline::_update_track(track_type& track)
+{
+    const span<const timeline_keyframe>& keyframes_ref = track.keyframes_ref;
+    int keyframes_count = keyframes_ref.size();
+    int keyframe_index = track.keyframe_index;
+
+    if(keyframe_index + 1 >= keyframes_count)
+    {
+        return;
+    }
+
+    if(keyframes_ref[keyframe_index + 1].frame() <= _frame)
+    {
+        track.keyframe_index = keyframe_index + 1;
+        _start_segment(track);
+    }
+    else if(keyframes_ref[keyframe_index].frame() < _frame)
+    {
+        track.progress += track.progress_increment;
+    }
+
+    fixed value = _value(track);
+
+    if(value != track.value)
+    {
+        track.value = value;
+        track.setter(track.target_ptr, value);
+    }
+}
+
+void itimeline::_start_segment(track_type& track)
+{
+    const span<const timeline_keyframe>& keyframes_ref = track.keyframes_ref;
+    int keyframe_index = track.keyframe_index;
+
+    if(keyframe_index + 1 < keyframes_ref.size())
+    {
+        int first_frame = keyframes_ref[keyframe_index].frame();
+        int duration = keyframes_ref[keyframe_index + 1].frame() - first_frame;
+        track.progress_increment = progress_one / duration;
+        track.progress = track.progress_increment * max(_frame - first_frame, 0);
+    }
+    else
+    {
+        track.progress_increment = 0;
+        track.progress = 0;
+    }
+}
+
+fixed itimeline::_value(const track_type& track) const
+{
+    const span<const timeline_keyframe>& keyframes_ref = track.keyframes_ref;
+    int keyframe_index = track.keyframe_index;
+    const timeline_keyframe& first_keyframe = keyframes_ref[keyframe_index];
+
+    if(keyframe_index + 1 >= keyframes_ref.size())
+    {
+        return first_keyframe.value();
+    }
+
+    const timeline_keyframe& last_keyframe = keyframes_ref[keyframe_index + 1];
+    int progress = min(track.progress >> (progress_shift - fixed::precision()), fixed::scale());
+    fixed eased_progress = ease(last_keyframe.easing(), fixed::from_data(progress));
+    fixed delta = last_keyframe.value() - first_keyframe.value();
+    return first_keyframe.value() + delta.safe_multiplication(eased_progress);
+}
+
+}
@@ -5,7 +5,6 @@
 
 #include "bn_timer.h"
 
-#include "bn_limits.h"
 #include "../hw/include/bn_hw_timer.h"
 
 namespace bn
@@ -18,17 +17,8 @@ timer::timer() :
 
 int timer::elapsed_ticks() const
 {
-    unsigned ticks = hw::timer::ticks();
-
-    if(ticks < _last_ticks) [[unlikely]]
-    {
-        uint64_t overflow_result = ticks;
-        overflow_result += numeric_limits<unsigned>::max();
-        overflow_result -= _last_ticks;
-        return int(overflow_result);
-    }
-
-    return int(ticks - _last_ticks);
+    // Unsigned subtraction handles the 32-bit counter overflow:
+    return int(hw::timer::ticks() - _last_ticks);
 }
 
 void timer::restart()
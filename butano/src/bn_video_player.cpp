@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_video_player.h"
+
+#include "bn_memory.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_builder.h"
+#include "../hw/include/bn_hw_bg_blocks.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int map_columns = 32;
+    constexpr int map_rows = 32;
+
+    [[nodiscard]] int _tiles_per_slot(const video_item& item)
+    {
+        return item.palette_item().bpp() == bpp_mode::BPP_8 ? 2 : 1;
+    }
+
+    [[nodiscard]] regular_bg_tiles_ptr _create_tiles(const video_item& item)
+    {
+        // The first tile is left empty for the cells not covered by the video:
+        int tiles_count = item.tiles_count() * _tiles_per_slot(item);
+        regular_bg_tiles_ptr result = regular_bg_tiles_ptr::allocate(tiles_count, item.palette_item().bpp());
+        optional<span<tile>> tiles_vram = result.vram();
+        memory::clear(tiles_count, tiles_vram->data()[0]);
+        return result;
+    }
+
+    [[nodiscard]] regular_bg_map_ptr _create_map(const video_item& item, const regular_bg_tiles_ptr& tiles)
+    {
+        regular_bg_map_ptr result = regular_bg_map_ptr::allocate(
+                    size(map_columns, map_rows), tiles, item.palette_item().create_palette());
+        optional<span<regular_bg_map_cell>> cells_vram = result.vram();
+        uint16_t cells_offset = hw::bg_blocks::regular_map_cells_offset(
+                    unsigned(result.tiles_offset()), unsigned(result.palette_banks_offset()));
+        memory::set_half_words(cells_offset, map_columns * map_rows, cells_vram->data());
+        return result;
+    }
+}
+
+video_player::video_player(const video_item& item, int max_bytes_per_update) :
+    _item(item),
+    _tiles(_create_tiles(item)),
+    _maps{ _create_map(item, _tiles), _create_map(item, _tiles) },
+    _bg(regular_bg_builder(_maps[0]).release_build()),
+    _data_ptr(&item.frames_ref()),
+    _max_bytes_per_update(max_bytes_per_update)
+{
+    BN_ASSERT(max_bytes_per_update > 0, "Invalid max bytes per update: ", max_bytes_per_update);
+}
+
+void video_player::set_max_bytes_per_update(int max_bytes_per_update)
+{
+    BN_ASSERT(max_bytes_per_update > 0, "Invalid max bytes per update: ", max_bytes_per_update);
+
+    _max_bytes_per_update = max_bytes_per_update;
+}
+
+void video_player::set_elapsed_frames(int elapsed_frames)
+{
+    BN_ASSERT(elapsed_frames >= 0, "Invalid elapsed frames: ", elapsed_frames);
+
+    _elapsed_frames = elapsed_frames;
+}
+
+void video_player::update()
+{
+    if(! done() && _decode())
+    {
+        int frame = _shown_frames;
+
+        if(_elapsed_frames >= frame * _item.frame_duration())
+        {
+            // The map is shown in the next VBlank, so the other one can be written in the next update:
+            _bg.set_map(_maps[(frame + 1) % 2]);
+            _shown_frames = frame + 1;
+            _pending_runs = -1;
+        }
+    }
+
+    ++_elapsed_frames;
+}
+
+bool video_player::_decode()
+{
+    const uint32_t* data_ptr = _data_ptr;
+
+    if(_pending_runs < 0)
+    {
+        unsigned header = *data_ptr;
+        ++data_ptr;
+        _pending_tiles = int(header >> 16);
+        _pending_runs = int(header & 0xFFFF);
+    }
+
+    int tiles_per_slot = _tiles_per_slot(_item);
+    int remaining_bytes = _max_bytes_per_update;
+    bool first_element = true;
+
+    if(int pending_tiles = _pending_tiles)
+    {
+        // Tiles used by the frame shown on the screen are never overwritten:
+        tile* tiles_vram_data = _tiles.vram()->data();
+        int tile_bytes = int(sizeof(uint32_t) + (sizeof(tile) * unsigned(tiles_per_slot)));
+
+        while(pending_tiles && (first_element || remaining_bytes >= tile_bytes))
+        {
+            int slot = int(*data_ptr);
+            const tile& source_tile = *reinterpret_cast<const tile*>(data_ptr + 1);
+            memory::copy(source_tile, tiles_per_slot, tiles_vram_data[slot * tiles_per_slot]);
+            data_ptr += tile_bytes / int(sizeof(uint32_t));
+            remaining_bytes -= tile_bytes;
+            first_element = false;
+            --pending_tiles;
+        }
+
+        _pending_tiles = pending_tiles;
+
+        if(pending_tiles)
+        {
+            _data_ptr = data_ptr;
+            return false;
+        }
+    }
+
+    if(int pending_runs = _pending_runs)
+    {
+        // Cells are written in the map not visible on the screen:
+        regular_bg_map_ptr& map = _maps[(_shown_frames + 1) % 2];
+        regular_bg_map_cell* cells_vram_data = map.vram()->data();
+        unsigned cells_offset = hw::bg_blocks::regular_map_cells_offset(
+                    unsigned(map.tiles_offset()), unsigned(map.palette_banks_offset()));
+
+        while(pending_runs)
+        {
+            unsigned run_header = *data_ptr;
+            int cells_count = int(run_header & 0xFFFF);
+            int run_words = (cells_count + 1) / 2;
+            int run_bytes = int(sizeof(uint32_t)) * (run_words + 1);
+
+            if(! first_element && remaining_bytes < run_bytes)
+            {
+                break;
+            }
+
+            regular_bg_map_cell* cells_vram_ptr = cells_vram_data + (run_header >> 16);
+            auto source_cells_ptr = reinterpret_cast<const uint16_t*>(data_ptr + 1);
+
+            for(int index = 0; index < cells_count; ++index)
+            {
+                cells_vram_ptr[index] = regular_bg_map_cell(source_cells_ptr[index] + cells_offset);
+            }
+
+            data_ptr += run_words + 1;
+            remaining_bytes -= run_bytes;
+            first_element = false;
+            --pending_runs;
+        }
+
+        _pending_runs = pending_runs;
+    }
+
+    _data_ptr = data_ptr;
+    return ! _pending_runs;
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_vram_queue.h"
+
+#include "bn_alignment.h"
+#include "bn_vram_queue_manager.h"
+
+namespace bn::vram_queue
+{
+
+namespace
+{
+    [[nodiscard]] bool _valid_destination(uintptr_t first, uintptr_t last)
+    {
+        // VRAM, palette RAM and OAM:
+        return (first >= 0x06000000 && last <= 0x06018000) || (first >= 0x05000000 && last <= 0x05000400) ||
+                (first >= 0x07000000 && last <= 0x07000400);
+    }
+}
+
+int max_items()
+{
+    return vram_queue_manager::max_items();
+}
+
+int used_items_count()
+{
+    return vram_queue_manager::used_items_count();
+}
+
+int available_items_count()
+{
+    return vram_queue_manager::max_items() - vram_queue_manager::used_items_count();
+}
+
+bool full()
+{
+    return vram_queue_manager::used_items_count() == vram_queue_manager::max_items();
+}
+
+void push(const void* source_ptr, int bytes, void* destination_ptr, int priority)
+{
+    BN_ASSERT(source_ptr, "Source is null");
+    BN_ASSERT(aligned<2>(source_ptr), "Source is not aligned");
+    BN_ASSERT(bytes >= 0 && bytes % 2 == 0, "Invalid bytes: ", bytes);
+    BN_ASSERT(aligned<2>(static_cast<const void*>(destination_ptr)), "Destination is not aligned");
+    BN_ASSERT(_valid_destination(uintptr_t(destination_ptr), uintptr_t(destination_ptr) + unsigned(bytes)),
+              "Destination is not in VRAM, palette RAM nor OAM: ", destination_ptr, " - ", bytes);
+    BN_ASSERT(priority >= 0 && priority <= 3, "Invalid priority: ", priority);
+    BN_ASSERT(! full(), "No more VRAM queue items available");
+
+    if(bytes)
+    {
+        vram_queue_manager::push(source_ptr, bytes, destination_ptr, priority);
+    }
+}
+
+void clear()
+{
+    vram_queue_manager::clear();
+}
+
+}
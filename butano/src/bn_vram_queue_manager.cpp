@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_vram_queue_manager.h"
+
+#include "bn_vector.h"
+#include "bn_algorithm.h"
+#include "bn_alignment.h"
+#include "bn_config_vram_queue.h"
+#include "../hw/include/bn_hw_memory.h"
+
+#include "bn_vram_queue.cpp.h"
+
+namespace bn::vram_queue_manager
+{
+
+namespace
+{
+    static_assert(BN_CFG_VRAM_QUEUE_MAX_ITEMS > 0);
+    static_assert(BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES >= 0);
+
+
+    class item_type
+    {
+
+    public:
+        const void* source_ptr;
+        void* destination_ptr;
+        int bytes;
+        int priority;
+    };
+
+
+    class static_data
+    {
+
+    public:
+        vector<item_type, BN_CFG_VRAM_QUEUE_MAX_ITEMS> items;
+    };
+
+    BN_DATA_EWRAM static_data data;
+
+    void _commit_item(const item_type& item)
+    {
+        // Words are copied when possible, since they're twice as fast as half words:
+        const void* destination_ptr = item.destination_ptr;
+
+        if(aligned<4>(item.source_ptr) && aligned<4>(destination_ptr) && item.bytes % 4 == 0)
+        {
+            hw::memory::copy_words(item.source_ptr, item.bytes / 4, item.destination_ptr);
+        }
+        else
+        {
+            hw::memory::copy_half_words(item.source_ptr, item.bytes / 2, item.destination_ptr);
+        }
+    }
+}
+
+int max_items()
+{
+    return data.items.max_size();
+}
+
+int used_items_count()
+{
+    return data.items.size();
+}
+
+void push(const void* source_ptr, int bytes, void* destination_ptr, int priority)
+{
+    // Items are sorted by priority, and items with the same priority keep their queue order:
+    auto it = upper_bound(data.items.begin(), data.items.end(), priority, [](int value, const item_type& item)
+    {
+        return value < item.priority;
+    });
+
+    data.items.insert(it, item_type{ source_ptr, destination_ptr, bytes, priority });
+}
+
+void clear()
+{
+    data.items.clear();
+}
+
+int commit([[maybe_unused]] int engine_bytes)
+{
+    int result = 0;
+
+    if(! data.items.empty())
+    {
+        auto items_begin = data.items.begin();
+        auto items_end = data.items.end();
+        auto items_it = items_begin;
+
+        #if BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES
+            int available_bytes = BN_CFG_VRAM_QUEUE_MAX_COMMIT_BYTES - engine_bytes;
+
+            while(items_it != items_end)
+            {
+                const item_type& item = *items_it;
+
+                if(item.bytes > available_bytes && items_it != items_begin)
+                {
+                    break;
+                }
+
+                _commit_item(item);
+                available_bytes -= item.bytes;
+                result += item.bytes;
+                ++items_it;
+            }
+        #else
+            while(items_it != items_end)
+            {
+                const item_type& item = *items_it;
+                _commit_item(item);
+                result += item.bytes;
+                ++items_it;
+            }
+        #endif
+
+        data.items.erase(items_begin, items_it);
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_VRAM_QUEUE_MANAGER_H
+#define BN_VRAM_QUEUE_MANAGER_H
+
+#include "bn_common.h"
+
+namespace bn::vram_queue_manager
+{
+    [[nodiscard]] int max_items();
+
+    [[nodiscard]] int used_items_count();
+
+    void push(const void* source_ptr, int bytes, void* destination_ptr, int priority);
+
+    void clear();
+
+    [[nodiscard]] int commit(int engine_bytes);
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_window_shape.h"
+
+#include "bn_math.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int shift = fixed::precision();
+    constexpr int one = 1 << shift;
+    constexpr int half = one / 2;
+    constexpr int x_offset = fixed(display::width() / 2).data();
+    constexpr int y_offset = fixed(display::height() / 2).data();
+    constexpr int width = fixed(display::width()).data();
+}
+
+void window_shape::_rasterize_ellipse()
+{
+    // Radii precision is reduced to keep squared distances inside int range:
+    constexpr int reduced_shift = shift - 4;
+
+    int center_x = _center.x().data() + x_offset;
+    int center_y = _center.y().data() + y_offset;
+    int reduced_vertical_radius = _vertical_radius.data() >> reduced_shift;
+    int squared_vertical_radius = reduced_vertical_radius * reduced_vertical_radius;
+    int64_t scale = reduced_vertical_radius ?
+                (int64_t(_horizontal_radius.data()) << 16) / reduced_vertical_radius : 0;
+    pair<fixed, fixed>* boundaries = _boundaries;
+    bool empty = true;
+
+    // Lines are sampled at their centers:
+    for(int y = 0; y < display::height(); ++y)
+    {
+        int distance = ((y << shift) + half - center_y) >> reduced_shift;
+
+        if(distance > -reduced_vertical_radius && distance < reduced_vertical_radius)
+        {
+            int reduced_half_width = sqrt(squared_vertical_radius - (distance * distance));
+            int half_width = int((scale * reduced_half_width) >> 16);
+            boundaries[y] = make_pair(fixed::from_data(center_x - half_width),
+                                      fixed::from_data(center_x + half_width));
+            empty = false;
+        }
+        else
+        {
+            boundaries[y] = pair<fixed, fixed>();
+        }
+    }
+
+    _empty = empty;
+}
+
+void window_shape::_rasterize_polygon()
+{
+    pair<fixed, fixed>* boundaries = _boundaries;
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        boundaries[y] = make_pair(fixed::from_data(width), fixed());
+    }
+
+    const fixed_point* vertices = _vertices.data();
+    int vertices_count = _vertices.size();
+    const fixed_point& last_vertex = vertices[vertices_count - 1];
+    int x0 = last_vertex.x().data() + x_offset;
+    int y0 = last_vertex.y().data() + y_offset;
+
+    for(int index = 0; index < vertices_count; ++index)
+    {
+        const fixed_point& vertex = vertices[index];
+        int x1 = vertex.x().data() + x_offset;
+        int y1 = vertex.y().data() + y_offset;
+        _add_edge(x0, y0, x1, y1);
+        x0 = x1;
+        y0 = y1;
+    }
+
+    bool empty = true;
+
+    for(int y = 0; y < display::height(); ++y)
+    {
+        pair<fixed, fixed>& line_boundaries = boundaries[y];
+
+        if(line_boundaries.first < line_boundaries.second)
+        {
+            empty = false;
+        }
+        else
+        {
+            line_boundaries = pair<fixed, fixed>();
+        }
+    }
+
+    _empty = empty;
+}
+
+void window_shape::_add_edge(int x0, int y0, int x1, int y1)
+{
+    // Horizontal edges are covered by their adjacent ones:
+    if(y0 == y1)
+    {
+        return;
+    }
+
+    if(y0 > y1)
+    {
+        swap(x0, x1);
+        swap(y0, y1);
+    }
+
+    // Lines are sampled at their centers, and only if y0 <= center < y1, so shared vertices aren't sampled twice:
+    int first_y = (y0 - half + one - 1) >> shift;
+    int last_y = ((y1 - half + one - 1) >> shift) - 1;
+
+    if(first_y < 0)
+    {
+        first_y = 0;
+    }
+
+    if(last_y >= display::height())
+    {
+        last_y = display::height() - 1;
+    }
+
+    if(first_y > last_y)
+    {
+        return;
+    }
+
+    int64_t slope = (int64_t(x1 - x0) << shift) / (y1 - y0);
+    int64_t x = x0 + ((slope * ((first_y << shift) + half - y0)) >> shift);
+    pair<fixed, fixed>* boundaries = _boundaries;
+
+    for(int y = first_y; y <= last_y; ++y)
+    {
+        int line_x;
+
+        if(x < 0)
+        {
+            line_x = 0;
+        }
+        else if(x > width)
+        {
+            line_x = width;
+        }
+        else
+        {
+            line_x = int(x);
+        }
+
+        x += slope;
+
+        pair<fixed, fixed>& line_boundaries = boundaries[y];
+
+        if(line_x < line_boundaries.first.data())
+        {
+            line_boundaries.first = fixed::from_data(line_x);
+        }
+
+        if(line_x > line_boundaries.second.data())
+        {
+            line_boundaries.second = fixed::from_data(line_x);
+        }
+    }
+}
+
+}
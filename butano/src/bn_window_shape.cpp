@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_window_shape.h"
+
+#include "bn_memory.h"
+
+namespace bn
+{
+
+bool window_shape::clear()
+{
+    if(_kind == kind_type::NONE)
+    {
+        return false;
+    }
+
+    _clear();
+    return true;
+}
+
+bool window_shape::set_ellipse(const fixed_point& center, fixed horizontal_radius, fixed vertical_radius)
+{
+    BN_ASSERT(horizontal_radius >= 0, "Invalid horizontal radius: ", horizontal_radius);
+    BN_ASSERT(vertical_radius >= 0, "Invalid vertical radius: ", vertical_radius);
+
+    if(_kind == kind_type::ELLIPSE && _center == center && _horizontal_radius == horizontal_radius &&
+            _vertical_radius == vertical_radius)
+    {
+        return false;
+    }
+
+    _vertices.clear();
+    _center = center;
+    _horizontal_radius = horizontal_radius;
+    _vertical_radius = vertical_radius;
+    _kind = kind_type::ELLIPSE;
+    _rasterize_ellipse();
+    return true;
+}
+
+bool window_shape::set_polygon(const span<const fixed_point>& vertices)
+{
+    int vertices_count = vertices.size();
+    BN_ASSERT(vertices_count >= 3 && vertices_count <= max_polygon_vertices(),
+              "Invalid vertices count: ", vertices_count, " - ", max_polygon_vertices());
+
+    if(_kind == kind_type::POLYGON && _vertices.size() == vertices_count)
+    {
+        bool equal = true;
+
+        for(int index = 0; index < vertices_count; ++index)
+        {
+            if(_vertices[index] != vertices[index])
+            {
+                equal = false;
+                break;
+            }
+        }
+
+        if(equal)
+        {
+            return false;
+        }
+    }
+
+    _vertices.clear();
+
+    for(const fixed_point& vertex : vertices)
+    {
+        _vertices.push_back(vertex);
+    }
+
+    _kind = kind_type::POLYGON;
+    _rasterize_polygon();
+    return true;
+}
+
+void window_shape::_clear()
+{
+    memory::set_words(0, display::height() * 2, _boundaries);
+    _vertices.clear();
+    _kind = kind_type::NONE;
+    _empty = true;
+}
+
+}
@@ -3,6 +3,7 @@ Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
 zlib License, see LICENSE file.
 """
 
+import heapq
 import shutil
 import struct
 
@@ -49,6 +50,8 @@ class BMP:
             if bits_per_pixel != 4 and bits_per_pixel != 8:
                 raise ValueError('Invalid bits per pixel: ' + str(bits_per_pixel))
 
+            self.__bits_per_pixel = bits_per_pixel
+
             compression_method = read_int()
 
             if compression_method != 0:
@@ -79,6 +82,99 @@ class BMP:
 
             self.colors_count = colors_count
 
+    def tiles(self):
+        """
+        Returns the color indexes of each 8x8 tile, from left to right and from top to bottom.
+
+        Each tile is a tuple of 64 color indexes, from left to right and from top to bottom.
+        """
+
+        width = self.width
+        height = self.height
+
+        with open(self.__file_path, 'rb') as file:
+            file.seek(self.__pixels_offset)
+
+            if self.__bits_per_pixel == 4:
+                pixels = []
+
+                for pixels_byte in file.read(int((width * height) / 2)):  # no padding, multiple of 8.
+                    pixels.append(pixels_byte >> 4)
+                    pixels.append(pixels_byte & 15)
+            else:
+                pixels = list(file.read(width * height))
+
+        result = []
+
+        # BMP rows are stored from bottom to top:
+        for ty in range(0, height, 8):
+            for tx in range(0, width, 8):
+                tile = []
+
+                for y in range(ty, ty + 8):
+                    row = width * (height - y - 1)
+                    tile.extend(pixels[row + tx:row + tx + 8])
+
+                result.append(tuple(tile))
+
+        return result
+
+    def used_colors(self):
+        """
+        Returns a dictionary with the color of each used color index (index 0 is included even if it is not used).
+        """
+
+        with open(self.__file_path, 'rb') as file:
+            colors_count = int((self.__pixels_offset - self.__colors_offset) / 4)
+            file.seek(self.__colors_offset)
+            colors = struct.unpack(str(colors_count) + 'I', file.read(colors_count * 4))
+
+        result = {0: colors[0]}
+
+        for tile in self.tiles():
+            for pixel in tile:
+                if pixel not in result:
+                    if pixel >= colors_count:
+                        raise ValueError('Invalid color index: ' + str(pixel) + ' - ' + str(colors_count))
+
+                    result[pixel] = colors[pixel]
+
+        return result
+
+    def remap(self, output_file_path, colors, color_indexes_map):
+        """
+        Writes a copy of this file with the given colors at the beginning of the color table
+        and with the color indexes replaced using the given dictionary.
+        """
+
+        with open(self.__file_path, 'rb') as input_file:
+            file_content = bytearray(input_file.read())
+
+        colors_count = int((self.__pixels_offset - self.__colors_offset) / 4)
+
+        if len(colors) > colors_count:
+            raise ValueError('Not enough colors in color table: ' + str(colors_count) + ' - ' + str(len(colors)))
+
+        offset = self.__colors_offset
+
+        for color in colors:
+            file_content[offset:offset + 4] = struct.pack('I', color)
+            offset += 4
+
+        offset = self.__pixels_offset
+
+        if self.__bits_per_pixel == 4:
+            for index in range(offset, offset + int((self.width * self.height) / 2)):
+                pixels_byte = file_content[index]
+                file_content[index] = (color_indexes_map.get(pixels_byte >> 4, 0) << 4) | \
+                    color_indexes_map.get(pixels_byte & 15, 0)
+        else:
+            for index in range(offset, offset + (self.width * self.height)):
+                file_content[index] = color_indexes_map.get(file_content[index], 0)
+
+        with open(output_file_path, 'wb') as output_file:
+            output_file.write(file_content)
+
     def quantize(self, output_file_path):
         if self.colors_count == 16:
             shutil.copyfile(self.__file_path, output_file_path)
@@ -262,6 +358,232 @@ class BMP:
                     raise ValueError('No valid palette found for tile: ' + str(tx) + ' - ' + str(height - ty - 8))
 
         # Write output file:
+        self.__write_quantized(output_file_path, new_colors, new_pixels)
+        return tile_pixel_sets_count * 16
+
+    def quantize_lossy(self, output_file_path):
+        """
+        Like quantize, but if the image doesn't fit in 16 4BPP palettes,
+        the least used colors of each tile and of each palette are replaced with the nearest ones.
+
+        Returns the number of colors of the new palette and a tuple with the number of changed tiles,
+        the number of changed pixels and the maximum error of a color component of the changed pixels
+        (in GBA color units, from 0 to 31).
+        """
+
+        try:
+            return self.quantize(output_file_path), (0, 0, 0)
+        except ValueError:
+            pass
+
+        width = self.width
+        height = self.height
+        colors = self.__colors
+        pixels = self.__pixels
+        transparent_color = colors[0]
+        gba_colors = [((color >> 19) & 31, (color >> 11) & 31, (color >> 3) & 31) for color in colors]
+
+        def distance(pixel_a, pixel_b):
+            color_a = gba_colors[pixel_a]
+            color_b = gba_colors[pixel_b]
+            return sum((color_a[i] - color_b[i]) * (color_a[i] - color_b[i]) for i in range(3))
+
+        def error(pixel_a, pixel_b):
+            color_a = gba_colors[pixel_a]
+            color_b = gba_colors[pixel_b]
+            return max(abs(color_a[i] - color_b[i]) for i in range(3))
+
+        def reduce(pixel_counts, max_pixels):
+            # Least used colors are merged with the nearest ones:
+            while len(pixel_counts) > max_pixels:
+                removed_pixel = min(pixel_counts, key=lambda p: (pixel_counts[p], p))
+                removed_count = pixel_counts.pop(removed_pixel)
+                nearest_pixel = min(pixel_counts, key=lambda p: (distance(removed_pixel, p), p))
+                pixel_counts[nearest_pixel] += removed_count
+
+            return pixel_counts
+
+        # Identical colors are merged without loss:
+        color_pixels = {}
+        pixel_map = [0] * 256
+
+        for pixel in range(1, len(colors)):
+            color = colors[pixel]
+            pixel_map[pixel] = color_pixels.setdefault(color, pixel)
+
+        # Store used pixels count for all tiles:
+        tile_pixel_counts = []
+
+        for ty in range(0, height, 8):
+            for tx in range(0, width, 8):
+                pixel_counts = {}
+
+                for y in range(ty, ty + 8):
+                    row = width * y
+
+                    for x in range(tx, tx + 8):
+                        pixel = pixel_map[pixels[row + x]]
+
+                        if pixel > 0:
+                            if colors[pixel] == transparent_color:
+                                raise ValueError('There\'s an used color like the transparent one in: ' +
+                                                 str(pixel))
+
+                            pixel_counts[pixel] = pixel_counts.get(pixel, 0) + 1
+
+                tile_pixel_counts.append(pixel_counts)
+
+        # Merge pixel sets, smallest unions first, until there's no more than 16 palettes
+        # and no merge can be done without loss:
+        palettes = {}
+
+        for pixel_counts in tile_pixel_counts:
+            if len(pixel_counts) > 0:
+                new_palette = reduce(dict(pixel_counts), 15)
+                append = True
+
+                for palette in palettes.values():
+                    if new_palette.keys() <= palette.keys():
+                        for pixel, pixel_count in new_palette.items():
+                            palette[pixel] += pixel_count
+
+                        append = False
+                        break
+
+                if append:
+                    palettes[len(palettes)] = new_palette
+
+        palette_versions = {palette_id: 0 for palette_id in palettes}
+        merges = []
+
+        def push_merges(palette_id):
+            palette_set = palettes[palette_id].keys()
+            palette_version = palette_versions[palette_id]
+
+            for other_palette_id, other_palette in palettes.items():
+                if other_palette_id != palette_id:
+                    u_set_length = len(palette_set | other_palette.keys())
+                    other_palette_version = palette_versions[other_palette_id]
+
+                    if palette_id < other_palette_id:
+                        heapq.heappush(merges, (u_set_length, palette_id, other_palette_id, palette_version,
+                                                other_palette_version))
+                    else:
+                        heapq.heappush(merges, (u_set_length, other_palette_id, palette_id, other_palette_version,
+                                                palette_version))
+
+        for palette_id in palettes:
+            palette_set = palettes[palette_id].keys()
+
+            for other_palette_id in range(palette_id + 1, len(palettes)):
+                merges.append((len(palette_set | palettes[other_palette_id].keys()), palette_id, other_palette_id,
+                               0, 0))
+
+        heapq.heapify(merges)
+
+        while merges:
+            u_set_length, i, j, i_version, j_version = merges[0]
+
+            if i not in palettes or j not in palettes or palette_versions[i] != i_version or \
+                    palette_versions[j] != j_version:
+                heapq.heappop(merges)
+                continue
+
+            if u_set_length > 15 and len(palettes) <= 16:
+                break
+
+            heapq.heappop(merges)
+            merged_palette = palettes[i]
+
+            for pixel, pixel_count in palettes.pop(j).items():
+                merged_palette[pixel] = merged_palette.get(pixel, 0) + pixel_count
+
+            reduce(merged_palette, 15)
+            palette_versions[i] += 1
+            push_merges(i)
+
+        palettes = list(palettes.values())
+        palettes_count = len(palettes)
+
+        if palettes_count == 0:
+            shutil.copyfile(self.__file_path, output_file_path)
+            return 16, (0, 0, 0)
+
+        palette_pixel_lists = [sorted(palette.keys()) for palette in palettes]
+        new_colors = [transparent_color] * 256
+
+        for tpi in range(palettes_count):
+            ci = (tpi * 16) + 1
+
+            for palette_pixel in palette_pixel_lists[tpi]:
+                new_colors[ci] = colors[palette_pixel]
+                ci += 1
+
+        # Generate new pixels with the palette with less error for each tile:
+        new_pixels = list(pixels)
+        changed_tiles = 0
+        changed_pixels = 0
+        max_error = 0
+        tile_index = 0
+
+        for ty in range(0, height, 8):
+            for tx in range(0, width, 8):
+                pixel_counts = tile_pixel_counts[tile_index]
+                tile_index += 1
+                best_tpi = 0
+                best_nearest_pixels = {}
+
+                if len(pixel_counts) > 0:
+                    best_tile_error = None
+
+                    for tpi in range(palettes_count):
+                        palette_pixel_list = palette_pixel_lists[tpi]
+                        nearest_pixels = {}
+                        tile_error = 0
+
+                        for pixel, pixel_count in pixel_counts.items():
+                            nearest_pixel = min(palette_pixel_list, key=lambda p: (distance(pixel, p), p))
+                            nearest_pixels[pixel] = nearest_pixel
+                            tile_error += distance(pixel, nearest_pixel) * pixel_count
+
+                            if best_tile_error is not None and tile_error >= best_tile_error:
+                                break
+
+                        if best_tile_error is None or tile_error < best_tile_error:
+                            best_tpi = tpi
+                            best_nearest_pixels = nearest_pixels
+                            best_tile_error = tile_error
+
+                            if tile_error == 0:
+                                break
+
+                    if best_tile_error > 0:
+                        changed_tiles += 1
+
+                palette_pixel_list = palette_pixel_lists[best_tpi]
+
+                for y in range(ty, ty + 8):
+                    row = width * y
+
+                    for x in range(tx, tx + 8):
+                        pixel = pixel_map[pixels[row + x]]
+                        new_pixel = best_tpi * 16
+
+                        if pixel > 0:
+                            nearest_pixel = best_nearest_pixels[pixel]
+                            new_pixel += palette_pixel_list.index(nearest_pixel) + 1
+
+                            if nearest_pixel != pixel:
+                                changed_pixels += 1
+                                max_error = max(error(pixel, nearest_pixel), max_error)
+
+                        new_pixels[row + x] = new_pixel
+
+        # Write output file:
+        self.__write_quantized(output_file_path, new_colors, new_pixels)
+        return palettes_count * 16, (changed_tiles, changed_pixels, max_error)
+
+    def __write_quantized(self, output_file_path, new_colors, new_pixels):
         with open(self.__file_path, 'rb') as input_file:
             input_file_content = input_file.read()
             b = bytearray()
@@ -284,5 +606,3 @@ class BMP:
 
             with open(output_file_path, 'wb') as output_file:
                 output_file.write(input_file_content)
-
-        return tile_pixel_sets_count * 16
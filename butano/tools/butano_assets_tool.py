@@ -3,7 +3,7 @@ import sys
 import traceback
 
 from butano_audio_tool import process_audio
-from butano_graphics_tool import process_graphics
+from butano_graphics_tool import process_graphics, process_asset_registry
 
 
 if __name__ == "__main__":
@@ -15,7 +15,8 @@ if __name__ == "__main__":
     try:
         args = parser.parse_args()
         process_audio(args.audio, args.build)
-        process_graphics(args.graphics, args.build)
+        process_graphics(args.graphics, args.build)
+        process_asset_registry(args.graphics, args.build)
     except Exception as ex:
         sys.stderr.write('Error: ' + str(ex) + '\n')
         traceback.print_exc()
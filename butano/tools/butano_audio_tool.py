@@ -3,6 +3,7 @@ Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
 zlib License, see LICENSE file.
 """
 
+import json
 import os
 import subprocess
 import sys
@@ -15,6 +16,8 @@ def list_audio_files(audio_folder_paths):
     audio_file_names = []
     audio_file_names_no_ext = []
     audio_file_paths = []
+    dmg_sound_file_names_no_ext = []
+    dmg_sound_file_paths = []
 
     for audio_folder_path in audio_folder_path_list:
         folder_audio_file_names = sorted(os.listdir(audio_folder_path))
@@ -26,10 +29,17 @@ def list_audio_files(audio_folder_paths):
                 audio_file_name_split = os.path.splitext(audio_file_name)
                 audio_file_name_no_ext = audio_file_name_split[0]
                 audio_file_names.append(audio_file_name)
-                audio_file_names_no_ext.append(audio_file_name_no_ext)
-                audio_file_paths.append(audio_file_path)
 
-    return audio_file_names, audio_file_names_no_ext, audio_file_paths
+                # DMG sound effects are not processed by mmutil:
+                if audio_file_name_split[1] == '.json':
+                    dmg_sound_file_names_no_ext.append(audio_file_name_no_ext)
+                    dmg_sound_file_paths.append(audio_file_path)
+                else:
+                    audio_file_names_no_ext.append(audio_file_name_no_ext)
+                    audio_file_paths.append(audio_file_path)
+
+    return audio_file_names, audio_file_names_no_ext, audio_file_paths, dmg_sound_file_names_no_ext, \
+        dmg_sound_file_paths
 
 
 def process_audio_files(audio_file_paths, soundbank_bin_path, soundbank_header_path, build_folder_path):
@@ -161,11 +171,191 @@ def write_output_files(audio_file_names_no_ext, soundbank_header_path, build_fol
                            'sound_item', build_folder_path + '/bn_sound_items_info.h')
 
 
+class DmgSoundItem:
+
+    __channels = {
+        'square_1': 'SQUARE_1',
+        'square_2': 'SQUARE_2',
+        'wave': 'WAVE',
+        'noise': 'NOISE',
+    }
+
+    @staticmethod
+    def __read_int(step, field, default, min_value, max_value):
+        try:
+            value = int(step[field]) if field in step else default
+        except ValueError:
+            raise ValueError('Invalid ' + field + ' field: ' + str(step[field]))
+
+        if value is None:
+            raise ValueError(field + ' field not found')
+
+        if value < min_value or value > max_value:
+            raise ValueError('Invalid ' + field + ' field: ' + str(value) +
+                             ' (range is [' + str(min_value) + '..' + str(max_value) + '])')
+
+        return value
+
+    @staticmethod
+    def __read_bool(step, field, default):
+        value = step.get(field, default)
+
+        if not isinstance(value, bool):
+            raise ValueError('Invalid ' + field + ' field: ' + str(value))
+
+        return 'true' if value else 'false'
+
+    def __init__(self, file_path, file_name_no_ext):
+        self.__file_name_no_ext = file_name_no_ext
+
+        with open(file_path) as file:
+            try:
+                info = json.load(file)
+            except Exception as exception:
+                raise ValueError(file_path + ' DMG sound file parse failed: ' + str(exception))
+
+        try:
+            channel = str(info['channel'])
+        except KeyError:
+            raise ValueError('channel field not found in DMG sound file: ' + file_path)
+
+        if channel not in DmgSoundItem.__channels:
+            raise ValueError('Invalid channel field in DMG sound file: ' + file_path + ' (' + channel + ')')
+
+        self.__channel = channel
+
+        try:
+            steps = info['steps']
+        except KeyError:
+            raise ValueError('steps field not found in DMG sound file: ' + file_path)
+
+        if not isinstance(steps, list) or len(steps) == 0:
+            raise ValueError('Invalid steps field in DMG sound file: ' + file_path)
+
+        try:
+            self.__steps = [self.__build_step(step) for step in steps]
+        except ValueError as exc:
+            raise ValueError(file_path + ' DMG sound step error: ' + str(exc))
+
+        self.__wave_pattern = None
+
+        if channel == 'wave':
+            wave_pattern = info.get('wave_pattern')
+
+            if not isinstance(wave_pattern, list) or len(wave_pattern) != 32:
+                raise ValueError('Invalid wave_pattern field in DMG sound file: ' + file_path +
+                                 ' (32 samples in the range [0..15] required)')
+
+            for sample in wave_pattern:
+                if not isinstance(sample, int) or sample < 0 or sample > 15:
+                    raise ValueError('Invalid wave_pattern sample in DMG sound file: ' + file_path +
+                                     ' (' + str(sample) + ')')
+
+            self.__wave_pattern = [(wave_pattern[index] << 4) | wave_pattern[index + 1] for index in range(0, 32, 2)]
+        elif 'wave_pattern' in info:
+            raise ValueError('wave_pattern field is only allowed for the wave channel: ' + file_path)
+
+    def __build_step(self, step):
+        if not isinstance(step, dict):
+            raise ValueError('Invalid step: ' + str(step))
+
+        frames = str(DmgSoundItem.__read_int(step, 'frames', None, 1, 255))
+        restart = DmgSoundItem.__read_bool(step, 'restart', True)
+
+        if self.__channel == 'wave':
+            frequency = str(DmgSoundItem.__read_int(step, 'frequency', None, 32, 65536))
+            volume = str(DmgSoundItem.__read_int(step, 'volume', 4, 0, 4))
+            return 'dmg_sound_step::wave(' + ', '.join([frequency, volume, frames, restart]) + ')'
+
+        volume = str(DmgSoundItem.__read_int(step, 'volume', 15, 0, 15))
+        envelope_step_time = str(DmgSoundItem.__read_int(step, 'envelope_step_time', 0, 0, 7))
+        envelope_increase = DmgSoundItem.__read_bool(step, 'envelope_increase', False)
+
+        if self.__channel == 'noise':
+            divider = str(DmgSoundItem.__read_int(step, 'divider', None, 0, 7))
+            shift = str(DmgSoundItem.__read_int(step, 'shift', None, 0, 13))
+            seven_steps = DmgSoundItem.__read_bool(step, 'seven_steps', False)
+            return 'dmg_sound_step::noise(' + ', '.join([divider, shift, volume, frames, seven_steps,
+                                                         envelope_step_time, envelope_increase, restart]) + ')'
+
+        frequency = str(DmgSoundItem.__read_int(step, 'frequency', None, 64, 131072))
+        duty = str(DmgSoundItem.__read_int(step, 'duty', 2, 0, 3))
+        result = 'dmg_sound_step::square(' + ', '.join([frequency, volume, frames, duty, envelope_step_time,
+                                                         envelope_increase, restart]) + ')'
+
+        if self.__channel == 'square_1':
+            sweep_shift = str(DmgSoundItem.__read_int(step, 'sweep_shift', 0, 0, 7))
+            sweep_step_time = str(DmgSoundItem.__read_int(step, 'sweep_step_time', 0, 0, 7))
+            sweep_decrease = DmgSoundItem.__read_bool(step, 'sweep_decrease', False)
+
+            if sweep_step_time != '0':
+                result += '.with_sweep(' + ', '.join([sweep_shift, sweep_step_time, sweep_decrease]) + ')'
+        elif 'sweep_shift' in step or 'sweep_step_time' in step or 'sweep_decrease' in step:
+            raise ValueError('Sweep fields are only allowed for the square_1 channel')
+
+        return result
+
+    def write_header(self, build_folder_path):
+        name = self.__file_name_no_ext
+        name_upper = name.upper()
+        header_file_path = build_folder_path + '/bn_dmg_sound_items_' + name + '.h'
+
+        with open(header_file_path, 'w') as header_file:
+            header_file.write('#ifndef BN_DMG_SOUND_ITEMS_' + name_upper + '_H\n')
+            header_file.write('#define BN_DMG_SOUND_ITEMS_' + name_upper + '_H\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_dmg_sound_item.h"\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::dmg_sound_items\n')
+            header_file.write('{\n')
+            header_file.write('    constexpr inline dmg_sound_step ' + name + '_steps[] = {\n')
+
+            for step in self.__steps:
+                header_file.write('        ' + step + ',\n')
+
+            header_file.write('    };\n')
+            header_file.write('\n')
+
+            channel = 'dmg_sound_channel::' + DmgSoundItem.__channels[self.__channel]
+
+            if self.__wave_pattern is not None:
+                wave_pattern = ', '.join(['0x' + format(value, '02X') for value in self.__wave_pattern])
+                header_file.write('    constexpr inline uint8_t ' + name + '_wave_pattern[] = {\n')
+                header_file.write('        ' + wave_pattern + '\n')
+                header_file.write('    };\n')
+                header_file.write('\n')
+                header_file.write('    constexpr inline dmg_sound_item ' + name + '(' + channel + ', ' +
+                                  name + '_steps, ' + name + '_wave_pattern);\n')
+            else:
+                header_file.write('    constexpr inline dmg_sound_item ' + name + '(' + channel + ', ' +
+                                  name + '_steps);\n')
+
+            header_file.write('}\n')
+            header_file.write('\n')
+            header_file.write('#endif\n')
+            header_file.write('\n')
+
+        print('    dmg_sound_item file written in ' + header_file_path)
+        return len(self.__steps)
+
+
+def process_dmg_sound_files(dmg_sound_file_names_no_ext, dmg_sound_file_paths, build_folder_path):
+    total_steps = 0
+
+    for dmg_sound_file_name_no_ext, dmg_sound_file_path in zip(dmg_sound_file_names_no_ext, dmg_sound_file_paths):
+        dmg_sound_item = DmgSoundItem(dmg_sound_file_path, dmg_sound_file_name_no_ext)
+        total_steps += dmg_sound_item.write_header(build_folder_path)
+
+    return total_steps
+
+
 def process_audio(audio_folder_paths, build_folder_path):
-    audio_file_names, audio_file_names_no_ext, audio_file_paths = list_audio_files(audio_folder_paths)
+    audio_file_names, audio_file_names_no_ext, audio_file_paths, dmg_sound_file_names_no_ext, \
+        dmg_sound_file_paths = list_audio_files(audio_folder_paths)
     file_info_path = build_folder_path + '/_bn_audio_files_info.txt'
     old_file_info = FileInfo.read(file_info_path)
-    new_file_info = FileInfo.build_from_files(audio_file_paths)
+    new_file_info = FileInfo.build_from_files(audio_file_paths + dmg_sound_file_paths +
+                                              FileInfo.tool_file_paths(__file__))
 
     if old_file_info == new_file_info:
         return
@@ -180,5 +370,9 @@ def process_audio(audio_folder_paths, build_folder_path):
     total_size = process_audio_files(audio_file_paths, soundbank_bin_path, soundbank_header_path, build_folder_path)
     write_output_files(audio_file_names_no_ext, soundbank_header_path, build_folder_path)
     print('    Processed audio size: ' + str(total_size) + ' bytes')
+
+    if dmg_sound_file_paths:
+        total_steps = process_dmg_sound_files(dmg_sound_file_names_no_ext, dmg_sound_file_paths, build_folder_path)
+        print('    Processed DMG sound steps: ' + str(total_steps))
     os.remove(soundbank_header_path)
     new_file_info.write(file_info_path)
@@ -6,6 +6,7 @@ zlib License, see LICENSE file.
 import os
 import json
 import re
+import heapq
 import string
 import subprocess
 import sys
@@ -16,10 +17,43 @@ from file_info import FileInfo
 
 
 def validate_compression(compression):
-    if compression != 'none' and compression != 'lz77' and compression != 'run_length' and compression != 'auto':
+    if compression != 'none' and compression != 'lz77' and compression != 'run_length' and compression != 'lz4' and \
+            compression != 'huffman' and compression != 'lz77_huffman' and compression != 'auto':
         raise ValueError('Unknown compression: ' + str(compression))
 
 
+def validate_map_compression(compression):
+    if compression != 'chunked':
+        validate_compression(compression)
+
+
+def validate_tiles_deltas(graphics, tiles_compression):
+    if graphics < 2:
+        raise ValueError('Tiles deltas require more than one graphic: ' + str(graphics))
+
+    if tiles_compression != 'none':
+        raise ValueError('Tiles deltas require uncompressed tiles: ' + str(tiles_compression))
+
+
+def validate_repeated_graphics_reduction(tiles_compression, tiles_deltas):
+    if tiles_compression != 'none' and tiles_compression != 'auto':
+        raise ValueError('Repeated graphics reduction requires uncompressed tiles: ' + str(tiles_compression))
+
+    if tiles_deltas:
+        raise ValueError('Repeated graphics reduction and tiles deltas can\'t be enabled at the same time')
+
+
+def validate_quarter_rotations(width, height, tiles_compression, tiles_deltas):
+    if width != height:
+        raise ValueError('Quarter rotations require square sprites: ' + str(width) + 'x' + str(height))
+
+    if tiles_compression != 'none':
+        raise ValueError('Quarter rotations require uncompressed tiles: ' + str(tiles_compression))
+
+    if tiles_deltas:
+        raise ValueError('Quarter rotations and tiles deltas can\'t be enabled at the same time')
+
+
 def remove_file(file_path):
     if os.path.exists(file_path):
         os.remove(file_path)
@@ -35,9 +69,718 @@ def compression_label(compression):
     if compression == 'run_length':
         return 'compression_type::RUN_LENGTH'
 
+    if compression == 'chunked':
+        return 'compression_type::CHUNKED'
+
+    if compression == 'lz4':
+        return 'compression_type::LZ4'
+
+    if compression == 'huffman':
+        return 'compression_type::HUFFMAN'
+
+    if compression == 'lz77_huffman':
+        return 'compression_type::LZ77_HUFFMAN'
+
     raise ValueError('Unknown compression: ' + str(compression))
 
 
+# Rough estimations of the CPU cycles needed to decompress a byte with each compression type:
+decompression_cycles_per_byte = {'run_length': 6, 'lz4': 8, 'lz77': 12, 'huffman': 64}
+
+# CPU cycles per frame:
+frame_cycles = 280896
+
+
+def compression_report(grit_data, name, entries):
+    """
+    Returns the compression ratio and a rough estimation of the decompression cost of the given grit data.
+
+    Each entry is a tuple with the data name (Tiles, Pal or Map), its compression and its decompressed size in bytes.
+    Uncompressed and chunked data are not reported (chunks are decompressed on demand).
+    """
+
+    result = []
+
+    for data_name, compression, decompressed_size in entries:
+        if compression == 'none' or compression == 'chunked' or decompressed_size <= 0:
+            continue
+
+        match = re.search(name + '_bn_gfx' + data_name + r'Len ([0-9]+)', grit_data)
+
+        if match is None:
+            continue
+
+        compressed_size = int(match.group(1))
+
+        if compression == 'lz77_huffman':
+            # The size of the LZ77 compressed data is unknown, so the size of the final data is used instead:
+            cycles = (decompressed_size * decompression_cycles_per_byte['lz77']) + \
+                     (compressed_size * decompression_cycles_per_byte['huffman'])
+        else:
+            cycles = decompressed_size * decompression_cycles_per_byte[compression]
+
+        result.append(data_name + ': ' + compression + ', ' + str(decompressed_size) + ' -> ' +
+                      str(compressed_size) + ' bytes (' + str((compressed_size * 100) // decompressed_size) +
+                      '%), ~' + str(cycles) + ' decompression cycles (' + str((cycles * 100) // frame_cycles) +
+                      '% of a frame)')
+
+    return result
+
+
+def write_regular_bg_tiles_report(bmp, build_folder_path, name, bpp_8, repeated_tiles_reduction,
+                                   flipped_tiles_reduction, tiles_count):
+    """
+    Writes a report with the number of unique tiles of a regular BG and the VRAM blocks saved by removing the others.
+
+    Tiles are considered equal if they match with horizontal and/or vertical flips,
+    and with 4BPP tiles, if they match with another palette bank.
+    """
+
+    source_tiles = bmp.tiles()
+    repeated_tiles = set()
+    flipped_tiles = set()
+
+    for tile in source_tiles:
+        if not bpp_8:
+            # Palette bank is stored in the map cell, so tile pixels are compared without it:
+            tile = tuple(pixel & 15 for pixel in tile)
+
+        repeated_tiles.add(tile)
+
+        rows = [tile[index:index + 8] for index in range(0, 64, 8)]
+        horizontal_flip_tile = tuple(pixel for row in rows for pixel in reversed(row))
+        vertical_flip_tile = tuple(pixel for row in reversed(rows) for pixel in row)
+        both_flip_tile = tuple(reversed(tile))
+        flipped_tiles.add(min(tile, horizontal_flip_tile, vertical_flip_tile, both_flip_tile))
+
+    tile_size = 64 if bpp_8 else 32
+    block_size = 2048
+
+    def blocks(tiles):
+        return int(((tiles * tile_size) + block_size - 1) / block_size)
+
+    source_tiles_count = len(source_tiles)
+    source_blocks_count = blocks(source_tiles_count)
+    blocks_count = blocks(tiles_count)
+    report_file_path = build_folder_path + '/' + name + '_bn_tiles_report.txt'
+
+    with open(report_file_path, 'w') as report_file:
+        report_file.write('Regular BG: ' + name + ' (' + ('BPP_8' if bpp_8 else 'BPP_4') + ')' + '\n')
+        report_file.write('Source tiles: ' + str(source_tiles_count) + ' (' + str(source_blocks_count) +
+                          ' VRAM blocks)' + '\n')
+        report_file.write('Unique tiles: ' + str(len(repeated_tiles)) + ' (' + str(blocks(len(repeated_tiles))) +
+                          ' VRAM blocks)' + '\n')
+        report_file.write('Unique tiles with flips: ' + str(len(flipped_tiles)) + ' (' +
+                          str(blocks(len(flipped_tiles))) + ' VRAM blocks)' + '\n')
+        report_file.write('Repeated tiles reduction: ' + str(repeated_tiles_reduction).lower() + '\n')
+        report_file.write('Flipped tiles reduction: ' + str(flipped_tiles_reduction).lower() + '\n')
+        report_file.write('Generated tiles: ' + str(tiles_count) + ' (' + str(blocks_count) + ' VRAM blocks)' + '\n')
+        report_file.write('Saved VRAM blocks: ' + str(source_blocks_count - blocks_count) + '\n')
+
+        if not repeated_tiles_reduction or not flipped_tiles_reduction:
+            best_blocks_count = blocks(len(flipped_tiles))
+
+            if best_blocks_count < blocks_count:
+                report_file.write('VRAM blocks that could be saved with all tiles reductions enabled: ' +
+                                  str(blocks_count - best_blocks_count) + '\n')
+
+
+def lz77_compress(data):
+    result = bytearray([0x10, len(data) & 0xFF, (len(data) >> 8) & 0xFF, (len(data) >> 16) & 0xFF])
+    positions = {}
+    index = 0
+    data_size = len(data)
+
+    while index < data_size:
+        flags_index = len(result)
+        result.append(0)
+
+        for block in range(8):
+            if index >= data_size:
+                break
+
+            best_length = 0
+            best_displacement = 0
+
+            for position in reversed(positions.get(bytes(data[index:index + 3]), [])):
+                displacement = index - position
+
+                if displacement > 4096:
+                    break
+
+                length = 0
+
+                while length < 18 and index + length < data_size and data[position + length] == data[index + length]:
+                    length += 1
+
+                if length > best_length:
+                    best_length = length
+                    best_displacement = displacement
+
+                    if length == 18:
+                        break
+
+            if best_length >= 3:
+                result[flags_index] |= 0x80 >> block
+                result.append(((best_length - 3) << 4) | ((best_displacement - 1) >> 8))
+                result.append((best_displacement - 1) & 0xFF)
+            else:
+                best_length = 1
+                result.append(data[index])
+
+            for position in range(index, index + best_length):
+                positions.setdefault(bytes(data[position:position + 3]), []).append(position)
+
+            index += best_length
+
+    return result
+
+
+def huffman_compress_bits(data, data_bits):
+    """
+    Compresses the given data with GBA BIOS compatible Huffman codes of the given size in bits (4 or 8).
+
+    Returns None if the tree can't be stored, since the offset of each node to its children is limited to 6 bits.
+    """
+
+    if data_bits == 8:
+        symbols = list(data)
+    else:
+        symbols = [nibble for value in data for nibble in (value & 0xF, value >> 4)]
+
+    frequencies = [0] * (1 << data_bits)
+
+    for symbol in symbols:
+        frequencies[symbol] += 1
+
+    nodes = [(frequency, symbol, symbol) for symbol, frequency in enumerate(frequencies) if frequency]
+
+    for symbol, frequency in enumerate(frequencies):
+        if len(nodes) >= 2:
+            break
+
+        if not frequency:
+            nodes.append((0, symbol, symbol))
+
+    # Leaves are ints and internal nodes are (node0, node1) tuples:
+    heapq.heapify(nodes)
+    nodes_order = len(frequencies)
+
+    while len(nodes) > 1:
+        frequency_0, order_0, node_0 = heapq.heappop(nodes)
+        frequency_1, order_1, node_1 = heapq.heappop(nodes)
+        heapq.heappush(nodes, (frequency_0 + frequency_1, nodes_order, (node_0, node_1)))
+        nodes_order += 1
+
+    root = nodes[0][2]
+    codes = {}
+    pending_nodes = [(root, '')]
+
+    while pending_nodes:
+        node, code = pending_nodes.pop()
+
+        if isinstance(node, int):
+            codes[node] = code
+        else:
+            pending_nodes.append((node[0], code + '0'))
+            pending_nodes.append((node[1], code + '1'))
+
+    # Tree table nodes are stored breadth first, with the tree size (first byte) and the root node in the first pair:
+    tree = bytearray(2)
+    pending_nodes = [(root, 1)]
+    pending_node_index = 0
+
+    while pending_node_index < len(pending_nodes):
+        node, tree_index = pending_nodes[pending_node_index]
+        pending_node_index += 1
+        children_index = len(tree)
+        offset = (children_index - (tree_index & ~1) - 2) // 2
+
+        if offset > 63:
+            return None
+
+        tree.extend(bytes(2))
+
+        for child_index in range(2):
+            child = node[child_index]
+
+            if isinstance(child, int):
+                tree[children_index + child_index] = child
+                offset |= 0x80 >> child_index
+            else:
+                pending_nodes.append((child, children_index + child_index))
+
+        tree[tree_index] = offset
+
+    while len(tree) % 4:
+        tree.append(0)
+
+    tree[0] = (len(tree) // 2) - 1
+
+    result = bytearray([0x20 | data_bits, len(data) & 0xFF, (len(data) >> 8) & 0xFF, (len(data) >> 16) & 0xFF])
+    result.extend(tree)
+
+    # Bitstream is stored in 32bit units, starting with the most significant bit:
+    bits = ''.join(codes[symbol] for symbol in symbols)
+    bits += '0' * (-len(bits) % 32)
+
+    for bits_index in range(0, len(bits), 32):
+        result.extend(int(bits[bits_index:bits_index + 32], 2).to_bytes(4, 'little'))
+
+    return result
+
+
+def huffman_compress(data):
+    """
+    Compresses the given data with GBA BIOS compatible Huffman codes, using the smallest codes size (4 or 8 bits).
+    """
+
+    result = huffman_compress_bits(data, 4)
+    result_8 = huffman_compress_bits(data, 8)
+
+    if result_8 is not None and len(result_8) < len(result):
+        result = result_8
+
+    return result
+
+
+def lz4_compress(data):
+    """
+    Compresses the given data in LZ4 block sequences, after a GBA BIOS compatible header (type 4).
+
+    Matches are searched further back than with LZ77 (up to 65535 bytes), and they don't have a maximum length.
+    """
+
+    data_size = len(data)
+    result = bytearray([0x40, data_size & 0xFF, (data_size >> 8) & 0xFF, (data_size >> 16) & 0xFF])
+    positions = {}
+    literals_index = 0
+    index = 0
+
+    def append_length(length):
+        while length >= 255:
+            result.append(255)
+            length -= 255
+
+        result.append(length)
+
+    def append_sequence(literals_end, match_length, match_distance):
+        literals_count = literals_end - literals_index
+        token_index = len(result)
+        result.append(min(literals_count, 15) << 4)
+
+        if literals_count >= 15:
+            append_length(literals_count - 15)
+
+        result.extend(data[literals_index:literals_end])
+
+        if match_length:
+            result[token_index] |= min(match_length - 4, 15)
+            result.append(match_distance & 0xFF)
+            result.append(match_distance >> 8)
+
+            if match_length - 4 >= 15:
+                append_length(match_length - 4 - 15)
+
+    while index < data_size:
+        best_length = 0
+        best_distance = 0
+        candidates = positions.get(bytes(data[index:index + 4]), [])
+
+        for position in reversed(candidates[-256:]):
+            distance = index - position
+
+            if distance > 65535:
+                break
+
+            length = 0
+
+            while index + length < data_size and data[position + length] == data[index + length]:
+                length += 1
+
+            if length > best_length:
+                best_length = length
+                best_distance = distance
+
+                if index + length == data_size:
+                    break
+
+        if best_length >= 4:
+            append_sequence(index, best_length, best_distance)
+        else:
+            best_length = 1
+
+        for position in range(index, index + best_length):
+            positions.setdefault(bytes(data[position:position + 4]), []).append(position)
+
+        index += best_length
+
+        if best_length >= 4:
+            literals_index = index
+
+    if literals_index < data_size:
+        append_sequence(data_size, 0, 0)
+
+    return result
+
+
+def read_grit_data(asm_lines, data_line_index):
+    """
+    Returns the data generated by grit after the given line of its assembly file,
+    the size in bytes of its values and the index of the first line after it.
+    """
+
+    sizes = {'.byte': 1, '.hword': 2, '.word': 4}
+    data_end_line_index = data_line_index + 1
+    data = bytearray()
+    value_size = 4
+
+    while data_end_line_index < len(asm_lines):
+        asm_words = asm_lines[data_end_line_index].split(None, 1)
+
+        if len(asm_words) != 2 or asm_words[0] not in sizes:
+            break
+
+        value_size = sizes[asm_words[0]]
+
+        for value in asm_words[1].split(','):
+            data.extend(int(value.strip(), 0).to_bytes(value_size, 'little'))
+
+        data_end_line_index += 1
+
+    return data, value_size, data_end_line_index
+
+
+def compress_grit_data(build_folder_path, name, data_name, compress_function):
+    """
+    Compresses with the given function the given data generated by grit (Tiles, Pal or Map),
+    updating its size and the total size in the grit header file.
+
+    It allows to use compression types not supported by grit (like LZ4),
+    or to compress again the data compressed by grit (like LZ77 compressed data compressed again with Huffman).
+    """
+
+    asm_file_path = build_folder_path + '/' + name + '_bn_gfx.s'
+    header_file_path = build_folder_path + '/' + name + '_bn_gfx.h'
+    data_label = name + '_bn_gfx' + data_name + ':'
+
+    with open(asm_file_path, 'r') as asm_file:
+        asm_lines = asm_file.read().splitlines()
+
+    data_line_index = asm_lines.index(data_label)
+    data, value_size, data_end_line_index = read_grit_data(asm_lines, data_line_index)
+    compressed_data = compress_function(data)
+
+    while len(compressed_data) % 4:
+        compressed_data.append(0)
+
+    compressed_lines = []
+
+    for line_offset in range(0, len(compressed_data), 32):
+        line_data = compressed_data[line_offset:line_offset + 32]
+        line_words = [int.from_bytes(line_data[index:index + 4], 'little') for index in range(0, len(line_data), 4)]
+        compressed_lines.append('\t.word ' + ','.join('0x%08X' % line_word for line_word in line_words))
+
+    asm_lines[data_line_index + 1:data_end_line_index] = compressed_lines
+
+    with open(asm_file_path, 'w') as asm_file:
+        asm_file.write('\n'.join(asm_lines) + '\n')
+
+    with open(header_file_path, 'r') as header_file:
+        header_data = header_file.read()
+
+    size_difference = len(compressed_data) - len(data)
+    header_data = re.sub(data_name + r'Len ([0-9]+)', data_name + 'Len ' + str(len(compressed_data)), header_data)
+    header_data = re.sub(data_name + r'\[([0-9]+)]', data_name + '[' + str(len(compressed_data) // value_size) + ']',
+                         header_data)
+    header_data = re.sub(r'(Total size:.*= )([0-9]+)',
+                         lambda match: match.group(1) + str(int(match.group(2)) + size_difference), header_data)
+
+    with open(header_file_path, 'w') as header_file:
+        header_file.write(header_data)
+
+
+def tiles_deltas_words(tiles_data, graphics_count):
+    """
+    Returns the words of a bn::sprite_tiles_delta_item: the offset in words of the differences of each tile set
+    against the previous one, followed by the runs of changed words of each tile set.
+
+    Single unchanged words between changed ones are stored in the same run, since a new run would need a header word.
+    """
+
+    words = [int.from_bytes(tiles_data[index:index + 4], 'little') for index in range(0, len(tiles_data), 4)]
+    graphics_words = len(words) // graphics_count
+
+    if graphics_words > 0xFFFF:
+        raise ValueError('Too many tiles per graphic for tiles deltas: ' + str(graphics_words // 8))
+
+    result = [0] * graphics_count
+
+    for graphics_index in range(graphics_count):
+        previous_words = words[((graphics_index - 1) % graphics_count) * graphics_words:][:graphics_words]
+        current_words = words[graphics_index * graphics_words:][:graphics_words]
+        result[graphics_index] = len(result)
+        index = 0
+
+        while index < graphics_words:
+            if current_words[index] == previous_words[index]:
+                index += 1
+                continue
+
+            run_end = index + 1
+
+            while run_end < graphics_words:
+                if current_words[run_end] != previous_words[run_end]:
+                    run_end += 1
+                elif run_end + 1 < graphics_words and current_words[run_end + 1] != previous_words[run_end + 1]:
+                    run_end += 2
+                else:
+                    break
+
+            result.append((index << 16) | (run_end - index))
+            result.extend(current_words[index:run_end])
+            index = run_end
+
+        result.append(0)
+
+    return result
+
+
+def reduce_repeated_graphics(build_folder_path, name, graphics_count):
+    """
+    Removes the repeated tile sets of the tiles data generated by grit,
+    updating its size and the total size in the grit header file.
+
+    Returns the index of the stored tile set of each graphic, or None if there's no repeated tile sets.
+    """
+
+    graphics_indexes = []
+
+    def reduce_function(data):
+        graphics_size = len(data) // graphics_count
+        graphics_datas = [bytes(data[index:index + graphics_size]) for index in range(0, len(data), graphics_size)]
+        stored_graphics_indexes = {}
+        result = bytearray()
+
+        for graphics_data in graphics_datas:
+            graphics_index = stored_graphics_indexes.get(graphics_data)
+
+            if graphics_index is None:
+                graphics_index = len(stored_graphics_indexes)
+                stored_graphics_indexes[graphics_data] = graphics_index
+                result.extend(graphics_data)
+
+            graphics_indexes.append(graphics_index)
+
+        return result
+
+    compress_grit_data(build_folder_path, name, 'Tiles', reduce_function)
+
+    if max(graphics_indexes) + 1 == graphics_count:
+        return None
+
+    return graphics_indexes
+
+
+def add_quarter_rotated_graphics(build_folder_path, name, graphics_count, size, bpp_8):
+    """
+    Appends to the tiles data generated by grit its tile sets rotated 90 degrees counterclockwise,
+    updating its size and the total size in the grit header file.
+
+    Tile sets of square sprites of the given size in pixels are expected.
+    """
+
+    size_tiles = size // 8
+    tile_size = 64 if bpp_8 else 32
+
+    def pixel_location(x, y):
+        tile_offset = (((y // 8) * size_tiles) + (x // 8)) * tile_size
+
+        if bpp_8:
+            return tile_offset + ((y % 8) * 8) + (x % 8), 0
+
+        return tile_offset + ((y % 8) * 4) + ((x % 8) // 2), (x % 2) * 4
+
+    def rotate_function(data):
+        graphics_size = len(data) // graphics_count
+        result = bytearray(data)
+
+        for graphics_offset in range(0, len(data), graphics_size):
+            graphics_data = data[graphics_offset:graphics_offset + graphics_size]
+            rotated_data = bytearray(graphics_size)
+
+            # Pixel (x, y) of a rotated tile set is the pixel (size - 1 - y, x) of the original one:
+            for y in range(size):
+                for x in range(size):
+                    source_index, source_shift = pixel_location(size - 1 - y, x)
+                    destination_index, destination_shift = pixel_location(x, y)
+                    value = graphics_data[source_index] if bpp_8 else (graphics_data[source_index] >> source_shift) & 15
+                    rotated_data[destination_index] |= value << destination_shift
+
+            result.extend(rotated_data)
+
+        return result
+
+    compress_grit_data(build_folder_path, name, 'Tiles', rotate_function)
+
+
+def write_graphics_indexes(header_file, name, graphics_indexes):
+    """
+    Writes to the given header file the index of the stored tile set of each graphic.
+
+    Returns the size in bytes of the written indexes.
+    """
+
+    header_file.write('    alignas(int) constexpr inline uint16_t ' + name + '_bn_gfxGraphicsIndexes[] = {' + '\n')
+
+    for index in range(0, len(graphics_indexes), 16):
+        header_file.write('        ' + ', '.join(str(graphics_index) for graphics_index in
+                                                 graphics_indexes[index:index + 16]) + ',' + '\n')
+
+    header_file.write('    };' + '\n')
+    header_file.write('\n')
+    return len(graphics_indexes) * 2
+
+
+def write_sprite_tiles_delta_item(header_file, build_folder_path, name, graphics_count):
+    """
+    Writes to the given header file a bn::sprite_tiles_delta_item with the differences between each tile set
+    generated by grit and the previous one.
+
+    Returns the size in bytes of the written differences.
+    """
+
+    with open(build_folder_path + '/' + name + '_bn_gfx.s', 'r') as asm_file:
+        asm_lines = asm_file.read().splitlines()
+
+    tiles_data = read_grit_data(asm_lines, asm_lines.index(name + '_bn_gfxTiles:'))[0]
+    words = tiles_deltas_words(tiles_data, graphics_count)
+
+    header_file.write('\n')
+    header_file.write('    alignas(int) constexpr inline uint32_t ' + name + '_bn_gfxTilesDeltas[] = {' + '\n')
+
+    for index in range(0, len(words), 8):
+        header_file.write('        ' + ', '.join('0x%08X' % word for word in words[index:index + 8]) + ',' + '\n')
+
+    header_file.write('    };' + '\n')
+    header_file.write('\n')
+    header_file.write('    constexpr inline sprite_tiles_delta_item ' + name + '_tiles_delta(' + name +
+                      '_bn_gfxTilesDeltas[0], ' + str(graphics_count) + ');' + '\n')
+    return len(words) * 4
+
+
+def run_length_compress(data):
+    result = bytearray([0x30, len(data) & 0xFF, (len(data) >> 8) & 0xFF, (len(data) >> 16) & 0xFF])
+    raw_data = bytearray()
+    index = 0
+    data_size = len(data)
+
+    def flush_raw_data():
+        while len(raw_data):
+            raw_block = raw_data[:128]
+            result.append(len(raw_block) - 1)
+            result.extend(raw_block)
+            del raw_data[:128]
+
+    while index < data_size:
+        length = 1
+
+        while length < 130 and index + length < data_size and data[index + length] == data[index]:
+            length += 1
+
+        if length >= 3:
+            flush_raw_data()
+            result.append(0x80 | (length - 3))
+            result.append(data[index])
+            index += length
+        else:
+            raw_data.append(data[index])
+            index += 1
+
+    flush_raw_data()
+    return result
+
+
+def write_chunked_map(build_folder_path, name, cell_size, width, height):
+    """
+    Splits the map generated by grit in 32x32 cells chunks, each one compressed on its own.
+
+    The map data starts with the offsets in bytes of each chunk (an uint32 per chunk),
+    followed by the GBA BIOS compatible LZ77 or run-length compressed chunks (or the LZ4 compressed ones
+    if they are smaller), so each chunk can be decompressed without decompressing the previous ones.
+    """
+
+    if width % 32 != 0 or height % 32 != 0:
+        raise ValueError('Chunked maps dimensions must be divisible by 256: ' + str(width * 8) + ' - ' +
+                         str(height * 8))
+
+    asm_file_path = build_folder_path + '/' + name + '_bn_gfx.s'
+    map_label = name + '_bn_gfxMap:'
+    sizes = {'.byte': 1, '.hword': 2, '.word': 4}
+
+    with open(asm_file_path, 'r') as asm_file:
+        asm_lines = asm_file.read().splitlines()
+
+    map_line_index = asm_lines.index(map_label)
+    map_end_line_index = map_line_index + 1
+    map_data = bytearray()
+
+    while map_end_line_index < len(asm_lines):
+        asm_words = asm_lines[map_end_line_index].split(None, 1)
+
+        if len(asm_words) != 2 or asm_words[0] not in sizes:
+            break
+
+        value_size = sizes[asm_words[0]]
+
+        for value in asm_words[1].split(','):
+            map_data.extend(int(value.strip(), 0).to_bytes(value_size, 'little'))
+
+        map_end_line_index += 1
+
+    chunks_x = width // 32
+    chunks_y = height // 32
+    row_size = 32 * cell_size
+    chunked_data = bytearray((chunks_x * chunks_y) * 4)
+
+    for chunk_y in range(chunks_y):
+        for chunk_x in range(chunks_x):
+            chunk_data = bytearray()
+
+            for row in range(32):
+                row_offset = ((((chunk_y * 32) + row) * width) + (chunk_x * 32)) * cell_size
+                chunk_data.extend(map_data[row_offset:row_offset + row_size])
+
+            lz77_data = lz77_compress(chunk_data)
+            lz4_data = lz4_compress(chunk_data)
+            run_length_data = run_length_compress(chunk_data)
+            compressed_data = lz4_data if len(lz4_data) <= len(lz77_data) else lz77_data
+
+            if len(run_length_data) < len(compressed_data):
+                compressed_data = run_length_data
+
+            chunk_offset = (chunk_y * chunks_x) + chunk_x
+            chunked_data[chunk_offset * 4:(chunk_offset + 1) * 4] = len(chunked_data).to_bytes(4, 'little')
+            chunked_data.extend(compressed_data)
+
+            while len(chunked_data) % 4:
+                chunked_data.append(0)
+
+    chunked_lines = []
+
+    for line_offset in range(0, len(chunked_data), 32):
+        line_data = chunked_data[line_offset:line_offset + 32]
+        line_words = [int.from_bytes(line_data[index:index + 4], 'little') for index in range(0, len(line_data), 4)]
+        chunked_lines.append('\t.word ' + ','.join('0x%08X' % line_word for line_word in line_words))
+
+    asm_lines[map_line_index + 1:map_end_line_index] = chunked_lines
+
+    with open(asm_file_path, 'w') as asm_file:
+        asm_file.write('\n'.join(asm_lines) + '\n')
+
+    return len(chunked_data)
+
+
 class SpriteItem:
 
     @staticmethod
@@ -135,6 +878,32 @@ class SpriteItem:
             except KeyError:
                 self.__palette_compression = 'none'
 
+        try:
+            self.__tiles_deltas = bool(info['tiles_deltas'])
+        except KeyError:
+            self.__tiles_deltas = False
+
+        if self.__tiles_deltas:
+            validate_tiles_deltas(self.__graphics, self.__tiles_compression)
+
+        try:
+            self.__repeated_graphics_reduction = bool(info['repeated_graphics_reduction'])
+        except KeyError:
+            self.__repeated_graphics_reduction = False
+
+        if self.__repeated_graphics_reduction:
+            validate_repeated_graphics_reduction(self.__tiles_compression, self.__tiles_deltas)
+
+        try:
+            self.__quarter_rotations = bool(info['quarter_rotations'])
+        except KeyError:
+            self.__quarter_rotations = False
+
+        if self.__quarter_rotations:
+            validate_quarter_rotations(bmp.width, height, self.__tiles_compression, self.__tiles_deltas)
+            self.__sprite_width = bmp.width
+            self.__graphics *= 2
+
     def process(self):
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
@@ -142,17 +911,22 @@ class SpriteItem:
         if tiles_compression == 'auto':
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'none', None)
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'run_length', file_size)
+            tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'lz4', file_size)
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'lz77', file_size)
 
         if palette_compression == 'auto':
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'none', None)
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'run_length',
                                                                              file_size)
+            palette_compression, file_size = self.__test_palette_compression(palette_compression, 'lz4', file_size)
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'lz77', file_size)
 
         self.__execute_command(tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
 
+    def compression_report(self):
+        return self.__compression_report
+
     def __test_tiles_compression(self, best_tiles_compression, new_tiles_compression, best_file_size):
         self.__execute_command(new_tiles_compression, 'none')
         new_file_size = self.__write_header(new_tiles_compression, 'none', True)
@@ -200,6 +974,14 @@ class SpriteItem:
 
         remove_file(grit_file_path)
 
+        if self.__quarter_rotations:
+            tiles_count *= 2
+
+        graphics_indexes = self.__graphics_indexes
+
+        if graphics_indexes is not None:
+            tiles_count = (tiles_count // self.__graphics) * (max(graphics_indexes) + 1)
+
         if self.__colors_count == 16:
             bpp_mode_label = 'bpp_mode::BPP_4'
         else:
@@ -215,24 +997,45 @@ class SpriteItem:
             header_file.write('#define ' + include_guard + '\n')
             header_file.write('\n')
             header_file.write('#include "bn_sprite_item.h"' + '\n')
+
+            if self.__tiles_deltas:
+                header_file.write('#include "bn_sprite_tiles_delta_item.h"' + '\n')
+
             header_file.write(grit_data)
             header_file.write('\n')
             header_file.write('namespace bn::sprite_items' + '\n')
             header_file.write('{' + '\n')
+
+            if graphics_indexes is None:
+                graphics_label = compression_label(tiles_compression) + ', ' + str(self.__graphics)
+            else:
+                total_size += write_graphics_indexes(header_file, name, graphics_indexes)
+                graphics_label = 'span<const uint16_t>(' + name + '_bn_gfxGraphicsIndexes, ' + \
+                                 str(self.__graphics) + ')'
+
             header_file.write('    constexpr inline sprite_item ' + name + '(' +
                               'sprite_shape_size(sprite_shape::' + self.__shape + ', ' +
                               'sprite_size::' + self.__size + '), ' + '\n            ' +
                               'sprite_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' +
-                              str(tiles_count) + '), ' + bpp_mode_label + ', ' + compression_label(tiles_compression) +
-                              ', ' + str(self.__graphics) + '), ' + '\n            ' +
+                              str(tiles_count) + '), ' + bpp_mode_label + ', ' + graphics_label + '), ' +
+                              '\n            ' +
                               'sprite_palette_item(span<const color>(' + name + '_bn_gfxPal, ' +
                               str(self.__colors_count) + '), ' + bpp_mode_label + ', ' +
                               compression_label(palette_compression) + '));\n')
+
+            if self.__tiles_deltas:
+                total_size += write_sprite_tiles_delta_item(header_file, self.__build_folder_path, name,
+                                                            self.__graphics)
+
             header_file.write('}' + '\n')
             header_file.write('\n')
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        self.__compression_report = compression_report(grit_data, name, [
+            ('Tiles', tiles_compression, tiles_count * 32),
+            ('Pal', palette_compression, self.__colors_count * 2)])
+
         return total_size, header_file_path
 
     def __execute_command(self, tiles_compression, palette_compression):
@@ -243,12 +1046,12 @@ class SpriteItem:
         else:
             command.append('-gB8')
 
-        if tiles_compression == 'lz77':
+        if tiles_compression == 'lz77' or tiles_compression == 'lz77_huffman':
             command.append('-gzl')
         elif tiles_compression == 'run_length':
             command.append('-gzr')
 
-        if palette_compression == 'lz77':
+        if palette_compression == 'lz77' or palette_compression == 'lz77_huffman':
             command.append('-pzl')
         elif palette_compression == 'run_length':
             command.append('-pzr')
@@ -261,6 +1064,26 @@ class SpriteItem:
         except subprocess.CalledProcessError as e:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        self.__graphics_indexes = None
+
+        if self.__quarter_rotations:
+            add_quarter_rotated_graphics(self.__build_folder_path, self.__file_name_no_ext, self.__graphics // 2,
+                                         self.__sprite_width, self.__colors_count != 16)
+
+        if tiles_compression == 'none' and self.__repeated_graphics_reduction and self.__graphics > 1:
+            self.__graphics_indexes = reduce_repeated_graphics(self.__build_folder_path, self.__file_name_no_ext,
+                                                               self.__graphics)
+
+        if tiles_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', lz4_compress)
+        elif tiles_compression == 'huffman' or tiles_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', huffman_compress)
+
+        if palette_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', lz4_compress)
+        elif palette_compression == 'huffman' or palette_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', huffman_compress)
+
 
 class SpriteTilesItem:
 
@@ -292,17 +1115,47 @@ class SpriteTilesItem:
         except KeyError:
             self.__compression = 'none'
 
+        try:
+            self.__tiles_deltas = bool(info['tiles_deltas'])
+        except KeyError:
+            self.__tiles_deltas = False
+
+        if self.__tiles_deltas:
+            validate_tiles_deltas(self.__graphics, self.__compression)
+
+        try:
+            self.__repeated_graphics_reduction = bool(info['repeated_graphics_reduction'])
+        except KeyError:
+            self.__repeated_graphics_reduction = False
+
+        if self.__repeated_graphics_reduction:
+            validate_repeated_graphics_reduction(self.__compression, self.__tiles_deltas)
+
+        try:
+            self.__quarter_rotations = bool(info['quarter_rotations'])
+        except KeyError:
+            self.__quarter_rotations = False
+
+        if self.__quarter_rotations:
+            validate_quarter_rotations(bmp.width, height, self.__compression, self.__tiles_deltas)
+            self.__sprite_width = bmp.width
+            self.__graphics *= 2
+
     def process(self):
         compression = self.__compression
 
         if compression == 'auto':
             compression, file_size = self.__test_compression(compression, 'none', None)
             compression, file_size = self.__test_compression(compression, 'run_length', file_size)
+            compression, file_size = self.__test_compression(compression, 'lz4', file_size)
             compression, file_size = self.__test_compression(compression, 'lz77', file_size)
 
         self.__execute_command(compression)
         return self.__write_header(compression, False)
 
+    def compression_report(self):
+        return self.__compression_report
+
     def __test_compression(self, best_compression, new_compression, best_file_size):
         self.__execute_command(new_compression)
         new_file_size = self.__write_header(new_compression, True)
@@ -340,6 +1193,14 @@ class SpriteTilesItem:
 
         remove_file(grit_file_path)
 
+        if self.__quarter_rotations:
+            tiles_count *= 2
+
+        graphics_indexes = self.__graphics_indexes
+
+        if graphics_indexes is not None:
+            tiles_count = (tiles_count // self.__graphics) * (max(graphics_indexes) + 1)
+
         if self.__colors_count == 16:
             bpp_mode_label = 'bpp_mode::BPP_4'
         else:
@@ -355,23 +1216,42 @@ class SpriteTilesItem:
             header_file.write('\n')
             header_file.write('#include "bn_sprite_tiles_item.h"' + '\n')
             header_file.write('#include "bn_sprite_shape_size.h"' + '\n')
+
+            if self.__tiles_deltas:
+                header_file.write('#include "bn_sprite_tiles_delta_item.h"' + '\n')
+
             header_file.write(grit_data)
             header_file.write('\n')
             header_file.write('namespace bn::sprite_tiles_items' + '\n')
             header_file.write('{' + '\n')
+
+            if graphics_indexes is None:
+                graphics_label = compression_label(compression) + ', ' + str(self.__graphics)
+            else:
+                total_size += write_graphics_indexes(header_file, name, graphics_indexes)
+                graphics_label = 'span<const uint16_t>(' + name + '_bn_gfxGraphicsIndexes, ' + \
+                                 str(self.__graphics) + ')'
+
             header_file.write('    constexpr inline sprite_tiles_item ' + name + '(span<const tile>(' +
                               name + '_bn_gfxTiles, ' + str(tiles_count) + '), ' + '\n            ' +
-                              bpp_mode_label + ', ' + compression_label(compression) + ', ' +
-                              str(self.__graphics) + ');' + '\n')
+                              bpp_mode_label + ', ' + graphics_label + ');' + '\n')
             header_file.write('\n')
             header_file.write('    constexpr inline sprite_shape_size ' + name +
                               '_shape_size(sprite_shape::' + self.__shape + ', ' +
                               'sprite_size::' + self.__size + ');' + '\n')
+
+            if self.__tiles_deltas:
+                total_size += write_sprite_tiles_delta_item(header_file, self.__build_folder_path, name,
+                                                            self.__graphics)
+
             header_file.write('}' + '\n')
             header_file.write('\n')
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        self.__compression_report = compression_report(grit_data, name, [
+            ('Tiles', compression, tiles_count * 32)])
+
         return total_size, header_file_path
 
     def __execute_command(self, compression):
@@ -382,7 +1262,7 @@ class SpriteTilesItem:
         else:
             command.append('-gB8')
 
-        if compression == 'lz77':
+        if compression == 'lz77' or compression == 'lz77_huffman':
             command.append('-gzl')
         elif compression == 'run_length':
             command.append('-gzr')
@@ -395,6 +1275,21 @@ class SpriteTilesItem:
         except subprocess.CalledProcessError as e:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        self.__graphics_indexes = None
+
+        if self.__quarter_rotations:
+            add_quarter_rotated_graphics(self.__build_folder_path, self.__file_name_no_ext, self.__graphics // 2,
+                                         self.__sprite_width, self.__colors_count != 16)
+
+        if compression == 'none' and self.__repeated_graphics_reduction and self.__graphics > 1:
+            self.__graphics_indexes = reduce_repeated_graphics(self.__build_folder_path, self.__file_name_no_ext,
+                                                               self.__graphics)
+
+        if compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', lz4_compress)
+        elif compression == 'huffman' or compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', huffman_compress)
+
 
 class SpritePaletteItem:
 
@@ -431,11 +1326,15 @@ class SpritePaletteItem:
         if compression == 'auto':
             compression, file_size = self.__test_compression(compression, 'none', None)
             compression, file_size = self.__test_compression(compression, 'run_length', file_size)
+            compression, file_size = self.__test_compression(compression, 'lz4', file_size)
             compression, file_size = self.__test_compression(compression, 'lz77', file_size)
 
         self.__execute_command(compression)
         return self.__write_header(compression, False)
 
+    def compression_report(self):
+        return self.__compression_report
+
     def __test_compression(self, best_compression, new_compression, best_file_size):
         self.__execute_command(new_compression)
         new_file_size = self.__write_header(new_compression, True)
@@ -491,12 +1390,15 @@ class SpritePaletteItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        self.__compression_report = compression_report(grit_data, name, [
+            ('Pal', compression, self.__colors_count * 2)])
+
         return total_size, header_file_path
 
     def __execute_command(self, compression):
         command = ['grit', self.__file_path, '-g!', '-pe' + str(self.__colors_count)]
 
-        if compression == 'lz77':
+        if compression == 'lz77' or compression == 'lz77_huffman':
             command.append('-pzl')
         elif compression == 'run_length':
             command.append('-pzr')
@@ -509,6 +1411,11 @@ class SpritePaletteItem:
         except subprocess.CalledProcessError as e:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        if compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', lz4_compress)
+        elif compression == 'huffman' or compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', huffman_compress)
+
 
 class RegularBgItem:
 
@@ -543,6 +1450,13 @@ class RegularBgItem:
         except KeyError:
             self.__flipped_tiles_reduction = True
 
+        try:
+            self.__tiles_report = bool(info['tiles_report'])
+        except KeyError:
+            self.__tiles_report = False
+
+        self.__quantize_loss = None
+
         try:
             palette_item = str(info['palette_item'])
 
@@ -583,6 +1497,12 @@ class RegularBgItem:
 
                 self.__file_path = self.__build_folder_path + '/' + file_name_no_ext + '.bn_quantized.bmp'
                 self.__colors_count = bmp.quantize(self.__file_path)
+            elif bpp_mode == 'bpp_4_auto_lossy':
+                if self.__palette_item is not None:
+                    raise ValueError('BPP mode not supported with an external palette item: ' + bpp_mode)
+
+                self.__file_path = self.__build_folder_path + '/' + file_name_no_ext + '.bn_quantized.bmp'
+                self.__colors_count, self.__quantize_loss = bmp.quantize_lossy(self.__file_path)
             elif bpp_mode != 'bpp_4' and bpp_mode != 'bpp_4_manual':
                 raise ValueError('Invalid BPP mode: ' + bpp_mode)
 
@@ -611,7 +1531,7 @@ class RegularBgItem:
 
         try:
             self.__map_compression = info['map_compression']
-            validate_compression(self.__map_compression)
+            validate_map_compression(self.__map_compression)
         except KeyError:
             try:
                 self.__map_compression = info['compression']
@@ -619,6 +1539,9 @@ class RegularBgItem:
             except KeyError:
                 self.__map_compression = 'none'
 
+        if self.__map_compression == 'chunked' and self.__width <= 64 and self.__height <= 64:
+            raise ValueError('Chunked compression is supported by big maps only: ' + str(width) + ' - ' + str(height))
+
     def process(self):
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
@@ -627,22 +1550,28 @@ class RegularBgItem:
         if tiles_compression == 'auto':
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'none', None)
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'run_length', file_size)
+            tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'lz4', file_size)
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'lz77', file_size)
 
         if palette_compression == 'auto':
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'none', None)
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'run_length',
                                                                              file_size)
+            palette_compression, file_size = self.__test_palette_compression(palette_compression, 'lz4', file_size)
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'lz77', file_size)
 
         if map_compression == 'auto':
             map_compression, file_size = self.__test_map_compression(map_compression, 'none', None)
             map_compression, file_size = self.__test_map_compression(map_compression, 'run_length', file_size)
+            map_compression, file_size = self.__test_map_compression(map_compression, 'lz4', file_size)
             map_compression, file_size = self.__test_map_compression(map_compression, 'lz77', file_size)
 
         self.__execute_command(tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
 
+    def compression_report(self):
+        return self.__compression_report
+
     def __test_tiles_compression(self, best_tiles_compression, new_tiles_compression, best_file_size):
         self.__execute_command(new_tiles_compression, 'none', 'none')
         new_file_size = self.__write_header(new_tiles_compression, 'none', 'none', True)
@@ -705,6 +1634,16 @@ class RegularBgItem:
 
         remove_file(grit_file_path)
 
+        if self.__tiles_report:
+            write_regular_bg_tiles_report(BMP(self.__file_path), self.__build_folder_path, name, self.__bpp_8,
+                                          self.__repeated_tiles_reduction, self.__flipped_tiles_reduction,
+                                          tiles_count)
+
+        if map_compression == 'chunked':
+            map_size = write_chunked_map(self.__build_folder_path, name, 2, self.__width, self.__height)
+            grit_data = re.sub(r'MapLen ([0-9]+)', 'MapLen ' + str(map_size), grit_data)
+            grit_data = re.sub(r'Map\[([0-9]+)]', 'Map[' + str(map_size // 2) + ']', grit_data)
+
         if self.__bpp_8:
             bpp_mode_label = 'bpp_mode::BPP_8'
             tiles_count *= 2
@@ -749,6 +1688,17 @@ class RegularBgItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        self.__compression_report = compression_report(grit_data, name, [
+            ('Tiles', tiles_compression, tiles_count * 32),
+            ('Pal', palette_compression, self.__colors_count * 2),
+            ('Map', map_compression, self.__width * self.__height * 2)])
+
+        if self.__quantize_loss is not None and self.__quantize_loss[1] > 0:
+            changed_tiles, changed_pixels, max_error = self.__quantize_loss
+            self.__compression_report.append('Quantize loss: ' + str(changed_pixels) + ' pixels changed in ' +
+                                             str(changed_tiles) + ' tiles, max color component error: ' +
+                                             str(max_error))
+
         return total_size, header_file_path
 
     def __execute_command(self, tiles_compression, palette_compression, map_compression):
@@ -787,17 +1737,17 @@ class RegularBgItem:
         else:
             command.append('-mLf')
 
-        if tiles_compression == 'lz77':
+        if tiles_compression == 'lz77' or tiles_compression == 'lz77_huffman':
             command.append('-gzl')
         elif tiles_compression == 'run_length':
             command.append('-gzr')
 
-        if palette_compression == 'lz77':
+        if palette_compression == 'lz77' or palette_compression == 'lz77_huffman':
             command.append('-pzl')
         elif palette_compression == 'run_length':
             command.append('-pzr')
 
-        if map_compression == 'lz77':
+        if map_compression == 'lz77' or map_compression == 'lz77_huffman':
             command.append('-mzl')
         elif map_compression == 'run_length':
             command.append('-mzr')
@@ -810,6 +1760,21 @@ class RegularBgItem:
         except subprocess.CalledProcessError as e:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        if tiles_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', lz4_compress)
+        elif tiles_compression == 'huffman' or tiles_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', huffman_compress)
+
+        if palette_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', lz4_compress)
+        elif palette_compression == 'huffman' or palette_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', huffman_compress)
+
+        if map_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Map', lz4_compress)
+        elif map_compression == 'huffman' or map_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Map', huffman_compress)
+
 
 class AffineBgItem:
 
@@ -884,7 +1849,7 @@ class AffineBgItem:
 
         try:
             self.__map_compression = info['map_compression']
-            validate_compression(self.__map_compression)
+            validate_map_compression(self.__map_compression)
         except KeyError:
             try:
                 self.__map_compression = info['compression']
@@ -892,6 +1857,10 @@ class AffineBgItem:
             except KeyError:
                 self.__map_compression = 'none'
 
+        if self.__map_compression == 'chunked' and self.__width == self.__height and \
+                self.__width in (16, 32, 64, 128):
+            raise ValueError('Chunked compression is supported by big maps only: ' + str(width) + ' - ' + str(height))
+
     def process(self):
         tiles_compression = self.__tiles_compression
         palette_compression = self.__palette_compression
@@ -900,22 +1869,28 @@ class AffineBgItem:
         if tiles_compression == 'auto':
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'none', None)
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'run_length', file_size)
+            tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'lz4', file_size)
             tiles_compression, file_size = self.__test_tiles_compression(tiles_compression, 'lz77', file_size)
 
         if palette_compression == 'auto':
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'none', None)
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'run_length',
                                                                              file_size)
+            palette_compression, file_size = self.__test_palette_compression(palette_compression, 'lz4', file_size)
             palette_compression, file_size = self.__test_palette_compression(palette_compression, 'lz77', file_size)
 
         if map_compression == 'auto':
             map_compression, file_size = self.__test_map_compression(map_compression, 'none', None)
             map_compression, file_size = self.__test_map_compression(map_compression, 'run_length', file_size)
+            map_compression, file_size = self.__test_map_compression(map_compression, 'lz4', file_size)
             map_compression, file_size = self.__test_map_compression(map_compression, 'lz77', file_size)
 
         self.__execute_command(tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
 
+    def compression_report(self):
+        return self.__compression_report
+
     def __test_tiles_compression(self, best_tiles_compression, new_tiles_compression, best_file_size):
         self.__execute_command(new_tiles_compression, 'none', 'none')
         new_file_size = self.__write_header(new_tiles_compression, 'none', 'none', True)
@@ -978,6 +1953,11 @@ class AffineBgItem:
 
         remove_file(grit_file_path)
 
+        if map_compression == 'chunked':
+            map_size = write_chunked_map(self.__build_folder_path, name, 1, self.__width, self.__height)
+            grit_data = re.sub(r'MapLen ([0-9]+)', 'MapLen ' + str(map_size), grit_data)
+            grit_data = re.sub(r'Map\[([0-9]+)]', 'Map[' + str(map_size) + ']', grit_data)
+
         tiles_count *= 2
         grit_data = re.sub(r'Tiles\[([0-9]+)]', 'Tiles[' + str(tiles_count) + ']', grit_data)
         grit_data = re.sub(r'Pal\[([0-9]+)]', 'Pal[' + str(self.__colors_count) + ']', grit_data)
@@ -1017,6 +1997,11 @@ class AffineBgItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        self.__compression_report = compression_report(grit_data, name, [
+            ('Tiles', tiles_compression, tiles_count * 32),
+            ('Pal', palette_compression, self.__colors_count * 2),
+            ('Map', map_compression, self.__width * self.__height)])
+
         return total_size, header_file_path
 
     def __execute_command(self, tiles_compression, palette_compression, map_compression):
@@ -1032,17 +2017,17 @@ class AffineBgItem:
         else:
             command.append('-mR!')
 
-        if tiles_compression == 'lz77':
+        if tiles_compression == 'lz77' or tiles_compression == 'lz77_huffman':
             command.append('-gzl')
         elif tiles_compression == 'run_length':
             command.append('-gzr')
 
-        if palette_compression == 'lz77':
+        if palette_compression == 'lz77' or palette_compression == 'lz77_huffman':
             command.append('-pzl')
         elif palette_compression == 'run_length':
             command.append('-pzr')
 
-        if map_compression == 'lz77':
+        if map_compression == 'lz77' or map_compression == 'lz77_huffman':
             command.append('-mzl')
         elif map_compression == 'run_length':
             command.append('-mzr')
@@ -1055,6 +2040,21 @@ class AffineBgItem:
         except subprocess.CalledProcessError as e:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        if tiles_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', lz4_compress)
+        elif tiles_compression == 'huffman' or tiles_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Tiles', huffman_compress)
+
+        if palette_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', lz4_compress)
+        elif palette_compression == 'huffman' or palette_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', huffman_compress)
+
+        if map_compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Map', lz4_compress)
+        elif map_compression == 'huffman' or map_compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Map', huffman_compress)
+
 
 class BgPaletteItem:
 
@@ -1103,11 +2103,15 @@ class BgPaletteItem:
         if compression == 'auto':
             compression, file_size = self.__test_compression(compression, 'none', None)
             compression, file_size = self.__test_compression(compression, 'run_length', file_size)
+            compression, file_size = self.__test_compression(compression, 'lz4', file_size)
             compression, file_size = self.__test_compression(compression, 'lz77', file_size)
 
         self.__execute_command(compression)
         return self.__write_header(compression, False)
 
+    def compression_report(self):
+        return self.__compression_report
+
     def __test_compression(self, best_compression, new_compression, best_file_size):
         self.__execute_command(new_compression)
         new_file_size = self.__write_header(new_compression, True)
@@ -1163,12 +2167,15 @@ class BgPaletteItem:
             header_file.write('#endif' + '\n')
             header_file.write('\n')
 
+        self.__compression_report = compression_report(grit_data, name, [
+            ('Pal', compression, self.__colors_count * 2)])
+
         return total_size, header_file_path
 
     def __execute_command(self, compression):
         command = ['grit', self.__file_path, '-g!', '-pe' + str(self.__colors_count)]
 
-        if compression == 'lz77':
+        if compression == 'lz77' or compression == 'lz77_huffman':
             command.append('-pzl')
         elif compression == 'run_length':
             command.append('-pzr')
@@ -1181,19 +2188,523 @@ class BgPaletteItem:
         except subprocess.CalledProcessError as e:
             raise ValueError('grit call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        if compression == 'lz4':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', lz4_compress)
+        elif compression == 'huffman' or compression == 'lz77_huffman':
+            compress_grit_data(self.__build_folder_path, self.__file_name_no_ext, 'Pal', huffman_compress)
+
+
+class TileCollisionMapItem:
+
+    def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
+        bmp = BMP(file_path)
+        self.__file_name_no_ext = file_name_no_ext
+        self.__build_folder_path = build_folder_path
+        self.__width = bmp.width // 8
+        self.__height = bmp.height // 8
+
+        # The collision value of each cell is the most used color index of its tile:
+        values = []
+
+        for tile in bmp.tiles():
+            value = max(set(tile), key=tile.count)
+
+            if value > 3:
+                raise ValueError('Invalid collision value: ' + str(value) +
+                                 ' (color indexes must be in the range [0..3])')
+
+            values.append(value)
+
+        self.__values = values
+
+        try:
+            bits_per_cell = int(info['bits_per_cell'])
+
+            if bits_per_cell != 1 and bits_per_cell != 2:
+                raise ValueError('Invalid bits per cell: ' + str(bits_per_cell))
+
+            if bits_per_cell == 1 and max(values) > 1:
+                raise ValueError('Collision values greater than 1 require 2 bits per cell')
+        except KeyError:
+            bits_per_cell = 1 if max(values) <= 1 else 2
+
+        self.__bits_per_cell = bits_per_cell
+
+    def process(self):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_tile_collision_map_items_' + name + '.h'
+        width = self.__width
+        height = self.__height
+        bits_per_cell = self.__bits_per_cell
+        words_per_row = ((width * bits_per_cell) + 31) // 32
+        words = []
+
+        # Each row starts at a new word, with the first cell in the least significant bits:
+        for y in range(height):
+            row_words = [0] * words_per_row
+
+            for x in range(width):
+                bit = x * bits_per_cell
+                row_words[bit // 32] |= self.__values[(y * width) + x] << (bit % 32)
+
+            words.extend(row_words)
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_TILE_COLLISION_MAP_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_tile_collision_map_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::tile_collision_map_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    alignas(int) constexpr inline uint32_t ' + name + '_bn_collision_cells[] = {' + '\n')
+
+            for index in range(0, len(words), 8):
+                header_file.write('        ' + ', '.join('0x%08X' % word for word in words[index:index + 8]) +
+                                  ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline tile_collision_map_item ' + name + '(' + name +
+                              '_bn_collision_cells[0],' + '\n            ' +
+                              'size(' + str(width) + ', ' + str(height) + '), ' + str(bits_per_cell) + ');' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return len(words) * 4, header_file_path
+
+    @staticmethod
+    def compression_report():
+        return []
+
+
+class MetaSpriteItem:
+
+    # Sprite shapes and sizes with their width and height in tiles:
+    __shapes = [(1, 1, 'SQUARE', 'SMALL'), (2, 2, 'SQUARE', 'NORMAL'), (4, 4, 'SQUARE', 'BIG'),
+                (8, 8, 'SQUARE', 'HUGE'), (2, 1, 'WIDE', 'SMALL'), (4, 1, 'WIDE', 'NORMAL'),
+                (4, 2, 'WIDE', 'BIG'), (8, 4, 'WIDE', 'HUGE'), (1, 2, 'TALL', 'SMALL'),
+                (1, 4, 'TALL', 'NORMAL'), (2, 4, 'TALL', 'BIG'), (4, 8, 'TALL', 'HUGE')]
+
+    def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
+        bmp = BMP(file_path)
+        self.__file_name_no_ext = file_name_no_ext
+        self.__build_folder_path = build_folder_path
+        self.__width = bmp.width
+        self.__height = bmp.height
+        self.__colors_count = bmp.colors_count
+        self.__bpp_8 = bmp.colors_count != 16
+
+        try:
+            self.__sprite_cost = int(info['sprite_cost'])
+
+            if self.__sprite_cost < 0:
+                raise ValueError('Invalid sprite cost: ' + str(self.__sprite_cost))
+        except KeyError:
+            self.__sprite_cost = 2
+
+        used_colors = bmp.used_colors()
+        self.__colors = [gba_color(used_colors.get(index, 0)) for index in range(self.__colors_count)]
+        self.__tiles = bmp.tiles()
+
+    def process(self):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_meta_sprite_items_' + name + '.h'
+        pieces = self.__cover()
+        tiles = []
+        pieces_lines = []
+
+        for tile_x, tile_y, shape in pieces:
+            tiles_width, tiles_height, shape_label, size_label = shape
+            x = (tile_x * 8) + (tiles_width * 4) - (self.__width // 2)
+            y = (tile_y * 8) + (tiles_height * 4) - (self.__height // 2)
+            pieces_lines.append('meta_sprite_piece(' + str(x) + ', ' + str(y) + ', sprite_shape_size(sprite_shape::' +
+                                shape_label + ', sprite_size::' + size_label + '), ' +
+                                str(len(tiles) * (2 if self.__bpp_8 else 1)) + ')')
+
+            # Sprite tiles are stored from left to right and from top to bottom:
+            for piece_tile_y in range(tile_y, tile_y + tiles_height):
+                for piece_tile_x in range(tile_x, tile_x + tiles_width):
+                    tiles.append(self.__tile_words(piece_tile_x, piece_tile_y))
+
+        # 8BPP tiles are stored as two 4BPP tiles:
+        tile_words = [words[index:index + 8] for words in tiles for index in range(0, len(words), 8)]
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_META_SPRITE_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_meta_sprite_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::meta_sprite_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    alignas(int) constexpr inline tile ' + name + '_bn_gfxTiles[] = {' + '\n')
+
+            for words in tile_words:
+                header_file.write('        { ' + ', '.join('0x%08X' % word for word in words) + ' },' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    alignas(int) constexpr inline color ' + name + '_bn_gfxPal[] = {' + '\n')
+
+            for index in range(0, len(self.__colors), 8):
+                header_file.write('        ' + ', '.join('color(0x%04X)' % color
+                                                         for color in self.__colors[index:index + 8]) + ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline meta_sprite_piece ' + name + '_bn_gfxPieces[] = {' + '\n')
+
+            for pieces_line in pieces_lines:
+                header_file.write('        ' + pieces_line + ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+
+            bpp_mode_label = 'bpp_mode::BPP_8' if self.__bpp_8 else 'bpp_mode::BPP_4'
+            header_file.write('    constexpr inline meta_sprite_item ' + name + '(' + '\n            ' +
+                              'span<const tile>(' + name + '_bn_gfxTiles, ' + str(len(tile_words)) + '), ' +
+                              '\n            ' + 'sprite_palette_item(span<const color>(' + name + '_bn_gfxPal, ' +
+                              str(self.__colors_count) + '), ' + bpp_mode_label + '), ' + '\n            ' +
+                              'span<const meta_sprite_piece>(' + name + '_bn_gfxPieces, ' + str(len(pieces)) + '), ' +
+                              'size(' + str(self.__width) + ', ' + str(self.__height) + '));' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        total_size = (len(tile_words) * 32) + (len(self.__colors) * 2) + (len(pieces) * 8)
+        return total_size, header_file_path
+
+    @staticmethod
+    def compression_report():
+        return []
+
+    def __opaque(self, tile_x, tile_y):
+        if tile_x >= self.__width // 8 or tile_y >= self.__height // 8:
+            return False
+
+        return any(self.__tiles[(tile_y * (self.__width // 8)) + tile_x])
+
+    def __tile_words(self, tile_x, tile_y):
+        if tile_x >= self.__width // 8 or tile_y >= self.__height // 8:
+            tile = [0] * 64
+        else:
+            tile = self.__tiles[(tile_y * (self.__width // 8)) + tile_x]
+
+        if self.__bpp_8:
+            return [tile[index] | (tile[index + 1] << 8) | (tile[index + 2] << 16) | (tile[index + 3] << 24)
+                    for index in range(0, 64, 4)]
+
+        words = []
+
+        for index in range(0, 64, 8):
+            word = 0
+
+            for pixel_index in range(8):
+                word |= tile[index + pixel_index] << (pixel_index * 4)
+
+            words.append(word)
+
+        return words
+
+    def __cover(self):
+        """
+        Covers the opaque tiles with sprites, trying to minimize the number of pixels drawn per scanline:
+        regular sprites take one cycle per pixel of width in each scanline, so the cost of a sprite is its area
+        plus the given cost per sprite, to avoid too many small sprites.
+        """
+
+        tiles_width = self.__width // 8
+        tiles_height = self.__height // 8
+        uncovered = set((tile_x, tile_y) for tile_y in range(tiles_height) for tile_x in range(tiles_width)
+                        if self.__opaque(tile_x, tile_y))
+        pieces = []
+
+        while uncovered:
+            # The top left uncovered tile is covered by the sprite which covers more tiles per cost unit:
+            first_tile_x, first_tile_y = min(uncovered, key=lambda uncovered_tile: (uncovered_tile[1],
+                                                                                     uncovered_tile[0]))
+            best_piece = None
+            best_score = None
+
+            for shape in self.__shapes:
+                shape_width, shape_height = shape[0], shape[1]
+
+                for tile_x in range(max(first_tile_x - shape_width + 1, 0), first_tile_x + 1):
+                    covered_tiles = sum(1 for piece_tile_y in range(first_tile_y, first_tile_y + shape_height)
+                                        for piece_tile_x in range(tile_x, tile_x + shape_width)
+                                        if (piece_tile_x, piece_tile_y) in uncovered)
+                    cost = (shape_width * shape_height) + self.__sprite_cost
+                    score = (covered_tiles / cost, covered_tiles)
+
+                    if best_score is None or score > best_score:
+                        best_piece = (tile_x, first_tile_y, shape)
+                        best_score = score
+
+            tile_x, tile_y, shape = best_piece
+            pieces.append(best_piece)
+
+            for piece_tile_y in range(tile_y, tile_y + shape[1]):
+                for piece_tile_x in range(tile_x, tile_x + shape[0]):
+                    uncovered.discard((piece_tile_x, piece_tile_y))
+
+        if not pieces:
+            raise ValueError('Meta sprites without opaque pixels not supported')
+
+        if len(pieces) > 128:
+            raise ValueError('Too many sprites: ' + str(len(pieces)) + ' (max is 128)')
+
+        return pieces
+
+
+class VideoItem:
+
+    def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
+        bmp = BMP(file_path)
+        self.__file_name_no_ext = file_name_no_ext
+        self.__build_folder_path = build_folder_path
+        self.__columns = bmp.width // 8
+
+        if self.__columns > 32:
+            raise ValueError('Invalid width: ' + str(bmp.width) + ' (max width is 256)')
+
+        try:
+            height = int(info['height'])
+        except KeyError:
+            raise ValueError('height field not found in graphics json file: ' + file_name_no_ext + '.json')
+
+        if height <= 0 or height > 256 or height % 8 != 0 or bmp.height % height != 0:
+            raise ValueError('Invalid height: ' + str(height) + ' (it must be a multiple of 8, less or equal than ' +
+                             '256 and it must divide the BMP height)')
+
+        self.__rows = height // 8
+        self.__frames_count = bmp.height // height
+
+        try:
+            self.__frame_duration = int(info['frame_duration'])
+
+            if self.__frame_duration < 1 or self.__frame_duration > 32767:
+                raise ValueError('Invalid frame duration: ' + str(self.__frame_duration))
+        except KeyError:
+            self.__frame_duration = 1
+
+        try:
+            bpp_mode = str(info['bpp_mode'])
+
+            if bpp_mode == 'bpp_8':
+                self.__bpp_8 = True
+            elif bpp_mode == 'bpp_4':
+                self.__bpp_8 = False
+            else:
+                raise ValueError('Invalid BPP mode: ' + bpp_mode)
+        except KeyError:
+            self.__bpp_8 = bmp.colors_count > 16
+
+        max_tiles = 512 if self.__bpp_8 else 1024
+
+        try:
+            self.__max_tiles = int(info['max_tiles'])
+
+            if self.__max_tiles < 2 or self.__max_tiles > max_tiles:
+                raise ValueError('Invalid max tiles: ' + str(self.__max_tiles) + ' - ' + str(max_tiles))
+        except KeyError:
+            self.__max_tiles = max_tiles
+
+        used_colors = bmp.used_colors()
+        colors_count = 256 if self.__bpp_8 else 16
+
+        if max(used_colors) >= colors_count:
+            raise ValueError('Invalid color index: ' + str(max(used_colors)) + ' - ' + str(colors_count))
+
+        self.__colors = [gba_color(used_colors.get(index, 0)) for index in range(max(used_colors) + 1)]
+        self.__colors += [0] * ((16 - (len(self.__colors) % 16)) % 16)
+        self.__tiles = bmp.tiles()
+
+    def process(self):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_video_items_' + name + '.h'
+        tiles_count, words = self.__encode()
+
+        with open(header_file_path, 'w') as header_file:
+            include_guard = 'BN_VIDEO_ITEMS_' + name.upper() + '_H'
+            header_file.write('#ifndef ' + include_guard + '\n')
+            header_file.write('#define ' + include_guard + '\n')
+            header_file.write('\n')
+            header_file.write('#include "bn_video_item.h"' + '\n')
+            header_file.write('\n')
+            header_file.write('namespace bn::video_items' + '\n')
+            header_file.write('{' + '\n')
+            header_file.write('    alignas(int) constexpr inline color ' + name + '_bn_video_colors[] = {' + '\n')
+
+            for index in range(0, len(self.__colors), 8):
+                header_file.write('        ' + ', '.join('color(0x%04X)' % color
+                                                         for color in self.__colors[index:index + 8]) + ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    alignas(int) constexpr inline uint32_t ' + name + '_bn_video_frames[] = {' + '\n')
+
+            for index in range(0, len(words), 8):
+                header_file.write('        ' + ', '.join('0x%08X' % word for word in words[index:index + 8]) +
+                                  ',' + '\n')
+
+            header_file.write('    };' + '\n')
+            header_file.write('\n')
+            header_file.write('    constexpr inline video_item ' + name + '(' + name + '_bn_video_frames[0], ' +
+                              '\n            ' + 'bg_palette_item(span<const color>(' + name + '_bn_video_colors, ' +
+                              str(len(self.__colors)) + '), ' +
+                              ('bpp_mode::BPP_8' if self.__bpp_8 else 'bpp_mode::BPP_4') + '), ' +
+                              '\n            ' + str(tiles_count) + ', ' + str(self.__frames_count) + ', ' +
+                              str(self.__frame_duration) + ');' + '\n')
+            header_file.write('}' + '\n')
+            header_file.write('\n')
+            header_file.write('#endif' + '\n')
+            header_file.write('\n')
+
+        return (len(self.__colors) * 2) + (len(words) * 4), header_file_path
+
+    @staticmethod
+    def compression_report():
+        return []
+
+    def __tile_words(self, tile):
+        if self.__bpp_8:
+            return [tile[index] | (tile[index + 1] << 8) | (tile[index + 2] << 16) | (tile[index + 3] << 24)
+                    for index in range(0, 64, 4)]
+
+        words = []
+
+        for index in range(0, 64, 8):
+            word = 0
+
+            for pixel_index in range(8):
+                word |= tile[index + pixel_index] << (pixel_index * 4)
+
+            words.append(word)
+
+        return words
+
+    def __encode(self):
+        columns = self.__columns
+        rows = self.__rows
+        max_tiles = self.__max_tiles
+
+        # Frames are centered in a 32x32 cells map, and the cells outside them use the empty first tile:
+        left = (32 - columns) // 2
+        top = (32 - rows) // 2
+        empty_tile = tuple([0] * 64)
+        slots_content = [empty_tile]
+        slots_last_frame = [-1]
+        content_slots = {empty_tile: 0}
+        maps = [[0] * 1024, [0] * 1024]
+        previous_frame_slots = set()
+        words = []
+
+        for frame_index in range(self.__frames_count):
+            first_tile_index = frame_index * rows * columns
+            frame_tiles = self.__tiles[first_tile_index:first_tile_index + (rows * columns)]
+            frame_slots = {0}
+            new_contents = []
+
+            # Tiles already in the dictionary are reused:
+            for tile in frame_tiles:
+                slot = content_slots.get(tile)
+
+                if slot is None:
+                    if tile not in new_contents:
+                        new_contents.append(tile)
+                else:
+                    frame_slots.add(slot)
+                    slots_last_frame[slot] = frame_index
+
+            # New tiles replace the least recently used tiles not used by the previous frame nor by this one:
+            tile_words = []
+
+            for tile in new_contents:
+                locked_slots = previous_frame_slots | frame_slots
+                free_slots = [slot for slot in range(1, len(slots_content)) if slot not in locked_slots]
+
+                if free_slots:
+                    slot = min(free_slots, key=lambda free_slot: slots_last_frame[free_slot])
+                    del content_slots[slots_content[slot]]
+                    slots_content[slot] = tile
+                    slots_last_frame[slot] = frame_index
+                elif len(slots_content) < max_tiles:
+                    slot = len(slots_content)
+                    slots_content.append(tile)
+                    slots_last_frame.append(frame_index)
+                else:
+                    raise ValueError('Frame ' + str(frame_index) + ' requires more than ' + str(max_tiles) +
+                                     ' tiles (tiles of two consecutive frames must fit in the dictionary)')
+
+                content_slots[tile] = slot
+                frame_slots.add(slot)
+                tile_words.append(slot)
+                tile_words.extend(self.__tile_words(tile))
+
+            # Map cells are double buffered, so they are compared with the frame before the previous one:
+            frame_cells = [0] * 1024
+
+            for tile_index, tile in enumerate(frame_tiles):
+                cell_index = ((top + (tile_index // columns)) * 32) + left + (tile_index % columns)
+                frame_cells[cell_index] = content_slots[tile]
+
+            map_cells = maps[frame_index % 2]
+            runs = []
+
+            for cell_index in range(1024):
+                if frame_cells[cell_index] != map_cells[cell_index]:
+                    # Runs separated by less than three cells are merged to save run headers:
+                    if runs and cell_index - (runs[-1][0] + runs[-1][1]) < 3:
+                        runs[-1][1] = cell_index - runs[-1][0] + 1
+                    else:
+                        runs.append([cell_index, 1])
+
+            words.append((len(new_contents) << 16) | len(runs))
+            words.extend(tile_words)
+
+            for run_cell_index, run_cells_count in runs:
+                run_cells = frame_cells[run_cell_index:run_cell_index + run_cells_count]
+
+                if run_cells_count % 2:
+                    run_cells.append(0)
+
+                words.append((run_cell_index << 16) | run_cells_count)
+                words.extend(run_cells[index] | (run_cells[index + 1] << 16) for index in range(0, len(run_cells), 2))
+
+            maps[frame_index % 2] = frame_cells
+            previous_frame_slots = frame_slots
+
+        return len(slots_content), words
+
 
 class GraphicsFileInfo:
 
-    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_info_path):
+    def __init__(self, json_file_path, file_path, file_name, file_name_no_ext, file_info_path, file_info):
         self.__json_file_path = json_file_path
         self.__file_path = file_path
         self.__file_name = file_name
         self.__file_name_no_ext = file_name_no_ext
         self.__file_info_path = file_info_path
+        self.__file_info = file_info
 
     def print_file_name(self):
         print(self.__file_name)
 
+    def file_path(self):
+        return self.__file_path
+
+    def set_file_path(self, file_path):
+        self.__file_path = file_path
+
+    def file_name_no_ext(self):
+        return self.__file_name_no_ext
+
     def process(self, build_folder_path):
         try:
             try:
@@ -1219,16 +2730,21 @@ class GraphicsFileInfo:
                 item = AffineBgItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
             elif graphics_type == 'bg_palette':
                 item = BgPaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+            elif graphics_type == 'tile_collision_map':
+                item = TileCollisionMapItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+            elif graphics_type == 'meta_sprite':
+                item = MetaSpriteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+            elif graphics_type == 'video':
+                item = VideoItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
             else:
                 raise ValueError('Unknown graphics type "' + graphics_type +
                                  '" found in graphics json file: ' + self.__json_file_path)
 
             total_size, header_file_path = item.process()
 
-            with open(self.__file_info_path, 'w') as file_info:
-                file_info.write('')
+            self.__file_info.write(self.__file_info_path)
 
-            return [self.__file_name, header_file_path, total_size]
+            return [self.__file_name, header_file_path, total_size, item.compression_report()]
         except Exception as exc:
             return [self.__file_name, exc]
 
@@ -1242,10 +2758,108 @@ class GraphicsFileInfoProcessor:
         return graphics_file_info.process(self.__build_folder_path)
 
 
+def gba_color(color):
+    return ((color >> 19) & 31) | (((color >> 11) & 31) << 5) | (((color >> 3) & 31) << 10)
+
+
+def read_palette_group(json_file_path):
+    try:
+        with open(json_file_path) as json_file:
+            info = json.load(json_file)
+
+        palette_group = str(info['palette_group'])
+        graphics_type = str(info['type'])
+    except Exception:
+        return None
+
+    if graphics_type != 'sprite':
+        raise ValueError('Palette groups are supported by sprites only: ' + json_file_path)
+
+    return palette_group
+
+
+def pack_palette_group(palette_group, graphics_file_infos, build_folder_path):
+    """
+    Packs the colors of the given sprites in as few 16 color palettes as possible,
+    remapping the color indexes of each sprite to its palette.
+
+    Sprites with the same palette share the same palette bank at runtime.
+    """
+
+    images = []
+
+    for graphics_file_info in graphics_file_infos:
+        bmp = BMP(graphics_file_info.file_path())
+        used_colors = bmp.used_colors()
+        colors = {}
+
+        for color_index, color in used_colors.items():
+            if color_index:
+                colors.setdefault(gba_color(color), color)
+
+        if len(colors) > 15:
+            raise ValueError('Sprites of palette groups can\'t have more than 15 colors: ' +
+                             graphics_file_info.file_name_no_ext() + ' (' + str(len(colors)) + ' colors)')
+
+        images.append([graphics_file_info, bmp, used_colors, colors, None])
+
+    # Sprites with more colors are packed first:
+    images.sort(key=lambda image: (-len(image[3]), image[0].file_name_no_ext()))
+    palettes = []
+
+    for image in images:
+        colors = image[3]
+        best_palette = None
+        best_added_colors_count = None
+
+        for palette in palettes:
+            added_colors_count = len([color_key for color_key in colors if color_key not in palette[1]])
+
+            if len(palette[1]) + added_colors_count <= 15:
+                if best_added_colors_count is None or added_colors_count < best_added_colors_count:
+                    best_palette = palette
+                    best_added_colors_count = added_colors_count
+
+                    if added_colors_count == 0:
+                        break
+
+        if best_palette is None:
+            best_palette = [image[2][0], {}]
+            palettes.append(best_palette)
+
+        for color_key in sorted(colors):
+            if color_key not in best_palette[1]:
+                best_palette[1][color_key] = [len(best_palette[1]) + 1, colors[color_key]]
+
+        image[4] = best_palette
+
+    for image in images:
+        graphics_file_info, bmp, used_colors, colors, palette = image
+        palette_colors = [palette[0]] + [0] * 15
+
+        for color_index, color in palette[1].values():
+            palette_colors[color_index] = color
+
+        color_indexes_map = {0: 0}
+
+        for color_index, color in used_colors.items():
+            if color_index:
+                color_indexes_map[color_index] = palette[1][gba_color(color)][0]
+
+        output_file_path = build_folder_path + '/' + graphics_file_info.file_name_no_ext() + '.bn_palette_group.bmp'
+        bmp.remap(output_file_path, palette_colors, color_indexes_map)
+        graphics_file_info.set_file_path(output_file_path)
+
+    print('Palette group ' + palette_group + ': ' + str(len(images)) + ' sprites packed in ' + str(len(palettes)) +
+          ' palettes')
+
+
 def list_graphics_file_infos(graphics_folder_paths, build_folder_path):
     graphics_folder_path_list = graphics_folder_paths.split(' ')
     graphics_file_infos = []
+    palette_groups = {}
     file_names_set = set()
+    tool_file_paths = FileInfo.tool_file_paths(__file__)
 
     for graphics_folder_path in graphics_folder_path_list:
         graphics_file_names = os.listdir(graphics_folder_path)
@@ -1270,27 +2884,147 @@ def list_graphics_file_infos(graphics_folder_paths, build_folder_path):
                         raise ValueError('Graphics json file not found: ' + json_file_path)
 
                     file_info_path = build_folder_path + '/_bn_' + graphics_file_name_no_ext + '_file_info.txt'
+                    file_info = FileInfo.build_from_files([graphics_file_path, json_file_path] + tool_file_paths)
+                    build = FileInfo.read(file_info_path) != file_info
 
-                    if not os.path.exists(file_info_path):
-                        build = True
-                    else:
-                        file_info_mtime = os.path.getmtime(file_info_path)
-                        graphics_file_mtime = os.path.getmtime(graphics_file_path)
-
-                        if file_info_mtime < graphics_file_mtime:
-                            build = True
-                        else:
-                            json_file_mtime = os.path.getmtime(json_file_path)
-                            build = file_info_mtime < json_file_mtime
+                    palette_group = read_palette_group(json_file_path)
 
-                    if build:
+                    if palette_group is not None:
+                        palette_groups.setdefault(palette_group, []).append([GraphicsFileInfo(
+                            json_file_path, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
+                            file_info_path, file_info), build])
+                    elif build:
                         graphics_file_infos.append(GraphicsFileInfo(
                             json_file_path, graphics_file_path, graphics_file_name, graphics_file_name_no_ext,
-                            file_info_path))
+                            file_info_path, file_info))
+
+    # The palettes of a group depend on all of its sprites, so if one of them is modified, all of them are rebuilt:
+    for palette_group, palette_group_items in sorted(palette_groups.items()):
+        if any(palette_group_item[1] for palette_group_item in palette_group_items):
+            palette_group_file_infos = [palette_group_item[0] for palette_group_item in palette_group_items]
+            pack_palette_group(palette_group, palette_group_file_infos, build_folder_path)
+            graphics_file_infos.extend(palette_group_file_infos)
 
     return graphics_file_infos
 
 
+def asset_hash(name):
+    # 32-bit FNV-1a, as bn::asset_hash:
+    result = 0x811C9DC5
+
+    for character in name.encode('utf-8'):
+        result ^= character
+        result = (result * 0x01000193) & 0xFFFFFFFF
+
+    return result
+
+
+def process_asset_registry(graphics_folder_paths, build_folder_path):
+    """
+    Writes the bn_asset_registry_items.h header file, which contains a table sorted by hash
+    for each graphics item type, so they can be found at runtime with bn::asset_registry::find.
+
+    The header file is only written if its contents change, to avoid rebuilding its dependencies.
+    """
+
+    graphics_types = ['affine_bg', 'bg_palette', 'regular_bg', 'sprite', 'sprite_palette', 'sprite_tiles',
+                      'tile_collision_map']
+    items = {graphics_type: [] for graphics_type in graphics_types}
+
+    for graphics_folder_path in graphics_folder_paths.split(' '):
+        for graphics_file_name in sorted(os.listdir(graphics_folder_path)):
+            graphics_file_path = graphics_folder_path + '/' + graphics_file_name
+
+            if os.path.isfile(graphics_file_path) and FileInfo.validate(graphics_file_name):
+                graphics_file_name_no_ext, graphics_file_name_ext = os.path.splitext(graphics_file_name)
+
+                if graphics_file_name_ext == '.bmp':
+                    json_file_path = graphics_folder_path + '/' + graphics_file_name_no_ext + '.json'
+
+                    try:
+                        with open(json_file_path) as json_file:
+                            graphics_type = str(json.load(json_file)['type'])
+                    except Exception:
+                        continue
+
+                    if graphics_type in items:
+                        items[graphics_type].append(graphics_file_name_no_ext)
+
+    lines = [
+        '#ifndef BN_ASSET_REGISTRY_ITEMS_H',
+        '#define BN_ASSET_REGISTRY_ITEMS_H',
+        '',
+        '#include "bn_asset_registry.h"',
+    ]
+
+    for item_type in graphics_types:
+        lines.append('#include "bn_' + item_type + '_item.h"')
+
+    lines.append('')
+
+    for item_type in graphics_types:
+        for name in items[item_type]:
+            lines.append('#include "bn_' + item_type + '_items_' + name + '.h"')
+
+    lines.append('')
+    lines.append('namespace bn')
+    lines.append('{')
+
+    for item_type in graphics_types:
+        names = items[item_type]
+        hashes = {}
+
+        for name in names:
+            hash_value = asset_hash(name)
+
+            if hash_value in hashes:
+                raise ValueError('Asset registry hash collision: ' + hashes[hash_value] + ' - ' + name)
+
+            hashes[hash_value] = name
+
+        if item_type != graphics_types[0]:
+            lines.append('')
+
+        lines.append('    template<>')
+        lines.append('    class asset_registry_table<' + item_type + '_item>')
+        lines.append('    {')
+        lines.append('')
+        lines.append('    public:')
+
+        if hashes:
+            lines.append('        static constexpr asset_registry_entry<' + item_type + '_item> entries_array[] = {')
+
+            for hash_value, name in sorted(hashes.items()):
+                lines.append('            asset_registry_entry<' + item_type + '_item>(0x%08X, ' % hash_value +
+                             item_type + '_items::' + name + '),')
+
+            lines.append('        };')
+            lines.append('')
+
+        lines.append('        [[nodiscard]] static constexpr span<const asset_registry_entry<' + item_type +
+                     '_item>> entries()')
+        lines.append('        {')
+        lines.append('            return ' + ('entries_array' if hashes else '{}') + ';')
+        lines.append('        }')
+        lines.append('    };')
+
+    lines.append('}')
+    lines.append('')
+    lines.append('#endif')
+    lines.append('')
+
+    header_contents = '\n'.join(lines)
+    header_file_path = build_folder_path + '/bn_asset_registry_items.h'
+
+    if os.path.isfile(header_file_path):
+        with open(header_file_path) as header_file:
+            if header_file.read() == header_contents:
+                return
+
+    with open(header_file_path, 'w') as header_file:
+        header_file.write(header_contents)
+
+
 def process_graphics(graphics_folder_paths, build_folder_path):
     graphics_file_infos = list_graphics_file_infos(graphics_folder_paths, build_folder_path)
 
@@ -1300,19 +3034,24 @@ def process_graphics(graphics_folder_paths, build_folder_path):
 
         sys.stdout.flush()
 
+        # Items are sent one by one, so an item which takes a long time (like an item with auto compression)
+        # doesn't delay the ones which would be sent with it:
         pool = Pool()
-        process_results = pool.map(GraphicsFileInfoProcessor(build_folder_path), graphics_file_infos)
+        process_results = pool.map(GraphicsFileInfoProcessor(build_folder_path), graphics_file_infos, chunksize=1)
         pool.close()
 
         total_size = 0
         process_excs = []
 
         for process_result in process_results:
-            if len(process_result) == 3:
+            if len(process_result) == 4:
                 file_size = process_result[2]
                 total_size += file_size
                 print('    ' + str(process_result[0]) + ' item header written in ' + str(process_result[1]) +
                       ' (graphics size: ' + str(file_size) + ' bytes)')
+
+                for compression_report_line in process_result[3]:
+                    print('        ' + compression_report_line)
             else:
                 process_excs.append(process_result)
 
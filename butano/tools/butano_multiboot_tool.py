@@ -0,0 +1,124 @@
+"""
+Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import argparse
+import struct
+import sys
+import traceback
+
+from butano_graphics_tool import lz77_compress
+
+
+ewram_start = 0x02000000
+max_image_size = 0x40000
+header_size = 0xC0
+stub_offset = 0xE0
+
+# ARM code executed by the client after receiving the compressed image:
+#   ldr     r0, payload_start
+#   ldr     r1, payload_end
+#   ldr     r2, destination_end
+# copy_loop:                        @ Moves the compressed payload to the end of EWRAM
+#   ldr     r3, [r1, #-4]!
+#   str     r3, [r2, #-4]!
+#   cmp     r1, r0
+#   bhi     copy_loop
+#   adr     r3, trampoline
+#   mov     r4, #0x03000000
+#   ldmia   r3, {r5, r6, r7}        @ Copies the trampoline to IWRAM, since EWRAM is going to be overwritten
+#   stmia   r4, {r5, r6, r7}
+#   mov     r0, r2
+#   mov     r1, #0x02000000
+#   bx      r4
+# trampoline:
+#   swi     0x110000                @ LZ77UnCompWram
+#   ldr     pc, [pc, #-4]           @ Jumps to the entry point of the decompressed image
+#   .word   0x02000000
+# payload_start:
+#   .word   0
+# payload_end:
+#   .word   0
+# destination_end:
+#   .word   0x02040000
+stub_code = [
+    0xE59F003C, 0xE59F103C, 0xE59F203C, 0xE5313004, 0xE5223004, 0xE1510000, 0x8AFFFFFB, 0xE28F3014,
+    0xE3A04403, 0xE89300E0, 0xE88400E0, 0xE1A00002, 0xE3A01402, 0xE12FFF14, 0xEF110000, 0xE51FF004,
+    0x02000000,
+]
+
+
+def arm_branch(source_offset, destination_offset):
+    return 0xEA000000 | (((destination_offset - source_offset - 8) >> 2) & 0xFFFFFF)
+
+
+def build_compressed_image(image):
+    """
+    Returns a multiboot image which decompresses the given one when the client boots it.
+
+    The header of the given image is kept, so the client BIOS accepts the returned image.
+    """
+
+    image_size = len(image)
+
+    if image_size < header_size + 4 or image_size > max_image_size:
+        raise ValueError('Invalid image size: ' + str(image_size))
+
+    payload = lz77_compress(image)
+
+    while len(payload) % 4:
+        payload.append(0)
+
+    payload_size = len(payload)
+
+    # The compressed payload is moved to the end of EWRAM, so it must not overlap the decompressed image:
+    if image_size + payload_size > max_image_size:
+        raise ValueError('Compressed image is too big: ' + str(image_size) + ' + ' + str(payload_size))
+
+    payload_offset = stub_offset + ((len(stub_code) + 3) * 4)
+    result = bytearray(image[:header_size])
+    result[0:4] = struct.pack('<I', arm_branch(0, stub_offset))
+    result += struct.pack('<I', arm_branch(header_size, stub_offset))
+    result += bytearray(stub_offset - len(result))
+
+    for word in stub_code:
+        result += struct.pack('<I', word)
+
+    result += struct.pack('<III', ewram_start + payload_offset, ewram_start + payload_offset + payload_size,
+                          ewram_start + max_image_size)
+    result += payload
+
+    while len(result) % 16:
+        result.append(0)
+
+    if len(result) > max_image_size:
+        raise ValueError('Compressed image is too big: ' + str(len(result)))
+
+    return result
+
+
+def process_multiboot(input_file_path, output_file_path):
+    with open(input_file_path, 'rb') as input_file:
+        image = input_file.read()
+
+    result = build_compressed_image(image)
+
+    with open(output_file_path, 'wb') as output_file:
+        output_file.write(result)
+
+    print('Multiboot image size: ' + str(len(image)) + ' bytes - compressed: ' + str(len(result)) + ' bytes')
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Butano multiboot tool.')
+    parser.add_argument('--input', required=True, help='multiboot image file path')
+    parser.add_argument('--output', required=True, help='compressed multiboot image file path')
+
+    try:
+        args = parser.parse_args()
+        process_multiboot(args.input, args.output)
+    except Exception as ex:
+        sys.stderr.write('Error: ' + str(ex) + '\n')
+        traceback.print_exc()
+        exit(-1)
@@ -3,6 +3,7 @@ Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
 zlib License, see LICENSE file.
 """
 
+import hashlib
 import os
 import string
 
@@ -45,12 +46,28 @@ class FileInfo:
     def build_from_files(file_paths):
         info = []
 
+        # Contents are hashed instead of reading modification times,
+        # so checkouts and copies which don't change the files don't trigger a rebuild:
         for file_path in file_paths:
+            with open(file_path, 'rb') as file:
+                file_hash = hashlib.sha1(file.read()).hexdigest()
+
             info.append(file_path)
-            info.append(str(os.path.getmtime(file_path)))
+            info.append(file_hash)
 
         return FileInfo('\n'.join(info), False)
 
+    @staticmethod
+    def tool_file_paths(tool_file_path):
+        """
+        Returns the paths of the source files of the given tool, so it can be added to the hashed files
+        to rebuild the assets when the tool changes.
+        """
+
+        tools_folder_path = os.path.dirname(os.path.abspath(tool_file_path))
+        return [os.path.join(tools_folder_path, file_name) for file_name in sorted(os.listdir(tools_folder_path))
+                if file_name.endswith('.py')]
+
     def __init__(self, info, read_failed):
         self.__info = info
         self.__read_failed = read_failed
@@ -6,8 +6,8 @@
 #include "bn_core.h"
 #include "bn_math.h"
 #include "bn_keypad.h"
-#include "bn_display.h"
 #include "bn_affine_bg_ptr.h"
+#include "bn_affine_bg_perspective.h"
 #include "bn_sprite_text_generator.h"
 #include "bn_affine_bg_pa_register_hbe_ptr.h"
 #include "bn_affine_bg_pc_register_hbe_ptr.h"
@@ -26,9 +26,7 @@ namespace
         bn::fixed x = 440;
         bn::fixed y = 128;
         bn::fixed z = 320;
-        int phi = 10;
-        int cos = 0;
-        int sin = 0;
+        bn::fixed angle = 1.7578125;
     };
 
     void update_camera(camera& camera)
@@ -70,57 +68,27 @@ namespace
 
         if(bn::keypad::l_held())
         {
-            camera.phi -= 4;
+            camera.angle -= 0.703125;
 
-            if(camera.phi < 0)
+            if(camera.angle < 0)
             {
-                camera.phi += 2048;
+                camera.angle += 360;
             }
         }
         else if(bn::keypad::r_held())
         {
-            camera.phi += 4;
+            camera.angle += 0.703125;
 
-            if(camera.phi >= 2048)
+            if(camera.angle >= 360)
             {
-                camera.phi -= 2048;
+                camera.angle -= 360;
             }
         }
 
-        camera.cos = bn::lut_cos(camera.phi).data() >> 4;
-        camera.sin = bn::lut_sin(camera.phi).data() >> 4;
-        camera.x += (dir_x * camera.cos) - (dir_z * camera.sin);
-        camera.z += (dir_x * camera.sin) + (dir_z * camera.cos);
-    }
-
-    void update_hbe_values(const camera& camera, int16_t* pa_values, int16_t* pc_values, int* dx_values,
-                           int* dy_values)
-    {
-        int camera_x = camera.x.data();
-        int camera_y = camera.y.data() >> 4;
-        int camera_z = camera.z.data();
-        int camera_cos = camera.cos;
-        int camera_sin = camera.sin;
-        int y_shift = 160;
-
-        for(int index = 0; index < bn::display::height(); ++index)
-        {
-            int reciprocal = bn::reciprocal_lut[index].data() >> 4;
-            int lam = camera_y * reciprocal >> 12;
-            int lcf = lam * camera_cos >> 8;
-            int lsf = lam * camera_sin >> 8;
-
-            pa_values[index] = int16_t(lcf >> 4);
-            pc_values[index] = int16_t(lsf >> 4);
-
-            int lxr = (bn::display::width() / 2) * lcf;
-            int lyr = y_shift * lsf;
-            dx_values[index] = (camera_x - lxr + lyr) >> 4;
-
-            lxr = (bn::display::width() / 2) * lsf;
-            lyr = y_shift * lcf;
-            dy_values[index] = (camera_z - lxr - lyr) >> 4;
-        }
+        int camera_cos = bn::degrees_lut_cos(camera.angle).data() >> 4;
+        int camera_sin = bn::degrees_lut_sin(camera.angle).data() >> 4;
+        camera.x += (dir_x * camera_cos) - (dir_z * camera_sin);
+        camera.z += (dir_x * camera_sin) + (dir_z * camera_cos);
     }
 }
 
@@ -141,28 +109,34 @@ int main()
 
     bn::affine_bg_ptr bg = bn::affine_bg_items::land.create_bg(-376, -336);
 
-    int16_t pa_values[bn::display::height()];
-    bn::affine_bg_pa_register_hbe_ptr pa_hbe = bn::affine_bg_pa_register_hbe_ptr::create(bg, pa_values);
-
-    int16_t pc_values[bn::display::height()];
-    bn::affine_bg_pc_register_hbe_ptr pc_hbe = bn::affine_bg_pc_register_hbe_ptr::create(bg, pc_values);
-
-    int dx_values[bn::display::height()];
-    bn::affine_bg_dx_register_hbe_ptr dx_hbe = bn::affine_bg_dx_register_hbe_ptr::create(bg, dx_values);
-
-    int dy_values[bn::display::height()];
-    bn::affine_bg_dy_register_hbe_ptr dy_hbe = bn::affine_bg_dy_register_hbe_ptr::create(bg, dy_values);
-
     camera camera;
+    bn::affine_bg_perspective perspective(camera.x, camera.y, camera.z, camera.angle);
+
+    bn::affine_bg_pa_register_hbe_ptr pa_hbe =
+            bn::affine_bg_pa_register_hbe_ptr::create(bg, perspective.pa_values());
+    bn::affine_bg_pc_register_hbe_ptr pc_hbe =
+            bn::affine_bg_pc_register_hbe_ptr::create(bg, perspective.pc_values());
+    bn::affine_bg_dx_register_hbe_ptr dx_hbe =
+            bn::affine_bg_dx_register_hbe_ptr::create(bg, perspective.dx_values());
+    bn::affine_bg_dy_register_hbe_ptr dy_hbe =
+            bn::affine_bg_dy_register_hbe_ptr::create(bg, perspective.dy_values());
 
     while(true)
     {
         update_camera(camera);
-        update_hbe_values(camera, pa_values, pc_values, dx_values, dy_values);
-        pa_hbe.reload_values_ref();
-        pc_hbe.reload_values_ref();
-        dx_hbe.reload_values_ref();
-        dy_hbe.reload_values_ref();
+        perspective.set_x(camera.x);
+        perspective.set_y(camera.y);
+        perspective.set_z(camera.z);
+        perspective.set_angle(camera.angle);
+
+        if(perspective.update())
+        {
+            pa_hbe.reload_values_ref();
+            pc_hbe.reload_values_ref();
+            dx_hbe.reload_values_ref();
+            dy_hbe.reload_values_ref();
+        }
+
         info.update();
         bn::core::update();
     }
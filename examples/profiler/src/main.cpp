@@ -5,9 +5,11 @@
 
 #include "bn_core.h"
 #include "bn_math.h"
+#include "bn_span.h"
 #include "bn_random.h"
 #include "bn_profiler.h"
 #include "bn_algorithm.h"
+#include "bn_polygon_rasterizer.h"
 
 #include "../../butano/hw/include/bn_hw_tonc.h"
 
@@ -121,6 +123,31 @@ int main()
 
     BN_PROFILER_STOP();
 
+    constexpr int polygons_count = 64;
+    bn::fixed_point polygons_vertices[polygons_count * 4];
+
+    for(bn::fixed_point& vertex : polygons_vertices)
+    {
+        vertex = bn::fixed_point(random.get_fixed(-160, 160), random.get_fixed(-100, 100));
+    }
+
+    bn::polygon_rasterizer polygon_rasterizer;
+    BN_PROFILER_START("polygon_rasterizer");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        polygon_rasterizer.clear();
+
+        for(int polygon_index = 0; polygon_index < polygons_count; ++polygon_index)
+        {
+            polygon_rasterizer.add_polygon(bn::span<const bn::fixed_point>(polygons_vertices + (polygon_index * 4), 4));
+        }
+
+        integer += polygon_rasterizer.maximum_y();
+    }
+
+    BN_PROFILER_STOP();
+
     [[maybe_unused]] int dummy = bn::sqrt(bn::abs(integer));
 
     bn::profiler::show();
@@ -7,9 +7,18 @@
 #include "bn_size.h"
 #include "bn_color.h"
 #include "bn_point.h"
+#include "bn_format.h"
+#include "bn_vector.h"
 #include "bn_keypad.h"
+#include "bn_tile_canvas.h"
 #include "bn_fixed_point.h"
 #include "bn_bg_palettes.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_builder.h"
+#include "bn_regular_bg_map_item.h"
 #include "bn_sprite_affine_mat_ptr.h"
 #include "bn_affine_mat_attributes.h"
 #include "bn_sprite_text_generator.h"
@@ -26,8 +35,19 @@ namespace
     constexpr bn::string_view info_text_lines[] = {
         "A: choose vertex to move",
         "PAD: move vertex",
+        "B: toggle software rendering",
+        "L/R: change software quads count",
     };
 
+    constexpr int canvas_width = 240;
+    constexpr int canvas_height = 160;
+    constexpr int canvas_columns = canvas_width / 8;
+    constexpr int canvas_rows = canvas_height / 8;
+    constexpr int max_software_quads = 32;
+
+    BN_DATA_EWRAM bn::tile canvas_tiles[canvas_columns * canvas_rows];
+    BN_DATA_EWRAM bn::regular_bg_map_cell canvas_cells[32 * 32];
+
     class triangle
     {
 
@@ -62,6 +82,12 @@ namespace
             _update();
         }
 
+        void set_visible(bool visible)
+        {
+            _visible = visible;
+            _update();
+        }
+
     private:
         bn::sprite_ptr _sprite;
         bn::sprite_affine_mat_ptr _sprite_affine_mat;
@@ -69,6 +95,7 @@ namespace
         bn::point _p1;
         bn::point _p2;
         int _half_size;
+        bool _visible = true;
 
         void _update()
         {
@@ -144,7 +171,80 @@ namespace
             int delta_y = (u0v1 * y2) + (y1 * u2v0) + (y0 * u1v2) - (y0 * u2v1) - (u1v0 * y2) - (u0v2 * y1);
             int position_divisor = u0v1 + u2v0 + u1v2 - u2v1 - u1v0 - u0v2;
             _sprite.set_position(delta_x / position_divisor, delta_y / position_divisor);
-            _sprite.set_visible(true);
+            _sprite.set_visible(_visible);
+        }
+    };
+
+    class software_renderer
+    {
+
+    public:
+        software_renderer() :
+            _canvas(canvas_tiles, canvas_width, canvas_height, bn::bpp_mode::BPP_4),
+            _texture(bn::sprite_items::texture.tiles_item().graphics_tiles_ref(), 64, 64, bn::bpp_mode::BPP_4),
+            _bg(_create_bg(_canvas))
+        {
+            _bg.set_visible(false);
+        }
+
+        [[nodiscard]] bool visible() const
+        {
+            return _bg.visible();
+        }
+
+        void set_visible(bool visible)
+        {
+            _bg.set_visible(visible);
+        }
+
+        void draw(const bn::point& p0, const bn::point& p1, const bn::point& p2, const bn::point& p3, int quads)
+        {
+            // Canvas origin is the top-left corner of the screen:
+            bn::point center(canvas_width / 2, canvas_height / 2);
+            bn::point c0 = p0 + center;
+            bn::point c1 = p1 + center;
+            bn::point c2 = p2 + center;
+            bn::point c3 = p3 + center;
+
+            // Same texture coordinates as the sprite triangles:
+            bn::fixed_point uv0(0, 64);
+            bn::fixed_point uv1(64, 64);
+            bn::fixed_point uv2(64, 0);
+
+            _canvas.fill(0);
+
+            for(int index = 0; index < quads; ++index)
+            {
+                _canvas.draw_textured_triangle(c2, c3, c0, _texture, uv0, uv1, uv2);
+                _canvas.draw_textured_triangle(c0, c1, c2, _texture, uv0, uv1, uv2);
+            }
+
+            _canvas.update();
+        }
+
+    private:
+        bn::tile_canvas _canvas;
+        bn::tile_canvas_texture _texture;
+        bn::regular_bg_ptr _bg;
+
+        [[nodiscard]] static bn::regular_bg_ptr _create_bg(const bn::tile_canvas& canvas)
+        {
+            // The top-left corner of the screen is the cell (1, 6) of a 32x32 map:
+            for(int row = 0; row < canvas_rows; ++row)
+            {
+                for(int column = 0; column < canvas_columns; ++column)
+                {
+                    canvas_cells[((row + 6) * 32) + column + 1] = bn::regular_bg_map_cell(
+                                (row * canvas_columns) + column);
+                }
+            }
+
+            bn::bg_palette_item palette_item(bn::sprite_items::texture.palette_item().colors_ref(),
+                                             bn::bpp_mode::BPP_4);
+            bn::regular_bg_map_item map_item(canvas_cells[0], bn::size(32, 32));
+            bn::regular_bg_map_ptr map = bn::regular_bg_map_ptr::create(
+                        map_item, canvas.tiles(), palette_item.create_palette());
+            return bn::regular_bg_builder(bn::move(map)).release_build();
         }
     };
 }
@@ -169,8 +269,36 @@ int main()
     bn::sprite_ptr p3_sprite = bn::sprite_items::bullet.create_sprite(p3);
     int p_index = 2;
 
+    software_renderer renderer;
+    bn::vector<bn::sprite_ptr, 16> benchmark_sprites;
+    int software_quads = 1;
+    int frame_counter = 0;
+    bn::fixed max_cpu_usage;
+
     while(true)
     {
+        if(bn::keypad::b_pressed())
+        {
+            bool software = ! renderer.visible();
+            renderer.set_visible(software);
+            top_triangle.set_visible(! software);
+            bottom_triangle.set_visible(! software);
+            benchmark_sprites.clear();
+            frame_counter = 0;
+        }
+
+        if(renderer.visible())
+        {
+            if(bn::keypad::l_pressed())
+            {
+                software_quads = bn::max(software_quads - 1, 1);
+            }
+            else if(bn::keypad::r_pressed())
+            {
+                software_quads = bn::min(software_quads + 1, max_software_quads);
+            }
+        }
+
         if(bn::keypad::a_pressed())
         {
             switch(p_index)
@@ -255,6 +383,24 @@ int main()
             }
         }
 
+        if(renderer.visible())
+        {
+            renderer.draw(p0, p1, p2, p3, software_quads);
+            max_cpu_usage = bn::max(max_cpu_usage, bn::core::last_cpu_usage());
+
+            if(frame_counter % 64 == 0)
+            {
+                int max_cpu_usage_pct = (max_cpu_usage * 100).right_shift_integer();
+                benchmark_sprites.clear();
+                big_text_generator.set_center_alignment();
+                big_text_generator.generate(0, -48, bn::format<32>("Quads: {} CPU: {}%", software_quads,
+                                                                   max_cpu_usage_pct), benchmark_sprites);
+                max_cpu_usage = 0;
+            }
+
+            ++frame_counter;
+        }
+
         info.update();
         bn::core::update();
     }
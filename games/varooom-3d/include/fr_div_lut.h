@@ -6,23 +6,19 @@
 #ifndef FR_DIV_LUT_H
 #define FR_DIV_LUT_H
 
-#include "bn_fixed.h"
 #include "bn_type_traits.h"
+#include "bn_reciprocal_lut.h"
 
 namespace fr
 {
 
 constexpr int div_lut_precision = 24;
-extern const uint32_t* div_lut_ptr;
+constexpr int div_lut_size = 1024 * 4;
+extern const bn::fixed_t<div_lut_precision>* div_lut_ptr;
 
 [[nodiscard]] constexpr uint32_t calculate_div_lut_value(int denominator)
 {
-    if(denominator < 2)
-    {
-        return 1 << div_lut_precision;
-    }
-
-    return uint32_t((1 << div_lut_precision) / denominator);
+    return uint32_t(bn::calculate_reciprocal_lut_entry<div_lut_precision>(denominator).data());
 }
 
 template<int Precision>
@@ -31,7 +27,7 @@ template<int Precision>
     static_assert(Precision > 0 && Precision <= div_lut_precision, "Invalid precision");
 
     uint32_t div_lut_value = bn::is_constant_evaluated() ?
-                calculate_div_lut_value(denominator) : div_lut_ptr[denominator];
+                calculate_div_lut_value(denominator) : uint32_t(div_lut_ptr[denominator].data());
 
     return bn::fixed_t<Precision>::from_data(numerator * int(div_lut_value >> (div_lut_precision - Precision)));
 }
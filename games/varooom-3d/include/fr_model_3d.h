@@ -9,6 +9,7 @@
 #include "bn_intrusive_list.h"
 
 #include "fr_sin_cos.h"
+#include "fr_sprite_3d.h"
 #include "fr_model_3d_item.h"
 
 namespace fr
@@ -19,7 +20,8 @@ class model_3d : public bn::intrusive_list_node_type
 
 public:
     constexpr explicit model_3d(const model_3d_item& item) :
-        _item(item)
+        _item(item),
+        _lod_item(&item)
     {
     }
 
@@ -28,6 +30,78 @@ public:
         return _item;
     }
 
+    [[nodiscard]] constexpr const model_3d_item& lod_item() const
+    {
+        return *_lod_item;
+    }
+
+    [[nodiscard]] constexpr sprite_3d* impostor_sprite() const
+    {
+        return _impostor_sprite;
+    }
+
+    [[nodiscard]] constexpr int impostor_distance() const
+    {
+        return _impostor_distance;
+    }
+
+    // The impostor sprite is shown instead of the model when the distance to the camera is greater than
+    // impostor_distance:
+    constexpr void set_impostor(sprite_3d& sprite, int impostor_distance)
+    {
+        BN_ASSERT(impostor_distance > 0, "Invalid impostor distance: ", impostor_distance);
+
+        _impostor_sprite = &sprite;
+        _impostor_distance = impostor_distance;
+        sprite.set_visible(_impostor_active);
+    }
+
+    constexpr void remove_impostor()
+    {
+        _impostor_sprite = nullptr;
+        _impostor_distance = 0;
+        _impostor_active = false;
+    }
+
+    [[nodiscard]] constexpr bool lod_enabled() const
+    {
+        return _item.lod_item() || _impostor_sprite;
+    }
+
+    // Returns false if the impostor sprite must be shown instead of the model:
+    constexpr bool update_lod(int camera_distance)
+    {
+        if(_impostor_sprite)
+        {
+            _impostor_active = camera_distance > _lod_threshold(_impostor_distance, _impostor_active);
+            _impostor_sprite->set_position(_position);
+            _impostor_sprite->set_visible(_impostor_active);
+
+            if(_impostor_active)
+            {
+                return false;
+            }
+        }
+
+        const model_3d_item* lod_item = &_item;
+        int lod_level = 0;
+
+        while(const model_3d_item* next_lod_item = lod_item->lod_item())
+        {
+            if(camera_distance <= _lod_threshold(lod_item->lod_distance(), lod_level < _lod_level))
+            {
+                break;
+            }
+
+            lod_item = next_lod_item;
+            ++lod_level;
+        }
+
+        _lod_item = lod_item;
+        _lod_level = lod_level;
+        return true;
+    }
+
     [[nodiscard]] constexpr const point_3d& position() const
     {
         return _position;
@@ -204,6 +278,8 @@ public:
 
 private:
     const model_3d_item& _item;
+    const model_3d_item* _lod_item;
+    sprite_3d* _impostor_sprite = nullptr;
     point_3d _position;
     bn::fixed _scale = 1;
     bn::fixed _phi;
@@ -227,7 +303,17 @@ private:
     bn::fixed _xx_xy;
     bn::fixed _yx_yy;
     bn::fixed _zx_zy;
+    int _impostor_distance = 0;
+    int _lod_level = 0;
     bool _update = true;
+    bool _impostor_active = false;
+
+    // Thresholds have a hysteresis band, so models near them don't switch detail level back and forth:
+    [[nodiscard]] constexpr static int _lod_threshold(int distance, bool past_threshold)
+    {
+        int band = distance / 8;
+        return past_threshold ? distance - band : distance + band;
+    }
 };
 
 }
@@ -249,6 +249,8 @@ public:
     {
         BN_ASSERT(vertices.size() > 0 && vertices.size() < 32768, "Invalid vertices count: ", vertices.size());
         BN_ASSERT(! faces.empty(), "There's no faces");
+
+        _setup_bounding_sphere();
     }
 
     [[nodiscard]] constexpr const bn::span<const vertex_3d>& vertices() const
@@ -271,11 +273,82 @@ public:
         return _vertical_cylinder;
     }
 
+    [[nodiscard]] constexpr const point_3d& bounding_sphere_center() const
+    {
+        return _bounding_sphere_center;
+    }
+
+    [[nodiscard]] constexpr bn::fixed bounding_sphere_radius() const
+    {
+        return _bounding_sphere_radius;
+    }
+
+    // Lower detail variant used when the distance to the camera is greater than lod_distance:
+    [[nodiscard]] constexpr const model_3d_item* lod_item() const
+    {
+        return _lod_item;
+    }
+
+    [[nodiscard]] constexpr int lod_distance() const
+    {
+        return _lod_distance;
+    }
+
+    [[nodiscard]] constexpr model_3d_item with_lod(const model_3d_item& lod_item, int lod_distance) const
+    {
+        BN_ASSERT(lod_distance > 0, "Invalid LOD distance: ", lod_distance);
+        BN_ASSERT(lod_item.vertices().size() <= _vertices.size(),
+                  "Invalid LOD vertices count: ", lod_item.vertices().size(), " - ", _vertices.size());
+        BN_ASSERT(lod_item.faces().size() <= _faces.size(),
+                  "Invalid LOD faces count: ", lod_item.faces().size(), " - ", _faces.size());
+
+        model_3d_item result = *this;
+        result._lod_item = &lod_item;
+        result._lod_distance = lod_distance;
+        return result;
+    }
+
 private:
     bn::span<const vertex_3d> _vertices;
     bn::span<const face_3d> _faces;
     const face_3d* _collision_face;
     const model_3d_vertical_cylinder* _vertical_cylinder;
+    const model_3d_item* _lod_item = nullptr;
+    point_3d _bounding_sphere_center;
+    bn::fixed _bounding_sphere_radius;
+    int _lod_distance = 0;
+
+    constexpr void _setup_bounding_sphere()
+    {
+        point_3d minimum = _vertices[0].point();
+        point_3d maximum = minimum;
+
+        for(const vertex_3d& vertex : _vertices)
+        {
+            const point_3d& point = vertex.point();
+            minimum = point_3d(bn::min(minimum.x(), point.x()), bn::min(minimum.y(), point.y()),
+                               bn::min(minimum.z(), point.z()));
+            maximum = point_3d(bn::max(maximum.x(), point.x()), bn::max(maximum.y(), point.y()),
+                               bn::max(maximum.z(), point.z()));
+        }
+
+        point_3d center = (minimum + maximum) / 2;
+        int64_t maximum_squared_distance = 0;
+
+        for(const vertex_3d& vertex : _vertices)
+        {
+            const point_3d& point = vertex.point();
+            int64_t x = (point.x() - center.x()).data();
+            int64_t y = (point.y() - center.y()).data();
+            int64_t z = (point.z() - center.z()).data();
+            maximum_squared_distance = bn::max(maximum_squared_distance, (x * x) + (y * y) + (z * z));
+        }
+
+        // Integer radius rounded up:
+        int squared_radius = int(maximum_squared_distance >> (bn::fixed::precision() * 2));
+        _bounding_sphere_center = center;
+        _bounding_sphere_radius = bn::sqrt(squared_radius) + 1;
+    }
 };
 
 
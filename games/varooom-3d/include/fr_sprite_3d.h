@@ -46,6 +46,16 @@ public:
         _position = position;
     }
 
+    [[nodiscard]] constexpr bool visible() const
+    {
+        return _visible;
+    }
+
+    constexpr void set_visible(bool visible)
+    {
+        _visible = visible;
+    }
+
     [[nodiscard]] constexpr bn::fixed scale() const
     {
         return _scale;
@@ -124,6 +134,7 @@ private:
     bn::fixed _theta;
     bn::fixed _theta_sin;
     bn::fixed _theta_cos = 1;
+    bool _visible = true;
 };
 
 }
@@ -56,7 +56,7 @@ public:
         _rival_car_infos(rival_car_infos),
         _rival_checkpoints(rival_checkpoints),
         _model_grid(model_items),
-        _visible_model_grid(_model_grid.cells()),
+        _visible_model_grid(model_items, _model_grid.cells()),
         _start_position(start_position),
         _start_angle(start_angle),
         _slow_ground_tile_index(slow_ground_tile_index),
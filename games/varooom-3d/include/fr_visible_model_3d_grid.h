@@ -6,6 +6,8 @@
 #ifndef FR_VISIBLE_MODEL_3D_GRID_H
 #define FR_VISIBLE_MODEL_3D_GRID_H
 
+#include "bn_limits.h"
+
 #include "fr_constants_3d.h"
 #include "fr_model_3d_grid.h"
 
@@ -16,15 +18,28 @@ class visible_model_3d_grid
 {
 
 public:
+    // Potentially visible models are grouped in sectors of sector_cells x sector_cells grid cells,
+    // so all models of a sector can be discarded with only one screen test:
+    static constexpr int sector_cells = 4;
+    static constexpr int sector_size = model_3d_grid::cell_size * sector_cells;
+    static constexpr int sector_columns = 4;
+    static constexpr int sector_rows = sector_columns;
+    static constexpr int max_sectors = sector_columns * sector_rows;
+
     class cell
     {
 
     public:
         uint16_t model_indexes[constants_3d::max_static_models];
         uint16_t models_count = 0;
+        uint16_t sector_radiuses[max_sectors] = {};
+        uint8_t sector_models_counts[max_sectors] = {};
+        uint8_t first_sector_row = 0;
+        uint8_t first_sector_column = 0;
     };
 
-    constexpr explicit visible_model_3d_grid(const model_3d_grid::cell* grid_cells)
+    constexpr visible_model_3d_grid(const bn::span<const model_3d_item>& model_items,
+                                    const model_3d_grid::cell* grid_cells)
     {
         for(int r = 0; r < model_3d_grid::rows; ++r)
         {
@@ -32,7 +47,7 @@ public:
 
             for(int c = 0; c < model_3d_grid::columns; ++c)
             {
-                cells_row[c] = _create_cell(grid_cells, r, c);
+                cells_row[c] = _create_cell(model_items, grid_cells, r, c);
             }
         }
     }
@@ -47,9 +62,14 @@ private:
 
     cell _cells[model_3d_grid::columns * model_3d_grid::rows];
 
-    [[nodiscard]] static constexpr cell _create_cell(const model_3d_grid::cell* grid_cells, int row, int column)
+    static_assert(((sector_cells - 1) + (_view_cells * 2)) / sector_cells < sector_columns);
+
+    [[nodiscard]] static constexpr cell _create_cell(const bn::span<const model_3d_item>& model_items,
+                                                     const model_3d_grid::cell* grid_cells, int row, int column)
     {
         uint16_t _model_usages[constants_3d::max_stage_models] = {};
+        uint16_t model_indexes[constants_3d::max_static_models] = {};
+        int models_count = 0;
         cell result;
 
         int ri = bn::max(row - _view_cells, 0);
@@ -75,16 +95,58 @@ private:
                     }
                     else
                     {
-                        BN_ASSERT(result.models_count < constants_3d::max_static_models, "Too much static models");
+                        BN_ASSERT(models_count < constants_3d::max_static_models, "Too much static models");
 
-                        result.model_indexes[result.models_count] = model_index;
-                        ++result.models_count;
+                        model_indexes[models_count] = model_index;
+                        ++models_count;
                         _model_usages[model_index] = 1;
                     }
                 }
             }
         }
 
+        // Models are sorted by the sector in which the centroid of their vertical cylinder is placed.
+        // Centroids outside the sectors window are assigned to the nearest sector:
+        int first_sector_row = ri / sector_cells;
+        int first_sector_column = ci / sector_cells;
+        int model_sectors[constants_3d::max_static_models] = {};
+        result.first_sector_row = uint8_t(first_sector_row);
+        result.first_sector_column = uint8_t(first_sector_column);
+
+        for(int index = 0; index < models_count; ++index)
+        {
+            const model_3d_vertical_cylinder* vertical_cylinder = model_items[model_indexes[index]].vertical_cylinder();
+            int centroid_x = vertical_cylinder->centroid_x().right_shift_integer();
+            int centroid_z = vertical_cylinder->centroid_z().right_shift_integer();
+            int sector_row = bn::clamp((centroid_z / sector_size) - first_sector_row, 0, sector_rows - 1);
+            int sector_column = bn::clamp((centroid_x / sector_size) - first_sector_column, 0, sector_columns - 1);
+            int sector_index = (sector_row * sector_columns) + sector_column;
+            model_sectors[index] = sector_index;
+
+            // Manhattan distance is always greater or equal than euclidean distance:
+            int sector_center_x = ((first_sector_column + sector_column) * sector_size) + (sector_size / 2);
+            int sector_center_z = ((first_sector_row + sector_row) * sector_size) + (sector_size / 2);
+            int sector_radius = bn::abs(centroid_x - sector_center_x) + bn::abs(centroid_z - sector_center_z) +
+                    vertical_cylinder->integer_radius() + 1;
+            BN_ASSERT(sector_radius <= bn::numeric_limits<uint16_t>::max(), "Invalid sector radius: ", sector_radius);
+
+            result.sector_radiuses[sector_index] = uint16_t(bn::max(int(result.sector_radiuses[sector_index]),
+                                                                    sector_radius));
+            ++result.sector_models_counts[sector_index];
+        }
+
+        for(int sector_index = 0; sector_index < max_sectors; ++sector_index)
+        {
+            for(int index = 0; index < models_count; ++index)
+            {
+                if(model_sectors[index] == sector_index)
+                {
+                    result.model_indexes[result.models_count] = model_indexes[index];
+                    ++result.models_count;
+                }
+            }
+        }
+
         return result;
     }
 };
@@ -49,7 +49,7 @@ void background_3d::update(const stage& stage, const camera_3d& camera)
     _clouds_bg_pivot_diff += stage.clouds_bg_pivot_inc();
 
     // bn::fixed scale = bn::fixed(256).division(camera_position.y());
-    bn::fixed scale = bn::fixed::from_data(div_lut_ptr[camera_position.y().data() >> 10] >> 2);
+    bn::fixed scale = bn::fixed::from_data(div_lut_ptr[camera_position.y().data() >> 10].data() >> 2);
     _ground_bg.set_scale(scale);
 
     int degrees = camera.phi().right_shift_integer() * 360;
@@ -5,27 +5,14 @@
 
 #include "fr_div_lut.h"
 
-#include "bn_array.h"
-
 namespace fr
 {
 
 namespace
 {
-    constexpr int div_lut_size = 1024 * 4;
-
-    constexpr bn::array<uint32_t, div_lut_size> div_lut = []{
-        bn::array<uint32_t, div_lut_size> result;
-
-        for(int index = 0; index < div_lut_size; ++index)
-        {
-            result[index] = calculate_div_lut_value(index);
-        }
-
-        return result;
-    }();
+    constexpr auto div_lut = bn::make_reciprocal_lut<div_lut_size, div_lut_precision>();
 }
 
-const uint32_t* div_lut_ptr = div_lut._data;
+const bn::fixed_t<div_lut_precision>* div_lut_ptr = div_lut.data();
 
 }
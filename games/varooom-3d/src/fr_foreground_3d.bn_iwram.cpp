@@ -32,29 +32,59 @@ int foreground_3d::_reload_static_model_items_impl(const camera_3d& camera, cons
     bn::fixed camera_u_z = camera.u().z();
     bn::fixed camera_v_x = camera.v().x();
     bn::fixed camera_v_z = camera.v().z();
+    const uint16_t* model_indexes = visible_cell.model_indexes;
     int static_model_items_count = 0;
 
-    for(int index = visible_cell.models_count - 1; index >= 0; --index)
+    auto on_screen = [=](bn::fixed x, bn::fixed z, int radius)
     {
-        uint16_t model_index = visible_cell.model_indexes[index];
-        const model_3d_item& model_item = model_items[model_index];
-        const model_3d_vertical_cylinder* vertical_cylinder = model_item.vertical_cylinder();
-        int radius = vertical_cylinder->integer_radius();
-
-        bn::fixed vrx = (vertical_cylinder->centroid_x() - camera_x) / 16;
-        bn::fixed vrz = (vertical_cylinder->centroid_z() - camera_z) / 16;
+        bn::fixed vrx = (x - camera_x) / 16;
+        bn::fixed vrz = (z - camera_z) / 16;
         int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
         int screen_y = ((vcy * scale) >> 16) + (display_height / 2);
 
-        if(screen_y + radius >= 0 && screen_y - radius < display_height) [[likely]]
+        if(screen_y + radius >= 0 && screen_y - radius < display_height)
         {
             int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
             int screen_x = ((vcx * scale) >> 16) + (display_width / 2);
+            return screen_x + radius >= 0 && screen_x - radius < display_width;
+        }
+
+        return false;
+    };
+
+    for(int sector_row = 0; sector_row < visible_model_3d_grid::sector_rows; ++sector_row)
+    {
+        int sector_z = ((visible_cell.first_sector_row + sector_row) * visible_model_3d_grid::sector_size) +
+                (visible_model_3d_grid::sector_size / 2);
 
-            if(screen_x + radius >= 0 && screen_x - radius < display_width) [[likely]]
+        for(int sector_column = 0; sector_column < visible_model_3d_grid::sector_columns; ++sector_column)
+        {
+            int sector_index = (sector_row * visible_model_3d_grid::sector_columns) + sector_column;
+            int sector_models_count = visible_cell.sector_models_counts[sector_index];
+
+            if(sector_models_count)
             {
-                _static_model_items[static_model_items_count] = &model_item;
-                ++static_model_items_count;
+                int sector_x = ((visible_cell.first_sector_column + sector_column) *
+                                visible_model_3d_grid::sector_size) + (visible_model_3d_grid::sector_size / 2);
+
+                // If the sector is not visible, its models are discarded without testing them:
+                if(on_screen(sector_x, sector_z, visible_cell.sector_radiuses[sector_index]))
+                {
+                    for(int index = 0; index < sector_models_count; ++index)
+                    {
+                        const model_3d_item& model_item = model_items[model_indexes[index]];
+                        const model_3d_vertical_cylinder* vertical_cylinder = model_item.vertical_cylinder();
+
+                        if(on_screen(vertical_cylinder->centroid_x(), vertical_cylinder->centroid_z(),
+                                     vertical_cylinder->integer_radius())) [[likely]]
+                        {
+                            _static_model_items[static_model_items_count] = &model_item;
+                            ++static_model_items_count;
+                        }
+                    }
+                }
+
+                model_indexes += sector_models_count;
             }
         }
     }
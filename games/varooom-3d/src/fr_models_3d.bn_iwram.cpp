@@ -6,6 +6,7 @@
 #include "fr_models_3d.h"
 
 #include "bn_profiler.h"
+#include "bn_algorithm.h"
 #include "../../butano/hw/include/bn_hw_sprites.h"
 
 #include "fr_div_lut.h"
@@ -34,6 +35,26 @@ namespace
 {
     constexpr int fixed_precision = 18;
     using fixed = bn::fixed_t<fixed_precision>;
+
+    [[nodiscard]] bool _outside_screen(int center, int radius, int far_scale, int half_screen_size)
+    {
+        // The nearest projection of a sphere side is at its farthest depth:
+        int minimum = center - radius;
+
+        if(minimum > 0)
+        {
+            return int((int64_t(minimum) * far_scale) >> 16) >= half_screen_size;
+        }
+
+        int maximum = center + radius;
+
+        if(maximum < 0)
+        {
+            return int((int64_t(maximum) * far_scale) >> 16) < -half_screen_size;
+        }
+
+        return false;
+    }
 }
 
 void models_3d::_process_models(const camera_3d& camera)
@@ -64,8 +85,66 @@ void models_3d::_process_models(const camera_3d& camera)
     for(int static_model_index = _static_models_count - 1; static_model_index >= 0; --static_model_index)
     {
         const model_3d_item* model_item = _static_model_items_ptr[static_model_index];
-        const vertex_3d* model_vertices = model_item->vertices().data();
+
+        // Reject the model before processing its faces and vertices if its bounding sphere
+        // is behind the near plane or outside the screen:
+        const point_3d& sphere_center = model_item->bounding_sphere_center();
+        int sphere_radius = model_item->bounding_sphere_radius().data();
+        int sphere_vcz = -(sphere_center.y() - camera_position.y()).data();
+
+        if(sphere_vcz + sphere_radius < near_plane)
+        {
+            continue;
+        }
+
+        if(sphere_vcz - sphere_radius >= near_plane)
+        {
+            bn::fixed vrx = (sphere_center.x() - camera_position.x()) / 16;
+            bn::fixed vrz = (sphere_center.z() - camera_position.z()) / 16;
+            int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
+            int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
+            int sphere_projected_radius = sphere_radius / 16;
+            int far_vcz = bn::min(sphere_vcz + sphere_radius, (div_lut_size << 10) - 1);
+            auto far_scale = int((uint32_t(div_lut_ptr[far_vcz >> 10].data()) << (focal_length_shift - 8)) >> 6);
+
+            if(_outside_screen(vcx, sphere_projected_radius, far_scale, display_width / 2) ||
+                    _outside_screen(vcy, sphere_projected_radius, far_scale, display_height / 2))
+            {
+                continue;
+            }
+        }
+
+        // Reject back faces before projecting the model vertices:
+        const face_3d* model_faces = model_item->faces().data();
+        int model_faces_count = model_item->faces().size();
         point_2d* projected_vertices = _projected_vertices + global_vertex_index;
+        int first_valid_face_index = valid_faces_count;
+
+        for(int index = model_faces_count - 1; index >= 0; --index)
+        {
+            const face_3d& face = model_faces[index];
+            const point_3d& centroid = face.centroid().point();
+            const point_3d& normal = face.normal().point();
+            point_3d vr = centroid - camera_position;
+
+            if(vr.safe_dot_product(normal) < 0) [[likely]]
+            {
+                int projected_z = -vr.y().data();
+
+                _valid_faces_info[valid_faces_count] = {
+                    &face, projected_vertices, projected_z
+                };
+
+                ++valid_faces_count;
+            }
+        }
+
+        if(valid_faces_count == first_valid_face_index)
+        {
+            continue;
+        }
+
+        const vertex_3d* model_vertices = model_item->vertices().data();
         int model_vertices_count = model_item->vertices().size();
         bool valid_model = true;
 
@@ -83,7 +162,7 @@ void models_3d::_process_models(const camera_3d& camera)
                 int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
 
                 // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
-                auto scale = int((div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+                auto scale = int((uint32_t(div_lut_ptr[vcz >> 10].data()) << (focal_length_shift - 8)) >> 6);
 
                 *projected_vertices = {
                     int16_t(((vcx * scale) >> 16) + (display_width / 2)),
@@ -101,31 +180,12 @@ void models_3d::_process_models(const camera_3d& camera)
 
         if(valid_model) [[likely]]
         {
-            const face_3d* model_faces = model_item->faces().data();
-            int model_faces_count = model_item->faces().size();
-            projected_vertices = _projected_vertices + global_vertex_index;
-
-            for(int index = model_faces_count - 1; index >= 0; --index)
-            {
-                const face_3d& face = model_faces[index];
-                const point_3d& centroid = face.centroid().point();
-                const point_3d& normal = face.normal().point();
-                point_3d vr = centroid - camera_position;
-
-                if(vr.safe_dot_product(normal) < 0) [[likely]]
-                {
-                    int projected_z = -vr.y().data();
-
-                    _valid_faces_info[valid_faces_count] = {
-                        &face, projected_vertices, projected_z
-                    };
-
-                    ++valid_faces_count;
-                }
-            }
-
             global_vertex_index += model_vertices_count;
         }
+        else
+        {
+            valid_faces_count = first_valid_face_index;
+        }
     }
 
     FR_PROFILER_STOP();
@@ -136,12 +196,55 @@ void models_3d::_process_models(const camera_3d& camera)
 
     for(model_3d& model : _dynamic_models_list)
     {
-        const model_3d_item& model_item = model.item();
-        const vertex_3d* model_vertices = model_item.vertices().data();
+        // Select the detail level with the Chebyshev distance to the camera, which doesn't require a square root:
+        if(model.lod_enabled())
+        {
+            point_3d camera_vector = model.position() - camera_position;
+            int camera_distance = bn::max(bn::abs(camera_vector.x()), bn::abs(camera_vector.y())).right_shift_integer();
+            camera_distance = bn::max(camera_distance, bn::abs(camera_vector.z()).right_shift_integer());
+
+            if(! model.update_lod(camera_distance))
+            {
+                continue;
+            }
+        }
+
+        const model_3d_item& model_item = model.lod_item();
+        model.update();
+
+        // Reject back faces before projecting the model vertices:
+        const face_3d* model_faces = model_item.faces().data();
+        int model_faces_count = model_item.faces().size();
         point_2d* projected_vertices = _projected_vertices + global_vertex_index;
+        int first_valid_face_index = valid_faces_count;
+
+        for(int index = model_faces_count - 1; index >= 0; --index)
+        {
+            const face_3d& face = model_faces[index];
+            point_3d centroid = model.transform(face.centroid());
+            point_3d normal = model.rotate(face.normal());
+            point_3d vr = centroid - camera_position;
+
+            if(vr.safe_dot_product(normal) < 0) [[likely]]
+            {
+                int projected_z = -vr.y().data();
+
+                _valid_faces_info[valid_faces_count] = {
+                    &face, projected_vertices, projected_z
+                };
+
+                ++valid_faces_count;
+            }
+        }
+
+        if(valid_faces_count == first_valid_face_index)
+        {
+            continue;
+        }
+
+        const vertex_3d* model_vertices = model_item.vertices().data();
         int model_vertices_count = model_item.vertices().size();
         bool valid_model = true;
-        model.update();
 
         for(int index = 0; index < model_vertices_count; ++index)
         {
@@ -157,7 +260,7 @@ void models_3d::_process_models(const camera_3d& camera)
                 int vcy = -(vrx.unsafe_multiplication(camera_v_x) + vrz.unsafe_multiplication(camera_v_z)).data();
 
                 // int scale = (1 << (focal_length_shift + 16 + 4)) / vcz;
-                auto scale = int((div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 6);
+                auto scale = int((uint32_t(div_lut_ptr[vcz >> 10].data()) << (focal_length_shift - 8)) >> 6);
 
                 *projected_vertices = {
                     int16_t(((vcx * scale) >> 16) + (display_width / 2)),
@@ -175,31 +278,12 @@ void models_3d::_process_models(const camera_3d& camera)
 
         if(valid_model) [[likely]]
         {
-            const face_3d* model_faces = model_item.faces().data();
-            int model_faces_count = model_item.faces().size();
-            projected_vertices = _projected_vertices + global_vertex_index;
-
-            for(int index = model_faces_count - 1; index >= 0; --index)
-            {
-                const face_3d& face = model_faces[index];
-                point_3d centroid = model.transform(face.centroid());
-                point_3d normal = model.rotate(face.normal());
-                point_3d vr = centroid - camera_position;
-
-                if(vr.safe_dot_product(normal) < 0) [[likely]]
-                {
-                    int projected_z = -vr.y().data();
-
-                    _valid_faces_info[valid_faces_count] = {
-                        &face, projected_vertices, projected_z
-                    };
-
-                    ++valid_faces_count;
-                }
-            }
-
             global_vertex_index += model_vertices_count;
         }
+        else
+        {
+            valid_faces_count = first_valid_face_index;
+        }
     }
 
     FR_PROFILER_STOP();
@@ -269,7 +353,6 @@ void models_3d::_process_models(const camera_3d& camera)
                 };
 
                 _visible_face_projected_zs[visible_faces_count] = valid_face.projected_z;
-                _visible_face_indexes[visible_faces_count] = visible_faces_count;
                 ++visible_faces_count;
             }
         }
@@ -283,6 +366,11 @@ void models_3d::_process_models(const camera_3d& camera)
 
     for(sprite_3d& sprite : _sprites_list)
     {
+        if(! sprite.visible())
+        {
+            continue;
+        }
+
         const point_3d& sprite_position = sprite.position();
         bn::fixed vry = sprite_position.y() - camera_position.y();
         int vcz = -vry.data();
@@ -293,7 +381,7 @@ void models_3d::_process_models(const camera_3d& camera)
             bn::fixed vrz = (sprite_position.z() - camera_position.z()) / 16;
             int vcx = (vrx.unsafe_multiplication(camera_u_x) + vrz.unsafe_multiplication(camera_u_z)).data();
 
-            auto sprite_scale = int((div_lut_ptr[vcz >> 10] << (focal_length_shift - 8)) >> 3);
+            auto sprite_scale = int((uint32_t(div_lut_ptr[vcz >> 10].data()) << (focal_length_shift - 8)) >> 3);
             auto scale = sprite_scale >> 3;
             int sprite_x = ((vcx * scale) >> 16) + (display_width / 2) - 32;
 
@@ -334,7 +422,6 @@ void models_3d::_process_models(const camera_3d& camera)
                         };
 
                         _visible_face_projected_zs[visible_faces_count] = vcz;
-                        _visible_face_indexes[visible_faces_count] = visible_faces_count;
                         ++visible_faces_count;
                     }
                 }
@@ -353,12 +440,26 @@ void models_3d::_process_models(const camera_3d& camera)
 
     FR_PROFILER_START("sort_visible_faces");
 
-    const int* projected_zs = _visible_face_projected_zs;
+    // Radix sort by descending projected z, with 16 bits keys and face indexes as payloads
+    // (projected z values shouldn't be greater than the div LUT range):
+    constexpr int key_shift = 6;
+    constexpr int max_key = (1 << 16) - 1;
+
+    unsigned visible_face_sort_values[_max_faces];
+    unsigned temp_visible_face_sort_values[_max_faces];
 
-    bn::sort(_visible_face_indexes, _visible_face_indexes + visible_faces_count, [projected_zs](uint8_t a, uint8_t b)
+    for(int index = 0; index < visible_faces_count; ++index)
     {
-        return projected_zs[a] > projected_zs[b];
-    });
+        int key = bn::max(_visible_face_projected_zs[index], 0) >> key_shift;
+        visible_face_sort_values[index] = (unsigned(max_key - bn::min(key, max_key)) << 16) | unsigned(index);
+    }
+
+    bn::radix_sort(visible_face_sort_values, visible_faces_count, 16, temp_visible_face_sort_values);
+
+    for(int index = 0; index < visible_faces_count; ++index)
+    {
+        _visible_face_indexes[index] = uint8_t(visible_face_sort_values[index]);
+    }
 
     FR_PROFILER_STOP();
 
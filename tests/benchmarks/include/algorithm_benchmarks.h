@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef ALGORITHM_BENCHMARKS_H
+#define ALGORITHM_BENCHMARKS_H
+
+#include "bn_random.h"
+#include "bn_string.h"
+#include "bn_algorithm.h"
+#include "benchmark.h"
+
+template<int Size, typename Function>
+void algorithm_benchmark(const bn::string_view& id, const unsigned* source_values, const Function& function)
+{
+    constexpr int iterations = 64;
+
+    unsigned values[Size];
+    unsigned temp_values[Size];
+
+    // Each iteration sorts a copy of the same values, so all benchmarks spend the same time copying them:
+    benchmark benchmark(id, iterations);
+
+    for(int iteration = 0; iteration < iterations; ++iteration)
+    {
+        bn::copy(source_values, source_values + Size, values);
+        function(values, temp_values);
+    }
+
+    benchmark_sink = int(values[Size / 2]);
+}
+
+template<int Size>
+void algorithm_benchmarks(const unsigned* source_values, const bn::string_view& size_id)
+{
+    bn::string<32> id;
+
+    id = "std_sort_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned*)
+    {
+        bn::sort(values, values + Size);
+    });
+
+    id = "small_sort_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned*)
+    {
+        bn::small_sort(values, Size);
+    });
+
+    id = "radix_sort_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned* temp_values)
+    {
+        bn::radix_sort(values, Size, 16, temp_values);
+    });
+
+    id = "std_nth_element_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned*)
+    {
+        bn::nth_element(values, values + (Size / 2), values + Size);
+    });
+
+    id = "nth_element_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned*)
+    {
+        bn::nth_element(values, Size, Size / 2);
+    });
+
+    id = "std_partial_sort_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned*)
+    {
+        bn::partial_sort(values, values + (Size / 4), values + Size);
+    });
+
+    id = "partial_sort_";
+    id.append(size_id);
+    algorithm_benchmark<Size>(id, source_values, [](unsigned* values, unsigned*)
+    {
+        bn::partial_sort(values, Size, Size / 4);
+    });
+}
+
+inline void algorithm_benchmarks()
+{
+    constexpr int max_size = 256;
+
+    unsigned source_values[max_size];
+    bn::random random;
+
+    // 16 bits keys with the index of each item as payload, like the ones used to sort sprites or faces:
+    for(int index = 0; index < max_size; ++index)
+    {
+        source_values[index] = ((random.get() & 0xFFFF) << 16) | unsigned(index);
+    }
+
+    algorithm_benchmarks<8>(source_values, "8");
+    algorithm_benchmarks<16>(source_values, "16");
+    algorithm_benchmarks<64>(source_values, "64");
+    algorithm_benchmarks<max_size>(source_values, "256");
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "bn_log.h"
+#include "bn_core.h"
+#include "bn_fixed.h"
+#include "bn_timer.h"
+#include "bn_timers.h"
+#include "bn_string_view.h"
+
+// Results are written here so the optimizer can't remove the benchmarked code:
+inline volatile int benchmark_sink = 0;
+
+// Prints benchmark results with the format "benchmark,<id>,<iterations>,<total ticks>,<ticks per iteration>":
+inline void log_benchmark(const bn::string_view& id, int iterations, int ticks)
+{
+    BN_LOG("benchmark,", id, ',', iterations, ',', ticks, ',', ticks / iterations);
+}
+
+// Measures the CPU time elapsed from its construction to its destruction:
+class benchmark
+{
+
+public:
+    benchmark(const bn::string_view& id, int iterations) :
+        _id(id),
+        _iterations(iterations)
+    {
+        // Start just after a screen refresh, so the measure is not interrupted by the V-Blank handler:
+        bn::core::update();
+        _timer.restart();
+    }
+
+    ~benchmark()
+    {
+        log_benchmark(_id, _iterations, _timer.elapsed_ticks());
+    }
+
+private:
+    bn::string_view _id;
+    int _iterations;
+    bn::timer _timer;
+};
+
+// Returns the CPU ticks spent by Butano in the last core::update call:
+[[nodiscard]] inline int last_update_ticks()
+{
+    return (bn::core::last_cpu_usage() * bn::timers::ticks_per_frame()).right_shift_integer();
+}
+
+#endif
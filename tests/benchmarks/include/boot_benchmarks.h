@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BOOT_BENCHMARKS_H
+#define BOOT_BENCHMARKS_H
+
+#include "benchmark.h"
+
+// Time to the first frame, without the startup code run before main
+// (disable BN_CFG_MEMORY_STACK_PAINT_ENABLED to measure it without the IWRAM stack painting):
+inline void boot_benchmarks()
+{
+    log_benchmark("core_init", 1, bn::core::init_ticks());
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef CONTAINERS_BENCHMARKS_H
+#define CONTAINERS_BENCHMARKS_H
+
+#include "bn_vector.h"
+#include "bn_algorithm.h"
+#include "bn_unordered_map.h"
+#include "benchmark.h"
+
+inline void containers_benchmarks()
+{
+    constexpr int iterations = 128;
+
+    bn::vector<int, iterations> vector;
+
+    {
+        benchmark benchmark("vector_push_back", iterations);
+
+        for(int index = 0; index < iterations; ++index)
+        {
+            vector.push_back(iterations - index);
+        }
+    }
+
+    {
+        benchmark benchmark("vector_sort", iterations);
+        bn::sort(vector.begin(), vector.end());
+    }
+
+    {
+        benchmark benchmark("vector_erase_front", iterations);
+
+        while(! vector.empty())
+        {
+            vector.erase(vector.begin());
+        }
+    }
+
+    bn::unordered_map<int, int, iterations * 2> map;
+
+    {
+        benchmark benchmark("unordered_map_insert", iterations);
+
+        for(int index = 0; index < iterations; ++index)
+        {
+            map.insert(index * 7, index);
+        }
+    }
+
+    {
+        benchmark benchmark("unordered_map_find", iterations);
+        int result = 0;
+
+        for(int index = 0; index < iterations; ++index)
+        {
+            auto it = map.find(index * 7);
+            result += it->second;
+        }
+
+        benchmark_sink = result;
+    }
+
+    {
+        benchmark benchmark("unordered_map_erase", iterations);
+
+        for(int index = 0; index < iterations; ++index)
+        {
+            map.erase(index * 7);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef DECOMPRESSION_BENCHMARKS_H
+#define DECOMPRESSION_BENCHMARKS_H
+
+#include "bn_sprite_items_benchmark_lz77.h"
+#include "bn_sprite_items_benchmark_run_length.h"
+#include "benchmark.h"
+
+inline void decompression_benchmark(const bn::string_view& id, const bn::sprite_item& sprite_item)
+{
+    alignas(int) static bn::tile tiles[64];
+    const bn::sprite_tiles_item& tiles_item = sprite_item.tiles_item();
+
+    {
+        benchmark benchmark(id, int(sizeof(tiles)));
+        bn::sprite_tiles_item decompressed_tiles_item = tiles_item.decompress(tiles);
+        benchmark_sink = decompressed_tiles_item.tiles_ref().size();
+    }
+}
+
+inline void decompression_benchmarks()
+{
+    decompression_benchmark("decompress_lz77", bn::sprite_items::benchmark_lz77);
+    decompression_benchmark("decompress_run_length", bn::sprite_items::benchmark_run_length);
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef MATH_BENCHMARKS_H
+#define MATH_BENCHMARKS_H
+
+#include "bn_math.h"
+#include "bn_random.h"
+#include "benchmark.h"
+
+inline void math_benchmarks()
+{
+    constexpr int iterations = 256;
+
+    bn::fixed values[iterations];
+    bn::random random;
+
+    for(bn::fixed& value : values)
+    {
+        value = bn::fixed::from_data(int(random.get() & 0xFFFFF) + 1);
+    }
+
+    {
+        benchmark benchmark("fixed_multiplication", iterations);
+        bn::fixed result = 1;
+
+        for(bn::fixed value : values)
+        {
+            result = (result * value) + 1;
+        }
+
+        benchmark_sink = result.data();
+    }
+
+    {
+        benchmark benchmark("fixed_division", iterations);
+        bn::fixed result = 1;
+
+        for(bn::fixed value : values)
+        {
+            result = (result / value) + 1;
+        }
+
+        benchmark_sink = result.data();
+    }
+
+    {
+        benchmark benchmark("fixed_sqrt", iterations);
+        int result = 0;
+
+        for(bn::fixed value : values)
+        {
+            result += bn::sqrt(value).data();
+        }
+
+        benchmark_sink = result;
+    }
+
+    {
+        benchmark benchmark("fixed_degrees_lut_sin", iterations);
+        int result = 0;
+
+        for(int index = 0; index < iterations; ++index)
+        {
+            result += bn::degrees_lut_sin(index).data();
+        }
+
+        benchmark_sink = result;
+    }
+}
+
+#endif
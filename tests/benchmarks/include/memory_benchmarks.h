@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef MEMORY_BENCHMARKS_H
+#define MEMORY_BENCHMARKS_H
+
+#include "bn_memory.h"
+#include "benchmark.h"
+
+inline void memory_benchmarks()
+{
+    constexpr int words = 1024;
+
+    alignas(int) static int source[words];
+    alignas(int) static int destination[words];
+
+    {
+        benchmark benchmark("memory_set_words", words);
+        bn::memory::set_words(0x12345678, words, source);
+    }
+
+    {
+        benchmark benchmark("memory_copy_words", words);
+        bn::memory::copy(source[0], words, destination[0]);
+    }
+
+    {
+        benchmark benchmark("memory_clear_words", words);
+        bn::memory::clear(words, destination[0]);
+    }
+
+    benchmark_sink = destination[words - 1];
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef PALETTES_BENCHMARKS_H
+#define PALETTES_BENCHMARKS_H
+
+#include "bn_vector.h"
+#include "bn_colors.h"
+#include "bn_sprite_palettes.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_palette_item.h"
+#include "benchmark.h"
+
+inline void palettes_benchmarks()
+{
+    constexpr int palettes_count = 8;
+
+    static bn::color colors[palettes_count][16];
+    bn::vector<bn::sprite_palette_ptr, palettes_count> palettes;
+
+    for(int palette_index = 0; palette_index < palettes_count; ++palette_index)
+    {
+        for(int color_index = 0; color_index < 16; ++color_index)
+        {
+            colors[palette_index][color_index] = bn::color(palette_index * 4, color_index * 2, 31 - color_index);
+        }
+
+        bn::sprite_palette_item palette_item(colors[palette_index], bn::bpp_mode::BPP_4);
+        palettes.push_back(palette_item.create_new_palette());
+    }
+
+    // Palette effects are applied by core::update:
+    bn::core::update();
+    bn::sprite_palettes::set_fade(bn::colors::red, 0.5);
+    bn::core::update();
+    log_benchmark("sprite_palettes_fade_update", palettes_count, last_update_ticks());
+
+    bn::sprite_palettes::set_fade_intensity(0);
+    bn::sprite_palettes::set_hue_shift_intensity(0.5);
+    bn::core::update();
+    log_benchmark("sprite_palettes_hue_shift_update", palettes_count, last_update_ticks());
+
+    bn::sprite_palettes::set_hue_shift_intensity(0);
+    bn::core::update();
+}
+
+#endif
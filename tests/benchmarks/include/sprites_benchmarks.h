@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITES_BENCHMARKS_H
+#define SPRITES_BENCHMARKS_H
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_vblank_stats.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_items_benchmark_none.h"
+#include "bn_sprite_items_benchmark_lz77.h"
+#include "bn_sprite_items_benchmark_run_length.h"
+#include "benchmark.h"
+
+inline void sprite_tiles_upload_benchmark(const bn::string_view& id, const bn::sprite_item& sprite_item)
+{
+    // Tiles are uploaded to VRAM by core::update:
+    bn::sprite_tiles_ptr tiles = bn::sprite_tiles_ptr::create_new(sprite_item.tiles_item());
+    bn::core::update();
+
+    const bn::vblank_stats& vblank_stats = bn::core::last_vblank_stats();
+    log_benchmark(id, vblank_stats.sprite_tiles_bytes(), vblank_stats.sprite_tiles_ticks());
+}
+
+inline void sprites_benchmarks()
+{
+    constexpr int sprites_count = 64;
+
+    bn::vector<bn::sprite_ptr, sprites_count> sprites;
+
+    {
+        benchmark benchmark("sprite_create", sprites_count);
+
+        for(int index = 0; index < sprites_count; ++index)
+        {
+            sprites.push_back(bn::sprite_items::benchmark_none.create_sprite((index % 8) * 16 - 56,
+                                                                              (index / 8) * 16 - 56));
+        }
+    }
+
+    // Z order updates force a rebuild of the hardware sprite handles:
+    bn::core::update();
+
+    for(int index = 0; index < sprites_count; ++index)
+    {
+        sprites[index].set_z_order(sprites_count - index);
+    }
+
+    bn::core::update();
+    log_benchmark("sprites_rebuild_handles_update", sprites_count, last_update_ticks());
+
+    {
+        benchmark benchmark("sprite_destroy", sprites_count);
+        sprites.clear();
+    }
+
+    sprite_tiles_upload_benchmark("sprite_tiles_upload_none", bn::sprite_items::benchmark_none);
+    sprite_tiles_upload_benchmark("sprite_tiles_upload_lz77", bn::sprite_items::benchmark_lz77);
+    sprite_tiles_upload_benchmark("sprite_tiles_upload_run_length", bn::sprite_items::benchmark_run_length);
+}
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef TEXT_BENCHMARKS_H
+#define TEXT_BENCHMARKS_H
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_text_generator.h"
+#include "common_fixed_8x16_sprite_font.h"
+#include "common_variable_8x16_sprite_font.h"
+#include "benchmark.h"
+
+inline void text_benchmark(const bn::string_view& id, const bn::sprite_font& font)
+{
+    constexpr bn::string_view text = "The quick brown fox jumps";
+
+    bn::sprite_text_generator text_generator(font);
+    bn::vector<bn::sprite_ptr, 16> text_sprites;
+
+    {
+        benchmark benchmark(id, text.size());
+        text_generator.generate(-112, 0, text, text_sprites);
+    }
+}
+
+inline void text_benchmarks()
+{
+    text_benchmark("text_generate_fixed_8x16", common::fixed_8x16_sprite_font);
+    text_benchmark("text_generate_variable_8x16", common::variable_8x16_sprite_font);
+}
+
+#endif
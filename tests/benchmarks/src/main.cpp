@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020-2022 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_colors.h"
+#include "bn_bg_palettes.h"
+#include "bn_config_log.h"
+
+#include "boot_benchmarks.h"
+#include "containers_benchmarks.h"
+#include "math_benchmarks.h"
+#include "algorithm_benchmarks.h"
+#include "memory_benchmarks.h"
+#include "decompression_benchmarks.h"
+#include "sprites_benchmarks.h"
+#include "palettes_benchmarks.h"
+#include "text_benchmarks.h"
+
+#if ! BN_CFG_LOG_ENABLED
+    static_assert(false, "Enable log in bn_config_log.h to print benchmark results");
+#endif
+
+int main()
+{
+    bn::core::init();
+
+    bn::bg_palettes::set_transparent_color(bn::colors::gray);
+    BN_LOG("Running benchmarks...");
+
+    boot_benchmarks();
+    containers_benchmarks();
+    math_benchmarks();
+    algorithm_benchmarks();
+    memory_benchmarks();
+    decompression_benchmarks();
+    sprites_benchmarks();
+    palettes_benchmarks();
+    text_benchmarks();
+
+    BN_LOG("Benchmarks finished");
+    bn::bg_palettes::set_transparent_color(bn::colors::green);
+
+    while(true)
+    {
+        bn::core::update();
+    }
+}
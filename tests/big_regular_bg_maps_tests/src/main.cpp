@@ -5,6 +5,7 @@
 
 #include "bn_core.h"
 #include "bn_keypad.h"
+#include "bn_string.h"
 #include "bn_display.h"
 #include "bn_regular_bg_ptr.h"
 #include "bn_sprite_text_generator.h"
@@ -60,6 +61,73 @@ namespace
             bn::core::update();
         }
     }
+
+    void benchmark_scene(const bn::regular_bg_item& item, bn::sprite_text_generator& text_generator)
+    {
+        constexpr bn::string_view info_text_lines[] = {
+            "Scrolling 4 pixels per frame",
+            "",
+            "START: go to next scene",
+        };
+
+        common::info info("Big map scroll benchmark", info_text_lines, text_generator);
+
+        bn::regular_bg_ptr bg = item.create_bg(0, 0);
+        int x_limit = (bg.dimensions().width() - bn::display::width()) / 2;
+        int y_limit = (bg.dimensions().height() - bn::display::height()) / 2;
+        int x_inc = 4;
+        int y_inc = 4;
+        int frames = 0;
+        bn::fixed total_vblank_usage;
+        bn::fixed max_vblank_usage;
+        bn::vector<bn::sprite_ptr, 16> text_sprites;
+
+        while(! bn::keypad::start_pressed())
+        {
+            int x = bg.x().right_shift_integer() + x_inc;
+            int y = bg.y().right_shift_integer() + y_inc;
+
+            if(x <= -x_limit || x >= x_limit)
+            {
+                x = bn::clamp(x, -x_limit, x_limit);
+                x_inc = -x_inc;
+            }
+
+            if(y <= -y_limit || y >= y_limit)
+            {
+                y = bn::clamp(y, -y_limit, y_limit);
+                y_inc = -y_inc;
+            }
+
+            bg.set_position(x, y);
+
+            if(frames)
+            {
+                bn::fixed vblank_usage = bn::core::last_vblank_usage();
+                total_vblank_usage += vblank_usage;
+                max_vblank_usage = bn::max(max_vblank_usage, vblank_usage);
+            }
+
+            ++frames;
+
+            if(frames % 64 == 1 && frames > 1)
+            {
+                bn::string<32> text;
+                bn::ostringstream text_stream(text);
+                text_stream.append("V-Blank avg: ");
+                text_stream.append(((total_vblank_usage * 100) / (frames - 1)).right_shift_integer());
+                text_stream.append("% max: ");
+                text_stream.append((max_vblank_usage * 100).right_shift_integer());
+                text_stream.append("%");
+
+                text_sprites.clear();
+                text_generator.generate(0, 0, text, text_sprites);
+            }
+
+            info.update();
+            bn::core::update();
+        }
+    }
 }
 
 int main()
@@ -78,5 +146,8 @@ int main()
 
         big_map_scene("512x1024 borders BPP4 regular BG", bn::regular_bg_items::border_map, text_generator);
         bn::core::update();
+
+        benchmark_scene(bn::regular_bg_items::big_map_4, text_generator);
+        bn::core::update();
     }
 }